@@ -18,6 +18,7 @@ HttpConnectionHandlerPool::HttpConnectionHandlerPool(QSettings* settings, HttpRe
     this->requestHandler = requestHandler;
     this->sslConfiguration = 0;
     loadSslConfig();
+    createMultiplexers();
     cleanupTimer.start(settings->value("cleanupInterval",1000).toInt());
     connect(&cleanupTimer, SIGNAL(timeout()), SLOT(cleanup()));
 }
@@ -31,6 +32,7 @@ HttpConnectionHandlerPool::HttpConnectionHandlerPool(const HttpListenerSettings*
     this->requestHandler = requestHandler;
     this->sslConfiguration = 0;
     loadSslConfig();
+    createMultiplexers();
     cleanupTimer.start(settings->cleanupInterval);
     connect(&cleanupTimer, SIGNAL(timeout()), SLOT(cleanup()));
 }
@@ -42,6 +44,10 @@ HttpConnectionHandlerPool::~HttpConnectionHandlerPool()
     {
        delete handler;
     }
+    foreach(HttpConnectionMultiplexer* multiplexer, multiplexers)
+    {
+       delete multiplexer;
+    }
     delete sslConfiguration;
     qDebug("HttpConnectionHandlerPool (%p): destroyed", this);
 }
@@ -82,6 +88,44 @@ HttpConnectionHandler* HttpConnectionHandlerPool::getConnectionHandler()
 }
 
 
+void HttpConnectionHandlerPool::createMultiplexers()
+{
+    int eventLoopThreads = useQtSettings ? settings->value("eventLoopThreads",0).toInt() : listenerSettings->eventLoopThreads;
+
+    for (int i = 0; i < eventLoopThreads; i++)
+    {
+        if (useQtSettings) {
+            multiplexers.append(new HttpConnectionMultiplexer(settings, requestHandler, sslConfiguration));
+        } else {
+            multiplexers.append(new HttpConnectionMultiplexer(listenerSettings, requestHandler, sslConfiguration));
+        }
+    }
+
+    if (eventLoopThreads > 0) {
+        qDebug("HttpConnectionHandlerPool: serving connections with %d event loops", eventLoopThreads);
+    }
+}
+
+
+HttpConnectionMultiplexer* HttpConnectionHandlerPool::getConnectionMultiplexer()
+{
+    HttpConnectionMultiplexer* leastLoaded=0;
+    // only the listener thread assigns connections so reading the counts then reserving is not racy
+    foreach(HttpConnectionMultiplexer* multiplexer, multiplexers)
+    {
+        if (!leastLoaded || (multiplexer->getConnectionCount() < leastLoaded->getConnectionCount()))
+        {
+            leastLoaded=multiplexer;
+        }
+    }
+    if (leastLoaded)
+    {
+        leastLoaded->reserveConnection();
+    }
+    return leastLoaded;
+}
+
+
 void HttpConnectionHandlerPool::cleanup()
 {
     int maxIdleHandlers = useQtSettings ? settings->value("minThreads",1).toInt() : listenerSettings->minThreads;
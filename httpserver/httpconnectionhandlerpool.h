@@ -7,6 +7,7 @@
 #include <QMutex>
 #include "httpglobal.h"
 #include "httpconnectionhandler.h"
+#include "httpconnectionmultiplexer.h"
 #include "httplistenersettings.h"
 
 #include "export.h"
@@ -33,6 +34,10 @@ namespace qtwebapp {
   the number of idle threads slowly by closing one thread in each interval.
   But the configured minimum number of threads are kept running.
   <p>
+  When eventLoopThreads is greater than zero the pool instead starts this fixed number of
+  HttpConnectionMultiplexer event loops, each serving many keep-alive connections. The
+  minThreads, maxThreads and cleanupInterval settings are then ignored.
+  <p>
   For SSL support, you need an OpenSSL certificate file and a key file.
   Both can be created with the command
   <code><pre>
@@ -75,6 +80,12 @@ public:
     /** Get a free connection handler, or 0 if not available. */
     HttpConnectionHandler* getConnectionHandler();
 
+    /** True if connections are served by event loop multiplexers rather than handler threads */
+    bool isMultiplexed() const { return !multiplexers.isEmpty(); }
+
+    /** Get the least loaded multiplexer with one connection reserved on it, or 0 if not multiplexed. */
+    HttpConnectionMultiplexer* getConnectionMultiplexer();
+
     /**
      * Get a listener settings const reference. Can be changed on the HttpListener only.
      * @return The current listener settings
@@ -95,6 +106,9 @@ private:
     /** Pool of connection handlers */
     QList<HttpConnectionHandler*> pool;
 
+    /** Fixed set of event loops used instead of the handler pool */
+    QList<HttpConnectionMultiplexer*> multiplexers;
+
     /** Timer to clean-up unused connection handler */
     QTimer cleanupTimer;
 
@@ -107,6 +121,9 @@ private:
     /** Load SSL configuration */
     void loadSslConfig();
 
+    /** Start the event loop multiplexers if configured */
+    void createMultiplexers();
+
     /** Settings flag */
     bool useQtSettings;
 
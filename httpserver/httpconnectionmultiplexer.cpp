@@ -0,0 +1,344 @@
+/**
+  @file
+  @author Edouard Griffiths, F4EXB
+*/
+
+#ifndef QT_NO_OPENSSL
+    #include <QSslSocket>
+#endif
+#include <QList>
+#include "httpconnectionmultiplexer.h"
+#include "httpresponse.h"
+
+using namespace qtwebapp;
+
+HttpConnectionMultiplexer::HttpConnectionMultiplexer(QSettings* settings, HttpRequestHandler* requestHandler, QSslConfiguration* sslConfiguration)
+    : QThread(), useQtSettings(true)
+{
+    Q_ASSERT(settings != 0);
+    Q_ASSERT(requestHandler != 0);
+    this->settings = settings;
+    this->listenerSettings = 0;
+    this->requestHandler = requestHandler;
+    this->sslConfiguration = sslConfiguration;
+    init();
+}
+
+HttpConnectionMultiplexer::HttpConnectionMultiplexer(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler, QSslConfiguration* sslConfiguration)
+    : QThread(), useQtSettings(false)
+{
+    Q_ASSERT(settings != 0);
+    Q_ASSERT(requestHandler != 0);
+    this->settings = 0;
+    this->listenerSettings = settings;
+    this->requestHandler = requestHandler;
+    this->sslConfiguration = sslConfiguration;
+    init();
+}
+
+void HttpConnectionMultiplexer::init()
+{
+    // execute signals in my own thread
+    moveToThread(this);
+    timeoutTimer.moveToThread(this);
+
+    // a sweep interval of a fraction of the read timeout keeps the timeout accuracy
+    // reasonable without waking up the loop too often
+    int readTimeout = getReadTimeout();
+    timeoutTimer.setInterval(readTimeout/4 < 100 ? 100 : readTimeout/4 > 1000 ? 1000 : readTimeout/4);
+    connect(&timeoutTimer, SIGNAL(timeout()), SLOT(checkTimeouts()));
+
+    qDebug("HttpConnectionMultiplexer (%p): constructed", this);
+    this->start();
+}
+
+HttpConnectionMultiplexer::~HttpConnectionMultiplexer()
+{
+    quit();
+    wait();
+    qDebug("HttpConnectionMultiplexer (%p): destroyed", this);
+}
+
+QTcpSocket* HttpConnectionMultiplexer::createSocket()
+{
+    // If SSL is supported and configured, then create an instance of QSslSocket
+    #ifndef QT_NO_OPENSSL
+        if (sslConfiguration)
+        {
+            QSslSocket* sslSocket=new QSslSocket();
+            sslSocket->setSslConfiguration(*sslConfiguration);
+            return sslSocket;
+        }
+    #endif
+    // else create an instance of QTcpSocket
+    return new QTcpSocket();
+}
+
+int HttpConnectionMultiplexer::getReadTimeout() const
+{
+    return useQtSettings ? settings->value("readTimeout",10000).toInt() : listenerSettings->readTimeout;
+}
+
+void HttpConnectionMultiplexer::run()
+{
+#ifdef SUPERVERBOSE
+    qDebug("HttpConnectionMultiplexer (%p): thread started", this);
+#endif
+    clock.start();
+    timeoutTimer.start();
+
+    try
+    {
+        exec();
+    }
+    catch (...)
+    {
+        qCritical("HttpConnectionMultiplexer (%p): an uncatched exception occurred in the thread",this);
+    }
+
+    timeoutTimer.stop();
+
+    // close the remaining connections without going back to the event loop
+    for (QHash<QTcpSocket*, Connection>::iterator it = connections.begin(); it != connections.end(); ++it)
+    {
+        disconnect(it.key(), 0, this, 0);
+        it.key()->abort();
+        delete it.key();
+        delete it->request;
+    }
+
+    connections.clear();
+#ifdef SUPERVERBOSE
+    qDebug("HttpConnectionMultiplexer (%p): thread stopped", this);
+#endif
+}
+
+void HttpConnectionMultiplexer::handleConnection(tSocketDescriptor socketDescriptor)
+{
+#ifdef SUPERVERBOSE
+    qDebug("HttpConnectionMultiplexer (%p): handle new connection", this);
+#endif
+    QTcpSocket* socket = createSocket();
+
+    if (!socket->setSocketDescriptor(socketDescriptor))
+    {
+        qCritical("HttpConnectionMultiplexer (%p): cannot initialize socket: %s", this,qPrintable(socket->errorString()));
+        delete socket;
+        connectionCount.deref();
+        return;
+    }
+
+    connect(socket, SIGNAL(readyRead()), SLOT(read()));
+    connect(socket, SIGNAL(disconnected()), SLOT(disconnected()));
+
+    Connection connection;
+    connection.deadline = clock.elapsed() + getReadTimeout();
+    connections.insert(socket, connection);
+
+    #ifndef QT_NO_OPENSSL
+        // Switch on encryption, if SSL is configured
+        if (sslConfiguration)
+        {
+            qDebug("HttpConnectionMultiplexer (%p): Starting encryption", this);
+            ((QSslSocket*)socket)->startServerEncryption();
+        }
+    #endif
+}
+
+void HttpConnectionMultiplexer::removeConnection(QTcpSocket* socket)
+{
+    QHash<QTcpSocket*, Connection>::iterator it = connections.find(socket);
+
+    if (it == connections.end()) {
+        return;
+    }
+
+    delete it->request;
+    connections.erase(it);
+    disconnect(socket, 0, this, 0);
+    socket->deleteLater();
+    connectionCount.deref();
+}
+
+void HttpConnectionMultiplexer::disconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+
+    if (socket)
+    {
+#ifdef SUPERVERBOSE
+        qDebug("HttpConnectionMultiplexer (%p): disconnected %p", this, socket);
+#endif
+        removeConnection(socket);
+    }
+}
+
+void HttpConnectionMultiplexer::checkTimeouts()
+{
+    qint64 now = clock.elapsed();
+    QList<QTcpSocket*> expired;
+
+    for (QHash<QTcpSocket*, Connection>::const_iterator it = connections.constBegin(); it != connections.constEnd(); ++it)
+    {
+        if (it->deadline <= now) {
+            expired.append(it.key());
+        }
+    }
+
+    foreach (QTcpSocket* socket, expired)
+    {
+        qDebug("HttpConnectionMultiplexer (%p): read timeout occurred on %p", this, socket);
+
+        if (socket->state() == QAbstractSocket::ClosingState)
+        {
+            // still flushing since the last sweep: give up on the peer
+            socket->abort();
+        }
+        else
+        {
+            QHash<QTcpSocket*, Connection>::iterator it = connections.find(socket);
+            delete it->request;
+            it->request = 0;
+            it->deadline = now + getReadTimeout();
+            socket->disconnectFromHost(); // may remove the connection synchronously
+        }
+    }
+}
+
+void HttpConnectionMultiplexer::read()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+
+    if (!socket || !connections.contains(socket)) {
+        return;
+    }
+
+    // The loop adds support for HTTP pipelinig
+    while (socket->bytesAvailable())
+    {
+        Connection& connection = connections[socket];
+
+        // Create new HttpRequest object if necessary
+        if (!connection.request)
+        {
+            if (useQtSettings) {
+                connection.request = new HttpRequest(settings);
+            } else {
+                connection.request = new HttpRequest(listenerSettings);
+            }
+        }
+
+        HttpRequest* request = connection.request;
+
+        // Collect data for the request object
+        while (socket->bytesAvailable() && request->getStatus()!=HttpRequest::complete && request->getStatus()!=HttpRequest::abort)
+        {
+            request->readFromSocket(socket);
+
+            if (request->getStatus()==HttpRequest::waitForBody)
+            {
+                // Restart read timeout, otherwise it would
+                // expire during large file uploads.
+                connection.deadline = clock.elapsed() + getReadTimeout();
+            }
+        }
+
+        // If the request is aborted, return error message and close the connection
+        if (request->getStatus()==HttpRequest::abort)
+        {
+            socket->write("HTTP/1.1 413 entity too large\r\nConnection: close\r\n\r\n413 Entity too large\r\n");
+            delete request;
+            connection.request = 0;
+            socket->disconnectFromHost(); // flushes the answer before closing
+            return;
+        }
+
+        // If the request is complete, let the request mapper dispatch it
+        if (request->getStatus()==HttpRequest::complete)
+        {
+            connection.request = 0;
+            bool closeConnection = processRequest(socket, request);
+            delete request;
+
+            // the socket may have been disconnected while the response was written
+            QHash<QTcpSocket*, Connection>::iterator it = connections.find(socket);
+
+            if (it == connections.end()) {
+                return;
+            }
+
+            if (closeConnection)
+            {
+                socket->disconnectFromHost();
+                return;
+            }
+
+            // Restart read timeout for next request
+            it->deadline = clock.elapsed() + getReadTimeout();
+        }
+    }
+}
+
+bool HttpConnectionMultiplexer::processRequest(QTcpSocket* socket, HttpRequest* request)
+{
+    qDebug("HttpConnectionMultiplexer (%p): received request from %s (%s) %s",
+            this,
+            qPrintable(request->getPeerAddress().toString()),
+            request->getMethod().constData(),
+            request->getRawPath().constData());
+
+    // Copy the Connection:close header to the response
+    HttpResponse response(socket);
+    bool closeConnection=QString::compare(request->getHeader("Connection"),"close",Qt::CaseInsensitive)==0;
+
+    if (closeConnection)
+    {
+        response.setHeader("Connection","close");
+    }
+    else
+    {
+        // In case of HTTP 1.0 protocol add the Connection:close header.
+        // This ensures that the HttpResponse does not activate chunked mode, which is not spported by HTTP 1.0.
+        bool http1_0=QString::compare(request->getVersion(),"HTTP/1.0",Qt::CaseInsensitive)==0;
+
+        if (http1_0)
+        {
+            closeConnection=true;
+            response.setHeader("Connection","close");
+        }
+    }
+
+    // Call the request mapper
+    try
+    {
+        requestHandler->service(*request, response);
+    }
+    catch (...)
+    {
+        qCritical("HttpConnectionMultiplexer (%p): An uncatched exception occurred in the request handler",this);
+    }
+
+    // Finalize sending the response if not already done
+    if (!response.hasSentLastPart())
+    {
+        response.write(QByteArray(),true);
+    }
+
+    if (closeConnection) {
+        return true;
+    }
+
+    // Maybe the request handler or mapper added a Connection:close header in the meantime
+    if (QString::compare(response.getHeaders().value("Connection"),"close",Qt::CaseInsensitive)==0) {
+        return true;
+    }
+
+    // If we have no Content-Length header and did not use chunked mode, then we have to close the
+    // connection to tell the HTTP client that the end of the response has been reached.
+    if (!response.getHeaders().contains("Content-Length"))
+    {
+        return QString::compare(response.getHeaders().value("Transfer-Encoding"),"chunked",Qt::CaseInsensitive)!=0;
+    }
+
+    return false;
+}
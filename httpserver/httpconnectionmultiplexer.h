@@ -0,0 +1,156 @@
+/**
+  @file
+  @author Edouard Griffiths, F4EXB
+*/
+
+#ifndef HTTPCONNECTIONMULTIPLEXER_H
+#define HTTPCONNECTIONMULTIPLEXER_H
+
+#include <QTcpSocket>
+#include <QSettings>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QHash>
+#include <QAtomicInt>
+#include "httpglobal.h"
+#include "httpconnectionhandler.h"
+#include "httprequest.h"
+#include "httprequesthandler.h"
+#include "httplistenersettings.h"
+
+#include "export.h"
+
+namespace qtwebapp {
+
+/**
+  Event driven counterpart of the HttpConnectionHandler. Instead of dedicating one thread to
+  each connection a multiplexer runs a single event loop that serves any number of keep-alive
+  connections: the sockets are watched by the Qt event dispatcher (epoll, kqueue or select
+  depending on the platform) and a request is dispatched to the request handler as soon as
+  it has been completely received.
+  <p>
+  The HttpConnectionHandlerPool creates a small fixed set of multiplexers when the
+  eventLoopThreads setting is greater than zero and the listener assigns each new connection
+  to the least loaded one.
+  <p>
+  Read timeouts are checked by a single periodic sweep instead of one timer per connection.
+  Closing a connection never blocks the loop: pending output is flushed by the socket before
+  it is actually closed.
+  @see HttpConnectionHandler for description of the readTimeout
+  @see HttpRequest for description of config settings maxRequestSize and maxMultiPartSize
+*/
+class HTTPSERVER_API HttpConnectionMultiplexer : public QThread {
+    Q_OBJECT
+    Q_DISABLE_COPY(HttpConnectionMultiplexer)
+
+public:
+
+    /**
+      Constructor.
+      @param settings Configuration settings of the HTTP webserver as Qt settings
+      @param requestHandler Handler that will process each incoming HTTP request
+      @param sslConfiguration SSL (HTTPS) will be used if not NULL
+    */
+    HttpConnectionMultiplexer(QSettings* settings, HttpRequestHandler* requestHandler, QSslConfiguration* sslConfiguration=NULL);
+
+    /**
+      Constructor.
+      @param settings Configuration settings of the HTTP webserver as a structure
+      @param requestHandler Handler that will process each incoming HTTP request
+      @param sslConfiguration SSL (HTTPS) will be used if not NULL
+    */
+    HttpConnectionMultiplexer(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler, QSslConfiguration* sslConfiguration=NULL);
+
+    /** Destructor. Closes all connections served by this multiplexer. */
+    virtual ~HttpConnectionMultiplexer();
+
+    /** Number of connections assigned to this multiplexer including the ones not yet opened */
+    int getConnectionCount() const { return connectionCount.load(); }
+
+    /** Account for a connection that is about to be passed with handleConnection() */
+    void reserveConnection() { connectionCount.ref(); }
+
+private:
+
+    /** State of one connection */
+    struct Connection
+    {
+        HttpRequest* request;   //!< request being received or 0 between requests
+        qint64 deadline;        //!< read timeout expiry relative to clock
+
+        Connection() :
+            request(0),
+            deadline(0)
+        {}
+    };
+
+    /** Configuration settings */
+    QSettings* settings;
+
+    /** Configuration settings */
+    const HttpListenerSettings* listenerSettings;
+
+    /** Dispatches received requests to services */
+    HttpRequestHandler* requestHandler;
+
+    /** Configuration for SSL */
+    QSslConfiguration* sslConfiguration;
+
+    /** Connections served by this event loop */
+    QHash<QTcpSocket*, Connection> connections;
+
+    /** Number of connections assigned, maintained across threads */
+    QAtomicInt connectionCount;
+
+    /** Periodic read timeout sweep */
+    QTimer timeoutTimer;
+
+    /** Time reference of the read timeout deadlines */
+    QElapsedTimer clock;
+
+    /** Settings flag */
+    bool useQtSettings;
+
+    /** Common part of the constructors */
+    void init();
+
+    /** Executes the threads own event loop */
+    void run();
+
+    /** Create SSL or TCP socket */
+    QTcpSocket* createSocket();
+
+    /** Read timeout in milliseconds from the settings */
+    int getReadTimeout() const;
+
+    /** Dispatch a complete request and send the response. Returns true if the connection must be closed. */
+    bool processRequest(QTcpSocket* socket, HttpRequest* request);
+
+    /** Remove the connection from the loop and schedule the socket deletion */
+    void removeConnection(QTcpSocket* socket);
+
+public slots:
+
+    /**
+      Received from from the listener, when the multiplexer shall serve a new connection.
+      @param socketDescriptor references the accepted connection.
+    */
+    void handleConnection(tSocketDescriptor socketDescriptor);
+
+private slots:
+
+    /** Received from a socket when incoming data can be read */
+    void read();
+
+    /** Received from a socket when its connection has been closed */
+    void disconnected();
+
+    /** Received from the sweep timer to close connections that timed out */
+    void checkTimeouts();
+
+};
+
+} // end of namespace
+
+#endif // HTTPCONNECTIONMULTIPLEXER_H
@@ -84,6 +84,14 @@ void HttpListener::incomingConnection(tSocketDescriptor socketDescriptor) {
     qDebug("HttpListener: New connection");
 #endif
 
+    // Event loops accept any number of connections
+    if (pool && pool->isMultiplexed())
+    {
+        HttpConnectionMultiplexer* multiplexer=pool->getConnectionMultiplexer();
+        QMetaObject::invokeMethod(multiplexer, "handleConnection", Qt::QueuedConnection, Q_ARG(tSocketDescriptor, socketDescriptor));
+        return;
+    }
+
     HttpConnectionHandler* freeHandler=NULL;
     if (pool)
     {
@@ -35,11 +35,12 @@ namespace qtwebapp {
   ;sslCertFile=ssl/my.cert
   maxRequestSize=16000
   maxMultiPartSize=1000000
+  ;eventLoopThreads=2
   </pre></code>
   The optional host parameter binds the listener to one network interface.
   The listener handles all network interfaces if no host is configured.
   The port number specifies the incoming TCP port that this listener listens to.
-  @see HttpConnectionHandlerPool for description of config settings minThreads, maxThreads, cleanupInterval and ssl settings
+  @see HttpConnectionHandlerPool for description of config settings minThreads, maxThreads, cleanupInterval, eventLoopThreads and ssl settings
   @see HttpConnectionHandler for description of the readTimeout
   @see HttpRequest for description of config settings maxRequestSize and maxMultiPartSize
 */
@@ -23,6 +23,7 @@ public:
     QString sslCertFile;
     int maxRequestSize;
     int maxMultiPartSize;
+    int eventLoopThreads; //!< 0: one handler thread per connection, >0: number of event loops multiplexing the connections
 
     HttpListenerSettings() {
         resetToDefaults();
@@ -40,6 +41,7 @@ public:
         sslCertFile = "";
         maxRequestSize = 16000;
         maxMultiPartSize = 1000000;
+        eventLoopThreads = 0;
     }
 };
 
@@ -174,7 +174,17 @@ void HttpRequest::readBody(QTcpSocket* socket)
         int toRead=expectedBodySize-bodyData.size();
         QByteArray newData=socket->read(toRead);
         currentSize+=newData.size();
-        bodyData.append(newData);
+        if (bodyData.isEmpty())
+        {
+            // Common case of a body received in one read: keep the buffer returned by the
+            // socket (implicitly shared) instead of copying it.
+            bodyData=newData;
+        }
+        else
+        {
+            bodyData.reserve(expectedBodySize);
+            bodyData.append(newData);
+        }
         if (bodyData.size()>=expectedBodySize)
         {
             status=complete;
@@ -0,0 +1,492 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "bfmscanner.h"
+
+#include <QDebug>
+
+#include "SWGChannelSettings.h"
+#include "SWGBFMScannerSettings.h"
+#include "SWGChannelReport.h"
+#include "SWGBFMScannerReport.h"
+#include "SWGBFMScannerStation.h"
+
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "dsp/dspcommands.h"
+#include "dsp/devicesamplemimo.h"
+#include "device/deviceapi.h"
+#include "webapi/webapireversedispatcher.h"
+
+MESSAGE_CLASS_DEFINITION(BFMScanner::MsgConfigureBFMScanner, Message)
+MESSAGE_CLASS_DEFINITION(BFMScanner::MsgSampleRateNotification, Message)
+
+const QString BFMScanner::m_channelIdURI = "sdrangel.channel.bfmscanner";
+const QString BFMScanner::m_channelId = "BFMScanner";
+
+BFMScanner::BFMScanner(DeviceAPI *deviceAPI) :
+        ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
+        m_deviceAPI(deviceAPI),
+        m_deviceSampleRate(0),
+        m_centerFrequency(0),
+        m_inputSampleRate(0),
+        m_bankCenterFrequency(0),
+        m_running(false),
+        m_settingsMutex(QMutex::Recursive)
+{
+    setObjectName(m_channelId);
+
+    m_channelizer = new DownChannelizer(this);
+    m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
+    m_deviceAPI->addChannelSink(m_threadedChannelizer);
+    m_deviceAPI->addChannelSinkAPI(this);
+}
+
+BFMScanner::~BFMScanner()
+{
+    m_deviceAPI->removeChannelSinkAPI(this);
+    m_deviceAPI->removeChannelSink(m_threadedChannelizer);
+    delete m_threadedChannelizer;
+    delete m_channelizer;
+}
+
+uint32_t BFMScanner::getNumberOfDeviceStreams() const
+{
+    return m_deviceAPI->getNbSourceStreams();
+}
+
+void BFMScanner::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
+{
+    (void) firstOfBurst;
+
+	if (!m_running) {
+        return;
+    }
+
+	m_settingsMutex.lock();
+    m_bank.feed(begin, end);
+	m_settingsMutex.unlock();
+}
+
+void BFMScanner::start()
+{
+	qDebug("BFMScanner::start");
+    applyChannelSettings(m_inputSampleRate, m_centerFrequency, true);
+    m_running = true;
+}
+
+void BFMScanner::stop()
+{
+    qDebug("BFMScanner::stop");
+    m_running = false;
+}
+
+bool BFMScanner::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        m_deviceSampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+
+        qDebug() << "BFMScanner::handleMessage: DSPSignalNotification:"
+                << " m_deviceSampleRate: " << m_deviceSampleRate
+                << " centerFrequency: " << m_centerFrequency;
+
+        // the scanner takes the whole baseband
+        m_channelizer->configure(m_channelizer->getInputMessageQueue(), m_deviceSampleRate, 0);
+
+        return true;
+    }
+    else if (DownChannelizer::MsgChannelizerNotification::match(cmd))
+	{
+		DownChannelizer::MsgChannelizerNotification& notif = (DownChannelizer::MsgChannelizerNotification&) cmd;
+
+        qDebug() << "BFMScanner::handleMessage: MsgChannelizerNotification:"
+                << " inputSampleRate: " << notif.getSampleRate()
+                << " inputFrequencyOffset: " << notif.getFrequencyOffset();
+
+        applyChannelSettings(notif.getSampleRate(), m_centerFrequency);
+
+		return true;
+	}
+	else if (MsgConfigureBFMScanner::match(cmd))
+	{
+        MsgConfigureBFMScanner& cfg = (MsgConfigureBFMScanner&) cmd;
+        qDebug() << "BFMScanner::handleMessage: MsgConfigureBFMScanner";
+        applySettings(cfg.getSettings(), cfg.getForce());
+
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+void BFMScanner::applyChannelSettings(int inputSampleRate, qint64 centerFrequency, bool force)
+{
+    qDebug() << "BFMScanner::applyChannelSettings:"
+            << " inputSampleRate: " << inputSampleRate
+            << " centerFrequency: " << centerFrequency;
+
+    if ((m_inputSampleRate != inputSampleRate) || (m_bankCenterFrequency != centerFrequency) || force)
+    {
+        m_settingsMutex.lock();
+        m_bank.configure(inputSampleRate, centerFrequency, m_settings); // slots follow the device center frequency
+        m_settingsMutex.unlock();
+    }
+
+    m_inputSampleRate = inputSampleRate;
+    m_bankCenterFrequency = centerFrequency;
+
+    if (m_guiMessageQueue)
+    {
+        MsgSampleRateNotification *msg = MsgSampleRateNotification::create(inputSampleRate, centerFrequency);
+        m_guiMessageQueue->push(msg);
+    }
+}
+
+void BFMScanner::applySettings(const BFMScannerSettings& settings, bool force)
+{
+    qDebug() << "BFMScanner::applySettings:"
+            << " m_bandLow: " << settings.m_bandLow
+            << " m_bandHigh: " << settings.m_bandHigh
+            << " m_channelSpacing: " << settings.m_channelSpacing
+            << " m_rfBandwidth: " << settings.m_rfBandwidth
+            << " m_threshold: " << settings.m_threshold
+            << " m_maxStations: " << settings.m_maxStations
+            << " m_rgbColor: " << settings.m_rgbColor
+            << " m_title: " << settings.m_title
+            << " m_streamIndex: " << settings.m_streamIndex
+            << " m_useReverseAPI: " << settings.m_useReverseAPI
+            << " m_reverseAPIAddress: " << settings.m_reverseAPIAddress
+            << " m_reverseAPIPort: " << settings.m_reverseAPIPort
+            << " m_reverseAPIDeviceIndex: " << settings.m_reverseAPIDeviceIndex
+            << " m_reverseAPIChannelIndex: " << settings.m_reverseAPIChannelIndex
+            << " force: " << force;
+
+    QList<QString> reverseAPIKeys;
+    bool updateBank = false;
+
+    if ((m_settings.m_bandLow != settings.m_bandLow) || force)
+    {
+        reverseAPIKeys.append("bandLow");
+        updateBank = true;
+    }
+    if ((m_settings.m_bandHigh != settings.m_bandHigh) || force)
+    {
+        reverseAPIKeys.append("bandHigh");
+        updateBank = true;
+    }
+    if ((m_settings.m_channelSpacing != settings.m_channelSpacing) || force)
+    {
+        reverseAPIKeys.append("channelSpacing");
+        updateBank = true;
+    }
+    if ((m_settings.m_rfBandwidth != settings.m_rfBandwidth) || force)
+    {
+        reverseAPIKeys.append("rfBandwidth");
+        updateBank = true;
+    }
+    if ((m_settings.m_threshold != settings.m_threshold) || force)
+    {
+        reverseAPIKeys.append("threshold");
+        updateBank = true;
+    }
+    if ((m_settings.m_maxStations != settings.m_maxStations) || force)
+    {
+        reverseAPIKeys.append("maxStations");
+        updateBank = true;
+    }
+    if ((m_settings.m_rgbColor != settings.m_rgbColor) || force) {
+        reverseAPIKeys.append("rgbColor");
+    }
+    if ((m_settings.m_title != settings.m_title) || force) {
+        reverseAPIKeys.append("title");
+    }
+
+    if (m_settings.m_streamIndex != settings.m_streamIndex)
+    {
+        if (m_deviceAPI->getSampleMIMO()) // change of stream is possible for MIMO devices only
+        {
+            m_deviceAPI->removeChannelSinkAPI(this, m_settings.m_streamIndex);
+            m_deviceAPI->removeChannelSink(m_threadedChannelizer, m_settings.m_streamIndex);
+            m_deviceAPI->addChannelSink(m_threadedChannelizer, settings.m_streamIndex);
+            m_deviceAPI->addChannelSinkAPI(this, settings.m_streamIndex);
+        }
+
+        reverseAPIKeys.append("streamIndex");
+    }
+
+    if (settings.m_useReverseAPI)
+    {
+        bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
+                (m_settings.m_reverseAPIAddress != settings.m_reverseAPIAddress) ||
+                (m_settings.m_reverseAPIPort != settings.m_reverseAPIPort) ||
+                (m_settings.m_reverseAPIDeviceIndex != settings.m_reverseAPIDeviceIndex) ||
+                (m_settings.m_reverseAPIChannelIndex != settings.m_reverseAPIChannelIndex);
+        webapiReverseSendSettings(reverseAPIKeys, settings, fullUpdate || force);
+    }
+
+    m_settingsMutex.lock();
+    m_settings = settings;
+
+    if (updateBank) {
+        m_bank.configure(m_inputSampleRate, m_bankCenterFrequency, m_settings);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+QByteArray BFMScanner::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool BFMScanner::deserialize(const QByteArray& data)
+{
+    if (m_settings.deserialize(data))
+    {
+        MsgConfigureBFMScanner *msg = MsgConfigureBFMScanner::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return true;
+    }
+    else
+    {
+        m_settings.resetToDefaults();
+        MsgConfigureBFMScanner *msg = MsgConfigureBFMScanner::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return false;
+    }
+}
+
+int BFMScanner::webapiSettingsGet(
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setBfmScannerSettings(new SWGSDRangel::SWGBFMScannerSettings());
+    response.getBfmScannerSettings()->init();
+    webapiFormatChannelSettings(response, m_settings);
+    return 200;
+}
+
+int BFMScanner::webapiSettingsPutPatch(
+        bool force,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    BFMScannerSettings settings = m_settings;
+    webapiUpdateChannelSettings(settings, channelSettingsKeys, response);
+
+    MsgConfigureBFMScanner *msg = MsgConfigureBFMScanner::create(settings, force);
+    m_inputMessageQueue.push(msg);
+
+    qDebug("BFMScanner::webapiSettingsPutPatch: forward to GUI: %p", m_guiMessageQueue);
+    if (m_guiMessageQueue) // forward to GUI if any
+    {
+        MsgConfigureBFMScanner *msgToGUI = MsgConfigureBFMScanner::create(settings, force);
+        m_guiMessageQueue->push(msgToGUI);
+    }
+
+    webapiFormatChannelSettings(response, settings);
+
+    return 200;
+}
+
+void BFMScanner::webapiUpdateChannelSettings(
+        BFMScannerSettings& settings,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response)
+{
+    if (channelSettingsKeys.contains("bandLow")) {
+        settings.m_bandLow = response.getBfmScannerSettings()->getBandLow();
+    }
+    if (channelSettingsKeys.contains("bandHigh")) {
+        settings.m_bandHigh = response.getBfmScannerSettings()->getBandHigh();
+    }
+    if (channelSettingsKeys.contains("channelSpacing"))
+    {
+        int channelSpacing = response.getBfmScannerSettings()->getChannelSpacing();
+        settings.m_channelSpacing = channelSpacing < BFMScannerSettings::m_minChannelSpacing ?
+            BFMScannerSettings::m_minChannelSpacing : channelSpacing;
+    }
+    if (channelSettingsKeys.contains("rfBandwidth"))
+    {
+        Real rfBandwidth = response.getBfmScannerSettings()->getRfBandwidth();
+        settings.m_rfBandwidth = rfBandwidth < BFMScannerSettings::m_minRFBandwidth ?
+            BFMScannerSettings::m_minRFBandwidth : rfBandwidth > BFMScannerSettings::m_maxRFBandwidth ?
+                BFMScannerSettings::m_maxRFBandwidth : rfBandwidth;
+    }
+    if (channelSettingsKeys.contains("threshold")) {
+        settings.m_threshold = response.getBfmScannerSettings()->getThreshold();
+    }
+    if (channelSettingsKeys.contains("maxStations"))
+    {
+        int maxStations = response.getBfmScannerSettings()->getMaxStations();
+        settings.m_maxStations = maxStations < 1 ? 1 : maxStations;
+    }
+    if (channelSettingsKeys.contains("rgbColor")) {
+        settings.m_rgbColor = response.getBfmScannerSettings()->getRgbColor();
+    }
+    if (channelSettingsKeys.contains("title")) {
+        settings.m_title = *response.getBfmScannerSettings()->getTitle();
+    }
+    if (channelSettingsKeys.contains("streamIndex")) {
+        settings.m_streamIndex = response.getBfmScannerSettings()->getStreamIndex();
+    }
+    if (channelSettingsKeys.contains("useReverseAPI")) {
+        settings.m_useReverseAPI = response.getBfmScannerSettings()->getUseReverseApi() != 0;
+    }
+    if (channelSettingsKeys.contains("reverseAPIAddress")) {
+        settings.m_reverseAPIAddress = *response.getBfmScannerSettings()->getReverseApiAddress();
+    }
+    if (channelSettingsKeys.contains("reverseAPIPort")) {
+        settings.m_reverseAPIPort = response.getBfmScannerSettings()->getReverseApiPort();
+    }
+    if (channelSettingsKeys.contains("reverseAPIDeviceIndex")) {
+        settings.m_reverseAPIDeviceIndex = response.getBfmScannerSettings()->getReverseApiDeviceIndex();
+    }
+    if (channelSettingsKeys.contains("reverseAPIChannelIndex")) {
+        settings.m_reverseAPIChannelIndex = response.getBfmScannerSettings()->getReverseApiChannelIndex();
+    }
+}
+
+int BFMScanner::webapiReportGet(
+        SWGSDRangel::SWGChannelReport& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setBfmScannerReport(new SWGSDRangel::SWGBFMScannerReport());
+    response.getBfmScannerReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
+void BFMScanner::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const BFMScannerSettings& settings)
+{
+    response.getBfmScannerSettings()->setBandLow(settings.m_bandLow);
+    response.getBfmScannerSettings()->setBandHigh(settings.m_bandHigh);
+    response.getBfmScannerSettings()->setChannelSpacing(settings.m_channelSpacing);
+    response.getBfmScannerSettings()->setRfBandwidth(settings.m_rfBandwidth);
+    response.getBfmScannerSettings()->setThreshold(settings.m_threshold);
+    response.getBfmScannerSettings()->setMaxStations(settings.m_maxStations);
+    response.getBfmScannerSettings()->setRgbColor(settings.m_rgbColor);
+
+    if (response.getBfmScannerSettings()->getTitle()) {
+        *response.getBfmScannerSettings()->getTitle() = settings.m_title;
+    } else {
+        response.getBfmScannerSettings()->setTitle(new QString(settings.m_title));
+    }
+
+    response.getBfmScannerSettings()->setStreamIndex(settings.m_streamIndex);
+    response.getBfmScannerSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
+
+    if (response.getBfmScannerSettings()->getReverseApiAddress()) {
+        *response.getBfmScannerSettings()->getReverseApiAddress() = settings.m_reverseAPIAddress;
+    } else {
+        response.getBfmScannerSettings()->setReverseApiAddress(new QString(settings.m_reverseAPIAddress));
+    }
+
+    response.getBfmScannerSettings()->setReverseApiPort(settings.m_reverseAPIPort);
+    response.getBfmScannerSettings()->setReverseApiDeviceIndex(settings.m_reverseAPIDeviceIndex);
+    response.getBfmScannerSettings()->setReverseApiChannelIndex(settings.m_reverseAPIChannelIndex);
+}
+
+void BFMScanner::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    SWGSDRangel::SWGBFMScannerReport *report = response.getBfmScannerReport();
+    report->setChannelSampleRate(m_inputSampleRate);
+    report->setStationSampleRate(m_bank.getStationSampleRate());
+    report->setNoiseFloorDb(m_bank.getNoiseFloorDb());
+
+    std::vector<BFMScannerBank::StationReport> stations;
+    m_bank.getStations(stations);
+
+    for (const auto& station : stations)
+    {
+        SWGSDRangel::SWGBFMScannerStation *swgStation = new SWGSDRangel::SWGBFMScannerStation();
+        swgStation->init();
+        swgStation->setFrequency(station.m_frequency);
+        swgStation->setActive(station.m_active ? 1 : 0);
+        swgStation->setPowerDb(station.m_powerDb);
+        swgStation->setPilotLocked(station.m_pilotLock ? 1 : 0);
+        swgStation->setRdsSynced(station.m_rdsSynced ? 1 : 0);
+
+        if (station.m_pi != 0) {
+            swgStation->setPid(new QString(QString("%1").arg(station.m_pi, 4, 16, QChar('0')).toUpper()));
+        }
+
+        swgStation->setProgServiceName(new QString(station.m_programServiceName));
+        swgStation->setRadioText(new QString(station.m_radioText));
+        report->getStations()->append(swgStation);
+    }
+}
+
+void BFMScanner::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const BFMScannerSettings& settings, bool force)
+{
+    SWGSDRangel::SWGChannelSettings *swgChannelSettings = new SWGSDRangel::SWGChannelSettings();
+    swgChannelSettings->setDirection(0); // single sink (Rx)
+    swgChannelSettings->setOriginatorChannelIndex(getIndexInDeviceSet());
+    swgChannelSettings->setOriginatorDeviceSetIndex(getDeviceSetIndex());
+    swgChannelSettings->setChannelType(new QString("BFMScanner"));
+    swgChannelSettings->setBfmScannerSettings(new SWGSDRangel::SWGBFMScannerSettings());
+    SWGSDRangel::SWGBFMScannerSettings *swgBFMScannerSettings = swgChannelSettings->getBfmScannerSettings();
+
+    // transfer data that has been modified. When force is on transfer all data except reverse API data
+
+    if (channelSettingsKeys.contains("bandLow") || force) {
+        swgBFMScannerSettings->setBandLow(settings.m_bandLow);
+    }
+    if (channelSettingsKeys.contains("bandHigh") || force) {
+        swgBFMScannerSettings->setBandHigh(settings.m_bandHigh);
+    }
+    if (channelSettingsKeys.contains("channelSpacing") || force) {
+        swgBFMScannerSettings->setChannelSpacing(settings.m_channelSpacing);
+    }
+    if (channelSettingsKeys.contains("rfBandwidth") || force) {
+        swgBFMScannerSettings->setRfBandwidth(settings.m_rfBandwidth);
+    }
+    if (channelSettingsKeys.contains("threshold") || force) {
+        swgBFMScannerSettings->setThreshold(settings.m_threshold);
+    }
+    if (channelSettingsKeys.contains("maxStations") || force) {
+        swgBFMScannerSettings->setMaxStations(settings.m_maxStations);
+    }
+    if (channelSettingsKeys.contains("rgbColor") || force) {
+        swgBFMScannerSettings->setRgbColor(settings.m_rgbColor);
+    }
+    if (channelSettingsKeys.contains("title") || force) {
+        swgBFMScannerSettings->setTitle(new QString(settings.m_title));
+    }
+    if (channelSettingsKeys.contains("streamIndex") || force) {
+        swgBFMScannerSettings->setStreamIndex(settings.m_streamIndex);
+    }
+
+    QString channelSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/channel/%4/settings")
+            .arg(settings.m_reverseAPIAddress)
+            .arg(settings.m_reverseAPIPort)
+            .arg(settings.m_reverseAPIDeviceIndex)
+            .arg(settings.m_reverseAPIChannelIndex);
+    // Always use PATCH to avoid passing reverse API settings
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
+
+    delete swgChannelSettings;
+}
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Broadcast FM band scanner. Takes the whole device baseband and reports the    //
+// stations found in the band with their RDS identification.                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_BFMSCANNER_H
+#define INCLUDE_BFMSCANNER_H
+
+#include <vector>
+
+#include <QMutex>
+
+#include "dsp/basebandsamplesink.h"
+#include "channel/channelapi.h"
+#include "util/message.h"
+
+#include "bfmscannersettings.h"
+#include "bfmscannerbank.h"
+
+class DeviceAPI;
+class DownChannelizer;
+class ThreadedBasebandSampleSink;
+
+class BFMScanner : public BasebandSampleSink, public ChannelAPI {
+	Q_OBJECT
+public:
+    class MsgConfigureBFMScanner : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const BFMScannerSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureBFMScanner* create(const BFMScannerSettings& settings, bool force)
+        {
+            return new MsgConfigureBFMScanner(settings, force);
+        }
+
+    private:
+        BFMScannerSettings m_settings;
+        bool m_force;
+
+        MsgConfigureBFMScanner(const BFMScannerSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgSampleRateNotification : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        static MsgSampleRateNotification* create(int sampleRate, qint64 centerFrequency) {
+            return new MsgSampleRateNotification(sampleRate, centerFrequency);
+        }
+
+        int getSampleRate() const { return m_sampleRate; }
+        qint64 getCenterFrequency() const { return m_centerFrequency; }
+
+    private:
+        MsgSampleRateNotification(int sampleRate, qint64 centerFrequency) :
+            Message(),
+            m_sampleRate(sampleRate),
+            m_centerFrequency(centerFrequency)
+        { }
+
+        int m_sampleRate;
+        qint64 m_centerFrequency;
+    };
+
+    BFMScanner(DeviceAPI *deviceAPI);
+	~BFMScanner();
+	virtual void destroy() { delete this; }
+
+	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+	virtual void start();
+	virtual void stop();
+	virtual bool handleMessage(const Message& cmd);
+
+    virtual void getIdentifier(QString& id) { id = objectName(); }
+    virtual void getTitle(QString& title) { title = m_settings.m_title; }
+    virtual qint64 getCenterFrequency() const { return 0; }
+
+    virtual QByteArray serialize() const;
+    virtual bool deserialize(const QByteArray& data);
+
+    virtual int getNbSinkStreams() const { return 1; }
+    virtual int getNbSourceStreams() const { return 0; }
+
+    virtual qint64 getStreamCenterFrequency(int streamIndex, bool sinkElseSource) const
+    {
+        (void) streamIndex;
+        (void) sinkElseSource;
+        return 0;
+    }
+
+    virtual int webapiSettingsGet(
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiSettingsPutPatch(
+            bool force,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage);
+
+    static void webapiFormatChannelSettings(
+        SWGSDRangel::SWGChannelSettings& response,
+        const BFMScannerSettings& settings);
+
+    static void webapiUpdateChannelSettings(
+            BFMScannerSettings& settings,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response);
+
+    int getSampleRate() const { return m_inputSampleRate; }
+    int getStationSampleRate() const { return m_bank.getStationSampleRate(); }
+    void getStations(std::vector<BFMScannerBank::StationReport>& stations) const { m_bank.getStations(stations); }
+    float getNoiseFloorDb() const { return m_bank.getNoiseFloorDb(); }
+    int getNbActiveStations() const { return m_bank.getNbActiveStations(); }
+
+    uint32_t getNumberOfDeviceStreams() const;
+
+    static const QString m_channelIdURI;
+    static const QString m_channelId;
+
+private:
+	DeviceAPI *m_deviceAPI;
+    ThreadedBasebandSampleSink* m_threadedChannelizer;
+    DownChannelizer* m_channelizer;
+    BFMScannerSettings m_settings;
+
+    int m_deviceSampleRate;
+    qint64 m_centerFrequency;   //!< device center frequency
+    int m_inputSampleRate;
+    qint64 m_bankCenterFrequency;
+    bool m_running;
+
+    BFMScannerBank m_bank;
+	QMutex m_settingsMutex;
+
+    void applySettings(const BFMScannerSettings& settings, bool force = false);
+    void applyChannelSettings(int inputSampleRate, qint64 centerFrequency, bool force = false);
+    void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
+    void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const BFMScannerSettings& settings, bool force);
+};
+
+#endif // INCLUDE_BFMSCANNER_H
@@ -0,0 +1,499 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Filter bank of the broadcast FM scanner. The whole device band goes through   //
+// a single forward FFT per block (overlap-save, half block overlap). Each       //
+// station raster slot takes the bins around its frequency weighted by the       //
+// station filter response. A windowed spectrum taken every few blocks measures  //
+// the slot levels against the noise floor. The slots above the threshold get a  //
+// station that is demodulated by a pool of worker threads.                      //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QRunnable>
+#include <QDebug>
+
+#include "dsp/fftengine.h"
+#include "util/db.h"
+
+#include "bfmscannerstation.h"
+#include "bfmscannerbank.h"
+
+class BFMScannerBank::StationTask : public QRunnable
+{
+public:
+    StationTask(BFMScannerStation *station) :
+        m_station(station)
+    {}
+
+    virtual void run() {
+        m_station->process();
+    }
+
+private:
+    BFMScannerStation *m_station;
+};
+
+const unsigned int BFMScannerBank::m_nbStationBins;
+const int BFMScannerBank::m_maxStationSampleRate;
+const unsigned int BFMScannerBank::m_maxMissCount;
+const float BFMScannerBank::m_scanPeriod = 0.1f;
+const float BFMScannerBank::m_hysteresisDb = 3.0f;
+
+BFMScannerBank::BFMScannerBank() :
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_fftSize(0),
+    m_stepSize(0),
+    m_stationSampleRate(0),
+    m_halfSlotBins(0),
+    m_windowPower(1.0),
+    m_inputFill(0),
+    m_blockCount(0),
+    m_powerDecimation(1),
+    m_nbPowerBlocks(0),
+    m_scanBlocks(1),
+    m_scanBlockCount(0),
+    m_noiseFloorDb(-120.0f)
+{
+    m_fft = FFTEngine::create();
+    m_powerFFT = FFTEngine::create();
+}
+
+BFMScannerBank::~BFMScannerBank()
+{
+    m_workers.waitForDone();
+    clearStations();
+    delete m_powerFFT;
+    delete m_fft;
+}
+
+void BFMScannerBank::clearStations()
+{
+    for (std::map<qint64, BFMScannerStation*>::iterator it = m_stations.begin(); it != m_stations.end(); ++it) {
+        delete it->second;
+    }
+
+    m_stations.clear();
+    m_activeStations.clear();
+}
+
+void BFMScannerBank::configure(int sampleRate, qint64 centerFrequency, const BFMScannerSettings& settings)
+{
+    bool rateChanged = sampleRate != m_sampleRate;
+    bool rasterChanged = (settings.m_bandLow != m_settings.m_bandLow)
+        || (settings.m_bandHigh != m_settings.m_bandHigh)
+        || (settings.m_channelSpacing != m_settings.m_channelSpacing);
+    bool filterChanged = rateChanged || (settings.m_rfBandwidth != m_settings.m_rfBandwidth);
+
+    m_sampleRate = sampleRate;
+    m_centerFrequency = centerFrequency;
+    m_settings = settings;
+
+    if (rateChanged || rasterChanged) {
+        clearStations(); // stations run at a rate derived from the device rate
+    }
+
+    m_slots.clear();
+
+    if ((m_sampleRate <= 0) || !m_fft || !m_powerFFT)
+    {
+        m_fftSize = 0;
+        updateReport();
+        return;
+    }
+
+    if (rateChanged)
+    {
+        // the station rate is the device rate decimated by a power of two
+        unsigned int decimation = 1;
+
+        while (m_sampleRate / decimation > m_maxStationSampleRate) {
+            decimation *= 2;
+        }
+
+        m_fftSize = m_nbStationBins * decimation;
+        m_stepSize = m_fftSize / 2;
+        m_stationSampleRate = m_sampleRate / decimation;
+        m_fft->configure(m_fftSize, false);
+        m_powerFFT->configure(m_fftSize, false);
+        m_window.create(FFTWindow::BlackmanHarris, m_fftSize);
+
+        std::vector<Complex> window(m_fftSize, Complex(1.0f, 0.0f));
+        m_window.apply(window);
+        m_windowPower = 0.0;
+
+        for (unsigned int i = 0; i < m_fftSize; i++) {
+            m_windowPower += std::norm(window[i]);
+        }
+
+        m_windowPower /= m_fftSize;
+        m_input.assign(m_fftSize, Complex(0.0f, 0.0f));
+        m_inputFill = m_fftSize - m_stepSize;
+        m_binPowerSum.assign(m_fftSize, 0.0);
+        m_blockCount = 0;
+        m_scanBlocks = std::max(1U, (unsigned int) ((m_sampleRate * m_scanPeriod) / m_stepSize));
+        m_powerDecimation = std::min(4U, m_scanBlocks);
+
+        qDebug("BFMScannerBank::configure: FFT size: %u station rate: %d S/s", m_fftSize, m_stationSampleRate);
+    }
+
+    if (filterChanged)
+    {
+        // Blackman windowed sinc no longer than the block overlap so that the convolution stays linear
+        unsigned int nbTaps = m_fftSize / 2;
+        double fc = m_settings.m_rfBandwidth / (2.0 * m_sampleRate);
+        double sum = 0.0;
+        Complex *taps = m_fft->in();
+        std::fill(taps, taps + m_fftSize, Complex(0.0f, 0.0f));
+
+        for (unsigned int n = 0; n < nbTaps; n++)
+        {
+            double x = n - (nbTaps - 1) / 2.0;
+            double sinc = x == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * x) / (M_PI * x);
+            double window = 0.42 - 0.5 * cos((2.0 * M_PI * n) / (nbTaps - 1)) + 0.08 * cos((4.0 * M_PI * n) / (nbTaps - 1));
+            taps[n] = Complex(sinc * window, 0.0f);
+            sum += sinc * window;
+        }
+
+        m_fft->transform();
+        const Complex *response = m_fft->out();
+        // unit gain, forward transform size and full scale folded in
+        Real scale = 1.0 / (sum * m_fftSize * SDR_RX_SCALED);
+        int half = m_nbStationBins / 2;
+        m_response.resize(m_nbStationBins);
+
+        for (int m = 0; m < (int) m_nbStationBins; m++)
+        {
+            int k = m < half ? m : m - (int) m_nbStationBins;
+            m_response[m] = response[k & (m_fftSize - 1)] * scale;
+        }
+    }
+
+    m_halfSlotBins = (m_settings.m_rfBandwidth / 2.0) * m_fftSize / m_sampleRate;
+
+    // slots of the raster whose station bins are all in the device band. Only the part of
+    // the raster in the device band is walked whatever the band limits and spacing.
+    qint64 maxOffset = (m_sampleRate - m_stationSampleRate) / 2;
+    qint64 spacing = m_settings.m_channelSpacing < BFMScannerSettings::m_minChannelSpacing ?
+        BFMScannerSettings::m_minChannelSpacing : m_settings.m_channelSpacing;
+    qint64 firstFrequency = m_settings.m_bandLow;
+    qint64 lastFrequency = std::min(m_settings.m_bandHigh, m_centerFrequency + maxOffset);
+
+    if (firstFrequency < m_centerFrequency - maxOffset) {
+        firstFrequency += ((m_centerFrequency - maxOffset - firstFrequency + spacing - 1) / spacing) * spacing;
+    }
+
+    for (qint64 frequency = firstFrequency; frequency <= lastFrequency; frequency += spacing)
+    {
+        qint64 offset = frequency - m_centerFrequency;
+
+        if ((offset < -maxOffset) || (offset > maxOffset)) {
+            continue;
+        }
+
+        Slot slot;
+        slot.m_frequency = frequency;
+        slot.m_binShift = std::round(((double) offset * m_fftSize) / m_sampleRate);
+        slot.m_powerDb = -120.0f;
+        std::map<qint64, BFMScannerStation*>::iterator it = m_stations.find(frequency);
+        slot.m_station = it == m_stations.end() ? nullptr : it->second;
+
+        if (slot.m_station) {
+            slot.m_station->setBinShift(slot.m_binShift);
+        }
+
+        m_slots.push_back(slot);
+    }
+
+    // stations that went out of the device band keep their data but are not demodulated
+    std::vector<BFMScannerStation*> activeStations;
+
+    for (std::vector<Slot>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+    {
+        if (it->m_station && it->m_station->isActive()) {
+            activeStations.push_back(it->m_station);
+        }
+    }
+
+    for (std::vector<BFMScannerStation*>::iterator it = m_activeStations.begin(); it != m_activeStations.end(); ++it)
+    {
+        if (std::find(activeStations.begin(), activeStations.end(), *it) == activeStations.end()) {
+            (*it)->setActive(false);
+        }
+    }
+
+    m_activeStations.swap(activeStations);
+
+    std::fill(m_binPowerSum.begin(), m_binPowerSum.end(), 0.0);
+    m_nbPowerBlocks = 0;
+    m_scanBlockCount = 0;
+    updateReport();
+}
+
+void BFMScannerBank::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if ((m_fftSize == 0) || m_slots.empty()) {
+        return;
+    }
+
+    SampleVector::const_iterator it = begin;
+
+    while (it != end)
+    {
+        unsigned int count = std::min((unsigned int) (end - it), m_fftSize - m_inputFill);
+
+        for (unsigned int i = 0; i < count; i++, ++it) {
+            m_input[m_inputFill + i] = Complex(it->real(), it->imag());
+        }
+
+        m_inputFill += count;
+
+        if (m_inputFill == m_fftSize)
+        {
+            processBlock();
+            std::copy(m_input.begin() + m_stepSize, m_input.end(), m_input.begin());
+            m_inputFill = m_fftSize - m_stepSize;
+        }
+    }
+
+    runStations();
+}
+
+void BFMScannerBank::processBlock()
+{
+    std::copy(m_input.begin(), m_input.end(), m_fft->in());
+    m_fft->transform();
+    const Complex *spectrum = m_fft->out();
+    int nbBins = m_nbStationBins;
+    int half = nbBins / 2;
+    int mask = m_fftSize - 1;
+
+    for (std::vector<BFMScannerStation*>::iterator it = m_activeStations.begin(); it != m_activeStations.end(); ++it)
+    {
+        int shift = (*it)->getBinShift();
+        // the block advance is half the FFT size so an odd bin turns by pi on each block
+        Real sign = ((m_blockCount & 1) && (shift & 1)) ? -1.0f : 1.0f;
+        Complex *bins = (*it)->newBlock();
+
+        for (int m = 0; m < nbBins; m++)
+        {
+            int k = m < half ? m : m - nbBins;
+            bins[m] = spectrum[(shift + k) & mask] * m_response[m] * sign;
+        }
+    }
+
+    if (m_blockCount % m_powerDecimation == 0) {
+        measurePower();
+    }
+
+    m_blockCount++;
+
+    if (++m_scanBlockCount >= m_scanBlocks)
+    {
+        runStations(); // with the blocks received before the change of stations
+        scan();
+        m_scanBlockCount = 0;
+    }
+}
+
+void BFMScannerBank::measurePower()
+{
+    m_window.apply(m_input.data(), m_powerFFT->in());
+    m_powerFFT->transform();
+    const Complex *spectrum = m_powerFFT->out();
+
+    for (unsigned int k = 0; k < m_fftSize; k++) {
+        m_binPowerSum[k] += std::norm(spectrum[k]);
+    }
+
+    m_nbPowerBlocks++;
+}
+
+void BFMScannerBank::runStations()
+{
+    for (std::vector<BFMScannerStation*>::iterator it = m_activeStations.begin(); it != m_activeStations.end(); ++it)
+    {
+        if ((*it)->hasBlocks()) {
+            m_workers.start(new StationTask(*it));
+        }
+    }
+
+    m_workers.waitForDone();
+}
+
+void BFMScannerBank::scan()
+{
+    if (m_nbPowerBlocks == 0) {
+        return;
+    }
+
+    int mask = m_fftSize - 1;
+    double norm = 1.0 / (m_nbPowerBlocks * m_windowPower * m_fftSize * m_fftSize * SDR_RX_SCALED * SDR_RX_SCALED);
+
+    // noise floor from the lower quartile of the bins so that a crowded band does not raise it
+    std::vector<double> binPower(m_binPowerSum);
+    std::nth_element(binPower.begin(), binPower.begin() + m_fftSize/4, binPower.end());
+    float noiseFloorDb = CalcDb::dbPower(binPower[m_fftSize/4] * norm * (2*m_halfSlotBins + 1));
+    float threshold = noiseFloorDb + m_settings.m_threshold;
+    std::vector<Slot*> candidates;
+
+    for (std::vector<Slot>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+    {
+        double power = 0.0;
+
+        for (int k = -m_halfSlotBins; k <= m_halfSlotBins; k++) {
+            power += m_binPowerSum[(it->m_binShift + k) & mask];
+        }
+
+        it->m_powerDb = CalcDb::dbPower(power * norm);
+        BFMScannerStation *station = it->m_station;
+
+        if (station) {
+            station->setPowerDb(it->m_powerDb);
+        }
+
+        if (station && station->isActive())
+        {
+            if (it->m_powerDb < threshold - m_hysteresisDb)
+            {
+                station->setMissCount(station->getMissCount() + 1);
+
+                if (station->getMissCount() >= m_maxMissCount) {
+                    station->setActive(false);
+                }
+            }
+            else
+            {
+                station->setMissCount(0);
+            }
+        }
+        else if (it->m_powerDb > threshold)
+        {
+            candidates.push_back(&(*it));
+        }
+    }
+
+    // strongest stations first within the maximum number of stations
+    std::vector<Slot*> active;
+
+    for (std::vector<Slot>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+    {
+        if (it->m_station && it->m_station->isActive()) {
+            active.push_back(&(*it));
+        }
+    }
+
+    active.insert(active.end(), candidates.begin(), candidates.end());
+    std::sort(active.begin(), active.end(), [](const Slot *a, const Slot *b) { return a->m_powerDb > b->m_powerDb; });
+    m_activeStations.clear();
+
+    for (unsigned int i = 0; i < active.size(); i++)
+    {
+        Slot *slot = active[i];
+
+        if ((int) i >= m_settings.m_maxStations)
+        {
+            if (slot->m_station) {
+                slot->m_station->setActive(false);
+            }
+
+            continue;
+        }
+
+        if (!slot->m_station)
+        {
+            slot->m_station = new BFMScannerStation(slot->m_frequency, m_nbStationBins, m_stationSampleRate);
+            slot->m_station->setBinShift(slot->m_binShift);
+            slot->m_station->setPowerDb(slot->m_powerDb);
+            m_stations[slot->m_frequency] = slot->m_station;
+        }
+
+        if (!slot->m_station->isActive()) {
+            slot->m_station->setActive(true);
+        }
+
+        m_activeStations.push_back(slot->m_station);
+    }
+
+    std::fill(m_binPowerSum.begin(), m_binPowerSum.end(), 0.0);
+    m_nbPowerBlocks = 0;
+
+    m_reportMutex.lock();
+    m_noiseFloorDb = noiseFloorDb;
+    m_reportMutex.unlock();
+
+    updateReport();
+}
+
+void BFMScannerBank::updateReport()
+{
+    std::vector<StationReport> report;
+
+    for (std::map<qint64, BFMScannerStation*>::const_iterator it = m_stations.begin(); it != m_stations.end(); ++it)
+    {
+        const BFMScannerStation *station = it->second;
+        const RDSParser& rdsParser = station->getRDSParser();
+        report.push_back(StationReport());
+        StationReport& stationReport = report.back();
+        stationReport.m_frequency = station->getFrequency();
+        stationReport.m_active = station->isActive();
+        stationReport.m_powerDb = station->getPowerDb();
+        stationReport.m_pilotLock = station->getPilotLock();
+        stationReport.m_rdsSynced = station->getRDSSynced();
+        stationReport.m_pi = rdsParser.m_pi_count > 0 ? rdsParser.m_pi_program_identification : 0;
+
+        if (rdsParser.m_g0_count > 0) {
+            stationReport.m_programServiceName = QString(rdsParser.m_g0_program_service_name).trimmed();
+        }
+
+        if (rdsParser.m_g2_count > 0) {
+            stationReport.m_radioText = QString(rdsParser.m_g2_radiotext).trimmed();
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_reportMutex);
+    m_report.swap(report);
+}
+
+void BFMScannerBank::getStations(std::vector<StationReport>& stations) const
+{
+    QMutexLocker mutexLocker(&m_reportMutex);
+    stations = m_report;
+}
+
+float BFMScannerBank::getNoiseFloorDb() const
+{
+    QMutexLocker mutexLocker(&m_reportMutex);
+    return m_noiseFloorDb;
+}
+
+int BFMScannerBank::getNbActiveStations() const
+{
+    QMutexLocker mutexLocker(&m_reportMutex);
+    int nbActive = 0;
+
+    for (std::vector<StationReport>::const_iterator it = m_report.begin(); it != m_report.end(); ++it)
+    {
+        if (it->m_active) {
+            nbActive++;
+        }
+    }
+
+    return nbActive;
+}
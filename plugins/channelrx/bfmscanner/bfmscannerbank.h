@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Filter bank of the broadcast FM scanner. The whole device band goes through   //
+// a single forward FFT per block (overlap-save, half block overlap). Each       //
+// station raster slot takes the bins around its frequency weighted by the       //
+// station filter response. A windowed spectrum taken every few blocks measures  //
+// the slot levels against the noise floor. The slots above the threshold get a  //
+// station that is demodulated by a pool of worker threads.                      //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERBANK_H_
+#define PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERBANK_H_
+
+#include <vector>
+#include <map>
+
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include "dsp/dsptypes.h"
+#include "dsp/fftwindow.h"
+
+#include "bfmscannersettings.h"
+
+class FFTEngine;
+class BFMScannerStation;
+
+class BFMScannerBank
+{
+public:
+    struct StationReport
+    {
+        qint64 m_frequency;
+        bool m_active;               //!< being demodulated
+        float m_powerDb;
+        bool m_pilotLock;
+        bool m_rdsSynced;
+        unsigned int m_pi;           //!< 0 if not received yet
+        QString m_programServiceName;
+        QString m_radioText;
+    };
+
+    BFMScannerBank();
+    ~BFMScannerBank();
+
+    void configure(int sampleRate, qint64 centerFrequency, const BFMScannerSettings& settings);
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+
+    void getStations(std::vector<StationReport>& stations) const; //!< snapshot of the last scan
+    float getNoiseFloorDb() const;
+    int getStationSampleRate() const { return m_stationSampleRate; }
+    int getNbActiveStations() const;
+
+private:
+    class StationTask;
+
+    struct Slot
+    {
+        qint64 m_frequency;
+        int m_binShift;
+        float m_powerDb;
+        BFMScannerStation *m_station; //!< null until the slot is found above the threshold
+    };
+
+    static const unsigned int m_nbStationBins = 256; //!< station inverse FFT size
+    static const int m_maxStationSampleRate = 500000;
+    static const unsigned int m_maxMissCount = 10;    //!< scans below the threshold before a station is dropped
+    static const float m_scanPeriod;                  //!< seconds between two slot level evaluations
+    static const float m_hysteresisDb;
+
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+    BFMScannerSettings m_settings;
+    unsigned int m_fftSize;
+    unsigned int m_stepSize;           //!< new samples per block
+    int m_stationSampleRate;
+    int m_halfSlotBins;                //!< half of the station bandwidth in bins
+
+    FFTEngine *m_fft;
+    FFTEngine *m_powerFFT;
+    FFTWindow m_window;
+    double m_windowPower;              //!< mean squared window
+    std::vector<Complex> m_input;
+    unsigned int m_inputFill;
+    std::vector<Complex> m_response;   //!< station filter on the station bins with the transforms scaling
+    std::vector<double> m_binPowerSum; //!< windowed spectrum accumulated over the scan period
+    unsigned int m_blockCount;
+    unsigned int m_powerDecimation;    //!< blocks between two level measurements
+    unsigned int m_nbPowerBlocks;
+    unsigned int m_scanBlocks;         //!< blocks between two slot level evaluations
+    unsigned int m_scanBlockCount;
+
+    std::vector<Slot> m_slots;         //!< slots in the device band
+    std::map<qint64, BFMScannerStation*> m_stations; //!< every station found since the last configuration
+    std::vector<BFMScannerStation*> m_activeStations;
+    QThreadPool m_workers;
+
+    std::vector<StationReport> m_report;
+    float m_noiseFloorDb;
+    mutable QMutex m_reportMutex;
+
+    void clearStations();
+    void processBlock();
+    void measurePower();
+    void runStations();
+    void scan();
+    void updateReport();
+};
+
+#endif /* PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERBANK_H_ */
@@ -0,0 +1,372 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QTableWidgetItem>
+#include <QHeaderView>
+#include <QDebug>
+
+#include "bfmscannergui.h"
+
+#include "device/deviceuiset.h"
+#include "ui_bfmscannergui.h"
+#include "plugin/pluginapi.h"
+#include "gui/basicchannelsettingsdialog.h"
+#include "gui/devicestreamselectiondialog.h"
+#include "mainwindow.h"
+
+#include "bfmscanner.h"
+
+BFMScannerGUI* BFMScannerGUI::create(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel)
+{
+	BFMScannerGUI* gui = new BFMScannerGUI(pluginAPI, deviceUISet, rxChannel);
+	return gui;
+}
+
+void BFMScannerGUI::destroy()
+{
+	delete this;
+}
+
+void BFMScannerGUI::setName(const QString& name)
+{
+	setObjectName(name);
+}
+
+QString BFMScannerGUI::getName() const
+{
+	return objectName();
+}
+
+qint64 BFMScannerGUI::getCenterFrequency() const
+{
+	return 0;
+}
+
+void BFMScannerGUI::setCenterFrequency(qint64 centerFrequency)
+{
+    (void) centerFrequency;
+}
+
+void BFMScannerGUI::resetToDefaults()
+{
+    m_settings.resetToDefaults();
+    displaySettings();
+    applySettings(true);
+}
+
+QByteArray BFMScannerGUI::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool BFMScannerGUI::deserialize(const QByteArray& data)
+{
+    if(m_settings.deserialize(data)) {
+        displaySettings();
+        applySettings(true);
+        return true;
+    } else {
+        resetToDefaults();
+        return false;
+    }
+}
+
+bool BFMScannerGUI::handleMessage(const Message& message)
+{
+    if (BFMScanner::MsgSampleRateNotification::match(message))
+    {
+        BFMScanner::MsgSampleRateNotification& notif = (BFMScanner::MsgSampleRateNotification&) message;
+        m_sampleRate = notif.getSampleRate();
+        m_channelMarker.setBandwidth(m_sampleRate);
+        ui->channelRateText->setText(tr("%1k").arg(QString::number(m_sampleRate / 1000.0, 'g', 5)));
+        return true;
+    }
+    else if (BFMScanner::MsgConfigureBFMScanner::match(message))
+    {
+        const BFMScanner::MsgConfigureBFMScanner& cfg = (BFMScanner::MsgConfigureBFMScanner&) message;
+        m_settings = cfg.getSettings();
+        blockApplySettings(true);
+        displaySettings();
+        blockApplySettings(false);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void BFMScannerGUI::handleInputMessages()
+{
+    Message* message;
+
+    while ((message = getInputMessageQueue()->pop()) != 0)
+    {
+        if (handleMessage(*message))
+        {
+            delete message;
+        }
+    }
+}
+
+void BFMScannerGUI::on_bandLow_valueChanged(double value)
+{
+    m_settings.m_bandLow = value * 1e6;
+    applySettings();
+}
+
+void BFMScannerGUI::on_bandHigh_valueChanged(double value)
+{
+    m_settings.m_bandHigh = value * 1e6;
+    applySettings();
+}
+
+void BFMScannerGUI::on_channelSpacing_currentIndexChanged(int index)
+{
+    m_settings.m_channelSpacing = ui->channelSpacing->itemText(index).toInt() * 1000;
+    applySettings();
+}
+
+void BFMScannerGUI::on_maxStations_valueChanged(int value)
+{
+    m_settings.m_maxStations = value;
+    applySettings();
+}
+
+void BFMScannerGUI::on_rfBW_valueChanged(int value)
+{
+    ui->rfBWText->setText(QString("%1 kHz").arg(value * 10));
+    m_settings.m_rfBandwidth = value * 10000;
+    applySettings();
+}
+
+void BFMScannerGUI::on_threshold_valueChanged(int value)
+{
+    ui->thresholdText->setText(QString("%1 dB").arg(value));
+    m_settings.m_threshold = value;
+    applySettings();
+}
+
+void BFMScannerGUI::onWidgetRolled(QWidget* widget, bool rollDown)
+{
+    (void) widget;
+    (void) rollDown;
+}
+
+void BFMScannerGUI::onMenuDialogCalled(const QPoint &p)
+{
+    if (m_contextMenuType == ContextMenuChannelSettings)
+    {
+        BasicChannelSettingsDialog dialog(&m_channelMarker, this);
+        dialog.setUseReverseAPI(m_settings.m_useReverseAPI);
+        dialog.setReverseAPIAddress(m_settings.m_reverseAPIAddress);
+        dialog.setReverseAPIPort(m_settings.m_reverseAPIPort);
+        dialog.setReverseAPIDeviceIndex(m_settings.m_reverseAPIDeviceIndex);
+        dialog.setReverseAPIChannelIndex(m_settings.m_reverseAPIChannelIndex);
+
+        dialog.move(p);
+        dialog.exec();
+
+        m_settings.m_rgbColor = m_channelMarker.getColor().rgb();
+        m_settings.m_title = m_channelMarker.getTitle();
+        m_settings.m_useReverseAPI = dialog.useReverseAPI();
+        m_settings.m_reverseAPIAddress = dialog.getReverseAPIAddress();
+        m_settings.m_reverseAPIPort = dialog.getReverseAPIPort();
+        m_settings.m_reverseAPIDeviceIndex = dialog.getReverseAPIDeviceIndex();
+        m_settings.m_reverseAPIChannelIndex = dialog.getReverseAPIChannelIndex();
+
+        setWindowTitle(m_settings.m_title);
+        setTitleColor(m_settings.m_rgbColor);
+
+        applySettings();
+    }
+    else if ((m_contextMenuType == ContextMenuStreamSettings) && (m_deviceUISet->m_deviceMIMOEngine))
+    {
+        DeviceStreamSelectionDialog dialog(this);
+        dialog.setNumberOfStreams(m_bfmScanner->getNumberOfDeviceStreams());
+        dialog.setStreamIndex(m_settings.m_streamIndex);
+        dialog.move(p);
+        dialog.exec();
+
+        m_settings.m_streamIndex = dialog.getSelectedStreamIndex();
+        m_channelMarker.clearStreamIndexes();
+        m_channelMarker.addStreamIndex(m_settings.m_streamIndex);
+        displayStreamIndex();
+        applySettings();
+    }
+
+    resetContextMenuType();
+}
+
+BFMScannerGUI::BFMScannerGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
+	RollupWidget(parent),
+	ui(new Ui::BFMScannerGUI),
+	m_pluginAPI(pluginAPI),
+	m_deviceUISet(deviceUISet),
+	m_channelMarker(this),
+    m_sampleRate(0),
+	m_doApplySettings(true),
+	m_tickCount(0)
+{
+	ui->setupUi(this);
+	setAttribute(Qt::WA_DeleteOnClose, true);
+	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
+    connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
+
+	m_bfmScanner = reinterpret_cast<BFMScanner*>(rxChannel);
+	m_bfmScanner->setMessageQueueToGUI(getInputMessageQueue());
+
+	connect(&MainWindow::getInstance()->getMasterTimer(), SIGNAL(timeout()), this, SLOT(tick())); // 50 ms
+
+    ui->stations->horizontalHeader()->setStretchLastSection(true);
+
+	m_channelMarker.blockSignals(true);
+	m_channelMarker.setColor(m_settings.m_rgbColor);
+	m_channelMarker.setCenterFrequency(0);
+    m_channelMarker.setTitle("BFM Scanner");
+    m_channelMarker.setMovable(false); // the scanner takes the whole baseband
+    m_channelMarker.blockSignals(false);
+    m_channelMarker.setVisible(true); // activate signal on the last setting only
+
+    setTitleColor(m_channelMarker.getColor());
+    m_settings.setChannelMarker(&m_channelMarker);
+
+    m_deviceUISet->registerRxChannelInstance(BFMScanner::m_channelIdURI, this);
+	m_deviceUISet->addChannelMarker(&m_channelMarker);
+	m_deviceUISet->addRollupWidget(this);
+
+    connect(getInputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+
+	displaySettings();
+	applySettings(true);
+}
+
+BFMScannerGUI::~BFMScannerGUI()
+{
+    m_deviceUISet->removeRxChannelInstance(this);
+	delete m_bfmScanner; // TODO: check this: when the GUI closes it has to delete the demodulator
+	delete ui;
+}
+
+void BFMScannerGUI::blockApplySettings(bool block)
+{
+    m_doApplySettings = !block;
+}
+
+void BFMScannerGUI::applySettings(bool force)
+{
+	if (m_doApplySettings)
+	{
+	    BFMScanner::MsgConfigureBFMScanner* message = BFMScanner::MsgConfigureBFMScanner::create(m_settings, force);
+	    m_bfmScanner->getInputMessageQueue()->push(message);
+	}
+}
+
+void BFMScannerGUI::displaySettings()
+{
+    m_channelMarker.blockSignals(true);
+    m_channelMarker.setCenterFrequency(0);
+    m_channelMarker.setTitle(m_settings.m_title);
+    m_channelMarker.blockSignals(false);
+    m_channelMarker.setColor(m_settings.m_rgbColor); // activate signal on the last setting only
+
+    setTitleColor(m_settings.m_rgbColor);
+    setWindowTitle(m_channelMarker.getTitle());
+
+    blockApplySettings(true);
+
+    ui->bandLow->setValue(m_settings.m_bandLow / 1e6);
+    ui->bandHigh->setValue(m_settings.m_bandHigh / 1e6);
+    int spacingIndex = ui->channelSpacing->findText(QString::number(m_settings.m_channelSpacing / 1000));
+    ui->channelSpacing->setCurrentIndex(spacingIndex < 0 ? 1 : spacingIndex);
+    ui->maxStations->setValue(m_settings.m_maxStations);
+    ui->rfBWText->setText(QString("%1 kHz").arg(m_settings.m_rfBandwidth / 1000.0, 0, 'f', 0));
+    ui->rfBW->setValue(m_settings.m_rfBandwidth / 10000.0);
+    ui->thresholdText->setText(QString("%1 dB").arg(m_settings.m_threshold, 0, 'f', 0));
+    ui->threshold->setValue(m_settings.m_threshold);
+
+    displayStreamIndex();
+
+    blockApplySettings(false);
+}
+
+void BFMScannerGUI::displayStreamIndex()
+{
+    if (m_deviceUISet->m_deviceMIMOEngine) {
+        setStreamIndicator(tr("%1").arg(m_settings.m_streamIndex));
+    } else {
+        setStreamIndicator("S"); // single channel indicator
+    }
+}
+
+void BFMScannerGUI::displayStations()
+{
+    std::vector<BFMScannerBank::StationReport> stations;
+    m_bfmScanner->getStations(stations);
+
+    ui->stationRateText->setText(tr("%1k").arg(QString::number(m_bfmScanner->getStationSampleRate() / 1000.0, 'g', 5)));
+    ui->noiseFloorText->setText(tr("%1 dB").arg(m_bfmScanner->getNoiseFloorDb(), 0, 'f', 1));
+    ui->nbStationsText->setText(tr("%1").arg(m_bfmScanner->getNbActiveStations()));
+
+    ui->stations->setRowCount(stations.size());
+
+    for (unsigned int i = 0; i < stations.size(); i++)
+    {
+        const BFMScannerBank::StationReport& station = stations[i];
+        QStringList row;
+        row << QString::number(station.m_frequency / 1e6, 'f', 2)
+            << QString::number(station.m_powerDb, 'f', 1)
+            << (station.m_pilotLock ? "Y" : "N")
+            << (station.m_rdsSynced ? "Y" : "N")
+            << (station.m_pi == 0 ? QString() : QString("%1").arg(station.m_pi, 4, 16, QChar('0')).toUpper())
+            << station.m_programServiceName
+            << station.m_radioText;
+
+        for (int j = 0; j < row.size(); j++)
+        {
+            QTableWidgetItem *item = ui->stations->item(i, j);
+
+            if (!item)
+            {
+                item = new QTableWidgetItem();
+                ui->stations->setItem(i, j, item);
+            }
+
+            item->setText(row.at(j));
+            item->setForeground(station.m_active ? palette().text() : palette().mid());
+        }
+    }
+}
+
+void BFMScannerGUI::leaveEvent(QEvent*)
+{
+	m_channelMarker.setHighlighted(false);
+}
+
+void BFMScannerGUI::enterEvent(QEvent*)
+{
+	m_channelMarker.setHighlighted(true);
+}
+
+void BFMScannerGUI::tick()
+{
+    if (++m_tickCount == 20) // once per second
+    {
+        displayStations();
+        m_tickCount = 0;
+    }
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_BFMSCANNERGUI_H
+#define INCLUDE_BFMSCANNERGUI_H
+
+#include "plugin/plugininstancegui.h"
+#include "gui/rollupwidget.h"
+#include "dsp/channelmarker.h"
+#include "util/messagequeue.h"
+#include "bfmscannersettings.h"
+
+class PluginAPI;
+class DeviceUISet;
+
+class BFMScanner;
+class BasebandSampleSink;
+
+namespace Ui {
+	class BFMScannerGUI;
+}
+
+class BFMScannerGUI : public RollupWidget, public PluginInstanceGUI {
+	Q_OBJECT
+
+public:
+	static BFMScannerGUI* create(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel);
+	virtual void destroy();
+
+	void setName(const QString& name);
+	QString getName() const;
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data);
+	virtual MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
+	virtual bool handleMessage(const Message& message);
+
+private:
+	Ui::BFMScannerGUI* ui;
+	PluginAPI* m_pluginAPI;
+	DeviceUISet* m_deviceUISet;
+	ChannelMarker m_channelMarker;
+	BFMScannerSettings m_settings;
+    int m_sampleRate;
+	bool m_doApplySettings;
+
+	BFMScanner* m_bfmScanner;
+	uint32_t m_tickCount;
+	MessageQueue m_inputMessageQueue;
+
+	explicit BFMScannerGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent = 0);
+	virtual ~BFMScannerGUI();
+
+    void blockApplySettings(bool block);
+	void applySettings(bool force = false);
+	void displaySettings();
+    void displayStreamIndex();
+    void displayStations();
+
+	void leaveEvent(QEvent*);
+	void enterEvent(QEvent*);
+
+private slots:
+	void on_bandLow_valueChanged(double value);
+	void on_bandHigh_valueChanged(double value);
+    void on_channelSpacing_currentIndexChanged(int index);
+	void on_maxStations_valueChanged(int value);
+	void on_rfBW_valueChanged(int value);
+	void on_threshold_valueChanged(int value);
+	void onWidgetRolled(QWidget* widget, bool rollDown);
+    void onMenuDialogCalled(const QPoint& p);
+    void handleInputMessages();
+	void tick();
+};
+
+#endif // INCLUDE_BFMSCANNERGUI_H
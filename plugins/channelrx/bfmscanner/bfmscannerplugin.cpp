@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QtPlugin>
+#include "plugin/pluginapi.h"
+
+#ifndef SERVER_MODE
+#include "bfmscannergui.h"
+#endif
+#include "bfmscanner.h"
+#include "bfmscannerwebapiadapter.h"
+#include "bfmscannerplugin.h"
+
+const PluginDescriptor BFMScannerPlugin::m_pluginDescriptor = {
+	QString("Broadcast FM Scanner"),
+	QString("4.11.6"),
+	QString("(c) Edouard Griffiths, F4EXB"),
+	QString("https://github.com/f4exb/sdrangel"),
+	true,
+	QString("https://github.com/f4exb/sdrangel")
+};
+
+BFMScannerPlugin::BFMScannerPlugin(QObject* parent) :
+	QObject(parent),
+	m_pluginAPI(0)
+{
+}
+
+const PluginDescriptor& BFMScannerPlugin::getPluginDescriptor() const
+{
+	return m_pluginDescriptor;
+}
+
+void BFMScannerPlugin::initPlugin(PluginAPI* pluginAPI)
+{
+	m_pluginAPI = pluginAPI;
+
+	// register broadcast FM scanner
+	m_pluginAPI->registerRxChannel(BFMScanner::m_channelIdURI, BFMScanner::m_channelId, this);
+}
+
+#ifdef SERVER_MODE
+PluginInstanceGUI* BFMScannerPlugin::createRxChannelGUI(
+        DeviceUISet *deviceUISet,
+        BasebandSampleSink *rxChannel) const
+{
+    return 0;
+}
+#else
+PluginInstanceGUI* BFMScannerPlugin::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const
+{
+	return BFMScannerGUI::create(m_pluginAPI, deviceUISet, rxChannel);
+}
+#endif
+
+BasebandSampleSink* BFMScannerPlugin::createRxChannelBS(DeviceAPI *deviceAPI) const
+{
+    return new BFMScanner(deviceAPI);
+}
+
+ChannelAPI* BFMScannerPlugin::createRxChannelCS(DeviceAPI *deviceAPI) const
+{
+    return new BFMScanner(deviceAPI);
+}
+
+ChannelWebAPIAdapter* BFMScannerPlugin::createChannelWebAPIAdapter() const
+{
+	return new BFMScannerWebAPIAdapter();
+}
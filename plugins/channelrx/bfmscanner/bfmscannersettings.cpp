@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QColor>
+
+#include "util/simpleserializer.h"
+#include "settings/serializable.h"
+
+#include "bfmscannersettings.h"
+
+const int BFMScannerSettings::m_minChannelSpacing;
+const int BFMScannerSettings::m_minRFBandwidth;
+const int BFMScannerSettings::m_maxRFBandwidth;
+
+BFMScannerSettings::BFMScannerSettings() :
+    m_channelMarker(nullptr)
+{
+    resetToDefaults();
+}
+
+void BFMScannerSettings::resetToDefaults()
+{
+    m_bandLow = 87500000;
+    m_bandHigh = 108000000;
+    m_channelSpacing = 100000;
+    m_rfBandwidth = 180000;
+    m_threshold = 15.0;
+    m_maxStations = 32;
+    m_rgbColor = QColor(80, 200, 228).rgb();
+    m_title = "BFM Scanner";
+    m_streamIndex = 0;
+    m_useReverseAPI = false;
+    m_reverseAPIAddress = "127.0.0.1";
+    m_reverseAPIPort = 8888;
+    m_reverseAPIDeviceIndex = 0;
+    m_reverseAPIChannelIndex = 0;
+}
+
+QByteArray BFMScannerSettings::serialize() const
+{
+    SimpleSerializer s(1);
+    s.writeS64(1, m_bandLow);
+    s.writeS64(2, m_bandHigh);
+    s.writeS32(3, m_channelSpacing);
+    s.writeReal(4, m_rfBandwidth);
+    s.writeReal(5, m_threshold);
+    s.writeS32(6, m_maxStations);
+    s.writeU32(7, m_rgbColor);
+    s.writeString(8, m_title);
+
+    if (m_channelMarker) {
+        s.writeBlob(9, m_channelMarker->serialize());
+    }
+
+    s.writeS32(10, m_streamIndex);
+    s.writeBool(11, m_useReverseAPI);
+    s.writeString(12, m_reverseAPIAddress);
+    s.writeU32(13, m_reverseAPIPort);
+    s.writeU32(14, m_reverseAPIDeviceIndex);
+    s.writeU32(15, m_reverseAPIChannelIndex);
+
+    return s.final();
+}
+
+bool BFMScannerSettings::deserialize(const QByteArray& data)
+{
+    SimpleDeserializer d(data);
+
+    if (!d.isValid())
+    {
+        resetToDefaults();
+        return false;
+    }
+
+    if (d.getVersion() == 1)
+    {
+        QByteArray bytetmp;
+        qint32 tmp;
+        uint32_t utmp;
+
+        d.readS64(1, &m_bandLow, 87500000);
+        d.readS64(2, &m_bandHigh, 108000000);
+        d.readS32(3, &tmp, 100000);
+        m_channelSpacing = tmp < m_minChannelSpacing ? m_minChannelSpacing : tmp;
+        d.readReal(4, &m_rfBandwidth, 180000);
+        m_rfBandwidth = m_rfBandwidth < m_minRFBandwidth ? m_minRFBandwidth : m_rfBandwidth > m_maxRFBandwidth ? m_maxRFBandwidth : m_rfBandwidth;
+        d.readReal(5, &m_threshold, 15.0);
+        d.readS32(6, &tmp, 32);
+        m_maxStations = tmp < 1 ? 1 : tmp;
+        d.readU32(7, &m_rgbColor, QColor(80, 200, 228).rgb());
+        d.readString(8, &m_title, "BFM Scanner");
+
+        if (m_channelMarker)
+        {
+            d.readBlob(9, &bytetmp);
+            m_channelMarker->deserialize(bytetmp);
+        }
+
+        d.readS32(10, &m_streamIndex, 0);
+        d.readBool(11, &m_useReverseAPI, false);
+        d.readString(12, &m_reverseAPIAddress, "127.0.0.1");
+        d.readU32(13, &utmp, 0);
+
+        if ((utmp > 1023) && (utmp < 65535)) {
+            m_reverseAPIPort = utmp;
+        } else {
+            m_reverseAPIPort = 8888;
+        }
+
+        d.readU32(14, &utmp, 0);
+        m_reverseAPIDeviceIndex = utmp > 99 ? 99 : utmp;
+        d.readU32(15, &utmp, 0);
+        m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
+
+        return true;
+    }
+    else
+    {
+        resetToDefaults();
+        return false;
+    }
+}
@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSETTINGS_H_
+#define PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSETTINGS_H_
+
+#include <QByteArray>
+#include <QString>
+
+#include "dsp/dsptypes.h"
+
+class Serializable;
+
+struct BFMScannerSettings
+{
+    qint64 m_bandLow;        //!< lowest station frequency (Hz)
+    qint64 m_bandHigh;       //!< highest station frequency (Hz)
+    int m_channelSpacing;    //!< station raster (Hz)
+    Real m_rfBandwidth;      //!< station filter bandwidth (Hz)
+    Real m_threshold;        //!< level above the noise floor for a station to be demodulated (dB)
+    int m_maxStations;       //!< maximum number of stations demodulated at the same time
+    quint32 m_rgbColor;
+    QString m_title;
+    Serializable *m_channelMarker;
+    int m_streamIndex; //!< MIMO channel. Not relevant when connected to SI (single Rx).
+    bool m_useReverseAPI;
+    QString m_reverseAPIAddress;
+    uint16_t m_reverseAPIPort;
+    uint16_t m_reverseAPIDeviceIndex;
+    uint16_t m_reverseAPIChannelIndex;
+
+    static const int m_minChannelSpacing = 10000;
+    static const int m_minRFBandwidth = 100000;
+    static const int m_maxRFBandwidth = 200000; //!< fits in the station slot rate
+
+    BFMScannerSettings();
+    void resetToDefaults();
+    void setChannelMarker(Serializable *channelMarker) { m_channelMarker = channelMarker; }
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+};
+
+#endif /* PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSETTINGS_H_ */
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// One broadcast FM station of the scanner. The scanner filter bank delivers the //
+// spectrum bins around the station frequency block by block. They are brought   //
+// back to the time domain at the station rate, FM demodulated and the RDS       //
+// subcarrier is decoded. There is no audio.                                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "dsp/fftengine.h"
+
+#include "bfmscannerstation.h"
+
+const int BFMScannerStation::m_rdsSampleRate = 62500; // as in BFMDemod
+const int BFMScannerStation::m_fmExcursion = 750000;  // same demodulator scale as BFMDemod
+
+BFMScannerStation::BFMScannerStation(qint64 frequency, unsigned int nbBins, double sampleRate) :
+    m_frequency(frequency),
+    m_nbBins(nbBins),
+    m_sampleRate(sampleRate),
+    m_binShift(0),
+    m_active(false),
+    m_missCount(0),
+    m_powerDb(-120.0f),
+    m_nbBlocks(0),
+    m_pilotPLL(19000.0/sampleRate, 50.0/sampleRate, 0.01)
+{
+    m_ifft = FFTEngine::create();
+
+    if (m_ifft) {
+        m_ifft->configure(m_nbBins, true);
+    }
+
+    m_phaseDiscri.reset();
+    m_phaseDiscri.setFMScaling(m_sampleRate / m_fmExcursion);
+    m_interpolatorRDS.create(4, m_sampleRate, 600.0);
+    m_interpolatorRDSDistance = m_sampleRate / m_rdsSampleRate;
+    m_interpolatorRDSDistanceRemain = m_interpolatorRDSDistance;
+    m_rdsDemod.setSampleRate(m_rdsSampleRate);
+}
+
+BFMScannerStation::~BFMScannerStation()
+{
+    delete m_ifft;
+}
+
+void BFMScannerStation::setActive(bool active)
+{
+    m_active = active;
+    m_missCount = 0;
+    m_nbBlocks = 0;
+}
+
+Complex *BFMScannerStation::newBlock()
+{
+    if (m_blocks.size() < (m_nbBlocks + 1) * m_nbBins) {
+        m_blocks.resize((m_nbBlocks + 1) * m_nbBins);
+    }
+
+    return &m_blocks[m_nbBins * m_nbBlocks++];
+}
+
+void BFMScannerStation::process()
+{
+    if (!m_ifft)
+    {
+        m_nbBlocks = 0;
+        return;
+    }
+
+    Complex cr;
+
+    for (unsigned int b = 0; b < m_nbBlocks; b++)
+    {
+        std::copy(m_blocks.begin() + b*m_nbBins, m_blocks.begin() + (b+1)*m_nbBins, m_ifft->in());
+        m_ifft->transform();
+        const Complex *out = m_ifft->out();
+
+        // the first half is the circular part of the overlap-save convolution
+        for (unsigned int i = m_nbBins/2; i < m_nbBins; i++)
+        {
+            Real demod = m_phaseDiscri.phaseDiscriminator(out[i]);
+            m_pilotPLL.process(demod, m_pilotPLLSamples);
+            Complex r(demod * 2.0 * m_pilotPLLSamples[3], 0.0); // 57 kHz carrier from the pilot
+
+            if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
+            {
+                bool bit;
+
+                if (m_rdsDemod.process(cr.real(), bit))
+                {
+                    if (m_rdsDecoder.frameSync(bit)) {
+                        m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
+                    }
+                }
+
+                m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
+            }
+        }
+    }
+
+    m_nbBlocks = 0;
+}
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// One broadcast FM station of the scanner. The scanner filter bank delivers the //
+// spectrum bins around the station frequency block by block. They are brought   //
+// back to the time domain at the station rate, FM demodulated and the RDS       //
+// subcarrier is decoded. There is no audio.                                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSTATION_H_
+#define PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSTATION_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "dsp/phaselock.h"
+#include "dsp/phasediscri.h"
+#include "dsp/interpolator.h"
+
+#include "rdsdemod.h"
+#include "rdsdecoder.h"
+#include "rdsparser.h"
+
+class FFTEngine;
+
+class BFMScannerStation
+{
+public:
+    BFMScannerStation(qint64 frequency, unsigned int nbBins, double sampleRate);
+    ~BFMScannerStation();
+
+    qint64 getFrequency() const { return m_frequency; }
+    int getBinShift() const { return m_binShift; }
+    void setBinShift(int binShift) { m_binShift = binShift; }
+    bool isActive() const { return m_active; }
+    void setActive(bool active);
+    unsigned int getMissCount() const { return m_missCount; }
+    void setMissCount(unsigned int missCount) { m_missCount = missCount; }
+    float getPowerDb() const { return m_powerDb; }
+    void setPowerDb(float powerDb) { m_powerDb = powerDb; }
+
+    Complex *newBlock();                //!< storage for the bins of the next block
+    bool hasBlocks() const { return m_nbBlocks != 0; }
+    void process();                     //!< run by a worker thread on the blocks received since the last call
+
+    bool getPilotLock() const { return m_pilotPLL.locked(); }
+    bool getRDSSynced() const { return m_rdsDecoder.synced(); }
+    const RDSParser& getRDSParser() const { return m_rdsParser; }
+
+private:
+    qint64 m_frequency;
+    unsigned int m_nbBins;              //!< inverse FFT size. Half of the output is kept (overlap-save).
+    double m_sampleRate;
+    int m_binShift;                     //!< station bin in the filter bank spectrum
+    bool m_active;
+    unsigned int m_missCount;           //!< scans below the threshold since the station was last seen
+    float m_powerDb;
+
+    FFTEngine *m_ifft;
+    std::vector<Complex> m_blocks;
+    unsigned int m_nbBlocks;
+
+    PhaseDiscriminators m_phaseDiscri;
+    RDSPhaseLock m_pilotPLL;
+    Real m_pilotPLLSamples[4];
+    Interpolator m_interpolatorRDS;
+    Real m_interpolatorRDSDistance;
+    Real m_interpolatorRDSDistanceRemain;
+
+    RDSDemod m_rdsDemod;
+    RDSDecoder m_rdsDecoder;
+    RDSParser m_rdsParser;
+
+    static const int m_rdsSampleRate;
+    static const int m_fmExcursion;
+};
+
+#endif /* PLUGINS_CHANNELRX_BFMSCANNER_BFMSCANNERSTATION_H_ */
@@ -19,9 +19,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include <stdio.h>
 #include <complex.h>
@@ -41,6 +38,7 @@
 #include "device/deviceapi.h"
 #include "util/db.h"
 #include "util/stepfunctions.h"
+#include "webapi/webapireversedispatcher.h"
 
 MESSAGE_CLASS_DEFINITION(AMDemod::MsgConfigureAMDemod, Message)
 MESSAGE_CLASS_DEFINITION(AMDemod::MsgConfigureChannelizer, Message)
@@ -90,15 +88,10 @@ AMDemod::AMDemod(DeviceAPI *deviceAPI) :
     m_pllFilt.create(101, m_audioSampleRate, 200.0);
     m_pll.computeCoefficients(0.05, 0.707, 1000);
     m_syncAMBuffIndex = 0;
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
 
 AMDemod::~AMDemod()
 {
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
     m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
@@ -803,38 +796,8 @@ void AMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, con
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
-
-void AMDemod::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "AMDemod::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("AMDemod::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
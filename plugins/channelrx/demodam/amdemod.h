@@ -20,7 +20,6 @@
 
 #include <vector>
 
-#include <QNetworkRequest>
 #include <QMutex>
 
 #include "dsp/basebandsamplesink.h"
@@ -38,8 +37,6 @@
 
 #include "amdemodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class DownChannelizer;
 class ThreadedBasebandSampleSink;
@@ -231,9 +228,6 @@ private:
 
     static const int m_udpBlockSize;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
 	QMutex m_settingsMutex;
 
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
@@ -244,9 +238,6 @@ private:
 
     void processOneSample(Complex &ci);
 
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
-
 };
 
 #endif // INCLUDE_AMDEMOD_H
@@ -27,6 +27,7 @@
 #include "dsp/threadedbasebandsamplesink.h"
 #include "device/deviceapi.h"
 
+#include "atvdemodprocessor.h"
 #include "atvdemod.h"
 
 MESSAGE_CLASS_DEFINITION(ATVDemod::MsgConfigureATVDemod, Message)
@@ -37,56 +38,18 @@ MESSAGE_CLASS_DEFINITION(ATVDemod::MsgReportChannelSampleRateChanged, Message)
 
 const QString ATVDemod::m_channelIdURI = "sdrangel.channel.demodatv";
 const QString ATVDemod::m_channelId = "ATVDemod";
-const int ATVDemod::m_ssbFftLen = 1024;
 
 ATVDemod::ATVDemod(DeviceAPI *deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
         m_deviceAPI(deviceAPI),
         m_scopeSink(0),
-        m_registeredTVScreen(0),
-        m_intNumberSamplePerTop(0),
-        m_intImageIndex(0),
-        m_intSynchroPoints(0),
-        m_blnSynchroDetected(false),
-        m_blnVerticalSynchroDetected(false),
-        m_fltAmpLineAverage(0.0f),
-        m_fltEffMin(2000000000.0f),
-        m_fltEffMax(-2000000000.0f),
-        m_fltAmpMin(-2000000000.0f),
-        m_fltAmpMax(2000000000.0f),
-        m_fltAmpDelta(1.0),
-        m_intColIndex(0),
-        m_intSampleIndex(0),
-        m_intRowIndex(0),
-        m_intLineIndex(0),
-        m_objAvgColIndex(3),
-        m_bfoPLL(200/1000000, 100/1000000, 0.01),
-        m_bfoFilter(200.0, 1000000.0, 0.9),
         m_interpolatorDistance(1.0f),
         m_interpolatorDistanceRemain(0.0f),
-        m_DSBFilter(0),
-        m_DSBFilterBuffer(0),
-        m_DSBFilterBufferIndex(0),
         m_objSettingsMutex(QMutex::Recursive)
 {
     setObjectName(m_channelId);
 
-    //*************** ATV PARAMETERS  ***************
-    //m_intNumberSamplePerLine=0;
-    m_intSynchroPoints=0;
-    m_intNumberOfLines=0;
-    m_interleaved = true;
-
-    m_DSBFilter = new fftfilt((2.0f * m_rfConfig.m_fltRFBandwidth) / 1000000, 2 * m_ssbFftLen); // arbitrary 1 MS/s sample rate
-    m_DSBFilterBuffer = new Complex[m_ssbFftLen];
-    memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
-
-    memset((void*)m_fltBufferI,0,6*sizeof(float));
-    memset((void*)m_fltBufferQ,0,6*sizeof(float));
-
-    m_objPhaseDiscri.setFMScaling(1.0f);
-
-    applyStandard();
+    m_processor = new ATVDemodProcessor();
 
     m_channelizer = new DownChannelizer(this);
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
@@ -102,13 +65,17 @@ ATVDemod::~ATVDemod()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_DSBFilter;
-    delete m_DSBFilterBuffer;
+    delete m_processor;
 }
 
-void ATVDemod::setTVScreen(TVScreen *objScreen)
+TVFrameBuffer *ATVDemod::getFrameBuffer()
 {
-    m_registeredTVScreen = objScreen;
+    return m_processor->getFrameBuffer();
+}
+
+double ATVDemod::getMagSq() const
+{
+    return m_processor->getMagSq();
 }
 
 void ATVDemod::configure(
@@ -171,12 +138,15 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     float fltI;
     float fltQ;
     Complex ci;
+    int nbRF = 0;
 
     //********** Let's rock and roll buddy ! **********
 
     m_objSettingsMutex.lock();
 
-    //********** Accessing ATV Screen context **********
+    if (m_rfBuffer.size() < (unsigned int) (end - begin)) {
+        m_rfBuffer.resize(end - begin);
+    }
 
 #ifdef EXTENDED_DIRECT_SAMPLE
 
@@ -219,18 +189,28 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
         {
             if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
-                demod(ci);
+                m_rfBuffer[nbRF++] = ci;
                 m_interpolatorDistanceRemain += m_interpolatorDistance;
             }
         }
         else
         {
-            demod(c);
+            m_rfBuffer[nbRF++] = c;
         }
     }
 
+    //********** demodulation and rendering of the whole block **********
+
+    m_processor->feed(m_rfBuffer.data(), nbRF);
+
     if ((m_running.m_intVideoTabIndex == 1) && (m_scopeSink != 0)) // do only if scope tab is selected and scope is available
     {
+        const float *video = m_processor->getVideo();
+
+        for (int i = 0; i < nbRF; i++) {
+            m_scopeSampleBuffer.push_back(Sample(video[i]*SDR_RX_SCALEF, 0.0f));
+        }
+
         m_scopeSink->feed(m_scopeSampleBuffer.begin(), m_scopeSampleBuffer.end(), false); // m_ssb = positive only
         m_scopeSampleBuffer.clear();
     }
@@ -245,206 +225,6 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     m_objSettingsMutex.unlock();
 }
 
-void ATVDemod::demod(Complex& c)
-{
-    float fltDivSynchroBlack = 1.0f - m_running.m_fltVoltLevelSynchroBlack;
-    float fltNormI;
-    float fltNormQ;
-    float fltNorm;
-    float fltVal;
-    int intVal;
-
-    //********** FFT filtering **********
-
-    if (m_rfRunning.m_blnFFTFiltering)
-    {
-        int n_out;
-        fftfilt::cmplx *filtered;
-
-        n_out = m_DSBFilter->runAsym(c, &filtered, m_rfRunning.m_enmModulation != ATV_LSB); // all usb except explicitely lsb
-
-        if (n_out > 0)
-        {
-            memcpy((void *) m_DSBFilterBuffer, (const void *) filtered, n_out*sizeof(Complex));
-            m_DSBFilterBufferIndex = 0;
-        }
-
-        m_DSBFilterBufferIndex++;
-    }
-
-    //********** demodulation **********
-
-    const float& fltI = m_rfRunning.m_blnFFTFiltering ? m_DSBFilterBuffer[m_DSBFilterBufferIndex-1].real() : c.real();
-    const float& fltQ = m_rfRunning.m_blnFFTFiltering ? m_DSBFilterBuffer[m_DSBFilterBufferIndex-1].imag() : c.imag();
-    double magSq;
-
-    if ((m_rfRunning.m_enmModulation == ATV_FM1) || (m_rfRunning.m_enmModulation == ATV_FM2))
-    {
-        //Amplitude FM
-        magSq = fltI*fltI + fltQ*fltQ;
-        m_objMagSqAverage(magSq);
-        fltNorm = sqrt(magSq);
-        fltNormI= fltI/fltNorm;
-        fltNormQ= fltQ/fltNorm;
-
-        //-2 > 2 : 0 -> 1 volt
-        //0->0.3 synchro  0.3->1 image
-
-        if (m_rfRunning.m_enmModulation == ATV_FM1)
-        {
-            //YDiff Cd
-            fltVal = m_fltBufferI[0]*(fltNormQ - m_fltBufferQ[1]);
-            fltVal -= m_fltBufferQ[0]*(fltNormI - m_fltBufferI[1]);
-
-            fltVal += 2.0f;
-            fltVal /= 4.0f;
-
-        }
-        else
-        {
-            //YDiff Folded
-            fltVal =  m_fltBufferI[2]*((m_fltBufferQ[5]-fltNormQ)/16.0f + m_fltBufferQ[1] - m_fltBufferQ[3]);
-            fltVal -= m_fltBufferQ[2]*((m_fltBufferI[5]-fltNormI)/16.0f + m_fltBufferI[1] - m_fltBufferI[3]);
-
-            fltVal += 2.125f;
-            fltVal /= 4.25f;
-
-            m_fltBufferI[5]=m_fltBufferI[4];
-            m_fltBufferQ[5]=m_fltBufferQ[4];
-
-            m_fltBufferI[4]=m_fltBufferI[3];
-            m_fltBufferQ[4]=m_fltBufferQ[3];
-
-            m_fltBufferI[3]=m_fltBufferI[2];
-            m_fltBufferQ[3]=m_fltBufferQ[2];
-
-            m_fltBufferI[2]=m_fltBufferI[1];
-            m_fltBufferQ[2]=m_fltBufferQ[1];
-        }
-
-        m_fltBufferI[1]=m_fltBufferI[0];
-        m_fltBufferQ[1]=m_fltBufferQ[0];
-
-        m_fltBufferI[0]=fltNormI;
-        m_fltBufferQ[0]=fltNormQ;
-
-        if (m_rfRunning.m_fmDeviation != 1.0f)
-        {
-            fltVal = ((fltVal - 0.5f) / m_rfRunning.m_fmDeviation) + 0.5f;
-        }
-    }
-    else if (m_rfRunning.m_enmModulation == ATV_AM)
-    {
-        //Amplitude AM
-        magSq = fltI*fltI + fltQ*fltQ;
-        m_objMagSqAverage(magSq);
-        fltNorm = sqrt(magSq);
-        fltVal = fltNorm / SDR_RX_SCALEF;
-
-        //********** Mini and Maxi Amplitude tracking **********
-
-        if(fltVal<m_fltEffMin)
-        {
-            m_fltEffMin=fltVal;
-        }
-
-        if(fltVal>m_fltEffMax)
-        {
-            m_fltEffMax=fltVal;
-        }
-
-        //Normalisation
-        fltVal -= m_fltAmpMin;
-        fltVal /=m_fltAmpDelta;
-    }
-    else if ((m_rfRunning.m_enmModulation == ATV_USB) || (m_rfRunning.m_enmModulation == ATV_LSB))
-    {
-        magSq = fltI*fltI + fltQ*fltQ;
-        m_objMagSqAverage(magSq);
-        fltNorm = sqrt(magSq);
-
-        Real bfoValues[2];
-        float fltFiltered = m_bfoFilter.run(fltI);
-        m_bfoPLL.process(fltFiltered, bfoValues);
-
-        // do the mix
-
-        float mixI = fltI * bfoValues[0] - fltQ * bfoValues[1];
-        float mixQ = fltI * bfoValues[1] + fltQ * bfoValues[0];
-
-        if (m_rfRunning.m_enmModulation == ATV_USB) {
-            fltVal = (mixI + mixQ);
-        } else {
-            fltVal = (mixI - mixQ);
-        }
-
-        //********** Mini and Maxi Amplitude tracking **********
-
-        if(fltVal<m_fltEffMin)
-        {
-            m_fltEffMin=fltVal;
-        }
-
-        if(fltVal>m_fltEffMax)
-        {
-            m_fltEffMax=fltVal;
-        }
-
-        //Normalisation
-        fltVal -= m_fltAmpMin;
-        fltVal /=m_fltAmpDelta;
-    }
-    else if (m_rfRunning.m_enmModulation == ATV_FM3)
-    {
-        float rawDeviation;
-        fltVal = m_objPhaseDiscri.phaseDiscriminatorDelta(c, magSq, rawDeviation) + 0.5f;
-        //fltVal = fltVal < 0.0f ? 0.0f : fltVal > 1.0f ? 1.0f : fltVal;
-        m_objMagSqAverage(magSq);
-        fltNorm = sqrt(magSq);
-    }
-    else
-    {
-        magSq = fltI*fltI + fltQ*fltQ;
-        m_objMagSqAverage(magSq);
-        fltNorm = sqrt(magSq);
-        fltVal = 0.0f;
-    }
-
-    fltVal = m_running.m_blnInvertVideo ? 1.0f - fltVal : fltVal;
-    fltVal = (fltVal < -1.0f) ? -1.0f : (fltVal > 1.0f) ? 1.0f : fltVal;
-
-    if ((m_running.m_intVideoTabIndex == 1) && (m_scopeSink != 0)) { // feed scope buffer only if scope is present and visible
-        m_scopeSampleBuffer.push_back(Sample(fltVal*SDR_RX_SCALEF, 0.0f));
-    }
-
-    m_fltAmpLineAverage += fltVal;
-
-    //********** gray level **********
-    //-0.3 -> 0.7
-    intVal = (int) 255.0*(fltVal - m_running.m_fltVoltLevelSynchroBlack) / fltDivSynchroBlack;
-
-    //0 -> 255
-    if(intVal<0)
-    {
-        intVal=0;
-    }
-    else if(intVal>255)
-    {
-        intVal=255;
-    }
-
-    //********** process video sample **********
-
-    if (m_registeredTVScreen) // can process only if the screen is available (set via the GUI)
-    {
-        if (m_running.m_enmATVStandard == ATVStdHSkip) {
-            processHSkip(fltVal, intVal);
-        } else {
-            processClassic(fltVal, intVal);
-        }
-    }
-}
-
 void ATVDemod::start()
 {
     //m_objTimer.start();
@@ -602,35 +382,7 @@ void ATVDemod::applySettings()
        || (m_config.m_enmATVStandard != m_running.m_enmATVStandard)
        || (m_config.m_intNumberOfLines != m_running.m_intNumberOfLines))
     {
-        m_objSettingsMutex.lock();
-
-        m_intNumberOfLines = m_config.m_intNumberOfLines;
-
-        applyStandard();
-
         m_configPrivate.m_intNumberSamplePerLine = (int) (m_config.m_fltLineDuration * m_config.m_intSampleRate);
-        m_intNumberSamplePerTop = (int) (m_config.m_fltTopDuration * m_config.m_intSampleRate);
-
-        if (m_registeredTVScreen)
-        {
-            //m_registeredTVScreen->setRenderImmediate(!(m_config.m_fltFramePerS > 25.0f));
-            m_registeredTVScreen->resizeTVScreen(
-                    m_configPrivate.m_intNumberSamplePerLine - m_intNumberSamplePerLineSignals,
-                    m_intNumberOfLines - m_intNumberOfBlackLines);
-        }
-
-        qDebug() << "ATVDemod::applySettings:"
-                << " m_fltLineDuration: " << m_config.m_fltLineDuration
-                << " m_fltFramePerS: " << m_config.m_fltFramePerS
-                << " m_intNumberOfLines: " << m_intNumberOfLines
-                << " m_intNumberSamplePerLine: " << m_configPrivate.m_intNumberSamplePerLine
-                << " m_intNumberOfBlackLines: " << m_intNumberOfBlackLines;
-
-        m_intImageIndex = 0;
-        m_intColIndex=0;
-        m_intRowIndex=0;
-
-        m_objSettingsMutex.unlock();
     }
 
     if ((m_configPrivate.m_intTVSampleRate != m_runningPrivate.m_intTVSampleRate)
@@ -641,31 +393,9 @@ void ATVDemod::applySettings()
         forwardSampleRateChange = true;
     }
 
-    if ((m_configPrivate.m_intTVSampleRate != m_runningPrivate.m_intTVSampleRate)
-        || (m_rfConfig.m_fltRFBandwidth != m_rfRunning.m_fltRFBandwidth)
-        || (m_rfConfig.m_fltRFOppBandwidth != m_rfRunning.m_fltRFOppBandwidth))
-    {
-        m_objSettingsMutex.lock();
-        m_DSBFilter->create_asym_filter(m_rfConfig.m_fltRFOppBandwidth / m_configPrivate.m_intTVSampleRate,
-                m_rfConfig.m_fltRFBandwidth / m_configPrivate.m_intTVSampleRate);
-        memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
-        m_DSBFilterBufferIndex = 0;
-        m_objSettingsMutex.unlock();
-    }
-
-    if ((m_configPrivate.m_intTVSampleRate != m_runningPrivate.m_intTVSampleRate)
-        || (m_rfConfig.m_fltBFOFrequency != m_rfRunning.m_fltBFOFrequency))
-    {
-        m_bfoPLL.configure(m_rfConfig.m_fltBFOFrequency / m_configPrivate.m_intTVSampleRate,
-                100.0 / m_configPrivate.m_intTVSampleRate,
-                0.01);
-        m_bfoFilter.setFrequencies(m_rfConfig.m_fltBFOFrequency, m_configPrivate.m_intTVSampleRate);
-    }
-
-    if (m_rfConfig.m_fmDeviation != m_rfRunning.m_fmDeviation)
-    {
-        m_objPhaseDiscri.setFMScaling(1.0f / m_rfConfig.m_fmDeviation);
-    }
+    m_objSettingsMutex.lock();
+    m_processor->applySettings(m_config, m_rfConfig, m_configPrivate.m_intTVSampleRate);
+    m_objSettingsMutex.unlock();
 
     m_running = m_config;
     m_rfRunning = m_rfConfig;
@@ -680,59 +410,6 @@ void ATVDemod::applySettings()
     }
 }
 
-void ATVDemod::applyStandard()
-{
-    switch(m_config.m_enmATVStandard)
-    {
-    case ATVStdHSkip:
-        // what is left in a line for the image
-        m_intNumberOfSyncLines  = 0;
-        m_intNumberOfBlackLines = 0;
-        m_intNumberOfEqLines    = 0; // not applicable
-        m_interleaved = false;
-        break;
-    case ATVStdShort:
-        // what is left in a line for the image
-        m_intNumberOfSyncLines  = 4;
-        m_intNumberOfBlackLines = 4;
-        m_intNumberOfEqLines    = 0;
-        m_interleaved = false;
-        break;
-    case ATVStdShortInterleaved:
-        // what is left in a line for the image
-        m_intNumberOfSyncLines  = 4;
-        m_intNumberOfBlackLines = 4;
-        m_intNumberOfEqLines    = 0;
-        m_interleaved = true;
-        break;
-    case ATVStd405: // Follows loosely the 405 lines standard
-        // what is left in a ine for the image
-        m_intNumberOfSyncLines  = 24; // (15+7)*2 - 20
-        m_intNumberOfBlackLines = 28; // above + 4
-        m_intNumberOfEqLines    = 3;
-        m_interleaved = true;
-        break;
-    case ATVStdPAL525: // Follows PAL-M standard
-        // what is left in a 64/1.008 us line for the image
-        m_intNumberOfSyncLines  = 40; // (15+15)*2 - 20
-        m_intNumberOfBlackLines = 44; // above + 4
-        m_intNumberOfEqLines    = 3;
-        m_interleaved = true;
-        break;
-    case ATVStdPAL625: // Follows PAL-B/G/H standard
-    default:
-        // what is left in a 64 us line for the image
-        m_intNumberOfSyncLines  = 44; // (15+17)*2 - 20
-        m_intNumberOfBlackLines = 48; // above + 4
-        m_intNumberOfEqLines    = 3;
-        m_interleaved = true;
-    }
-
-    // for now all standards apply this
-    m_intNumberSamplePerLineSignals = (int) ((12.0f/64.0f)*m_config.m_fltLineDuration * m_config.m_intSampleRate);  // 12.0 = 7.3 + 4.7
-    m_intNumberSaplesPerHSync = (int) ((9.6f/64.0f)*m_config.m_fltLineDuration * m_config.m_intSampleRate);      // 9.4 = 4.7 + 4.7
-}
-
 int ATVDemod::getSampleRate()
 {
     return m_running.m_intSampleRate;
@@ -745,14 +422,7 @@ int ATVDemod::getEffectiveSampleRate()
 
 bool ATVDemod::getBFOLocked()
 {
-    if ((m_rfRunning.m_enmModulation == ATV_USB) || (m_rfRunning.m_enmModulation == ATV_LSB))
-    {
-        return m_bfoPLL.locked();
-    }
-    else
-    {
-        return false;
-    }
+    return m_processor->getBFOLocked();
 }
 
 float ATVDemod::getRFBandwidthDivisor(ATVModulation modulation)
@@ -30,19 +30,13 @@
 #include "dsp/downchannelizer.h"
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
-#include "util/movingaverage.h"
-#include "dsp/fftfilt.h"
-#include "dsp/agc.h"
-#include "dsp/phaselock.h"
-#include "dsp/recursivefilters.h"
-#include "dsp/phasediscri.h"
-#include "audio/audiofifo.h"
 #include "util/message.h"
-#include "gui/tvscreen.h"
 
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
+class ATVDemodProcessor;
+class TVFrameBuffer;
 
 class ATVDemod : public BasebandSampleSink, public ChannelAPI
 {
@@ -243,10 +237,10 @@ public:
         return m_rfRunning.m_intFrequencyOffset;
     }
 
-    void setTVScreen(TVScreen *objScreen); //!< set by the GUI
+    TVFrameBuffer *getFrameBuffer(); //!< complete frames for the screen
     int getSampleRate();
     int getEffectiveSampleRate();
-    double getMagSq() const { return m_objMagSqAverage; } //!< Beware this is scaled to 2^30
+    double getMagSq() const; //!< Beware this is scaled to 2^30
     bool getBFOLocked();
 
     static const QString m_channelIdURI;
@@ -385,36 +379,6 @@ private:
             }
     };
 
-    /**
-     * Exponential average using integers and alpha as the inverse of a power of two
-     */
-    class AvgExpInt
-    {
-    public:
-        AvgExpInt(int log2Alpha) : m_log2Alpha(log2Alpha), m_m1(0), m_start(true) {}
-        void reset() { m_start = true; }
-
-        int run(int m0)
-        {
-            if (m_start)
-            {
-                m_m1 = m0;
-                m_start = false;
-                return m0;
-            }
-            else
-            {
-                m_m1 = m0 + m_m1 - (m_m1>>m_log2Alpha);
-                return m_m1>>m_log2Alpha;
-            }
-        }
-
-    private:
-        int m_log2Alpha;
-        int m_m1;
-        bool m_start;
-    };
-
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -424,71 +388,20 @@ private:
     BasebandSampleSink* m_scopeSink;
     SampleVector m_scopeSampleBuffer;
 
-    //*************** ATV PARAMETERS  ***************
-    TVScreen *m_registeredTVScreen;
-
-    //int m_intNumberSamplePerLine;
-    int m_intNumberSamplePerTop;
-    int m_intNumberOfLines;
-    int m_intNumberOfSyncLines;          //!< this is the number of non displayable lines at the start of a frame. First displayable row comes next.
-    int m_intNumberOfBlackLines;         //!< this is the total number of lines not part of the image and is used for vertical screen size
-    int m_intNumberOfEqLines;            //!< number of equalizing lines both whole and partial
-    int m_intNumberSamplePerLineSignals; //!< number of samples in the non image part of the line (signals)
-    int m_intNumberSaplesPerHSync;       //!< number of samples per horizontal synchronization pattern (pulse + back porch)
-    bool m_interleaved;                  //!< interleaved image
+    //*************** VIDEO  ***************
 
-    //*************** PROCESSING  ***************
-
-    int m_intImageIndex;
-    int m_intSynchroPoints;
-
-    bool m_blnSynchroDetected;
-    bool m_blnVerticalSynchroDetected;
-
-    float m_fltAmpLineAverage;
-
-    float m_fltEffMin;
-    float m_fltEffMax;
-
-    float m_fltAmpMin;
-    float m_fltAmpMax;
-    float m_fltAmpDelta;
-
-    float m_fltBufferI[6];
-    float m_fltBufferQ[6];
-
-    int m_intColIndex;
-    int m_intSampleIndex;
-    int m_intRowIndex;
-    int m_intLineIndex;
-
-    AvgExpInt m_objAvgColIndex;
-    int m_intAvgColIndex;
-
-    SampleVector m_sampleBuffer;
+    ATVDemodProcessor *m_processor;
+    std::vector<Complex> m_rfBuffer;     //!< samples at the TV sample rate of the block being fed
 
     //*************** RF  ***************
 
-    MovingAverageUtil<double, double, 32> m_objMagSqAverage;
-
     NCO m_nco;
-    SimplePhaseLock m_bfoPLL;
-    SecondOrderRecursiveFilter m_bfoFilter;
 
     // Interpolator group for decimation and/or double sideband RF filtering
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
 
-    // Used for vestigial SSB with asymmetrical filtering (needs double sideband scheme)
-    fftfilt* m_DSBFilter;
-    Complex* m_DSBFilterBuffer;
-    int m_DSBFilterBufferIndex;
-    static const int m_ssbFftLen;
-
-    // Used for FM
-    PhaseDiscriminators m_objPhaseDiscri;
-
     //QElapsedTimer m_objTimer;
 
     ATVConfig m_running;
@@ -503,257 +416,7 @@ private:
     QMutex m_objSettingsMutex;
 
     void applySettings();
-    void applyStandard();
-    void demod(Complex& c);
     static float getRFBandwidthDivisor(ATVModulation modulation);
-
-    inline void processHSkip(float& fltVal, int& intVal)
-    {
-        m_registeredTVScreen->setDataColor(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop, intVal, intVal, intVal);
-
-        // Horizontal Synchro detection
-
-        // Floor Detection 0
-        if (fltVal < m_running.m_fltVoltLevelSynchroTop)
-        {
-            m_intSynchroPoints++;
-        }
-        // Black detection 0.3
-        else if (fltVal > m_running.m_fltVoltLevelSynchroBlack)
-        {
-            m_intSynchroPoints = 0;
-        }
-
-        // sync pulse
-
-        m_blnSynchroDetected = (m_intSynchroPoints == m_intNumberSamplePerTop);
-
-        if (m_blnSynchroDetected)
-        {
-            if (m_intSampleIndex >= (3 * m_runningPrivate.m_intNumberSamplePerLine)/2) // first after skip
-            {
-                //qDebug("VSync: %d %d %d", m_intColIndex, m_intSampleIndex, m_intLineIndex);
-                m_intAvgColIndex = m_intColIndex;
-                m_registeredTVScreen->renderImage(0);
-
-                m_intImageIndex++;
-                m_intLineIndex = 0;
-                m_intRowIndex = 0;
-            }
-
-            m_intSampleIndex = 0;
-        }
-        else
-        {
-            m_intSampleIndex++;
-        }
-
-        if (m_intColIndex < m_runningPrivate.m_intNumberSamplePerLine + m_intNumberSamplePerTop - 1)
-        {
-            m_intColIndex++;
-        }
-        else
-        {
-            if (m_running.m_blnHSync && (m_intLineIndex == 0))
-            {
-                //qDebug("HCorr: %d", m_intAvgColIndex);
-                m_intColIndex = m_intNumberSamplePerTop + (m_runningPrivate.m_intNumberSamplePerLine - m_intAvgColIndex)/2; // amortizing factor 1/2
-            }
-            else
-            {
-                m_intColIndex = m_intNumberSamplePerTop;
-            }
-
-            if ((m_rfRunning.m_enmModulation == ATV_AM)
-                || (m_rfRunning.m_enmModulation == ATV_USB)
-                || (m_rfRunning.m_enmModulation == ATV_LSB))
-            {
-                m_fltAmpMin = m_fltEffMin;
-                m_fltAmpMax = m_fltEffMax;
-                m_fltAmpDelta = m_fltEffMax-m_fltEffMin;
-
-                if(m_fltAmpDelta<=0.0)
-                {
-                    m_fltAmpDelta=1.0f;
-                }
-
-                //Reset extrema
-                m_fltEffMin = 2000000.0f;
-                m_fltEffMax = -2000000.0f;
-            }
-
-            m_registeredTVScreen->selectRow(m_intRowIndex);
-            m_intLineIndex++;
-            m_intRowIndex++;
-        }
-    }
-
-    inline void processClassic(float& fltVal, int& intVal)
-    {
-        int intSynchroTimeSamples= (3 * m_runningPrivate.m_intNumberSamplePerLine)/4;
-        float fltSynchroTrameLevel =  0.5f*((float)intSynchroTimeSamples) * m_running.m_fltVoltLevelSynchroBlack;
-
-        // Horizontal Synchro detection
-
-        // Floor Detection 0
-        if (fltVal < m_running.m_fltVoltLevelSynchroTop)
-        {
-            m_intSynchroPoints++;
-        }
-        // Black detection 0.3
-        else if (fltVal > m_running.m_fltVoltLevelSynchroBlack)
-        {
-            m_intSynchroPoints = 0;
-        }
-
-        m_blnSynchroDetected = (m_intSynchroPoints == m_intNumberSamplePerTop);
-
-        //Horizontal Synchro processing
-
-        bool blnNewLine = false;
-
-        if (m_blnSynchroDetected)
-        {
-            m_intAvgColIndex = m_intSampleIndex - m_intColIndex - (m_intColIndex < m_runningPrivate.m_intNumberSamplePerLine/2 ? 150 : 0);
-            //qDebug("HSync: %d %d %d", m_intSampleIndex, m_intColIndex, m_intAvgColIndex);
-            m_intSampleIndex = 0;
-        }
-        else
-        {
-            m_intSampleIndex++;
-        }
-
-        if (!m_running.m_blnHSync && (m_intColIndex >= m_runningPrivate.m_intNumberSamplePerLine)) // H Sync not active
-        {
-            m_intColIndex = 0;
-            blnNewLine = true;
-        }
-        else if (m_intColIndex >= m_runningPrivate.m_intNumberSamplePerLine + m_intNumberSamplePerTop) // No valid H sync
-        {
-            if (m_running.m_blnHSync && (m_intLineIndex == 0))
-            {
-                //qDebug("HSync: %d %d", m_intColIndex, m_intAvgColIndex);
-                m_intColIndex = m_intNumberSamplePerTop + m_intAvgColIndex/4; // amortizing 1/4
-            }
-            else
-            {
-                m_intColIndex = m_intNumberSamplePerTop;
-            }
-
-            blnNewLine = true;
-        }
-
-        if (blnNewLine)
-        {
-            if ((m_rfRunning.m_enmModulation == ATV_AM)
-                || (m_rfRunning.m_enmModulation == ATV_USB)
-                || (m_rfRunning.m_enmModulation == ATV_LSB))
-            {
-                m_fltAmpMin = m_fltEffMin;
-                m_fltAmpMax = m_fltEffMax;
-                m_fltAmpDelta = m_fltEffMax-m_fltEffMin;
-
-                if(m_fltAmpDelta<=0.0)
-                {
-                    m_fltAmpDelta=1.0f;
-                }
-
-                //Reset extrema
-                m_fltEffMin = 2000000.0f;
-                m_fltEffMax = -2000000.0f;
-            }
-
-            m_fltAmpLineAverage=0.0f;
-
-            //New line + Interleaving
-            m_intRowIndex += m_interleaved ? 2 : 1;
-
-            if (m_intRowIndex < m_intNumberOfLines)
-            {
-                m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
-            }
-
-            m_intLineIndex++;
-        }
-
-        // Filling pixels
-
-        // +4 is to compensate shift due to hsync amortizing factor of 1/4
-        m_registeredTVScreen->setDataColor(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop + 4, intVal, intVal, intVal);
-        m_intColIndex++;
-
-        // Vertical sync and image rendering
-
-        if ((m_running.m_blnVSync) && (m_intLineIndex < m_intNumberOfLines)) // VSync activated and lines in range
-        {
-            if (m_intColIndex >= intSynchroTimeSamples)
-            {
-                if (m_fltAmpLineAverage <= fltSynchroTrameLevel)
-                {
-                    m_fltAmpLineAverage = 0.0f;
-
-                    if (!m_blnVerticalSynchroDetected) // not yet
-                    {
-                        m_blnVerticalSynchroDetected = true; // prevent repetition
-
-                        if ((m_intLineIndex % 2 == 0) || !m_interleaved) // even => odd image
-                        {
-                            m_registeredTVScreen->renderImage(0);
-                            m_intRowIndex = 1;
-                        }
-                        else
-                        {
-                            m_intRowIndex = 0;
-                        }
-
-                        m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
-                        m_intLineIndex = 0;
-                        m_intImageIndex++;
-                    }
-                }
-                else
-                {
-                    m_blnVerticalSynchroDetected = false; // reset
-                }
-            }
-        }
-        else // no VSync or lines out of range => arbitrary
-        {
-            if (m_intLineIndex >= m_intNumberOfLines/2)
-            {
-                if (m_intImageIndex % 2 == 1) // odd image
-                {
-                    m_registeredTVScreen->renderImage(0);
-
-                    if (m_rfRunning.m_enmModulation == ATV_AM)
-                    {
-                        m_fltAmpMin = m_fltEffMin;
-                        m_fltAmpMax = m_fltEffMax;
-                        m_fltAmpDelta = m_fltEffMax-m_fltEffMin;
-
-                        if(m_fltAmpDelta<=0.0)
-                        {
-                            m_fltAmpDelta=1.0f;
-                        }
-
-                        //Reset extrema
-                        m_fltEffMin = 2000000.0f;
-                        m_fltEffMax = -2000000.0f;
-                    }
-
-                    m_intRowIndex = 1;
-                }
-                else
-                {
-                    m_intRowIndex = 0;
-                }
-
-                m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
-                m_intLineIndex = 0;
-                m_intImageIndex++;
-            }
-        }
-    }
 };
 
 #endif // INCLUDE_ATVDEMOD_H
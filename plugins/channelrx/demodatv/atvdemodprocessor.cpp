@@ -0,0 +1,474 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+#include <string.h>
+
+#include <QDebug>
+
+#include "atvdemodprocessor.h"
+
+const int ATVDemodProcessor::m_ssbFftLen = 1024;
+const int ATVDemodProcessor::m_nbNormHistory = 6;
+
+ATVDemodProcessor::ATVDemodProcessor() :
+    m_tvSampleRate(0),
+    m_intNumberSamplePerLine(0),
+    m_intNumberSamplePerTop(0),
+    m_intNumberOfLines(0),
+    m_intCols(0),
+    m_intRows(0),
+    m_intImageIndex(0),
+    m_intSynchroPoints(0),
+    m_blnSynchroDetected(false),
+    m_blnVerticalSynchroDetected(false),
+    m_fltAmpLineAverage(0.0f),
+    m_fltEffMin(2000000000.0f),
+    m_fltEffMax(-2000000000.0f),
+    m_fltAmpMin(-2000000000.0f),
+    m_fltAmpMax(2000000000.0f),
+    m_fltAmpDelta(1.0f),
+    m_fltAmpInvDelta(1.0f),
+    m_intColIndex(0),
+    m_intSampleIndex(0),
+    m_intRowIndex(0),
+    m_intLineIndex(0),
+    m_intAvgColIndex(0),
+    m_frame(nullptr),
+    m_row(nullptr),
+    m_intSelectedRow(0),
+    m_bfoPLL(200/1000000, 100/1000000, 0.01),
+    m_bfoFilter(200.0, 1000000.0, 0.9),
+    m_DSBFilterBufferIndex(0)
+{
+    m_DSBFilter = new fftfilt((2.0f * m_rfRunning.m_fltRFBandwidth) / 1000000, 2 * m_ssbFftLen); // arbitrary 1 MS/s sample rate
+    m_DSBFilterBuffer = new Complex[m_ssbFftLen];
+    memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
+
+    m_normI.assign(m_nbNormHistory, 0.0f);
+    m_normQ.assign(m_nbNormHistory, 0.0f);
+
+    m_objPhaseDiscri.setFMScaling(1.0f);
+
+    applyStandard(m_running);
+}
+
+ATVDemodProcessor::~ATVDemodProcessor()
+{
+    delete m_DSBFilter;
+    delete[] m_DSBFilterBuffer;
+}
+
+void ATVDemodProcessor::applySettings(const ATVDemod::ATVConfig& config, const ATVDemod::ATVRFConfig& rfConfig, int tvSampleRate)
+{
+    if ((config.m_fltFramePerS != m_running.m_fltFramePerS)
+       || (config.m_fltLineDuration != m_running.m_fltLineDuration)
+       || (config.m_intSampleRate != m_running.m_intSampleRate)
+       || (config.m_fltTopDuration != m_running.m_fltTopDuration)
+       || (config.m_fltRatioOfRowsToDisplay != m_running.m_fltRatioOfRowsToDisplay)
+       || (config.m_enmATVStandard != m_running.m_enmATVStandard)
+       || (config.m_intNumberOfLines != m_running.m_intNumberOfLines))
+    {
+        m_intNumberOfLines = config.m_intNumberOfLines;
+
+        applyStandard(config);
+
+        m_intNumberSamplePerLine = (int) (config.m_fltLineDuration * config.m_intSampleRate);
+        m_intNumberSamplePerTop = (int) (config.m_fltTopDuration * config.m_intSampleRate);
+        m_intCols = m_intNumberSamplePerLine - m_intNumberSamplePerLineSignals;
+        m_intRows = m_intNumberOfLines - m_intNumberOfBlackLines;
+        m_frame = (m_intCols > 0) && (m_intRows > 0) ? m_frameBuffer.getBackFrame(m_intCols, m_intRows) : nullptr;
+
+        qDebug() << "ATVDemodProcessor::applySettings:"
+                << " m_fltLineDuration: " << config.m_fltLineDuration
+                << " m_fltFramePerS: " << config.m_fltFramePerS
+                << " m_intNumberOfLines: " << m_intNumberOfLines
+                << " m_intNumberSamplePerLine: " << m_intNumberSamplePerLine
+                << " m_intNumberOfBlackLines: " << m_intNumberOfBlackLines
+                << " frame: " << m_intCols << "x" << m_intRows;
+
+        m_intImageIndex = 0;
+        m_intColIndex=0;
+        m_intRowIndex=0;
+        selectRow(-1); // no row until the next line
+    }
+
+    if ((tvSampleRate != m_tvSampleRate)
+        || (rfConfig.m_fltRFBandwidth != m_rfRunning.m_fltRFBandwidth)
+        || (rfConfig.m_fltRFOppBandwidth != m_rfRunning.m_fltRFOppBandwidth))
+    {
+        m_DSBFilter->create_asym_filter(rfConfig.m_fltRFOppBandwidth / tvSampleRate,
+                rfConfig.m_fltRFBandwidth / tvSampleRate);
+        memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
+        m_DSBFilterBufferIndex = 0;
+    }
+
+    if ((tvSampleRate != m_tvSampleRate)
+        || (rfConfig.m_fltBFOFrequency != m_rfRunning.m_fltBFOFrequency))
+    {
+        m_bfoPLL.configure(rfConfig.m_fltBFOFrequency / tvSampleRate,
+                100.0 / tvSampleRate,
+                0.01);
+        m_bfoFilter.setFrequencies(rfConfig.m_fltBFOFrequency, tvSampleRate);
+    }
+
+    if (rfConfig.m_fmDeviation != m_rfRunning.m_fmDeviation)
+    {
+        m_objPhaseDiscri.setFMScaling(1.0f / rfConfig.m_fmDeviation);
+    }
+
+    m_running = config;
+    m_rfRunning = rfConfig;
+    m_tvSampleRate = tvSampleRate;
+}
+
+void ATVDemodProcessor::applyStandard(const ATVDemod::ATVConfig& config)
+{
+    switch(config.m_enmATVStandard)
+    {
+    case ATVDemod::ATVStdHSkip:
+        // what is left in a line for the image
+        m_intNumberOfSyncLines  = 0;
+        m_intNumberOfBlackLines = 0;
+        m_intNumberOfEqLines    = 0; // not applicable
+        m_interleaved = false;
+        break;
+    case ATVDemod::ATVStdShort:
+        // what is left in a line for the image
+        m_intNumberOfSyncLines  = 4;
+        m_intNumberOfBlackLines = 4;
+        m_intNumberOfEqLines    = 0;
+        m_interleaved = false;
+        break;
+    case ATVDemod::ATVStdShortInterleaved:
+        // what is left in a line for the image
+        m_intNumberOfSyncLines  = 4;
+        m_intNumberOfBlackLines = 4;
+        m_intNumberOfEqLines    = 0;
+        m_interleaved = true;
+        break;
+    case ATVDemod::ATVStd405: // Follows loosely the 405 lines standard
+        // what is left in a ine for the image
+        m_intNumberOfSyncLines  = 24; // (15+7)*2 - 20
+        m_intNumberOfBlackLines = 28; // above + 4
+        m_intNumberOfEqLines    = 3;
+        m_interleaved = true;
+        break;
+    case ATVDemod::ATVStdPAL525: // Follows PAL-M standard
+        // what is left in a 64/1.008 us line for the image
+        m_intNumberOfSyncLines  = 40; // (15+15)*2 - 20
+        m_intNumberOfBlackLines = 44; // above + 4
+        m_intNumberOfEqLines    = 3;
+        m_interleaved = true;
+        break;
+    case ATVDemod::ATVStdPAL625: // Follows PAL-B/G/H standard
+    default:
+        // what is left in a 64 us line for the image
+        m_intNumberOfSyncLines  = 44; // (15+17)*2 - 20
+        m_intNumberOfBlackLines = 48; // above + 4
+        m_intNumberOfEqLines    = 3;
+        m_interleaved = true;
+    }
+
+    // for now all standards apply this
+    m_intNumberSamplePerLineSignals = (int) ((12.0f/64.0f)*config.m_fltLineDuration * config.m_intSampleRate);  // 12.0 = 7.3 + 4.7
+    m_intNumberSaplesPerHSync = (int) ((9.6f/64.0f)*config.m_fltLineDuration * config.m_intSampleRate);      // 9.4 = 4.7 + 4.7
+}
+
+bool ATVDemodProcessor::getBFOLocked() const
+{
+    if ((m_rfRunning.m_enmModulation == ATVDemod::ATV_USB) || (m_rfRunning.m_enmModulation == ATVDemod::ATV_LSB)) {
+        return m_bfoPLL.locked();
+    } else {
+        return false;
+    }
+}
+
+void ATVDemodProcessor::resizeBuffers(int nbSamples)
+{
+    if ((int) m_video.size() < nbSamples)
+    {
+        m_filtered.resize(nbSamples);
+        m_video.resize(nbSamples);
+        m_gray.resize(nbSamples);
+        m_normI.resize(nbSamples + m_nbNormHistory);
+        m_normQ.resize(nbSamples + m_nbNormHistory);
+    }
+}
+
+void ATVDemodProcessor::feed(const Complex *samples, int nbSamples)
+{
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    resizeBuffers(nbSamples);
+
+    //********** FFT filtering **********
+
+    const Complex *rf = samples;
+
+    if (m_rfRunning.m_blnFFTFiltering)
+    {
+        filterDSB(samples, nbSamples);
+        rf = m_filtered.data();
+    }
+
+    //********** demodulation **********
+
+    switch (m_rfRunning.m_enmModulation)
+    {
+    case ATVDemod::ATV_FM1:
+    case ATVDemod::ATV_FM2:
+        demodFM(rf, nbSamples);
+        break;
+    case ATVDemod::ATV_FM3:
+        demodFM3(samples, nbSamples); // the phase discriminator always worked on the unfiltered signal
+        break;
+    case ATVDemod::ATV_AM:
+        demodAM(rf, nbSamples);
+        break;
+    case ATVDemod::ATV_USB:
+    case ATVDemod::ATV_LSB:
+        demodSSB(rf, nbSamples);
+        break;
+    default:
+        feedMagSq(rf, nbSamples);
+        std::fill(m_video.begin(), m_video.begin() + nbSamples, 0.0f);
+        break;
+    }
+
+    //********** video levels, synchronization and rendering **********
+
+    processLevels(nbSamples);
+}
+
+void ATVDemodProcessor::filterDSB(const Complex *samples, int nbSamples)
+{
+    bool usb = m_rfRunning.m_enmModulation != ATVDemod::ATV_LSB; // all usb except explicitely lsb
+    fftfilt::cmplx *filtered;
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        int n_out = m_DSBFilter->runAsym(samples[i], &filtered, usb);
+
+        if (n_out > 0)
+        {
+            memcpy((void *) m_DSBFilterBuffer, (const void *) filtered, n_out*sizeof(Complex));
+            m_DSBFilterBufferIndex = 0;
+        }
+
+        m_DSBFilterBufferIndex++;
+        m_filtered[i] = m_DSBFilterBuffer[m_DSBFilterBufferIndex-1];
+    }
+}
+
+void ATVDemodProcessor::feedMagSq(const Complex *samples, int nbSamples)
+{
+    // only the last samples of the block count in the moving average
+    for (int i = std::max(0, nbSamples - 32); i < nbSamples; i++) {
+        m_objMagSqAverage(samples[i].real()*samples[i].real() + samples[i].imag()*samples[i].imag());
+    }
+}
+
+void ATVDemodProcessor::demodFM(const Complex *samples, int nbSamples)
+{
+    feedMagSq(samples, nbSamples);
+
+    // normalized samples after the history of the previous block
+    float *normI = m_normI.data() + m_nbNormHistory;
+    float *normQ = m_normQ.data() + m_nbNormHistory;
+    float *video = m_video.data();
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        float fltI = samples[i].real();
+        float fltQ = samples[i].imag();
+        float fltInvNorm = 1.0f / std::sqrt(fltI*fltI + fltQ*fltQ);
+        normI[i] = fltI * fltInvNorm;
+        normQ[i] = fltQ * fltInvNorm;
+    }
+
+    //-2 > 2 : 0 -> 1 volt
+    //0->0.3 synchro  0.3->1 image
+
+    if (m_rfRunning.m_enmModulation == ATVDemod::ATV_FM1)
+    {
+        //YDiff Cd
+        for (int i = 0; i < nbSamples; i++)
+        {
+            float fltVal = normI[i-1]*(normQ[i] - normQ[i-2]) - normQ[i-1]*(normI[i] - normI[i-2]);
+            video[i] = (fltVal + 2.0f) * 0.25f;
+        }
+    }
+    else
+    {
+        //YDiff Folded
+        const float fltScale = 1.0f / 4.25f;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            float fltVal =  normI[i-3]*((normQ[i-6] - normQ[i])*0.0625f + normQ[i-2] - normQ[i-4]);
+            fltVal -= normQ[i-3]*((normI[i-6] - normI[i])*0.0625f + normI[i-2] - normI[i-4]);
+            video[i] = (fltVal + 2.125f) * fltScale;
+        }
+    }
+
+    if (m_rfRunning.m_fmDeviation != 1.0f)
+    {
+        const float fltInvDeviation = 1.0f / m_rfRunning.m_fmDeviation;
+
+        for (int i = 0; i < nbSamples; i++) {
+            video[i] = ((video[i] - 0.5f) * fltInvDeviation) + 0.5f;
+        }
+    }
+
+    // keep the history for the next block
+    std::copy(m_normI.begin() + nbSamples, m_normI.begin() + nbSamples + m_nbNormHistory, m_normI.begin());
+    std::copy(m_normQ.begin() + nbSamples, m_normQ.begin() + nbSamples + m_nbNormHistory, m_normQ.begin());
+}
+
+void ATVDemodProcessor::demodFM3(const Complex *samples, int nbSamples)
+{
+    double magSq;
+    Real rawDeviation;
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        m_video[i] = m_objPhaseDiscri.phaseDiscriminatorDelta(samples[i], magSq, rawDeviation) + 0.5f;
+        m_objMagSqAverage(magSq);
+    }
+}
+
+void ATVDemodProcessor::demodAM(const Complex *samples, int nbSamples)
+{
+    feedMagSq(samples, nbSamples);
+
+    // raw amplitude: normalized with the extrema of the previous line when the levels are processed
+    for (int i = 0; i < nbSamples; i++) {
+        m_video[i] = std::sqrt(samples[i].real()*samples[i].real() + samples[i].imag()*samples[i].imag()) / SDR_RX_SCALEF;
+    }
+}
+
+void ATVDemodProcessor::demodSSB(const Complex *samples, int nbSamples)
+{
+    feedMagSq(samples, nbSamples);
+    Real bfoValues[2];
+    bool usb = m_rfRunning.m_enmModulation == ATVDemod::ATV_USB;
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        float fltI = samples[i].real();
+        float fltQ = samples[i].imag();
+        float fltFiltered = m_bfoFilter.run(fltI);
+        m_bfoPLL.process(fltFiltered, bfoValues);
+
+        // do the mix
+
+        float mixI = fltI * bfoValues[0] - fltQ * bfoValues[1];
+        float mixQ = fltI * bfoValues[1] + fltQ * bfoValues[0];
+
+        m_video[i] = usb ? mixI + mixQ : mixI - mixQ;
+    }
+}
+
+void ATVDemodProcessor::convertLevels(int nbSamples)
+{
+    const float fltGrayScale = 255.0f / (1.0f - m_running.m_fltVoltLevelSynchroBlack);
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        m_video[i] = videoLevel(m_video[i]);
+        m_gray[i] = grayLevel(m_video[i], fltGrayScale);
+    }
+}
+
+void ATVDemodProcessor::processLevels(int nbSamples)
+{
+    bool amplitudeTracking = (m_rfRunning.m_enmModulation == ATVDemod::ATV_AM)
+        || (m_rfRunning.m_enmModulation == ATVDemod::ATV_USB)
+        || (m_rfRunning.m_enmModulation == ATVDemod::ATV_LSB);
+
+    // With FM the levels do not depend on the synchronization and are converted in one pass.
+    // With AM the amplitude range is that of the previous line so it is applied as lines go.
+    if (!amplitudeTracking) {
+        convertLevels(nbSamples);
+    }
+
+    const float fltGrayScale = 255.0f / (1.0f - m_running.m_fltVoltLevelSynchroBlack);
+    bool hSkip = m_running.m_enmATVStandard == ATVDemod::ATVStdHSkip;
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        if (amplitudeTracking)
+        {
+            float fltVal = m_video[i];
+
+            //********** Mini and Maxi Amplitude tracking **********
+
+            if (fltVal < m_fltEffMin) {
+                m_fltEffMin = fltVal;
+            }
+
+            if (fltVal > m_fltEffMax) {
+                m_fltEffMax = fltVal;
+            }
+
+            //Normalisation
+            m_video[i] = videoLevel((fltVal - m_fltAmpMin) * m_fltAmpInvDelta);
+            m_gray[i] = grayLevel(m_video[i], fltGrayScale);
+        }
+
+        m_fltAmpLineAverage += m_video[i];
+
+        if (hSkip) {
+            processHSkip(m_video[i], m_gray[i]);
+        } else {
+            processClassic(m_video[i], m_gray[i]);
+        }
+    }
+}
+
+void ATVDemodProcessor::updateAmplitudeRange()
+{
+    m_fltAmpMin = m_fltEffMin;
+    m_fltAmpMax = m_fltEffMax;
+    m_fltAmpDelta = m_fltEffMax-m_fltEffMin;
+
+    if (m_fltAmpDelta <= 0.0)
+    {
+        m_fltAmpDelta=1.0f;
+    }
+
+    m_fltAmpInvDelta = 1.0f / m_fltAmpDelta;
+
+    //Reset extrema
+    m_fltEffMin = 2000000.0f;
+    m_fltEffMax = -2000000.0f;
+}
+
+void ATVDemodProcessor::renderFrame()
+{
+    if (m_frame)
+    {
+        m_frameBuffer.publishFrame();
+        // drawing goes on in the new back frame from the same row
+        m_frame = m_frameBuffer.getBackFrame(m_intCols, m_intRows);
+        selectRow(m_intSelectedRow);
+    }
+}
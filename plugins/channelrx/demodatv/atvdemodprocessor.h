@@ -0,0 +1,385 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_ATVDEMODPROCESSOR_H
+#define INCLUDE_ATVDEMODPROCESSOR_H
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "dsp/fftfilt.h"
+#include "dsp/phaselock.h"
+#include "dsp/recursivefilters.h"
+#include "dsp/phasediscri.h"
+#include "dsp/tvframebuffer.h"
+#include "util/movingaverage.h"
+
+#include "atvdemod.h"
+
+/**
+ * Video chain of the ATV demodulator working on blocks of samples at the TV sample rate.
+ * A block is demodulated in one loop per modulation into a buffer of video levels that is
+ * converted to gray levels in a second pass. The synchronization then walks the buffers and
+ * stores the gray levels in the rows of the back frame of a double buffer. The frame is
+ * published to the screen when the image is complete. Nothing here depends on the GUI so
+ * that the chain can be run headless.
+ */
+class ATVDemodProcessor
+{
+public:
+    ATVDemodProcessor();
+    ~ATVDemodProcessor();
+
+    void applySettings(const ATVDemod::ATVConfig& config, const ATVDemod::ATVRFConfig& rfConfig, int tvSampleRate);
+    void feed(const Complex *samples, int nbSamples);
+
+    const float *getVideo() const { return m_video.data(); } //!< video levels of the last block
+    TVFrameBuffer *getFrameBuffer() { return &m_frameBuffer; }
+    int getNumberSamplePerLine() const { return m_intNumberSamplePerLine; }
+    double getMagSq() const { return m_objMagSqAverage; } //!< Beware this is scaled to 2^30
+    bool getBFOLocked() const;
+
+private:
+    static const int m_ssbFftLen;
+    static const int m_nbNormHistory; //!< past normalized samples used by the FM discriminators
+
+    ATVDemod::ATVConfig m_running;
+    ATVDemod::ATVRFConfig m_rfRunning;
+    int m_tvSampleRate;
+
+    //*************** ATV PARAMETERS  ***************
+
+    int m_intNumberSamplePerLine;
+    int m_intNumberSamplePerTop;
+    int m_intNumberOfLines;
+    int m_intNumberOfSyncLines;          //!< this is the number of non displayable lines at the start of a frame. First displayable row comes next.
+    int m_intNumberOfBlackLines;         //!< this is the total number of lines not part of the image and is used for vertical screen size
+    int m_intNumberOfEqLines;            //!< number of equalizing lines both whole and partial
+    int m_intNumberSamplePerLineSignals; //!< number of samples in the non image part of the line (signals)
+    int m_intNumberSaplesPerHSync;       //!< number of samples per horizontal synchronization pattern (pulse + back porch)
+    bool m_interleaved;                  //!< interleaved image
+    int m_intCols;                       //!< frame width
+    int m_intRows;                       //!< frame height
+
+    //*************** PROCESSING  ***************
+
+    int m_intImageIndex;
+    int m_intSynchroPoints;
+
+    bool m_blnSynchroDetected;
+    bool m_blnVerticalSynchroDetected;
+
+    float m_fltAmpLineAverage;
+
+    float m_fltEffMin;
+    float m_fltEffMax;
+
+    float m_fltAmpMin;
+    float m_fltAmpMax;
+    float m_fltAmpDelta;
+    float m_fltAmpInvDelta;
+
+    int m_intColIndex;
+    int m_intSampleIndex;
+    int m_intRowIndex;
+    int m_intLineIndex;
+    int m_intAvgColIndex;
+
+    //*************** BLOCK BUFFERS  ***************
+
+    std::vector<Complex> m_filtered;     //!< DSB filter output
+    std::vector<float> m_normI;          //!< normalized samples preceded by the history
+    std::vector<float> m_normQ;
+    std::vector<float> m_video;          //!< video levels
+    std::vector<unsigned char> m_gray;   //!< gray levels
+
+    //*************** FRAME  ***************
+
+    TVFrameBuffer m_frameBuffer;
+    unsigned char *m_frame;              //!< back frame being drawn
+    unsigned char *m_row;                //!< selected row in the back frame or null if out of the frame
+    int m_intSelectedRow;
+
+    //*************** RF  ***************
+
+    MovingAverageUtil<double, double, 32> m_objMagSqAverage;
+
+    SimplePhaseLock m_bfoPLL;
+    SecondOrderRecursiveFilter m_bfoFilter;
+
+    // Used for vestigial SSB with asymmetrical filtering (needs double sideband scheme)
+    fftfilt* m_DSBFilter;
+    Complex* m_DSBFilterBuffer;
+    int m_DSBFilterBufferIndex;
+
+    // Used for FM
+    PhaseDiscriminators m_objPhaseDiscri;
+
+    void applyStandard(const ATVDemod::ATVConfig& config);
+    void resizeBuffers(int nbSamples);
+
+    void filterDSB(const Complex *samples, int nbSamples);
+    void feedMagSq(const Complex *samples, int nbSamples);
+    void demodFM(const Complex *samples, int nbSamples);
+    void demodFM3(const Complex *samples, int nbSamples);
+    void demodAM(const Complex *samples, int nbSamples);
+    void demodSSB(const Complex *samples, int nbSamples);
+    void convertLevels(int nbSamples);
+    void processLevels(int nbSamples);
+
+    void updateAmplitudeRange();
+    void renderFrame();
+
+    inline float videoLevel(float fltVal) const
+    {
+        fltVal = m_running.m_blnInvertVideo ? 1.0f - fltVal : fltVal;
+        return (fltVal < -1.0f) ? -1.0f : (fltVal > 1.0f) ? 1.0f : fltVal;
+    }
+
+    inline unsigned char grayLevel(float fltVal, float fltGrayScale) const
+    {
+        //-0.3 -> 0.7
+        int intVal = (int) ((fltVal - m_running.m_fltVoltLevelSynchroBlack) * fltGrayScale);
+        //0 -> 255
+        return intVal < 0 ? 0 : intVal > 255 ? 255 : intVal;
+    }
+
+    inline void selectRow(int intRow)
+    {
+        m_intSelectedRow = intRow;
+        m_row = (m_frame && (intRow >= 0) && (intRow < m_intRows)) ? m_frame + intRow * m_intCols : nullptr;
+    }
+
+    inline void setPixel(int intCol, unsigned char gray)
+    {
+        if (m_row && (intCol >= 0) && (intCol < m_intCols)) {
+            m_row[intCol] = gray;
+        }
+    }
+
+    inline void processHSkip(float fltVal, unsigned char gray)
+    {
+        setPixel(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop, gray);
+
+        // Horizontal Synchro detection
+
+        // Floor Detection 0
+        if (fltVal < m_running.m_fltVoltLevelSynchroTop)
+        {
+            m_intSynchroPoints++;
+        }
+        // Black detection 0.3
+        else if (fltVal > m_running.m_fltVoltLevelSynchroBlack)
+        {
+            m_intSynchroPoints = 0;
+        }
+
+        // sync pulse
+
+        m_blnSynchroDetected = (m_intSynchroPoints == m_intNumberSamplePerTop);
+
+        if (m_blnSynchroDetected)
+        {
+            if (m_intSampleIndex >= (3 * m_intNumberSamplePerLine)/2) // first after skip
+            {
+                m_intAvgColIndex = m_intColIndex;
+                renderFrame();
+
+                m_intImageIndex++;
+                m_intLineIndex = 0;
+                m_intRowIndex = 0;
+            }
+
+            m_intSampleIndex = 0;
+        }
+        else
+        {
+            m_intSampleIndex++;
+        }
+
+        if (m_intColIndex < m_intNumberSamplePerLine + m_intNumberSamplePerTop - 1)
+        {
+            m_intColIndex++;
+        }
+        else
+        {
+            if (m_running.m_blnHSync && (m_intLineIndex == 0))
+            {
+                m_intColIndex = m_intNumberSamplePerTop + (m_intNumberSamplePerLine - m_intAvgColIndex)/2; // amortizing factor 1/2
+            }
+            else
+            {
+                m_intColIndex = m_intNumberSamplePerTop;
+            }
+
+            if ((m_rfRunning.m_enmModulation == ATVDemod::ATV_AM)
+                || (m_rfRunning.m_enmModulation == ATVDemod::ATV_USB)
+                || (m_rfRunning.m_enmModulation == ATVDemod::ATV_LSB))
+            {
+                updateAmplitudeRange();
+            }
+
+            selectRow(m_intRowIndex);
+            m_intLineIndex++;
+            m_intRowIndex++;
+        }
+    }
+
+    inline void processClassic(float fltVal, unsigned char gray)
+    {
+        int intSynchroTimeSamples= (3 * m_intNumberSamplePerLine)/4;
+        float fltSynchroTrameLevel =  0.5f*((float)intSynchroTimeSamples) * m_running.m_fltVoltLevelSynchroBlack;
+
+        // Horizontal Synchro detection
+
+        // Floor Detection 0
+        if (fltVal < m_running.m_fltVoltLevelSynchroTop)
+        {
+            m_intSynchroPoints++;
+        }
+        // Black detection 0.3
+        else if (fltVal > m_running.m_fltVoltLevelSynchroBlack)
+        {
+            m_intSynchroPoints = 0;
+        }
+
+        m_blnSynchroDetected = (m_intSynchroPoints == m_intNumberSamplePerTop);
+
+        //Horizontal Synchro processing
+
+        bool blnNewLine = false;
+
+        if (m_blnSynchroDetected)
+        {
+            m_intAvgColIndex = m_intSampleIndex - m_intColIndex - (m_intColIndex < m_intNumberSamplePerLine/2 ? 150 : 0);
+            m_intSampleIndex = 0;
+        }
+        else
+        {
+            m_intSampleIndex++;
+        }
+
+        if (!m_running.m_blnHSync && (m_intColIndex >= m_intNumberSamplePerLine)) // H Sync not active
+        {
+            m_intColIndex = 0;
+            blnNewLine = true;
+        }
+        else if (m_intColIndex >= m_intNumberSamplePerLine + m_intNumberSamplePerTop) // No valid H sync
+        {
+            if (m_running.m_blnHSync && (m_intLineIndex == 0))
+            {
+                m_intColIndex = m_intNumberSamplePerTop + m_intAvgColIndex/4; // amortizing 1/4
+            }
+            else
+            {
+                m_intColIndex = m_intNumberSamplePerTop;
+            }
+
+            blnNewLine = true;
+        }
+
+        if (blnNewLine)
+        {
+            if ((m_rfRunning.m_enmModulation == ATVDemod::ATV_AM)
+                || (m_rfRunning.m_enmModulation == ATVDemod::ATV_USB)
+                || (m_rfRunning.m_enmModulation == ATVDemod::ATV_LSB))
+            {
+                updateAmplitudeRange();
+            }
+
+            m_fltAmpLineAverage=0.0f;
+
+            //New line + Interleaving
+            m_intRowIndex += m_interleaved ? 2 : 1;
+
+            if (m_intRowIndex < m_intNumberOfLines)
+            {
+                selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+            }
+
+            m_intLineIndex++;
+        }
+
+        // Filling pixels
+
+        // +4 is to compensate shift due to hsync amortizing factor of 1/4
+        setPixel(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop + 4, gray);
+        m_intColIndex++;
+
+        // Vertical sync and image rendering
+
+        if ((m_running.m_blnVSync) && (m_intLineIndex < m_intNumberOfLines)) // VSync activated and lines in range
+        {
+            if (m_intColIndex >= intSynchroTimeSamples)
+            {
+                if (m_fltAmpLineAverage <= fltSynchroTrameLevel)
+                {
+                    m_fltAmpLineAverage = 0.0f;
+
+                    if (!m_blnVerticalSynchroDetected) // not yet
+                    {
+                        m_blnVerticalSynchroDetected = true; // prevent repetition
+
+                        if ((m_intLineIndex % 2 == 0) || !m_interleaved) // even => odd image
+                        {
+                            renderFrame();
+                            m_intRowIndex = 1;
+                        }
+                        else
+                        {
+                            m_intRowIndex = 0;
+                        }
+
+                        selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+                        m_intLineIndex = 0;
+                        m_intImageIndex++;
+                    }
+                }
+                else
+                {
+                    m_blnVerticalSynchroDetected = false; // reset
+                }
+            }
+        }
+        else // no VSync or lines out of range => arbitrary
+        {
+            if (m_intLineIndex >= m_intNumberOfLines/2)
+            {
+                if (m_intImageIndex % 2 == 1) // odd image
+                {
+                    renderFrame();
+
+                    if (m_rfRunning.m_enmModulation == ATVDemod::ATV_AM) {
+                        updateAmplitudeRange();
+                    }
+
+                    m_intRowIndex = 1;
+                }
+                else
+                {
+                    m_intRowIndex = 0;
+                }
+
+                selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+                m_intLineIndex = 0;
+                m_intImageIndex++;
+            }
+        }
+    }
+};
+
+#endif // INCLUDE_ATVDEMODPROCESSOR_H
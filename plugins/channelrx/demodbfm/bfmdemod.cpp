@@ -19,12 +19,10 @@
 #include "boost/format.hpp"
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
 
 #include <QTime>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include "SWGChannelSettings.h"
 #include "SWGBFMDemodSettings.h"
@@ -40,6 +38,7 @@
 #include "dsp/devicesamplemimo.h"
 #include "device/deviceapi.h"
 #include "util/db.h"
+#include "webapi/webapireversedispatcher.h"
 
 #include "rdsparser.h"
 #include "bfmdemod.h"
@@ -52,6 +51,7 @@ const QString BFMDemod::m_channelIdURI = "sdrangel.channel.bfm";
 const QString BFMDemod::m_channelId = "BFMDemod";
 const Real BFMDemod::default_deemphasis = 50.0; // 50 us
 const int BFMDemod::m_udpBlockSize = 512;
+const int BFMDemod::m_rdsSampleRate = 62500; // RDS subcarrier is +/- 2.4 kHz after mixing
 
 BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
@@ -90,6 +90,8 @@ BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
     m_sampleSink = 0;
     m_m1Arg = 0;
 
+    m_rdsDemod.setSampleRate(m_rdsSampleRate);
+
     m_rfFilter = new fftfilt(-50000.0 / 384000.0, 50000.0 / 384000.0, filtFftLen);
 
 	m_deemphasisFilterX.configure(default_deemphasis * m_audioSampleRate * 1.0e-6);
@@ -106,15 +108,10 @@ BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
 
 BFMDemod::~BFMDemod()
 {
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
 
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
 
@@ -133,16 +130,18 @@ uint32_t BFMDemod::getNumberOfDeviceStreams() const
 void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
-	Complex ci, cs, cr;
 	fftfilt::cmplx *rf;
 	int rf_out;
 	double msq;
 	Real demod;
 
 	m_sampleBuffer.clear();
+	m_demodBuffer.clear();
 
 	m_settingsMutex.lock();
 
+	// RF stage: channel, RF filter, squelch and FM discriminator
+
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
@@ -180,101 +179,166 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 				demod = 0;
 			}
 
-			if (!m_settings.m_showPilot) {
-				m_sampleBuffer.push_back(Sample(demod * SDR_RX_SCALEF, 0.0));
-			}
+			m_demodBuffer.push_back(demod);
+		}
+	}
 
-			if (m_settings.m_rdsActive)
-			{
-				//Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-				Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
+	unsigned int nbDemod = m_demodBuffer.size();
 
-				if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
-				{
-					bool bit;
+	if (!m_settings.m_showPilot)
+	{
+		for (unsigned int i = 0; i < nbDemod; i++) {
+			m_sampleBuffer.push_back(Sample(m_demodBuffer[i] * SDR_RX_SCALEF, 0.0));
+		}
+	}
 
-					if (m_rdsDemod.process(cr.real(), bit))
-					{
-						if (m_rdsDecoder.frameSync(bit)) {
-						    m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
-						}
-					}
+	// Pilot stage: the 38 kHz stereo and 57 kHz RDS carriers are derived from the 19 kHz pilot PLL tone
 
-					m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
-				}
+	if (m_settings.m_audioStereo || m_settings.m_rdsActive)
+	{
+		m_carrier38Sin.resize(nbDemod);
+		m_carrier38Cos.resize(nbDemod);
+		m_carrier57.resize(nbDemod);
+
+		for (unsigned int i = 0; i < nbDemod; i++)
+		{
+			m_pilotPLL.process(m_demodBuffer[i], m_pilotPLLSamples);
+			m_carrier38Sin[i] = m_pilotPLLSamples[1];
+			m_carrier38Cos[i] = m_pilotPLLSamples[2];
+			m_carrier57[i] = m_pilotPLLSamples[3];
+		}
+
+		if (m_settings.m_audioStereo && m_settings.m_showPilot)
+		{
+			for (unsigned int i = 0; i < nbDemod; i++) {
+				m_sampleBuffer.push_back(Sample(m_carrier38Sin[i] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
 			}
+		}
+	}
 
-			Real sampleStereo = 0.0f;
+	// RDS stage: subcarrier mixed down and decimated to the RDS demodulator rate
 
-			// Process stereo if stereo mode is selected
+	if (m_settings.m_rdsActive)
+	{
+		Complex cr;
 
-			if (m_settings.m_audioStereo)
-			{
-				m_pilotPLL.process(demod, m_pilotPLLSamples);
+		for (unsigned int i = 0; i < nbDemod; i++)
+		{
+			Complex r(m_demodBuffer[i] * 2.0 * m_carrier57[i], 0.0);
 
-				if (m_settings.m_showPilot) {
-					m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
-				}
+			if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
+			{
+				bool bit;
 
-				if (m_settings.m_lsbStereo)
+				if (m_rdsDemod.process(cr.real(), bit))
 				{
-					// 1.17 * 0.7 = 0.819
-					Complex s(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real() + cs.imag();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
+					if (m_rdsDecoder.frameSync(bit)) {
+					    m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
 					}
 				}
-				else
-				{
-					Complex s(demod * 1.17 * m_pilotPLLSamples[1], 0);
 
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
-				}
+				m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
 			}
+		}
+	}
+
+	// Audio decimation stage: mono (L+R) and stereo subcarrier (L-R) at the audio rate
 
-			Complex e(demod, 0);
+	m_audioMid.clear();
+	m_audioSide.clear();
 
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
+	for (unsigned int i = 0; i < nbDemod; i++)
+	{
+		Complex ci, cs;
+		Real sampleStereo = 0.0f;
+		demod = m_demodBuffer[i];
+
+		if (m_settings.m_audioStereo)
+		{
+			if (m_settings.m_lsbStereo)
 			{
-				if (m_settings.m_audioStereo)
+				// 1.17 * 0.7 = 0.819
+				Complex s(demod * m_carrier38Sin[i], demod * m_carrier38Cos[i]);
+
+				if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
 				{
-					Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
-					m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
-					m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
-                    m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
-                    m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
+					sampleStereo = cs.real() + cs.imag();
+					m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
 				}
-				else
+			}
+			else
+			{
+				Complex s(demod * 1.17 * m_carrier38Sin[i], 0);
+
+				if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
 				{
-					Real deemph;
-					m_deemphasisFilterX.process(ci.real(), deemph);
-					quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
-					m_audioBuffer[m_audioBufferFill].l = sample;
-					m_audioBuffer[m_audioBufferFill].r = sample;
+					sampleStereo = cs.real();
+					m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
 				}
+			}
+		}
 
-				++m_audioBufferFill;
+		Complex e(demod, 0);
 
-				if (m_audioBufferFill >= m_audioBuffer.size())
-				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+		if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
+		{
+			m_audioMid.push_back(ci.real());
+			m_audioSide.push_back(sampleStereo);
+			m_interpolatorDistanceRemain += m_interpolatorDistance;
+		}
+	}
 
-					if(res != m_audioBufferFill) {
-						qDebug("BFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-					}
+	// Audio stage: stereo matrix, de-emphasis and output
 
-					m_audioBufferFill = 0;
-				}
+	unsigned int nbAudio = m_audioMid.size();
+	Real gain = (1<<12) * m_settings.m_volume;
+
+	if (m_settings.m_audioStereo)
+	{
+		// Pre-emphasis is applied on each channel before multiplexing
+		m_audioLeft.resize(nbAudio);
+		m_audioRight.resize(nbAudio);
+
+		for (unsigned int i = 0; i < nbAudio; i++)
+		{
+			m_audioLeft[i] = m_audioMid[i] + m_audioSide[i];
+			m_audioRight[i] = m_audioMid[i] - m_audioSide[i];
+		}
+
+		m_deemphasisFilterX.process(m_audioLeft);
+		m_deemphasisFilterY.process(m_audioRight);
+	}
+	else
+	{
+		m_deemphasisFilterX.process(m_audioMid);
+	}
+
+	const std::vector<Real>& audioLeft = m_settings.m_audioStereo ? m_audioLeft : m_audioMid;
+	const std::vector<Real>& audioRight = m_settings.m_audioStereo ? m_audioRight : m_audioMid;
+	unsigned int index = 0;
+
+	while (index < nbAudio)
+	{
+		unsigned int count = std::min(nbAudio - index, (unsigned int) m_audioBuffer.size() - m_audioBufferFill);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			m_audioBuffer[m_audioBufferFill + i].l = (qint16)(audioLeft[index + i] * gain);
+			m_audioBuffer[m_audioBufferFill + i].r = (qint16)(audioRight[index + i] * gain);
+		}
+
+		m_audioBufferFill += count;
+		index += count;
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
+		if (m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+
+			if(res != m_audioBufferFill) {
+				qDebug("BFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
 			}
+
+			m_audioBufferFill = 0;
 		}
 	}
 
@@ -438,8 +502,8 @@ void BFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
         m_interpolatorStereoDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
 
         m_interpolatorRDS.create(4, inputSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) inputSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) inputSampleRate / 250000.0;
+        m_interpolatorRDSDistanceRemain = (Real) inputSampleRate / m_rdsSampleRate;
+        m_interpolatorRDSDistance =  (Real) inputSampleRate / m_rdsSampleRate;
 
         Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
         Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
@@ -510,8 +574,8 @@ void BFMDemod::applySettings(const BFMDemodSettings& settings, bool force)
         m_interpolatorStereoDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
 
         m_interpolatorRDS.create(4, m_inputSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) m_inputSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) m_inputSampleRate / 250000.0;
+        m_interpolatorRDSDistanceRemain = (Real) m_inputSampleRate / m_rdsSampleRate;
+        m_interpolatorRDSDistance =  (Real) m_inputSampleRate / m_rdsSampleRate;
 
         m_lowpass.create(21, m_audioSampleRate, settings.m_afBandwidth);
 
@@ -862,38 +926,8 @@ void BFMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, co
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
-
-void BFMDemod::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "BFMDemod::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("BFMDemod::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
@@ -22,7 +22,6 @@
 #include <vector>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -42,8 +41,6 @@
 #include "rdsdemod.h"
 #include "bfmdemodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -281,6 +278,17 @@ private:
 	RDSPhaseLock m_pilotPLL;
 	Real m_pilotPLLSamples[4];
 
+	// block processing buffers
+	std::vector<Real> m_demodBuffer;  //!< FM discriminator output
+	std::vector<Real> m_carrier38Sin; //!< stereo subcarrier from the pilot PLL
+	std::vector<Real> m_carrier38Cos;
+	std::vector<Real> m_carrier57;    //!< RDS subcarrier from the pilot PLL
+	std::vector<Real> m_audioMid;     //!< L+R at audio rate
+	std::vector<Real> m_audioSide;    //!< L-R at audio rate
+	std::vector<Real> m_audioLeft;
+	std::vector<Real> m_audioRight;
+	static const int m_rdsSampleRate;
+
 	RDSDemod m_rdsDemod;
 	RDSDecoder m_rdsDecoder;
 	RDSParser m_rdsParser;
@@ -296,9 +304,6 @@ private:
 
     static const int m_udpBlockSize;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
 	void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
 	void applySettings(const BFMDemodSettings& settings, bool force = false);
@@ -306,9 +311,6 @@ private:
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiFormatRDSReport(SWGSDRangel::SWGRDSReport *report);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const BFMDemodSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // INCLUDE_BFMDEMOD_H
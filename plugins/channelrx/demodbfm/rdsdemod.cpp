@@ -34,7 +34,7 @@ const Real RDSDemod::m_fsc = 1187.5;
 RDSDemod::RDSDemod()
 	// : m_udpDebug(this, 1472, 9995) // UDP debug
 {
-	m_srate = 250000;
+	setSampleRate(250000);
 
 	m_parms.subcarr_phi = 0;
 	memset(m_parms.subcarr_bb, 0, sizeof(m_parms.subcarr_bb));
@@ -67,9 +67,22 @@ RDSDemod::~RDSDemod()
 	//delete m_socket;
 }
 
-void RDSDemod::setSampleRate(int srate) /// FIXME: fix rate for now
+void RDSDemod::setSampleRate(int srate)
 {
-    (void) srate;
+	m_srate = srate;
+
+	// 2nd order Butterworth low pass at 1200 Hz by bilinear transform
+	// (same as mkfilter -Bu -Lp -o 2 -a 4.8e-03 at 250 kS/s)
+	double wc = tan(M_PI * 1200.0 / srate);
+	double k1 = sqrt(2.0) * wc;
+	double k2 = wc * wc;
+	double a0 = 1.0 + k1 + k2;
+	m_lpGain = a0 / k2;
+	m_lpA1 = 2.0 * (1.0 - k2) / a0;
+	m_lpA2 = -(1.0 - k1 + k2) / a0;
+
+	// biphase symbols are integrated at 31.25 kS/s
+	m_integrationDecimation = srate / 31250 < 1 ? 1 : srate / 31250;
 }
 
 bool RDSDemod::process(Real demod, bool& bit)
@@ -113,7 +126,7 @@ bool RDSDemod::process(Real demod, bool& bit)
 	m_parms.lo_clock = (m_parms.clock_phi < M_PI ? 1 : -1);
 
 	/* Decimate band-limited signal */
-	if (m_parms.numsamples % 8 == 0)
+	if (m_parms.numsamples % m_integrationDecimation == 0)
 	{
 		/* biphase symbol integrate & dump */
 		m_parms.acc += m_parms.subcarr_bb[0] * m_parms.lo_clock;
@@ -190,10 +203,10 @@ Real RDSDemod::filter_lp_2400_iq(Real input, int iqIndex)
 	 -a 4.8000000000e-03 0.0000000000e+00 -l */
 
 	m_xv[iqIndex][0] = m_xv[iqIndex][1]; m_xv[iqIndex][1] = m_xv[iqIndex][2];
-	m_xv[iqIndex][2] = input / 4.491730007e+03;
+	m_xv[iqIndex][2] = input / m_lpGain;
 	m_yv[iqIndex][0] = m_yv[iqIndex][1]; m_yv[iqIndex][1] = m_yv[iqIndex][2];
 	m_yv[iqIndex][2] =   (m_xv[iqIndex][0] + m_xv[iqIndex][2]) + 2 * m_xv[iqIndex][1]
-	+ ( -0.9582451124 * m_yv[iqIndex][0]) + (  1.9573545869 * m_yv[iqIndex][1]);
+	+ ( m_lpA2 * m_yv[iqIndex][0]) + ( m_lpA1 * m_yv[iqIndex][1]);
 
 	return m_yv[iqIndex][2];
 }
@@ -75,6 +75,10 @@ private:
 	Real m_prev;
 
 	int m_srate;
+	int m_integrationDecimation;
+	double m_lpGain; //!< low pass filter
+	double m_lpA1;
+	double m_lpA2;
 
 	static const Real m_pllBeta;
 	static const Real m_fsc;
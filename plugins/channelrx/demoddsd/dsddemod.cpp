@@ -23,9 +23,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include "SWGChannelSettings.h"
 #include "SWGDSDDemodSettings.h"
@@ -41,6 +38,7 @@
 #include "dsp/devicesamplemimo.h"
 #include "device/deviceapi.h"
 #include "util/db.h"
+#include "webapi/webapireversedispatcher.h"
 
 #include "dsddemod.h"
 
@@ -89,6 +87,8 @@ DSDDemod::DSDDemod(DeviceAPI *deviceAPI) :
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(&m_audioFifo1, getInputMessageQueue());
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(&m_audioFifo2, getInputMessageQueue());
+    DSDVocoderPool::instance()->addVocoder(&m_vocoder1, QString("%1 %2 slot 1").arg(m_channelId).arg(m_deviceAPI->getDeviceSetIndex()));
+    DSDVocoderPool::instance()->addVocoder(&m_vocoder2, QString("%1 %2 slot 2").arg(m_channelId).arg(m_deviceAPI->getDeviceSetIndex()));
     m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate();
 
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
@@ -98,16 +98,13 @@ DSDDemod::DSDDemod(DeviceAPI *deviceAPI) :
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
 
 DSDDemod::~DSDDemod()
 {
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
     delete[] m_sampleBuffer;
+    DSDVocoderPool::instance()->removeVocoder(&m_vocoder1);
+    DSDVocoderPool::instance()->removeVocoder(&m_vocoder2);
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo1);
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo2);
 
@@ -137,7 +134,10 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	m_settingsMutex.lock();
 	m_scopeSampleBuffer.clear();
 
-	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
+	bool dvSerial = DSPEngine::instance()->hasDVSerialSupport();
+	// voice frames go to the AMBE devices or to the vocoder pool else DSDcc synthesizes them itself
+	bool dsdccMbelib = !dvSerial && !m_settings.m_vocoderPool;
+	m_dsdDecoder.enableMbelib(dsdccMbelib);
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -252,13 +252,22 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                 m_scopeSampleBuffer.push_back(s);
             }
 
-            if (DSPEngine::instance()->hasDVSerialSupport())
+            if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
             {
-                if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
+                if (!m_settings.m_audioMute && !dsdccMbelib)
                 {
-                    if (!m_settings.m_audioMute)
+                    // frames not taken by an AMBE device are synthesized on the vocoder pool
+                    if ((!dvSerial || !DSPEngine::instance()->pushMbeFrame(
+                                m_dsdDecoder.getMbeDVFrame1(),
+                                m_dsdDecoder.getMbeRateIndex(),
+                                m_settings.m_volume * 10.0,
+                                m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
+                                m_settings.m_highPassFilter,
+                                m_audioSampleRate/8000, // upsample from native 8k
+                                &m_audioFifo1)) && m_settings.m_vocoderPool)
                     {
-                        DSPEngine::instance()->pushMbeFrame(
+                        DSDVocoderPool::instance()->pushMbeFrame(
+                                &m_vocoder1,
                                 m_dsdDecoder.getMbeDVFrame1(),
                                 m_dsdDecoder.getMbeRateIndex(),
                                 m_settings.m_volume * 10.0,
@@ -267,15 +276,27 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                                 m_audioSampleRate/8000, // upsample from native 8k
                                 &m_audioFifo1);
                     }
-
-                    m_dsdDecoder.resetMbeDV1();
                 }
 
-                if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+                m_dsdDecoder.resetMbeDV1();
+            }
+
+            if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+            {
+                if (!m_settings.m_audioMute && !dsdccMbelib)
                 {
-                    if (!m_settings.m_audioMute)
+                    // frames not taken by an AMBE device are synthesized on the vocoder pool
+                    if ((!dvSerial || !DSPEngine::instance()->pushMbeFrame(
+                                m_dsdDecoder.getMbeDVFrame2(),
+                                m_dsdDecoder.getMbeRateIndex(),
+                                m_settings.m_volume * 10.0,
+                                m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
+                                m_settings.m_highPassFilter,
+                                m_audioSampleRate/8000, // upsample from native 8k
+                                &m_audioFifo2)) && m_settings.m_vocoderPool)
                     {
-                        DSPEngine::instance()->pushMbeFrame(
+                        DSDVocoderPool::instance()->pushMbeFrame(
+                                &m_vocoder2,
                                 m_dsdDecoder.getMbeDVFrame2(),
                                 m_dsdDecoder.getMbeRateIndex(),
                                 m_settings.m_volume * 10.0,
@@ -284,9 +305,9 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                                 m_audioSampleRate/8000, // upsample from native 8k
                                 &m_audioFifo2);
                     }
-
-                    m_dsdDecoder.resetMbeDV2();
                 }
+
+                m_dsdDecoder.resetMbeDV2();
             }
 
 //            if (DSPEngine::instance()->hasDVSerialSupport() && m_dsdDecoder.mbeDVReady1())
@@ -303,7 +324,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
         }
 	}
 
-	if (!DSPEngine::instance()->hasDVSerialSupport())
+	if (dsdccMbelib)
 	{
 	    if (m_settings.m_slot1On)
 	    {
@@ -334,18 +355,6 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                 m_dsdDecoder.resetAudio2();
             }
         }
-
-//	    int nbAudioSamples;
-//	    short *dsdAudio = m_dsdDecoder.getAudio1(nbAudioSamples);
-//
-//	    if (nbAudioSamples > 0)
-//	    {
-//	        if (!m_settings.m_audioMute) {
-//	            uint res = m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples, 10);
-//	        }
-//
-//	        m_dsdDecoder.resetAudio1();
-//	    }
 	}
 
     if ((m_scopeXY != 0) && (m_scopeEnabled))
@@ -494,6 +503,7 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
             << " m_tdmaStereo: " << settings.m_tdmaStereo
             << " m_pllLock: " << settings.m_pllLock
             << " m_highPassFilter: "<< settings.m_highPassFilter
+            << " m_vocoderPool: "<< settings.m_vocoderPool
             << " m_audioDeviceName: " << settings.m_audioDeviceName
             << " m_traceLengthMutliplier: " << settings.m_traceLengthMutliplier
             << " m_traceStroke: " << settings.m_traceStroke
@@ -595,6 +605,20 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
         m_dsdDecoder.useHPMbelib(settings.m_highPassFilter);
     }
 
+    if ((settings.m_vocoderPool != m_settings.m_vocoderPool) || force)
+    {
+        reverseAPIKeys.append("vocoderPool");
+
+        if (settings.m_vocoderPool != m_settings.m_vocoderPool)
+        {
+            // the audio FIFOs take a single producer: no frame queued for the pool may be written after the switch
+            m_settingsMutex.lock();
+            DSDVocoderPool::instance()->drainVocoder(&m_vocoder1);
+            DSDVocoderPool::instance()->drainVocoder(&m_vocoder2);
+            m_settingsMutex.unlock();
+        }
+    }
+
     if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
     {
         reverseAPIKeys.append("audioDeviceName");
@@ -954,6 +978,9 @@ void DSDDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("highPassFilter")) {
         settings.m_highPassFilter = response.getDsdDemodSettings()->getHighPassFilter() != 0;
     }
+    if (channelSettingsKeys.contains("vocoderPool")) {
+        settings.m_vocoderPool = response.getDsdDemodSettings()->getVocoderPool() != 0;
+    }
     if (channelSettingsKeys.contains("traceLengthMutliplier")) {
         settings.m_traceLengthMutliplier = response.getDsdDemodSettings()->getTraceLengthMutliplier();
     }
@@ -1026,6 +1053,7 @@ void DSDDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& resp
     }
 
     response.getDsdDemodSettings()->setHighPassFilter(settings.m_highPassFilter ? 1 : 0);
+    response.getDsdDemodSettings()->setVocoderPool(settings.m_vocoderPool ? 1 : 0);
     response.getDsdDemodSettings()->setTraceLengthMutliplier(settings.m_traceLengthMutliplier);
     response.getDsdDemodSettings()->setTraceStroke(settings.m_traceStroke);
     response.getDsdDemodSettings()->setTraceDecay(settings.m_traceDecay);
@@ -1134,6 +1162,9 @@ void DSDDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, co
     if (channelSettingsKeys.contains("highPassFilter") || force) {
         swgDSDDemodSettings->setHighPassFilter(settings.m_highPassFilter ? 1 : 0);
     }
+    if (channelSettingsKeys.contains("vocoderPool") || force) {
+        swgDSDDemodSettings->setVocoderPool(settings.m_vocoderPool ? 1 : 0);
+    }
     if (channelSettingsKeys.contains("traceLengthMutliplier") || force) {
         swgDSDDemodSettings->setTraceLengthMutliplier(settings.m_traceLengthMutliplier);
     }
@@ -1152,38 +1183,8 @@ void DSDDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, co
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
-
-void DSDDemod::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "DSDDemod::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("DSDDemod::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
@@ -22,7 +22,6 @@
 #include <vector>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -40,9 +39,8 @@
 
 #include "dsddemodsettings.h"
 #include "dsddecoder.h"
+#include "dsdvocoderpool.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -129,6 +127,11 @@ public:
 	bool getSquelchOpen() const { return m_squelchOpen; }
 
 	const DSDDecoder& getDecoder() const { return m_dsdDecoder; }
+	void getVocoderStats(DSDVocoderPool::VocoderStats& stats1, DSDVocoderPool::VocoderStats& stats2)
+	{
+	    DSDVocoderPool::instance()->getVocoderStats(&m_vocoder1, stats1);
+	    DSDVocoderPool::instance()->getVocoderStats(&m_vocoder2, stats2);
+	}
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
     {
@@ -266,14 +269,13 @@ private:
 	bool m_scopeEnabled;
 
 	DSDDecoder m_dsdDecoder;
+	DSDVocoderPool::Vocoder m_vocoder1; //!< software synthesis of slot 1 voice
+	DSDVocoderPool::Vocoder m_vocoder2;
 
 	char m_formatStatusText[82+1]; //!< Fixed signal format dependent status text
     SignalFormat m_signalFormat;   //!< Used to keep formatting during successive calls for the same standard type
     PhaseDiscriminators m_phaseDiscri;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     QMutex m_settingsMutex;
 
     static const int m_udpBlockSize;
@@ -286,9 +288,6 @@ private:
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const DSDDemodSettings& settings, bool force);
 
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
-
 };
 
 #endif // INCLUDE_DSDDEMOD_H
@@ -254,6 +254,12 @@ void DSDDemodGUI::on_highPassFilter_toggled(bool checked)
     applySettings();
 }
 
+void DSDDemodGUI::on_vocoderPool_toggled(bool checked)
+{
+    m_settings.m_vocoderPool = checked;
+    applySettings();
+}
+
 void DSDDemodGUI::on_symbolPLLLock_toggled(bool checked)
 {
     if (checked) {
@@ -465,6 +471,7 @@ void DSDDemodGUI::displaySettings()
     ui->audioMute->setChecked(m_settings.m_audioMute);
     ui->symbolPLLLock->setChecked(m_settings.m_pllLock);
     ui->highPassFilter->setChecked(m_settings.m_highPassFilter);
+    ui->vocoderPool->setChecked(m_settings.m_vocoderPool);
 
     ui->baudRate->setCurrentIndex(DSDDemodBaudRates::getRateIndex(m_settings.m_baudRate));
 
@@ -623,6 +630,16 @@ void DSDDemodGUI::tick()
             ui->formatStatusText->setStyleSheet("QLabel { background:rgb(37,53,39); }"); // turn on background
 	    }
 
+        if (!DSPEngine::instance()->hasDVSerialSupport() && m_settings.m_vocoderPool)
+        {
+            DSDVocoderPool::VocoderStats stats1, stats2;
+            m_dsdDemod->getVocoderStats(stats1, stats2);
+            ui->slot1On->setToolTip(tr("TDMA slot1 or FDMA unique slot voice on/off\nVocoder latency avg %1 max %2 ms (%3 frames dropped)")
+                .arg(stats1.m_latencyAvg / 1000.0f, 0, 'f', 1).arg(stats1.m_latencyMax / 1000.0f, 0, 'f', 1).arg(stats1.m_droppedItems));
+            ui->slot2On->setToolTip(tr("TDMA slot2 voice on/off\nVocoder latency avg %1 max %2 ms (%3 frames dropped)")
+                .arg(stats2.m_latencyAvg / 1000.0f, 0, 'f', 1).arg(stats2.m_latencyMax / 1000.0f, 0, 'f', 1).arg(stats2.m_droppedItems));
+        }
+
         if (m_squelchOpen && ui->symbolPLLLock->isChecked() && m_dsdDemod->getDecoder().getSymbolPLLLocked()) {
             ui->symbolPLLLock->setStyleSheet("QToolButton { background-color : green; }");
         } else {
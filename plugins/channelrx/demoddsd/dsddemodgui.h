@@ -130,6 +130,7 @@ private slots:
     void on_squelchGate_valueChanged(int value);
     void on_squelch_valueChanged(int value);
     void on_highPassFilter_toggled(bool checked);
+    void on_vocoderPool_toggled(bool checked);
     void on_audioMute_toggled(bool checked);
     void on_symbolPLLLock_toggled(bool checked);
     void onWidgetRolled(QWidget* widget, bool rollDown);
@@ -49,6 +49,7 @@ void DSDDemodSettings::resetToDefaults()
     m_rgbColor = QColor(0, 255, 255).rgb();
     m_title = "DSD Demodulator";
     m_highPassFilter = false;
+    m_vocoderPool = true;
     m_traceLengthMutliplier = 6; // 300 ms
     m_traceStroke = 100;
     m_traceDecay = 200;
@@ -102,6 +103,7 @@ QByteArray DSDDemodSettings::serialize() const
     s.writeU32(28, m_reverseAPIChannelIndex);
     s.writeBool(29, m_audioMute);
     s.writeS32(30, m_streamIndex);
+    s.writeBool(31, m_vocoderPool);
 
     return s.final();
 }
@@ -180,6 +182,7 @@ bool DSDDemodSettings::deserialize(const QByteArray& data)
         m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
         d.readBool(29, &m_audioMute, false);
         d.readS32(30, &m_streamIndex, 0);
+        d.readBool(31, &m_vocoderPool, true);
 
         return true;
     }
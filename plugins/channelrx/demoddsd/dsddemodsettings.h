@@ -42,6 +42,7 @@ struct DSDDemodSettings
     quint32 m_rgbColor;
     QString m_title;
     bool m_highPassFilter;
+    bool m_vocoderPool; //!< mbelib synthesis on the shared vocoder pool else by DSDcc on the channel thread
     int m_traceLengthMutliplier; // x 50ms
     int m_traceStroke; // [0..255]
     int m_traceDecay; // [0..255]
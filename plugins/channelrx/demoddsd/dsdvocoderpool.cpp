@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Software vocoder shared by the DSD channels. Without AMBE devices the voice   //
+// frames of all channels are synthesized with mbelib by a pool of worker        //
+// threads instead of the channel threads. Frames of a same voice slot are       //
+// synthesized in order and never concurrently.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <string.h>
+
+#include <QGlobalStatic>
+#include <QDebug>
+
+extern "C" {
+#include <mbelib.h>
+}
+
+#include "dsdcc/dsd_decoder.h"
+#include "audio/audiofifo.h"
+
+#include "dsdvocoderpool.h"
+
+Q_GLOBAL_STATIC(DSDVocoderPool, dsdVocoderPool)
+
+const unsigned int DSDVocoderPool::m_maxFrameBytes;
+
+struct DSDVocoderPool::Vocoder::Synth
+{
+    mbe_parms m_curMp;
+    mbe_parms m_prevMp;
+    mbe_parms m_prevMpEnhanced;
+    char m_ambeFr[4][24];
+    char m_ambeD[49];
+    char m_imbeFr[8][23];
+    char m_imbeD[88];
+    char m_errStr[64];
+    float m_audioFloat[160];
+    short m_audio[160];        //!< 20 ms at 8 kS/s
+};
+
+DSDVocoderPool::Vocoder::Vocoder() :
+    m_synth(new Synth),
+    m_upsamplerLastValue(0.0f)
+{
+    mbe_initMbeParms(&m_synth->m_curMp, &m_synth->m_prevMp, &m_synth->m_prevMpEnhanced);
+    m_audioBuffer.resize(160*6); // 48 kS/s at most
+}
+
+DSDVocoderPool::Vocoder::~Vocoder()
+{
+    delete m_synth;
+}
+
+SerialTaskPool::Item *DSDVocoderPool::Vocoder::createItem()
+{
+    return new Frame();
+}
+
+void DSDVocoderPool::Vocoder::processItem(SerialTaskPool::Item *item)
+{
+    decode(*static_cast<Frame*>(item));
+}
+
+// Frames come in the bit order of the DV frames of DSDcc: MSB first, FEC rows one after the other
+static inline char getFrameBit(const unsigned char *frame, int bitIndex)
+{
+    return (frame[bitIndex >> 3] >> (7 - (bitIndex & 7))) & 1;
+}
+
+static void unpackRows(const unsigned char *frame, char *rows, int rowSize, const int *rowLengths, int nbRows)
+{
+    int bitIndex = 0;
+
+    for (int i = 0; i < nbRows; i++)
+    {
+        for (int j = rowLengths[i] - 1; j >= 0; j--) {
+            rows[i*rowSize + j] = getFrameBit(frame, bitIndex++);
+        }
+    }
+}
+
+void DSDVocoderPool::Vocoder::decode(const Frame& frame)
+{
+    static const int ambeRowLengths[4] = {24, 23, 11, 14};
+    static const int imbeRowLengths[8] = {23, 23, 23, 23, 15, 15, 15, 7};
+    int errs = 0, errs2 = 0;
+    Synth& s = *m_synth;
+    s.m_errStr[0] = '\0';
+
+    switch (frame.m_mbeRateIndex)
+    {
+    case DSDcc::DSDDecoder::DSDMBERate3600x2400:
+        unpackRows(frame.m_mbeFrame, &s.m_ambeFr[0][0], 24, ambeRowLengths, 4);
+        mbe_processAmbe3600x2400Framef(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_ambeFr, s.m_ambeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    case DSDcc::DSDDecoder::DSDMBERate3600x2450:
+        unpackRows(frame.m_mbeFrame, &s.m_ambeFr[0][0], 24, ambeRowLengths, 4);
+        mbe_processAmbe3600x2450Framef(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_ambeFr, s.m_ambeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    case DSDcc::DSDDecoder::DSDMBERate7200x4400:
+        unpackRows(frame.m_mbeFrame, &s.m_imbeFr[0][0], 23, imbeRowLengths, 8);
+        mbe_processImbe7200x4400Framef(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_imbeFr, s.m_imbeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    case DSDcc::DSDDecoder::DSDMBERate2400:
+        for (int i = 0; i < 49; i++) {
+            s.m_ambeD[i] = getFrameBit(frame.m_mbeFrame, i);
+        }
+        mbe_processAmbe2400Dataf(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_ambeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    case DSDcc::DSDDecoder::DSDMBERate2450:
+        for (int i = 0; i < 49; i++) {
+            s.m_ambeD[i] = getFrameBit(frame.m_mbeFrame, i);
+        }
+        mbe_processAmbe2450Dataf(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_ambeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    case DSDcc::DSDDecoder::DSDMBERate4400:
+        for (int i = 0; i < 88; i++) {
+            s.m_imbeD[i] = getFrameBit(frame.m_mbeFrame, i);
+        }
+        mbe_processImbe4400Dataf(s.m_audioFloat, &errs, &errs2, s.m_errStr, s.m_imbeD,
+            &s.m_curMp, &s.m_prevMp, &s.m_prevMpEnhanced, 3);
+        break;
+    default:
+        return;
+    }
+
+    mbe_floattoshort(s.m_audioFloat, s.m_audio);
+
+    // same volume and upsampling as the AMBE workers
+    int dBVolume = (frame.m_volumeIndex - 30) / 4;
+    float volume = pow(10.0, dBVolume / 10.0f);
+    int upsampling = frame.m_upsampling > 6 ? 6 : frame.m_upsampling < 1 ? 1 : frame.m_upsampling;
+    unsigned char channels = frame.m_channels % 4;
+    unsigned int fill = 0;
+    m_upsampleFilter.useHP(frame.m_useHP);
+
+    if (upsampling > 1) {
+        upsample(s.m_audio, upsampling, volume, channels, fill);
+    } else {
+        noUpsample(s.m_audio, volume, channels, fill);
+    }
+
+    if (frame.m_audioFifo)
+    {
+        uint res = frame.m_audioFifo->write((const quint8*) &m_audioBuffer[0], fill);
+
+        if (res != fill) {
+            qDebug("DSDVocoderPool::Vocoder::decode: %s: %u/%u audio samples written", qPrintable(m_name), res, fill);
+        }
+    }
+}
+
+void DSDVocoderPool::Vocoder::upsample(const short *in, int upsampling, float volume, unsigned char channels, unsigned int& fill)
+{
+    for (int i = 0; i < 160; i++)
+    {
+        float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        float prev = m_upsamplerLastValue;
+
+        for (int j = 1; j <= upsampling; j++)
+        {
+            qint16 upsample = (qint16) m_upsampleFilter.runLP((cur*j + prev*(upsampling-j)) * volume / upsampling);
+            m_audioBuffer[fill].l = channels & 1 ? m_compressor.compress(upsample) : 0;
+            m_audioBuffer[fill].r = (channels>>1) & 1 ? m_compressor.compress(upsample) : 0;
+            fill++;
+        }
+
+        m_upsamplerLastValue = cur;
+    }
+}
+
+void DSDVocoderPool::Vocoder::noUpsample(const short *in, float volume, unsigned char channels, unsigned int& fill)
+{
+    for (int i = 0; i < 160; i++)
+    {
+        float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        m_audioBuffer[fill].l = channels & 1 ? cur*volume : 0;
+        m_audioBuffer[fill].r = (channels>>1) & 1 ? cur*volume : 0;
+        fill++;
+    }
+}
+
+DSDVocoderPool::DSDVocoderPool() :
+    m_pool(25) // half a second of 20 ms frames per vocoder
+{
+}
+
+DSDVocoderPool::~DSDVocoderPool()
+{
+}
+
+DSDVocoderPool *DSDVocoderPool::instance()
+{
+    return dsdVocoderPool;
+}
+
+unsigned int DSDVocoderPool::getNbFrameBytes(int mbeRateIndex)
+{
+    switch (mbeRateIndex)
+    {
+    case DSDcc::DSDDecoder::DSDMBERate3600x2400:
+    case DSDcc::DSDDecoder::DSDMBERate3600x2450:
+        return 9;
+    case DSDcc::DSDDecoder::DSDMBERate7200x4400:
+        return 18;
+    case DSDcc::DSDDecoder::DSDMBERate2400:
+    case DSDcc::DSDDecoder::DSDMBERate2450:
+        return 7;
+    case DSDcc::DSDDecoder::DSDMBERate4400:
+        return 11;
+    default:
+        return 0;
+    }
+}
+
+void DSDVocoderPool::addVocoder(Vocoder *vocoder, const QString& name)
+{
+    vocoder->m_name = name;
+    m_pool.addQueue(vocoder, name);
+}
+
+void DSDVocoderPool::pushMbeFrame(
+        Vocoder *vocoder,
+        const unsigned char *mbeFrame,
+        int mbeRateIndex,
+        int mbeVolumeIndex,
+        unsigned char channels,
+        bool useHP,
+        int upsampling,
+        AudioFifo *audioFifo)
+{
+    unsigned int nbFrameBytes = getNbFrameBytes(mbeRateIndex);
+
+    if (nbFrameBytes == 0) {
+        return;
+    }
+
+    Vocoder::Frame *frame = static_cast<Vocoder::Frame*>(m_pool.takeItem(vocoder));
+    memcpy(frame->m_mbeFrame, mbeFrame, nbFrameBytes);
+    frame->m_mbeRateIndex = mbeRateIndex;
+    frame->m_volumeIndex = mbeVolumeIndex;
+    frame->m_channels = channels;
+    frame->m_useHP = useHP;
+    frame->m_upsampling = upsampling;
+    frame->m_audioFifo = audioFifo;
+    m_pool.submit(vocoder, frame); // late voice is useless: the oldest frame is dropped if the vocoder cannot keep up
+}
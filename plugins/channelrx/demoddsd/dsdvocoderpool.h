@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Software vocoder shared by the DSD channels. Without AMBE devices the voice   //
+// frames of all channels are synthesized with mbelib by a pool of worker        //
+// threads instead of the channel threads. Frames of a same voice slot are       //
+// synthesized in order and never concurrently.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_DEMODDSD_DSDVOCODERPOOL_H_
+#define PLUGINS_CHANNELRX_DEMODDSD_DSDVOCODERPOOL_H_
+
+#include <vector>
+
+#include <QString>
+
+#include "dsp/filtermbe.h"
+#include "dsp/dsptypes.h"
+#include "audio/audiocompressor.h"
+#include "util/serialtaskpool.h"
+
+class AudioFifo;
+
+class DSDVocoderPool
+{
+public:
+    typedef SerialTaskPool::QueueStats VocoderStats; //!< items are frames, processing is synthesis
+
+    static const unsigned int m_maxFrameBytes = 18; //!< 144 bits IMBE frame
+
+    /** Voice of a channel slot with its own synthesis state */
+    class Vocoder : public SerialTaskPool::Queue
+    {
+    public:
+        Vocoder();
+        ~Vocoder();
+
+    protected:
+        virtual SerialTaskPool::Item *createItem();
+        virtual void processItem(SerialTaskPool::Item *item);
+
+    private:
+        struct Frame : public SerialTaskPool::Item
+        {
+            unsigned char m_mbeFrame[m_maxFrameBytes];
+            int m_mbeRateIndex;
+            int m_volumeIndex;
+            unsigned char m_channels;
+            bool m_useHP;
+            int m_upsampling;
+            AudioFifo *m_audioFifo;
+        };
+
+        struct Synth;                  //!< mbelib state
+
+        Synth *m_synth;
+        MBEAudioInterpolatorFilter m_upsampleFilter;
+        AudioCompressor m_compressor;
+        float m_upsamplerLastValue;
+        AudioVector m_audioBuffer;
+        QString m_name;
+
+        void decode(const Frame& frame); //!< called by a worker thread
+        void upsample(const short *in, int upsampling, float volume, unsigned char channels, unsigned int& fill);
+        void noUpsample(const short *in, float volume, unsigned char channels, unsigned int& fill);
+
+        friend class DSDVocoderPool;
+    };
+
+    DSDVocoderPool();
+    ~DSDVocoderPool();
+
+    static DSDVocoderPool *instance();
+    static unsigned int getNbFrameBytes(int mbeRateIndex); //!< 0 if the rate is not supported
+
+    void addVocoder(Vocoder *vocoder, const QString& name);
+    void removeVocoder(Vocoder *vocoder) { m_pool.removeQueue(vocoder); } //!< Drops the pending frames and waits for the frame being synthesized
+    void drainVocoder(Vocoder *vocoder) { m_pool.drainQueue(vocoder); }   //!< Same but the vocoder stays registered
+
+    /** Queue a copy of the frame as DSPEngine::pushMbeFrame does for AMBE devices. Never waits for a worker. */
+    void pushMbeFrame(
+            Vocoder *vocoder,
+            const unsigned char *mbeFrame,
+            int mbeRateIndex,
+            int mbeVolumeIndex,
+            unsigned char channels,
+            bool useHP,
+            int upsampling,
+            AudioFifo *audioFifo);
+
+    void getVocoderStats(Vocoder *vocoder, VocoderStats& stats) { m_pool.getQueueStats(vocoder, stats); }
+    void getVocoderStats(std::vector<VocoderStats>& stats) { m_pool.getQueueStats(stats); }
+
+private:
+    SerialTaskPool m_pool;
+};
+
+#endif /* PLUGINS_CHANNELRX_DEMODDSD_DSDVOCODERPOOL_H_ */
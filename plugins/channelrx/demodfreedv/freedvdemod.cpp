@@ -19,9 +19,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include "codec2/freedv_api.h"
 #include "codec2/modem_stats.h"
@@ -39,6 +36,7 @@
 #include "dsp/devicesamplemimo.h"
 #include "device/deviceapi.h"
 #include "util/db.h"
+#include "webapi/webapireversedispatcher.h"
 
 #include "freedvdemod.h"
 
@@ -202,16 +200,11 @@ FreeDVDemod::FreeDVDemod(DeviceAPI *deviceAPI) :
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
     connect(&m_timer, SIGNAL(timeout()), this, SLOT(timerHandlerFunction()));
 }
 
 FreeDVDemod::~FreeDVDemod()
 {
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
 
 	m_deviceAPI->removeChannelSinkAPI(this);
@@ -468,8 +461,6 @@ bool FreeDVDemod::handleMessage(const Message& cmd)
 
 void FreeDVDemod::pushSampleToDV(int16_t sample)
 {
-    qint16 audioSample;
-
     if (m_levelIn.m_n >= m_levelInNbSamples)
     {
         qreal rmsLevel = sqrt(m_levelIn.m_sum / m_levelInNbSamples);
@@ -487,22 +478,15 @@ void FreeDVDemod::pushSampleToDV(int16_t sample)
         m_freeDVStats.collect(m_freeDV);
         m_freeDVSNR.accumulate(m_freeDVStats.m_snrEst);
 
-        if (m_settings.m_audioMute)
-        {
-            for (uint32_t i = 0; i < nout * m_audioResampler.getDecimation(); i++) {
-                pushSampleToAudio(0);
-            }
+        // whole speech frame resampled at once
+        if (m_speechResampled.size() < m_audioResampler.getMaxOutput(nout)) {
+            m_speechResampled.resize(m_audioResampler.getMaxOutput(nout));
         }
-        else
-        {
-            for (int i = 0; i < nout; i++)
-            {
-                while (!m_audioResampler.upSample(m_speechOut[i], audioSample)) {
-                    pushSampleToAudio(audioSample);
-                }
 
-                pushSampleToAudio(audioSample);
-            }
+        unsigned int nbAudioSamples = m_audioResampler.process(m_speechOut, nout, m_speechResampled.data());
+
+        for (unsigned int i = 0; i < nbAudioSamples; i++) {
+            pushSampleToAudio(m_settings.m_audioMute ? 0 : m_speechResampled[i]);
         }
 
         m_iModem = 0;
@@ -561,8 +545,8 @@ void FreeDVDemod::applyAudioSampleRate(int sampleRate)
 
     m_settingsMutex.lock();
     m_audioFifo.setSize(sampleRate);
-    m_audioResampler.setDecimation(sampleRate / m_speechSampleRate);
-    m_audioResampler.setAudioFilters(sampleRate, sampleRate, 250, 3300, 4.0f);
+    // same level as the zero stuffing interpolation used before
+    m_audioResampler.setRates(m_speechSampleRate, sampleRate, 1, 3300.0f, (4.0f * m_speechSampleRate) / sampleRate);
     m_settingsMutex.unlock();
 
     m_audioSampleRate = sampleRate;
@@ -1055,42 +1039,12 @@ void FreeDVDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys,
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
 
-void FreeDVDemod::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "FreeDVDemod::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("FreeDVDemod::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
-
 void FreeDVDemod::timerHandlerFunction()
 {
     m_enable = true;
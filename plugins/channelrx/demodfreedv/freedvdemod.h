@@ -22,7 +22,6 @@
 
 #include <QTimer>
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -31,7 +30,7 @@
 #include "dsp/fftfilt.h"
 #include "dsp/agc.h"
 #include "audio/audiofifo.h"
-#include "audio/audioresampler.h"
+#include "audio/audiopolyphaseresampler.h"
 #include "util/message.h"
 #include "util/doublebufferfifo.h"
 
@@ -40,8 +39,6 @@
 #define ssbFftLen 1024
 #define agcTarget 3276.8 // -10 dB amplitude => -20 dB power: center of normal signal
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -402,9 +399,6 @@ private:
 	uint m_audioBufferFill;
 	AudioFifo m_audioFifo;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     struct freedv *m_freeDV;
     int m_nSpeechSamples;
     int m_nMaxModemSamples;
@@ -413,7 +407,8 @@ private:
     int m_iModem;
     int16_t *m_speechOut;
     int16_t *m_modIn;
-    AudioResampler m_audioResampler;
+    AudioPolyphaseResampler m_audioResampler;
+    std::vector<int16_t> m_speechResampled; //!< speech at the audio sample rate
 	FreeDVStats m_freeDVStats;
 	FreeDVSNR m_freeDVSNR;
 	LevelRMS m_levelIn;
@@ -434,7 +429,6 @@ private:
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const FreeDVDemodSettings& settings, bool force);
 
 private slots:
-    void networkManagerFinished(QNetworkReply *reply);
     void timerHandlerFunction();
 };
 
@@ -20,18 +20,20 @@
 
 #include <QTime>
 #include <QDebug>
-#include <stdio.h>
 
 #include "dsp/downchannelizer.h"
 #include "dsp/threadedbasebandsamplesink.h"
 #include "dsp/dspcommands.h"
 #include "device/deviceapi.h"
 
+#include "SWGChannelReport.h"
+#include "SWGLoRaDemodReport.h"
+
 #include "lorademod.h"
-#include "lorabits.h"
 
 MESSAGE_CLASS_DEFINITION(LoRaDemod::MsgConfigureLoRaDemod, Message)
 MESSAGE_CLASS_DEFINITION(LoRaDemod::MsgConfigureChannelizer, Message)
+MESSAGE_CLASS_DEFINITION(LoRaDemod::MsgReportDecodeSymbols, Message)
 
 const QString LoRaDemod::m_channelIdURI = "sdrangel.channel.lorademod";
 const QString LoRaDemod::m_channelId = "LoRaDemod";
@@ -50,22 +52,9 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 	m_nco.setFreq(m_frequency, m_sampleRate);
 	m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
 	m_sampleDistanceRemain = (Real)m_sampleRate / m_Bandwidth;
-
-	m_chirp = 0;
-	m_angle = 0;
-	m_bin = 0;
-	m_result = 0;
-	m_count = 0;
-	m_header = 0;
-	m_time = 0;
-	m_tune = 0;
-
-	loraFilter = new sfft(LORA_SFFT_LEN);
-	negaFilter = new sfft(LORA_SFFT_LEN);
-
-	mov = new float[4*LORA_SFFT_LEN];
-	history = new short[1024];
-	finetune = new short[16];
+	m_lastFrame.m_spreadFactor = 0;
+	m_lastFrame.m_snrdB = 0.0f;
+	m_nbFrames = 0;
 
     m_channelizer = new DownChannelizer(this);
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
@@ -75,190 +64,20 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 
 LoRaDemod::~LoRaDemod()
 {
-	if (loraFilter)
-		delete loraFilter;
-	if (negaFilter)
-		delete negaFilter;
-	if (mov)
-		delete [] mov;
-	if (history)
-		delete [] history;
-	if (finetune)
-		delete [] finetune;
-
 	m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
 }
 
-void LoRaDemod::dumpRaw()
-{
-	short bin, j, max;
-	char text[256];
-
-	max = m_time / 4 - 3;
-
-	if (max > 140)
-	{
-		max = 140; // about 2 symbols to each char
-	}
-
-	for ( j=0; j < max; j++)
-	{
-		bin = (history[(j + 1)  * 4] + m_tune ) & (LORA_SFFT_LEN - 1);
-		text[j] = toGray(bin >> 1);
-	}
-
-	prng6(text, max);
-	// First block is always 8 symbols
-	interleave6(text, 6);
-	interleave6(&text[8], max);
-	hamming6(text, 6);
-	hamming6(&text[8], max);
-
-	for ( j=0; j < max / 2; j++)
-	{
-		text[j] = (text[j * 2 + 1] << 4) | (0xf & text[j * 2 + 0]);
-
-		if ((text[j] < 32 )||( text[j] > 126))
-		{
-			text[j] = 0x5f;
-		}
-	}
-
-	text[3] = text[2];
-	text[2] = text[1];
-	text[1] = text[0];
-	text[j] = 0;
-
-	printf("%s\n", &text[1]);
-}
-
-short LoRaDemod::synch(short bin)
-{
-	short i, j;
-
-	if (bin < 0)
-	{
-		if (m_time > 70)
-		{
-			dumpRaw();
-		}
-
-		m_time = 0;
-		return -1;
-	}
-
-	history[m_time] = bin;
-
-	if (m_time > 12)
-	{
-		if (bin == history[m_time - 6])
-		{
-			if (bin == history[m_time - 12])
-			{
-				m_tune = LORA_SFFT_LEN - bin;
-				j = 0;
-
-				for (i=0; i<12; i++)
-				{
-					j += finetune[15 & (m_time - i)];
-				}
-
-				if (j < 0)
-				{
-					m_tune += 1;
-				}
-
-				m_tune &= (LORA_SFFT_LEN - 1);
-				m_time = 0;
-				return -1;
-			}
-		}
-	}
-
-	m_time++;
-	m_time &= 1023;
-
-	if (m_time & 3)
-	{
-		return -1;
-	}
-
-	return (bin + m_tune) & (LORA_SFFT_LEN - 1);
-}
-
-int LoRaDemod::detect(Complex c, Complex a)
-{
-	int p, q;
-	short i, result, negresult, movpoint;
-	float peak, negpeak, tfloat;
-	float mag[LORA_SFFT_LEN];
-	float rev[LORA_SFFT_LEN];
-
-	loraFilter->run(c * a);
-	negaFilter->run(c * conj(a));
-
-	// process spectrum twice in FFTLEN
-	if (++m_count & ((1 << DATA_BITS) - 1))
-	{
-		return m_result;
-	}
-
-	movpoint = 3 & (m_count >> DATA_BITS);
-
-	loraFilter->fetch(mag);
-	negaFilter->fetch(rev);
-	peak = negpeak = 0.0f;
-	result = negresult = 0;
-
-	for (i = 0; i < LORA_SFFT_LEN; i++)
-	{
-		if (rev[i] > negpeak)
-		{
-			negpeak = rev[i];
-			negresult = i;
-		}
-
-		tfloat = mov[i] + mov[LORA_SFFT_LEN + i] +mov[2 * LORA_SFFT_LEN + i]
-				+ mov[3 * LORA_SFFT_LEN + i] + mag[i];
-
-		if (tfloat > peak)
-		{
-			peak = tfloat;
-			result = i;
-		}
-
-		mov[movpoint * LORA_SFFT_LEN + i] = mag[i];
-	}
-
-	p = (result - 1 + LORA_SFFT_LEN) & (LORA_SFFT_LEN -1);
-	q = (result + 1) & (LORA_SFFT_LEN -1);
-	finetune[15 & m_time] = (mag[p] > mag[q]) ? -1 : 1;
-
-	if (peak < negpeak * LORA_SQUELCH)
-	{
-		result = -1;
-	}
-
-	result = synch(result);
-
-	if (result >= 0)
-	{
-		m_result = result;
-	}
-
-	return m_result;
-}
-
 void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool pO)
 {
     (void) pO;
-	int newangle;
 	Complex ci;
+	unsigned int fftLength;
 
 	m_sampleBuffer.clear();
+	m_chipBuffer.clear();
 
 	m_settingsMutex.lock();
 
@@ -269,18 +88,27 @@ void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
-			m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
-                        m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
-			Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
-			newangle = detect(ci, cangle);
-
-			m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
-			Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
-			m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
+			m_chipBuffer.push_back(ci);
 			m_sampleDistanceRemain += (Real)m_sampleRate / m_Bandwidth;
 		}
 	}
 
+	// all spreading factors are processed by symbol blocks on the chips of this block
+	m_detector.process(m_chipBuffer.data(), m_chipBuffer.size());
+	int symbol = m_detector.getLastSymbol(fftLength);
+	Complex nangle(cos(M_PI*2*symbol/fftLength),sin(M_PI*2*symbol/fftLength));
+	m_sampleBuffer.resize(m_chipBuffer.size(), Sample(nangle.real() * 100, nangle.imag() * 100));
+
+	// frames are formatted by the GUI and the web API not here in the DSP thread
+	while (m_detector.popFrame(m_lastFrame))
+	{
+		m_nbFrames++;
+
+		if (getMessageQueueToGUI()) {
+			getMessageQueueToGUI()->push(MsgReportDecodeSymbols::create(m_lastFrame));
+		}
+	}
+
 	if(m_sampleSink != 0)
 	{
 		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), false);
@@ -311,6 +139,7 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 		m_nco.setFreq(-notif.getFrequencyOffset(), m_sampleRate);
 		m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
 		m_sampleDistanceRemain = m_sampleRate / m_Bandwidth;
+		m_detector.reset();
 
 		m_settingsMutex.unlock();
 
@@ -342,11 +171,13 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 
 		m_Bandwidth = LoRaDemodSettings::bandwidths[settings.m_bandwidthIndex];
 		m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
+		m_detector.setSpreadFactors(settings.m_spread == 0 ? 0 : LoRaDemodDetector::m_minSpreadFactor + settings.m_spread - 1);
 
 		m_settingsMutex.unlock();
 
 		m_settings = settings;
-		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth;
+		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth
+			<< " m_spread: " << settings.m_spread;
 
 		return true;
 	}
@@ -389,3 +220,36 @@ bool LoRaDemod::deserialize(const QByteArray& data)
     }
 }
 
+int LoRaDemod::webapiReportGet(
+        SWGSDRangel::SWGChannelReport& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setLoRaDemodReport(new SWGSDRangel::SWGLoRaDemodReport());
+    response.getLoRaDemodReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
+void LoRaDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    QMutexLocker mutexLocker(&m_settingsMutex);
+
+    response.getLoRaDemodReport()->setChannelSampleRate(m_sampleRate);
+    response.getLoRaDemodReport()->setNbFrames(m_nbFrames);
+    response.getLoRaDemodReport()->setSpreadFactor(m_lastFrame.m_spreadFactor);
+    response.getLoRaDemodReport()->setSnrDb(m_lastFrame.m_snrdB);
+    response.getLoRaDemodReport()->setNbSymbols(m_lastFrame.m_symbols.size());
+    *response.getLoRaDemodReport()->getSymbols() = formatSymbols(m_lastFrame.m_symbols);
+}
+
+QString LoRaDemod::formatSymbols(const std::vector<unsigned short>& symbols)
+{
+    QString text;
+
+    for (unsigned int i = 0; i < symbols.size(); i++) {
+        text.append(QString(i == 0 ? "%1" : " %1").arg(symbols[i], 3, 16, QChar('0')));
+    }
+
+    return text;
+}
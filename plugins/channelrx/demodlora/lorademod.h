@@ -27,15 +27,9 @@
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
 #include "util/message.h"
-#include "dsp/fftfilt.h"
 
 #include "lorademodsettings.h"
-
-#define DATA_BITS (6)
-#define SAMPLEBITS (DATA_BITS + 2)
-#define SPREADFACTOR (1 << SAMPLEBITS)
-#define LORA_SFFT_LEN (SPREADFACTOR / 2)
-#define LORA_SQUELCH (3)
+#include "lorademoddetector.h"
 
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
@@ -89,6 +83,32 @@ public:
         { }
     };
 
+    class MsgReportDecodeSymbols : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        unsigned int getSpreadFactor() const { return m_spreadFactor; }
+        float getSnrdB() const { return m_snrdB; }
+        const std::vector<unsigned short>& getSymbols() const { return m_symbols; }
+
+        static MsgReportDecodeSymbols* create(const LoRaDemodDetector::Frame& frame)
+        {
+            return new MsgReportDecodeSymbols(frame);
+        }
+
+    private:
+        unsigned int m_spreadFactor;
+        float m_snrdB;
+        std::vector<unsigned short> m_symbols;
+
+        MsgReportDecodeSymbols(const LoRaDemodDetector::Frame& frame) :
+            Message(),
+            m_spreadFactor(frame.m_spreadFactor),
+            m_snrdB(frame.m_snrdB),
+            m_symbols(frame.m_symbols)
+        { }
+    };
+
 	LoRaDemod(DeviceAPI* deviceAPI);
 	virtual ~LoRaDemod();
 	virtual void destroy() { delete this; }
@@ -116,18 +136,16 @@ public:
         return 0;
     }
 
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage);
+
+    static QString formatSymbols(const std::vector<unsigned short>& symbols); //!< space separated hexadecimal values
+
     static const QString m_channelIdURI;
     static const QString m_channelId;
 
 private:
-	int  detect(Complex sample, Complex angle);
-	void dumpRaw(void);
-	short synch (short bin);
-	short toGray(short bin);
-	void interleave6(char* inout, int size);
-	void hamming6(char* inout, int size);
-	void prng6(char* inout, int size);
-
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -136,20 +154,10 @@ private:
 	Real m_Bandwidth;
 	int m_sampleRate;
 	int m_frequency;
-	int m_chirp;
-	int m_angle;
-	int m_bin;
-	int m_result;
-	int m_count;
-	int m_header;
-	int m_time;
-	short m_tune;
-
-	sfft* loraFilter;
-	sfft* negaFilter;
-	float* mov;
-	short* history;
-	short* finetune;
+	LoRaDemodDetector m_detector;
+	std::vector<Complex> m_chipBuffer; //!< channel samples at the chip rate
+	LoRaDemodDetector::Frame m_lastFrame;
+	unsigned int m_nbFrames;
 
 	NCO m_nco;
 	Interpolator m_interpolator;
@@ -158,6 +166,8 @@ private:
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
 	QMutex m_settingsMutex;
+
+    void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
 };
 
 #endif // INCLUDE_LoRaDEMOD_H
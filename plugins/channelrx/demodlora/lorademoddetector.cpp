@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// LoRa chirp detector. The channel samples (one per chip) are dechirped and     //
+// transformed by symbol blocks for each spreading factor from SF7 to SF12 at    //
+// the same time so that a single channel receives every spreading factor used   //
+// by the gateways of a sub-band. A preamble aligns the symbol boundaries of its //
+// spreading factor and the following data symbols are collected into a frame.   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#include "dsp/fftengine.h"
+
+#include "lorademoddetector.h"
+
+const unsigned int LoRaDemodDetector::m_minSpreadFactor;
+const unsigned int LoRaDemodDetector::m_maxSpreadFactor;
+const unsigned int LoRaDemodDetector::m_nbSpreadFactors;
+const unsigned int LoRaDemodDetector::m_minPreambleSymbols;
+const unsigned int LoRaDemodDetector::m_maxSyncSymbols;
+const unsigned int LoRaDemodDetector::m_maxLostSymbols;
+const unsigned int LoRaDemodDetector::m_maxFrameSymbols;
+const unsigned int LoRaDemodDetector::m_maxFrames;
+const float LoRaDemodDetector::m_peakRatio = 16.0f; // noise alone peaks at about 8 times the average for SF12
+
+LoRaDemodDetector::LoRaDemodDetector() :
+    m_spreadFactor(0),
+    m_lastSymbol(0),
+    m_lastFFTLength(1 << m_minSpreadFactor)
+{
+    for (unsigned int i = 0; i < m_nbSpreadFactors; i++)
+    {
+        Lane& lane = m_lanes[i];
+        lane.m_spreadFactor = m_minSpreadFactor + i;
+        lane.m_fftLength = 1 << lane.m_spreadFactor;
+        lane.m_fft = FFTEngine::create();
+
+        if (lane.m_fft) {
+            lane.m_fft->configure(lane.m_fftLength, false);
+        }
+
+        // up chirp sweeping from -BW/2 to +BW/2 in one symbol at one sample per chip
+        lane.m_upChirp.resize(lane.m_fftLength);
+        lane.m_downChirp.resize(lane.m_fftLength);
+        lane.m_dataChirp.resize(lane.m_fftLength);
+        lane.m_symbol.resize(lane.m_fftLength);
+
+        for (unsigned int n = 0; n < lane.m_fftLength; n++)
+        {
+            double phase = M_PI * ((double) n * n / lane.m_fftLength - n);
+            lane.m_upChirp[n] = Complex(cos(phase), sin(phase));
+            lane.m_downChirp[n] = std::conj(lane.m_upChirp[n]);
+        }
+
+        resetLane(lane);
+    }
+}
+
+LoRaDemodDetector::~LoRaDemodDetector()
+{
+    for (unsigned int i = 0; i < m_nbSpreadFactors; i++) {
+        delete m_lanes[i].m_fft;
+    }
+}
+
+void LoRaDemodDetector::setSpreadFactors(unsigned int spreadFactor)
+{
+    m_spreadFactor = spreadFactor;
+    reset();
+}
+
+void LoRaDemodDetector::reset()
+{
+    for (unsigned int i = 0; i < m_nbSpreadFactors; i++) {
+        resetLane(m_lanes[i]);
+    }
+
+    m_frames.clear();
+}
+
+void LoRaDemodDetector::resetLane(Lane& lane)
+{
+    lane.m_fill = 0;
+    lane.m_skip = 0;
+    lane.m_state = StateDetect;
+    lane.m_preambleBin = 0;
+    lane.m_fineBin = 0.0f;
+    lane.m_preambleCount = 0;
+    lane.m_syncCount = 0;
+    lane.m_lostCount = 0;
+    lane.m_snrSum = 0.0;
+    lane.m_frame.m_symbols.clear();
+}
+
+bool LoRaDemodDetector::enabled(const Lane& lane) const
+{
+    return lane.m_fft && ((m_spreadFactor == 0) || (lane.m_spreadFactor == m_spreadFactor));
+}
+
+void LoRaDemodDetector::process(const Complex *samples, unsigned int nbSamples)
+{
+    // each lane runs through the whole block before the next one
+    for (unsigned int i = 0; i < m_nbSpreadFactors; i++)
+    {
+        Lane& lane = m_lanes[i];
+
+        if (!enabled(lane)) {
+            continue;
+        }
+
+        unsigned int index = 0;
+
+        while (index < nbSamples)
+        {
+            if (lane.m_skip > 0)
+            {
+                unsigned int skipped = std::min(lane.m_skip, nbSamples - index);
+                lane.m_skip -= skipped;
+                index += skipped;
+                continue;
+            }
+
+            unsigned int count = std::min(lane.m_fftLength - lane.m_fill, nbSamples - index);
+            std::copy(samples + index, samples + index + count, lane.m_symbol.begin() + lane.m_fill);
+            lane.m_fill += count;
+            index += count;
+
+            if (lane.m_fill == lane.m_fftLength)
+            {
+                processSymbol(lane);
+                lane.m_fill = 0;
+            }
+        }
+    }
+}
+
+int LoRaDemodDetector::dechirp(Lane& lane, const std::vector<Complex>& chirp, float& peakPower, float& ratio, float *fineBin)
+{
+    Complex *in = lane.m_fft->in();
+
+    for (unsigned int n = 0; n < lane.m_fftLength; n++) {
+        in[n] = lane.m_symbol[n] * chirp[n];
+    }
+
+    lane.m_fft->transform();
+
+    const Complex *out = lane.m_fft->out();
+    float total = 0.0f;
+    int peakBin = 0;
+    peakPower = 0.0f;
+
+    for (unsigned int n = 0; n < lane.m_fftLength; n++)
+    {
+        float power = std::norm(out[n]);
+        total += power;
+
+        if (power > peakPower)
+        {
+            peakPower = power;
+            peakBin = n;
+        }
+    }
+
+    float noisePower = (total - peakPower) / (lane.m_fftLength - 1);
+    ratio = noisePower > 0.0f ? peakPower / noisePower : 0.0f;
+
+    if (fineBin)
+    {
+        // the peak of a tone between two bins is shared in proportion of their magnitudes
+        int N = lane.m_fftLength;
+        float peak = std::abs(out[peakBin]);
+        float previous = std::abs(out[(peakBin + N - 1) % N]);
+        float next = std::abs(out[(peakBin + 1) % N]);
+        float fine = next > previous ? peakBin + next / (peak + next) : peakBin - previous / (peak + previous);
+        *fineBin = fine > N / 2 ? fine - N : fine;
+    }
+
+    return peakBin;
+}
+
+void LoRaDemodDetector::processSymbol(Lane& lane)
+{
+    int N = lane.m_fftLength;
+    float upPower, upRatio, upFineBin;
+    // a symbol delayed by d chips in the block or shifted by d bins in frequency dechirps to bin d
+    int upBin = dechirp(lane, lane.m_state == StateData ? lane.m_dataChirp : lane.m_downChirp, upPower, upRatio, &upFineBin);
+    bool detected = upRatio > m_peakRatio;
+
+    if (lane.m_state == StateDetect)
+    {
+        if (!detected)
+        {
+            lane.m_preambleCount = 0;
+            return;
+        }
+
+        int distance = (upBin - lane.m_preambleBin + N) % N;
+
+        if ((lane.m_preambleCount > 0) && ((distance <= 1) || (distance == N - 1))) {
+            lane.m_preambleCount++;
+        } else {
+            lane.m_preambleCount = 1;
+        }
+
+        lane.m_preambleBin = upBin;
+
+        if (lane.m_preambleCount >= m_minPreambleSymbols)
+        {
+            // the next block starts on a chirp boundary up to the frequency offset
+            lane.m_skip = (N - upBin) % N;
+            lane.m_preambleBin = 0;
+            lane.m_fineBin = 0.0f;
+            lane.m_syncCount = 0;
+            lane.m_state = StateSync;
+        }
+    }
+    else if (lane.m_state == StateSync)
+    {
+        float downPower, downRatio, downFineBin;
+        dechirp(lane, lane.m_upChirp, downPower, downRatio, &downFineBin);
+
+        if ((downRatio > m_peakRatio) && (downPower > upPower))
+        {
+            // up chirps dechirp to offset + delay and down chirps to offset - delay
+            float difference = lane.m_fineBin - downFineBin;
+            difference = difference > N / 2 ? difference - N : difference < -N / 2 ? difference + N : difference;
+            int delay = lroundf(difference / 2.0f);
+            // rest of the 2.25 down chirps
+            lane.m_skip = (5 * N) / 4 - delay;
+            // the frequency offset and the delay left after the alignment shift the up chirps alike
+            float offset = lane.m_fineBin - delay;
+
+            for (int n = 0; n < N; n++)
+            {
+                float phase = -2.0f * M_PI * offset * n / N;
+                lane.m_dataChirp[n] = lane.m_downChirp[n] * Complex(cos(phase), sin(phase));
+            }
+
+            lane.m_lostCount = 0;
+            lane.m_snrSum = 0.0;
+            lane.m_frame.m_symbols.clear();
+            lane.m_state = StateData;
+            return;
+        }
+
+        int distance = (upBin - lane.m_preambleBin + N) % N;
+
+        if (detected && ((distance <= 1) || (distance == N - 1)))
+        {
+            // follows the drift over the preamble, the sync word is ignored
+            lane.m_preambleBin = upBin;
+            lane.m_fineBin = upFineBin;
+        }
+
+        if (++lane.m_syncCount > m_maxSyncSymbols) {
+            resetLane(lane);
+        }
+    }
+    else
+    {
+        lane.m_frame.m_symbols.push_back(upBin);
+
+        if (detected)
+        {
+            lane.m_lostCount = 0;
+            lane.m_snrSum += 10.0 * log10(upRatio / N); // processing gain removed
+            m_lastSymbol = upBin;
+            m_lastFFTLength = N;
+        }
+        else
+        {
+            lane.m_lostCount++;
+        }
+
+        if ((lane.m_lostCount >= m_maxLostSymbols) || (lane.m_frame.m_symbols.size() >= m_maxFrameSymbols)) {
+            endFrame(lane);
+        }
+    }
+}
+
+void LoRaDemodDetector::endFrame(Lane& lane)
+{
+    std::vector<unsigned short>& symbols = lane.m_frame.m_symbols;
+    symbols.resize(symbols.size() - lane.m_lostCount);
+
+    if (symbols.size() > 0)
+    {
+        if (m_frames.size() >= m_maxFrames) {
+            m_frames.erase(m_frames.begin());
+        }
+
+        lane.m_frame.m_spreadFactor = lane.m_spreadFactor;
+        lane.m_frame.m_snrdB = lane.m_snrSum / symbols.size();
+        m_frames.push_back(lane.m_frame);
+    }
+
+    resetLane(lane);
+}
+
+bool LoRaDemodDetector::popFrame(Frame& frame)
+{
+    if (m_frames.size() == 0) {
+        return false;
+    }
+
+    frame = m_frames.front();
+    m_frames.erase(m_frames.begin());
+    return true;
+}
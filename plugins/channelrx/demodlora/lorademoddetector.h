@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// LoRa chirp detector. The channel samples (one per chip) are dechirped and     //
+// transformed by symbol blocks for each spreading factor from SF7 to SF12 at    //
+// the same time so that a single channel receives every spreading factor used   //
+// by the gateways of a sub-band. A preamble aligns the symbol boundaries of its //
+// spreading factor and the following data symbols are collected into a frame.   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_DEMODLORA_LORADEMODDETECTOR_H_
+#define PLUGINS_CHANNELRX_DEMODLORA_LORADEMODDETECTOR_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+
+class FFTEngine;
+
+class LoRaDemodDetector
+{
+public:
+    struct Frame
+    {
+        unsigned int m_spreadFactor;
+        float m_snrdB;                         //!< average over the data symbols
+        std::vector<unsigned short> m_symbols;
+    };
+
+    static const unsigned int m_minSpreadFactor = 7;
+    static const unsigned int m_maxSpreadFactor = 12;
+    static const unsigned int m_nbSpreadFactors = m_maxSpreadFactor - m_minSpreadFactor + 1;
+
+    LoRaDemodDetector();
+    ~LoRaDemodDetector();
+
+    void setSpreadFactors(unsigned int spreadFactor); //!< 0 for all spreading factors
+    void reset();
+    void process(const Complex *samples, unsigned int nbSamples); //!< samples at the chip rate
+    bool popFrame(Frame& frame);
+    int getLastSymbol(unsigned int& fftLength) const { fftLength = m_lastFFTLength; return m_lastSymbol; }
+
+private:
+    enum State
+    {
+        StateDetect, //!< looking for repeated up chirps
+        StateSync,   //!< aligned on the preamble, looking for the down chirps
+        StateData
+    };
+
+    struct Lane
+    {
+        unsigned int m_spreadFactor;
+        unsigned int m_fftLength;
+        FFTEngine *m_fft;
+        std::vector<Complex> m_downChirp;
+        std::vector<Complex> m_upChirp;
+        std::vector<Complex> m_dataChirp; //!< down chirp with the frequency offset of the frame
+        std::vector<Complex> m_symbol;  //!< samples of the current symbol block
+        unsigned int m_fill;
+        unsigned int m_skip;            //!< samples dropped to align the symbol blocks
+        State m_state;
+        int m_preambleBin;
+        float m_fineBin;                //!< preamble bin with its fraction
+        unsigned int m_preambleCount;
+        unsigned int m_syncCount;
+        unsigned int m_lostCount;
+        double m_snrSum;
+        Frame m_frame;
+    };
+
+    static const unsigned int m_minPreambleSymbols = 4;
+    static const unsigned int m_maxSyncSymbols = 16;  //!< preamble rest and sync word before the down chirps
+    static const unsigned int m_maxLostSymbols = 2;   //!< end of frame
+    static const unsigned int m_maxFrameSymbols = 2048;
+    static const unsigned int m_maxFrames = 16;       //!< oldest frames are dropped if not popped
+    static const float m_peakRatio;                   //!< peak to average bin power for a symbol
+
+    Lane m_lanes[m_nbSpreadFactors];
+    unsigned int m_spreadFactor;
+    std::vector<Frame> m_frames;
+    int m_lastSymbol;
+    unsigned int m_lastFFTLength;
+
+    void resetLane(Lane& lane);
+    bool enabled(const Lane& lane) const;
+    void processSymbol(Lane& lane);
+    int dechirp(Lane& lane, const std::vector<Complex>& chirp, float& peakPower, float& ratio, float *fineBin = nullptr);
+    void endFrame(Lane& lane);
+};
+
+#endif /* PLUGINS_CHANNELRX_DEMODLORA_LORADEMODDETECTOR_H_ */
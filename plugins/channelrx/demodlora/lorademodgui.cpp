@@ -3,6 +3,8 @@
 #include <dsp/downchannelizer.h>
 #include <QDockWidget>
 #include <QMainWindow>
+#include <QDateTime>
+#include <QScrollBar>
 
 #include "ui_lorademodgui.h"
 #include "dsp/spectrumvis.h"
@@ -71,8 +73,39 @@ bool LoRaDemodGUI::deserialize(const QByteArray& data)
 
 bool LoRaDemodGUI::handleMessage(const Message& message)
 {
-    (void) message;
-	return false;
+    if (LoRaDemod::MsgReportDecodeSymbols::match(message))
+    {
+        displayFrame((const LoRaDemod::MsgReportDecodeSymbols&) message);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void LoRaDemodGUI::handleInputMessages()
+{
+    Message* message;
+
+    while ((message = getInputMessageQueue()->pop()) != 0)
+    {
+        if (handleMessage(*message)) {
+            delete message;
+        }
+    }
+}
+
+void LoRaDemodGUI::displayFrame(const LoRaDemod::MsgReportDecodeSymbols& report)
+{
+    QString dateStr = QDateTime::currentDateTime().toString("HH:mm:ss");
+    ui->messageText->appendPlainText(tr("%1 SF%2 %3 dB %4 symbols: %5")
+        .arg(dateStr)
+        .arg(report.getSpreadFactor())
+        .arg(report.getSnrdB(), 0, 'f', 1)
+        .arg(report.getSymbols().size())
+        .arg(LoRaDemod::formatSymbols(report.getSymbols())));
+    ui->messageText->verticalScrollBar()->setValue(ui->messageText->verticalScrollBar()->maximum());
 }
 
 void LoRaDemodGUI::viewChanged()
@@ -99,7 +132,18 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spread = value;
+    ui->SpreadText->setText(getSpreadText(value));
+    applySettings();
+}
+
+QString LoRaDemodGUI::getSpreadText(int spread)
+{
+    if (spread == 0) {
+        return tr("SF7-12");
+    } else {
+        return tr("SF%1").arg(LoRaDemodDetector::m_minSpreadFactor + spread - 1);
+    }
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -123,6 +167,7 @@ LoRaDemodGUI::LoRaDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseb
 	m_spectrumVis = new SpectrumVis(SDR_RX_SCALEF, ui->glSpectrum);
 	m_LoRaDemod = (LoRaDemod*) rxChannel; //new LoRaDemod(m_deviceUISet->m_deviceSourceAPI);
 	m_LoRaDemod->setSpectrumSink(m_spectrumVis);
+	m_LoRaDemod->setMessageQueueToGUI(getInputMessageQueue());
 
 	ui->glSpectrum->setCenterFrequency(16000);
 	ui->glSpectrum->setSampleRate(32000);
@@ -143,6 +188,9 @@ LoRaDemodGUI::LoRaDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseb
 	m_settings.setChannelMarker(&m_channelMarker);
 	m_settings.setSpectrumGUI(ui->spectrumGUI);
 
+	ui->messageText->setMaximumBlockCount(100); // oldest frames are dropped
+	connect(getInputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+
 	displaySettings();
 	applySettings(true);
 }
@@ -190,5 +238,7 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->SpreadText->setText(getSpreadText(m_settings.m_spread));
+    ui->Spread->setValue(m_settings.m_spread);
     blockApplySettings(false);
 }
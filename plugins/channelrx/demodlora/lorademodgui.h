@@ -7,10 +7,10 @@
 #include "util/messagequeue.h"
 
 #include "lorademodsettings.h"
+#include "lorademod.h"
 
 class PluginAPI;
 class DeviceUISet;
-class LoRaDemod;
 class SpectrumVis;
 class BasebandSampleSink;
 
@@ -38,6 +38,7 @@ public:
 
 private slots:
 	void viewChanged();
+	void handleInputMessages();
 	void on_BW_valueChanged(int value);
 	void on_Spread_valueChanged(int value);
 	void onWidgetRolled(QWidget* widget, bool rollDown);
@@ -60,6 +61,8 @@ private:
     void blockApplySettings(bool block);
 	void applySettings(bool force = false);
 	void displaySettings();
+	QString getSpreadText(int spread);
+	void displayFrame(const LoRaDemod::MsgReportDecodeSymbols& report);
 };
 
 #endif // INCLUDE_LoRaDEMODGUI_H
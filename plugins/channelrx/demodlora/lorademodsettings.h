@@ -13,7 +13,7 @@ struct LoRaDemodSettings
 {
     int m_centerFrequency;
     int m_bandwidthIndex;
-    int m_spread;
+    int m_spread; //!< 0 for all spreading factors else SF6 + m_spread
     uint32_t m_rgbColor;
     QString m_title;
 
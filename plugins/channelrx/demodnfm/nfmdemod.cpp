@@ -21,9 +21,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include "SWGChannelSettings.h"
 #include "SWGNFMDemodSettings.h"
@@ -39,6 +36,7 @@
 #include "dsp/dspcommands.h"
 #include "dsp/devicesamplemimo.h"
 #include "device/deviceapi.h"
+#include "webapi/webapireversedispatcher.h"
 
 #include "nfmdemod.h"
 
@@ -100,15 +98,10 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
 
 NFMDemod::~NFMDemod()
 {
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
 	m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
@@ -921,38 +914,8 @@ void NFMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, co
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
-
-void NFMDemod::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "NFMDemod::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("NFMDemod::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
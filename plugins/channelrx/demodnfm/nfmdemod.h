@@ -22,7 +22,6 @@
 #include <vector>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -41,8 +40,6 @@
 
 #include "nfmdemodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -263,9 +260,6 @@ private:
 
     PhaseDiscriminators m_phaseDiscri;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     static const int m_udpBlockSize;
 
 //    void apply(bool force = false);
@@ -276,9 +270,6 @@ private:
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const NFMDemodSettings& settings, bool force);
 
     void processOneSample(Complex &ci);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // INCLUDE_NFMDEMOD_H
@@ -22,7 +22,6 @@
 #include <vector>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -39,8 +38,6 @@
 #define ssbFftLen 1024
 #define agcTarget 3276.8 // -10 dB amplitude => -20 dB power: center of normal signal
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -338,9 +335,6 @@ private:
 	AudioFifo m_audioFifo;
 	quint32 m_audioSampleRate;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
 	QMutex m_settingsMutex;
 
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
@@ -350,9 +344,6 @@ private:
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const SSBDemodSettings& settings, bool force);
 
     void processOneSample(Complex &ci);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // INCLUDE_SSBDEMOD_H
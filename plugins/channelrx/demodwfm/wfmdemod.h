@@ -22,7 +22,6 @@
 #include <vector>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -39,8 +38,6 @@
 
 #define rfFilterFftLength 1024
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
 class DeviceAPI;
@@ -230,9 +227,6 @@ private:
 
 	PhaseDiscriminators m_phaseDiscri;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     static const int m_udpBlockSize;
 
     void applyAudioSampleRate(int sampleRate);
@@ -241,9 +235,6 @@ private:
 
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const WFMDemodSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // INCLUDE_WFMDEMOD_H
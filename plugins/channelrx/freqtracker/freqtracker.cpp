@@ -20,9 +20,6 @@
 #include <QTime>
 #include <QTimer>
 #include <QDebug>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QBuffer>
 
 #include <stdio.h>
 #include <complex.h>
@@ -42,6 +39,7 @@
 #include "device/deviceapi.h"
 #include "util/db.h"
 #include "util/stepfunctions.h"
+#include "webapi/webapireversedispatcher.h"
 
 MESSAGE_CLASS_DEFINITION(FreqTracker::MsgConfigureFreqTracker, Message)
 MESSAGE_CLASS_DEFINITION(FreqTracker::MsgSampleRateNotification, Message)
@@ -89,9 +87,6 @@ FreqTracker::FreqTracker(DeviceAPI *deviceAPI) :
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
-
-    m_networkManager = new QNetworkAccessManager();
-    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
 
 FreqTracker::~FreqTracker()
@@ -101,8 +96,6 @@ FreqTracker::~FreqTracker()
     m_timer->stop();
     delete m_timer;
 #endif
-    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
-    delete m_networkManager;
     m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
@@ -757,42 +750,12 @@ void FreqTracker::webapiReverseSendSettings(QList<QString>& channelSettingsKeys,
             .arg(settings.m_reverseAPIPort)
             .arg(settings.m_reverseAPIDeviceIndex)
             .arg(settings.m_reverseAPIChannelIndex);
-    m_networkRequest.setUrl(QUrl(channelSettingsURL));
-    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QBuffer *buffer = new QBuffer();
-    buffer->open((QBuffer::ReadWrite));
-    buffer->write(swgChannelSettings->asJson().toUtf8());
-    buffer->seek(0);
-
     // Always use PATCH to avoid passing reverse API settings
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
-    buffer->setParent(reply);
+    WebAPIReverseDispatcher::instance()->sendSettings(channelSettingsURL, swgChannelSettings->asJson());
 
     delete swgChannelSettings;
 }
 
-void FreqTracker::networkManagerFinished(QNetworkReply *reply)
-{
-    QNetworkReply::NetworkError replyError = reply->error();
-
-    if (replyError)
-    {
-        qWarning() << "FreqTracker::networkManagerFinished:"
-                << " error(" << (int) replyError
-                << "): " << replyError
-                << ": " << reply->errorString();
-    }
-    else
-    {
-        QString answer = reply->readAll();
-        answer.chop(1); // remove last \n
-        qDebug("FreqTracker::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
-    }
-
-    reply->deleteLater();
-}
-
 void FreqTracker::tick()
 {
     if (getSquelchOpen()) {
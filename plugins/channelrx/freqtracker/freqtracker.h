@@ -20,7 +20,6 @@
 
 #include <vector>
 
-#include <QNetworkRequest>
 #include <QMutex>
 
 #include "dsp/basebandsamplesink.h"
@@ -38,8 +37,6 @@
 
 #include "freqtrackersettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class DownChannelizer;
 class ThreadedBasebandSampleSink;
@@ -245,8 +242,6 @@ private:
 	MovingAverageUtil<Real, double, 16> m_movingAverage;
 
     static const int m_udpBlockSize;
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
 
     const QTimer *m_timer;
     bool m_timerConnected;
@@ -267,7 +262,6 @@ private:
     void processOneSample(Complex &ci);
 
 private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 	void tick();
 };
 
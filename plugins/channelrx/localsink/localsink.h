@@ -20,7 +20,6 @@
 
 #include <QObject>
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -31,8 +30,6 @@ class DeviceSampleSource;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
 class LocalSinkThread;
-class QNetworkAccessManager;
-class QNetworkReply;
 
 class LocalSink : public BasebandSampleSink, public ChannelAPI {
     Q_OBJECT
@@ -177,18 +174,12 @@ private:
     uint32_t m_sampleRate;
     uint32_t m_deviceSampleRate;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const LocalSinkSettings& settings, bool force = false);
     DeviceSampleSource *getLocalDevice(uint32_t index);
     void propagateSampleRateAndFrequency(uint32_t index);
     static void validateFilterChainHash(LocalSinkSettings& settings);
     void calculateFrequencyOffset();
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const LocalSinkSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif /* INCLUDE_LOCALSINK_H_ */
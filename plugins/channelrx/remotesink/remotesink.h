@@ -27,14 +27,11 @@
 #include <channel/remotedatablock.h>
 #include <QObject>
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "remotesinksettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
@@ -199,16 +196,11 @@ private:
     int m_txDelay;
     QString m_dataAddress;
     uint16_t m_dataPort;
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
 
     void applySettings(const RemoteSinkSettings& settings, bool force = false);
     static void validateFilterChainHash(RemoteSinkSettings& settings);
     void calculateFrequencyOffset();
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RemoteSinkSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif /* INCLUDE_REMOTESINK_H_ */
@@ -21,7 +21,6 @@
 
 #include <QMutex>
 #include <QHostAddress>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -38,8 +37,6 @@
 
 #include "udpsinksettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QUdpSocket;
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
@@ -160,9 +157,6 @@ public:
 public slots:
     void audioReadyRead();
 
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
-
 protected:
 	class MsgUDPSinkSpectrum : public Message {
 		MESSAGE_CLASS_DECLARATION
@@ -255,9 +249,6 @@ protected:
     MagAGC m_agc;
     Bandpass<double> m_bandpass;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
 	QMutex m_settingsMutex;
 
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = true);
@@ -26,7 +26,6 @@
 #include <QString>
 #include <QByteArray>
 #include <QTimer>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -35,8 +34,6 @@
 #include "filesourcesettings.h"
 #include "filesourcereport.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 
 class DeviceAPI;
 class FileSourceBaseband;
@@ -260,17 +257,11 @@ private:
     uint32_t m_basebandSampleRate;
     double m_linearGain;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const FileSourceSettings& settings, bool force = false);
     static void validateFilterChainHash(FileSourceSettings& settings);
     void calculateFrequencyOffset();
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const FileSourceSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // PLUGINS_CHANNELTX_FILESOURCE_FILESOURCE_H_
@@ -20,15 +20,12 @@
 
 #include <QObject>
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "util/message.h"
 #include "channel/channelapi.h"
 #include "localsourcesettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 
 class DeviceAPI;
@@ -142,9 +139,6 @@ private:
     int64_t m_frequencyOffset;
     uint32_t m_basebandSampleRate;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     QMutex m_settingsMutex;
 
     void applySettings(const LocalSourceSettings& settings, bool force = false);
@@ -154,9 +148,6 @@ private:
     DeviceSampleSink *getLocalDevice(uint32_t index);
 
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const LocalSourceSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif /* INCLUDE_LOCALSOURCE_H_ */
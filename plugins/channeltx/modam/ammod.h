@@ -23,7 +23,6 @@
 #include <fstream>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -31,8 +30,6 @@
 
 #include "ammodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 class AMModBaseband;
 class DeviceAPI;
@@ -249,18 +246,12 @@ private:
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const AMModSettings& settings, bool force = false);
     void openFileStream();
     void seekFileStream(int seekPercentage);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AMModSettings& settings, bool force);
     void webapiReverseSendCWSettings(const CWKeyerSettings& settings);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 
@@ -23,7 +23,6 @@
 #include <fstream>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -31,8 +30,6 @@
 
 #include "atvmodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 class ATVModBaseband;
 class DeviceAPI;
@@ -310,15 +307,9 @@ private:
     ATVModBaseband* m_basebandSource;
     ATVModSettings m_settings;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const ATVModSettings& settings, bool force = false);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const ATVModSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif /* PLUGINS_CHANNELTX_MODAM_AMMOD_H_ */
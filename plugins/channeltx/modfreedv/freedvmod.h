@@ -23,7 +23,6 @@
 #include <fstream>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -32,8 +31,6 @@
 
 #include "freedvmodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 class DeviceAPI;
 class CWKeyer;
@@ -257,18 +254,12 @@ private:
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_fileSampleRate;  //!< speech (input) sample rate (fixed 8000 S/s)
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const FreeDVModSettings& settings, bool force = false);
     void openFileStream();
     void seekFileStream(int seekPercentage);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const FreeDVModSettings& settings, bool force);
     void webapiReverseSendCWSettings(const CWKeyerSettings& settings);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 
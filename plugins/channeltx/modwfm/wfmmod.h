@@ -23,7 +23,6 @@
 #include <fstream>
 
 #include <QMutex>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -31,8 +30,6 @@
 
 #include "wfmmodsettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 class DeviceAPI;
 class CWKeyer;
@@ -259,9 +256,6 @@ private:
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     static const int m_levelNbSamples;
 
     void applySettings(const WFMModSettings& settings, bool force = false);
@@ -270,9 +264,6 @@ private:
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const WFMModSettings& settings, bool force);
     void webapiReverseSendCWSettings(const CWKeyerSettings& settings);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 
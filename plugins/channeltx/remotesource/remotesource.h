@@ -19,7 +19,6 @@
 #define PLUGINS_CHANNELTX_REMOTESRC_REMOTESRC_H_
 
 #include <QObject>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -27,8 +26,6 @@
 
 #include "remotesourcesettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 
 class DeviceAPI;
@@ -215,15 +212,9 @@ private:
     RemoteSourceBaseband *m_basebandSource;
     RemoteSourceSettings m_settings;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const RemoteSourceSettings& settings, bool force = false);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RemoteSourceSettings& settings, bool force);
-
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
 };
 
 #endif // PLUGINS_CHANNELTX_REMOTESRC_REMOTESRC_H_
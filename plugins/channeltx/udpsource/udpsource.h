@@ -19,7 +19,6 @@
 #define PLUGINS_CHANNELTX_UDPSINK_UDPSOURCE_H_
 
 #include <QObject>
-#include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
 #include "channel/channelapi.h"
@@ -28,8 +27,6 @@
 
 #include "udpsourcesettings.h"
 
-class QNetworkAccessManager;
-class QNetworkReply;
 class QThread;
 class DeviceAPI;
 class UDPSourceBaseband;
@@ -154,9 +151,6 @@ public:
     static const QString m_channelIdURI;
     static const QString m_channelId;
 
-private slots:
-    void networkManagerFinished(QNetworkReply *reply);
-
 private:
     DeviceAPI* m_deviceAPI;
     QThread *m_thread;
@@ -166,9 +160,6 @@ private:
     SampleVector m_sampleBuffer;
     QMutex m_settingsMutex;
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkRequest m_networkRequest;
-
     void applySettings(const UDPSourceSettings& settings, bool force = false);
 
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
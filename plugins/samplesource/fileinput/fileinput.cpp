@@ -32,6 +32,7 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspengine.h"
 #include "dsp/filerecord.h"
+#include "dsp/filerecordindex.h"
 #include "device/deviceapi.h"
 
 #include "fileinput.h"
@@ -41,6 +42,8 @@ MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInput, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInputWork, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceSeek, Message)
+MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceSeekTimestamp, Message)
+MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceSeekEvent, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInputStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgStartStop, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgPlayPause, Message)
@@ -89,22 +92,10 @@ void FileInput::openFileStream()
 {
 	//stopInput();
 
-	if (m_ifstream.is_open()) {
-		m_ifstream.close();
-	}
-
-#ifdef Q_OS_WIN
-	m_ifstream.open(m_fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
-#else
-	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
-#endif
-	quint64 fileSize = m_ifstream.tellg();
-
-	if (fileSize > sizeof(FileRecord::Header))
+	if (m_reader.open(m_fileName))
 	{
-	    FileRecord::Header header;
-	    m_ifstream.seekg(0,std::ios_base::beg);
-		bool crcOK = FileRecord::readHeader(m_ifstream, header);
+	    const FileRecord::Header& header = m_reader.getHeader();
+		bool crcOK = m_reader.isHeaderCRCOK();
 		m_sampleRate = header.sampleRate;
 		m_centerFrequency = header.centerFrequency;
 		m_startingTimeStamp = header.startTimeStamp;
@@ -114,7 +105,11 @@ void FileInput::openFileStream()
 	    if (crcOK)
 	    {
 	        qDebug("FileInput::openFileStream: CRC32 OK for header: %s", qPrintable(crcHex));
-	        m_recordLength = (fileSize - sizeof(FileRecord::Header)) / ((m_sampleSize == 24 ? 8 : 4) * m_sampleRate);
+	        m_recordLength = m_sampleRate == 0 ? 0 : m_reader.getNbSamples() / m_sampleRate;
+
+	        if (!m_reader.loadIndex()) {
+	            qDebug("FileInput::openFileStream: no index for this record");
+	        }
 	    }
 	    else
 	    {
@@ -133,7 +128,7 @@ void FileInput::openFileStream()
 	}
 
 	qDebug() << "FileInput::openFileStream: " << m_fileName.toStdString().c_str()
-			<< " fileSize: " << fileSize << " bytes"
+			<< " fileSize: " << m_reader.getFileSize() << " bytes"
 			<< " length: " << m_recordLength << " seconds"
 			<< " sample rate: " << m_sampleRate << " S/s"
 			<< " center frequency: " << m_centerFrequency << " Hz"
@@ -149,7 +144,7 @@ void FileInput::openFileStream()
 	}
 
 	if (m_recordLength == 0) {
-	    m_ifstream.close();
+	    m_reader.close();
 	}
 }
 
@@ -157,13 +152,84 @@ void FileInput::seekFileStream(int seekMillis)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && m_fileInputThread && !m_fileInputThread->isRunning())
+	if (m_reader.isOpen() && m_fileInputThread && !m_fileInputThread->isRunning())
 	{
-        quint64 seekPoint = ((m_recordLength * seekMillis) / 1000) * m_sampleRate;
+        quint64 seekPoint = (m_reader.getNbSamples() * seekMillis) / 1000;
 		m_fileInputThread->setSamplesCount(seekPoint);
-        seekPoint *= (m_sampleSize == 24 ? 8 : 4); // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		m_reader.seekSample(seekPoint);
+	}
+}
+
+void FileInput::seekFileStreamTimestamp(quint64 timestamp)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_reader.isOpen() || !m_fileInputThread) {
+		return;
+	}
+
+	bool running = m_fileInputThread->isRunning();
+
+	if (running) {
+		m_fileInputThread->stopWork();
+	}
+
+	const FileRecordIndex& index = m_reader.getIndex();
+	int blockIndex = index.findBlock(timestamp);
+
+	if (blockIndex >= 0)
+	{
+		const FileRecordIndex::Block& block = index.getBlock(blockIndex);
+		quint64 seekPoint = (quint64) blockIndex * index.getBlockSize() + ((timestamp - block.timestamp) * m_sampleRate) / 1000ULL;
+		m_reader.seekSample(seekPoint);
+	}
+	else
+	{
+		m_reader.seekTimestamp(timestamp);
+	}
+
+	qDebug("FileInput::seekFileStreamTimestamp: %llu ms: sample %llu", timestamp, m_reader.getSamplePosition());
+	m_fileInputThread->setSamplesCount(m_reader.getSamplePosition());
+
+	if (running) {
+		m_fileInputThread->startWork();
+	}
+}
+
+void FileInput::seekFileStreamEvent(float peakPowerDb)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	const FileRecordIndex& index = m_reader.getIndex();
+
+	if (!m_reader.isOpen() || !m_fileInputThread || (index.getNbBlocks() == 0) || (index.getBlockSize() == 0))
+	{
+		qWarning("FileInput::seekFileStreamEvent: no record index");
+		return;
+	}
+
+	// search from the block after the one being played
+	unsigned int fromBlock = m_reader.getSamplePosition() / index.getBlockSize() + 1;
+	int blockIndex = index.findEvent(peakPowerDb, fromBlock);
+
+	if (blockIndex < 0)
+	{
+		qDebug("FileInput::seekFileStreamEvent: no block at or above %.1f dB from block %u", peakPowerDb, fromBlock);
+		return;
+	}
+
+	bool running = m_fileInputThread->isRunning();
+
+	if (running) {
+		m_fileInputThread->stopWork();
+	}
+
+	quint64 seekPoint = (quint64) blockIndex * index.getBlockSize();
+	m_reader.seekSample(seekPoint);
+	qDebug("FileInput::seekFileStreamEvent: %.1f dB: block %d sample %llu", peakPowerDb, blockIndex, seekPoint);
+	m_fileInputThread->setSamplesCount(seekPoint);
+
+	if (running) {
+		m_fileInputThread->startWork();
 	}
 }
 
@@ -175,7 +241,7 @@ void FileInput::init()
 
 bool FileInput::start()
 {
-    if (!m_ifstream.is_open())
+    if (!m_reader.isOpen())
     {
         qWarning("FileInput::start: file not open. not starting");
         return false;
@@ -184,18 +250,17 @@ bool FileInput::start()
 	QMutexLocker mutexLocker(&m_mutex);
 	qDebug() << "FileInput::start";
 
-	if (m_ifstream.tellg() != (std::streampos)0) {
-		m_ifstream.clear();
-		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
-	}
+	m_reader.seekSample(0);
 
-	if(!m_sampleFifo.setSize(m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample))) {
+	if(!m_sampleFifo.setSize(getPlaybackRate(m_settings) * sizeof(Sample))) {
 		qCritical("Could not allocate SampleFifo");
 		return false;
 	}
 
-	m_fileInputThread = new FileInputThread(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
-	m_fileInputThread->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+	m_fileInputThread = new FileInputThread(&m_reader, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
+	m_fileInputThread->setSampleRateAndSize(getPlaybackRate(m_settings), m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+	m_fileInputThread->setDeviceSourceEngine(m_deviceAPI->getDeviceSourceEngine());
+	m_fileInputThread->setAsFastAsPossible(m_settings.m_asFastAsPossible);
 	m_fileInputThread->startWork();
 	m_deviceDescription = "FileInput";
 
@@ -287,6 +352,12 @@ void FileInput::setCenterFrequency(qint64 centerFrequency)
     }
 }
 
+int FileInput::getPlaybackRate(const FileInputSettings& settings) const
+{
+    // as fast as possible mode is paced by the processing chain: the chunks are sized for real time
+    return settings.m_asFastAsPossible ? m_sampleRate : settings.m_accelerationFactor * m_sampleRate;
+}
+
 quint64 FileInput::getStartingTimeStamp() const
 {
 	return m_startingTimeStamp;
@@ -332,6 +403,20 @@ bool FileInput::handleMessage(const Message& message)
 
 		return true;
 	}
+	else if (MsgConfigureFileSourceSeekTimestamp::match(message))
+	{
+		MsgConfigureFileSourceSeekTimestamp& conf = (MsgConfigureFileSourceSeekTimestamp&) message;
+		seekFileStreamTimestamp(conf.getTimestamp());
+
+		return true;
+	}
+	else if (MsgConfigureFileSourceSeekEvent::match(message))
+	{
+		MsgConfigureFileSourceSeekEvent& conf = (MsgConfigureFileSourceSeekEvent&) message;
+		seekFileStreamEvent(conf.getPeakPowerDb());
+
+		return true;
+	}
 	else if (MsgConfigureFileInputStreamTiming::match(message))
 	{
 		MsgReportFileInputStreamTiming *report;
@@ -411,18 +496,32 @@ bool FileInput::applySettings(const FileInputSettings& settings, bool force)
         m_centerFrequency = settings.m_centerFrequency;
     }
 
-    if ((m_settings.m_accelerationFactor != settings.m_accelerationFactor) || force)
-    {
+    if ((m_settings.m_accelerationFactor != settings.m_accelerationFactor) || force) {
         reverseAPIKeys.append("accelerationFactor");
+    }
+    if ((m_settings.m_asFastAsPossible != settings.m_asFastAsPossible) || force) {
+        reverseAPIKeys.append("asFastAsPossible");
+    }
 
+    if ((m_settings.m_accelerationFactor != settings.m_accelerationFactor)
+        || (m_settings.m_asFastAsPossible != settings.m_asFastAsPossible) || force)
+    {
         if (m_fileInputThread)
         {
             QMutexLocker mutexLocker(&m_mutex);
-            if (!m_sampleFifo.setSize(m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample))) {
+            bool working = m_fileInputThread->isRunning();
+
+            if (!m_sampleFifo.setSize(getPlaybackRate(settings) * sizeof(Sample))) {
                 qCritical("FileInput::applySettings: could not reallocate sample FIFO size to %lu",
-                        m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample));
+                        getPlaybackRate(settings) * sizeof(Sample));
+            }
+
+            m_fileInputThread->setSampleRateAndSize(getPlaybackRate(settings), m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+            m_fileInputThread->setAsFastAsPossible(settings.m_asFastAsPossible);
+
+            if (working && !m_fileInputThread->isRunning()) {
+                m_fileInputThread->startWork();
             }
-            m_fileInputThread->setSampleRateAndSize(settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
         }
     }
 
@@ -476,6 +575,18 @@ int FileInput::webapiSettingsPutPatch(
         m_guiMessageQueue->push(msgToGUI);
     }
 
+    // seek requests are not settings: they are applied once after the settings
+    if (deviceSettingsKeys.contains("seekTimestamp"))
+    {
+        MsgConfigureFileSourceSeekTimestamp *msgSeek = MsgConfigureFileSourceSeekTimestamp::create(response.getFileInputSettings()->getSeekTimestamp());
+        m_inputMessageQueue.push(msgSeek);
+    }
+    if (deviceSettingsKeys.contains("seekEventPeakPower"))
+    {
+        MsgConfigureFileSourceSeekEvent *msgSeek = MsgConfigureFileSourceSeekEvent::create(response.getFileInputSettings()->getSeekEventPeakPower());
+        m_inputMessageQueue.push(msgSeek);
+    }
+
     webapiFormatDeviceSettings(response, settings);
     return 200;
 }
@@ -491,6 +602,9 @@ void FileInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("accelerationFactor")) {
         settings.m_accelerationFactor = response.getFileInputSettings()->getAccelerationFactor();
     }
+    if (deviceSettingsKeys.contains("asFastAsPossible")) {
+        settings.m_asFastAsPossible = response.getFileInputSettings()->getAsFastAsPossible() != 0;
+    }
     if (deviceSettingsKeys.contains("loop")) {
         settings.m_loop = response.getFileInputSettings()->getLoop() != 0;
     }
@@ -551,6 +665,7 @@ void FileInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& respo
 {
     response.getFileInputSettings()->setFileName(new QString(settings.m_fileName));
     response.getFileInputSettings()->setAccelerationFactor(settings.m_accelerationFactor);
+    response.getFileInputSettings()->setAsFastAsPossible(settings.m_asFastAsPossible ? 1 : 0);
     response.getFileInputSettings()->setLoop(settings.m_loop ? 1 : 0);
 
     response.getFileInputSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
@@ -599,6 +714,12 @@ void FileInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response)
     response.getFileInputReport()->setFileName(new QString(m_fileName));
     response.getFileInputReport()->setSampleRate(m_sampleRate);
     response.getFileInputReport()->setSampleSize(m_sampleSize);
+
+    if (m_fileInputThread && (m_sampleRate > 0)) {
+        response.getFileInputReport()->setSpeedUpFactor(m_fileInputThread->getAchievedSampleRate() / m_sampleRate);
+    } else {
+        response.getFileInputReport()->setSpeedUpFactor(0.0f);
+    }
 }
 
 void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const FileInputSettings& settings, bool force)
@@ -615,6 +736,9 @@ void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, co
     if (deviceSettingsKeys.contains("accelerationFactor") || force) {
         swgFileInputSettings->setAccelerationFactor(settings.m_accelerationFactor);
     }
+    if (deviceSettingsKeys.contains("asFastAsPossible") || force) {
+        swgFileInputSettings->setAsFastAsPossible(settings.m_asFastAsPossible ? 1 : 0);
+    }
     if (deviceSettingsKeys.contains("loop") || force) {
         swgFileInputSettings->setLoop(settings.m_loop);
     }
@@ -19,8 +19,6 @@
 #define INCLUDE_FILEINPUT_H
 
 #include <ctime>
-#include <iostream>
-#include <fstream>
 
 #include <QString>
 #include <QByteArray>
@@ -28,6 +26,7 @@
 #include <QNetworkRequest>
 
 #include "dsp/devicesamplesource.h"
+#include "dsp/filerecordreader.h"
 #include "fileinputsettings.h"
 
 class QNetworkAccessManager;
@@ -138,6 +137,46 @@ public:
 		{ }
 	};
 
+	class MsgConfigureFileSourceSeekTimestamp : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		quint64 getTimestamp() const { return m_timestamp; }
+
+		static MsgConfigureFileSourceSeekTimestamp* create(quint64 timestamp)
+		{
+			return new MsgConfigureFileSourceSeekTimestamp(timestamp);
+		}
+
+	protected:
+		quint64 m_timestamp; //!< absolute time of seek position in ms since epoch
+
+		MsgConfigureFileSourceSeekTimestamp(quint64 timestamp) :
+			Message(),
+			m_timestamp(timestamp)
+		{ }
+	};
+
+	class MsgConfigureFileSourceSeekEvent : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		float getPeakPowerDb() const { return m_peakPowerDb; }
+
+		static MsgConfigureFileSourceSeekEvent* create(float peakPowerDb)
+		{
+			return new MsgConfigureFileSourceSeekEvent(peakPowerDb);
+		}
+
+	protected:
+		float m_peakPowerDb; //!< peak power threshold of the next event in dB relative to full scale
+
+		MsgConfigureFileSourceSeekEvent(float peakPowerDb) :
+			Message(),
+			m_peakPowerDb(peakPowerDb)
+		{ }
+	};
+
 	class MsgReportFileSourceAcquisition : public Message {
 		MESSAGE_CLASS_DECLARATION
 
@@ -332,7 +371,7 @@ public:
 	DeviceAPI *m_deviceAPI;
 	QMutex m_mutex;
 	FileInputSettings m_settings;
-	std::ifstream m_ifstream;
+	FileRecordReader m_reader;
 	FileInputThread* m_fileInputThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -347,6 +386,9 @@ public:
 
 	void openFileStream();
 	void seekFileStream(int seekMillis);
+	void seekFileStreamTimestamp(quint64 timestamp); //!< Uses the record index if any
+	void seekFileStreamEvent(float peakPowerDb);     //!< Next indexed block with a peak at or above the threshold
+	int getPlaybackRate(const FileInputSettings& settings) const; //!< Sample rate the file is read at
 	bool applySettings(const FileInputSettings& settings, bool force = false);
     void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
     void webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const FileInputSettings& settings, bool force);
@@ -26,6 +26,7 @@ struct FileInputSettings {
     qint32  m_sampleRate;
     QString m_fileName;
     quint32 m_accelerationFactor;
+    bool m_asFastAsPossible; //!< read driven by the processing chain backlog. Acceleration factor is ignored.
     bool m_loop;
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
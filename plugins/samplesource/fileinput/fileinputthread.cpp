@@ -20,22 +20,22 @@
 #include <assert.h>
 #include <QDebug>
 
-#include "dsp/filerecord.h"
+#include "dsp/filerecordreader.h"
 #include "fileinputthread.h"
 #include "dsp/samplesinkfifo.h"
+#include "dsp/dspdevicesourceengine.h"
 #include "util/messagequeue.h"
 
 MESSAGE_CLASS_DEFINITION(FileInputThread::MsgReportEOF, Message)
 
-FileInputThread::FileInputThread(std::ifstream *samplesStream,
+FileInputThread::FileInputThread(FileRecordReader *reader,
         SampleSinkFifo* sampleFifo,
         const QTimer& timer,
         MessageQueue *fileInputMessageQueue,
         QObject* parent) :
 	QThread(parent),
 	m_running(false),
-	m_ifstream(samplesStream),
-	m_fileBuf(0),
+	m_reader(reader),
 	m_convertBuf(0),
 	m_bufsize(0),
 	m_chunksize(0),
@@ -43,13 +43,16 @@ FileInputThread::FileInputThread(std::ifstream *samplesStream,
 	m_samplesCount(0),
 	m_timer(timer),
 	m_fileInputMessageQueue(fileInputMessageQueue),
+	m_deviceSourceEngine(nullptr),
+	m_asFastAsPossible(false),
+	m_samplesRead(0),
     m_samplerate(0),
 	m_samplesize(0),
 	m_samplebytes(0),
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false)
 {
-    assert(m_ifstream != 0);
+    assert(m_reader != 0);
 }
 
 FileInputThread::~FileInputThread()
@@ -58,10 +61,6 @@ FileInputThread::~FileInputThread()
 		stopWork();
 	}
 
-	if (m_fileBuf != 0) {
-		free(m_fileBuf);
-	}
-
 	if (m_convertBuf != 0) {
 		free(m_convertBuf);
 	}
@@ -71,16 +70,21 @@ void FileInputThread::startWork()
 {
 	qDebug() << "FileInputThread::startWork: ";
 
-    if (m_ifstream->is_open())
+    if (m_reader->isOpen())
     {
         qDebug() << "FileInputThread::startWork: file stream open, starting...";
         m_startWaitMutex.lock();
         m_elapsedTimer.start();
+        m_workTimer.start();
+        m_samplesRead.storeRelease(0);
         start();
         while(!m_running)
             m_startWaiter.wait(&m_startWaitMutex, 100);
         m_startWaitMutex.unlock();
-        connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+
+        if (!m_asFastAsPossible) { // else the thread loop does the reading
+            connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+        }
     }
     else
     {
@@ -121,6 +125,26 @@ void FileInputThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 	//m_samplerate = samplerate;
 }
 
+void FileInputThread::setAsFastAsPossible(bool asFastAsPossible)
+{
+    qDebug() << "FileInputThread::setAsFastAsPossible: " << asFastAsPossible;
+
+    if (asFastAsPossible != m_asFastAsPossible)
+    {
+        if (m_running) {
+            stopWork();
+        }
+
+        m_asFastAsPossible = asFastAsPossible;
+    }
+}
+
+float FileInputThread::getAchievedSampleRate() const
+{
+    qint64 elapsedms = m_workTimer.isValid() ? m_workTimer.elapsed() : 0;
+    return elapsedms == 0 ? 0.0f : (m_samplesRead.loadAcquire() * 1000.0f) / elapsedms;
+}
+
 void FileInputThread::setBuffers(std::size_t chunksize)
 {
     if (chunksize > m_bufsize)
@@ -128,19 +152,6 @@ void FileInputThread::setBuffers(std::size_t chunksize)
         m_bufsize = chunksize;
         int nbSamples = m_bufsize/(2 * m_samplebytes);
 
-        if (m_fileBuf == 0)
-        {
-            qDebug() << "FileInputThread::setBuffers: Allocate file buffer";
-            m_fileBuf = (quint8*) malloc(m_bufsize);
-        }
-        else
-        {
-            qDebug() << "FileInputThread::setBuffers: Re-allocate file buffer";
-            quint8 *buf = m_fileBuf;
-            m_fileBuf = (quint8*) realloc((void*) m_fileBuf, m_bufsize);
-            if (!m_fileBuf) free(buf);
-        }
-
         if (m_convertBuf == 0)
         {
             qDebug() << "FileInputThread::setBuffers: Allocate conversion buffer";
@@ -164,9 +175,20 @@ void FileInputThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running)
 	{
-		sleep(1);
+        if (m_asFastAsPossible)
+        {
+            if (isBacklogged()) {
+                usleep(FILESOURCE_BACKOFF_US); // let the processing chain catch up
+            } else if (!readChunk()) {
+                break; // end of file is reported
+            }
+        }
+        else
+        {
+            sleep(1); // actual work is in the tick() function
+        }
 	}
 
 	m_running = false;
@@ -186,21 +208,86 @@ void FileInputThread::tick()
             setBuffers(m_chunksize);
         }
 
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+        readChunk();
+	}
+}
+
+bool FileInputThread::readChunk()
+{
+	// samples are taken in place from the file mapping directly feeding the SampleFifo (no callback)
+    quint64 nbSamples = m_chunksize / (2 * m_samplebytes);
+    quint64 nbSamplesRead = 0;
 
-        if (m_ifstream->eof())
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-        	MsgReportEOF *message = MsgReportEOF::create();
-        	m_fileInputMessageQueue->push(message);
+    if (m_asFastAsPossible) // the chunk must not overflow the FIFOs that the backlog check let through
+    {
+        quint64 freeSpace = getFreeSpace();
+
+        if (freeSpace == 0) {
+            return true;
+        } else if (freeSpace < nbSamples) {
+            nbSamples = freeSpace;
         }
-        else
+    }
+
+    while (nbSamplesRead < nbSamples)
+    {
+        quint64 nbRead;
+        const quint8 *buf = m_reader->readSamples(nbSamples - nbSamplesRead, nbRead);
+
+        if (nbRead == 0) {
+            break;
+        }
+
+        writeToSampleFifo(buf, (qint32) (nbRead * 2 * m_samplebytes));
+        nbSamplesRead += nbRead;
+    }
+
+    m_samplesCount += nbSamplesRead;
+    m_samplesRead.fetchAndAddOrdered(nbSamplesRead);
+
+    if (nbSamplesRead < nbSamples)
+    {
+    	MsgReportEOF *message = MsgReportEOF::create();
+    	m_fileInputMessageQueue->push(message);
+        return false;
+    }
+
+    return true;
+}
+
+bool FileInputThread::isBacklogged()
+{
+    quint64 chunkSamples = m_chunksize / (2 * m_samplebytes);
+
+    if (getFreeSpace() == 0) {
+        return true;
+    }
+
+    if ((m_sampleFifo->fill() + chunkSamples) * 1000ULL > (quint64) m_sampleFifo->size() * FILESOURCE_BACKLOG_MAX) {
+        return true;
+    }
+
+    return m_deviceSourceEngine && (m_deviceSourceEngine->getChannelBacklog() > FILESOURCE_BACKLOG_MAX);
+}
+
+quint64 FileInputThread::getFreeSpace()
+{
+    quint64 fill = m_sampleFifo->fill();
+    quint64 freeSpace = fill < m_sampleFifo->size() ? m_sampleFifo->size() - fill : 0;
+
+    if (m_deviceSourceEngine)
+    {
+        // samples still in the sample FIFO will go to the channels before this chunk
+        int channelFreeSpace = m_deviceSourceEngine->getChannelFreeSpace();
+
+        if (channelFreeSpace >= 0)
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+            quint64 channelRoom = (quint64) channelFreeSpace > fill ? channelFreeSpace - fill : 0;
+            freeSpace = channelRoom < freeSpace ? channelRoom : freeSpace;
         }
-	}
+    }
+
+    return freeSpace;
 }
 
 void FileInputThread::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
@@ -23,17 +23,20 @@
 #include <QWaitCondition>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <iostream>
-#include <fstream>
+#include <QAtomicInteger>
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_BACKLOG_MAX 500  //!< FIFO fill in per mille above which reading is held in as fast as possible mode
+#define FILESOURCE_BACKOFF_US 1000  //!< Wait time when held in as fast as possible mode
 
 class SampleSinkFifo;
 class MessageQueue;
+class DSPDeviceSourceEngine;
+class FileRecordReader;
 
 class FileInputThread : public QThread {
 	Q_OBJECT
@@ -53,7 +56,7 @@ public:
         { }
     };
 
-	FileInputThread(std::ifstream *samplesStream,
+	FileInputThread(FileRecordReader *reader,
 	        SampleSinkFifo* sampleFifo,
 	        const QTimer& timer,
 	        MessageQueue *fileInputMessageQueue,
@@ -64,17 +67,19 @@ public:
 	void stopWork();
 	void setSampleRateAndSize(int samplerate, quint32 samplesize);
     void setBuffers(std::size_t chunksize);
+    void setAsFastAsPossible(bool asFastAsPossible); //!< Read driven by the processing chain backlog instead of the timer
+    void setDeviceSourceEngine(const DSPDeviceSourceEngine *deviceSourceEngine) { m_deviceSourceEngine = deviceSourceEngine; }
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
     void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    float getAchievedSampleRate() const; //!< Samples read per second of wall clock time since last start
 
 private:
 	QMutex m_startWaitMutex;
 	QWaitCondition m_startWaiter;
 	volatile bool m_running;
 
-	std::ifstream* m_ifstream;
-	quint8  *m_fileBuf;
+	FileRecordReader *m_reader;
 	quint8  *m_convertBuf;
 	std::size_t m_bufsize;
     qint64 m_chunksize;
@@ -82,6 +87,10 @@ private:
     quint64 m_samplesCount;
     const QTimer& m_timer;
     MessageQueue *m_fileInputMessageQueue;
+    const DSPDeviceSourceEngine *m_deviceSourceEngine;
+    bool m_asFastAsPossible;
+    QAtomicInteger<quint64> m_samplesRead; //!< since last start. Read by getAchievedSampleRate from other threads.
+    QElapsedTimer m_workTimer;
 
 	int m_samplerate;      //!< File I/Q stream original sample rate
     quint64 m_samplesize;  //!< File effective sample size in bits (I or Q). Ex: 16, 24.
@@ -91,6 +100,9 @@ private:
     bool m_throttleToggle;
 
 	void run();
+	bool readChunk(); //!< Read one chunk into the sample FIFO. Returns false at end of file.
+	bool isBacklogged(); //!< Processing chain cannot take another chunk yet
+	quint64 getFreeSpace(); //!< Samples the sample FIFO and the channel FIFOs can take without overflow
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
 
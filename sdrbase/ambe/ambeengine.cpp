@@ -43,8 +43,14 @@
 #include "ambeworker.h"
 #include "ambeengine.h"
 
+const qint64 AMBEEngine::m_streamTimeout;
+const int AMBEEngine::m_maxQueueDepth;
+const float AMBEEngine::m_maxUtilization = 0.9f;
+
 AMBEEngine::AMBEEngine()
-{}
+{
+    m_clock.start();
+}
 
 AMBEEngine::~AMBEEngine()
 {
@@ -226,18 +232,22 @@ bool AMBEEngine::registerController(const std::string& deviceRef)
 
     if (worker->open(deviceRef))
     {
-        m_controllers.push_back(AMBEController());
-        m_controllers.back().worker = worker;
-        m_controllers.back().thread = new QThread();
-        m_controllers.back().device = deviceRef;
-
-        m_controllers.back().worker->moveToThread(m_controllers.back().thread);
-        connect(m_controllers.back().worker, SIGNAL(finished()), m_controllers.back().thread, SLOT(quit()));
-        connect(m_controllers.back().worker, SIGNAL(finished()), m_controllers.back().worker, SLOT(deleteLater()));
-        connect(m_controllers.back().thread, SIGNAL(finished()), m_controllers.back().thread, SLOT(deleteLater()));
-        connect(&m_controllers.back().worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), m_controllers.back().worker, SLOT(handleInputMessages()));
+        AMBEController controller;
+        controller.worker = worker;
+        controller.thread = new QThread();
+        controller.device = deviceRef;
+
+        controller.worker->moveToThread(controller.thread);
+        connect(controller.worker, SIGNAL(finished()), controller.thread, SLOT(quit()));
+        connect(controller.worker, SIGNAL(finished()), controller.worker, SLOT(deleteLater()));
+        connect(controller.thread, SIGNAL(finished()), controller.thread, SLOT(deleteLater()));
+        connect(&controller.worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), controller.worker, SLOT(handleInputMessages()));
         std::this_thread::sleep_for(std::chrono::seconds(1));
-        m_controllers.back().thread->start();
+        controller.thread->start();
+
+        // the controller list is read by the DSD channels threads
+        QMutexLocker locker(&m_mutex);
+        m_controllers.push_back(controller);
 
         return true;
     }
@@ -247,12 +257,14 @@ bool AMBEEngine::registerController(const std::string& deviceRef)
 
 void AMBEEngine::releaseController(const std::string& deviceRef)
 {
+    QMutexLocker locker(&m_mutex);
     std::vector<AMBEController>::iterator it = m_controllers.begin();
 
     while (it != m_controllers.end())
     {
         if (it->device == deviceRef)
         {
+            releaseStreams(it->worker);
             disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
             it->worker->stop();
             it->thread->wait(100);
@@ -269,6 +281,7 @@ void AMBEEngine::releaseController(const std::string& deviceRef)
 
 void AMBEEngine::releaseAll()
 {
+    QMutexLocker locker(&m_mutex);
     std::vector<AMBEController>::iterator it = m_controllers.begin();
 
     while (it != m_controllers.end())
@@ -283,10 +296,27 @@ void AMBEEngine::releaseAll()
     }
 
     m_controllers.clear();
+    m_streams.clear();
+}
+
+void AMBEEngine::getDeviceStats(std::vector<DeviceStats>& deviceStats)
+{
+    QMutexLocker locker(&m_mutex);
+    std::vector<AMBEController>::const_iterator it = m_controllers.begin();
+
+    for (; it != m_controllers.end(); ++it)
+    {
+        deviceStats.push_back(DeviceStats());
+        DeviceStats& stats = deviceStats.back();
+        stats.m_deviceRef = QString(it->device.c_str());
+        stats.m_queueDepth = it->worker->getQueueDepth();
+        it->worker->getStats(stats.m_nbFrames, stats.m_utilization);
+    }
 }
 
 void AMBEEngine::getDeviceRefs(std::vector<QString>& deviceNames)
 {
+    QMutexLocker locker(&m_mutex);
     std::vector<AMBEController>::const_iterator it = m_controllers.begin();
 
     while (it != m_controllers.end())
@@ -296,7 +326,7 @@ void AMBEEngine::getDeviceRefs(std::vector<QString>& deviceNames)
     }
 }
 
-void AMBEEngine::pushMbeFrame(
+bool AMBEEngine::pushMbeFrame(
         const unsigned char *mbeFrame,
         int mbeRateIndex,
         int mbeVolumeIndex,
@@ -305,38 +335,96 @@ void AMBEEngine::pushMbeFrame(
         int upsampling,
         AudioFifo *audioFifo)
 {
-    std::vector<AMBEController>::iterator it = m_controllers.begin();
-    std::vector<AMBEController>::iterator itAvail = m_controllers.end();
-    bool done = false;
     QMutexLocker locker(&m_mutex);
+    qint64 now = m_clock.elapsed();
+    std::map<AudioFifo*, StreamAssignment>::iterator it = m_streams.find(audioFifo);
 
-    while (it != m_controllers.end())
+    // a stream stays on its device (or in software) while it talks so that its FIFO has a single writer
+    if ((it == m_streams.end()) || (now - it->second.lastFrame > m_streamTimeout))
+    {
+        StreamAssignment assignment;
+        assignment.worker = selectWorker(now);
+        assignment.lastFrame = now;
+        m_streams[audioFifo] = assignment;
+
+        if (assignment.worker) {
+            qDebug("AMBEEngine::pushMbeFrame: stream %p on device %p", audioFifo, assignment.worker);
+        } else {
+            qDebug("AMBEEngine::pushMbeFrame: no DV device available. Stream %p synthesized in software", audioFifo);
+        }
+
+        it = m_streams.find(audioFifo);
+    }
+
+    it->second.lastFrame = now;
+
+    if (it->second.worker)
+    {
+        it->second.worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
+        return true;
+    }
+
+    return false;
+}
+
+AMBEWorker *AMBEEngine::selectWorker(qint64 now)
+{
+    std::map<AMBEWorker*, int> activeStreams;
+    std::map<AudioFifo*, StreamAssignment>::iterator sIt = m_streams.begin();
+
+    while (sIt != m_streams.end())
     {
-        if (it->worker->hasFifo(audioFifo))
+        if (now - sIt->second.lastFrame > m_streamTimeout)
         {
-            it->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
-            done = true;
+            m_streams.erase(sIt++);
         }
-        else if (it->worker->isAvailable())
+        else
         {
-            itAvail = it;
+            activeStreams[sIt->second.worker]++;
+            ++sIt;
         }
-
-        ++it;
     }
 
-    if (!done)
+    // least loaded device by number of streams then by frames waiting
+    AMBEWorker *selected = nullptr;
+    int selectedStreams = 0;
+    int selectedDepth = 0;
+    std::vector<AMBEController>::iterator it = m_controllers.begin();
+
+    for (; it != m_controllers.end(); ++it)
     {
-        if (itAvail != m_controllers.end())
-        {
-            int wNum = itAvail - m_controllers.begin();
+        int depth = it->worker->getQueueDepth();
+        quint64 nbFrames;
+        float utilization;
+        it->worker->getStats(nbFrames, utilization);
 
-            qDebug("AMBEEngine::pushMbeFrame: push %p on empty queue %d", audioFifo, wNum);
-            itAvail->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
+        if ((depth >= m_maxQueueDepth) || (utilization >= m_maxUtilization)) {
+            continue; // saturated
         }
-        else
+
+        int streams = activeStreams[it->worker];
+
+        if (!selected || (streams < selectedStreams) || ((streams == selectedStreams) && (depth < selectedDepth)))
         {
-            qDebug("AMBEEngine::pushMbeFrame: no DV device available. MBE frame dropped");
+            selected = it->worker;
+            selectedStreams = streams;
+            selectedDepth = depth;
+        }
+    }
+
+    return selected;
+}
+
+void AMBEEngine::releaseStreams(AMBEWorker *worker)
+{
+    std::map<AudioFifo*, StreamAssignment>::iterator it = m_streams.begin();
+
+    while (it != m_streams.end())
+    {
+        if (it->second.worker == worker) {
+            m_streams.erase(it++);
+        } else {
+            ++it;
         }
     }
 }
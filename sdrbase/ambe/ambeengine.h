@@ -21,11 +21,13 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include <QObject>
 #include <QMutex>
 #include <QString>
 #include <QByteArray>
+#include <QElapsedTimer>
 
 #include "export.h"
 
@@ -37,6 +39,14 @@ class SDRBASE_API AMBEEngine : public QObject
 {
     Q_OBJECT
 public:
+    struct DeviceStats
+    {
+        QString m_deviceRef;
+        int m_queueDepth;     //!< frames waiting for the device
+        quint64 m_nbFrames;   //!< frames decoded since the device was opened
+        float m_utilization;  //!< device busy time ratio over the last second
+    };
+
     AMBEEngine();
     ~AMBEEngine();
 
@@ -45,10 +55,12 @@ public:
 
     int getNbDevices() const { return m_controllers.size(); }   //!< number of devices used
     void getDeviceRefs(std::vector<QString>& devicesRefs);  //!< reference of the devices used (device path or url)
-    bool registerController(const std::string& deviceRef);      //!< create a new controller for the device in reference
+    void getDeviceStats(std::vector<DeviceStats>& deviceStats);
+    bool registerController(const std::string& deviceRef);      //!< create a new controller for the device in reference. "loopback[:ms]" for a stand in device.
     void releaseController(const std::string& deviceRef);       //!< release controller resources for the device in reference
 
-    void pushMbeFrame(
+    /** Returns false if the frame was not taken by a device and should be synthesized in software */
+    bool pushMbeFrame(
             const unsigned char *mbeFrame,
             int mbeRateIndex,
             int mbeVolumeIndex,
@@ -73,16 +85,31 @@ private:
         std::string device;
     };
 
+    /** Device assigned to the audio FIFO of a voice stream until it is idle */
+    struct StreamAssignment
+    {
+        AMBEWorker *worker;   //!< nullptr when the stream is synthesized in software
+        qint64 lastFrame;     //!< milliseconds on the engine clock
+    };
+
+    static const qint64 m_streamTimeout = 1000;   //!< a stream idle for longer can move to another device
+    static const int m_maxQueueDepth = 10;        //!< 200 ms of voice frames
+    static const float m_maxUtilization;
+
 #ifndef __WINDOWS__
     static std::string get_driver(const std::string& tty);
     static void register_comport(std::vector<std::string>& comList, std::vector<std::string>& comList8250, const std::string& dir);
     static void probe_serial8250_comports(std::vector<std::string>& comList, std::vector<std::string> comList8250);
 #endif
     void getComList();
+    AMBEWorker *selectWorker(qint64 now);
+    void releaseStreams(AMBEWorker *worker);
 
     std::vector<AMBEController> m_controllers;
     std::vector<std::string> m_comList;
     std::vector<std::string> m_comList8250;
+    std::map<AudioFifo*, StreamAssignment> m_streams;
+    QElapsedTimer m_clock;
     QMutex m_mutex;
 };
 
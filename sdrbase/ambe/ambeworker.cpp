@@ -19,6 +19,10 @@
 #include <algorithm>
 #include <chrono>
 #include <thread>
+#include <cmath>
+#include <cstdlib>
+
+#include <QMutexLocker>
 
 #include "audio/audiofifo.h"
 #include "ambeworker.h"
@@ -27,17 +31,24 @@ MESSAGE_CLASS_DEFINITION(AMBEWorker::MsgMbeDecode, Message)
 MESSAGE_CLASS_DEFINITION(AMBEWorker::MsgTest, Message)
 
 AMBEWorker::AMBEWorker() :
+    m_loopback(false),
+    m_loopbackTime(4),
+    m_loopbackPhase(0.0f),
     m_running(false),
     m_currentGainIn(0),
     m_currentGainOut(0),
     m_upsamplerLastValue(0.0f),
     m_phase(0),
     m_upsampling(1),
-    m_volume(1.0f)
+    m_volume(1.0f),
+    m_loadWindowStart(0),
+    m_busyTime(0),
+    m_utilization(0.0f),
+    m_nbFrames(0)
 {
     m_audioBuffer.resize(48000);
     m_audioBufferFill = 0;
-    m_audioFifo = 0;
+    m_loadClock.start();
     std::fill(m_dvAudioSamples, m_dvAudioSamples+SerialDV::MBE_AUDIO_BLOCK_SIZE, 0);
     setVolumeFactors();
 }
@@ -47,12 +58,26 @@ AMBEWorker::~AMBEWorker()
 
 bool AMBEWorker::open(const std::string& deviceRef)
 {
+    if (deviceRef.compare(0, 8, "loopback") == 0)
+    {
+        m_loopback = true;
+
+        if ((deviceRef.size() > 9) && (deviceRef[8] == ':')) {
+            m_loopbackTime = std::max(0, atoi(deviceRef.c_str() + 9));
+        }
+
+        qDebug("AMBEWorker::open: loopback device with %d ms transactions", m_loopbackTime);
+        return true;
+    }
+
     return m_dvController.open(deviceRef);
 }
 
 void AMBEWorker::close()
 {
-    m_dvController.close();
+    if (!m_loopback) {
+        m_dvController.close();
+    }
 }
 
 void AMBEWorker::process()
@@ -80,6 +105,7 @@ void AMBEWorker::handleInputMessages()
     m_audioBufferFill = 0;
     AudioFifo *audioFifo = 0;
 
+    // all the frames waiting in the queue are decoded in a row and their audio is written in blocks
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
         if (MsgMbeDecode::match(*message))
@@ -99,8 +125,13 @@ void AMBEWorker::handleInputMessages()
 
             m_upsampleFilter.useHP(decodeMsg->getUseHP());
 
-            if (m_dvController.decode(m_dvAudioSamples, decodeMsg->getMbeFrame(), decodeMsg->getMbeRate()))
+            if (decode(decodeMsg))
             {
+                // the audio of the previous stream goes to its own FIFO
+                if (audioFifo && (decodeMsg->getAudioFifo() != audioFifo)) {
+                    writeAudio(audioFifo);
+                }
+
                 if (upsampling > 1) {
                     upsample(upsampling, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
                 } else {
@@ -109,15 +140,8 @@ void AMBEWorker::handleInputMessages()
 
                 audioFifo = decodeMsg->getAudioFifo();
 
-                if (audioFifo && (m_audioBufferFill >= m_audioBuffer.size() - 960))
-                {
-                    uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
-
-                    if (res != m_audioBufferFill) {
-                        qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
-                    }
-
-                    m_audioBufferFill = 0;
+                if (audioFifo && (m_audioBufferFill >= m_audioBuffer.size() - 960)) {
+                    writeAudio(audioFifo);
                 }
             }
             else
@@ -136,18 +160,78 @@ void AMBEWorker::handleInputMessages()
         }
     }
 
-    if (audioFifo)
+    if (audioFifo) {
+        writeAudio(audioFifo);
+    }
+}
+
+bool AMBEWorker::decode(const MsgMbeDecode *decodeMsg)
+{
+    qint64 start = m_loadClock.nsecsElapsed();
+    bool done;
+
+    if (m_loopback)
     {
-        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+        // a 1 kHz tone at 8 kS/s stands for the voice
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_loopbackTime));
 
-        if (res != m_audioBufferFill) {
-            qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
+        for (int i = 0; i < SerialDV::MBE_AUDIO_BLOCK_SIZE; i++)
+        {
+            m_dvAudioSamples[i] = (short) (8192.0f * sin(m_loopbackPhase));
+            m_loopbackPhase += (float) (2.0 * M_PI / 8.0);
         }
 
-        m_audioBufferFill = 0;
+        m_loopbackPhase = fmod(m_loopbackPhase, (float) (2.0 * M_PI));
+        done = true;
+    }
+    else
+    {
+        done = m_dvController.decode(m_dvAudioSamples, decodeMsg->getMbeFrame(), decodeMsg->getMbeRate());
+    }
+
+    updateLoad(m_loadClock.nsecsElapsed() - start);
+    return done;
+}
+
+void AMBEWorker::writeAudio(AudioFifo *audioFifo)
+{
+    uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+
+    if (res != m_audioBufferFill) {
+        qDebug("AMBEWorker::writeAudio: %u/%u audio samples written", res, m_audioBufferFill);
+    }
+
+    m_audioBufferFill = 0;
+}
+
+void AMBEWorker::updateLoad(qint64 busyTime)
+{
+    QMutexLocker mutexLocker(&m_statsMutex);
+    qint64 now = m_loadClock.nsecsElapsed();
+    qint64 window = now - m_loadWindowStart;
+    m_busyTime += busyTime;
+    m_nbFrames++;
+
+    if (window >= 1000000000LL)
+    {
+        m_utilization = std::min(1.0f, m_busyTime / (float) window);
+        m_busyTime = 0;
+        m_loadWindowStart = now;
     }
+}
 
-    m_timestamp = QDateTime::currentDateTime();
+void AMBEWorker::getStats(quint64& nbFrames, float& utilization)
+{
+    QMutexLocker mutexLocker(&m_statsMutex);
+    qint64 window = m_loadClock.nsecsElapsed() - m_loadWindowStart;
+    nbFrames = m_nbFrames;
+
+    // an idle device does not close its window
+    if (window >= 2000000000LL) {
+        utilization = std::min(1.0f, m_busyTime / (float) window);
+    } else {
+        utilization = m_utilization;
+    }
 }
 
 void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
@@ -158,24 +242,9 @@ void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
         int upsampling,
         AudioFifo *audioFifo)
 {
-    m_audioFifo = audioFifo;
     m_inputMessageQueue.push(MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo));
 }
 
-bool AMBEWorker::isAvailable()
-{
-	if (m_audioFifo == 0) {
-		return true;
-	}
-
-	return m_timestamp.time().msecsTo(QDateTime::currentDateTime().time()) > 1000; // 1 second inactivity timeout
-}
-
-bool AMBEWorker::hasFifo(AudioFifo *audioFifo)
-{
-    return m_audioFifo == audioFifo;
-}
-
 void AMBEWorker::upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels)
 {
     for (int i = 0; i < nbSamplesIn; i++)
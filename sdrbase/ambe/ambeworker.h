@@ -21,7 +21,8 @@
 
 #include <QObject>
 #include <QDebug>
-#include <QDateTime>
+#include <QMutex>
+#include <QElapsedTimer>
 
 #include "export.h"
 #include "dvcontroller.h"
@@ -109,12 +110,12 @@ public:
             int upsampling,
             AudioFifo *audioFifo);
 
-    bool open(const std::string& deviceRef); //!< Either serial device or ip:port
+    bool open(const std::string& deviceRef); //!< Either serial device, ip:port or loopback[:ms]
     void close();
     void process();
     void stop();
-    bool isAvailable();
-    bool hasFifo(AudioFifo *audioFifo);
+    int getQueueDepth() { return m_inputMessageQueue.size(); } //!< frames waiting for the device
+    void getStats(quint64& nbFrames, float& utilization); //!< utilization is the device busy time ratio over the last second
 
     void postTest()
     {
@@ -131,13 +132,17 @@ public slots:
     void handleInputMessages();
 
 private:
+    bool decode(const MsgMbeDecode *decodeMsg);
+    void writeAudio(AudioFifo *audioFifo);
+    void updateLoad(qint64 busyTime);
     void upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels);
     void noUpsample(short *in, int nbSamplesIn, unsigned char channels);
     void setVolumeFactors();
 
     SerialDV::DVController m_dvController;
-    AudioFifo *m_audioFifo;
-    QDateTime m_timestamp;
+    bool m_loopback;              //!< stand in for a device: a tone is output after the transaction time
+    int m_loopbackTime;           //!< simulated transaction time in milliseconds
+    float m_loopbackPhase;
     volatile bool m_running;
     int m_currentGainIn;
     int m_currentGainOut;
@@ -151,6 +156,12 @@ private:
     float m_volume;
     float m_upsamplingFactors[7];
     AudioCompressor m_compressor;
+    QMutex m_statsMutex;
+    QElapsedTimer m_loadClock;
+    qint64 m_loadWindowStart;     //!< nanoseconds on the load clock
+    qint64 m_busyTime;            //!< in the current window in nanoseconds
+    float m_utilization;          //!< of the last complete window
+    quint64 m_nbFrames;
 };
 
 #endif // SDRBASE_AMBE_AMBEWORKER_H_
@@ -522,6 +522,17 @@ int AudioDeviceManager::getOutputSampleRate(int outputDeviceIndex)
 }
 
 
+bool AudioDeviceManager::getOutputUdpStreamStats(int outputDeviceIndex, AudioStreamingService::StreamStats& stats) const
+{
+    QMap<int, AudioOutput*>::const_iterator it = m_audioOutputs.find(outputDeviceIndex);
+
+    if (it == m_audioOutputs.end()) {
+        return false;
+    }
+
+    return it.value()->getUdpStreamStats(stats);
+}
+
 void AudioDeviceManager::setInputDeviceInfo(int inputDeviceIndex, const InputDeviceInfo& deviceInfo)
 {
     QString deviceName;
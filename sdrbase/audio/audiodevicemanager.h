@@ -107,6 +107,7 @@ public:
     bool getOutputDeviceInfo(const QString& deviceName, OutputDeviceInfo& deviceInfo) const;
     int getInputSampleRate(int inputDeviceIndex = -1);
     int getOutputSampleRate(int outputDeviceIndex = -1);
+    bool getOutputUdpStreamStats(int outputDeviceIndex, AudioStreamingService::StreamStats& stats) const; //!< false if the device is not running
     void setInputDeviceInfo(int inputDeviceIndex, const InputDeviceInfo& deviceInfo);
     void setOutputDeviceInfo(int outputDeviceIndex, const OutputDeviceInfo& deviceInfo);
     void unsetInputDeviceInfo(int inputDeviceIndex);
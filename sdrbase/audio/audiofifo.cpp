@@ -26,26 +26,26 @@
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
-	m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_writeIndex(0),
+	m_readIndex(0)
 {
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
-    m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_writeIndex(0),
+	m_readIndex(0)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	QWriteLocker resizeLocker(&m_resizeLock);
 
 	if (m_fifo != 0)
 	{
@@ -58,108 +58,101 @@ AudioFifo::~AudioFifo()
 
 bool AudioFifo::setSize(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	QWriteLocker resizeLocker(&m_resizeLock);
 
 	return create(numSamples);
 }
 
 uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
+	if (!m_resizeLock.tryLockForRead()) { // resize in progress
+		return 0;
+	}
 
-	if (m_fifo == 0) {
+	if (m_fifo == 0)
+	{
+		m_resizeLock.unlock();
 		return 0;
 	}
 
-	m_mutex.lock();
+	uint32_t writeIndex = m_writeIndex.load();
+	uint32_t readIndex = m_readIndex.loadAcquire();
+	uint32_t total = MIN(numSamples, m_size - count(writeIndex, readIndex));
+	uint32_t tail = position(writeIndex);
+	uint32_t copyLen = MIN(total, m_size - tail);
 
-	total = MIN(numSamples, m_size - m_fill);
-	remaining = total;
+	memcpy(m_fifo + (tail * m_sampleSize), data, copyLen * m_sampleSize);
 
-	while (remaining != 0)
-	{
-		if (isFull())
-		{
-			m_mutex.unlock();
-			return total - remaining; // written so far
-		}
-
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
-		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
-		m_tail += copyLen;
-		m_tail %= m_size;
-		m_fill += copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
+	if (copyLen < total) { // wrap around
+		memcpy(m_fifo, data + copyLen * m_sampleSize, (total - copyLen) * m_sampleSize);
 	}
 
-	m_mutex.unlock();
+	m_writeIndex.storeRelease(advance(writeIndex, total)); // publish the samples
+	m_resizeLock.unlock();
+
 	return total;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
+	if (!m_resizeLock.tryLockForRead()) { // resize in progress
+		return 0;
+	}
 
-	if (m_fifo == 0) {
+	if (m_fifo == 0)
+	{
+		m_resizeLock.unlock();
 		return 0;
 	}
 
-	m_mutex.lock();
+	uint32_t readIndex = m_readIndex.loadAcquire();
+	uint32_t writeIndex = m_writeIndex.loadAcquire();
+	uint32_t total = MIN(numSamples, count(writeIndex, readIndex));
+	uint32_t head = position(readIndex);
+	uint32_t copyLen = MIN(total, m_size - head);
 
-	total = MIN(numSamples, m_fill);
-	remaining = total;
+	memcpy(data, m_fifo + (head * m_sampleSize), copyLen * m_sampleSize);
 
-	while (remaining != 0)
-	{
-		if (isEmpty())
-		{
-			m_mutex.unlock();
-			return total - remaining; // read so far
-		}
-
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
-		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
-
-		m_head += copyLen;
-		m_head %= m_size;
-		m_fill -= copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
+	if (copyLen < total) { // wrap around
+		memcpy(data + copyLen * m_sampleSize, m_fifo, (total - copyLen) * m_sampleSize);
 	}
 
-	m_mutex.unlock();
+	// a concurrent clear wins: the samples just read are returned but the read index stays where clear put it
+	m_readIndex.testAndSetOrdered(readIndex, advance(readIndex, total));
+	m_resizeLock.unlock();
+
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (!m_resizeLock.tryLockForRead()) { // resize in progress
+		return 0;
+	}
 
-	if(numSamples > m_fill)
+	if (m_fifo == 0)
 	{
-		numSamples = m_fill;
+		m_resizeLock.unlock();
+		return 0;
 	}
 
-	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	uint32_t readIndex = m_readIndex.loadAcquire();
+	uint32_t writeIndex = m_writeIndex.loadAcquire();
+	numSamples = MIN(numSamples, count(writeIndex, readIndex));
+
+	if (!m_readIndex.testAndSetOrdered(readIndex, advance(readIndex, numSamples))) {
+		numSamples = 0; // cleared meanwhile
+	}
+
+	m_resizeLock.unlock();
 
 	return numSamples;
 }
 
 void AudioFifo::clear()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	// everything written so far is discarded
+	m_readIndex.fetchAndStoreOrdered(m_writeIndex.loadAcquire());
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -170,9 +163,8 @@ bool AudioFifo::create(uint32_t numSamples)
 		m_fifo = 0;
 	}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_writeIndex.storeRelease(0);
+	m_readIndex.storeRelease(0);
 
 	m_fifo = new qint8[numSamples * m_sampleSize];
 	m_size = numSamples;
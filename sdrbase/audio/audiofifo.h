@@ -20,12 +20,20 @@
 #define INCLUDE_AUDIOFIFO_H
 
 #include <QObject>
-#include <QMutex>
-#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QReadWriteLock>
 
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Single producer single consumer ring of audio samples. Neither side takes a lock: the
+ * producer only moves the write index and the consumer only moves the read index so that
+ * the audio callback is never held by a channel. Indexes run over twice the size so that
+ * a full FIFO can be told from an empty one without losing a slot. Resizing is the only
+ * operation that excludes the others. Read and write share the resize lock as readers so
+ * that they never exclude each other and only return nothing while a resize is in progress.
+ */
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -39,27 +47,37 @@ public:
 	uint32_t read(quint8* data, uint32_t numSamples);
 
 	uint32_t drain(uint32_t numSamples);
-	void clear();
+	void clear(); //!< May be called by the producer or the consumer
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return count(m_writeIndex.loadAcquire(), m_readIndex.loadAcquire()); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
 private:
-	QMutex m_mutex;
+	QReadWriteLock m_resizeLock; //!< held for writing by resize only
 
 	qint8* m_fifo;
 
 	const uint32_t m_sampleSize;
 
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
+	QAtomicInt m_writeIndex; //!< moved by the producer only, in [0, 2*m_size)
+	QAtomicInt m_readIndex;  //!< moved by the consumer or by clear, in [0, 2*m_size)
 
 	bool create(uint32_t numSamples);
+
+	inline uint32_t count(uint32_t writeIndex, uint32_t readIndex) const {
+		return writeIndex >= readIndex ? writeIndex - readIndex : 2*m_size + writeIndex - readIndex;
+	}
+	inline uint32_t advance(uint32_t index, uint32_t numSamples) const {
+		index += numSamples;
+		return index >= 2*m_size ? index - 2*m_size : index;
+	}
+	inline uint32_t position(uint32_t index) const {
+		return index >= m_size ? index - m_size : index;
+	}
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
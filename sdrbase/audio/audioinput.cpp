@@ -28,7 +28,9 @@ AudioInput::AudioInput() :
 	m_audioUsageCount(0),
 	m_onExit(false),
 	m_volume(0.5f),
-	m_audioFifos()
+	m_audioFifos(),
+	m_sampleRate(0),
+	m_resampling(false)
 {
 }
 
@@ -100,6 +102,15 @@ bool AudioInput::start(int device, int rate)
             return false;
         }
 
+        m_sampleRate = rate;
+        m_resampling = m_audioFormat.sampleRate() != rate;
+
+        if (m_resampling)
+        {
+            qInfo("AudioInput::start: resampling from %d to %d Hz", m_audioFormat.sampleRate(), rate);
+            m_resampler.setRates(m_audioFormat.sampleRate(), rate, 2);
+        }
+
         m_audioInput = new QAudioInput(devInfo, m_audioFormat);
         m_audioInput->setVolume(m_volume);
 
@@ -181,9 +192,22 @@ qint64 AudioInput::writeData(const char *data, qint64 len)
     	return 0;
     }
 
+    const quint8 *samples = reinterpret_cast<const quint8*>(data);
+    unsigned int nbSamples = len/4;
+
+    if (m_resampling)
+    {
+        if (m_resamplerBuffer.size() < 2*m_resampler.getMaxOutput(nbSamples)) {
+            m_resamplerBuffer.resize(2*m_resampler.getMaxOutput(nbSamples));
+        }
+
+        nbSamples = m_resampler.process(reinterpret_cast<const qint16*>(data), nbSamples, &m_resamplerBuffer[0]);
+        samples = reinterpret_cast<const quint8*>(&m_resamplerBuffer[0]);
+    }
+
 	for (std::list<AudioFifo*>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
 	{
-		(*it)->write(reinterpret_cast<const quint8*>(data), len/4);
+		(*it)->write(samples, nbSamples);
 	}
 
 	return len;
@@ -23,6 +23,7 @@
 #include <QAudioFormat>
 #include <list>
 #include <vector>
+#include "audio/audiopolyphaseresampler.h"
 #include "export.h"
 
 class QAudioInput;
@@ -42,7 +43,7 @@ public:
 	void removeFifo(AudioFifo* audioFifo);
     int getNbFifos() const { return m_audioFifos.size(); }
 
-	uint getRate() const { return m_audioFormat.sampleRate(); }
+	uint getRate() const { return m_sampleRate; } //!< rate of the samples delivered to the FIFOs
 	void setOnExit(bool onExit) { m_onExit = onExit; }
 	void setVolume(float volume) { m_volume = volume; }
 
@@ -57,6 +58,10 @@ private:
 	std::vector<qint32> m_mixBuffer;
 
 	QAudioFormat m_audioFormat;
+	uint m_sampleRate;
+	bool m_resampling; //!< device does not support the requested rate
+	AudioPolyphaseResampler m_resampler;
+	std::vector<qint16> m_resamplerBuffer;
 
 	//virtual bool open(OpenMode mode);
 	virtual qint64 readData(char* data, qint64 maxLen);
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Stereo audio mixing kernels. Channels are accumulated in floating point and   //
+// the mix is converted back to 16 bit with saturation once per block.           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <cmath>
+
+#include "audiomix.h"
+
+void AudioMix::accumulate(float *mix, const AudioSample *samples, unsigned int nbSamples)
+{
+    const qint16 *src = (const qint16 *) samples;
+    unsigned int i = 0;
+
+#ifdef USE_SSE2
+    // 4 stereo samples per iteration
+    for (; i + 4 <= nbSamples; i += 4)
+    {
+        __m128i s16 = _mm_loadu_si128((const __m128i *) &src[2*i]);
+        // sign extension of the 16 bit values to 32 bit
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+        __m128 acc0 = _mm_loadu_ps(&mix[2*i]);
+        __m128 acc1 = _mm_loadu_ps(&mix[2*i + 4]);
+        acc0 = _mm_add_ps(acc0, _mm_cvtepi32_ps(lo));
+        acc1 = _mm_add_ps(acc1, _mm_cvtepi32_ps(hi));
+        _mm_storeu_ps(&mix[2*i], acc0);
+        _mm_storeu_ps(&mix[2*i + 4], acc1);
+    }
+#endif
+
+    for (; i < nbSamples; i++)
+    {
+        mix[2*i] += src[2*i];
+        mix[2*i + 1] += src[2*i + 1];
+    }
+}
+
+void AudioMix::convert(AudioSample *samples, const float *mix, unsigned int nbSamples)
+{
+    qint16 *dst = (qint16 *) samples;
+    unsigned int i = 0;
+
+#ifdef USE_SSE2
+    // saturation happens in the pack
+    for (; i + 4 <= nbSamples; i += 4)
+    {
+        __m128i s0 = _mm_cvtps_epi32(_mm_loadu_ps(&mix[2*i]));
+        __m128i s1 = _mm_cvtps_epi32(_mm_loadu_ps(&mix[2*i + 4]));
+        _mm_storeu_si128((__m128i *) &dst[2*i], _mm_packs_epi32(s0, s1));
+    }
+#endif
+
+    for (i *= 2; i < 2*nbSamples; i++)
+    {
+        float s = std::nearbyint(mix[i]);
+        dst[i] = s < -32768.0f ? -32768 : s > 32767.0f ? 32767 : (qint16) s;
+    }
+}
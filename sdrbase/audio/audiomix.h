@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Stereo audio mixing kernels. Channels are accumulated in floating point and   //
+// the mix is converted back to 16 bit with saturation once per block.           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOMIX_H_
+#define SDRBASE_AUDIO_AUDIOMIX_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SDRBASE_API AudioMix
+{
+public:
+    /** Add nbSamples stereo samples to the interleaved accumulator. Channels apply their own volume. */
+    static void accumulate(float *mix, const AudioSample *samples, unsigned int nbSamples);
+    /** Convert nbSamples stereo samples of the accumulator to 16 bit with saturation */
+    static void convert(AudioSample *samples, const float *mix, unsigned int nbSamples);
+};
+
+#endif /* SDRBASE_AUDIO_AUDIOMIX_H_ */
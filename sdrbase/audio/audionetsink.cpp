@@ -30,43 +30,47 @@ AudioNetSink::AudioNetSink(QObject *parent) :
     m_type(SinkUDP),
     m_codec(CodecL16),
     m_rtpBufferAudio(0),
+    m_resamplerCutoff(0.0f),
+    m_resamplerInIndex(0),
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
-    m_decimationCount(0),
     m_codecInputSize(960),
     m_codecInputIndex(0),
     m_bufferIndex(0),
     m_port(9998)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
+    std::fill(m_codecIn, m_codecIn+m_opusBlockSize, 0);
     m_udpSocket = new QUdpSocket(parent);
+    AudioStreamingService::instance()->addStream(this, "AudioNetSink");
 }
 
 AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
     m_type(SinkUDP),
     m_codec(CodecL16),
     m_rtpBufferAudio(0),
+    m_resamplerCutoff(0.0f),
+    m_resamplerInIndex(0),
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
-    m_decimationCount(0),
     m_codecInputSize(960),
     m_codecInputIndex(0),
     m_bufferIndex(0),
     m_port(9998)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
+    std::fill(m_codecIn, m_codecIn+m_opusBlockSize, 0);
     m_udpSocket = new QUdpSocket(parent);
+    AudioStreamingService::instance()->addStream(this, "AudioNetSink");
     m_rtpBufferAudio = new RTPSink(m_udpSocket, sampleRate, stereo);
 }
 
 AudioNetSink::~AudioNetSink()
 {
+    AudioStreamingService::instance()->removeStream(this);
+
     if (m_rtpBufferAudio) {
         delete m_rtpBufferAudio;
     }
@@ -81,6 +85,8 @@ bool AudioNetSink::isRTPCapable() const
 
 bool AudioNetSink::selectType(SinkType type)
 {
+    AudioStreamingService::instance()->drainStream(this);
+
     if (type == SinkUDP)
     {
         m_type = SinkUDP;
@@ -95,8 +101,10 @@ bool AudioNetSink::selectType(SinkType type)
 
 void AudioNetSink::setDestination(const QString& address, uint16_t port)
 {
+    AudioStreamingService::instance()->drainStream(this);
     m_address.setAddress(const_cast<QString&>(address));
     m_port = port;
+    AudioStreamingService::instance()->setStreamName(this, QString("%1:%2").arg(address).arg(port));
 
     if (m_rtpBufferAudio) {
         m_rtpBufferAudio->setDestination(address, port);
@@ -124,6 +132,7 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
             << " stereo: " << stereo
             << " sampleRate: " << sampleRate;
 
+    AudioStreamingService::instance()->drainStream(this);
     m_codec = codec;
     m_stereo = stereo;
     m_sampleRate = sampleRate;
@@ -163,8 +172,8 @@ void AudioNetSink::setDecimation(uint32_t decimation)
 {
     m_decimation = decimation < 1 ? 1 : decimation > 6 ? 6 : decimation;
     qDebug() << "AudioNetSink::setDecimation: " << m_decimation << " from: " << decimation;
+    AudioStreamingService::instance()->drainStream(this);
     setNewCodecData();
-    m_decimationCount = 0;
 }
 
 void AudioNetSink::setNewCodecData()
@@ -173,79 +182,133 @@ void AudioNetSink::setNewCodecData()
     {
         m_codecInputSize = m_sampleRate / (m_decimation * 50); // 20ms = 1/50s - size is per channel
         m_codecInputSize = m_codecInputSize > 960 ? 960 : m_codecInputSize; // hard limit of 48 kS/s
-        m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
         qDebug() << "AudioNetSink::setNewCodecData: CodecOpus:"
             << " m_codecInputSize: " << m_codecInputSize
-            << " m_codecRatio: " << m_codecRatio
             << " Fs: " << m_sampleRate/m_decimation
             << " stereo: " << m_stereo;
         m_opus.setEncoder(m_sampleRate/m_decimation, m_stereo ? 2 : 1);
         m_codecInputIndex = 0;
         m_bufferIndex = 0;
     }
+    else if (m_codec == CodecG722)
+    {
+        m_codecInputSize = m_g722BlockSize;
+        m_codecInputIndex = 0;
+    }
 
     setDecimationFilters();
+
+    QMutexLocker mutexLocker(&m_encodedMutex);
+    m_encoded.clear();
 }
 
 void AudioNetSink::setDecimationFilters()
 {
-    int decimatedSampleRate = m_sampleRate / m_decimation;
-
     switch (m_codec)
     {
     case CodecPCMA:
     case CodecPCMU:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 3300.0, 300.0);
+        m_resamplerCutoff = 3300.0f;
         break;
     case CodecG722:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 7000.0, 50.0);
+        m_resamplerCutoff = 7000.0f;
         break;
     case CodecOpus:
     case CodecL8:
     case CodecL16:
     default:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 0.45*decimatedSampleRate, 50.0);
+        m_resamplerCutoff = 0.0f; // 90% of the decimated Nyquist frequency
         break;
     }
+
+    m_resampler.setRates(m_sampleRate, m_sampleRate / m_decimation, m_stereo ? 2 : 1, m_resamplerCutoff);
+    m_resamplerInIndex = 0;
 }
 
-void AudioNetSink::write(qint16 isample)
+void AudioNetSink::setResamplerChannels(unsigned int nbChannels)
 {
-    qint16& sample = isample;
+    // the coefficients come from the cache: only the held samples are lost
+    m_resampler.setRates(m_sampleRate, m_sampleRate / m_decimation, nbChannels, m_resamplerCutoff);
+    m_resamplerInIndex = 0;
+}
 
-    if (m_decimation > 1)
+void AudioNetSink::write(qint16 sample)
+{
+    if (m_decimation == 1)
     {
-        float lpSample = m_audioFilter.run(sample / 32768.0f);
+        writeSample(sample);
+        return;
+    }
 
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            sample = lpSample * 32768.0f;
-            m_decimationCount = 0;
+    if (m_resampler.getNbChannels() != 1) {
+        setResamplerChannels(1);
+    }
+
+    m_resamplerIn[m_resamplerInIndex++] = sample;
+
+    if (m_resamplerInIndex == m_resamplerBlockSize)
+    {
+        unsigned int nbSamples = m_resampler.process(m_resamplerIn, m_resamplerBlockSize, m_resamplerOut);
+
+        for (unsigned int i = 0; i < nbSamples; i++) {
+            writeSample(m_resamplerOut[i]);
         }
-        else
-        {
-            m_decimationCount++;
-            return;
+
+        m_resamplerInIndex = 0;
+    }
+}
+
+void AudioNetSink::write(qint16 lSample, qint16 rSample)
+{
+    if (m_decimation == 1)
+    {
+        writeSample(lSample, rSample);
+        return;
+    }
+
+    if (m_resampler.getNbChannels() != 2) {
+        setResamplerChannels(2);
+    }
+
+    m_resamplerIn[2*m_resamplerInIndex] = lSample;
+    m_resamplerIn[2*m_resamplerInIndex+1] = rSample;
+    m_resamplerInIndex++;
+
+    if (m_resamplerInIndex == m_resamplerBlockSize)
+    {
+        unsigned int nbSamples = m_resampler.process(m_resamplerIn, m_resamplerBlockSize, m_resamplerOut);
+
+        for (unsigned int i = 0; i < nbSamples; i++) {
+            writeSample(m_resamplerOut[2*i], m_resamplerOut[2*i+1]);
         }
+
+        m_resamplerInIndex = 0;
     }
+}
 
-    if (m_type == SinkUDP)
+void AudioNetSink::writeSample(qint16 sample)
+{
+    if ((m_codec == CodecG722) || (m_codec == CodecOpus))
     {
-        if (m_codec == CodecG722)
+        // encoded by the streaming service workers
+        m_codecIn[m_codecInputIndex++] = sample;
+
+        if (m_codecInputIndex == m_codecInputSize)
         {
-            if (m_bufferIndex >= 2*m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
+            sendEncoded();
+            AudioStreamingService::instance()->submit(this, m_codecIn, m_codecInputSize);
+            m_codecInputIndex = 0;
         }
-        else
+
+        return;
+    }
+
+    if (m_type == SinkUDP)
+    {
+        if (m_bufferIndex >= m_udpBlockSize)
         {
-            if (m_bufferIndex >= m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
+            AudioStreamingService::instance()->sendDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
+            m_bufferIndex = 0;
         }
 
         switch(m_codec)
@@ -265,30 +328,6 @@ void AudioNetSink::write(qint16 isample)
             m_bufferIndex += sizeof(qint8);
         }
             break;
-        case CodecG722:
-        {
-            qint16 *p = (qint16*) &m_data[m_udpBlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
-
-            if (m_bufferIndex == 2*m_udpBlockSize) {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_udpBlockSize], 2*m_udpBlockSize);
-            }
-        }
-            break;
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
-            }
-
-            m_opusIn[m_codecInputIndex++] = sample;
-        }
-            break;
         case CodecL16:
         default:
         {
@@ -316,43 +355,6 @@ void AudioNetSink::write(qint16 isample)
             m_rtpBufferAudio->write((uint8_t *) &p);
         }
             break;
-        case CodecG722:
-        {
-
-            if (m_bufferIndex >= 2*m_g722BlockSize)
-            {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_g722BlockSize], 2*m_g722BlockSize);
-                m_bufferIndex = 0;
-            }
-
-            if (m_bufferIndex % 2 == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex/2]);
-            }
-
-            qint16 *p = (qint16*) &m_data[m_g722BlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
-        }
-            break;
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
-                }
-                m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
-
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
-            }
-
-            m_opusIn[m_codecInputIndex++] = sample;
-        }
-            break;
         case CodecL16:
         default:
             m_rtpBufferAudio->write((uint8_t *) &sample);
@@ -361,58 +363,39 @@ void AudioNetSink::write(qint16 isample)
     }
 }
 
-void AudioNetSink::write(qint16 ilSample, qint16 irSample)
+void AudioNetSink::writeSample(qint16 lSample, qint16 rSample)
 {
-    qint16& lSample = ilSample;
-    qint16& rSample = irSample;
+    if ((m_codec == CodecPCMA) || (m_codec == CodecPCMU) || (m_codec == CodecG722)) {
+        return; // mono modes - do nothing
+    }
 
-    if (m_decimation > 1)
+    if (m_codec == CodecOpus)
     {
-        float lpLSample = m_audioFilter.runLP(lSample / 32768.0f);
-        float lpRSample = m_audioFilter.runLP(rSample / 32768.0f);
+        // encoded by the streaming service workers
+        m_codecIn[2*m_codecInputIndex]   = lSample;
+        m_codecIn[2*m_codecInputIndex+1] = rSample;
+        m_codecInputIndex++;
 
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            lSample = lpLSample * 32768.0f;
-            rSample = lpRSample * 32768.0f;
-            m_decimationCount = 0;
-        }
-        else
+        if (m_codecInputIndex == m_codecInputSize)
         {
-            m_decimationCount++;
-            return;
+            sendEncoded();
+            AudioStreamingService::instance()->submit(this, m_codecIn, 2*m_codecInputSize);
+            m_codecInputIndex = 0;
         }
+
+        return;
     }
 
     if (m_type == SinkUDP)
     {
         if (m_bufferIndex >= m_udpBlockSize)
         {
-            m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
+            AudioStreamingService::instance()->sendDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
             m_bufferIndex = 0;
         }
 
         switch(m_codec)
         {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
-            }
-
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
-        }
-            break;
         case CodecL8:
         {
             qint8 *p = (qint8*) &m_data[m_bufferIndex];
@@ -440,31 +423,6 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
     {
         switch(m_codec)
         {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
-                }
-                m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
-
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
-            }
-
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
-        }
-            break;
         case CodecL8:
         {
             qint8 pl = lSample / 256;
@@ -480,6 +438,62 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
     }
 }
 
+void AudioNetSink::encodeBlock(const qint16 *samples, unsigned int nbSamples)
+{
+    int nbBytes;
+
+    if (m_codec == CodecG722)
+    {
+        nbBytes = m_g722.encode(m_codecOut, samples, nbSamples);
+    }
+    else if (m_codec == CodecOpus)
+    {
+        nbBytes = m_opus.encode(nbSamples / (m_stereo ? 2 : 1), const_cast<int16_t*>(samples), m_codecOut);
+
+        if ((m_type == SinkRTP) && (nbBytes != AudioOpus::m_bitrate/400)) { // 8 bits for 1/50s (20ms)
+            qWarning("AudioNetSink::encodeBlock: CodecOpus: unexpected output frame size: %d bytes", nbBytes);
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    if (m_type == SinkUDP)
+    {
+        nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
+        AudioStreamingService::instance()->sendDatagram((const char*) m_codecOut, (qint64) nbBytes, m_address, m_port);
+    }
+    else if (m_type == SinkRTP)
+    {
+        // the RTP session is driven by the writing thread only
+        QMutexLocker mutexLocker(&m_encodedMutex);
+
+        if (m_encoded.size() + nbBytes > (unsigned int) m_dataBlockSize) {
+            m_encoded.clear(); // the writing thread stalled: drop the stale blocks
+        }
+
+        m_encoded.insert(m_encoded.end(), m_codecOut, m_codecOut + nbBytes);
+    }
+}
+
+void AudioNetSink::sendEncoded()
+{
+    if (m_type != SinkRTP) {
+        return;
+    }
+
+    m_encodedMutex.lock();
+    m_encodedSend.swap(m_encoded);
+    m_encodedMutex.unlock();
+
+    if (m_encodedSend.size() > 0)
+    {
+        m_rtpBufferAudio->write(m_encodedSend.data(), m_encodedSend.size());
+        m_encodedSend.clear();
+    }
+}
+
 void AudioNetSink::moveToThread(QThread *thread)
 {
     m_udpSocket->moveToThread(thread);
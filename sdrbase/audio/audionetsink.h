@@ -20,21 +20,25 @@
 #define SDRBASE_AUDIO_AUDIONETSINK_H_
 
 #include "dsp/dsptypes.h"
-#include "audiofilter.h"
+#include "audiopolyphaseresampler.h"
 #include "audiocompressor.h"
 #include "audiog722.h"
 #include "audioopus.h"
+#include "audiostreamingservice.h"
 #include "export.h"
 
+#include <vector>
+
 #include <QObject>
 #include <QHostAddress>
+#include <QMutex>
 #include <stdint.h>
 
 class QUdpSocket;
 class RTPSink;
 class QThread;
 
-class SDRBASE_API AudioNetSink {
+class SDRBASE_API AudioNetSink : public AudioStreamingService::Stream {
 public:
     typedef enum
     {
@@ -65,6 +69,8 @@ public:
     void write(qint16 sample);
     void write(qint16 lSample, qint16 rSample);
 
+    virtual void encodeBlock(const qint16 *samples, unsigned int nbSamples); //!< G722 and Opus encoding in the streaming service
+
     bool isRTPCapable() const;
     bool selectType(SinkType type);
 
@@ -72,13 +78,18 @@ public:
 
     static const int m_udpBlockSize;
     static const int m_dataBlockSize = 65536; // room for G722 conversion (64000 = 12800*5 largest to date)
-    static const int m_g722BlockSize = 12800; // number of resulting G722 bytes (80*20ms frames)
+    static const int m_g722BlockSize = 1024;  // G722 input samples encoded at once (64ms at 16 kS/s in 512 bytes)
     static const int m_opusBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
     static const int m_opusOutputSize = 160;  // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
+    static const unsigned int m_resamplerBlockSize = 64; // samples per channel buffered before decimation
 
 protected:
     void setNewCodecData();       // actions to take when changes affecting codec dependent data occurs
     void setDecimationFilters();  // set decimation filters limits depending on effective sample rate and codec
+    void setResamplerChannels(unsigned int nbChannels);
+    void writeSample(qint16 sample);                   // sample at the decimated rate
+    void writeSample(qint16 lSample, qint16 rSample);  // stereo sample at the decimated rate
+    void sendEncoded();                                // RTP packets of the encoded blocks from the writing thread
 
     SinkType m_type;
     Codec m_codec;
@@ -87,16 +98,22 @@ protected:
     AudioCompressor m_audioCompressor;
     AudioG722 m_g722;
     AudioOpus m_opus;
-    AudioFilter m_audioFilter;
+    AudioPolyphaseResampler m_resampler;
+    float m_resamplerCutoff;
+    qint16 m_resamplerIn[2*m_resamplerBlockSize];
+    qint16 m_resamplerOut[2*m_resamplerBlockSize];
+    unsigned int m_resamplerInIndex;
     int m_sampleRate;
     bool m_stereo;
     uint32_t m_decimation;
-    uint32_t m_decimationCount;
     char m_data[m_dataBlockSize];
-    int16_t m_opusIn[m_opusBlockSize];
-    int m_codecInputSize;  // codec input block size - for codecs with actual encoding (Opus only for now)
+    int16_t m_codecIn[m_opusBlockSize];             // codec input block filled by the writing thread
+    uint8_t m_codecOut[AudioOpus::m_maxPacketSize]; // codec output used by the streaming service worker
+    int m_codecInputSize;  // codec input block size per channel - for codecs with actual encoding (G722 and Opus)
     int m_codecInputIndex; // codec input block fill index
-    int m_codecRatio;      // codec compression ratio
+    std::vector<uint8_t> m_encoded;     // encoded bytes waiting for the writing thread to send them over RTP
+    std::vector<uint8_t> m_encodedSend; // encoded bytes being sent by the writing thread
+    QMutex m_encodedMutex;
     unsigned int m_bufferIndex;
     QHostAddress m_address;
     unsigned int m_port;
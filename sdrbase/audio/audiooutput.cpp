@@ -17,12 +17,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
+#include <QThread>
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
 #include <QAudioOutput>
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "audiomix.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
@@ -33,12 +35,17 @@ AudioOutput::AudioOutput() :
 	m_udpChannelCodec(UDPCodecL16),
 	m_audioUsageCount(0),
 	m_onExit(false),
-	m_audioFifos()
+	m_audioFifos(),
+	m_pendingChannels(nullptr),
+	m_retiredChannels(nullptr),
+	m_mixing(0)
 {
 }
 
 AudioOutput::~AudioOutput()
 {
+    delete m_pendingChannels.fetchAndStoreOrdered(nullptr);
+    delete m_retiredChannels.fetchAndStoreOrdered(nullptr);
 //	stop();
 //
 //	QMutexLocker mutexLocker(&m_mutex);
@@ -162,13 +169,36 @@ void AudioOutput::addFifo(AudioFifo* audioFifo)
 	QMutexLocker mutexLocker(&m_mutex);
 
 	m_audioFifos.push_back(audioFifo);
+	publishChannels();
 }
 
 void AudioOutput::removeFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	m_audioFifos.remove(audioFifo);
+	for (MixChannels::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	{
+		if (*it == audioFifo)
+		{
+			m_audioFifos.erase(it);
+			break;
+		}
+	}
+
+	publishChannels();
+
+	// The FIFO is usually deleted next. Either the callback started after the publication and
+	// takes the new list or it is running with the old one and it is waited for.
+	while (m_mixing.fetchAndAddOrdered(0)) {
+		QThread::yieldCurrentThread();
+	}
+}
+
+void AudioOutput::publishChannels()
+{
+	// memory is allocated and freed here so that the audio callback only swaps lists
+	delete m_retiredChannels.fetchAndStoreOrdered(nullptr);
+	delete m_pendingChannels.fetchAndStoreOrdered(new MixChannels(m_audioFifos)); // replaces a list not taken yet
 }
 
 /*
@@ -218,117 +248,93 @@ void AudioOutput::setUdpDecimation(uint32_t decimation)
 	}
 }
 
+bool AudioOutput::getUdpStreamStats(AudioStreamingService::StreamStats& stats)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_audioNetSink) {
+		return false;
+	}
+
+	AudioStreamingService::instance()->getStreamStats(m_audioNetSink, stats);
+	return true;
+}
+
 qint64 AudioOutput::readData(char* data, qint64 maxLen)
 {
     //qDebug("AudioOutput::readData: %lld", maxLen);
 
-    // Study this mutex on OSX, for now deadlocks possible
-    // Removed as it may indeed cause lockups and is in fact useless.
-//#ifndef __APPLE__
-//    QMutexLocker mutexLocker(&m_mutex);
-//#endif
+    // No lock is taken in the audio callback. Channel list changes are picked up here.
+	m_mixing.fetchAndStoreOrdered(1);
+	MixChannels *pendingChannels = m_pendingChannels.fetchAndStoreOrdered(nullptr);
+
+	if (pendingChannels)
+	{
+		m_mixChannels.swap(*pendingChannels);
+		delete m_retiredChannels.fetchAndStoreOrdered(pendingChannels); // normally already freed by publishChannels
+	}
 
 	unsigned int samplesPerBuffer = maxLen / 4;
 
 	if (samplesPerBuffer == 0)
 	{
+		m_mixing.fetchAndStoreOrdered(0);
 		return 0;
 	}
 
 	if (m_mixBuffer.size() < samplesPerBuffer * 2)
 	{
-		m_mixBuffer.resize(samplesPerBuffer * 2); // allocate 2 qint32 per sample (stereo)
-
-		if (m_mixBuffer.size() != samplesPerBuffer * 2)
-		{
-			return 0;
-		}
+		m_mixBuffer.resize(samplesPerBuffer * 2); // allocate 2 floats per sample (stereo)
+		m_readBuffer.resize(samplesPerBuffer);
 	}
 
 	memset(&m_mixBuffer[0], 0x00, 2 * samplesPerBuffer * sizeof(m_mixBuffer[0])); // start with silence
 
 	// sum up a block from all fifos
 
-	for (std::list<AudioFifo*>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	for (MixChannels::const_iterator it = m_mixChannels.begin(); it != m_mixChannels.end(); ++it)
 	{
-		// use outputBuffer as temp - yes, one memcpy could be saved
-		unsigned int samples = (*it)->read((quint8*) data, samplesPerBuffer);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
+		unsigned int samples = (*it)->read((quint8*) &m_readBuffer[0], samplesPerBuffer);
 
 //		if (samples != framesPerBuffer)
 //		{
 //            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
 //		}
 
-		for (unsigned int i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
-    }
-	// convert to int16
-
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
-	qint16* dst = (qint16*) data;
-	qint32 sl, sr;
-
-	for (unsigned int i = 0; i < samplesPerBuffer; i++)
-	{
-		// left channel
-
-		//s = *src++; // Valgrind optim
-		sl = m_mixBuffer[2*i];
-
-		if(sl < -32768)
-		{
-			sl = -32768;
-		}
-		else if (sl > 32767)
-		{
-			sl = 32767;
-		}
-
-		*dst++ = sl;
+		AudioMix::accumulate(&m_mixBuffer[0], &m_readBuffer[0], samples);
+	}
 
-		// right channel
+	m_mixing.fetchAndStoreOrdered(0);
 
-		//s = *src++; // Valgrind optim
-		sr = m_mixBuffer[2*i + 1];
+	// convert to int16 with saturation
 
-		if(sr < -32768)
-		{
-			sr = -32768;
-		}
-		else if (sr > 32767)
-		{
-			sr = 32767;
-		}
+	AudioMix::convert((AudioSample*) data, &m_mixBuffer[0], samplesPerBuffer);
 
-		*dst++ = sr;
+	if ((m_copyAudioToUdp) && (m_audioNetSink))
+	{
+		const AudioSample *src = (const AudioSample*) data;
 
-		if ((m_copyAudioToUdp) && (m_audioNetSink))
+		for (unsigned int i = 0; i < samplesPerBuffer; i++)
 		{
-	        switch (m_udpChannelMode)
-	        {
-            case UDPChannelStereo:
-                m_audioNetSink->write(sl, sr);
-                break;
-            case UDPChannelMixed:
-                m_audioNetSink->write((sl+sr)/2);
-                break;
-            case UDPChannelRight:
-                m_audioNetSink->write(sr);
-                break;
-	        case UDPChannelLeft:
-	        default:
-	            m_audioNetSink->write(sl);
-	            break;
-	        }
+			qint32 sl = src[i].l;
+			qint32 sr = src[i].r;
+
+			switch (m_udpChannelMode)
+			{
+			case UDPChannelStereo:
+				m_audioNetSink->write(sl, sr);
+				break;
+			case UDPChannelMixed:
+				m_audioNetSink->write((sl+sr)/2);
+				break;
+			case UDPChannelRight:
+				m_audioNetSink->write(sr);
+				break;
+			case UDPChannelLeft:
+			default:
+				m_audioNetSink->write(sl);
+				break;
+			}
 		}
 	}
 
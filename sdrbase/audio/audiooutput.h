@@ -22,9 +22,12 @@
 #include <QMutex>
 #include <QIODevice>
 #include <QAudioFormat>
-#include <list>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <vector>
 #include <stdint.h>
+#include "dsp/dsptypes.h"
+#include "audio/audiostreamingservice.h"
 #include "export.h"
 
 class QAudioOutput;
@@ -59,7 +62,7 @@ public:
 	void stop();
 
 	void addFifo(AudioFifo* audioFifo);
-	void removeFifo(AudioFifo* audioFifo);
+	void removeFifo(AudioFifo* audioFifo); //!< The FIFO is not read anymore when this returns
 	int getNbFifos() const { return m_audioFifos.size(); }
 
 	unsigned int getRate() const { return m_audioFormat.sampleRate(); }
@@ -71,8 +74,11 @@ public:
 	void setUdpChannelMode(UDPChannelMode udpChannelMode);
 	void setUdpChannelFormat(UDPChannelCodec udpChannelCodec, bool stereo, int sampleRate);
 	void setUdpDecimation(uint32_t decimation);
+	bool getUdpStreamStats(AudioStreamingService::StreamStats& stats); //!< false if the output is not started
 
 private:
+	typedef std::vector<AudioFifo*> MixChannels;
+
 	QMutex m_mutex;
 	QAudioOutput* m_audioOutput;
 	AudioNetSink* m_audioNetSink;
@@ -82,14 +88,20 @@ private:
 	uint m_audioUsageCount;
 	bool m_onExit;
 
-	std::list<AudioFifo*> m_audioFifos;
-	std::vector<qint32> m_mixBuffer;
+	MixChannels m_audioFifos;                        //!< control side list guarded by m_mutex
+	MixChannels m_mixChannels;                       //!< audio callback copy
+	QAtomicPointer<MixChannels> m_pendingChannels;   //!< next copy for the audio callback
+	QAtomicPointer<MixChannels> m_retiredChannels;   //!< previous copy given back by the audio callback
+	QAtomicInt m_mixing;                             //!< audio callback in progress
+	std::vector<float> m_mixBuffer;
+	AudioVector m_readBuffer;
 
 	QAudioFormat m_audioFormat;
 
 	//virtual bool open(OpenMode mode);
 	virtual qint64 readData(char* data, qint64 maxLen);
 	virtual qint64 writeData(const char* data, qint64 len);
+	void publishChannels();
 
 	friend class AudioOutputPipe;
 };
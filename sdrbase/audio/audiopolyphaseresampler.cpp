@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Block based polyphase audio resampler for any ratio of sample rates. The      //
+// anti aliasing filter is split in one branch per output phase and the branch  //
+// coefficients are computed once per ratio and shared by all the resamplers    //
+// using the same ratio.                                                         //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+
+#include <QGlobalStatic>
+#include <QMutex>
+#include <QMap>
+#include <QString>
+#include <QWeakPointer>
+#include <QDebug>
+
+#include "audiopolyphaseresampler.h"
+
+namespace {
+
+// Banks in use by at least one resampler
+struct BankCache
+{
+    QMutex m_mutex;
+    QMap<QString, QWeakPointer<const AudioPolyphaseResampler::Bank>> m_banks;
+};
+
+// Zero order modified Bessel function of the first kind for the Kaiser window
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; k < 32; k++)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+
+        if (term < 1e-12 * sum) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+unsigned int gcd(unsigned int a, unsigned int b)
+{
+    while (b != 0)
+    {
+        unsigned int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+}
+
+Q_GLOBAL_STATIC(BankCache, bankCache)
+
+const unsigned int AudioPolyphaseResampler::m_maxPhases;
+
+AudioPolyphaseResampler::AudioPolyphaseResampler() :
+    m_inputRate(0),
+    m_outputRate(0),
+    m_nbChannels(1),
+    m_phase(0),
+    m_offset(0)
+{
+}
+
+AudioPolyphaseResampler::~AudioPolyphaseResampler()
+{
+}
+
+void AudioPolyphaseResampler::setRates(int inputRate, int outputRate, unsigned int nbChannels, float cutoff, float gain)
+{
+    inputRate = inputRate < 1 ? 1 : inputRate;
+    outputRate = outputRate < 1 ? 1 : outputRate;
+    unsigned int g = gcd(inputRate, outputRate);
+    unsigned int interpolation = outputRate / g;
+    unsigned int decimation = inputRate / g;
+
+    if (interpolation > m_maxPhases)
+    {
+        // ratio approximated on the largest number of branches
+        decimation = (unsigned int) std::round(((double) inputRate * m_maxPhases) / outputRate);
+        decimation = decimation < 1 ? 1 : decimation;
+        interpolation = m_maxPhases;
+        qWarning("AudioPolyphaseResampler::setRates: %d to %d S/s approximated with %u/%u",
+            inputRate, outputRate, interpolation, decimation);
+    }
+
+    // longer filters when decimating to keep the transition band relative to the output rate
+    unsigned int nbTaps = (32 * std::max(interpolation, decimation) + interpolation - 1) / interpolation;
+    nbTaps = (nbTaps + 3) & ~3U;
+
+    // the filter is centered between the pass band edge and the lowest Nyquist frequency
+    float nyquist = std::min(inputRate, outputRate) / 2.0f;
+    float passband = (cutoff <= 0.0f) || (cutoff > nyquist) ? 0.9f * nyquist : cutoff;
+    float normalizedCutoff = (passband + nyquist) / (2.0f * inputRate * interpolation); // at the upsampled rate
+
+    m_bank = getBank(interpolation, decimation, nbTaps, normalizedCutoff, gain);
+    m_inputRate = inputRate;
+    m_outputRate = outputRate;
+    m_nbChannels = nbChannels < 1 ? 1 : nbChannels;
+    reset();
+}
+
+void AudioPolyphaseResampler::reset()
+{
+    m_phase = 0;
+    m_offset = m_bank ? m_bank->m_nbTaps - 1 : 0;
+    m_work.resize(m_nbChannels);
+
+    for (unsigned int c = 0; c < m_nbChannels; c++) {
+        m_work[c].assign(m_bank ? m_bank->m_nbTaps - 1 : 0, 0.0f);
+    }
+}
+
+unsigned int AudioPolyphaseResampler::getMaxOutput(unsigned int nbInput) const
+{
+    if (!m_bank) {
+        return 0;
+    }
+
+    return ((quint64) nbInput * m_bank->m_interpolation + m_bank->m_decimation - 1) / m_bank->m_decimation;
+}
+
+unsigned int AudioPolyphaseResampler::process(const qint16 *input, unsigned int nbInput, qint16 *output)
+{
+    if (!m_bank) {
+        return 0;
+    }
+
+    const unsigned int L = m_bank->m_interpolation;
+    const unsigned int M = m_bank->m_decimation;
+    const unsigned int nbTaps = m_bank->m_nbTaps;
+    const unsigned int history = nbTaps - 1;
+    const unsigned int length = history + nbInput;
+    unsigned int nbOutput = 0;
+    unsigned int phase = m_phase;
+    unsigned int offset = m_offset;
+
+    for (unsigned int c = 0; c < m_nbChannels; c++)
+    {
+        // history then the new block
+        std::vector<float>& work = m_work[c];
+        work.resize(length);
+
+        for (unsigned int i = 0; i < nbInput; i++) {
+            work[history + i] = input[i * m_nbChannels + c];
+        }
+
+        phase = m_phase;
+        offset = m_offset;
+        nbOutput = 0;
+
+        while (offset < length)
+        {
+            float s = std::nearbyint(dot(&m_bank->m_coefs[phase * nbTaps], &work[offset - history], nbTaps));
+            output[nbOutput * m_nbChannels + c] = s < -32768.0f ? -32768 : s > 32767.0f ? 32767 : (qint16) s;
+            nbOutput++;
+            phase += M;
+            offset += phase / L;
+            phase %= L;
+        }
+
+        // keep the last samples for the next block
+        std::copy(work.begin() + nbInput, work.end(), work.begin());
+        work.resize(history);
+    }
+
+    m_phase = phase;
+    m_offset = offset - nbInput;
+
+    return nbOutput;
+}
+
+float AudioPolyphaseResampler::dot(const float *coefs, const float *samples, unsigned int nbTaps)
+{
+#ifdef USE_SSE2
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    unsigned int i = 0;
+
+    for (; i + 8 <= nbTaps; i += 8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&coefs[i]), _mm_loadu_ps(&samples[i])));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&coefs[i + 4]), _mm_loadu_ps(&samples[i + 4])));
+    }
+
+    if (i < nbTaps) { // taps are a multiple of 4
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&coefs[i]), _mm_loadu_ps(&samples[i])));
+    }
+
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1));
+
+    return _mm_cvtss_f32(acc0);
+#else
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    for (unsigned int i = 0; i < nbTaps; i += 4)
+    {
+        acc[0] += coefs[i] * samples[i];
+        acc[1] += coefs[i + 1] * samples[i + 1];
+        acc[2] += coefs[i + 2] * samples[i + 2];
+        acc[3] += coefs[i + 3] * samples[i + 3];
+    }
+
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+QSharedPointer<const AudioPolyphaseResampler::Bank> AudioPolyphaseResampler::getBank(
+    unsigned int interpolation,
+    unsigned int decimation,
+    unsigned int nbTaps,
+    float cutoff,
+    float gain)
+{
+    QString key = QString("%1:%2:%3:%4:%5").arg(interpolation).arg(decimation).arg(nbTaps).arg(cutoff, 0, 'g', 8).arg(gain, 0, 'g', 8);
+    QMutexLocker mutexLocker(&bankCache()->m_mutex);
+    QSharedPointer<const Bank> bank = bankCache()->m_banks.value(key).toStrongRef();
+
+    if (bank) {
+        return bank;
+    }
+
+    // Kaiser windowed sinc at the upsampled rate split in branches
+    Bank *newBank = new Bank();
+    newBank->m_interpolation = interpolation;
+    newBank->m_decimation = decimation;
+    newBank->m_nbTaps = nbTaps;
+    newBank->m_coefs.resize(interpolation * nbTaps);
+
+    const unsigned int length = interpolation * nbTaps;
+    const double center = (length - 1) / 2.0;
+    const double beta = 7.0;
+    const double i0Beta = besselI0(beta);
+
+    for (unsigned int n = 0; n < length; n++)
+    {
+        double t = n - center;
+        double x = 2.0 * cutoff * t;
+        double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        double r = t / center;
+        double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0Beta;
+        // branch n % L tap n / L, reversed to run along increasing input samples
+        newBank->m_coefs[(n % interpolation) * nbTaps + (nbTaps - 1 - n / interpolation)] =
+            2.0 * cutoff * sinc * window * interpolation * gain;
+    }
+
+    bank = QSharedPointer<const Bank>(newBank);
+    bankCache()->m_banks.insert(key, bank.toWeakRef());
+    qDebug("AudioPolyphaseResampler::getBank: new bank %s", qPrintable(key));
+
+    return bank;
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Block based polyphase audio resampler for any ratio of sample rates. The      //
+// anti aliasing filter is split in one branch per output phase and the branch  //
+// coefficients are computed once per ratio and shared by all the resamplers    //
+// using the same ratio.                                                         //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOPOLYPHASERESAMPLER_H_
+#define SDRBASE_AUDIO_AUDIOPOLYPHASERESAMPLER_H_
+
+#include <vector>
+
+#include <QSharedPointer>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SDRBASE_API AudioPolyphaseResampler
+{
+public:
+    /** Coefficients of all the branches. Branch p computes the outputs at p/L input samples after an input sample. */
+    struct Bank
+    {
+        unsigned int m_interpolation; //!< L: number of branches
+        unsigned int m_decimation;    //!< M: branch step per output sample
+        unsigned int m_nbTaps;        //!< taps per branch, multiple of 4
+        std::vector<float> m_coefs;   //!< L branches of m_nbTaps coefficients in reverse order
+    };
+
+    AudioPolyphaseResampler();
+    ~AudioPolyphaseResampler();
+
+    /**
+     * Set the conversion. Cutoff is the upper limit of the pass band in Hz and defaults to 90% of the
+     * Nyquist frequency of the lowest rate. Samples held from a previous conversion are discarded.
+     */
+    void setRates(int inputRate, int outputRate, unsigned int nbChannels = 1, float cutoff = 0.0f, float gain = 1.0f);
+    void reset(); //!< Discard the samples held for the next block
+    int getInputRate() const { return m_inputRate; }
+    int getOutputRate() const { return m_outputRate; }
+    unsigned int getNbChannels() const { return m_nbChannels; }
+    unsigned int getMaxOutput(unsigned int nbInput) const; //!< Largest number of samples produced from nbInput samples
+
+    /**
+     * Resample nbInput samples of nbChannels interleaved channels. The output must have room for
+     * getMaxOutput(nbInput) samples. Returns the number of samples produced.
+     */
+    unsigned int process(const qint16 *input, unsigned int nbInput, qint16 *output);
+
+    static const unsigned int m_maxPhases = 1024; //!< larger L are approximated with 1024 branches
+
+private:
+    QSharedPointer<const Bank> m_bank;
+    int m_inputRate;
+    int m_outputRate;
+    unsigned int m_nbChannels;
+    unsigned int m_phase;        //!< branch of the next output
+    unsigned int m_offset;       //!< position of the last input sample of the next output in the work buffer
+    std::vector<std::vector<float>> m_work; //!< per channel: history of m_nbTaps-1 samples followed by the input block
+
+    static QSharedPointer<const Bank> getBank(unsigned int interpolation, unsigned int decimation, unsigned int nbTaps,
+        float cutoff, float gain);
+    static float dot(const float *coefs, const float *samples, unsigned int nbTaps);
+};
+
+#endif /* SDRBASE_AUDIO_AUDIOPOLYPHASERESAMPLER_H_ */
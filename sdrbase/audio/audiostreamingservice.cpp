@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Audio streaming service. Blocks of audio of many streams are encoded in       //
+// parallel by a pool of worker threads instead of the threads producing the     //
+// audio. Blocks of a same stream are encoded in order. Datagrams go out         //
+// through one socket per sending thread.                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QGlobalStatic>
+#include <QUdpSocket>
+
+#include "audiostreamingservice.h"
+
+Q_GLOBAL_STATIC(AudioStreamingService, audioStreamingService)
+
+SerialTaskPool::Item *AudioStreamingService::Stream::createItem()
+{
+    return new Block();
+}
+
+void AudioStreamingService::Stream::processItem(SerialTaskPool::Item *item)
+{
+    Block *block = static_cast<Block*>(item);
+    encodeBlock(block->m_samples.data(), block->m_nbSamples);
+}
+
+AudioStreamingService::AudioStreamingService() :
+    m_pool(50) // one second of 20ms blocks per stream
+{
+}
+
+AudioStreamingService::~AudioStreamingService()
+{
+}
+
+AudioStreamingService *AudioStreamingService::instance()
+{
+    return audioStreamingService;
+}
+
+bool AudioStreamingService::submit(Stream *stream, const qint16 *samples, unsigned int nbSamples)
+{
+    Stream::Block *block = static_cast<Stream::Block*>(m_pool.takeItem(stream));
+    block->m_samples.assign(samples, samples + nbSamples);
+    block->m_nbSamples = nbSamples;
+    return m_pool.submit(stream, block);
+}
+
+void AudioStreamingService::sendDatagram(const char *data, qint64 size, const QHostAddress& address, quint16 port)
+{
+    // a socket is only used by the thread that created it
+    if (!m_sockets.hasLocalData()) {
+        m_sockets.setLocalData(new QUdpSocket());
+    }
+
+    m_sockets.localData()->writeDatagram(data, size, address, port);
+}
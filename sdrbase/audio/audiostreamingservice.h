@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Audio streaming service. Blocks of audio of many streams are encoded in       //
+// parallel by a pool of worker threads instead of the threads producing the     //
+// audio. Blocks of a same stream are encoded in order. Datagrams go out         //
+// through one socket per sending thread.                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOSTREAMINGSERVICE_H_
+#define SDRBASE_AUDIO_AUDIOSTREAMINGSERVICE_H_
+
+#include <vector>
+
+#include <QThreadStorage>
+#include <QHostAddress>
+#include <QString>
+
+#include "util/serialtaskpool.h"
+#include "export.h"
+
+class QUdpSocket;
+
+class SDRBASE_API AudioStreamingService
+{
+public:
+    typedef SerialTaskPool::QueueStats StreamStats; //!< items are blocks, processing is encoding
+
+    /** A stream encodes its own blocks. Calls to encodeBlock of a same stream never overlap. */
+    class Stream : public SerialTaskPool::Queue
+    {
+    public:
+        virtual void encodeBlock(const qint16 *samples, unsigned int nbSamples) = 0; //!< called by a worker thread
+
+    protected:
+        virtual SerialTaskPool::Item *createItem();
+        virtual void processItem(SerialTaskPool::Item *item);
+
+    private:
+        struct Block : public SerialTaskPool::Item
+        {
+            std::vector<qint16> m_samples;
+            unsigned int m_nbSamples;  //!< number of sample values (all channels)
+        };
+
+        friend class AudioStreamingService;
+    };
+
+    AudioStreamingService();
+    ~AudioStreamingService();
+
+    static AudioStreamingService *instance();
+
+    void addStream(Stream *stream, const QString& name) { m_pool.addQueue(stream, name); }
+    void removeStream(Stream *stream) { m_pool.removeQueue(stream); } //!< Drops the pending blocks and waits for the block being encoded
+    void drainStream(Stream *stream) { m_pool.drainQueue(stream); }   //!< Same but the stream stays registered
+    void setStreamName(Stream *stream, const QString& name) { m_pool.setQueueName(stream, name); }
+    /** Queue a copy of the block for encoding. Never waits for a worker. Returns false if the oldest block was dropped. */
+    bool submit(Stream *stream, const qint16 *samples, unsigned int nbSamples);
+    void sendDatagram(const char *data, qint64 size, const QHostAddress& address, quint16 port); //!< Thread safe
+    void getStreamStats(std::vector<StreamStats>& stats) { m_pool.getQueueStats(stats); }
+    void getStreamStats(Stream *stream, StreamStats& stats) { m_pool.getQueueStats(stream, stats); }
+    void setMaxQueuedBlocks(unsigned int maxQueuedBlocks) { m_pool.setMaxQueuedItems(maxQueuedBlocks); }
+
+private:
+    SerialTaskPool m_pool;
+    QThreadStorage<QUdpSocket*> m_sockets; //!< one socket per sending thread deleted with the thread
+};
+
+#endif /* SDRBASE_AUDIO_AUDIOSTREAMINGSERVICE_H_ */
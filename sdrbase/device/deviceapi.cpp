@@ -15,15 +15,19 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "plugin/plugininstancegui.h"
 #include "plugin/plugininterface.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/dspcommands.h"
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/devicesamplemimo.h"
+#include "dsp/filerecord.h"
 #include "settings/preset.h"
 #include "channel/channelapi.h"
 
@@ -60,6 +64,12 @@ DeviceAPI::~DeviceAPI()
 
 void DeviceAPI::addAncillarySink(BasebandSampleSink *sink, unsigned int index)
 {
+    FileRecord *fileRecord = dynamic_cast<FileRecord*>(sink);
+
+    if (fileRecord) {
+        m_fileRecords.push_back(fileRecord);
+    }
+
     if (m_deviceSourceEngine) {
         m_deviceSourceEngine->addSink(sink);
     } else if (m_deviceSinkEngine) {
@@ -71,6 +81,12 @@ void DeviceAPI::addAncillarySink(BasebandSampleSink *sink, unsigned int index)
 
 void DeviceAPI::removeAncillarySink(BasebandSampleSink* sink, unsigned int index)
 {
+    std::vector<FileRecord*>::iterator it = std::find(m_fileRecords.begin(), m_fileRecords.end(), dynamic_cast<FileRecord*>(sink));
+
+    if (it != m_fileRecords.end()) {
+        m_fileRecords.erase(it);
+    }
+
     if (m_deviceSourceEngine) {
         m_deviceSourceEngine->removeSink(sink);
     } else if (m_deviceSinkEngine) {
@@ -80,6 +96,18 @@ void DeviceAPI::removeAncillarySink(BasebandSampleSink* sink, unsigned int index
     }
 }
 
+FileRecord *DeviceAPI::getFileRecord() const
+{
+    for (std::vector<FileRecord*>::const_iterator it = m_fileRecords.begin(); it != m_fileRecords.end(); ++it)
+    {
+        if ((*it)->isRecording()) {
+            return *it;
+        }
+    }
+
+    return m_fileRecords.size() > 0 ? m_fileRecords.front() : nullptr;
+}
+
 void DeviceAPI::setSpectrumSinkInput(bool sourceElseSink, unsigned int index)
 {
     if (m_deviceMIMOEngine) { // In practice this is only used in the MIMO case
@@ -272,6 +300,50 @@ void DeviceAPI::stopDeviceEngine(int subsystemIndex)
     }
 }
 
+std::future<int> DeviceAPI::startDeviceEngineAsync(int subsystemIndex, const SyncMessenger::Completion& completion)
+{
+    std::vector<Message*> commands;
+
+    if (m_deviceSourceEngine)
+    {
+        commands.push_back(new DSPAcquisitionInit());
+        commands.push_back(new DSPAcquisitionStart());
+        return m_deviceSourceEngine->sendCommands(commands, completion);
+    }
+    else if (m_deviceSinkEngine)
+    {
+        commands.push_back(new DSPGenerationInit());
+        commands.push_back(new DSPGenerationStart());
+        return m_deviceSinkEngine->sendCommands(commands, completion);
+    }
+    else if (m_deviceMIMOEngine)
+    {
+        if (subsystemIndex == 1) // Tx side
+        {
+            commands.push_back(new DSPGenerationInit());
+            commands.push_back(new DSPGenerationStart());
+        }
+        else // Rx side
+        {
+            commands.push_back(new DSPAcquisitionInit());
+            commands.push_back(new DSPAcquisitionStart());
+        }
+
+        return m_deviceMIMOEngine->sendCommands(commands, completion);
+    }
+    else
+    {
+        std::promise<int> promise;
+        promise.set_value((int) StError);
+
+        if (completion) {
+            completion(StError);
+        }
+
+        return promise.get_future();
+    }
+}
+
 DeviceAPI::EngineState DeviceAPI::state(int subsystemIndex) const
 {
     if (m_deviceSourceEngine) {
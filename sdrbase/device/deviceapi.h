@@ -22,9 +22,11 @@
 #include <QString>
 #include <QTimer>
 
+#include "util/syncmessenger.h"
 #include "export.h"
 
 class BasebandSampleSink;
+class FileRecord;
 class ThreadedBasebandSampleSink;
 class BasebandSampleSource;
 class MIMOChannel;
@@ -70,6 +72,7 @@ public:
     void addAncillarySink(BasebandSampleSink* sink, unsigned int index = 0);       //!< Adds a sink to receive full baseband and that is not a channel (e.g. spectrum)
     void removeAncillarySink(BasebandSampleSink* sink, unsigned int index = 0);    //!< Removes it
     void setSpectrumSinkInput(bool sourceElseSink = true, unsigned int index = 0); //!< Used in the MIMO case to select which stream is used as input to main spectrum
+    FileRecord *getFileRecord() const; //!< Ancillary sink recording the baseband to file (the one recording first) or null
 
     void addChannelSink(ThreadedBasebandSampleSink* sink, int streamIndex = 0);        //!< Add a channel sink (Rx)
     void removeChannelSink(ThreadedBasebandSampleSink* sink, int streamIndex = 0);     //!< Remove a channel sink (Rx)
@@ -95,6 +98,7 @@ public:
     bool initDeviceEngine(int subsystemIndex = 0);    //!< Init the device engine corresponding to the stream type
     bool startDeviceEngine(int subsystemIndex = 0);   //!< Start the device engine corresponding to the stream type
     void stopDeviceEngine(int subsystemIndex = 0);    //!< Stop the device engine corresponding to the stream type
+    std::future<int> startDeviceEngineAsync(int subsystemIndex = 0, const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Init and start the device engine in one batch without waiting. Result is the engine state.
     EngineState state(int subsystemIndex = 0) const;  //!< Return the state of the device engine corresponding to the stream type
     QString errorMessage(int subsystemIndex = 0);     //!< Last error message from the device engine
     uint getDeviceUID() const;  //!< Return the current device engine unique ID
@@ -189,6 +193,7 @@ protected:
     uint32_t m_samplingDeviceSequence;   //!< The device sequence. >0 when more than one device of the same type is connected
     QString m_hardwareUserArguments;     //!< User given arguments to be used at hardware level i.e. for the hardware device and device sequence
     PluginInstanceGUI* m_samplingDevicePluginInstanceUI;
+    std::vector<FileRecord*> m_fileRecords; //!< Ancillary sinks recording the baseband to file
 
     // Buddies (single Rx or single Tx)
 
@@ -15,9 +15,22 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <algorithm>
+
 #include <QGlobalStatic>
+#include <QCoreApplication>
+#include <QSettings>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QDebug>
 
 #include "plugin/pluginmanager.h"
+#include "plugin/pluginproxy.h"
 #include "deviceenumerator.h"
 
 Q_GLOBAL_STATIC(DeviceEnumerator, deviceEnumerator)
@@ -26,94 +39,576 @@ DeviceEnumerator *DeviceEnumerator::instance()
     return deviceEnumerator;
 }
 
-DeviceEnumerator::DeviceEnumerator()
-{}
+const int DeviceEnumerator::m_startupTimeout;
+const int DeviceEnumerator::m_probeTimeout;
+
+/** Probes the registrations of a same hardware in a row so that they share the origin devices */
+class DeviceEnumerator::ProbeTask : public QRunnable
+{
+public:
+    ProbeTask(DeviceEnumerator *deviceEnumerator, int probeId, const QString& hardwareId) :
+        m_deviceEnumerator(deviceEnumerator),
+        m_probeId(probeId),
+        m_hardwareId(hardwareId)
+    {}
+
+    std::vector<ProbeResult> m_probes;
+
+    int getProbeId() const { return m_probeId; }
+
+    virtual void run()
+    {
+        QStringList listedHwIds;
+        PluginInterface::OriginDevices originDevices;
+
+        for (std::vector<ProbeResult>::iterator it = m_probes.begin(); it != m_probes.end(); ++it)
+        {
+            if (m_hardwareId.isEmpty())
+            {
+                // the hardware of the registration is not known yet: the probe runs on its own to find out
+                QStringList ownHwIds;
+                PluginInterface::OriginDevices ownDevices;
+                it->m_pluginInterface->enumOriginDevices(ownHwIds, ownDevices);
+                it->m_hardwareId = ownHwIds.size() > 0 ? ownHwIds.front() : QString();
+
+                if (!listedHwIds.contains(it->m_hardwareId))
+                {
+                    listedHwIds.append(ownHwIds);
+                    originDevices.append(ownDevices);
+                }
+            }
+            else
+            {
+                it->m_pluginInterface->enumOriginDevices(listedHwIds, originDevices);
+                it->m_hardwareId = m_hardwareId;
+            }
+
+            if (it->m_direction == DirectionRx) {
+                it->m_samplingDevices = it->m_pluginInterface->enumSampleSources(originDevices);
+            } else if (it->m_direction == DirectionTx) {
+                it->m_samplingDevices = it->m_pluginInterface->enumSampleSinks(originDevices);
+            } else {
+                it->m_samplingDevices = it->m_pluginInterface->enumSampleMIMO(originDevices);
+            }
+        }
+
+        m_deviceEnumerator->probeDone(m_probeId, m_probes);
+    }
+
+private:
+    DeviceEnumerator *m_deviceEnumerator;
+    int m_probeId;
+    QString m_hardwareId;
+};
+
+static QJsonObject samplingDeviceToJson(const PluginInterface::SamplingDevice& samplingDevice)
+{
+    QJsonObject json;
+    json["displayedName"] = samplingDevice.displayedName;
+    json["hardwareId"] = samplingDevice.hardwareId;
+    json["id"] = samplingDevice.id;
+    json["serial"] = samplingDevice.serial;
+    json["sequence"] = samplingDevice.sequence;
+    json["type"] = (int) samplingDevice.type;
+    json["streamType"] = (int) samplingDevice.streamType;
+    json["deviceNbItems"] = samplingDevice.deviceNbItems;
+    json["deviceItemIndex"] = samplingDevice.deviceItemIndex;
+    return json;
+}
+
+static PluginInterface::SamplingDevice samplingDeviceFromJson(const QJsonObject& json)
+{
+    return PluginInterface::SamplingDevice(
+        json["displayedName"].toString(),
+        json["hardwareId"].toString(),
+        json["id"].toString(),
+        json["serial"].toString(),
+        json["sequence"].toInt(),
+        (PluginInterface::SamplingDevice::SamplingDeviceType) json["type"].toInt(),
+        (PluginInterface::SamplingDevice::StreamType) json["streamType"].toInt(),
+        json["deviceNbItems"].toInt(),
+        json["deviceItemIndex"].toInt()
+    );
+}
+
+DeviceEnumerator::DeviceEnumerator() :
+    m_pluginManager(nullptr),
+    m_enumerationIndex(0),
+    m_nextProbeId(0)
+{
+    m_clock.start();
+    m_probeWatchdog.setInterval(500);
+    connect(&m_probeWatchdog, SIGNAL(timeout()), this, SLOT(checkProbes()));
+}
 
 DeviceEnumerator::~DeviceEnumerator()
-{}
+{
+    // a probe still running holds the enumerator
+    m_probeThreads.clear();
+    m_probeThreads.waitForDone();
+}
+
+void DeviceEnumerator::enumerateDevices(PluginManager *pluginManager)
+{
+    m_pluginManager = pluginManager;
+    m_devicesCacheFileName = QFileInfo(QSettings().fileName()).absolutePath() + "/devices-cache.json";
+
+    if (readDevicesCache())
+    {
+        std::vector<ProbeResult> registrations;
+        getRegistrations(registrations);
+        bool uncached = false;
+
+        for (std::vector<ProbeResult>::iterator it = registrations.begin(); it != registrations.end(); ++it)
+        {
+            uncached = uncached || !m_devicesCache.contains(getRegistrationKey(it->m_direction, it->m_deviceId));
+            QJsonObject entry = m_devicesCache[getRegistrationKey(it->m_direction, it->m_deviceId)].toObject();
+            QJsonArray samplingDevices = entry["devices"].toArray();
+            it->m_hardwareId = entry["hardwareId"].toString();
+
+            for (QJsonArray::const_iterator dIt = samplingDevices.begin(); dIt != samplingDevices.end(); ++dIt) {
+                it->m_samplingDevices.append(samplingDeviceFromJson((*dIt).toObject()));
+            }
+        }
+
+        m_probeMutex.lock();
+        m_probeResults = registrations;
+        m_probeMutex.unlock();
+        handleProbeResults();
+        // the device plugins are not loaded until a device is used or the devices are refreshed
+        // except for the plugins installed since the cache was written that are probed now
+        if (uncached) {
+            startProbes(true);
+        }
+
+        qDebug("DeviceEnumerator::enumerateDevices: %lu Rx %lu Tx %lu MIMO devices from cache",
+            m_rxEnumeration.size(), m_txEnumeration.size(), m_mimoEnumeration.size());
+    }
+    else
+    {
+        // first run: the hardware is probed before the devices can be listed
+        startProbes();
+        QElapsedTimer timer;
+        timer.start();
+        m_probeMutex.lock();
+
+        while ((m_runningProbes.size() > 0) && (timer.elapsed() < m_startupTimeout))
+        {
+            m_probesDone.wait(&m_probeMutex, 100);
+            expireProbes();
+        }
+
+        if (m_runningProbes.size() > 0) {
+            qWarning("DeviceEnumerator::enumerateDevices: %lu probes still running. Their devices will be listed later.", m_runningProbes.size());
+        }
+
+        m_probeMutex.unlock();
+        handleProbeResults();
+    }
+}
+
+void DeviceEnumerator::refreshDevices()
+{
+    QMetaObject::invokeMethod(this, "startProbes", Qt::QueuedConnection);
+}
+
+void DeviceEnumerator::startProbes(bool uncachedOnly)
+{
+    if (!m_pluginManager) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_probeMutex);
+
+    if (m_runningProbes.size() > 0) {
+        return;
+    }
+
+    // vendor libraries may not tolerate being probed while one of their devices is open. Hardware
+    // with a claimed device or with a probe that was given up and is still stuck is not probed.
+    // The registrations of unknown hardware with a stuck probe are not probed either.
+    QStringList busyHardwareIds;
+    QStringList busyRegistrationKeys;
+    getClaimedHardwareIds(busyHardwareIds);
+
+    for (RunningProbes::const_iterator it = m_timedOutProbes.begin(); it != m_timedOutProbes.end(); ++it)
+    {
+        if (it->second.m_hardwareId.isEmpty()) {
+            busyRegistrationKeys.append(it->second.m_registrationKeys);
+        } else {
+            busyHardwareIds.append(it->second.m_hardwareId);
+        }
+    }
+
+    std::vector<ProbeResult> registrations;
+    getRegistrations(registrations);
+    // registrations of the same hardware are probed in a row and different hardware concurrently.
+    // Each registration of unknown hardware has its own probe.
+    std::map<QString, ProbeTask*> tasks; // by hardware ID or registration key if the hardware is unknown
+    int nbProbed = 0;
+    int nbSkipped = 0;
+
+    for (std::vector<ProbeResult>::const_iterator it = registrations.begin(); it != registrations.end(); ++it)
+    {
+        QString registrationKey = getRegistrationKey(it->m_direction, it->m_deviceId);
+
+        if (uncachedOnly && m_devicesCache.contains(registrationKey)) {
+            continue;
+        }
+
+        QString hardwareId = m_devicesCache[registrationKey].toObject()["hardwareId"].toString();
+
+        if ((!hardwareId.isEmpty() && busyHardwareIds.contains(hardwareId)) || busyRegistrationKeys.contains(registrationKey))
+        {
+            nbSkipped++;
+            continue;
+        }
+
+        QString taskKey = hardwareId.isEmpty() ? registrationKey : hardwareId;
+
+        if (tasks.find(taskKey) == tasks.end())
+        {
+            tasks[taskKey] = new ProbeTask(this, m_nextProbeId, hardwareId);
+            RunningProbe& runningProbe = m_runningProbes[m_nextProbeId];
+            runningProbe.m_hardwareId = hardwareId;
+            runningProbe.m_startTime = m_clock.elapsed();
+            m_nextProbeId++;
+        }
+
+        tasks[taskKey]->m_probes.push_back(*it);
+        nbProbed++;
+        RunningProbe& runningProbe = m_runningProbes[tasks[taskKey]->getProbeId()];
+        runningProbe.m_deviceIds.append(it->m_deviceId);
+        runningProbe.m_registrationKeys.append(registrationKey);
+    }
+
+    // the probes given up still hold their thread
+    m_probeThreads.setMaxThreadCount(std::max(1, (int) (m_runningProbes.size() + m_timedOutProbes.size())));
+    qDebug("DeviceEnumerator::startProbes: %d registrations in %lu probes. %d registrations of busy hardware or stuck probes skipped",
+        nbProbed, m_runningProbes.size(), nbSkipped);
+
+    for (std::map<QString, ProbeTask*>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+    {
+        // the libraries are loaded here in the main thread rather than by the probe threads
+        for (std::vector<ProbeResult>::const_iterator pIt = it->second->m_probes.begin(); pIt != it->second->m_probes.end(); ++pIt) {
+            static_cast<PluginProxy*>(pIt->m_pluginInterface)->load();
+        }
+
+        m_probeThreads.start(it->second);
+    }
+
+    if (m_runningProbes.size() > 0) {
+        m_probeWatchdog.start();
+    }
+}
+
+void DeviceEnumerator::probeDone(int probeId, const std::vector<ProbeResult>& probeResults)
+{
+    QMutexLocker mutexLocker(&m_probeMutex);
+    // the results of a probe given up are still merged when it returns
+    m_probeResults.insert(m_probeResults.end(), probeResults.begin(), probeResults.end());
+
+    if (m_runningProbes.erase(probeId) == 0)
+    {
+        RunningProbes::iterator it = m_timedOutProbes.find(probeId);
+
+        if (it != m_timedOutProbes.end())
+        {
+            qWarning("DeviceEnumerator::probeDone: probe of %s returned after %lld ms",
+                qPrintable(it->second.m_deviceIds.join(",")), m_clock.elapsed() - it->second.m_startTime);
+            m_timedOutProbes.erase(it);
+        }
+    }
+
+    m_probesDone.wakeAll();
+    QMetaObject::invokeMethod(this, "handleProbeResults", Qt::QueuedConnection);
+}
+
+void DeviceEnumerator::expireProbes()
+{
+    qint64 now = m_clock.elapsed();
+    RunningProbes::iterator it = m_runningProbes.begin();
+
+    while (it != m_runningProbes.end())
+    {
+        if (now - it->second.m_startTime > m_probeTimeout)
+        {
+            qWarning("DeviceEnumerator::expireProbes: probe of %s gave no answer in %d ms. Its devices are not updated.",
+                qPrintable(it->second.m_deviceIds.join(",")), m_probeTimeout);
+            m_timedOutProbes.insert(*it);
+            m_runningProbes.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
 
-void DeviceEnumerator::enumerateRxDevices(PluginManager *pluginManager)
+void DeviceEnumerator::checkProbes()
 {
-    m_rxEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& rxDeviceRegistrations = pluginManager->getSourceDeviceRegistrations();
-    int index = 0;
+    QMutexLocker mutexLocker(&m_probeMutex);
+    expireProbes();
 
-    for (int i = 0; i < rxDeviceRegistrations.count(); i++)
+    if (m_runningProbes.size() == 0) {
+        m_probeWatchdog.stop();
+    }
+
+    m_probesDone.wakeAll();
+}
+
+bool DeviceEnumerator::isProbing(const QString& hardwareId) const
+{
+    for (RunningProbes::const_iterator it = m_runningProbes.begin(); it != m_runningProbes.end(); ++it)
+    {
+        if (!hardwareId.isEmpty() && (it->second.m_hardwareId == hardwareId)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DeviceEnumerator::waitForProbe(const QString& hardwareId)
+{
+    QMutexLocker mutexLocker(&m_probeMutex);
+
+    if (isProbing(hardwareId)) {
+        qDebug("DeviceEnumerator::waitForProbe: wait for the probe of %s to complete", qPrintable(hardwareId));
+    }
+
+    while (isProbing(hardwareId))
     {
-        qDebug("DeviceEnumerator::enumerateRxDevices: %s", qPrintable(rxDeviceRegistrations[i].m_deviceId));
-        rxDeviceRegistrations[i].m_plugin->enumOriginDevices(m_originDevicesHwIds, m_originDevices);
-        PluginInterface::SamplingDevices samplingDevices = rxDeviceRegistrations[i].m_plugin->enumSampleSources(m_originDevices);
+        m_probesDone.wait(&m_probeMutex, 100);
+        expireProbes();
+    }
+}
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+void DeviceEnumerator::getClaimedHardwareIds(QStringList& hardwareIds) const
+{
+    const DevicesEnumeration *enumerations[3] = {&m_rxEnumeration, &m_txEnumeration, &m_mimoEnumeration};
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (DevicesEnumeration::const_iterator it = enumerations[i]->begin(); it != enumerations[i]->end(); ++it)
         {
-            m_rxEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    rxDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            if ((it->m_samplingDevice.claimed >= 0) && (it->m_samplingDevice.type != PluginInterface::SamplingDevice::BuiltInDevice)) {
+                hardwareIds.append(it->m_samplingDevice.hardwareId);
+            }
         }
     }
 }
 
-void DeviceEnumerator::enumerateTxDevices(PluginManager *pluginManager)
+void DeviceEnumerator::getDevicesSnapshot(int direction, DevicesSnapshot& snapshot) const
 {
-    m_txEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& txDeviceRegistrations = pluginManager->getSinkDeviceRegistrations();
-    int index = 0;
+    const DevicesEnumeration& enumeration = direction == 0 ? m_rxEnumeration : direction == 1 ? m_txEnumeration : m_mimoEnumeration;
 
-    for (int i = 0; i < txDeviceRegistrations.count(); i++)
+    m_enumerationMutex.lock();
+    snapshot.m_enumerationIndex = m_enumerationIndex;
+    snapshot.m_samplingDevices.clear();
+    snapshot.m_removed.clear();
+
+    for (DevicesEnumeration::const_iterator it = enumeration.begin(); it != enumeration.end(); ++it)
     {
-        qDebug("DeviceEnumerator::enumerateTxDevices: %s", qPrintable(txDeviceRegistrations[i].m_deviceId));
-        txDeviceRegistrations[i].m_plugin->enumOriginDevices(m_originDevicesHwIds, m_originDevices);
-        PluginInterface::SamplingDevices samplingDevices = txDeviceRegistrations[i].m_plugin->enumSampleSinks(m_originDevices);
+        snapshot.m_samplingDevices.push_back(it->m_samplingDevice);
+        snapshot.m_removed.push_back(it->m_removed);
+    }
+
+    m_enumerationMutex.unlock();
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+    QMutexLocker mutexLocker(&m_probeMutex);
+    snapshot.m_timedOutProbes.clear();
+
+    for (RunningProbes::const_iterator it = m_timedOutProbes.begin(); it != m_timedOutProbes.end(); ++it) {
+        snapshot.m_timedOutProbes.append(it->second.m_deviceIds);
+    }
+}
+
+void DeviceEnumerator::handleProbeResults()
+{
+    std::vector<ProbeResult> probeResults;
+    m_probeMutex.lock();
+    probeResults.swap(m_probeResults);
+    m_probeMutex.unlock();
+
+    if (probeResults.size() == 0) {
+        return;
+    }
+
+    // results are merged in the order of the registrations
+    std::vector<ProbeResult> registrations;
+    getRegistrations(registrations);
+    QJsonObject devicesCache = m_devicesCache;
+    bool changed = false;
+    m_enumerationMutex.lock();
+
+    for (std::vector<ProbeResult>::const_iterator rIt = registrations.begin(); rIt != registrations.end(); ++rIt)
+    {
+        for (std::vector<ProbeResult>::const_iterator it = probeResults.begin(); it != probeResults.end(); ++it)
         {
-            m_txEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    txDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            if ((it->m_direction != rIt->m_direction) || (it->m_pluginInterface != rIt->m_pluginInterface)) {
+                continue;
+            }
+
+            DevicesEnumeration& enumeration = it->m_direction == DirectionRx ? m_rxEnumeration :
+                it->m_direction == DirectionTx ? m_txEnumeration : m_mimoEnumeration;
+            changed = mergeDevices(enumeration, it->m_pluginInterface, it->m_samplingDevices) || changed;
+
+            QJsonArray samplingDevices;
+
+            for (int i = 0; i < it->m_samplingDevices.count(); i++) {
+                samplingDevices.append(samplingDeviceToJson(it->m_samplingDevices[i]));
+            }
+
+            QJsonObject entry;
+            entry["hardwareId"] = it->m_hardwareId;
+            entry["devices"] = samplingDevices;
+            m_devicesCache[getRegistrationKey(it->m_direction, it->m_deviceId)] = entry;
         }
     }
+
+    m_enumerationIndex += changed ? 1 : 0;
+    m_enumerationMutex.unlock();
+
+    if (changed) {
+        emit devicesChanged();
+    }
+
+    if (m_devicesCache != devicesCache) {
+        writeDevicesCache();
+    }
 }
 
-void DeviceEnumerator::enumerateMIMODevices(PluginManager *pluginManager)
+bool DeviceEnumerator::mergeDevices(
+        DevicesEnumeration& enumeration,
+        PluginInterface *pluginInterface,
+        const PluginInterface::SamplingDevices& samplingDevices)
 {
-    m_mimoEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& mimoDeviceRegistrations = pluginManager->getMIMODeviceRegistrations();
-    int index = 0;
+    std::vector<bool> found(enumeration.size(), false);
+    bool changed = false;
+
+    for (int i = 0; i < samplingDevices.count(); i++)
+    {
+        const PluginInterface::SamplingDevice& samplingDevice = samplingDevices[i];
+        unsigned int index = 0;
+
+        for (; index < enumeration.size(); index++)
+        {
+            const PluginInterface::SamplingDevice& listed = enumeration[index].m_samplingDevice;
+
+            if (!found[index]
+             && (enumeration[index].m_pluginInterface == pluginInterface)
+             && (listed.id == samplingDevice.id)
+             && (listed.serial == samplingDevice.serial)
+             && (listed.sequence == samplingDevice.sequence)
+             && (listed.deviceItemIndex == samplingDevice.deviceItemIndex)) {
+                break;
+            }
+        }
+
+        if (index < enumeration.size())
+        {
+            found[index] = true;
+
+            if (enumeration[index].m_removed)
+            {
+                // plugged again: the claim of the device is kept
+                int claimed = enumeration[index].m_samplingDevice.claimed;
+                enumeration[index].m_samplingDevice = samplingDevice;
+                enumeration[index].m_samplingDevice.claimed = claimed;
+                enumeration[index].m_removed = false;
+                changed = true;
+            }
+        }
+        else
+        {
+            enumeration.push_back(DeviceEnumeration(samplingDevice, pluginInterface, enumeration.size()));
+            found.push_back(true);
+            changed = true;
+        }
+    }
 
-    for (int i = 0; i < mimoDeviceRegistrations.count(); i++)
+    for (unsigned int index = 0; index < enumeration.size(); index++)
     {
-        qDebug("DeviceEnumerator::enumerateMIMODevices: %s", qPrintable(mimoDeviceRegistrations[i].m_deviceId));
-        mimoDeviceRegistrations[i].m_plugin->enumOriginDevices(m_originDevicesHwIds, m_originDevices);
-        PluginInterface::SamplingDevices samplingDevices = mimoDeviceRegistrations[i].m_plugin->enumSampleMIMO(m_originDevices);
+        if ((enumeration[index].m_pluginInterface == pluginInterface) && !found[index] && !enumeration[index].m_removed)
+        {
+            enumeration[index].m_removed = true;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+void DeviceEnumerator::getRegistrations(std::vector<ProbeResult>& registrations)
+{
+    PluginAPI::SamplingDeviceRegistrations *deviceRegistrations[3] = {
+        &m_pluginManager->getSourceDeviceRegistrations(),
+        &m_pluginManager->getSinkDeviceRegistrations(),
+        &m_pluginManager->getMIMODeviceRegistrations()
+    };
+
+    for (int direction = DirectionRx; direction <= DirectionMIMO; direction++)
+    {
+        for (int i = 0; i < deviceRegistrations[direction]->count(); i++)
         {
-            m_mimoEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    mimoDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            registrations.push_back(ProbeResult());
+            registrations.back().m_direction = (Direction) direction;
+            registrations.back().m_deviceId = (*deviceRegistrations[direction])[i].m_deviceId;
+            registrations.back().m_pluginInterface = (*deviceRegistrations[direction])[i].m_plugin;
         }
     }
 }
 
+QString DeviceEnumerator::getRegistrationKey(Direction direction, const QString& deviceId)
+{
+    return QString("%1:%2").arg((int) direction).arg(deviceId);
+}
+
+bool DeviceEnumerator::readDevicesCache()
+{
+    QFile cacheFile(m_devicesCacheFileName);
+
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject devicesCache = QJsonDocument::fromJson(cacheFile.readAll()).object();
+
+    if (devicesCache["version"].toString() != QCoreApplication::applicationVersion())
+    {
+        qDebug("DeviceEnumerator::readDevicesCache: %s is obsolete", qPrintable(m_devicesCacheFileName));
+        return false;
+    }
+
+    m_devicesCache = devicesCache["registrations"].toObject();
+    return !m_devicesCache.isEmpty();
+}
+
+void DeviceEnumerator::writeDevicesCache()
+{
+    QJsonObject devicesCache;
+    devicesCache["version"] = QCoreApplication::applicationVersion();
+    devicesCache["registrations"] = m_devicesCache;
+    QFile cacheFile(m_devicesCacheFileName);
+
+    if (!cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("DeviceEnumerator::writeDevicesCache: cannot write %s", qPrintable(m_devicesCacheFileName));
+        return;
+    }
+
+    cacheFile.write(QJsonDocument(devicesCache).toJson(QJsonDocument::Compact));
+}
+
 void DeviceEnumerator::listRxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const
 {
     for (DevicesEnumeration::const_iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
+        if (it->m_removed) {
+            continue;
+        }
+
         if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
         {
             list.append(it->m_samplingDevice.displayedName);
@@ -126,6 +621,10 @@ void DeviceEnumerator::listTxDeviceNames(QList<QString>& list, std::vector<int>&
 {
     for (DevicesEnumeration::const_iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
+        if (it->m_removed) {
+            continue;
+        }
+
         if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
         {
             list.append(it->m_samplingDevice.displayedName);
@@ -138,6 +637,10 @@ void DeviceEnumerator::listMIMODeviceNames(QList<QString>& list, std::vector<int
 {
     for (DevicesEnumeration::const_iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
+        if (it->m_removed) {
+            continue;
+        }
+
         if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
         {
             list.append(it->m_samplingDevice.displayedName);
@@ -148,6 +651,14 @@ void DeviceEnumerator::listMIMODeviceNames(QList<QString>& list, std::vector<int
 
 void DeviceEnumerator::changeRxSelection(int tabIndex, int deviceIndex)
 {
+    const PluginInterface::SamplingDevice& samplingDevice = m_rxEnumeration[deviceIndex].m_samplingDevice;
+
+    if (samplingDevice.type != PluginInterface::SamplingDevice::BuiltInDevice) {
+        waitForProbe(samplingDevice.hardwareId); // the device is opened next
+    }
+
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -161,6 +672,14 @@ void DeviceEnumerator::changeRxSelection(int tabIndex, int deviceIndex)
 
 void DeviceEnumerator::changeTxSelection(int tabIndex, int deviceIndex)
 {
+    const PluginInterface::SamplingDevice& samplingDevice = m_txEnumeration[deviceIndex].m_samplingDevice;
+
+    if (samplingDevice.type != PluginInterface::SamplingDevice::BuiltInDevice) {
+        waitForProbe(samplingDevice.hardwareId); // the device is opened next
+    }
+
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -174,6 +693,14 @@ void DeviceEnumerator::changeTxSelection(int tabIndex, int deviceIndex)
 
 void DeviceEnumerator::changeMIMOSelection(int tabIndex, int deviceIndex)
 {
+    const PluginInterface::SamplingDevice& samplingDevice = m_mimoEnumeration[deviceIndex].m_samplingDevice;
+
+    if (samplingDevice.type != PluginInterface::SamplingDevice::BuiltInDevice) {
+        waitForProbe(samplingDevice.hardwareId); // the device is opened next
+    }
+
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -187,6 +714,8 @@ void DeviceEnumerator::changeMIMOSelection(int tabIndex, int deviceIndex)
 
 void DeviceEnumerator::removeRxSelection(int tabIndex)
 {
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -197,6 +726,8 @@ void DeviceEnumerator::removeRxSelection(int tabIndex)
 
 void DeviceEnumerator::removeTxSelection(int tabIndex)
 {
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -207,6 +738,8 @@ void DeviceEnumerator::removeTxSelection(int tabIndex)
 
 void DeviceEnumerator::removeMIMOSelection(int tabIndex)
 {
+    QMutexLocker mutexLocker(&m_enumerationMutex);
+
     for (DevicesEnumeration::iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
         if (it->m_samplingDevice.claimed == tabIndex) {
@@ -255,7 +788,7 @@ int DeviceEnumerator::getRxSamplingDeviceIndex(const QString& deviceId, int sequ
 {
     for (DevicesEnumeration::iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (!it->m_removed && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
@@ -267,7 +800,7 @@ int DeviceEnumerator::getTxSamplingDeviceIndex(const QString& deviceId, int sequ
 {
     for (DevicesEnumeration::iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (!it->m_removed && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
@@ -279,7 +812,7 @@ int DeviceEnumerator::getMIMOSamplingDeviceIndex(const QString& deviceId, int se
 {
     for (DevicesEnumeration::iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (!it->m_removed && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
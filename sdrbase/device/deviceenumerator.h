@@ -19,23 +19,49 @@
 #define SDRBASE_DEVICE_DEVICEENUMERATOR_H_
 
 #include <vector>
+#include <map>
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QJsonObject>
 
 #include "plugin/plugininterface.h"
 #include "export.h"
 
 class PluginManager;
 
-class SDRBASE_API DeviceEnumerator
+class SDRBASE_API DeviceEnumerator : public QObject
 {
+    Q_OBJECT
 public:
+    /** Devices of one direction copied for threads other than the main thread */
+    struct DevicesSnapshot
+    {
+        int m_enumerationIndex;
+        std::vector<PluginInterface::SamplingDevice> m_samplingDevices;
+        std::vector<bool> m_removed;
+        QStringList m_timedOutProbes; //!< registrations of the probes given up that have not returned yet
+
+        DevicesSnapshot() : m_enumerationIndex(0) {}
+    };
+
     DeviceEnumerator();
     ~DeviceEnumerator();
 
     static DeviceEnumerator *instance();
 
-    void enumerateRxDevices(PluginManager *pluginManager);
-    void enumerateTxDevices(PluginManager *pluginManager);
-    void enumerateMIMODevices(PluginManager *pluginManager);
+    /** Devices of the last run are listed at once and the hardware is probed when the devices are refreshed.
+     *  Without a devices cache the hardware is probed in the foreground for a limited time. */
+    void enumerateDevices(PluginManager *pluginManager);
+    void refreshDevices(); //!< Probes the hardware in the background unless a probe is running. Can be called from any thread.
+    void getDevicesSnapshot(int direction, DevicesSnapshot& snapshot) const; //!< direction 0: Rx, 1: Tx, 2: MIMO. Can be called from any thread.
+    // the enumerations change on the main thread: the methods below are for the main thread only
+    int getEnumerationIndex() const { return m_enumerationIndex; } //!< incremented at each change of the devices lists
     void listRxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
     void listTxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
     void listMIMODeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
@@ -54,6 +80,9 @@ public:
     PluginInterface *getRxPluginInterface(int deviceIndex) { return m_rxEnumeration[deviceIndex].m_pluginInterface; }
     PluginInterface *getTxPluginInterface(int deviceIndex) { return m_txEnumeration[deviceIndex].m_pluginInterface; }
     PluginInterface *getMIMOPluginInterface(int deviceIndex) { return m_mimoEnumeration[deviceIndex].m_pluginInterface; }
+    bool isRxSamplingDeviceRemoved(int deviceIndex) const { return m_rxEnumeration[deviceIndex].m_removed; }
+    bool isTxSamplingDeviceRemoved(int deviceIndex) const { return m_txEnumeration[deviceIndex].m_removed; }
+    bool isMIMOSamplingDeviceRemoved(int deviceIndex) const { return m_mimoEnumeration[deviceIndex].m_removed; }
     int getFileInputDeviceIndex() const;  //!< Get Rx default device
     int getFileSinkDeviceIndex() const;   //!< Get Tx default device
     int getTestMIMODeviceIndex() const;   //!< Get MIMO default device
@@ -61,27 +90,93 @@ public:
     int getTxSamplingDeviceIndex(const QString& deviceId, int sequence);
     int getMIMOSamplingDeviceIndex(const QString& deviceId, int sequence);
 
+signals:
+    void devicesChanged();
+
+private slots:
+    void startProbes(bool uncachedOnly = false); //!< uncachedOnly: only the registrations not in the devices cache
+    void handleProbeResults();
+    void checkProbes();
+
 private:
     struct DeviceEnumeration
     {
         PluginInterface::SamplingDevice m_samplingDevice;
         PluginInterface *m_pluginInterface;
         int m_index;
+        bool m_removed; //!< not found by the last probe. Kept so that the device indexes do not change.
 
         DeviceEnumeration(const PluginInterface::SamplingDevice& samplingDevice, PluginInterface *pluginInterface, int index) :
             m_samplingDevice(samplingDevice),
             m_pluginInterface(pluginInterface),
-            m_index(index)
+            m_index(index),
+            m_removed(false)
         {}
     };
 
     typedef std::vector<DeviceEnumeration> DevicesEnumeration;
 
+    enum Direction
+    {
+        DirectionRx,
+        DirectionTx,
+        DirectionMIMO
+    };
+
+    /** Sampling devices of a device registration */
+    struct ProbeResult
+    {
+        Direction m_direction;
+        QString m_deviceId;
+        QString m_hardwareId;
+        PluginInterface *m_pluginInterface;
+        PluginInterface::SamplingDevices m_samplingDevices;
+    };
+
+    /** Probe task running on the probe threads */
+    struct RunningProbe
+    {
+        QString m_hardwareId;    //!< empty if not known yet
+        QStringList m_deviceIds; //!< registrations probed
+        QStringList m_registrationKeys; //!< registrations probed (see getRegistrationKey)
+        qint64 m_startTime;      //!< milliseconds on the enumerator clock
+    };
+
+    typedef std::map<int, RunningProbe> RunningProbes; //!< by probe ID
+
+    class ProbeTask;
+
+    static const int m_startupTimeout = 10000; //!< milliseconds the startup waits for the probes without devices cache
+    static const int m_probeTimeout = 5000;    //!< milliseconds after which a probe is given up
+
     DevicesEnumeration m_rxEnumeration;
     DevicesEnumeration m_txEnumeration;
     DevicesEnumeration m_mimoEnumeration;
-    PluginInterface::OriginDevices m_originDevices;
-    QStringList m_originDevicesHwIds;
+    mutable QMutex m_enumerationMutex; //!< held by the main thread when it changes the enumerations
+    PluginManager *m_pluginManager;
+    int m_enumerationIndex;
+    QThreadPool m_probeThreads;
+    mutable QMutex m_probeMutex;    //!< guards the probe results and the running and timed out probes
+    QWaitCondition m_probesDone;
+    std::vector<ProbeResult> m_probeResults;
+    RunningProbes m_runningProbes;
+    RunningProbes m_timedOutProbes; //!< given up and not returned yet. Their hardware or registrations are not probed again until they return.
+    int m_nextProbeId;
+    QElapsedTimer m_clock;
+    QTimer m_probeWatchdog;
+    QJsonObject m_devicesCache;     //!< registration key to its hardware ID and sampling devices
+    QString m_devicesCacheFileName;
+
+    void probeDone(int probeId, const std::vector<ProbeResult>& probeResults); //!< called by the probe tasks
+    void expireProbes(); //!< gives up the probes running for longer than m_probeTimeout. Called with m_probeMutex held.
+    bool isProbing(const QString& hardwareId) const; //!< called with m_probeMutex held
+    void waitForProbe(const QString& hardwareId); //!< waits until the hardware is not probed before one of its devices is claimed
+    void getClaimedHardwareIds(QStringList& hardwareIds) const;
+    bool readDevicesCache();
+    void writeDevicesCache();
+    void getRegistrations(std::vector<ProbeResult>& registrations);
+    bool mergeDevices(DevicesEnumeration& enumeration, PluginInterface *pluginInterface, const PluginInterface::SamplingDevices& samplingDevices);
+    static QString getRegistrationKey(Direction direction, const QString& deviceId);
 };
 
 #endif /* SDRBASE_DEVICE_DEVICEENUMERATOR_H_ */
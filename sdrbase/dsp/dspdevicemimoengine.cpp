@@ -53,6 +53,7 @@ DSPDeviceMIMOEngine::DSPDeviceMIMOEngine(uint32_t uid, QObject* parent) :
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
+	connect(&m_syncMessenger, SIGNAL(asyncMessageSent()), this, SLOT(handleAsynchronousMessages()), Qt::QueuedConnection);
 
 	moveToThread(this);
 }
@@ -138,6 +139,34 @@ void DSPDeviceMIMOEngine::stopProcess(int subsystemIndex)
     }
 }
 
+std::future<int> DSPDeviceMIMOEngine::initProcessAsync(int subsystemIndex, const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceMIMOEngine::initProcessAsync: subsystemIndex: " << subsystemIndex;
+
+    if (subsystemIndex == 1) { // Tx side
+        return m_syncMessenger.sendAsync(new DSPGenerationInit(), completion);
+    } else { // Rx side
+        return m_syncMessenger.sendAsync(new DSPAcquisitionInit(), completion);
+    }
+}
+
+std::future<int> DSPDeviceMIMOEngine::startProcessAsync(int subsystemIndex, const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceMIMOEngine::startProcessAsync: subsystemIndex: " << subsystemIndex;
+
+    if (subsystemIndex == 1) { // Tx side
+        return m_syncMessenger.sendAsync(new DSPGenerationStart(), completion);
+    } else { // Rx side
+        return m_syncMessenger.sendAsync(new DSPAcquisitionStart(), completion);
+    }
+}
+
+std::future<int> DSPDeviceMIMOEngine::sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion)
+{
+	qDebug("DSPDeviceMIMOEngine::sendCommands: %u commands", (unsigned int) commands.size());
+	return m_syncMessenger.sendAsync(commands, completion);
+}
+
 void DSPDeviceMIMOEngine::setMIMO(DeviceSampleMIMO* mimo)
 {
 	qDebug() << "DSPDeviceMIMOEngine::setMIMO";
@@ -157,8 +186,7 @@ void DSPDeviceMIMOEngine::addChannelSource(BasebandSampleSource* source, int ind
         << source->objectName().toStdString().c_str()
         << " at: "
         << index;
-	AddBasebandSampleSource cmd(source, index);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new AddBasebandSampleSource(source, index));
 }
 
 void DSPDeviceMIMOEngine::removeChannelSource(BasebandSampleSource* source, int index)
@@ -177,8 +205,7 @@ void DSPDeviceMIMOEngine::addChannelSink(ThreadedBasebandSampleSink* sink, int i
         << sink->objectName().toStdString().c_str()
         << " at: "
         << index;
-	AddThreadedBasebandSampleSink cmd(sink, index);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new AddThreadedBasebandSampleSink(sink, index));
 }
 
 void DSPDeviceMIMOEngine::removeChannelSink(ThreadedBasebandSampleSink* sink, int index)
@@ -195,8 +222,7 @@ void DSPDeviceMIMOEngine::addMIMOChannel(MIMOChannel *channel)
 {
 	qDebug() << "DSPDeviceMIMOEngine::addMIMOChannel: "
         << channel->objectName().toStdString().c_str();
-    AddMIMOChannel cmd(channel);
-    m_syncMessenger.sendWait(cmd);
+    m_syncMessenger.sendAsync(new AddMIMOChannel(channel));
 }
 
 void DSPDeviceMIMOEngine::removeMIMOChannel(MIMOChannel *channel)
@@ -213,8 +239,7 @@ void DSPDeviceMIMOEngine::addAncillarySink(BasebandSampleSink* sink, int index)
         << sink->objectName().toStdString().c_str()
         << " at: "
         << index;
-	AddBasebandSampleSink cmd(sink, index);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new AddBasebandSampleSink(sink, index));
 }
 
 void DSPDeviceMIMOEngine::removeAncillarySink(BasebandSampleSink* sink, int index)
@@ -230,8 +255,7 @@ void DSPDeviceMIMOEngine::removeAncillarySink(BasebandSampleSink* sink, int inde
 void DSPDeviceMIMOEngine::addSpectrumSink(BasebandSampleSink* spectrumSink)
 {
 	qDebug() << "DSPDeviceMIMOEngine::addSpectrumSink: " << spectrumSink->objectName().toStdString().c_str();
-	AddSpectrumSink cmd(spectrumSink);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new AddSpectrumSink(spectrumSink));
 }
 
 void DSPDeviceMIMOEngine::removeSpectrumSink(BasebandSampleSink* spectrumSink)
@@ -936,11 +960,35 @@ void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
 
 void DSPDeviceMIMOEngine::handleSynchronousMessages()
 {
+    handleAsynchronousMessages(); // messages sent before this one are processed first
     Message *message = m_syncMessenger.getMessage();
 	qDebug() << "DSPDeviceMIMOEngine::handleSynchronousMessages: " << message->getIdentifier();
+	m_syncMessenger.done(processSynchronousMessage(*message));
+}
+
+void DSPDeviceMIMOEngine::handleAsynchronousMessages()
+{
+    SyncMessenger::AsyncBatch *batch;
+
+    while ((batch = m_syncMessenger.takeAsyncBatch()) != 0)
+    {
+        int result = StNotStarted;
+
+        for (std::vector<Message*>::iterator it = batch->m_messages.begin(); it != batch->m_messages.end(); ++it)
+        {
+            qDebug() << "DSPDeviceMIMOEngine::handleAsynchronousMessages: " << (*it)->getIdentifier();
+            result = processSynchronousMessage(**it);
+        }
+
+        m_syncMessenger.doneAsync(batch, result);
+    }
+}
+
+int DSPDeviceMIMOEngine::processSynchronousMessage(Message& message)
+{
     State returnState = StNotStarted;
 
-	if (DSPAcquisitionInit::match(*message))
+	if (DSPAcquisitionInit::match(message))
 	{
 		m_stateRx = gotoIdle(0);
 
@@ -950,7 +998,7 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 
         returnState = m_stateRx;
 	}
-	else if (DSPAcquisitionStart::match(*message))
+	else if (DSPAcquisitionStart::match(message))
 	{
 		if (m_stateRx == StReady) {
 			m_stateRx = gotoRunning(0);
@@ -958,12 +1006,12 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 
         returnState = m_stateRx;
 	}
-	else if (DSPAcquisitionStop::match(*message))
+	else if (DSPAcquisitionStop::match(message))
 	{
 		m_stateRx = gotoIdle(0);
         returnState = m_stateRx;
 	}
-    else if (DSPGenerationInit::match(*message))
+    else if (DSPGenerationInit::match(message))
 	{
 		m_stateTx = gotoIdle(1);
 
@@ -973,7 +1021,7 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 
         returnState = m_stateTx;
 	}
-	else if (DSPGenerationStart::match(*message))
+	else if (DSPGenerationStart::match(message))
 	{
 		if (m_stateTx == StReady) {
 			m_stateTx = gotoRunning(1);
@@ -981,18 +1029,18 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 
         returnState = m_stateTx;
 	}
-	else if (DSPGenerationStop::match(*message))
+	else if (DSPGenerationStop::match(message))
 	{
 		m_stateTx = gotoIdle(1);
         returnState = m_stateTx;
 	}
-	else if (GetMIMODeviceDescription::match(*message))
+	else if (GetMIMODeviceDescription::match(message))
 	{
-		((GetMIMODeviceDescription*) message)->setDeviceDescription(m_deviceDescription);
+		((GetMIMODeviceDescription*) &message)->setDeviceDescription(m_deviceDescription);
 	}
-	else if (GetErrorMessage::match(*message))
+	else if (GetErrorMessage::match(message))
 	{
-        GetErrorMessage *cmd = (GetErrorMessage *) message;
+        GetErrorMessage *cmd = (GetErrorMessage *) &message;
         int subsystemIndex = cmd->getSubsystemIndex();
         if (subsystemIndex == 0) {
             cmd->setErrorMessage(m_errorMessageRx);
@@ -1002,12 +1050,12 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             cmd->setErrorMessage("Not implemented");
         }
 	}
-	else if (SetSampleMIMO::match(*message)) {
-		handleSetMIMO(((SetSampleMIMO*) message)->getSampleMIMO());
+	else if (SetSampleMIMO::match(message)) {
+		handleSetMIMO(((SetSampleMIMO*) &message)->getSampleMIMO());
 	}
-	else if (AddBasebandSampleSink::match(*message))
+	else if (AddBasebandSampleSink::match(message))
 	{
-        const AddBasebandSampleSink *msg = (AddBasebandSampleSink *) message;
+        const AddBasebandSampleSink *msg = (AddBasebandSampleSink *) &message;
 		BasebandSampleSink* sink = msg->getSampleSink();
         unsigned int isource = msg->getIndex();
 
@@ -1025,10 +1073,10 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             }
         }
 	}
-	else if (RemoveBasebandSampleSink::match(*message))
+	else if (RemoveBasebandSampleSink::match(message))
 	{
-        const RemoveBasebandSampleSink *msg = (RemoveBasebandSampleSink *) message;
-		BasebandSampleSink* sink = ((DSPRemoveBasebandSampleSink*) message)->getSampleSink();
+        const RemoveBasebandSampleSink *msg = (RemoveBasebandSampleSink *) &message;
+		BasebandSampleSink* sink = ((DSPRemoveBasebandSampleSink*) &message)->getSampleSink();
         unsigned int isource = msg->getIndex();
 
         if (isource < m_basebandSampleSinks.size())
@@ -1040,9 +1088,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 		    m_basebandSampleSinks[isource].remove(sink);
         }
 	}
-	else if (AddThreadedBasebandSampleSink::match(*message))
+	else if (AddThreadedBasebandSampleSink::match(message))
 	{
-        const AddThreadedBasebandSampleSink *msg = (AddThreadedBasebandSampleSink *) message;
+        const AddThreadedBasebandSampleSink *msg = (AddThreadedBasebandSampleSink *) &message;
 		ThreadedBasebandSampleSink *threadedSink = msg->getThreadedSampleSink();
         unsigned int isource = msg->getIndex();
 
@@ -1060,9 +1108,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             }
         }
 	}
-	else if (RemoveThreadedBasebandSampleSink::match(*message))
+	else if (RemoveThreadedBasebandSampleSink::match(message))
 	{
-        const RemoveThreadedBasebandSampleSink *msg = (RemoveThreadedBasebandSampleSink *) message;
+        const RemoveThreadedBasebandSampleSink *msg = (RemoveThreadedBasebandSampleSink *) &message;
 		ThreadedBasebandSampleSink* threadedSink = msg->getThreadedSampleSink();
         unsigned int isource = msg->getIndex();
 
@@ -1072,9 +1120,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             m_threadedBasebandSampleSinks[isource].remove(threadedSink);
         }
 	}
-	else if (AddBasebandSampleSource::match(*message))
+	else if (AddBasebandSampleSource::match(message))
 	{
-        const AddBasebandSampleSource *msg = (AddBasebandSampleSource *) message;
+        const AddBasebandSampleSource *msg = (AddBasebandSampleSource *) &message;
 		BasebandSampleSource *sampleSource = msg->getSampleSource();
         unsigned int isink = msg->getIndex();
 
@@ -1092,9 +1140,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             }
         }
 	}
-	else if (RemoveBasebandSampleSource::match(*message))
+	else if (RemoveBasebandSampleSource::match(message))
 	{
-        const RemoveBasebandSampleSource *msg = (RemoveBasebandSampleSource *) message;
+        const RemoveBasebandSampleSource *msg = (RemoveBasebandSampleSource *) &message;
 		BasebandSampleSource* sampleSource = msg->getSampleSource();
         unsigned int isink = msg->getIndex();
 
@@ -1104,9 +1152,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             m_basebandSampleSources[isink].remove(sampleSource);
         }
 	}
-    else if (AddMIMOChannel::match(*message))
+    else if (AddMIMOChannel::match(message))
     {
-        const AddMIMOChannel *msg = (AddMIMOChannel *) message;
+        const AddMIMOChannel *msg = (AddMIMOChannel *) &message;
         MIMOChannel *channel = msg->getChannel();
         m_mimoChannels.push_back(channel);
 
@@ -1140,21 +1188,21 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
             channel->startSources();
         }
     }
-    else if (RemoveMIMOChannel::match(*message))
+    else if (RemoveMIMOChannel::match(message))
     {
-        const RemoveMIMOChannel *msg = (RemoveMIMOChannel *) message;
+        const RemoveMIMOChannel *msg = (RemoveMIMOChannel *) &message;
         MIMOChannel *channel = msg->getChannel();
         channel->stopSinks();
         channel->stopSources();
         m_mimoChannels.remove(channel);
     }
-	else if (AddSpectrumSink::match(*message))
+	else if (AddSpectrumSink::match(message))
 	{
-		m_spectrumSink = ((AddSpectrumSink*) message)->getSampleSink();
+		m_spectrumSink = ((AddSpectrumSink*) &message)->getSampleSink();
 	}
-    else if (RemoveSpectrumSink::match(*message))
+    else if (RemoveSpectrumSink::match(message))
     {
-        BasebandSampleSink* spectrumSink = ((DSPRemoveSpectrumSink*) message)->getSampleSink();
+        BasebandSampleSink* spectrumSink = ((DSPRemoveSpectrumSink*) &message)->getSampleSink();
         spectrumSink->stop();
 
         // if (!m_spectrumInputSourceElseSink && m_deviceSampleMIMO && (m_spectrumInputIndex <  m_deviceSampleMIMO->getNbSinkStreams()))
@@ -1165,9 +1213,9 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
 
         m_spectrumSink = nullptr;
     }
-    else if (SetSpectrumSinkInput::match(*message))
+    else if (SetSpectrumSinkInput::match(message))
     {
-        const SetSpectrumSinkInput *msg = (SetSpectrumSinkInput *) message;
+        const SetSpectrumSinkInput *msg = (SetSpectrumSinkInput *) &message;
         bool spectrumInputSourceElseSink = msg->getSourceElseSink();
         unsigned int spectrumInputIndex = msg->getIndex();
 
@@ -1206,7 +1254,7 @@ void DSPDeviceMIMOEngine::handleSynchronousMessages()
         }
     }
 
-    m_syncMessenger.done(returnState);
+    return returnState;
 }
 
 void DSPDeviceMIMOEngine::handleInputMessages()
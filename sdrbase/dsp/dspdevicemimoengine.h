@@ -254,13 +254,16 @@ public:
 	bool initProcess(int subsystemIndex);  //!< Initialize process sequence
 	bool startProcess(int subsystemIndex); //!< Start process sequence
 	void stopProcess(int subsystemIndex);  //!< Stop process sequence
+	std::future<int> initProcessAsync(int subsystemIndex, const SyncMessenger::Completion& completion = SyncMessenger::Completion());  //!< Initialize process sequence without waiting. Result is the subsystem state.
+	std::future<int> startProcessAsync(int subsystemIndex, const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Start process sequence without waiting. Result is the subsystem state.
+	std::future<int> sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Process engine commands (taking ownership) in one go without waiting
 
 	void setMIMO(DeviceSampleMIMO* mimo); //!< Set the sample MIMO type
 	DeviceSampleMIMO *getMIMO() { return m_deviceSampleMIMO; }
 	void setMIMOSequence(int sequence); //!< Set the sample MIMO sequence in type
     uint getUID() const { return m_uid; }
 
-	void addChannelSource(BasebandSampleSource* source, int index = 0);            //!< Add a channel source
+	void addChannelSource(BasebandSampleSource* source, int index = 0);            //!< Add a channel source. Does not wait for completion.
 	void removeChannelSource(BasebandSampleSource* source, int index = 0);         //!< Remove a channel source
 	void addChannelSink(ThreadedBasebandSampleSink* sink, int index = 0);          //!< Add a channel sink that will run on its own thread
 	void removeChannelSink(ThreadedBasebandSampleSink* sink, int index = 0);       //!< Remove a channel sink that runs on its own thread
@@ -389,6 +392,7 @@ private:
 	State gotoError(int subsystemIndex, const QString& errorMsg); //!< Go to an error state
 
     void handleSetMIMO(DeviceSampleMIMO* mimo); //!< Manage MIMO device setting
+    int processSynchronousMessage(Message& message); //!< Process an engine command and return the state of the subsystem concerned
    	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, int isource, bool imbalanceCorrection);
 
 private slots:
@@ -397,6 +401,7 @@ private slots:
 	void handleDataTxSync();           //!< Handle data when Tx samples have to be processed synchronously
 	void handleDataTxAsync(int streamIndex); //!< Handle data when Tx samples have to be processed asynchronously
 	void handleSynchronousMessages();  //!< Handle synchronous messages with the thread
+	void handleAsynchronousMessages(); //!< Handle messages sent asynchronously to the thread
 	void handleInputMessages();        //!< Handle input message queue
 };
 
@@ -28,6 +28,39 @@
 #include "dsp/dspcommands.h"
 #include "samplesourcefifodb.h"
 
+class DSPDeviceSinkEngine::SourcePullTask : public QRunnable
+{
+public:
+    SourcePullTask(QSemaphore *done) :
+        m_source(nullptr),
+        m_nbSamples(0),
+        m_done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    void set(BasebandSampleSource *source, SampleVector::iterator begin, unsigned int nbSamples)
+    {
+        m_source = source;
+        m_begin = begin;
+        m_nbSamples = nbSamples;
+    }
+
+    void run()
+    {
+        m_source->pull(m_begin, m_nbSamples);
+        m_done->release();
+    }
+
+private:
+    BasebandSampleSource *m_source;
+    SampleVector::iterator m_begin;
+    unsigned int m_nbSamples;
+    QSemaphore *m_done;
+};
+
+const unsigned int DSPDeviceSinkEngine::m_minParallelPull;
+
 DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	QThread(parent),
     m_uid(uid),
@@ -41,6 +74,7 @@ DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
+	connect(&m_syncMessenger, SIGNAL(asyncMessageSent()), this, SLOT(handleAsynchronousMessages()), Qt::QueuedConnection);
 
 	moveToThread(this);
 }
@@ -49,6 +83,13 @@ DSPDeviceSinkEngine::~DSPDeviceSinkEngine()
 {
     stop();
 	wait();
+    m_sourcePullThreadPool.waitForDone();
+
+    for (unsigned int i = 0; i < m_sourceBuffers.size(); i++)
+    {
+        delete m_sourceBuffers[i];
+        delete m_sourcePullTasks[i];
+    }
 }
 
 void DSPDeviceSinkEngine::run()
@@ -94,8 +135,30 @@ void DSPDeviceSinkEngine::stopGeneration()
 {
 	qDebug() << "DSPDeviceSinkEngine::stopGeneration";
 	DSPGenerationStop cmd;
-	m_syncMessenger.storeMessage(cmd);
-	handleSynchronousMessages();
+
+	if (isRunning() && (QThread::currentThread() != this)) {
+		m_syncMessenger.sendWait(cmd); // processed in the engine thread after any pending asynchronous command
+	} else {
+		processSynchronousMessage(cmd);
+	}
+}
+
+std::future<int> DSPDeviceSinkEngine::initGenerationAsync(const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceSinkEngine::initGenerationAsync";
+	return m_syncMessenger.sendAsync(new DSPGenerationInit(), completion);
+}
+
+std::future<int> DSPDeviceSinkEngine::startGenerationAsync(const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceSinkEngine::startGenerationAsync";
+	return m_syncMessenger.sendAsync(new DSPGenerationStart(), completion);
+}
+
+std::future<int> DSPDeviceSinkEngine::sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion)
+{
+	qDebug("DSPDeviceSinkEngine::sendCommands: %u commands", (unsigned int) commands.size());
+	return m_syncMessenger.sendAsync(commands, completion);
 }
 
 void DSPDeviceSinkEngine::setSink(DeviceSampleSink* sink)
@@ -114,8 +177,7 @@ void DSPDeviceSinkEngine::setSinkSequence(int sequence)
 void DSPDeviceSinkEngine::addChannelSource(BasebandSampleSource* source)
 {
 	qDebug() << "DSPDeviceSinkEngine::addChannelSource: " << source->objectName().toStdString().c_str();
-	DSPAddBasebandSampleSource cmd(source);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new DSPAddBasebandSampleSource(source));
 }
 
 void DSPDeviceSinkEngine::removeChannelSource(BasebandSampleSource* source)
@@ -128,8 +190,7 @@ void DSPDeviceSinkEngine::removeChannelSource(BasebandSampleSource* source)
 void DSPDeviceSinkEngine::addSpectrumSink(BasebandSampleSink* spectrumSink)
 {
 	qDebug() << "DSPDeviceSinkEngine::addSpectrumSink: " << spectrumSink->objectName().toStdString().c_str();
-	DSPAddSpectrumSink cmd(spectrumSink);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new DSPAddSpectrumSink(spectrumSink));
 }
 
 void DSPDeviceSinkEngine::removeSpectrumSink(BasebandSampleSink* spectrumSink)
@@ -204,33 +265,8 @@ void DSPDeviceSinkEngine::workSamples(SampleVector& data, unsigned int iBegin, u
     }
     else
     {
-        m_sourceSampleBuffer.allocate(nbSamples);
-        SampleVector::iterator sBegin = m_sourceSampleBuffer.m_vector.begin();
-        BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin();
-        BasebandSampleSource *source = *srcIt;
-        source->pull(begin, nbSamples);
-        srcIt++;
-        m_sumIndex = 1;
-
-        for (; srcIt != m_basebandSampleSources.end(); ++srcIt, m_sumIndex++)
-        {
-            source = *srcIt;
-            source->pull(sBegin, nbSamples);
-            std::transform(
-                sBegin,
-                sBegin + nbSamples,
-                data.begin() + iBegin,
-                data.begin() + iBegin,
-                [this](Sample& a, const Sample& b) -> Sample {
-                    int den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                    int nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-                    return Sample{
-                        a.real()/den + nom*(b.real()/den),
-                        a.imag()/den + nom*(b.imag()/den)
-                    };
-                }
-            );
-        }
+        pullSources(begin, nbSamples);
+        mixSources(begin, nbSamples);
     }
 
     // possibly feed data to spectrum sink
@@ -239,6 +275,85 @@ void DSPDeviceSinkEngine::workSamples(SampleVector& data, unsigned int iBegin, u
     }
 }
 
+void DSPDeviceSinkEngine::allocateSourceBuffers()
+{
+    unsigned int nbBuffers = m_basebandSampleSources.size() - 1;
+
+    while (m_sourceBuffers.size() < nbBuffers)
+    {
+        m_sourceBuffers.push_back(new IncrementalVector<Sample>());
+        m_sourcePullTasks.push_back(new SourcePullTask(&m_sourcePullDone));
+    }
+}
+
+void DSPDeviceSinkEngine::pullSources(SampleVector::iterator& begin, unsigned int nbSamples)
+{
+    allocateSourceBuffers();
+    BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin();
+    BasebandSampleSource *firstSource = *srcIt;
+    ++srcIt;
+
+    if (nbSamples < m_minParallelPull)
+    {
+        firstSource->pull(begin, nbSamples);
+
+        for (unsigned int i = 0; srcIt != m_basebandSampleSources.end(); ++srcIt, i++)
+        {
+            m_sourceBuffers[i]->allocate(nbSamples);
+            SampleVector::iterator sBegin = m_sourceBuffers[i]->m_vector.begin();
+            (*srcIt)->pull(sBegin, nbSamples);
+        }
+
+        return;
+    }
+
+    // the other sources run in the pool while this thread pulls the first one
+    unsigned int nbTasks = 0;
+
+    for (; srcIt != m_basebandSampleSources.end(); ++srcIt, nbTasks++)
+    {
+        m_sourceBuffers[nbTasks]->allocate(nbSamples);
+        m_sourcePullTasks[nbTasks]->set(*srcIt, m_sourceBuffers[nbTasks]->m_vector.begin(), nbSamples);
+        m_sourcePullThreadPool.start(m_sourcePullTasks[nbTasks]);
+    }
+
+    firstSource->pull(begin, nbSamples);
+    m_sourcePullDone.acquire(nbTasks);
+}
+
+void DSPDeviceSinkEngine::mixSources(SampleVector::iterator& begin, unsigned int nbSamples)
+{
+    // sums are accumulated on a wider type and scaled once to the average of all sources
+    unsigned int nbComponents = 2 * nbSamples;
+    unsigned int nbSources = m_basebandSampleSources.size();
+
+    if (m_mixAccumulator.size() < nbComponents) {
+        m_mixAccumulator.resize(nbComponents);
+    }
+
+    MixAccumulator *acc = m_mixAccumulator.data();
+    FixReal *out = (FixReal *) &(*begin);
+
+    for (unsigned int i = 0; i < nbComponents; i++) {
+        acc[i] = out[i];
+    }
+
+    for (unsigned int is = 0; is < nbSources - 1; is++)
+    {
+        const FixReal *in = (const FixReal *) m_sourceBuffers[is]->m_vector.data();
+
+        for (unsigned int i = 0; i < nbComponents; i++) {
+            acc[i] += in[i];
+        }
+    }
+
+    const MixAccumulator scale = (1 << 15) / nbSources; // Q15 reciprocal
+
+    for (unsigned int i = 0; i < nbComponents; i++) {
+        out[i] = (acc[i] * scale) >> 15;
+    }
+}
+
 // notStarted -> idle -> init -> running -+
 //                ^                       |
 //                +-----------------------+
@@ -423,10 +538,33 @@ void DSPDeviceSinkEngine::handleData()
 
 void DSPDeviceSinkEngine::handleSynchronousMessages()
 {
+    handleAsynchronousMessages(); // messages sent before this one are processed first
     Message *message = m_syncMessenger.getMessage();
 	qDebug() << "DSPDeviceSinkEngine::handleSynchronousMessages: " << message->getIdentifier();
+	m_syncMessenger.done(processSynchronousMessage(*message));
+}
+
+void DSPDeviceSinkEngine::handleAsynchronousMessages()
+{
+    SyncMessenger::AsyncBatch *batch;
+
+    while ((batch = m_syncMessenger.takeAsyncBatch()) != 0)
+    {
+        int result = m_state;
+
+        for (std::vector<Message*>::iterator it = batch->m_messages.begin(); it != batch->m_messages.end(); ++it)
+        {
+            qDebug() << "DSPDeviceSinkEngine::handleAsynchronousMessages: " << (*it)->getIdentifier();
+            result = processSynchronousMessage(**it);
+        }
 
-	if (DSPGenerationInit::match(*message))
+        m_syncMessenger.doneAsync(batch, result);
+    }
+}
+
+int DSPDeviceSinkEngine::processSynchronousMessage(Message& message)
+{
+	if (DSPGenerationInit::match(message))
 	{
 		m_state = gotoIdle();
 
@@ -434,34 +572,34 @@ void DSPDeviceSinkEngine::handleSynchronousMessages()
 			m_state = gotoInit(); // State goes ready if init is performed
 		}
 	}
-	else if (DSPGenerationStart::match(*message))
+	else if (DSPGenerationStart::match(message))
 	{
 		if(m_state == StReady) {
 			m_state = gotoRunning();
 		}
 	}
-	else if (DSPGenerationStop::match(*message))
+	else if (DSPGenerationStop::match(message))
 	{
 		m_state = gotoIdle();
 	}
-	else if (DSPGetSinkDeviceDescription::match(*message))
+	else if (DSPGetSinkDeviceDescription::match(message))
 	{
-		((DSPGetSinkDeviceDescription*) message)->setDeviceDescription(m_deviceDescription);
+		((DSPGetSinkDeviceDescription*) &message)->setDeviceDescription(m_deviceDescription);
 	}
-	else if (DSPGetErrorMessage::match(*message))
+	else if (DSPGetErrorMessage::match(message))
 	{
-		((DSPGetErrorMessage*) message)->setErrorMessage(m_errorMessage);
+		((DSPGetErrorMessage*) &message)->setErrorMessage(m_errorMessage);
 	}
-	else if (DSPSetSink::match(*message)) {
-		handleSetSink(((DSPSetSink*) message)->getSampleSink());
+	else if (DSPSetSink::match(message)) {
+		handleSetSink(((DSPSetSink*) &message)->getSampleSink());
 	}
-	else if (DSPAddSpectrumSink::match(*message))
+	else if (DSPAddSpectrumSink::match(message))
 	{
-		m_spectrumSink = ((DSPAddSpectrumSink*) message)->getSampleSink();
+		m_spectrumSink = ((DSPAddSpectrumSink*) &message)->getSampleSink();
 	}
-	else if (DSPRemoveSpectrumSink::match(*message))
+	else if (DSPRemoveSpectrumSink::match(message))
 	{
-		BasebandSampleSink* spectrumSink = ((DSPRemoveSpectrumSink*) message)->getSampleSink();
+		BasebandSampleSink* spectrumSink = ((DSPRemoveSpectrumSink*) &message)->getSampleSink();
 
 		if(m_state == StRunning) {
 			spectrumSink->stop();
@@ -469,9 +607,9 @@ void DSPDeviceSinkEngine::handleSynchronousMessages()
 
 		m_spectrumSink = nullptr;
 	}
-	else if (DSPAddBasebandSampleSource::match(*message))
+	else if (DSPAddBasebandSampleSource::match(message))
 	{
-		BasebandSampleSource* source = ((DSPAddBasebandSampleSource*) message)->getSampleSource();
+		BasebandSampleSource* source = ((DSPAddBasebandSampleSource*) &message)->getSampleSource();
 		m_basebandSampleSources.push_back(source);
         DSPSignalNotification notif(m_sampleRate, m_centerFrequency);
         source->handleMessage(notif);
@@ -481,9 +619,9 @@ void DSPDeviceSinkEngine::handleSynchronousMessages()
             source->start();
         }
 	}
-	else if (DSPRemoveBasebandSampleSource::match(*message))
+	else if (DSPRemoveBasebandSampleSource::match(message))
 	{
-		BasebandSampleSource* source = ((DSPRemoveBasebandSampleSource*) message)->getSampleSource();
+		BasebandSampleSource* source = ((DSPRemoveBasebandSampleSource*) &message)->getSampleSource();
 
 		if(m_state == StRunning) {
 			source->stop();
@@ -492,7 +630,7 @@ void DSPDeviceSinkEngine::handleSynchronousMessages()
 		m_basebandSampleSources.remove(source);
 	}
 
-	m_syncMessenger.done(m_state);
+	return m_state;
 }
 
 void DSPDeviceSinkEngine::handleInputMessages()
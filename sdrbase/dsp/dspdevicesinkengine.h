@@ -23,10 +23,13 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QThreadPool>
+#include <QSemaphore>
 
 #include <stdint.h>
 #include <list>
 #include <map>
+#include <vector>
 
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
@@ -65,14 +68,18 @@ public:
 	bool startGeneration(); //!< Start generation sequence
 	void stopGeneration();   //!< Stop generation sequence
 
+	std::future<int> initGenerationAsync(const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Initialize generation sequence without waiting. Result is the engine state.
+	std::future<int> startGenerationAsync(const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Start generation sequence without waiting. Result is the engine state.
+	std::future<int> sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Process engine commands (taking ownership) in one go without waiting
+
 	void setSink(DeviceSampleSink* sink); //!< Set the sample sink type
 	DeviceSampleSink *getSink() { return m_deviceSampleSink; }
 	void setSinkSequence(int sequence); //!< Set the sample sink sequence in type
 
-	void addChannelSource(BasebandSampleSource* source);       //!< Add a baseband sample source
+	void addChannelSource(BasebandSampleSource* source);       //!< Add a baseband sample source. Does not wait for completion.
 	void removeChannelSource(BasebandSampleSource* source);    //!< Remove a baseband sample source
 
-	void addSpectrumSink(BasebandSampleSink* spectrumSink);    //!< Add a spectrum vis baseband sample sink
+	void addSpectrumSink(BasebandSampleSink* spectrumSink);    //!< Add a spectrum vis baseband sample sink. Does not wait for completion.
 	void removeSpectrumSink(BasebandSampleSink* spectrumSink); //!< Add a spectrum vis baseband sample sink
 
 	State state() const { return m_state; } //!< Return DSP engine current state
@@ -98,16 +105,30 @@ private:
 	BasebandSampleSources m_basebandSampleSources; //!< baseband sample sources within main thread (usually file input)
 
 	BasebandSampleSink *m_spectrumSink;
-    IncrementalVector<Sample> m_sourceSampleBuffer;
     IncrementalVector<Sample> m_sourceZeroBuffer;
 
+#if SDR_RX_SAMP_SZ == 16
+    typedef qint32 MixAccumulator;
+#else
+    typedef qint64 MixAccumulator;
+#endif
+    class SourcePullTask;
+    std::vector<IncrementalVector<Sample>*> m_sourceBuffers; //!< one per source after the first
+    std::vector<SourcePullTask*> m_sourcePullTasks;          //!< pull the sources after the first in the thread pool
+    std::vector<MixAccumulator> m_mixAccumulator;            //!< sum of the sources interleaved I/Q
+    QThreadPool m_sourcePullThreadPool;
+    QSemaphore m_sourcePullDone;
+    static const unsigned int m_minParallelPull = 256;       //!< sources are pulled serially below this number of samples
+
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
-    unsigned int m_sumIndex; //!< channel index when summing channels
 
 	void run();
 	void workSampleFifo(); //!< transfer samples from baseband sources to sink if in running state
     void workSamples(SampleVector& data, unsigned int iBegin, unsigned int iEnd);
+    void pullSources(SampleVector::iterator& begin, unsigned int nbSamples); //!< Pull all sources concurrently
+    void mixSources(SampleVector::iterator& begin, unsigned int nbSamples);  //!< Average of all sources in a single pass
+    void allocateSourceBuffers();
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
@@ -115,11 +136,13 @@ private:
 	State gotoError(const QString& errorMsg); //!< Go to an error state
 
 	void handleSetSink(DeviceSampleSink* sink); //!< Manage sink setting
+	int processSynchronousMessage(Message& message); //!< Process an engine command and return the engine state
 
 private slots:
 	void handleData(); //!< Handle data when samples have to be written to the sample FIFO
 	void handleInputMessages(); //!< Handle input message queue
 	void handleSynchronousMessages(); //!< Handle synchronous messages with the thread
+	void handleAsynchronousMessages(); //!< Handle messages sent asynchronously to the thread
 };
 
 
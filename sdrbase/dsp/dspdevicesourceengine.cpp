@@ -37,6 +37,8 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_basebandSampleSinks(),
 	m_sampleRate(0),
 	m_centerFrequency(0),
+	m_channelBacklog(0),
+	m_channelFreeSpace(-1),
 	m_dcOffsetCorrection(false),
 	m_iqImbalanceCorrection(false),
 	m_iOffset(0),
@@ -47,6 +49,7 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
+	connect(&m_syncMessenger, SIGNAL(asyncMessageSent()), this, SLOT(handleAsynchronousMessages()), Qt::QueuedConnection);
 
 	moveToThread(this);
 }
@@ -100,8 +103,12 @@ void DSPDeviceSourceEngine::stopAcquistion()
 {
 	qDebug() << "DSPDeviceSourceEngine::stopAcquistion";
 	DSPAcquisitionStop cmd;
-	m_syncMessenger.storeMessage(cmd);
-	handleSynchronousMessages();
+
+	if (isRunning() && (QThread::currentThread() != this)) {
+		m_syncMessenger.sendWait(cmd); // processed in the engine thread after any pending asynchronous command
+	} else {
+		processSynchronousMessage(cmd);
+	}
 
 	if(m_dcOffsetCorrection)
 	{
@@ -109,6 +116,24 @@ void DSPDeviceSourceEngine::stopAcquistion()
 	}
 }
 
+std::future<int> DSPDeviceSourceEngine::initAcquisitionAsync(const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceSourceEngine::initAcquisitionAsync";
+	return m_syncMessenger.sendAsync(new DSPAcquisitionInit(), completion);
+}
+
+std::future<int> DSPDeviceSourceEngine::startAcquisitionAsync(const SyncMessenger::Completion& completion)
+{
+	qDebug() << "DSPDeviceSourceEngine::startAcquisitionAsync";
+	return m_syncMessenger.sendAsync(new DSPAcquisitionStart(), completion);
+}
+
+std::future<int> DSPDeviceSourceEngine::sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion)
+{
+	qDebug("DSPDeviceSourceEngine::sendCommands: %u commands", (unsigned int) commands.size());
+	return m_syncMessenger.sendAsync(commands, completion);
+}
+
 void DSPDeviceSourceEngine::setSource(DeviceSampleSource* source)
 {
 	qDebug() << "DSPDeviceSourceEngine::setSource";
@@ -125,8 +150,7 @@ void DSPDeviceSourceEngine::setSourceSequence(int sequence)
 void DSPDeviceSourceEngine::addSink(BasebandSampleSink* sink)
 {
 	qDebug() << "DSPDeviceSourceEngine::addSink: " << sink->objectName().toStdString().c_str();
-	DSPAddBasebandSampleSink cmd(sink);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new DSPAddBasebandSampleSink(sink));
 }
 
 void DSPDeviceSourceEngine::removeSink(BasebandSampleSink* sink)
@@ -139,8 +163,7 @@ void DSPDeviceSourceEngine::removeSink(BasebandSampleSink* sink)
 void DSPDeviceSourceEngine::addThreadedSink(ThreadedBasebandSampleSink* sink)
 {
 	qDebug() << "DSPDeviceSourceEngine::addThreadedSink: " << sink->objectName().toStdString().c_str();
-	DSPAddThreadedBasebandSampleSink cmd(sink);
-	m_syncMessenger.sendWait(cmd);
+	m_syncMessenger.sendAsync(new DSPAddThreadedBasebandSampleSink(sink));
 }
 
 void DSPDeviceSourceEngine::removeThreadedSink(ThreadedBasebandSampleSink* sink)
@@ -406,6 +429,21 @@ void DSPDeviceSourceEngine::work()
 		sampleFifo->readCommit((unsigned int) count);
 		samplesDone += count;
 	}
+
+	// report how far behind the channels are so that sources not tied to real time can throttle
+	int channelBacklog = 0;
+	int channelFreeSpace = -1;
+
+	for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+	{
+		int fifoBacklog = (*it)->getFifoBacklog();
+		int fifoFreeSpace = (int) (*it)->getFifoFreeSpace();
+		channelBacklog = fifoBacklog > channelBacklog ? fifoBacklog : channelBacklog;
+		channelFreeSpace = (channelFreeSpace < 0) || (fifoFreeSpace < channelFreeSpace) ? fifoFreeSpace : channelFreeSpace;
+	}
+
+	m_channelBacklog.store(channelBacklog);
+	m_channelFreeSpace.store(channelFreeSpace);
 }
 
 // notStarted -> idle -> init -> running -+
@@ -607,41 +645,63 @@ void DSPDeviceSourceEngine::handleData()
 
 void DSPDeviceSourceEngine::handleSynchronousMessages()
 {
+    handleAsynchronousMessages(); // messages sent before this one are processed first
     Message *message = m_syncMessenger.getMessage();
 	qDebug() << "DSPDeviceSourceEngine::handleSynchronousMessages: " << message->getIdentifier();
+	m_syncMessenger.done(processSynchronousMessage(*message));
+}
+
+void DSPDeviceSourceEngine::handleAsynchronousMessages()
+{
+    SyncMessenger::AsyncBatch *batch;
+
+    while ((batch = m_syncMessenger.takeAsyncBatch()) != 0)
+    {
+        int result = m_state;
+
+        for (std::vector<Message*>::iterator it = batch->m_messages.begin(); it != batch->m_messages.end(); ++it)
+        {
+            qDebug() << "DSPDeviceSourceEngine::handleAsynchronousMessages: " << (*it)->getIdentifier();
+            result = processSynchronousMessage(**it);
+        }
+
+        m_syncMessenger.doneAsync(batch, result);
+    }
+}
 
-	if (DSPAcquisitionInit::match(*message))
+int DSPDeviceSourceEngine::processSynchronousMessage(Message& message)
+{
+	switch (message.getTypeId())
 	{
+	case MESSAGE_TYPE_ID(DSPAcquisitionInit):
 		m_state = gotoIdle();
 
 		if(m_state == StIdle) {
 			m_state = gotoInit(); // State goes ready if init is performed
 		}
-	}
-	else if (DSPAcquisitionStart::match(*message))
-	{
+
+		break;
+	case MESSAGE_TYPE_ID(DSPAcquisitionStart):
 		if(m_state == StReady) {
 			m_state = gotoRunning();
 		}
-	}
-	else if (DSPAcquisitionStop::match(*message))
-	{
+
+		break;
+	case MESSAGE_TYPE_ID(DSPAcquisitionStop):
 		m_state = gotoIdle();
-	}
-	else if (DSPGetSourceDeviceDescription::match(*message))
+		break;
+	case MESSAGE_TYPE_ID(DSPGetSourceDeviceDescription):
+		((DSPGetSourceDeviceDescription*) &message)->setDeviceDescription(m_deviceDescription);
+		break;
+	case MESSAGE_TYPE_ID(DSPGetErrorMessage):
+		((DSPGetErrorMessage*) &message)->setErrorMessage(m_errorMessage);
+		break;
+	case MESSAGE_TYPE_ID(DSPSetSource):
+		handleSetSource(((DSPSetSource*) &message)->getSampleSource());
+		break;
+	case MESSAGE_TYPE_ID(DSPAddBasebandSampleSink):
 	{
-		((DSPGetSourceDeviceDescription*) message)->setDeviceDescription(m_deviceDescription);
-	}
-	else if (DSPGetErrorMessage::match(*message))
-	{
-		((DSPGetErrorMessage*) message)->setErrorMessage(m_errorMessage);
-	}
-	else if (DSPSetSource::match(*message)) {
-		handleSetSource(((DSPSetSource*) message)->getSampleSource());
-	}
-	else if (DSPAddBasebandSampleSink::match(*message))
-	{
-		BasebandSampleSink* sink = ((DSPAddBasebandSampleSink*) message)->getSampleSink();
+		BasebandSampleSink* sink = ((DSPAddBasebandSampleSink*) &message)->getSampleSink();
 		m_basebandSampleSinks.push_back(sink);
         // initialize sample rate and center frequency in the sink:
         DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
@@ -650,20 +710,23 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
         if(m_state == StRunning) {
             sink->start();
         }
+
+		break;
 	}
-	else if (DSPRemoveBasebandSampleSink::match(*message))
+	case MESSAGE_TYPE_ID(DSPRemoveBasebandSampleSink):
 	{
-		BasebandSampleSink* sink = ((DSPRemoveBasebandSampleSink*) message)->getSampleSink();
+		BasebandSampleSink* sink = ((DSPRemoveBasebandSampleSink*) &message)->getSampleSink();
 
 		if(m_state == StRunning) {
 			sink->stop();
 		}
 
 		m_basebandSampleSinks.remove(sink);
+		break;
 	}
-	else if (DSPAddThreadedBasebandSampleSink::match(*message))
+	case MESSAGE_TYPE_ID(DSPAddThreadedBasebandSampleSink):
 	{
-		ThreadedBasebandSampleSink *threadedSink = ((DSPAddThreadedBasebandSampleSink*) message)->getThreadedSampleSink();
+		ThreadedBasebandSampleSink *threadedSink = ((DSPAddThreadedBasebandSampleSink*) &message)->getThreadedSampleSink();
 		m_threadedBasebandSampleSinks.push_back(threadedSink);
 		// initialize sample rate and center frequency in the sink:
 		DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
@@ -672,15 +735,21 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
         if(m_state == StRunning) {
             threadedSink->start();
         }
+
+		break;
 	}
-	else if (DSPRemoveThreadedBasebandSampleSink::match(*message))
+	case MESSAGE_TYPE_ID(DSPRemoveThreadedBasebandSampleSink):
 	{
-		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedBasebandSampleSink*) message)->getThreadedSampleSink();
+		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedBasebandSampleSink*) &message)->getThreadedSampleSink();
 		threadedSink->stop();
 		m_threadedBasebandSampleSinks.remove(threadedSink);
+		break;
+	}
+	default:
+		break;
 	}
 
-	m_syncMessenger.done(m_state);
+	return m_state;
 }
 
 void DSPDeviceSourceEngine::handleInputMessages()
@@ -23,6 +23,7 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QAtomicInt>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
 #include "util/messagequeue.h"
@@ -60,14 +61,18 @@ public:
 	bool startAcquisition(); //!< Start acquisition sequence
 	void stopAcquistion();   //!< Stop acquisition sequence
 
+	std::future<int> initAcquisitionAsync(const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Initialize acquisition sequence without waiting. Result is the engine state.
+	std::future<int> startAcquisitionAsync(const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Start acquisition sequence without waiting. Result is the engine state.
+	std::future<int> sendCommands(const std::vector<Message*>& commands, const SyncMessenger::Completion& completion = SyncMessenger::Completion()); //!< Process engine commands (taking ownership) in one go without waiting
+
 	void setSource(DeviceSampleSource* source); //!< Set the sample source type
 	void setSourceSequence(int sequence); //!< Set the sample source sequence in type
 	DeviceSampleSource *getSource() { return m_deviceSampleSource; }
 
-	void addSink(BasebandSampleSink* sink); //!< Add a sample sink
+	void addSink(BasebandSampleSink* sink); //!< Add a sample sink. Does not wait for completion.
 	void removeSink(BasebandSampleSink* sink); //!< Remove a sample sink
 
-	void addThreadedSink(ThreadedBasebandSampleSink* sink); //!< Add a sample sink that will run on its own thread
+	void addThreadedSink(ThreadedBasebandSampleSink* sink); //!< Add a sample sink that will run on its own thread. Does not wait for completion.
 	void removeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Remove a sample sink that runs on its own thread
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
@@ -76,6 +81,8 @@ public:
 
 	QString errorMessage(); //!< Return the current error message
 	QString sourceDeviceDescription(); //!< Return the source device description
+	int getChannelBacklog() const { return m_channelBacklog.load(); } //!< Highest fill of the channel sinks FIFOs in per mille. Can be read from any thread.
+	int getChannelFreeSpace() const { return m_channelFreeSpace.load(); } //!< Smallest free space of the channel sinks FIFOs in samples or -1 if there is no channel. Can be read from any thread.
 
 private:
 	uint m_uid; //!< unique ID
@@ -99,6 +106,8 @@ private:
 
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
+	QAtomicInt m_channelBacklog; //!< highest fill of the threaded sinks FIFOs after the last work in per mille
+	QAtomicInt m_channelFreeSpace; //!< smallest free space of the threaded sinks FIFOs after the last work in samples
 
 	bool m_dcOffsetCorrection;
 	bool m_iqImbalanceCorrection;
@@ -143,11 +152,13 @@ private:
 	State gotoError(const QString& errorMsg); //!< Go to an error state
 
 	void handleSetSource(DeviceSampleSource* source); //!< Manage source setting
+	int processSynchronousMessage(Message& message); //!< Process an engine command and return the engine state
 
 private slots:
 	void handleData(); //!< Handle data when samples from source FIFO are ready to be processed
 	void handleInputMessages(); //!< Handle input message queue
 	void handleSynchronousMessages(); //!< Handle synchronous messages with the thread
+	void handleAsynchronousMessages(); //!< Handle messages sent asynchronously to the thread
 };
 
 #endif // INCLUDE_DSPDEVICEENGINE_H
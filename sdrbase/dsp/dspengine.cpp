@@ -174,7 +174,7 @@ void DSPEngine::getDVSerialNames(std::vector<std::string>& deviceNames)
     }
 }
 
-void DSPEngine::pushMbeFrame(
+bool DSPEngine::pushMbeFrame(
         const unsigned char *mbeFrame,
         int mbeRateIndex,
         int mbeVolumeIndex,
@@ -183,5 +183,5 @@ void DSPEngine::pushMbeFrame(
         int upsampling,
         AudioFifo *audioFifo)
 {
-    m_ambeEngine.pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo);
+    return m_ambeEngine.pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo);
 }
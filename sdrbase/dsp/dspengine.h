@@ -72,7 +72,7 @@ public:
 	bool hasDVSerialSupport();
 	void setDVSerialSupport(bool support);
 	void getDVSerialNames(std::vector<std::string>& deviceNames);
-	void pushMbeFrame(
+	bool pushMbeFrame( //!< false if no AMBE device took the frame
 	        const unsigned char *mbeFrame,
 	        int mbeRateIndex,
 	        int mbeVolumeIndex,
@@ -26,15 +26,21 @@
 #include "util/message.h"
 
 #include "filerecord.h"
+#include "filerecordwriter.h"
+#include "sigmfrecord.h"
+
+Preferences FileRecord::m_recordingPreferences;
+QMutex FileRecord::m_recordingPreferencesMutex;
 
 FileRecord::FileRecord() :
 	BasebandSampleSink(),
     m_fileName("test.sdriq"),
     m_sampleRate(0),
     m_centerFrequency(0),
-	m_recordOn(false),
+	m_recordOn(0),
     m_recordStart(false),
-    m_byteCount(0)
+    m_byteCount(0),
+    m_writer(new FileRecordWriter())
 {
 	setObjectName("FileSink");
 }
@@ -44,9 +50,10 @@ FileRecord::FileRecord(const QString& filename) :
     m_fileName(filename),
     m_sampleRate(0),
     m_centerFrequency(0),
-    m_recordOn(false),
+    m_recordOn(0),
     m_recordStart(false),
-    m_byteCount(0)
+    m_byteCount(0),
+    m_writer(new FileRecordWriter())
 {
     setObjectName("FileRecord");
 }
@@ -54,22 +61,35 @@ FileRecord::FileRecord(const QString& filename) :
 FileRecord::~FileRecord()
 {
     stopRecording();
+    delete m_writer;
 }
 
 void FileRecord::setFileName(const QString& filename)
 {
-    if (!m_recordOn)
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_recordOn.loadAcquire())
     {
         m_fileName = filename;
     }
 }
 
+QString FileRecord::getFileName() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_fileName;
+}
+
 void FileRecord::genUniqueFileName(uint deviceUID, int istream)
 {
+    m_recordingPreferencesMutex.lock();
+    QString extension = m_recordingPreferences.getRecordSigMF() ? "sigmf-data" : "sdriq";
+    m_recordingPreferencesMutex.unlock();
+
     if (istream < 0) {
-        setFileName(QString("rec%1_%2.sdriq").arg(deviceUID).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")));
+        setFileName(QString("rec%1_%2.%3").arg(deviceUID).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")).arg(extension));
     } else {
-        setFileName(QString("rec%1_%2_%3.sdriq").arg(deviceUID).arg(istream).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")));
+        setFileName(QString("rec%1_%2_%3.%4").arg(deviceUID).arg(istream).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")).arg(extension));
     }
 }
 
@@ -77,18 +97,33 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
 {
     (void) positiveOnly;
     // if no recording is active, send the samples to /dev/null
-    if(!m_recordOn)
+    if(!m_recordOn.loadAcquire())
         return;
 
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_recordOn.loadAcquire()) { // stopped meanwhile
+        return;
+    }
+
     if (begin < end) // if there is something to put out
     {
         if (m_recordStart)
         {
-            writeHeader();
+            // header is known at the first samples
+            Header header;
+            header.sampleRate = m_sampleRate;
+            header.centerFrequency = m_centerFrequency;
+            header.startTimeStamp = time(0);
+            header.sampleSize = SDR_RX_SAMP_SZ;
+            header.filler = 0;
+            header.crc32 = 0;
+            m_writer->setSigMF(SigMFRecord::isSigMF(m_fileName));
+            m_writer->startSession(m_fileName, header);
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+        m_writer->write(reinterpret_cast<const quint8*>(&*(begin)), (end - begin)*sizeof(Sample));
         m_byteCount += end - begin;
     }
 }
@@ -104,32 +139,97 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_recordOn.loadAcquire())
     {
     	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
-        m_recordOn = true;
+        applyRecordingPreferences();
         m_recordStart = true;
         m_byteCount = 0;
+        m_recordOn.storeRelease(1);
     }
 }
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    m_mutex.lock();
+
+    if (m_recordOn.loadAcquire())
     {
     	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
-        m_recordOn = false;
+        m_recordOn.storeRelease(0);
         m_recordStart = false;
+        m_mutex.unlock();
+        // the DSP thread does not write any more: the pending samples are flushed without holding it
+        m_writer->stopSession();
+    }
+    else
+    {
+        m_mutex.unlock();
     }
 }
 
+float FileRecord::getWriteBandwidth()
+{
+    Stats stats;
+    m_writer->getStats(stats);
+    return stats.m_bandwidth;
+}
+
+float FileRecord::getBufferHeadroom()
+{
+    Stats stats;
+    m_writer->getStats(stats);
+    return stats.m_headroom;
+}
+
+quint64 FileRecord::getDroppedBytes()
+{
+    Stats stats;
+    m_writer->getStats(stats);
+    return stats.m_droppedBytes;
+}
+
+void FileRecord::getStats(Stats& stats)
+{
+    m_writer->getStats(stats);
+}
+
+void FileRecord::setRecordingPreferences(const Preferences& preferences)
+{
+    QMutexLocker mutexLocker(&m_recordingPreferencesMutex);
+    m_recordingPreferences = preferences;
+}
+
+void FileRecord::applyRecordingPreferences()
+{
+    QMutexLocker mutexLocker(&m_recordingPreferencesMutex);
+    m_writer->setBufferPool(m_recordingPreferences.getRecordNbBuffers(), m_recordingPreferences.getRecordBufferSize() * 1024);
+    m_writer->setDirectIO(m_recordingPreferences.getRecordDirectIO());
+    m_writer->setPreallocation(((quint64) m_recordingPreferences.getRecordPreallocation()) * 1024 * 1024);
+    m_writer->setRotation(((quint64) m_recordingPreferences.getRecordMaxFileSize()) * 1024 * 1024, m_recordingPreferences.getRecordMaxFileSeconds());
+    m_writer->setSigMFStorage(m_recordingPreferences.getRecordSigMFPackingBits(), m_recordingPreferences.getRecordSigMFCompressed());
+}
+
 bool FileRecord::handleMessage(const Message& message)
 {
 	if (DSPSignalNotification::match(message))
 	{
 		DSPSignalNotification& notif = (DSPSignalNotification&) message;
+        QMutexLocker mutexLocker(&m_mutex);
+
+        if (m_recordOn.loadAcquire() && !m_recordStart) // changes while recording are kept in the SigMF metadata
+        {
+            if (notif.getCenterFrequency() != (qint64) m_centerFrequency) {
+                m_writer->addCapture(m_byteCount, notif.getCenterFrequency());
+            }
+
+            if (notif.getSampleRate() != (int) m_sampleRate) {
+                m_writer->addAnnotation(m_byteCount, QString("sample rate changed to %1 S/s").arg(notif.getSampleRate()));
+            }
+        }
+
 		m_sampleRate = notif.getSampleRate();
 		m_centerFrequency = notif.getCenterFrequency();
 		qDebug() << "FileRecord::handleMessage: DSPSignalNotification: m_inputSampleRate: " << m_sampleRate
@@ -152,18 +252,7 @@ void FileRecord::handleConfigure(const QString& fileName)
 	m_fileName = fileName;
 }
 
-void FileRecord::writeHeader()
-{
-    Header header;
-    header.sampleRate = m_sampleRate;
-    header.centerFrequency = m_centerFrequency;
-    std::time_t ts = time(0);
-    header.startTimeStamp = ts;
-    header.sampleSize = SDR_RX_SAMP_SZ;
-    header.filler = 0;
 
-    writeHeader(m_sampleFile, header);
-}
 
 bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
 {
@@ -24,9 +24,15 @@
 #include <fstream>
 
 #include <ctime>
+
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "settings/preferences.h"
 #include "export.h"
 
 class Message;
+class FileRecordWriter;
 
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
@@ -43,14 +49,38 @@ public:
     };
 #pragma pack(pop)
 
+    struct Stats
+    {
+        float m_bandwidth;       //!< bytes per second written over the last second
+        float m_headroom;        //!< ratio of free buffers in the pool
+        quint64 m_bytesWritten;  //!< since recording start
+        quint64 m_droppedBytes;  //!< samples dropped because no buffer was free
+        int m_nbFiles;           //!< files opened since recording start (rotation)
+
+        Stats() :
+            m_bandwidth(0.0f),
+            m_headroom(1.0f),
+            m_bytesWritten(0),
+            m_droppedBytes(0),
+            m_nbFiles(0)
+        {}
+    };
+
 	FileRecord();
     FileRecord(const QString& filename);
 	virtual ~FileRecord();
 
     quint64 getByteCount() const { return m_byteCount; }
 
+    static void setRecordingPreferences(const Preferences& preferences); //!< Writer settings of the recordings started afterwards
+    float getWriteBandwidth(); //!< Bytes per second written to disk over the last second
+    float getBufferHeadroom(); //!< Ratio of free buffers in the pool (0 to 1)
+    quint64 getDroppedBytes(); //!< Bytes lost since recording start because the disk did not keep up
+    void getStats(Stats& stats); //!< Statistics of the current or last recording
+
     void setFileName(const QString& filename);
-    void genUniqueFileName(uint deviceUID, int istream = -1);
+    QString getFileName() const;
+    void genUniqueFileName(uint deviceUID, int istream = -1); //!< SigMF or .sdriq extension from the recording preferences
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
 	virtual void start();
@@ -58,7 +88,7 @@ public:
 	virtual bool handleMessage(const Message& message);
     void startRecording();
     void stopRecording();
-    bool isRecording() const { return m_recordOn; }
+    bool isRecording() const { return m_recordOn.loadAcquire() != 0; }
     static bool readHeader(std::ifstream& samplefile, Header& header); //!< returns true if CRC checksum is correct else false
     static void writeHeader(std::ofstream& samplefile, Header& header);
 
@@ -66,13 +96,16 @@ private:
 	QString m_fileName;
 	quint32 m_sampleRate;
 	quint64 m_centerFrequency;
-	bool m_recordOn;
+	QAtomicInt m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
+    mutable QMutex m_mutex; //!< the DSP thread feeds the writer under this lock so that recording stops are not concurrent with the writes
     quint64 m_byteCount;
+    FileRecordWriter *m_writer; //!< writes the samples to disk in its own thread
+    static Preferences m_recordingPreferences;
+    static QMutex m_recordingPreferencesMutex;
 
 	void handleConfigure(const QString& fileName);
-    void writeHeader();
+    void applyRecordingPreferences();
 };
 
 #endif // INCLUDE_FILERECORD_H
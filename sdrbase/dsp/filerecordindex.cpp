@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Sidecar index of a .sdriq record. The record is cut in blocks of a fixed      //
+// number of samples and for each block the index gives the byte offset, the     //
+// timestamp and the mean and peak power. It allows to locate a timestamp or     //
+// an event in the record without reading the samples.                           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#include <QFile>
+#include <QDebug>
+
+#include "filerecordindex.h"
+
+static const char indexMagic[8] = {'S', 'D', 'R', 'I', 'Q', 'I', 'D', 'X'};
+static const quint32 indexVersion = 1;
+
+FileRecordIndex::FileRecordIndex() :
+    m_blockSize(0),
+    m_nbSamples(0),
+    m_blockFill(0),
+    m_blockPowerSum(0.0),
+    m_blockPowerPeak(0.0)
+{
+    std::memset(&m_recordHeader, 0, sizeof(FileRecord::Header));
+}
+
+FileRecordIndex::~FileRecordIndex()
+{}
+
+void FileRecordIndex::clear()
+{
+    m_blocks.clear();
+    m_nbSamples = 0;
+    m_blockFill = 0;
+    m_blockPowerSum = 0.0;
+    m_blockPowerPeak = 0.0;
+}
+
+void FileRecordIndex::init(const FileRecord::Header& recordHeader, quint32 blockSize)
+{
+    clear();
+    m_recordHeader = recordHeader;
+    m_blockSize = blockSize == 0 ? 1 : blockSize;
+}
+
+void FileRecordIndex::feed(const quint8 *samples, quint64 nbSamples)
+{
+    if (m_blockSize == 0) {
+        return;
+    }
+
+    if (m_recordHeader.sampleSize == 24)
+    {
+        const qint32 *iq = (const qint32 *) samples;
+        const double scale = 1.0 / (8388608.0 * 8388608.0);
+
+        for (quint64 is = 0; is < nbSamples; is++)
+        {
+            double power = ((double) iq[2*is] * iq[2*is] + (double) iq[2*is+1] * iq[2*is+1]) * scale;
+            m_blockPowerSum += power;
+            m_blockPowerPeak = power > m_blockPowerPeak ? power : m_blockPowerPeak;
+            m_nbSamples++;
+
+            if (++m_blockFill == m_blockSize) {
+                closeBlock();
+            }
+        }
+    }
+    else
+    {
+        const qint16 *iq = (const qint16 *) samples;
+        const double scale = 1.0 / (32768.0 * 32768.0);
+
+        for (quint64 is = 0; is < nbSamples; is++)
+        {
+            double power = ((double) iq[2*is] * iq[2*is] + (double) iq[2*is+1] * iq[2*is+1]) * scale;
+            m_blockPowerSum += power;
+            m_blockPowerPeak = power > m_blockPowerPeak ? power : m_blockPowerPeak;
+            m_nbSamples++;
+
+            if (++m_blockFill == m_blockSize) {
+                closeBlock();
+            }
+        }
+    }
+}
+
+void FileRecordIndex::finish()
+{
+    closeBlock();
+}
+
+void FileRecordIndex::closeBlock()
+{
+    if (m_blockFill == 0) {
+        return;
+    }
+
+    quint64 blockStart = m_nbSamples - m_blockFill;
+    quint32 sampleBytes = m_recordHeader.sampleSize == 24 ? 8 : 4;
+    Block block;
+    block.offset = sizeof(FileRecord::Header) + blockStart * sampleBytes;
+    block.timestamp = m_recordHeader.startTimeStamp * 1000ULL
+        + (m_recordHeader.sampleRate == 0 ? 0 : (blockStart * 1000ULL) / m_recordHeader.sampleRate);
+    block.meanPower = powerDb(m_blockPowerSum / m_blockFill);
+    block.peakPower = powerDb(m_blockPowerPeak);
+    m_blocks.push_back(block);
+
+    m_blockFill = 0;
+    m_blockPowerSum = 0.0;
+    m_blockPowerPeak = 0.0;
+}
+
+float FileRecordIndex::powerDb(double power)
+{
+    return power > 1e-20 ? 10.0 * std::log10(power) : -200.0f;
+}
+
+bool FileRecordIndex::write(const QString& indexFileName) const
+{
+    QFile file(indexFileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("FileRecordIndex::write: cannot open %s", qPrintable(indexFileName));
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    header.version = indexVersion;
+    header.blockSize = m_blockSize;
+    header.nbBlocks = m_blocks.size();
+    header.recordSize = sizeof(FileRecord::Header) + m_nbSamples * (m_recordHeader.sampleSize == 24 ? 8 : 4);
+    header.recordCrc32 = m_recordHeader.crc32;
+    header.filler = 0;
+
+    qint64 blocksBytes = m_blocks.size() * sizeof(Block);
+    bool ok = file.write((const char *) &header, sizeof(Header)) == sizeof(Header);
+    ok = ok && ((m_blocks.size() == 0) || (file.write((const char *) m_blocks.data(), blocksBytes) == blocksBytes));
+
+    if (!ok) {
+        qWarning("FileRecordIndex::write: error writing %s", qPrintable(indexFileName));
+    }
+
+    return ok;
+}
+
+bool FileRecordIndex::read(const QString& indexFileName, const FileRecord::Header& recordHeader, quint64 recordSize)
+{
+    clear();
+    QFile file(indexFileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    Header header;
+
+    if ((file.read((char *) &header, sizeof(Header)) != sizeof(Header))
+        || (std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0)
+        || (header.version != indexVersion))
+    {
+        qWarning("FileRecordIndex::read: %s is not a record index", qPrintable(indexFileName));
+        return false;
+    }
+
+    if ((header.recordSize != recordSize) || (header.recordCrc32 != recordHeader.crc32))
+    {
+        qWarning("FileRecordIndex::read: %s does not match the record", qPrintable(indexFileName));
+        return false;
+    }
+
+    if ((quint64) file.size() != sizeof(Header) + header.nbBlocks * sizeof(Block))
+    {
+        qWarning("FileRecordIndex::read: %s is truncated", qPrintable(indexFileName));
+        return false;
+    }
+
+    m_blocks.resize(header.nbBlocks);
+    qint64 blocksBytes = header.nbBlocks * sizeof(Block);
+
+    if ((header.nbBlocks != 0) && (file.read((char *) m_blocks.data(), blocksBytes) != blocksBytes))
+    {
+        m_blocks.clear();
+        return false;
+    }
+
+    m_recordHeader = recordHeader;
+    m_blockSize = header.blockSize;
+    m_nbSamples = (recordSize - sizeof(FileRecord::Header)) / (recordHeader.sampleSize == 24 ? 8 : 4);
+    qDebug("FileRecordIndex::read: %s: %u blocks of %u samples", qPrintable(indexFileName), getNbBlocks(), m_blockSize);
+
+    return true;
+}
+
+int FileRecordIndex::findBlock(quint64 timestamp) const
+{
+    if (m_blocks.empty() || (timestamp < m_blocks.front().timestamp)) {
+        return -1;
+    }
+
+    // first block starting after the timestamp then step back
+    int lo = 0;
+    int hi = m_blocks.size();
+
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+
+        if (m_blocks[mid].timestamp <= timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo - 1;
+}
+
+int FileRecordIndex::findEvent(float peakPowerDb, unsigned int fromBlock) const
+{
+    for (unsigned int i = fromBlock; i < m_blocks.size(); i++)
+    {
+        if (m_blocks[i].peakPower >= peakPowerDb) {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Sidecar index of a .sdriq record. The record is cut in blocks of a fixed      //
+// number of samples and for each block the index gives the byte offset, the     //
+// timestamp and the mean and peak power. It allows to locate a timestamp or     //
+// an event in the record without reading the samples.                           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDINDEX_H_
+#define SDRBASE_DSP_FILERECORDINDEX_H_
+
+#include <vector>
+
+#include <QString>
+
+#include "dsp/filerecord.h"
+#include "export.h"
+
+class SDRBASE_API FileRecordIndex
+{
+public:
+#pragma pack(push, 1)
+    struct Header
+    {
+        char magic[8];        //!< "SDRIQIDX"
+        quint32 version;
+        quint32 blockSize;    //!< number of I/Q samples per block
+        quint64 nbBlocks;
+        quint64 recordSize;   //!< size in bytes of the indexed record file
+        quint32 recordCrc32;  //!< CRC32 of the indexed record header
+        quint32 filler;
+    };
+
+    struct Block
+    {
+        quint64 offset;       //!< byte offset of the first sample of the block in the record file
+        quint64 timestamp;    //!< time of the first sample of the block in ms since epoch
+        float meanPower;      //!< mean power in dB relative to full scale
+        float peakPower;      //!< highest sample power in dB relative to full scale
+    };
+#pragma pack(pop)
+
+    FileRecordIndex();
+    ~FileRecordIndex();
+
+    void init(const FileRecord::Header& recordHeader, quint32 blockSize); //!< Start a new index
+    void feed(const quint8 *samples, quint64 nbSamples); //!< Account for samples in the record sample format
+    void finish(); //!< Close the last partial block
+    bool write(const QString& indexFileName) const;
+    bool read(const QString& indexFileName, const FileRecord::Header& recordHeader, quint64 recordSize); //!< false if absent or not matching the record
+    void clear();
+
+    static QString getIndexFileName(const QString& recordFileName) { return recordFileName + ".idx"; }
+
+    quint32 getBlockSize() const { return m_blockSize; }
+    unsigned int getNbBlocks() const { return m_blocks.size(); }
+    const Block& getBlock(unsigned int blockIndex) const { return m_blocks[blockIndex]; }
+    int findBlock(quint64 timestamp) const; //!< Block containing the timestamp in ms or -1
+    int findEvent(float peakPowerDb, unsigned int fromBlock = 0) const; //!< First block from fromBlock with a peak at or above the threshold or -1
+
+private:
+    FileRecord::Header m_recordHeader;
+    quint32 m_blockSize;
+    std::vector<Block> m_blocks;
+    quint64 m_nbSamples;       //!< samples accounted for so far
+    quint32 m_blockFill;       //!< samples in the current block
+    double m_blockPowerSum;    //!< sum of normalized powers of the current block
+    double m_blockPowerPeak;   //!< peak normalized power of the current block
+
+    void closeBlock();
+    static float powerDb(double power);
+};
+
+#endif /* SDRBASE_DSP_FILERECORDINDEX_H_ */
@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Memory mapped reader of .sdriq records. The file is mapped by windows so that //
+// records larger than the address space can be read. Samples are returned in   //
+// place from the mapping and the pages ahead of the read position are           //
+// prefetched. Seeking to a sample or a timestamp is immediate.                  //
+//                                                                               //
+// SigMF records are read the same way when stored raw. Chunked SigMF records    //
+// are decoded by a worker thread.                                               //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/crc.hpp>
+#include <boost/cstdint.hpp>
+
+#include <QtGlobal>
+#include <QFileInfo>
+#include <QDebug>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "filerecordreader.h"
+
+// a window spans a large part of the address space on 64 bit systems and stays small on 32 bit systems
+static const quint64 windowSize = sizeof(void*) == 8 ? (1ULL<<30) : (1ULL<<25);
+static const quint64 prefetchSize = 1ULL<<23; //!< bytes requested ahead of the read position
+
+FileRecordReader::FileRecordReader() :
+    m_headerCRCOK(false),
+    m_sampleBytes(4),
+    m_dataOffset(sizeof(FileRecord::Header)),
+    m_fileSize(0),
+    m_nbSamples(0),
+    m_samplePosition(0),
+    m_window(nullptr),
+    m_windowOffset(0),
+    m_windowSize(0),
+    m_prefetched(0),
+    m_sigMF(false)
+{}
+
+FileRecordReader::~FileRecordReader()
+{
+    close();
+}
+
+bool FileRecordReader::open(const QString& fileName)
+{
+    close();
+
+    if (SigMFRecord::isSigMF(fileName)) {
+        return openSigMF(fileName);
+    }
+
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qWarning("FileRecordReader::open: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    m_fileSize = m_file.size();
+
+    if ((m_fileSize <= sizeof(FileRecord::Header))
+        || (m_file.read((char *) &m_header, sizeof(FileRecord::Header)) != sizeof(FileRecord::Header)))
+    {
+        qWarning("FileRecordReader::open: %s has no complete header", qPrintable(fileName));
+        m_file.close();
+        return false;
+    }
+
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&m_header, 28);
+    m_headerCRCOK = m_header.crc32 == crc32.checksum();
+    m_sampleBytes = m_header.sampleSize == 24 ? 8 : 4;
+    m_dataOffset = sizeof(FileRecord::Header);
+    m_nbSamples = (m_fileSize - m_dataOffset) / m_sampleBytes;
+    seekSample(0);
+
+    return true;
+}
+
+bool FileRecordReader::openSigMF(const QString& fileName)
+{
+    if (!SigMFRecord::readMeta(fileName, m_meta)) {
+        return false;
+    }
+
+    QString dataFileName = SigMFRecord::getDataFileName(fileName);
+    m_header.sampleRate = m_meta.m_sampleRate;
+    m_header.centerFrequency = m_meta.m_captures.size() == 0 ? 0 : m_meta.m_captures[0].m_frequency;
+    m_header.startTimeStamp = m_meta.m_captures.size() == 0 ? 0 : m_meta.m_captures[0].m_timestamp / 1000;
+    m_header.sampleSize = m_meta.m_sampleSize;
+    m_header.filler = 0;
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&m_header, 28);
+    m_header.crc32 = crc32.checksum();
+    m_headerCRCOK = true; // the metadata has been validated
+    m_sampleBytes = m_meta.m_sampleSize == 24 ? 8 : 4;
+    m_dataOffset = 0;
+
+    if (m_meta.m_chunked)
+    {
+        if (!m_chunkDecoder.open(dataFileName, m_meta)) {
+            return false;
+        }
+
+        m_fileSize = QFileInfo(dataFileName).size();
+        m_nbSamples = m_chunkDecoder.getNbSamples();
+    }
+    else
+    {
+        m_file.setFileName(dataFileName);
+
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            qWarning("FileRecordReader::openSigMF: cannot open %s", qPrintable(dataFileName));
+            return false;
+        }
+
+        m_fileSize = m_file.size();
+        m_nbSamples = m_fileSize / m_sampleBytes;
+    }
+
+    m_sigMF = true;
+    seekSample(0);
+    qDebug("FileRecordReader::openSigMF: %s: %u captures %u annotations%s", qPrintable(dataFileName),
+        (unsigned int) m_meta.m_captures.size(), (unsigned int) m_meta.m_annotations.size(), m_meta.m_chunked ? " chunked" : "");
+
+    return true;
+}
+
+void FileRecordReader::close()
+{
+    unmapWindow();
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    m_chunkDecoder.close();
+    m_sigMF = false;
+    m_index.clear();
+    m_fileSize = 0;
+    m_nbSamples = 0;
+    m_samplePosition = 0;
+}
+
+void FileRecordReader::seekSample(quint64 sampleIndex)
+{
+    m_samplePosition = sampleIndex > m_nbSamples ? m_nbSamples : sampleIndex;
+    m_prefetched = 0; // restart prefetching from the new position
+}
+
+void FileRecordReader::seekTimestamp(quint64 timestamp)
+{
+    quint64 start = m_header.startTimeStamp * 1000ULL;
+
+    if ((timestamp <= start) || (m_header.sampleRate == 0)) {
+        seekSample(0);
+    } else {
+        seekSample(((timestamp - start) * m_header.sampleRate) / 1000ULL);
+    }
+}
+
+const quint8 *FileRecordReader::readSamples(quint64 nbSamples, quint64& nbRead)
+{
+    nbRead = 0;
+
+    if (!isOpen() || atEnd()) {
+        return nullptr;
+    }
+
+    if (m_chunkDecoder.isOpen()) {
+        return readChunkSamples(nbSamples, nbRead);
+    }
+
+    quint64 offset = m_dataOffset + m_samplePosition * m_sampleBytes;
+
+    if (!m_window || (offset < m_windowOffset) || (offset + m_sampleBytes > m_windowOffset + m_windowSize))
+    {
+        if (!mapWindow(offset)) {
+            return nullptr;
+        }
+    }
+
+    quint64 available = (m_windowOffset + m_windowSize - offset) / m_sampleBytes;
+    nbRead = nbSamples < available ? nbSamples : available;
+    nbRead = nbRead < m_nbSamples - m_samplePosition ? nbRead : m_nbSamples - m_samplePosition;
+    m_samplePosition += nbRead;
+    prefetch(offset + nbRead * m_sampleBytes);
+
+    return m_window + (offset - m_windowOffset);
+}
+
+const quint8 *FileRecordReader::readChunkSamples(quint64 nbSamples, quint64& nbRead)
+{
+    int chunkIndex = m_chunkDecoder.findChunk(m_samplePosition);
+
+    if (chunkIndex < 0) {
+        return nullptr;
+    }
+
+    const quint8 *samples = m_chunkDecoder.getSamples(chunkIndex);
+
+    if (!samples) {
+        return nullptr;
+    }
+
+    const SigMFChunkDecoder::Chunk& chunk = m_chunkDecoder.getChunk(chunkIndex);
+    quint64 chunkPosition = m_samplePosition - chunk.m_sampleStart;
+    quint64 available = chunk.m_nbSamples - chunkPosition;
+    nbRead = nbSamples < available ? nbSamples : available;
+    m_samplePosition += nbRead;
+
+    return samples + chunkPosition * m_sampleBytes;
+}
+
+bool FileRecordReader::mapWindow(quint64 offset)
+{
+    unmapWindow();
+    // the mapping starts on a sample boundary so that the window end falls on a sample boundary too
+    quint64 size = m_fileSize - offset < windowSize ? m_fileSize - offset : windowSize;
+    size -= size % m_sampleBytes;
+
+    if (size == 0) {
+        return false;
+    }
+
+    m_window = m_file.map(offset, size);
+
+    if (!m_window)
+    {
+        qCritical("FileRecordReader::mapWindow: cannot map %llu bytes at %llu: %s", size, offset, qPrintable(m_file.errorString()));
+        return false;
+    }
+
+    m_windowOffset = offset;
+    m_windowSize = size;
+    m_prefetched = 0;
+
+#if defined(Q_OS_UNIX)
+    // Qt maps from the page boundary below the requested offset
+    long pageSize = sysconf(_SC_PAGESIZE);
+    quintptr start = ((quintptr) m_window) & ~((quintptr) pageSize - 1);
+    posix_madvise((void *) start, size + ((quintptr) m_window - start), POSIX_MADV_SEQUENTIAL);
+#endif
+
+    return true;
+}
+
+void FileRecordReader::unmapWindow()
+{
+    if (m_window)
+    {
+        m_file.unmap(m_window);
+        m_window = nullptr;
+        m_windowSize = 0;
+    }
+}
+
+void FileRecordReader::prefetch(quint64 offset)
+{
+#if defined(Q_OS_UNIX)
+    // keep the pages of the next prefetchSize bytes requested ahead of the read position
+    if (offset + prefetchSize / 2 < m_prefetched) {
+        return;
+    }
+
+    quint64 windowEnd = m_windowOffset + m_windowSize;
+    quint64 start = offset > m_prefetched ? offset : m_prefetched;
+    quint64 end = offset + prefetchSize < windowEnd ? offset + prefetchSize : windowEnd;
+
+    if (start < end)
+    {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        quintptr address = (quintptr) (m_window + (start - m_windowOffset));
+        quintptr alignedAddress = address & ~((quintptr) pageSize - 1);
+        posix_madvise((void *) alignedAddress, end - start + (address - alignedAddress), POSIX_MADV_WILLNEED);
+    }
+
+    m_prefetched = end;
+#else
+    (void) offset;
+#endif
+}
+
+bool FileRecordReader::loadIndex()
+{
+    if (!m_file.isOpen() || m_sigMF) {
+        return false;
+    }
+
+    return m_index.read(FileRecordIndex::getIndexFileName(m_file.fileName()), m_header, m_fileSize);
+}
+
+bool FileRecordReader::buildIndex(quint32 blockSize)
+{
+    if (!m_file.isOpen() || m_sigMF) {
+        return false;
+    }
+
+    quint64 samplePosition = m_samplePosition;
+    m_index.init(m_header, blockSize);
+    seekSample(0);
+
+    while (!atEnd())
+    {
+        quint64 nbRead;
+        const quint8 *samples = readSamples(blockSize, nbRead);
+
+        if (!samples) {
+            break;
+        }
+
+        m_index.feed(samples, nbRead);
+    }
+
+    m_index.finish();
+    seekSample(samplePosition);
+
+    return m_index.write(FileRecordIndex::getIndexFileName(m_file.fileName()));
+}
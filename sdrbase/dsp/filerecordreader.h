@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Memory mapped reader of .sdriq records. The file is mapped by windows so that //
+// records larger than the address space can be read. Samples are returned in   //
+// place from the mapping and the pages ahead of the read position are           //
+// prefetched. Seeking to a sample or a timestamp is immediate.                  //
+//                                                                               //
+// SigMF records are read the same way when stored raw. Chunked SigMF records    //
+// are decoded by a worker thread.                                               //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDREADER_H_
+#define SDRBASE_DSP_FILERECORDREADER_H_
+
+#include <QFile>
+#include <QString>
+
+#include "dsp/filerecord.h"
+#include "dsp/filerecordindex.h"
+#include "dsp/sigmfrecord.h"
+#include "dsp/sigmfchunkdecoder.h"
+#include "export.h"
+
+class SDRBASE_API FileRecordReader
+{
+public:
+    FileRecordReader();
+    ~FileRecordReader();
+
+    bool open(const QString& fileName); //!< false if the file cannot be opened or has no complete header
+    void close();
+    bool isOpen() const { return m_file.isOpen() || m_chunkDecoder.isOpen(); }
+
+    const FileRecord::Header& getHeader() const { return m_header; } //!< Made up from the metadata for SigMF records
+    bool isSigMF() const { return m_sigMF; }
+    const SigMFRecord::Meta& getSigMFMeta() const { return m_meta; }
+    bool isHeaderCRCOK() const { return m_headerCRCOK; }
+    quint32 getSampleBytes() const { return m_sampleBytes; } //!< bytes per I/Q sample
+    quint64 getFileSize() const { return m_fileSize; }
+    quint64 getNbSamples() const { return m_nbSamples; }
+    quint64 getSamplePosition() const { return m_samplePosition; }
+    bool atEnd() const { return m_samplePosition >= m_nbSamples; }
+
+    void seekSample(quint64 sampleIndex); //!< Clamped to the end of the record
+    void seekTimestamp(quint64 timestamp); //!< Absolute time in ms since epoch
+
+    /**
+     * Read samples in place. The returned pointer is valid until the next call to a read, seek or close method.
+     * Less samples than requested are returned at the end of a mapping window or of the record.
+     */
+    const quint8 *readSamples(quint64 nbSamples, quint64& nbRead);
+
+    bool loadIndex(); //!< Load the sidecar index if it exists and matches the record (.sdriq only)
+    bool buildIndex(quint32 blockSize); //!< Scan the whole record and write the sidecar index (.sdriq only)
+    const FileRecordIndex& getIndex() const { return m_index; }
+
+private:
+    QFile m_file;
+    FileRecord::Header m_header;
+    bool m_headerCRCOK;
+    quint32 m_sampleBytes;
+    quint64 m_dataOffset;    //!< file offset of the first sample
+    quint64 m_fileSize;
+    quint64 m_nbSamples;
+    quint64 m_samplePosition;
+    uchar *m_window;         //!< current mapping
+    quint64 m_windowOffset;  //!< file offset of the current mapping
+    quint64 m_windowSize;
+    quint64 m_prefetched;    //!< file offset up to which the pages have been requested
+    FileRecordIndex m_index;
+    bool m_sigMF;
+    SigMFRecord::Meta m_meta;
+    SigMFChunkDecoder m_chunkDecoder; //!< for chunked SigMF records
+
+    bool openSigMF(const QString& fileName);
+    const quint8 *readChunkSamples(quint64 nbSamples, quint64& nbRead);
+    bool mapWindow(quint64 offset);
+    void unmapWindow();
+    void prefetch(quint64 offset);
+};
+
+#endif /* SDRBASE_DSP_FILERECORDREADER_H_ */
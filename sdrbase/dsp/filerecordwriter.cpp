@@ -0,0 +1,556 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Writer thread of the FileRecord sink. Samples are copied into buffers of a    //
+// pre-allocated pool and written to disk by a dedicated thread so that a slow   //
+// disk never blocks the DSP engine. When no buffer is free the samples are      //
+// dropped and accounted for.                                                    //
+//                                                                               //
+// Samples are written either as a .sdriq record or as a SigMF record. SigMF    //
+// samples can be packed and compressed by chunks in the writer thread.          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include <boost/crc.hpp>
+#include <boost/cstdint.hpp>
+
+#include <QtGlobal>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "filerecordwriter.h"
+
+const unsigned int FileRecordWriter::m_alignment;
+
+FileRecordWriter::FileRecordWriter() :
+    m_currentBuffer(nullptr),
+    m_bufferSize(1<<21),
+    m_stopping(false),
+    m_inSession(0),
+    m_nbBuffers(32),
+    m_directIO(false),
+    m_preallocation(0),
+    m_maxFileSize(0),
+    m_maxFileSeconds(0),
+    m_sigMF(false),
+    m_packingBits(0),
+    m_compressed(false),
+    m_fileDirectIO(false),
+    m_fileBytes(0),
+    m_fileSamples(0),
+    m_sessionSamples(0),
+    m_fileStartSample(0),
+    m_staging(nullptr),
+    m_stagingFill(0),
+    m_bandwidthBytes(0)
+{
+    std::memset(&m_header, 0, sizeof(FileRecord::Header));
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    stopSession();
+    releasePool();
+}
+
+void FileRecordWriter::setBufferPool(unsigned int nbBuffers, unsigned int bufferSize)
+{
+    nbBuffers = nbBuffers < 2 ? 2 : nbBuffers;
+    bufferSize = bufferSize < m_alignment ? m_alignment : bufferSize - (bufferSize % m_alignment);
+
+    if (isInSession() || ((nbBuffers == m_nbBuffers) && (bufferSize == m_bufferSize))) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    releasePool();
+    m_nbBuffers = nbBuffers;
+    m_bufferSize = bufferSize;
+}
+
+void FileRecordWriter::allocatePool()
+{
+    if (m_pool.size() != 0) {
+        return;
+    }
+
+    // the whole pool is allocated upfront so that nothing is allocated while recording
+    m_pool.resize(m_nbBuffers);
+
+    for (unsigned int i = 0; i < m_nbBuffers; i++)
+    {
+        m_pool[i].m_data = (quint8 *) qMallocAligned(m_bufferSize, m_alignment);
+        m_pool[i].m_fill = 0;
+    }
+
+    m_staging = (quint8 *) qMallocAligned(m_bufferSize + m_alignment, m_alignment);
+    qDebug("FileRecordWriter::allocatePool: %u buffers of %u bytes", m_nbBuffers, m_bufferSize);
+}
+
+void FileRecordWriter::releasePool()
+{
+    for (unsigned int i = 0; i < m_pool.size(); i++) {
+        qFreeAligned(m_pool[i].m_data);
+    }
+
+    m_pool.clear();
+    m_freeBuffers.clear();
+    m_fullBuffers.clear();
+    m_currentBuffer = nullptr;
+
+    if (m_staging)
+    {
+        qFreeAligned(m_staging);
+        m_staging = nullptr;
+    }
+}
+
+void FileRecordWriter::startSession(const QString& fileName, const FileRecord::Header& header)
+{
+    if (isInSession()) {
+        stopSession();
+    }
+
+    m_mutex.lock();
+    allocatePool();
+    m_freeBuffers.clear();
+    m_fullBuffers.clear();
+
+    for (unsigned int i = 0; i < m_pool.size(); i++)
+    {
+        m_pool[i].m_fill = 0;
+        m_freeBuffers.push_back(&m_pool[i]);
+    }
+
+    m_currentBuffer = nullptr;
+    m_fileName = fileName;
+    m_header = header;
+    m_sessionSamples = 0;
+    m_stats = FileRecord::Stats();
+    m_meta = SigMFRecord::Meta();
+    m_meta.m_sampleRate = header.sampleRate;
+    m_meta.m_sampleSize = header.sampleSize;
+    m_meta.m_packingBits = m_packingBits;
+    m_meta.m_chunked = (m_packingBits != 0) || m_compressed;
+    m_meta.m_compressed = m_compressed;
+    m_stopping = false;
+    m_mutex.unlock();
+
+    addCapture(0, header.centerFrequency);
+    m_inSession.storeRelease(1);
+    start();
+}
+
+void FileRecordWriter::stopSession()
+{
+    if (!isInSession()) {
+        return;
+    }
+
+    m_mutex.lock();
+
+    if (m_currentBuffer && (m_currentBuffer->m_fill > 0)) {
+        m_fullBuffers.push_back(m_currentBuffer);
+    } else if (m_currentBuffer) {
+        m_freeBuffers.push_back(m_currentBuffer);
+    }
+
+    m_currentBuffer = nullptr;
+    m_stopping = true;
+    m_dataReady.wakeAll();
+    m_mutex.unlock();
+
+    wait();
+    m_inSession.storeRelease(0);
+    qDebug("FileRecordWriter::stopSession: %llu bytes written in %d file(s) %llu bytes dropped",
+        m_stats.m_bytesWritten, m_stats.m_nbFiles, m_stats.m_droppedBytes);
+
+    if (m_stats.m_droppedBytes > 0) {
+        qWarning("FileRecordWriter::stopSession: %s: the disk did not keep up. Consider more or larger buffers in the recording preferences.",
+            qPrintable(m_fileName));
+    }
+}
+
+void FileRecordWriter::write(const quint8 *data, unsigned int size)
+{
+    // the current buffer is held under the mutex so that a stop from another thread
+    // cannot hand it over to the writer thread while it is being filled
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_stopping || !isInSession()) {
+        return;
+    }
+
+    while (size > 0)
+    {
+        if (!m_currentBuffer)
+        {
+            if (m_freeBuffers.size() == 0)
+            {
+                // the disk does not keep up: losing samples is better than stalling acquisition
+                m_stats.m_droppedBytes += size;
+                return;
+            }
+
+            m_currentBuffer = m_freeBuffers.back();
+            m_freeBuffers.pop_back();
+            m_currentBuffer->m_fill = 0;
+        }
+
+        unsigned int chunk = m_bufferSize - m_currentBuffer->m_fill;
+        chunk = size < chunk ? size : chunk;
+        std::memcpy(m_currentBuffer->m_data + m_currentBuffer->m_fill, data, chunk);
+        m_currentBuffer->m_fill += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_currentBuffer->m_fill == m_bufferSize)
+        {
+            m_fullBuffers.push_back(m_currentBuffer);
+            m_dataReady.wakeAll();
+            m_currentBuffer = nullptr;
+        }
+    }
+}
+
+void FileRecordWriter::addCapture(quint64 sampleIndex, quint64 frequency)
+{
+    SigMFRecord::Capture capture;
+    capture.m_sampleStart = sampleIndex;
+    capture.m_frequency = frequency;
+    capture.m_timestamp = m_header.startTimeStamp * 1000ULL
+        + (m_header.sampleRate == 0 ? 0 : (sampleIndex * 1000ULL) / m_header.sampleRate);
+    QMutexLocker mutexLocker(&m_mutex);
+    m_meta.m_captures.push_back(capture);
+}
+
+void FileRecordWriter::addAnnotation(quint64 sampleIndex, const QString& comment)
+{
+    SigMFRecord::Annotation annotation;
+    annotation.m_sampleStart = sampleIndex;
+    annotation.m_sampleCount = 0;
+    annotation.m_comment = comment;
+    QMutexLocker mutexLocker(&m_mutex);
+    m_meta.m_annotations.push_back(annotation);
+}
+
+void FileRecordWriter::getStats(FileRecord::Stats& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats = m_stats;
+    stats.m_headroom = m_pool.size() == 0 ? 1.0f : (float) m_freeBuffers.size() / m_pool.size();
+}
+
+void FileRecordWriter::run()
+{
+    m_bandwidthTimer.start();
+    m_bandwidthBytes = 0;
+
+    if (!openFile()) {
+        qCritical("FileRecordWriter::run: cannot open %s: samples are discarded", qPrintable(m_fileName));
+    }
+
+    while (true)
+    {
+        m_mutex.lock();
+
+        while (m_fullBuffers.empty() && !m_stopping) {
+            m_dataReady.wait(&m_mutex);
+        }
+
+        if (m_fullBuffers.empty()) // and stopping
+        {
+            m_mutex.unlock();
+            break;
+        }
+
+        Buffer *buffer = m_fullBuffers.front();
+        m_fullBuffers.pop_front();
+        m_mutex.unlock();
+
+        writeBuffer(buffer);
+
+        m_mutex.lock();
+        buffer->m_fill = 0;
+        m_freeBuffers.push_back(buffer);
+        m_mutex.unlock();
+    }
+
+    closeFile();
+}
+
+void FileRecordWriter::writeBuffer(Buffer *buffer)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    quint32 sampleBytes = m_header.sampleSize == 24 ? 8 : 4;
+    quint64 nbSamples = buffer->m_fill / sampleBytes;
+    unsigned int nbBytes = buffer->m_fill;
+
+    if (m_sigMF && m_meta.m_chunked)
+    {
+        // one chunk per buffer: packing and compression take place here rather than in the DSP thread
+        m_chunk.clear();
+        SigMFRecord::encodeChunk(buffer->m_data, nbSamples, m_meta, m_chunk);
+        nbBytes = m_chunk.size();
+        writeOut((const quint8 *) m_chunk.constData(), nbBytes);
+    }
+    else
+    {
+        writeOut(buffer->m_data, nbBytes);
+    }
+
+    if (!m_sigMF) {
+        m_index.feed(buffer->m_data, nbSamples);
+    }
+
+    m_fileBytes += nbBytes;
+    m_fileSamples += nbSamples;
+    m_sessionSamples += nbSamples;
+    m_bandwidthBytes += nbBytes;
+
+    qint64 elapsed = m_bandwidthTimer.elapsed();
+
+    m_mutex.lock();
+    m_stats.m_bytesWritten += nbBytes;
+
+    if (elapsed >= 1000)
+    {
+        m_stats.m_bandwidth = (m_bandwidthBytes * 1000.0f) / elapsed;
+        m_bandwidthBytes = 0;
+        m_bandwidthTimer.restart();
+    }
+
+    m_mutex.unlock();
+
+    // rotation takes place on buffer boundaries which are also sample boundaries
+    bool sizeLimit = (m_maxFileSize != 0) && (m_fileBytes >= m_maxFileSize);
+    bool timeLimit = (m_maxFileSeconds != 0) && (m_header.sampleRate != 0) && (m_fileSamples >= (quint64) m_maxFileSeconds * m_header.sampleRate);
+
+    if (sizeLimit || timeLimit)
+    {
+        closeFile();
+        openFile();
+    }
+}
+
+QString FileRecordWriter::getSegmentFileName(int segment) const
+{
+    if (segment == 0) {
+        return m_sigMF ? SigMFRecord::getDataFileName(m_fileName) : m_fileName;
+    }
+
+    QFileInfo fileInfo(m_sigMF ? SigMFRecord::getDataFileName(m_fileName) : m_fileName);
+    QString segmentFileName = QString("%1_%2").arg(fileInfo.completeBaseName()).arg(segment, 3, 10, QChar('0'));
+
+    if (!fileInfo.suffix().isEmpty()) {
+        segmentFileName += "." + fileInfo.suffix();
+    }
+
+    return fileInfo.dir().filePath(segmentFileName);
+}
+
+bool FileRecordWriter::openFile()
+{
+    QString fileName = getSegmentFileName(m_stats.m_nbFiles);
+    m_fileDirectIO = false;
+
+#if defined(Q_OS_LINUX)
+    int fd = -1;
+
+    if (m_directIO)
+    {
+        fd = ::open(fileName.toLocal8Bit().constData(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        m_fileDirectIO = fd >= 0;
+
+        if (fd < 0) {
+            qWarning("FileRecordWriter::openFile: direct I/O not supported for %s", qPrintable(fileName));
+        }
+    }
+
+    if (fd < 0) {
+        fd = ::open(fileName.toLocal8Bit().constData(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if ((fd < 0) || !m_file.open(fd, QIODevice::WriteOnly | QIODevice::Unbuffered, QFileDevice::AutoCloseHandle))
+    {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+
+        return false;
+    }
+
+    if ((m_preallocation != 0) && (posix_fallocate(fd, 0, m_preallocation) != 0)) {
+        qWarning("FileRecordWriter::openFile: cannot preallocate %llu bytes for %s", m_preallocation, qPrintable(fileName));
+    }
+#else
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        return false;
+    }
+
+    if (m_preallocation != 0) {
+        m_file.resize(m_preallocation);
+    }
+#endif
+
+    m_stagingFill = 0;
+    m_fileBytes = 0;
+    m_fileSamples = 0;
+    m_fileStartSample = m_sessionSamples;
+
+    if (!m_sigMF) // SigMF data files have no header
+    {
+        // header of a rotated file gives the time of its first sample
+        FileRecord::Header header = m_header;
+        header.startTimeStamp = m_header.startTimeStamp + (m_header.sampleRate == 0 ? 0 : m_sessionSamples / m_header.sampleRate);
+        header.filler = 0;
+        boost::crc_32_type crc32;
+        crc32.process_bytes(&header, 28);
+        header.crc32 = crc32.checksum();
+
+        writeOut((const quint8 *) &header, sizeof(FileRecord::Header));
+        m_fileBytes = sizeof(FileRecord::Header);
+        m_index.init(header, header.sampleRate < 10 ? 1 : header.sampleRate / 10); // 100 ms blocks
+    }
+
+    m_mutex.lock();
+    m_stats.m_nbFiles++;
+    m_mutex.unlock();
+    qDebug("FileRecordWriter::openFile: %s%s", qPrintable(fileName), m_fileDirectIO ? " (direct I/O)" : "");
+
+    return true;
+}
+
+void FileRecordWriter::closeFile()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if (m_fileDirectIO && (m_stagingFill > 0))
+    {
+        // last write is padded to the alignment then the file is cut to its actual size
+        std::memset(m_staging + m_stagingFill, 0, m_alignment - m_stagingFill);
+        m_file.write((const char *) m_staging, m_alignment);
+        m_stagingFill = 0;
+    }
+
+    if (m_fileDirectIO || (m_preallocation != 0)) {
+        m_file.resize(m_fileBytes);
+    }
+
+    QString fileName = getSegmentFileName(m_stats.m_nbFiles - 1);
+    m_file.close();
+
+    if (m_sigMF)
+    {
+        writeMeta(fileName);
+    }
+    else
+    {
+        m_index.finish();
+        m_index.write(FileRecordIndex::getIndexFileName(fileName));
+        m_index.clear();
+    }
+}
+
+void FileRecordWriter::writeMeta(const QString& fileName)
+{
+    // captures and annotations of the session that fall in this file with sample indexes relative to the file
+    quint64 fileEndSample = m_fileStartSample + m_fileSamples;
+    QMutexLocker mutexLocker(&m_mutex);
+    SigMFRecord::Meta meta = m_meta;
+    meta.m_captures.clear();
+    meta.m_annotations.clear();
+
+    for (unsigned int i = 0; i < m_meta.m_captures.size(); i++)
+    {
+        SigMFRecord::Capture capture = m_meta.m_captures[i];
+
+        if (capture.m_sampleStart >= fileEndSample) {
+            break;
+        }
+
+        if (capture.m_sampleStart <= m_fileStartSample) // capture in effect at the file start
+        {
+            meta.m_captures.clear();
+            capture.m_timestamp += m_header.sampleRate == 0 ? 0 : ((m_fileStartSample - capture.m_sampleStart) * 1000ULL) / m_header.sampleRate;
+            capture.m_sampleStart = 0;
+        }
+        else
+        {
+            capture.m_sampleStart -= m_fileStartSample;
+        }
+
+        meta.m_captures.push_back(capture);
+    }
+
+    for (unsigned int i = 0; i < m_meta.m_annotations.size(); i++)
+    {
+        SigMFRecord::Annotation annotation = m_meta.m_annotations[i];
+
+        if ((annotation.m_sampleStart >= m_fileStartSample) && (annotation.m_sampleStart < fileEndSample))
+        {
+            annotation.m_sampleStart -= m_fileStartSample;
+            meta.m_annotations.push_back(annotation);
+        }
+    }
+
+    mutexLocker.unlock();
+    SigMFRecord::writeMeta(fileName, meta);
+}
+
+void FileRecordWriter::writeOut(const quint8 *data, unsigned int size)
+{
+    if (!m_fileDirectIO)
+    {
+        if (m_file.write((const char *) data, size) != size) {
+            qWarning("FileRecordWriter::writeOut: %s", qPrintable(m_file.errorString()));
+        }
+
+        return;
+    }
+
+    // direct I/O takes aligned sizes from aligned memory: the remainder is carried over to the next write
+    while (size > 0)
+    {
+        unsigned int chunk = m_bufferSize < size ? m_bufferSize : size; // staging holds a buffer and the carry
+        std::memcpy(m_staging + m_stagingFill, data, chunk);
+        unsigned int total = m_stagingFill + chunk;
+        unsigned int aligned = total - (total % m_alignment);
+
+        if ((aligned != 0) && (m_file.write((const char *) m_staging, aligned) != aligned)) {
+            qWarning("FileRecordWriter::writeOut: %s", qPrintable(m_file.errorString()));
+        }
+
+        m_stagingFill = total - aligned;
+        std::memmove(m_staging, m_staging + aligned, m_stagingFill);
+        data += chunk;
+        size -= chunk;
+    }
+}
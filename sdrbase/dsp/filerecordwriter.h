@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Writer thread of the FileRecord sink. Samples are copied into buffers of a    //
+// pre-allocated pool and written to disk by a dedicated thread so that a slow   //
+// disk never blocks the DSP engine. When no buffer is free the samples are      //
+// dropped and accounted for.                                                    //
+//                                                                               //
+// Samples are written either as a .sdriq record or as a SigMF record. SigMF    //
+// samples can be packed and compressed by chunks in the writer thread.          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <vector>
+#include <deque>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QFile>
+#include <QString>
+
+#include "dsp/filerecord.h"
+#include "dsp/filerecordindex.h"
+#include "dsp/sigmfrecord.h"
+#include "export.h"
+
+class SDRBASE_API FileRecordWriter : public QThread
+{
+    Q_OBJECT
+public:
+    FileRecordWriter();
+    ~FileRecordWriter();
+
+    // settings are taken into account at the next session start
+    void setBufferPool(unsigned int nbBuffers, unsigned int bufferSize); //!< bufferSize is rounded to the I/O alignment
+    void setDirectIO(bool directIO) { m_directIO = directIO; } //!< Bypass the page cache where supported (Linux O_DIRECT)
+    void setPreallocation(quint64 preallocation) { m_preallocation = preallocation; } //!< Bytes reserved on disk when a file is opened
+    void setRotation(quint64 maxFileSize, quint32 maxFileSeconds) //!< Start a new file past any non zero limit
+    {
+        m_maxFileSize = maxFileSize;
+        m_maxFileSeconds = maxFileSeconds;
+    }
+    void setSigMF(bool sigMF) { m_sigMF = sigMF; } //!< Write .sigmf-data and .sigmf-meta files instead of .sdriq
+    void setSigMFStorage(quint32 packingBits, bool compressed) //!< Chunked storage if packing bits are non zero or compressed
+    {
+        m_packingBits = packingBits;
+        m_compressed = compressed;
+    }
+
+    void startSession(const QString& fileName, const FileRecord::Header& header); //!< Header CRC is computed by the writer
+    void stopSession(); //!< Flush the pending samples and wait for the writer thread to complete
+    bool isInSession() const { return m_inSession.loadAcquire() != 0; }
+    void write(const quint8 *data, unsigned int size); //!< Called from the DSP thread. Never waits for the disk. Ignored out of session.
+    void addCapture(quint64 sampleIndex, quint64 frequency); //!< SigMF capture segment at a sample index since session start
+    void addAnnotation(quint64 sampleIndex, const QString& comment); //!< SigMF annotation at a sample index since session start
+    void getStats(FileRecord::Stats& stats);
+
+private:
+    struct Buffer
+    {
+        quint8 *m_data;
+        unsigned int m_fill;
+    };
+
+    static const unsigned int m_alignment = 4096;
+
+    // pool shared with the writer thread
+    std::vector<Buffer> m_pool;
+    std::vector<Buffer*> m_freeBuffers;
+    std::deque<Buffer*> m_fullBuffers;
+    Buffer *m_currentBuffer; //!< being filled by the DSP thread under the mutex
+    unsigned int m_bufferSize;
+    QMutex m_mutex;
+    QWaitCondition m_dataReady;
+    bool m_stopping; //!< under the mutex
+    QAtomicInt m_inSession;
+
+    // settings
+    unsigned int m_nbBuffers;
+    bool m_directIO;
+    quint64 m_preallocation;
+    quint64 m_maxFileSize;
+    quint32 m_maxFileSeconds;
+    bool m_sigMF;
+    quint32 m_packingBits;
+    bool m_compressed;
+
+    // writer thread state
+    QString m_fileName;
+    FileRecord::Header m_header;
+    QFile m_file;
+    bool m_fileDirectIO;
+    quint64 m_fileBytes;        //!< bytes of the current file including header
+    quint64 m_fileSamples;      //!< samples written to the current file
+    quint64 m_sessionSamples;   //!< samples written since session start
+    quint64 m_fileStartSample;  //!< session sample of the first sample of the current file
+    SigMFRecord::Meta m_meta;   //!< session captures and annotations are accessed under the mutex
+    QByteArray m_chunk;         //!< encoded chunk of SigMF chunked storage
+    quint8 *m_staging;          //!< aligned copy of the data for direct I/O
+    unsigned int m_stagingFill; //!< bytes left over from the last aligned write
+    FileRecordIndex m_index;
+    QElapsedTimer m_bandwidthTimer;
+    quint64 m_bandwidthBytes;
+    FileRecord::Stats m_stats;  //!< under the mutex
+
+    void allocatePool();
+    void releasePool();
+    void run();
+    bool openFile();
+    void closeFile();
+    QString getSegmentFileName(int segment) const;
+    void writeMeta(const QString& fileName);
+    void writeOut(const quint8 *data, unsigned int size);
+    void writeBuffer(Buffer *buffer);
+};
+
+#endif /* SDRBASE_DSP_FILERECORDWRITER_H_ */
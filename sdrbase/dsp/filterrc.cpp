@@ -56,6 +56,20 @@ void LowPassFilterRC::process(const Real& sample_in, Real& sample_out)
 	sample_out = m_y1;
 }
 
+// Process a block of samples in place.
+void LowPassFilterRC::process(std::vector<Real>& samples)
+{
+    Real y1 = m_y1;
+
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+        y1 = (samples[i] * m_b0) - (y1 * m_a1);
+        samples[i] = y1;
+    }
+
+    m_y1 = y1;
+}
+
 // Construct 1st order high-pass IIR filter.
 HighPassFilterRC::HighPassFilterRC(Real timeconst) :
      m_timeconst(timeconst),
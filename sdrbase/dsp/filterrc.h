@@ -19,6 +19,8 @@
 #ifndef INCLUDE_DSP_FILTERRC_H_
 #define INCLUDE_DSP_FILTERRC_H_
 
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "export.h"
 
@@ -42,6 +44,9 @@ public:
     /** Process samples. */
     void process(const Real& sample_in, Real& sample_out);
 
+    /** Process a block of samples in place. */
+    void process(std::vector<Real>& samples);
+
 private:
     Real m_timeconst;
     Real m_y1;
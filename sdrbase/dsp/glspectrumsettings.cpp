@@ -48,6 +48,8 @@ void GLSpectrumSettings::resetToDefaults()
 	m_averagingMode = AvgModeNone;
 	m_averagingIndex = 0;
 	m_linear = false;
+	m_displayRate = 20;
+	m_accumulationMode = AccumulateMax;
 }
 
 QByteArray GLSpectrumSettings::serialize() const
@@ -75,6 +77,8 @@ QByteArray GLSpectrumSettings::serialize() const
 	s.writeS32(19, (int) m_averagingMode);
 	s.writeS32(20, (qint32) getAveragingValue(m_averagingIndex, m_averagingMode));
 	s.writeBool(21, m_linear);
+	s.writeS32(22, m_displayRate);
+	s.writeS32(23, (int) m_accumulationMode);
 
 	return s.final();
 }
@@ -116,6 +120,10 @@ bool GLSpectrumSettings::deserialize(const QByteArray& data)
 		m_averagingIndex = getAveragingIndex(tmp, m_averagingMode);
 	    m_averagingNb = getAveragingValue(m_averagingIndex, m_averagingMode);
 	    d.readBool(21, &m_linear, false);
+		d.readS32(22, &tmp, 20);
+		m_displayRate = tmp < 1 ? 1 : tmp > 100 ? 100 : tmp;
+		d.readS32(23, &tmp, 0);
+		m_accumulationMode = tmp == 1 ? AccumulateMean : AccumulateMax;
 
 		return true;
 	}
@@ -32,6 +32,12 @@ public:
         AvgModeMax
     };
 
+    enum AccumulationMode
+    {
+        AccumulateMax,
+        AccumulateMean
+    };
+
 	int m_fftSize;
 	int m_fftOverlap;
 	int m_fftWindow;
@@ -55,6 +61,8 @@ public:
 	int m_averagingMaxScale; //!< Max power of 10 multiplier to 2,5,10 base ex: 2 -> 2,5,10,20,50,100,200,500,1000
 	unsigned int m_averagingNb;
 	bool m_linear; //!< linear else logarithmic scale
+	int m_displayRate; //!< spectrum lines rendered per second
+	AccumulationMode m_accumulationMode; //!< how the spectra coming faster than the display rate are combined
 
     GLSpectrumSettings();
 	virtual ~GLSpectrumSettings();
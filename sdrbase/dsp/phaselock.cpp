@@ -47,8 +47,6 @@ PhaseLock::PhaseLock(Real freq, Real bandwidth, Real minsignal)
     m_lock_delay = int(20.0 / bandwidth);
     m_lock_cnt   = 0;
     m_pilot_level = 0;
-    m_psin = 0.0;
-    m_pcos = 1.0;
 
     // Create 2nd order filter for I/Q representation of phase error.
     // Filter has two poles, unit DC gain.
@@ -70,6 +68,14 @@ PhaseLock::PhaseLock(Real freq, Real bandwidth, Real minsignal)
     // Initialize frequency and phase.
     m_freq  = freq * 2.0 * M_PI;
     m_phase = 0;
+    m_psin = 0.0;
+    m_pcos = 1.0;
+    m_phasorCount = 0;
+
+    // Rotation of the locked tone at the center frequency
+    m_centerFreq = m_freq;
+    m_centerSin = sin(m_centerFreq);
+    m_centerCos = cos(m_centerFreq);
 
     m_phasor_i1 = 0;
     m_phasor_i2 = 0;
@@ -130,6 +136,14 @@ void PhaseLock::configure(Real freq, Real bandwidth, Real minsignal)
     // Initialize frequency and phase.
     m_freq  = freq * 2.0 * M_PI;
     m_phase = 0;
+    m_psin = 0.0;
+    m_pcos = 1.0;
+    m_phasorCount = 0;
+
+    // Rotation of the locked tone at the center frequency
+    m_centerFreq = m_freq;
+    m_centerSin = sin(m_centerFreq);
+    m_centerCos = cos(m_centerFreq);
 
     m_phasor_i1 = 0;
     m_phasor_i2 = 0;
@@ -159,9 +173,9 @@ void PhaseLock::process(const std::vector<Real>& samples_in, std::vector<Real>&
 
     for (unsigned int i = 0; i < n; i++) {
 
-        // Generate locked pilot tone.
-        Real psin = sin(m_phase);
-        Real pcos = cos(m_phase);
+        // Locked pilot tone.
+        Real psin = m_psin;
+        Real pcos = m_pcos;
 
         // Generate double-frequency output.
         // sin(2*x) = 2 * sin(x) * cos(x)
@@ -211,9 +225,11 @@ void PhaseLock::process(const std::vector<Real>& samples_in, std::vector<Real>&
 
         // Update locked phase.
         m_phase += m_freq;
+        bool wrapped = false;
         if (m_phase > 2.0 * M_PI) {
             m_phase -= 2.0 * M_PI;
             m_pilot_periods++;
+            wrapped = true;
 
             // Generate pulse-per-second.
             if (m_pilot_periods == pilot_frequency) {
@@ -228,6 +244,7 @@ void PhaseLock::process(const std::vector<Real>& samples_in, std::vector<Real>&
                 }
             }
         }
+        advancePhasor(wrapped);
     }
 
     // Update lock status.
@@ -255,9 +272,7 @@ void PhaseLock::process(const Real& sample_in, Real *samples_out)
 {
     m_pps_events.clear();
 
-	// Generate locked pilot tone.
-	m_psin = sin(m_phase);
-	m_pcos = cos(m_phase);
+	// Locked pilot tone is in m_psin and m_pcos
 
 	// Generate output
 	processPhase(samples_out);
@@ -274,9 +289,7 @@ void PhaseLock::process(const Real& real_in, const Real& imag_in, Real *samples_
 {
     m_pps_events.clear();
 
-    // Generate locked pilot tone.
-    m_psin = sin(m_phase);
-    m_pcos = cos(m_phase);
+    // Locked pilot tone is in m_psin and m_pcos
 
     // Generate output
     processPhase(samples_out);
@@ -331,10 +344,12 @@ void PhaseLock::process_phasor(Real& phasor_i, Real& phasor_q)
 
     // Update locked phase.
     m_phase += m_freq;
+    bool wrapped = false;
     if (m_phase > 2.0 * M_PI)
     {
         m_phase -= 2.0 * M_PI;
         m_pilot_periods++;
+        wrapped = true;
 
         // Generate pulse-per-second.
         if (m_pilot_periods == pilot_frequency)
@@ -343,6 +358,8 @@ void PhaseLock::process_phasor(Real& phasor_i, Real& phasor_q)
         }
     }
 
+    advancePhasor(wrapped);
+
     // Update lock status.
     if (2 * m_pilot_level > m_minsignal)
     {
@@ -366,3 +383,31 @@ void PhaseLock::process_phasor(Real& phasor_i, Real& phasor_q)
     // Update sample counter.
     m_sample_cnt += 1; // n
 }
+
+// Rotate the locked tone by the frequency estimate so that no sin/cos is evaluated per sample.
+// The frequency stays close to the center frequency so that the rotation is the center rotation
+// corrected with a short series of the small difference. The tone is computed exactly again at
+// each pilot period (or every 64 samples for low or negative frequencies) to stay coherent with the phase.
+void PhaseLock::advancePhasor(bool wrapped)
+{
+    if (wrapped || (++m_phasorCount >= 64))
+    {
+        m_phasorCount = 0;
+        m_psin = sin(m_phase);
+        m_pcos = cos(m_phase);
+        return;
+    }
+
+    Real d = m_freq - m_centerFreq;
+    Real d2 = d * d;
+    Real dcos = 1.0 - d2 * (0.5 - d2 / 24.0);
+    Real dsin = d * (1.0 - d2 / 6.0);
+    Real rcos = m_centerCos * dcos - m_centerSin * dsin;
+    Real rsin = m_centerSin * dcos + m_centerCos * dsin;
+    Real psin = m_psin * rcos + m_pcos * rsin;
+    Real pcos = m_pcos * rcos - m_psin * rsin;
+    // keeps unit amplitude (first order correction)
+    Real gain = 1.5 - 0.5 * (psin * psin + pcos * pcos);
+    m_psin = psin * gain;
+    m_pcos = pcos * gain;
+}
@@ -105,6 +105,9 @@ private:
     Real    m_loopfilter_b0, m_loopfilter_b1;
     Real    m_loopfilter_x1;
     Real    m_freq;
+    Real    m_centerFreq;
+    Real    m_centerSin, m_centerCos;
+    int     m_phasorCount;
     Real    m_minsignal;
     Real    m_pilot_level;
     int     m_lock_delay;
@@ -115,6 +118,7 @@ private:
     std::vector<PpsEvent> m_pps_events;
 
     void process_phasor(Real& phasor_i, Real& phasor_q);
+    void advancePhasor(bool wrapped);
 };
 
 class SimplePhaseLock : public PhaseLock
@@ -177,6 +181,8 @@ protected:
         samples_out[1] = 2.0 * m_psin * m_pcos; // Pilot signal (2f)
         // cos(2*x) = 2 * cos(x) * cos(x) - 1
     	samples_out[2] = (2.0 * m_pcos * m_pcos) - 1.0; // 2f Pilot cos
-        samples_out[3] = m_phase; // Pilot phase
+        // Generate triple-frequency output (RDS carrier).
+        // cos(3*x) = 4 * cos(x)^3 - 3 * cos(x)
+        samples_out[3] = m_pcos * (4.0 * m_pcos * m_pcos - 3.0); // 3f Pilot cos
     }
 };
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Decoder of the chunked samples of a SigMF record. Chunks are unpacked and     //
+// decompressed ahead of the read position by a worker thread so that playback   //
+// does not wait for the decoding. Any chunk can be located from its sample      //
+// index for seeking.                                                            //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "sigmfchunkdecoder.h"
+
+const unsigned int SigMFChunkDecoder::m_nbSlots;
+
+SigMFChunkDecoder::SigMFChunkDecoder() :
+    m_sampleBytes(4),
+    m_nbSamples(0),
+    m_requested(-1),
+    m_stop(false)
+{
+    for (unsigned int i = 0; i < m_nbSlots; i++)
+    {
+        m_slots[i].m_chunkIndex = -1;
+        m_slots[i].m_ready = false;
+        m_slots[i].m_ok = false;
+    }
+}
+
+SigMFChunkDecoder::~SigMFChunkDecoder()
+{
+    close();
+}
+
+bool SigMFChunkDecoder::open(const QString& dataFileName, const SigMFRecord::Meta& meta)
+{
+    close();
+    m_file.setFileName(dataFileName);
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qWarning("SigMFChunkDecoder::open: cannot open %s", qPrintable(dataFileName));
+        return false;
+    }
+
+    m_meta = meta;
+    m_sampleBytes = meta.m_sampleSize == 24 ? 8 : 4;
+
+    // only the headers are read: a chunk holds a few MB of samples
+    quint64 fileSize = m_file.size();
+    quint64 offset = 0;
+
+    while (offset + sizeof(SigMFRecord::ChunkHeader) <= fileSize)
+    {
+        Chunk chunk;
+        m_file.seek(offset);
+
+        if ((m_file.read((char *) &chunk.m_header, sizeof(SigMFRecord::ChunkHeader)) != sizeof(SigMFRecord::ChunkHeader))
+            || !SigMFRecord::isChunkHeader(chunk.m_header))
+        {
+            qWarning("SigMFChunkDecoder::open: %s: bad chunk header at %llu", qPrintable(dataFileName), offset);
+            break;
+        }
+
+        chunk.m_offset = offset + sizeof(SigMFRecord::ChunkHeader);
+
+        if (chunk.m_offset + chunk.m_header.payloadSize > fileSize)
+        {
+            qWarning("SigMFChunkDecoder::open: %s: truncated chunk at %llu", qPrintable(dataFileName), offset);
+            break;
+        }
+
+        chunk.m_sampleStart = m_nbSamples;
+        chunk.m_nbSamples = chunk.m_header.nbSamples;
+        m_chunks.push_back(chunk);
+        m_nbSamples += chunk.m_nbSamples;
+        offset = chunk.m_offset + chunk.m_header.payloadSize;
+    }
+
+    qDebug("SigMFChunkDecoder::open: %s: %u chunks %llu samples", qPrintable(dataFileName), getNbChunks(), m_nbSamples);
+
+    if (m_chunks.size() == 0)
+    {
+        m_file.close();
+        return false;
+    }
+
+    m_stop = false;
+    m_requested = -1;
+    start();
+
+    return true;
+}
+
+void SigMFChunkDecoder::close()
+{
+    if (isRunning())
+    {
+        m_mutex.lock();
+        m_stop = true;
+        m_work.wakeAll();
+        m_mutex.unlock();
+        wait();
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    for (unsigned int i = 0; i < m_nbSlots; i++)
+    {
+        m_slots[i].m_chunkIndex = -1;
+        m_slots[i].m_ready = false;
+    }
+
+    m_chunks.clear();
+    m_nbSamples = 0;
+}
+
+int SigMFChunkDecoder::findChunk(quint64 sampleIndex) const
+{
+    if (sampleIndex >= m_nbSamples) {
+        return -1;
+    }
+
+    // last chunk starting at or before the sample
+    int lo = 0;
+    int hi = m_chunks.size();
+
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+
+        if (m_chunks[mid].m_sampleStart <= sampleIndex) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo - 1;
+}
+
+int SigMFChunkDecoder::findSlot(int chunkIndex) const
+{
+    for (unsigned int i = 0; i < m_nbSlots; i++)
+    {
+        if (m_slots[i].m_chunkIndex == chunkIndex) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+const quint8 *SigMFChunkDecoder::getSamples(unsigned int chunkIndex)
+{
+    if (chunkIndex >= m_chunks.size()) {
+        return nullptr;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_requested = chunkIndex;
+    m_work.wakeAll();
+    int slotIndex;
+
+    while (((slotIndex = findSlot(chunkIndex)) < 0) || !m_slots[slotIndex].m_ready) {
+        m_decoded.wait(&m_mutex);
+    }
+
+    return m_slots[slotIndex].m_ok ? m_slots[slotIndex].m_samples.data() : nullptr;
+}
+
+void SigMFChunkDecoder::run()
+{
+    m_mutex.lock();
+
+    while (!m_stop)
+    {
+        // next chunk of the read ahead window that is not decoded yet
+        int chunkIndex = -1;
+
+        if (m_requested >= 0)
+        {
+            for (int i = m_requested; (i < m_requested + (int) m_nbSlots) && (i < (int) m_chunks.size()); i++)
+            {
+                if (findSlot(i) < 0)
+                {
+                    chunkIndex = i;
+                    break;
+                }
+            }
+        }
+
+        if (chunkIndex < 0)
+        {
+            m_work.wait(&m_mutex);
+            continue;
+        }
+
+        // a slot outside the window is recycled
+        int slotIndex = 0;
+
+        for (unsigned int i = 0; i < m_nbSlots; i++)
+        {
+            int slotChunk = m_slots[i].m_chunkIndex;
+
+            if ((slotChunk < m_requested) || (slotChunk >= m_requested + (int) m_nbSlots))
+            {
+                slotIndex = i;
+                break;
+            }
+        }
+
+        Slot& slot = m_slots[slotIndex];
+        slot.m_chunkIndex = chunkIndex;
+        slot.m_ready = false;
+        m_mutex.unlock();
+
+        bool ok = decode(chunkIndex, slot.m_samples);
+
+        m_mutex.lock();
+        slot.m_ok = ok;
+        slot.m_ready = true;
+        m_decoded.wakeAll();
+    }
+
+    m_mutex.unlock();
+}
+
+bool SigMFChunkDecoder::decode(int chunkIndex, std::vector<quint8>& samples)
+{
+    const Chunk& chunk = m_chunks[chunkIndex];
+    m_payload.resize(chunk.m_header.payloadSize);
+    samples.resize(chunk.m_nbSamples * m_sampleBytes);
+
+    bool ok = m_file.seek(chunk.m_offset)
+        && (m_file.read(m_payload.data(), chunk.m_header.payloadSize) == chunk.m_header.payloadSize)
+        && SigMFRecord::decodeChunk(chunk.m_header, (const quint8 *) m_payload.constData(), m_meta, samples.data());
+
+    if (!ok) {
+        qWarning("SigMFChunkDecoder::decode: chunk %d is corrupted", chunkIndex);
+    }
+
+    return ok;
+}
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Decoder of the chunked samples of a SigMF record. Chunks are unpacked and     //
+// decompressed ahead of the read position by a worker thread so that playback   //
+// does not wait for the decoding. Any chunk can be located from its sample      //
+// index for seeking.                                                            //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SIGMFCHUNKDECODER_H_
+#define SDRBASE_DSP_SIGMFCHUNKDECODER_H_
+
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QString>
+
+#include "dsp/sigmfrecord.h"
+#include "export.h"
+
+class SDRBASE_API SigMFChunkDecoder : public QThread
+{
+    Q_OBJECT
+public:
+    struct Chunk
+    {
+        quint64 m_offset;          //!< file offset of the payload
+        quint64 m_sampleStart;     //!< index of the first sample
+        quint32 m_nbSamples;
+        SigMFRecord::ChunkHeader m_header;
+    };
+
+    SigMFChunkDecoder();
+    ~SigMFChunkDecoder();
+
+    bool open(const QString& dataFileName, const SigMFRecord::Meta& meta); //!< Scan the chunk headers and start the worker
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    quint64 getNbSamples() const { return m_nbSamples; }
+    unsigned int getNbChunks() const { return m_chunks.size(); }
+    const Chunk& getChunk(unsigned int chunkIndex) const { return m_chunks[chunkIndex]; }
+    int findChunk(quint64 sampleIndex) const; //!< Chunk containing the sample or -1
+
+    /**
+     * Samples of a chunk in the record sample format. Waits only if the chunk is not decoded yet
+     * and schedules the decoding of the next chunks. The returned pointer is valid until a
+     * different chunk is requested. Returns nullptr if the chunk is corrupted.
+     */
+    const quint8 *getSamples(unsigned int chunkIndex);
+
+private:
+    struct Slot
+    {
+        int m_chunkIndex;          //!< -1 if empty
+        bool m_ready;
+        bool m_ok;
+        std::vector<quint8> m_samples;
+    };
+
+    static const unsigned int m_nbSlots = 4; //!< requested chunk and the read ahead
+
+    QFile m_file;
+    SigMFRecord::Meta m_meta;
+    quint32 m_sampleBytes;
+    std::vector<Chunk> m_chunks;
+    quint64 m_nbSamples;
+    Slot m_slots[m_nbSlots];
+    int m_requested;               //!< chunk being read
+    bool m_stop;
+    QMutex m_mutex;
+    QWaitCondition m_work;         //!< signals the worker
+    QWaitCondition m_decoded;      //!< signals the reader
+    QByteArray m_payload;          //!< worker thread buffer
+
+    void run();
+    int findSlot(int chunkIndex) const;
+    bool decode(int chunkIndex, std::vector<quint8>& samples);
+};
+
+#endif /* SDRBASE_DSP_SIGMFCHUNKDECODER_H_ */
@@ -0,0 +1,366 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// SigMF records: a .sigmf-data file with the I/Q samples and a .sigmf-meta      //
+// JSON description with the sample format, the captures (center frequency       //
+// changes) and annotations.                                                     //
+//                                                                               //
+// Samples can be stored raw (ci16_le or ci32_le as in a .sdriq record) which is //
+// readable by any SigMF tool or in independently decodable chunks. A chunk      //
+// holds its samples packed to the effective bit depth and optionally zlib       //
+// compressed. Chunked storage is described by the non optional "sdrangel"      //
+// extension of the metadata.                                                    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include <boost/crc.hpp>
+#include <boost/cstdint.hpp>
+
+#include <QFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "sigmfrecord.h"
+
+static const char chunkMagic[4] = {'S', 'Q', 'C', 'K'};
+static const char *sigMFVersion = "1.0.0";
+static const char *extensionVersion = "1.0.0";
+
+static QString timestampToISO(quint64 timestamp)
+{
+    return QDateTime::fromMSecsSinceEpoch(timestamp, Qt::UTC).toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+}
+
+static quint64 timestampFromISO(const QString& dateTime)
+{
+    QDateTime t = QDateTime::fromString(dateTime, Qt::ISODate);
+    return t.isValid() ? t.toMSecsSinceEpoch() : 0;
+}
+
+static quint32 getPackingBits(const SigMFRecord::Meta& meta)
+{
+    return (meta.m_packingBits == 0) || (meta.m_packingBits > meta.m_sampleSize) ? meta.m_sampleSize : meta.m_packingBits;
+}
+
+bool SigMFRecord::isSigMF(const QString& fileName)
+{
+    return fileName.endsWith(".sigmf-meta") || fileName.endsWith(".sigmf-data");
+}
+
+QString SigMFRecord::getBaseName(const QString& fileName)
+{
+    static const char *extensions[] = {".sigmf-meta", ".sigmf-data", ".sigmf", ".sdriq"};
+
+    for (unsigned int i = 0; i < sizeof(extensions)/sizeof(extensions[0]); i++)
+    {
+        if (fileName.endsWith(extensions[i])) {
+            return fileName.left(fileName.size() - (int) strlen(extensions[i]));
+        }
+    }
+
+    return fileName;
+}
+
+bool SigMFRecord::writeMeta(const QString& fileName, const Meta& meta)
+{
+    QJsonObject global;
+    global.insert("core:datatype", meta.m_sampleSize == 24 ? "ci32_le" : "ci16_le");
+    global.insert("core:sample_rate", (double) meta.m_sampleRate);
+    global.insert("core:version", sigMFVersion);
+    global.insert("core:recorder", "SDRangel");
+
+    if (!meta.m_description.isEmpty()) {
+        global.insert("core:description", meta.m_description);
+    }
+
+    // the extension is needed to read chunked data hence not optional
+    QJsonObject extension;
+    extension.insert("name", "sdrangel");
+    extension.insert("version", extensionVersion);
+    extension.insert("optional", !meta.m_chunked);
+    QJsonArray extensions;
+    extensions.append(extension);
+    global.insert("core:extensions", extensions);
+    global.insert("sdrangel:sample_size", (int) meta.m_sampleSize);
+
+    if (meta.m_chunked)
+    {
+        global.insert("sdrangel:chunked", true);
+        global.insert("sdrangel:packing_bits", (int) getPackingBits(meta));
+        global.insert("sdrangel:compression", meta.m_compressed ? "zlib" : "none");
+    }
+
+    QJsonArray captures;
+
+    for (unsigned int i = 0; i < meta.m_captures.size(); i++)
+    {
+        QJsonObject capture;
+        capture.insert("core:sample_start", (double) meta.m_captures[i].m_sampleStart);
+        capture.insert("core:frequency", (double) meta.m_captures[i].m_frequency);
+        capture.insert("core:datetime", timestampToISO(meta.m_captures[i].m_timestamp));
+        captures.append(capture);
+    }
+
+    QJsonArray annotations;
+
+    for (unsigned int i = 0; i < meta.m_annotations.size(); i++)
+    {
+        QJsonObject annotation;
+        annotation.insert("core:sample_start", (double) meta.m_annotations[i].m_sampleStart);
+
+        if (meta.m_annotations[i].m_sampleCount != 0) {
+            annotation.insert("core:sample_count", (double) meta.m_annotations[i].m_sampleCount);
+        }
+
+        annotation.insert("core:comment", meta.m_annotations[i].m_comment);
+        annotations.append(annotation);
+    }
+
+    QJsonObject root;
+    root.insert("global", global);
+    root.insert("captures", captures);
+    root.insert("annotations", annotations);
+
+    QString metaFileName = getMetaFileName(fileName);
+    QFile file(metaFileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("SigMFRecord::writeMeta: cannot open %s", qPrintable(metaFileName));
+        return false;
+    }
+
+    QByteArray json = QJsonDocument(root).toJson();
+
+    if (file.write(json) != json.size())
+    {
+        qWarning("SigMFRecord::writeMeta: error writing %s", qPrintable(metaFileName));
+        return false;
+    }
+
+    return true;
+}
+
+bool SigMFRecord::readMeta(const QString& fileName, Meta& meta)
+{
+    QString metaFileName = getMetaFileName(fileName);
+    QFile file(metaFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning("SigMFRecord::readMeta: cannot open %s", qPrintable(metaFileName));
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+
+    if (doc.isNull() || !doc.isObject())
+    {
+        qWarning("SigMFRecord::readMeta: %s: %s", qPrintable(metaFileName), qPrintable(error.errorString()));
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    QJsonObject global = root.value("global").toObject();
+    QString dataType = global.value("core:datatype").toString();
+
+    // only the formats of the record samples are supported
+    if (dataType == "ci16_le")
+    {
+        meta.m_sampleSize = 16;
+    }
+    else if (dataType == "ci32_le")
+    {
+        meta.m_sampleSize = 24;
+    }
+    else
+    {
+        qWarning("SigMFRecord::readMeta: %s: unsupported data type %s", qPrintable(metaFileName), qPrintable(dataType));
+        return false;
+    }
+
+    meta.m_sampleRate = global.value("core:sample_rate").toDouble();
+    meta.m_description = global.value("core:description").toString();
+    meta.m_chunked = global.value("sdrangel:chunked").toBool(false);
+    meta.m_packingBits = global.value("sdrangel:packing_bits").toInt(0);
+    meta.m_compressed = global.value("sdrangel:compression").toString() == "zlib";
+
+    if (meta.m_chunked && (meta.m_packingBits > meta.m_sampleSize))
+    {
+        qWarning("SigMFRecord::readMeta: %s: invalid packing bits %u", qPrintable(metaFileName), meta.m_packingBits);
+        return false;
+    }
+
+    QJsonArray captures = root.value("captures").toArray();
+    meta.m_captures.clear();
+
+    for (int i = 0; i < captures.size(); i++)
+    {
+        QJsonObject captureObject = captures[i].toObject();
+        Capture capture;
+        capture.m_sampleStart = captureObject.value("core:sample_start").toDouble();
+        capture.m_frequency = captureObject.value("core:frequency").toDouble();
+        capture.m_timestamp = timestampFromISO(captureObject.value("core:datetime").toString());
+        meta.m_captures.push_back(capture);
+    }
+
+    QJsonArray annotations = root.value("annotations").toArray();
+    meta.m_annotations.clear();
+
+    for (int i = 0; i < annotations.size(); i++)
+    {
+        QJsonObject annotationObject = annotations[i].toObject();
+        Annotation annotation;
+        annotation.m_sampleStart = annotationObject.value("core:sample_start").toDouble();
+        annotation.m_sampleCount = annotationObject.value("core:sample_count").toDouble();
+        annotation.m_comment = annotationObject.value("core:comment").toString();
+        meta.m_annotations.push_back(annotation);
+    }
+
+    return true;
+}
+
+bool SigMFRecord::isChunkHeader(const ChunkHeader& header)
+{
+    return std::memcmp(header.magic, chunkMagic, sizeof(chunkMagic)) == 0;
+}
+
+void SigMFRecord::encodeChunk(const quint8 *samples, quint32 nbSamples, const Meta& meta, QByteArray& chunk)
+{
+    quint32 bits = getPackingBits(meta);
+    quint32 shift = meta.m_sampleSize - bits;
+    quint32 nbComponents = 2 * nbSamples;
+    QByteArray packed;
+
+    if ((bits == 16) && (meta.m_sampleSize == 16))
+    {
+        packed = QByteArray((const char *) samples, nbComponents * 2);
+    }
+    else
+    {
+        // components are rounded to the most significant bits and packed LSB first
+        packed.resize((nbComponents * bits + 7) / 8);
+        quint8 *out = (quint8 *) packed.data();
+        const qint32 maxValue = (1 << (bits - 1)) - 1;
+        const qint32 rounding = shift == 0 ? 0 : 1 << (shift - 1);
+        const quint64 mask = (1ULL << bits) - 1;
+        quint64 acc = 0;
+        quint32 nacc = 0;
+
+        for (quint32 i = 0; i < nbComponents; i++)
+        {
+            qint32 v = meta.m_sampleSize == 24 ? ((const qint32 *) samples)[i] : ((const qint16 *) samples)[i];
+            v = (v + rounding) >> shift;
+            v = v > maxValue ? maxValue : v;
+            acc |= ((quint64) v & mask) << nacc;
+            nacc += bits;
+
+            while (nacc >= 8)
+            {
+                *out++ = acc & 0xFF;
+                acc >>= 8;
+                nacc -= 8;
+            }
+        }
+
+        if (nacc > 0) {
+            *out = acc & 0xFF;
+        }
+    }
+
+    if (meta.m_compressed) {
+        packed = qCompress(packed);
+    }
+
+    ChunkHeader header;
+    std::memcpy(header.magic, chunkMagic, sizeof(chunkMagic));
+    header.nbSamples = nbSamples;
+    header.payloadSize = packed.size();
+    boost::crc_32_type crc32;
+    crc32.process_bytes(packed.constData(), packed.size());
+    header.crc32 = crc32.checksum();
+
+    chunk.append((const char *) &header, sizeof(ChunkHeader));
+    chunk.append(packed);
+}
+
+bool SigMFRecord::decodeChunk(const ChunkHeader& header, const quint8 *payload, const Meta& meta, quint8 *samples)
+{
+    boost::crc_32_type crc32;
+    crc32.process_bytes(payload, header.payloadSize);
+
+    if (crc32.checksum() != header.crc32) {
+        return false;
+    }
+
+    quint32 bits = getPackingBits(meta);
+    quint32 shift = meta.m_sampleSize - bits;
+    quint32 nbComponents = 2 * header.nbSamples;
+    quint32 packedSize = (nbComponents * bits + 7) / 8;
+    QByteArray uncompressed;
+    const quint8 *in = payload;
+
+    if (meta.m_compressed)
+    {
+        uncompressed = qUncompress(payload, header.payloadSize);
+        in = (const quint8 *) uncompressed.constData();
+
+        if ((quint32) uncompressed.size() != packedSize) {
+            return false;
+        }
+    }
+    else if (header.payloadSize != packedSize)
+    {
+        return false;
+    }
+
+    if ((bits == 16) && (meta.m_sampleSize == 16))
+    {
+        std::memcpy(samples, in, packedSize);
+        return true;
+    }
+
+    quint64 acc = 0;
+    quint32 nacc = 0;
+    const quint64 mask = (1ULL << bits) - 1;
+
+    for (quint32 i = 0; i < nbComponents; i++)
+    {
+        while (nacc < bits)
+        {
+            acc |= ((quint64) *in++) << nacc;
+            nacc += 8;
+        }
+
+        // sign extension then back to the most significant bits
+        qint32 v = ((qint32) ((acc & mask) << (32 - bits))) >> (32 - bits);
+        acc >>= bits;
+        nacc -= bits;
+
+        if (meta.m_sampleSize == 24) {
+            ((qint32 *) samples)[i] = v * (1 << shift);
+        } else {
+            ((qint16 *) samples)[i] = v * (1 << shift);
+        }
+    }
+
+    return true;
+}
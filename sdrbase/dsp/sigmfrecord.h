@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// SigMF records: a .sigmf-data file with the I/Q samples and a .sigmf-meta      //
+// JSON description with the sample format, the captures (center frequency       //
+// changes) and annotations.                                                     //
+//                                                                               //
+// Samples can be stored raw (ci16_le or ci32_le as in a .sdriq record) which is //
+// readable by any SigMF tool or in independently decodable chunks. A chunk      //
+// holds its samples packed to the effective bit depth and optionally zlib       //
+// compressed. Chunked storage is described by the non optional "sdrangel"      //
+// extension of the metadata.                                                    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SIGMFRECORD_H_
+#define SDRBASE_DSP_SIGMFRECORD_H_
+
+#include <vector>
+
+#include <QString>
+#include <QByteArray>
+
+#include "export.h"
+
+class SDRBASE_API SigMFRecord
+{
+public:
+    struct Capture
+    {
+        quint64 m_sampleStart;     //!< sample index in the data file
+        quint64 m_frequency;       //!< center frequency in Hz
+        quint64 m_timestamp;       //!< time of the first sample in ms since epoch
+    };
+
+    struct Annotation
+    {
+        quint64 m_sampleStart;
+        quint64 m_sampleCount;     //!< 0 for a point in time
+        QString m_comment;
+    };
+
+    struct Meta
+    {
+        quint32 m_sampleRate;
+        quint32 m_sampleSize;      //!< 16 or 24 bits (24 bits samples are stored on 32 bits)
+        quint32 m_packingBits;     //!< bits kept per I or Q component in chunks (0: sample size)
+        bool m_chunked;            //!< samples are stored in chunks
+        bool m_compressed;         //!< chunk payloads are zlib compressed
+        QString m_description;
+        std::vector<Capture> m_captures;
+        std::vector<Annotation> m_annotations;
+
+        Meta() :
+            m_sampleRate(0),
+            m_sampleSize(16),
+            m_packingBits(0),
+            m_chunked(false),
+            m_compressed(false)
+        {}
+    };
+
+#pragma pack(push, 1)
+    struct ChunkHeader
+    {
+        char magic[4];             //!< "SQCK"
+        quint32 nbSamples;         //!< number of I/Q samples
+        quint32 payloadSize;       //!< bytes following the header
+        quint32 crc32;             //!< CRC32 of the payload
+    };
+#pragma pack(pop)
+
+    static bool isSigMF(const QString& fileName); //!< True for .sigmf-meta or .sigmf-data files
+    static QString getBaseName(const QString& fileName); //!< File name without the SigMF or .sdriq extension
+    static QString getMetaFileName(const QString& fileName) { return getBaseName(fileName) + ".sigmf-meta"; }
+    static QString getDataFileName(const QString& fileName) { return getBaseName(fileName) + ".sigmf-data"; }
+
+    static bool writeMeta(const QString& fileName, const Meta& meta);
+    static bool readMeta(const QString& fileName, Meta& meta); //!< false if absent or not a supported sample format
+
+    /**
+     * Encode I/Q samples in the record sample format into a chunk (header and payload) appended to chunk.
+     * Components are packed to the meta packing bits keeping the most significant bits.
+     */
+    static void encodeChunk(const quint8 *samples, quint32 nbSamples, const Meta& meta, QByteArray& chunk);
+    /**
+     * Decode a chunk payload to I/Q samples in the record sample format.
+     * samples must hold header.nbSamples samples. Returns false on corrupted payload.
+     */
+    static bool decodeChunk(const ChunkHeader& header, const quint8 *payload, const Meta& meta, quint8 *samples);
+    static bool isChunkHeader(const ChunkHeader& header);
+};
+
+#endif /* SDRBASE_DSP_SIGMFRECORD_H_ */
@@ -124,6 +124,19 @@ bool ThreadedBasebandSampleSink::handleSinkMessage(const Message& cmd)
 	return m_basebandSampleSink->handleMessage(cmd);
 }
 
+int ThreadedBasebandSampleSink::getFifoBacklog()
+{
+	SampleSinkFifo& sampleFifo = m_threadedBasebandSampleSinkFifo->m_sampleFifo;
+	return sampleFifo.size() == 0 ? 0 : (int) ((sampleFifo.fill() * 1000ULL) / sampleFifo.size());
+}
+
+unsigned int ThreadedBasebandSampleSink::getFifoFreeSpace()
+{
+	SampleSinkFifo& sampleFifo = m_threadedBasebandSampleSinkFifo->m_sampleFifo;
+	unsigned int fill = sampleFifo.fill();
+	return fill > sampleFifo.size() ? 0 : sampleFifo.size() - fill;
+}
+
 QString ThreadedBasebandSampleSink::getSampleSinkObjectName() const
 {
 	return m_basebandSampleSink->objectName();
@@ -67,6 +67,8 @@ public:
 	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples
 
 	QString getSampleSinkObjectName() const;
+	int getFifoBacklog(); //!< FIFO fill in per mille of its size
+	unsigned int getFifoFreeSpace(); //!< FIFO free space in samples
     const QThread *getThread() const { return m_thread; }
 
 protected:
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "tvframebuffer.h"
+
+TVFrameBuffer::TVFrameBuffer() :
+    m_state(0),
+    m_backIndex(1),
+    m_nbPublished(0),
+    m_nbDropped(0)
+{
+}
+
+unsigned char *TVFrameBuffer::getBackFrame(int cols, int rows)
+{
+    Frame& frame = m_frames[m_backIndex];
+
+    if ((frame.m_cols != cols) || (frame.m_rows != rows))
+    {
+        frame.m_cols = cols;
+        frame.m_rows = rows;
+        frame.m_pixels.resize(cols * rows);
+        std::fill(frame.m_pixels.begin(), frame.m_pixels.end(), 0);
+    }
+
+    return frame.m_pixels.data();
+}
+
+bool TVFrameBuffer::publishFrame()
+{
+    while (true)
+    {
+        int state = m_state.loadAcquire();
+
+        if (state & ReaderBusy)
+        {
+            m_nbDropped++;
+            return false;
+        }
+
+        // the back frame becomes the front frame
+        if (m_state.testAndSetOrdered(state, m_backIndex | NewFrame))
+        {
+            m_backIndex = state & FrontIndex;
+            m_nbPublished++;
+            return true;
+        }
+    }
+}
+
+const TVFrameBuffer::Frame *TVFrameBuffer::acquireFrame()
+{
+    while (true)
+    {
+        int state = m_state.loadAcquire();
+
+        if ((state & NewFrame) == 0) {
+            return nullptr;
+        }
+
+        if (m_state.testAndSetOrdered(state, (state & FrontIndex) | ReaderBusy)) {
+            return &m_frames[state & FrontIndex];
+        }
+    }
+}
+
+void TVFrameBuffer::releaseFrame()
+{
+    m_state.fetchAndAndOrdered(~ReaderBusy);
+}
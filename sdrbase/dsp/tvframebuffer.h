@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_TVFRAMEBUFFER_H
+#define INCLUDE_TVFRAMEBUFFER_H
+
+#include <vector>
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Double buffer of gray level video frames between a single writer (the demodulator) and a
+ * single reader (the screen). The writer draws into the back frame and publishes it by swapping
+ * the front and back indexes. The reader takes the front frame for the time of a copy. Neither
+ * side takes a lock: the state is a single atomic word holding the front index, a reader busy
+ * flag and a new frame flag. A frame completed while the reader holds the front frame is dropped
+ * and the writer draws the next frame over it.
+ */
+class SDRBASE_API TVFrameBuffer
+{
+public:
+    struct Frame
+    {
+        int m_cols;
+        int m_rows;
+        std::vector<unsigned char> m_pixels; //!< m_rows lines of m_cols gray levels
+
+        Frame() : m_cols(0), m_rows(0) {}
+    };
+
+    TVFrameBuffer();
+
+    // writer side
+    unsigned char *getBackFrame(int cols, int rows); //!< pixels of the back frame. Cleared when the size changes.
+    bool publishFrame(); //!< false if the frame was dropped because the reader held the front frame
+
+    // reader side
+    bool hasNewFrame() const { return (m_state.loadAcquire() & NewFrame) != 0; }
+    const Frame *acquireFrame(); //!< front frame if a frame was published since the last one acquired else null
+    void releaseFrame();
+
+    quint64 getNbPublished() const { return m_nbPublished; }
+    quint64 getNbDropped() const { return m_nbDropped; }
+
+private:
+    enum StateBits
+    {
+        FrontIndex = 1,
+        ReaderBusy = 2,
+        NewFrame = 4
+    };
+
+    Frame m_frames[2];
+    QAtomicInt m_state;
+    int m_backIndex;       //!< writer only
+    quint64 m_nbPublished; //!< writer only
+    quint64 m_nbDropped;   //!< writer only
+};
+
+#endif // INCLUDE_TVFRAMEBUFFER_H
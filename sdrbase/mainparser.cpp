@@ -31,10 +31,15 @@ MainParser::MainParser() :
         "Web API server port.",
         "port",
         "8091"),
+    m_serverEventLoopsOption("api-event-loops",
+        "Web API server event loops serving all connections (0: one thread per connection).",
+        "count",
+        "0"),
     m_mimoOption("mimo", "Activate MIMO functionality")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_serverEventLoops = 0;
     m_mimoSupport = false;
     m_mimoOption.setFlags(QCommandLineOption::HiddenFromHelp);
 
@@ -44,6 +49,7 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_serverEventLoopsOption);
     m_parser.addOption(m_mimoOption);
 }
 
@@ -85,6 +91,17 @@ void MainParser::parse(const QCoreApplication& app)
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
 
+    // server event loops
+
+    QString serverEventLoopsStr = m_parser.value(m_serverEventLoopsOption);
+    int serverEventLoops = serverEventLoopsStr.toInt(&ok);
+
+    if (ok && (serverEventLoops >= 0) && (serverEventLoops <= 16)) {
+        m_serverEventLoops = serverEventLoops;
+    } else {
+        qWarning() << "MainParser::parse: server event loops invalid. Defaulting to " << m_serverEventLoops;
+    }
+
     // MIMO
 
     m_mimoSupport = m_parser.isSet(m_mimoOption);
@@ -34,16 +34,19 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    int getServerEventLoops() const { return m_serverEventLoops; }
     bool getMIMOSupport() const { return m_mimoSupport; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    int m_serverEventLoops;
     bool m_mimoSupport;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_serverEventLoopsOption;
     QCommandLineOption m_mimoOption;
 };
 
@@ -17,6 +17,11 @@
 
 #include <QCoreApplication>
 #include <QPluginLoader>
+#include <QSettings>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonArray>
 #include <QDebug>
 
 #include <cstdio>
@@ -28,6 +33,7 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 
+#include "plugin/pluginproxy.h"
 #include "plugin/pluginmanager.h"
 
 const QString PluginManager::m_localInputHardwareID = "LocalInput";
@@ -49,7 +55,9 @@ const QString PluginManager::m_testMIMODeviceTypeID = "sdrangel.samplemimo.testm
 
 PluginManager::PluginManager(QObject* parent) :
 	QObject(parent),
-    m_pluginAPI(this)
+    m_pluginAPI(this),
+    m_initProxy(nullptr),
+    m_manifestDirty(false)
 {
 }
 
@@ -81,6 +89,9 @@ void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
     PluginsPath << applicationDirPath + "/" + pluginsSubDir;
 #endif
 
+    // the manifest is kept next to the settings
+    m_manifestFileName = QFileInfo(QSettings().fileName()).absolutePath() + "/" + pluginsSubDir + "-manifest.json";
+
     // NOTE: exit on the first folder found
     bool found = false;
     foreach (QString dir, PluginsPath)
@@ -109,16 +120,27 @@ void PluginManager::loadPluginsFinal()
 
     for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
     {
+        m_initProxy = static_cast<PluginProxy*>(it->pluginInterface);
         it->pluginInterface->initPlugin(&m_pluginAPI);
     }
 
-    DeviceEnumerator::instance()->enumerateRxDevices(this);
-    DeviceEnumerator::instance()->enumerateTxDevices(this);
-    DeviceEnumerator::instance()->enumerateMIMODevices(this);
+    m_initProxy = nullptr;
+
+    if (m_manifestDirty) {
+        writeManifest();
+    }
+
+    DeviceEnumerator::instance()->enumerateDevices(this);
 }
 
 void PluginManager::registerRxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    plugin = initRegistration(PluginProxy::RegistrationRxChannel, channelIdURI, channelId, plugin);
+
+    if (!plugin) {
+        return;
+    }
+
     qDebug() << "PluginManager::registerRxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -128,6 +150,12 @@ void PluginManager::registerRxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerTxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    plugin = initRegistration(PluginProxy::RegistrationTxChannel, channelIdURI, channelId, plugin);
+
+    if (!plugin) {
+        return;
+    }
+
     qDebug() << "PluginManager::registerTxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -137,6 +165,12 @@ void PluginManager::registerTxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerMIMOChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    plugin = initRegistration(PluginProxy::RegistrationMIMOChannel, channelIdURI, channelId, plugin);
+
+    if (!plugin) {
+        return;
+    }
+
     qDebug() << "PluginManager::registerMIMOChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -146,6 +180,12 @@ void PluginManager::registerMIMOChannel(const QString& channelIdURI, const QStri
 
 void PluginManager::registerSampleSource(const QString& sourceName, PluginInterface* plugin)
 {
+	plugin = initRegistration(PluginProxy::RegistrationSampleSource, sourceName, QString(), plugin);
+
+	if (!plugin) {
+		return;
+	}
+
 	qDebug() << "PluginManager::registerSampleSource "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with source name " << sourceName.toStdString().c_str();
@@ -155,6 +195,12 @@ void PluginManager::registerSampleSource(const QString& sourceName, PluginInterf
 
 void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface* plugin)
 {
+	plugin = initRegistration(PluginProxy::RegistrationSampleSink, sinkName, QString(), plugin);
+
+	if (!plugin) {
+		return;
+	}
+
 	qDebug() << "PluginManager::registerSampleSink "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with sink name " << sinkName.toStdString().c_str();
@@ -164,6 +210,12 @@ void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface*
 
 void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface* plugin)
 {
+	plugin = initRegistration(PluginProxy::RegistrationSampleMIMO, mimoName, QString(), plugin);
+
+	if (!plugin) {
+		return;
+	}
+
 	qDebug() << "PluginManager::registerSampleMIMO "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with MIMO name " << mimoName.toStdString().c_str();
@@ -171,17 +223,68 @@ void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface*
 	m_sampleMIMORegistrations.append(PluginAPI::SamplingDeviceRegistration(mimoName, plugin));
 }
 
+PluginInterface *PluginManager::initRegistration(int registrationType, const QString& idURI, const QString& id, PluginInterface* plugin)
+{
+    // a plugin registers the proxy that stands for it
+    if (m_initProxy && (plugin != m_initProxy))
+    {
+        if (!m_initProxy->addRegistration((PluginProxy::RegistrationType) registrationType, idURI, id)) {
+            return nullptr; // already registered from the manifest
+        }
+
+        return m_initProxy;
+    }
+
+    return plugin;
+}
+
+void PluginManager::initLoadedPlugin(PluginProxy *pluginProxy, PluginInterface *plugin)
+{
+    QMutexLocker mutexLocker(&m_initMutex);
+    m_initProxy = pluginProxy;
+    plugin->initPlugin(&m_pluginAPI);
+    m_initProxy = nullptr;
+}
+
+void PluginManager::loadPlugin(const QString& filePath)
+{
+    for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
+    {
+        PluginProxy *pluginProxy = static_cast<PluginProxy*>(it->pluginInterface);
+
+        if (pluginProxy->getFilePath() == filePath)
+        {
+            pluginProxy->load();
+            return;
+        }
+    }
+}
+
 void PluginManager::loadPluginsDir(const QDir& dir)
 {
     QDir pluginsDir(dir);
+    QMap<QString, QJsonObject> manifestEntries;
+    int nbLoaded = 0;
+    m_pluginsDir = pluginsDir;
+    readManifest(manifestEntries);
 
     foreach (QString fileName, pluginsDir.entryList(QDir::Files))
     {
         if (QLibrary::isLibrary(fileName))
         {
             qDebug("PluginManager::loadPluginsDir: fileName: %s", qPrintable(fileName));
+            QString filePath = pluginsDir.absoluteFilePath(fileName);
 
-            QPluginLoader* pluginLoader = new QPluginLoader(pluginsDir.absoluteFilePath(fileName));
+            if (PluginProxy::isManifestEntryValid(manifestEntries.value(fileName), filePath))
+            {
+                // the library is loaded on first use
+                m_plugins.append(Plugin(fileName, new PluginProxy(this, filePath, manifestEntries.value(fileName))));
+                manifestEntries.remove(fileName);
+                continue;
+            }
+
+            m_manifestDirty = true;
+            QPluginLoader* pluginLoader = new QPluginLoader(filePath);
             if (!pluginLoader->load())
             {
                 qWarning("PluginManager::loadPluginsDir: %s", qPrintable(pluginLoader->errorString()));
@@ -200,9 +303,69 @@ void PluginManager::loadPluginsDir(const QDir& dir)
             delete(pluginLoader);
 
             qInfo("PluginManager::loadPluginsDir: loaded plugin %s", qPrintable(fileName));
-            m_plugins.append(Plugin(fileName, instance));
+            nbLoaded++;
+            m_plugins.append(Plugin(fileName, new PluginProxy(this, filePath, instance)));
        }
     }
+
+    if (manifestEntries.size() > 0) { // plugins removed
+        m_manifestDirty = true;
+    }
+
+    qInfo("PluginManager::loadPluginsDir: %d plugins %d loaded at startup", m_plugins.size(), nbLoaded);
+}
+
+void PluginManager::readManifest(QMap<QString, QJsonObject>& manifestEntries)
+{
+    QFile manifestFile(m_manifestFileName);
+
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonObject manifest = QJsonDocument::fromJson(manifestFile.readAll()).object();
+
+    // a new build or another plugins directory may have plugins with the same file names
+    if ((manifest["version"].toString() != QCoreApplication::applicationVersion())
+     || (manifest["directory"].toString() != m_pluginsDir.absolutePath()))
+    {
+        qDebug("PluginManager::readManifest: %s is obsolete", qPrintable(m_manifestFileName));
+        return;
+    }
+
+    QJsonArray plugins = manifest["plugins"].toArray();
+
+    for (QJsonArray::const_iterator it = plugins.begin(); it != plugins.end(); ++it)
+    {
+        QJsonObject manifestEntry = (*it).toObject();
+        manifestEntries.insert(manifestEntry["file"].toString(), manifestEntry);
+    }
+}
+
+void PluginManager::writeManifest()
+{
+    QJsonArray plugins;
+
+    for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it) {
+        plugins.append(static_cast<PluginProxy*>(it->pluginInterface)->getManifestEntry());
+    }
+
+    QJsonObject manifest;
+    manifest["version"] = QCoreApplication::applicationVersion();
+    manifest["directory"] = m_pluginsDir.absolutePath();
+    manifest["plugins"] = plugins;
+
+    QFile manifestFile(m_manifestFileName);
+
+    if (!manifestFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("PluginManager::writeManifest: cannot write %s", qPrintable(m_manifestFileName));
+        return;
+    }
+
+    manifestFile.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+    m_manifestDirty = false;
+    qDebug("PluginManager::writeManifest: %d plugins in %s", plugins.size(), qPrintable(m_manifestFileName));
 }
 
 void PluginManager::listTxChannels(QList<QString>& list)
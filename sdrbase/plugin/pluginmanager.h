@@ -23,6 +23,9 @@
 #include <QDir>
 #include <QList>
 #include <QString>
+#include <QMap>
+#include <QMutex>
+#include <QJsonObject>
 
 #include "plugin/plugininterface.h"
 #include "plugin/pluginapi.h"
@@ -34,6 +37,7 @@ class Preset;
 class Message;
 class MessageQueue;
 class DeviceAPI;
+class PluginProxy;
 
 class SDRBASE_API PluginManager : public QObject {
 	Q_OBJECT
@@ -149,7 +153,22 @@ private:
     static const QString m_testMIMOHardwareID;       //!< Test MIMO hardware ID
     static const QString m_testMIMODeviceTypeID;     //!< Test MIMO plugin ID
 
+	PluginProxy *m_initProxy;     //!< plugin being initialized
+	QMutex m_initMutex;
+	QDir m_pluginsDir;
+	QString m_manifestFileName;   //!< descriptors and registrations of the plugins in the plugins directory
+	bool m_manifestDirty;
+
 	void loadPluginsDir(const QDir& dir);
+	void readManifest(QMap<QString, QJsonObject>& manifestEntries);
+	void writeManifest();
+	void initLoadedPlugin(PluginProxy *pluginProxy, PluginInterface *plugin); //!< library loaded after startup
+	PluginInterface *initRegistration(int registrationType, const QString& idURI, const QString& id, PluginInterface* plugin);
+
+private slots:
+	void loadPlugin(const QString& filePath); //!< library of a plugin first used from another thread
+
+	friend class PluginProxy;
 };
 
 static inline bool operator<(const PluginManager::Plugin& a, const PluginManager::Plugin& b)
@@ -0,0 +1,416 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Stand in for a plugin library. The descriptor and the registrations of the    //
+// plugin are known from the plugins manifest so that the library is loaded only //
+// when one of its channels or devices is used for the first time.               //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QPluginLoader>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+
+#include "plugin/pluginapi.h"
+#include "plugin/pluginmanager.h"
+#include "plugin/pluginproxy.h"
+
+PluginProxy::PluginProxy(PluginManager *pluginManager, const QString& filePath, PluginInterface *plugin) :
+    m_pluginManager(pluginManager),
+    m_filePath(filePath),
+    m_descriptor(nullptr),
+    m_pluginAPI(nullptr),
+    m_plugin(plugin),
+    m_loadFailed(false)
+{}
+
+PluginProxy::PluginProxy(PluginManager *pluginManager, const QString& filePath, const QJsonObject& manifestEntry) :
+    m_pluginManager(pluginManager),
+    m_filePath(filePath),
+    m_pluginAPI(nullptr),
+    m_plugin(nullptr),
+    m_loadFailed(false)
+{
+    QJsonObject descriptor = manifestEntry["descriptor"].toObject();
+    m_descriptor = new PluginDescriptor {
+        descriptor["displayedName"].toString(),
+        descriptor["version"].toString(),
+        descriptor["copyright"].toString(),
+        descriptor["website"].toString(),
+        descriptor["licenseIsGPL"].toBool(),
+        descriptor["sourceCodeURL"].toString()
+    };
+
+    QJsonArray registrations = manifestEntry["registrations"].toArray();
+
+    for (QJsonArray::const_iterator it = registrations.begin(); it != registrations.end(); ++it)
+    {
+        QJsonObject registration = (*it).toObject();
+        addRegistration(
+            (RegistrationType) registration["type"].toInt(),
+            registration["idURI"].toString(),
+            registration["id"].toString()
+        );
+    }
+}
+
+PluginProxy::~PluginProxy()
+{
+    delete m_descriptor;
+}
+
+bool PluginProxy::isManifestEntryValid(const QJsonObject& manifestEntry, const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+
+    return !manifestEntry.isEmpty()
+        && (manifestEntry["size"].toDouble() == (double) fileInfo.size())
+        && (manifestEntry["modified"].toDouble() == (double) fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
+QJsonObject PluginProxy::getManifestEntry() const
+{
+    QFileInfo fileInfo(m_filePath);
+    const PluginDescriptor& pluginDescriptor = getPluginDescriptor();
+    QJsonObject descriptor;
+    descriptor["displayedName"] = pluginDescriptor.displayedName;
+    descriptor["version"] = pluginDescriptor.version;
+    descriptor["copyright"] = pluginDescriptor.copyright;
+    descriptor["website"] = pluginDescriptor.website;
+    descriptor["licenseIsGPL"] = pluginDescriptor.licenseIsGPL;
+    descriptor["sourceCodeURL"] = pluginDescriptor.sourceCodeURL;
+
+    QJsonArray registrations;
+
+    for (std::vector<Registration>::const_iterator it = m_registrations.begin(); it != m_registrations.end(); ++it)
+    {
+        QJsonObject registration;
+        registration["type"] = (int) it->m_type;
+        registration["idURI"] = it->m_idURI;
+        registration["id"] = it->m_id;
+        registrations.append(registration);
+    }
+
+    QJsonObject manifestEntry;
+    manifestEntry["file"] = fileInfo.fileName();
+    manifestEntry["size"] = (double) fileInfo.size();
+    manifestEntry["modified"] = (double) fileInfo.lastModified().toMSecsSinceEpoch();
+    manifestEntry["descriptor"] = descriptor;
+    manifestEntry["registrations"] = registrations;
+
+    return manifestEntry;
+}
+
+bool PluginProxy::addRegistration(RegistrationType type, const QString& idURI, const QString& id)
+{
+    for (std::vector<Registration>::const_iterator it = m_registrations.begin(); it != m_registrations.end(); ++it)
+    {
+        if ((it->m_type == type) && (it->m_idURI == idURI)) {
+            return false;
+        }
+    }
+
+    m_registrations.push_back(Registration{type, idURI, id});
+    return true;
+}
+
+PluginInterface *PluginProxy::plugin() const
+{
+    m_mutex.lock();
+    bool loadDone = m_plugin || m_loadFailed;
+    m_mutex.unlock();
+
+    if (!loadDone)
+    {
+        if (QThread::currentThread() == m_pluginManager->thread()) {
+            load();
+        } else { // the plugin instance is a QObject that must live in the main thread like the plugins loaded at startup
+            QMetaObject::invokeMethod(m_pluginManager, "loadPlugin", Qt::BlockingQueuedConnection, Q_ARG(QString, m_filePath));
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_plugin;
+}
+
+void PluginProxy::load() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_plugin || m_loadFailed) {
+        return;
+    }
+
+    QPluginLoader pluginLoader(m_filePath);
+
+    if (!pluginLoader.load())
+    {
+        qCritical("PluginProxy::load: %s", qPrintable(pluginLoader.errorString()));
+        m_loadFailed = true;
+        return;
+    }
+
+    PluginInterface *instance = qobject_cast<PluginInterface*>(pluginLoader.instance());
+
+    if (instance == nullptr)
+    {
+        qCritical("PluginProxy::load: Unable to get main instance of plugin: %s", qPrintable(m_filePath));
+        m_loadFailed = true;
+        return;
+    }
+
+    qInfo("PluginProxy::load: loaded plugin %s on first use", qPrintable(m_filePath));
+    // the registrations of the plugin are already known from the manifest
+    m_pluginManager->initLoadedPlugin(const_cast<PluginProxy*>(this), instance);
+    m_plugin = instance;
+}
+
+const PluginDescriptor& PluginProxy::getPluginDescriptor() const
+{
+    return m_descriptor ? *m_descriptor : m_plugin->getPluginDescriptor();
+}
+
+void PluginProxy::initPlugin(PluginAPI* pluginAPI)
+{
+    m_pluginAPI = pluginAPI;
+
+    if (m_plugin)
+    {
+        // the plugin registers itself and its registrations are collected for the manifest
+        m_registrations.clear();
+        m_plugin->initPlugin(pluginAPI);
+        return;
+    }
+
+    for (std::vector<Registration>::const_iterator it = m_registrations.begin(); it != m_registrations.end(); ++it)
+    {
+        switch (it->m_type)
+        {
+        case RegistrationRxChannel:
+            pluginAPI->registerRxChannel(it->m_idURI, it->m_id, this);
+            break;
+        case RegistrationTxChannel:
+            pluginAPI->registerTxChannel(it->m_idURI, it->m_id, this);
+            break;
+        case RegistrationMIMOChannel:
+            pluginAPI->registerMIMOChannel(it->m_idURI, it->m_id, this);
+            break;
+        case RegistrationSampleSource:
+            pluginAPI->registerSampleSource(it->m_idURI, this);
+            break;
+        case RegistrationSampleSink:
+            pluginAPI->registerSampleSink(it->m_idURI, this);
+            break;
+        case RegistrationSampleMIMO:
+            pluginAPI->registerSampleMIMO(it->m_idURI, this);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+PluginInstanceGUI* PluginProxy::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createRxChannelGUI(deviceUISet, rxChannel) : nullptr;
+}
+
+BasebandSampleSink* PluginProxy::createRxChannelBS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createRxChannelBS(deviceAPI) : nullptr;
+}
+
+ChannelAPI* PluginProxy::createRxChannelCS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createRxChannelCS(deviceAPI) : nullptr;
+}
+
+PluginInstanceGUI* PluginProxy::createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createTxChannelGUI(deviceUISet, txChannel) : nullptr;
+}
+
+BasebandSampleSource* PluginProxy::createTxChannelBS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createTxChannelBS(deviceAPI) : nullptr;
+}
+
+ChannelAPI* PluginProxy::createTxChannelCS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createTxChannelCS(deviceAPI) : nullptr;
+}
+
+PluginInstanceGUI* PluginProxy::createMIMOChannelGUI(DeviceUISet *deviceUISet, MIMOChannel *mimoChannel) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createMIMOChannelGUI(deviceUISet, mimoChannel) : nullptr;
+}
+
+MIMOChannel* PluginProxy::createMIMOChannelBS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createMIMOChannelBS(deviceAPI) : nullptr;
+}
+
+ChannelAPI* PluginProxy::createMIMOChannelCS(DeviceAPI *deviceAPI) const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createMIMOChannelCS(deviceAPI) : nullptr;
+}
+
+ChannelWebAPIAdapter* PluginProxy::createChannelWebAPIAdapter() const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createChannelWebAPIAdapter() : nullptr;
+}
+
+void PluginProxy::enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices)
+{
+    PluginInterface *p = plugin();
+
+    if (p) {
+        p->enumOriginDevices(listedHwIds, originDevices);
+    }
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleSources(const OriginDevices& originDevices)
+{
+    PluginInterface *p = plugin();
+    return p ? p->enumSampleSources(originDevices) : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleSourcePluginInstanceGUI(sourceId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSource* PluginProxy::createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleSourcePluginInstance(sourceId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleSourcePluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleSourcePluginInstanceGUI(ui);
+    } else {
+        PluginInterface::deleteSampleSourcePluginInstanceGUI(ui);
+    }
+}
+
+void PluginProxy::deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleSourcePluginInstanceInput(source);
+    } else {
+        PluginInterface::deleteSampleSourcePluginInstanceInput(source);
+    }
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleSinks(const OriginDevices& originDevices)
+{
+    PluginInterface *p = plugin();
+    return p ? p->enumSampleSinks(originDevices) : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleSinkPluginInstanceGUI(sinkId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSink* PluginProxy::createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleSinkPluginInstance(sinkId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleSinkPluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleSinkPluginInstanceGUI(ui);
+    } else {
+        PluginInterface::deleteSampleSinkPluginInstanceGUI(ui);
+    }
+}
+
+void PluginProxy::deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleSinkPluginInstanceOutput(sink);
+    } else {
+        PluginInterface::deleteSampleSinkPluginInstanceOutput(sink);
+    }
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleMIMO(const OriginDevices& originDevices)
+{
+    PluginInterface *p = plugin();
+    return p ? p->enumSampleMIMO(originDevices) : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleMIMOPluginInstanceGUI(mimoId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleMIMO* PluginProxy::createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *p = plugin();
+    return p ? p->createSampleMIMOPluginInstance(mimoId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleMIMOPluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleMIMOPluginInstanceGUI(ui);
+    } else {
+        PluginInterface::deleteSampleMIMOPluginInstanceGUI(ui);
+    }
+}
+
+void PluginProxy::deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo)
+{
+    PluginInterface *p = plugin();
+    if (p) {
+        p->deleteSampleMIMOPluginInstanceMIMO(mimo);
+    } else {
+        PluginInterface::deleteSampleMIMOPluginInstanceMIMO(mimo);
+    }
+}
+
+DeviceWebAPIAdapter* PluginProxy::createDeviceWebAPIAdapter() const
+{
+    PluginInterface *p = plugin();
+    return p ? p->createDeviceWebAPIAdapter() : nullptr;
+}
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Stand in for a plugin library. The descriptor and the registrations of the    //
+// plugin are known from the plugins manifest so that the library is loaded only //
+// when one of its channels or devices is used for the first time.               //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_PLUGINPROXY_H
+#define INCLUDE_PLUGINPROXY_H
+
+#include <vector>
+
+#include <QString>
+#include <QMutex>
+#include <QJsonObject>
+
+#include "plugin/plugininterface.h"
+#include "export.h"
+
+class PluginManager;
+
+class SDRBASE_API PluginProxy : public PluginInterface
+{
+public:
+    enum RegistrationType
+    {
+        RegistrationRxChannel,
+        RegistrationTxChannel,
+        RegistrationMIMOChannel,
+        RegistrationSampleSource,
+        RegistrationSampleSink,
+        RegistrationSampleMIMO
+    };
+
+    struct Registration
+    {
+        RegistrationType m_type;
+        QString m_idURI; //!< Channel type ID in URI form or device ID
+        QString m_id;    //!< Channel type ID in short form. Empty for devices.
+    };
+
+    PluginProxy(PluginManager *pluginManager, const QString& filePath, PluginInterface *plugin); //!< library already loaded
+    PluginProxy(PluginManager *pluginManager, const QString& filePath, const QJsonObject& manifestEntry);
+    virtual ~PluginProxy();
+
+    static bool isManifestEntryValid(const QJsonObject& manifestEntry, const QString& filePath); //!< same file size and modification time
+    QJsonObject getManifestEntry() const;
+    bool isLoaded() const { return m_plugin != nullptr; }
+    const QString& getFilePath() const { return m_filePath; }
+    void load() const; //!< loads the library if not done yet. Main thread only.
+    bool addRegistration(RegistrationType type, const QString& idURI, const QString& id); //!< false if already registered
+
+    virtual const PluginDescriptor& getPluginDescriptor() const;
+    virtual void initPlugin(PluginAPI* pluginAPI);
+
+    virtual PluginInstanceGUI* createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const;
+    virtual BasebandSampleSink* createRxChannelBS(DeviceAPI *deviceAPI) const;
+    virtual ChannelAPI* createRxChannelCS(DeviceAPI *deviceAPI) const;
+    virtual PluginInstanceGUI* createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel) const;
+    virtual BasebandSampleSource* createTxChannelBS(DeviceAPI *deviceAPI) const;
+    virtual ChannelAPI* createTxChannelCS(DeviceAPI *deviceAPI) const;
+    virtual PluginInstanceGUI* createMIMOChannelGUI(DeviceUISet *deviceUISet, MIMOChannel *mimoChannel) const;
+    virtual MIMOChannel* createMIMOChannelBS(DeviceAPI *deviceAPI) const;
+    virtual ChannelAPI* createMIMOChannelCS(DeviceAPI *deviceAPI) const;
+    virtual ChannelWebAPIAdapter* createChannelWebAPIAdapter() const;
+
+    virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+
+    virtual SamplingDevices enumSampleSources(const OriginDevices& originDevices);
+    virtual PluginInstanceGUI* createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSource* createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSourcePluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source);
+
+    virtual SamplingDevices enumSampleSinks(const OriginDevices& originDevices);
+    virtual PluginInstanceGUI* createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSink* createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSinkPluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink);
+
+    virtual SamplingDevices enumSampleMIMO(const OriginDevices& originDevices);
+    virtual PluginInstanceGUI* createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleMIMO* createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleMIMOPluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo);
+
+    virtual DeviceWebAPIAdapter* createDeviceWebAPIAdapter() const;
+
+private:
+    PluginManager *m_pluginManager;
+    QString m_filePath;
+    PluginDescriptor *m_descriptor;          //!< from the manifest when the library is not loaded
+    std::vector<Registration> m_registrations;
+    PluginAPI *m_pluginAPI;
+    mutable PluginInterface *m_plugin;
+    mutable bool m_loadFailed;
+    mutable QMutex m_mutex;
+
+    PluginInterface *plugin() const; //!< loads the library on first use. The loading is done on the main thread.
+};
+
+#endif // INCLUDE_PLUGINPROXY_H
@@ -1,5 +1,13 @@
 #include <QSettings>
 #include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
 
 #include "settings/mainsettings.h"
 #include "commands/command.h"
@@ -8,9 +16,13 @@
 
 MainSettings::MainSettings() :
     m_audioDeviceManager(nullptr),
-    m_ambeEngine(nullptr)
+    m_ambeEngine(nullptr),
+    m_nextPresetFileIndex(1)
 {
 	resetToDefaults();
+    // presets are kept one file each in a directory next to the settings file
+    QFileInfo settingsFileInfo(getFileLocation());
+    m_presetsDir = settingsFileInfo.absolutePath() + "/" + settingsFileInfo.completeBaseName() + "-presets";
     qInfo("MainSettings::MainSettings: settings file: format: %d location: %s", getFileFormat(), qPrintable(getFileLocation()));
 }
 
@@ -55,11 +67,17 @@ void MainSettings::load()
     }
 
 	QStringList groups = s.childGroups();
+	bool presetStore = loadPresetStore();
 
 	for(int i = 0; i < groups.size(); ++i)
 	{
 		if (groups[i].startsWith("preset"))
 		{
+		    if (presetStore) {
+		        continue; // leftovers of the settings file presets
+		    }
+
+			// presets of the settings file go to the presets store on next save
 			s.beginGroup(groups[i]);
 			Preset* preset = new Preset;
 
@@ -114,20 +132,12 @@ void MainSettings::save() const
 
 	for(int i = 0; i < groups.size(); ++i)
 	{
-		if ((groups[i].startsWith("preset")) || (groups[i].startsWith("command")))
+		if (groups[i].startsWith("command"))
 		{
 			s.remove(groups[i]);
 		}
 	}
 
-	for (int i = 0; i < m_presets.count(); ++i)
-	{
-		QString group = QString("preset-%1").arg(i + 1);
-		s.beginGroup(group);
-		s.setValue("data", qCompress(m_presets[i]->serialize()).toBase64());
-		s.endGroup();
-	}
-
     for (int i = 0; i < m_commands.count(); ++i)
     {
         QString group = QString("command-%1").arg(i + 1);
@@ -137,6 +147,177 @@ void MainSettings::save() const
     }
 
     s.setValue("hwDeviceUserArgs", qCompress(m_hardwareDeviceUserArgs.serialize()).toBase64());
+
+    // presets of the settings file are kept until the presets store holds them all
+    if (savePresetStore())
+    {
+        for(int i = 0; i < groups.size(); ++i)
+        {
+            if (groups[i].startsWith("preset")) {
+                s.remove(groups[i]);
+            }
+        }
+    }
+}
+
+bool MainSettings::loadPresetStore()
+{
+    QFile indexFile(m_presetsDir + "/index.json");
+
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    m_presetsIndex = indexFile.readAll();
+    QJsonArray entries = QJsonDocument::fromJson(m_presetsIndex).array();
+
+    for (int i = 0; i < entries.size(); i++)
+    {
+        QJsonObject entry = entries[i].toObject();
+        QString fileName = entry["file"].toString();
+
+        if (fileName.isEmpty() || m_presetStore.contains(fileName)) {
+            continue;
+        }
+
+        PresetStoreEntry storeEntry;
+        storeEntry.m_group = entry["group"].toString();
+        storeEntry.m_description = entry["description"].toString();
+        storeEntry.m_centerFrequency = entry["centerFrequency"].toVariant().toULongLong();
+        storeEntry.m_presetType = entry["type"].toInt();
+        storeEntry.m_digest = QByteArray::fromHex(entry["digest"].toString().toLatin1());
+        m_presetStore.insert(fileName, storeEntry);
+
+        // only the index is known until the preset is used
+        Preset *preset = new Preset();
+        preset->setGroup(storeEntry.m_group);
+        preset->setDescription(storeEntry.m_description);
+        preset->setCenterFrequency(storeEntry.m_centerFrequency);
+        preset->setPresetType((Preset::PresetType) storeEntry.m_presetType);
+        preset->setStoreFile(m_presetsDir + "/" + fileName, false);
+        m_presets.append(preset);
+
+        int fileIndex = fileName.section('.', 0, 0).section('-', 1).toInt();
+        m_nextPresetFileIndex = fileIndex >= m_nextPresetFileIndex ? fileIndex + 1 : m_nextPresetFileIndex;
+    }
+
+    qDebug("MainSettings::loadPresetStore: %d presets in %s", m_presetStore.size(), qPrintable(m_presetsDir));
+    return true;
+}
+
+bool MainSettings::savePresetStore() const
+{
+    if (!QDir().mkpath(m_presetsDir))
+    {
+        qWarning("MainSettings::savePresetStore: cannot create %s", qPrintable(m_presetsDir));
+        return false;
+    }
+
+    QJsonArray entries;
+    QMap<QString, PresetStoreEntry> presetStore;
+    int nbWritten = 0;
+    int nbFailed = 0;
+
+    for (int i = 0; i < m_presets.count(); ++i)
+    {
+        Preset *preset = m_presets[i];
+        QString fileName;
+
+        if (preset->getStoreFileName().isEmpty())
+        {
+            fileName = QString("preset-%1.dat").arg(m_nextPresetFileIndex++);
+            preset->setStoreFile(m_presetsDir + "/" + fileName, true);
+        }
+        else
+        {
+            fileName = QFileInfo(preset->getStoreFileName()).fileName();
+        }
+
+        PresetStoreEntry storeEntry = m_presetStore.value(fileName);
+        bool indexChanged = (storeEntry.m_group != preset->getGroup())
+            || (storeEntry.m_description != preset->getDescription())
+            || (storeEntry.m_centerFrequency != preset->getCenterFrequency())
+            || (storeEntry.m_presetType != (int) preset->getPresetType());
+
+        // a preset that has not been used since it was loaded cannot have changed but for its index
+        // and one whose file could not be read only has the defaults to write
+        if ((preset->isBodyLoaded() || indexChanged) && !preset->isBodyUnreadable())
+        {
+            QByteArray data = preset->serialize();
+            QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+            if (digest != storeEntry.m_digest)
+            {
+                QSaveFile presetFile(preset->getStoreFileName());
+
+                if (presetFile.open(QIODevice::WriteOnly)
+                    && (presetFile.write(qCompress(data)) >= 0)
+                    && presetFile.commit())
+                {
+                    storeEntry.m_digest = digest;
+                    nbWritten++;
+                }
+                else
+                {
+                    qWarning("MainSettings::savePresetStore: cannot write %s", qPrintable(preset->getStoreFileName()));
+                    nbFailed++;
+                }
+            }
+        }
+
+        storeEntry.m_group = preset->getGroup();
+        storeEntry.m_description = preset->getDescription();
+        storeEntry.m_centerFrequency = preset->getCenterFrequency();
+        storeEntry.m_presetType = (int) preset->getPresetType();
+        presetStore.insert(fileName, storeEntry);
+
+        QJsonObject entry;
+        entry["file"] = fileName;
+        entry["group"] = storeEntry.m_group;
+        entry["description"] = storeEntry.m_description;
+        entry["centerFrequency"] = (double) storeEntry.m_centerFrequency;
+        entry["type"] = storeEntry.m_presetType;
+        entry["digest"] = QString(storeEntry.m_digest.toHex());
+        entries.append(entry);
+    }
+
+    if (nbFailed > 0)
+    {
+        // the index and the files of the deleted presets stay as they are until a complete save
+        qWarning("MainSettings::savePresetStore: %d of %d presets not written", nbFailed, m_presets.count());
+        return false;
+    }
+
+    QByteArray presetsIndex = QJsonDocument(entries).toJson();
+
+    if (presetsIndex != m_presetsIndex)
+    {
+        QSaveFile indexFile(m_presetsDir + "/index.json");
+
+        if (indexFile.open(QIODevice::WriteOnly)
+            && (indexFile.write(presetsIndex) >= 0)
+            && indexFile.commit())
+        {
+            m_presetsIndex = presetsIndex;
+        }
+        else
+        {
+            qWarning("MainSettings::savePresetStore: cannot write %s/index.json", qPrintable(m_presetsDir));
+            return false;
+        }
+    }
+
+    // files of the deleted presets
+    for (QMap<QString, PresetStoreEntry>::const_iterator it = m_presetStore.begin(); it != m_presetStore.end(); ++it)
+    {
+        if (!presetStore.contains(it.key())) {
+            QFile::remove(m_presetsDir + "/" + it.key());
+        }
+    }
+
+    m_presetStore = presetStore;
+    qDebug("MainSettings::savePresetStore: %d of %d presets written", nbWritten, m_presets.count());
+    return true;
 }
 
 void MainSettings::initialize()
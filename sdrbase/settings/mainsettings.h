@@ -2,6 +2,9 @@
 #define INCLUDE_SETTINGS_H
 
 #include <QString>
+#include <QMap>
+#include <QByteArray>
+
 #include "device/deviceuserargs.h"
 #include "preferences.h"
 #include "preset.h"
@@ -23,6 +26,7 @@ public:
     void initialize();
 	QString getFileLocation() const;
 	int getFileFormat() const; //!< see QSettings::Format for the values
+	const QString& getPresetsLocation() const { return m_presetsDir; }
 
     const Preferences& getPreferences() const { return m_preferences; }
     void setPreferences(const Preferences& preferences) { m_preferences = preferences; }
@@ -84,6 +88,30 @@ protected:
     Commands m_commands;
 	DeviceUserArgs m_hardwareDeviceUserArgs;
     AMBEEngine *m_ambeEngine;
+
+private:
+    /** Index entry of a preset as last written in the presets store */
+    struct PresetStoreEntry
+    {
+        QString m_group;
+        QString m_description;
+        quint64 m_centerFrequency;
+        int m_presetType;
+        QByteArray m_digest; //!< of the serialized preset
+
+        PresetStoreEntry() :
+            m_centerFrequency(0),
+            m_presetType(-1)
+        {}
+    };
+
+    QString m_presetsDir;
+    mutable QMap<QString, PresetStoreEntry> m_presetStore; //!< by preset file name
+    mutable QByteArray m_presetsIndex;                     //!< index file contents as last read or written
+    mutable int m_nextPresetFileIndex;
+
+    bool loadPresetStore();
+    bool savePresetStore() const; //!< true when all presets and the index are on disk
 };
 
 #endif // INCLUDE_SETTINGS_H
@@ -18,6 +18,15 @@ void Preferences::resetToDefaults()
 	m_logFileName = "sdrangel.log";
 	m_consoleMinLogLevel = QtDebugMsg;
     m_fileMinLogLevel = QtDebugMsg;
+    m_recordNbBuffers = 32;
+    m_recordBufferSize = 2048;
+    m_recordDirectIO = false;
+    m_recordPreallocation = 0;
+    m_recordMaxFileSize = 0;
+    m_recordMaxFileSeconds = 0;
+    m_recordSigMF = false;
+    m_recordSigMFPackingBits = 0;
+    m_recordSigMFCompressed = false;
 }
 
 QByteArray Preferences::serialize() const
@@ -33,6 +42,15 @@ QByteArray Preferences::serialize() const
 	s.writeBool(9, m_useLogFile);
 	s.writeString(10, m_logFileName);
     s.writeS32(11, (int) m_fileMinLogLevel);
+    s.writeU32(12, m_recordNbBuffers);
+    s.writeU32(13, m_recordBufferSize);
+    s.writeBool(14, m_recordDirectIO);
+    s.writeU32(15, m_recordPreallocation);
+    s.writeU32(16, m_recordMaxFileSize);
+    s.writeU32(17, m_recordMaxFileSeconds);
+    s.writeBool(18, m_recordSigMF);
+    s.writeU32(19, m_recordSigMFPackingBits);
+    s.writeBool(20, m_recordSigMFCompressed);
 	return s.final();
 }
 
@@ -83,6 +101,16 @@ bool Preferences::deserialize(const QByteArray& data)
             m_fileMinLogLevel = QtDebugMsg;
         }
 
+        d.readU32(12, &m_recordNbBuffers, 32);
+        d.readU32(13, &m_recordBufferSize, 2048);
+        d.readBool(14, &m_recordDirectIO, false);
+        d.readU32(15, &m_recordPreallocation, 0);
+        d.readU32(16, &m_recordMaxFileSize, 0);
+        d.readU32(17, &m_recordMaxFileSeconds, 0);
+        d.readBool(18, &m_recordSigMF, false);
+        d.readU32(19, &m_recordSigMFPackingBits, 0);
+        d.readBool(20, &m_recordSigMFCompressed, false);
+
 		return true;
 	} else
 	{
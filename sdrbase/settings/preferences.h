@@ -37,6 +37,25 @@ public:
 	bool getUseLogFile() const { return m_useLogFile; }
 	const QString& getLogFileName() const { return m_logFileName; }
 
+	void setRecordNbBuffers(quint32 nbBuffers) { m_recordNbBuffers = nbBuffers; }
+	void setRecordBufferSize(quint32 bufferSize) { m_recordBufferSize = bufferSize; }
+	void setRecordDirectIO(bool directIO) { m_recordDirectIO = directIO; }
+	void setRecordPreallocation(quint32 preallocation) { m_recordPreallocation = preallocation; }
+	void setRecordMaxFileSize(quint32 maxFileSize) { m_recordMaxFileSize = maxFileSize; }
+	void setRecordMaxFileSeconds(quint32 maxFileSeconds) { m_recordMaxFileSeconds = maxFileSeconds; }
+	void setRecordSigMF(bool sigMF) { m_recordSigMF = sigMF; }
+	void setRecordSigMFPackingBits(quint32 packingBits) { m_recordSigMFPackingBits = packingBits; }
+	void setRecordSigMFCompressed(bool compressed) { m_recordSigMFCompressed = compressed; }
+	quint32 getRecordNbBuffers() const { return m_recordNbBuffers; }
+	quint32 getRecordBufferSize() const { return m_recordBufferSize; }
+	bool getRecordDirectIO() const { return m_recordDirectIO; }
+	quint32 getRecordPreallocation() const { return m_recordPreallocation; }
+	quint32 getRecordMaxFileSize() const { return m_recordMaxFileSize; }
+	quint32 getRecordMaxFileSeconds() const { return m_recordMaxFileSeconds; }
+	bool getRecordSigMF() const { return m_recordSigMF; }
+	quint32 getRecordSigMFPackingBits() const { return m_recordSigMFPackingBits; }
+	bool getRecordSigMFCompressed() const { return m_recordSigMFCompressed; }
+
 protected:
 	QString m_sourceDevice; //!< Identification of the source used in R0 tab (GUI flavor) at startup
 	int m_sourceIndex;      //!< Index of the source used in R0 tab (GUI flavor) at startup
@@ -51,6 +70,16 @@ protected:
     QtMsgType m_fileMinLogLevel;
 	bool m_useLogFile;
 	QString m_logFileName;
+
+	quint32 m_recordNbBuffers;      //!< Buffers between the DSP and the disk writer threads of a recording
+	quint32 m_recordBufferSize;     //!< Size of a recording buffer (kB)
+	bool m_recordDirectIO;          //!< Bypass the page cache when writing a recording where supported
+	quint32 m_recordPreallocation;  //!< Disk space reserved when a recording file is opened (MB)
+	quint32 m_recordMaxFileSize;    //!< A recording continues in a new file past this size (MB). 0 for no limit.
+	quint32 m_recordMaxFileSeconds; //!< A recording continues in a new file past this duration (s). 0 for no limit.
+	bool m_recordSigMF;             //!< Generated recording file names are SigMF records instead of .sdriq files
+	quint32 m_recordSigMFPackingBits; //!< Bits kept per I or Q component of the SigMF samples. 0 for no packing.
+	bool m_recordSigMFCompressed;   //!< SigMF samples are compressed by chunks
 };
 
 #endif // INCLUDE_PREFERENCES_H
@@ -21,23 +21,45 @@
 #include "settings/preset.h"
 
 #include <QDebug>
+#include <QFile>
 
-Preset::Preset()
+Preset::Preset() :
+    m_bodyLoaded(true),
+    m_bodyUnreadable(false)
 {
 	resetToDefaults();
 }
 
 Preset::Preset(const Preset& other) :
-	m_group(other.m_group),
-	m_description(other.m_description),
-	m_centerFrequency(other.m_centerFrequency),
-	m_spectrumConfig(other.m_spectrumConfig),
-	m_dcOffsetCorrection(other.m_dcOffsetCorrection),
-	m_iqImbalanceCorrection(other.m_iqImbalanceCorrection),
-	m_channelConfigs(other.m_channelConfigs),
-	m_deviceConfigs(other.m_deviceConfigs),
-	m_layout(other.m_layout)
-{}
+    m_bodyLoaded(true),
+    m_bodyUnreadable(false)
+{
+    *this = other;
+}
+
+Preset& Preset::operator=(const Preset& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    other.loadBody();
+    m_presetType = other.m_presetType;
+	m_group = other.m_group;
+	m_description = other.m_description;
+	m_centerFrequency = other.m_centerFrequency;
+	m_spectrumConfig = other.m_spectrumConfig;
+	m_dcOffsetCorrection = other.m_dcOffsetCorrection;
+	m_iqImbalanceCorrection = other.m_iqImbalanceCorrection;
+	m_channelConfigs = other.m_channelConfigs;
+	m_deviceConfigs = other.m_deviceConfigs;
+	m_layout = other.m_layout;
+    // a copy is not backed by the store file of the original
+    m_storeFileName.clear();
+    m_bodyLoaded = true;
+    m_bodyUnreadable = false;
+    return *this;
+}
 
 void Preset::resetToDefaults()
 {
@@ -50,6 +72,39 @@ void Preset::resetToDefaults()
 	m_channelConfigs.clear();
 	m_dcOffsetCorrection = false;
 	m_iqImbalanceCorrection = false;
+	m_bodyLoaded = true;
+}
+
+void Preset::readBody() const
+{
+    // presets of the store are not const objects, only their body is deserialized here
+    Preset *preset = const_cast<Preset*>(this);
+
+    QFile file(m_storeFileName);
+    QByteArray data;
+
+    if (file.open(QIODevice::ReadOnly)) {
+        data = qUncompress(file.readAll());
+    }
+
+    // the store index prevails for the group, description, center frequency and type
+    PresetType presetType = m_presetType;
+    QString group = m_group;
+    QString description = m_description;
+    quint64 centerFrequency = m_centerFrequency;
+
+    if (!preset->deserialize(data))
+    {
+        // the defaults are used from now on but the file is left as it is
+        qWarning("Preset::readBody: cannot read preset body from %s: it will not be saved", qPrintable(m_storeFileName));
+        preset->m_bodyLoaded = false;
+        preset->m_bodyUnreadable = true;
+    }
+
+    preset->m_presetType = presetType;
+    preset->m_group = group;
+    preset->m_description = description;
+    preset->m_centerFrequency = centerFrequency;
 }
 
 QByteArray Preset::serialize() const
@@ -60,6 +115,7 @@ QByteArray Preset::serialize() const
 //			qPrintable(m_description),
 //			m_centerFrequency);
 
+	loadBody();
 	SimpleSerializer s(1);
 
 	s.writeString(1, m_group);
@@ -107,6 +163,7 @@ QByteArray Preset::serialize() const
 bool Preset::deserialize(const QByteArray& data)
 {
 	SimpleDeserializer d(data);
+	m_bodyLoaded = true;
 
 	if (!d.isValid())
 	{
@@ -187,6 +244,7 @@ bool Preset::deserialize(const QByteArray& data)
 			m_channelConfigs.append(ChannelConfig(channel, config));
 		}
 
+		m_bodyUnreadable = false;
 		return true;
 	}
 	else
@@ -201,6 +259,7 @@ void Preset::addOrUpdateDeviceConfig(const QString& sourceId,
 		int sourceSequence,
 		const QByteArray& config)
 {
+	modifyBody();
 	DeviceeConfigs::iterator it = m_deviceConfigs.begin();
 
 	for (; it != m_deviceConfigs.end(); ++it)
@@ -239,6 +298,7 @@ const QByteArray* Preset::findDeviceConfig(
         const QString& deviceSerial,
         int deviceSequence) const
 {
+    loadBody();
     DeviceeConfigs::const_iterator it = m_deviceConfigs.begin();
 
     for (; it != m_deviceConfigs.end(); ++it)
@@ -256,6 +316,8 @@ const QByteArray* Preset::findBestDeviceConfig(
 		const QString& sourceSerial,
 		int sourceSequence) const
 {
+	loadBody();
+
 	// Special case for SoapySDR based on serial (driver name)
 	if (sourceId == "sdrangel.samplesource.soapysdrinput") {
 		return findBestDeviceConfigSoapy(sourceId, sourceSerial);
@@ -66,6 +66,7 @@ public:
 
 	Preset();
 	Preset(const Preset& other);
+	Preset& operator=(const Preset& other);
 
 	void resetToDefaults();
 
@@ -88,28 +89,34 @@ public:
 	void setCenterFrequency(const quint64 centerFrequency) { m_centerFrequency = centerFrequency; }
 	quint64 getCenterFrequency() const { return m_centerFrequency; }
 
-	void setSpectrumConfig(const QByteArray& data) { m_spectrumConfig = data; }
-	const QByteArray& getSpectrumConfig() const { return m_spectrumConfig; }
+	void setSpectrumConfig(const QByteArray& data) { modifyBody(); m_spectrumConfig = data; }
+	const QByteArray& getSpectrumConfig() const { loadBody(); return m_spectrumConfig; }
 
-	bool hasDCOffsetCorrection() const { return m_dcOffsetCorrection; }
-    void setDCOffsetCorrection(bool dcOffsetCorrection) { m_dcOffsetCorrection = dcOffsetCorrection; }
-	bool hasIQImbalanceCorrection() const { return m_iqImbalanceCorrection; }
-    void setIQImbalanceCorrection(bool iqImbalanceCorrection) { m_iqImbalanceCorrection = iqImbalanceCorrection; }
+	bool hasDCOffsetCorrection() const { loadBody(); return m_dcOffsetCorrection; }
+    void setDCOffsetCorrection(bool dcOffsetCorrection) { modifyBody(); m_dcOffsetCorrection = dcOffsetCorrection; }
+	bool hasIQImbalanceCorrection() const { loadBody(); return m_iqImbalanceCorrection; }
+    void setIQImbalanceCorrection(bool iqImbalanceCorrection) { modifyBody(); m_iqImbalanceCorrection = iqImbalanceCorrection; }
 
-	void setLayout(const QByteArray& data) { m_layout = data; }
-	const QByteArray& getLayout() const { return m_layout; }
+	void setLayout(const QByteArray& data) { modifyBody(); m_layout = data; }
+	const QByteArray& getLayout() const { loadBody(); return m_layout; }
 
-	void clearChannels() { m_channelConfigs.clear(); }
-	void addChannel(const QString& channel, const QByteArray& config) { m_channelConfigs.append(ChannelConfig(channel, config)); }
-	int getChannelCount() const { return m_channelConfigs.count(); }
-	const ChannelConfig& getChannelConfig(int index) const { return m_channelConfigs.at(index); }
+	void clearChannels() { modifyBody(); m_channelConfigs.clear(); }
+	void addChannel(const QString& channel, const QByteArray& config) { modifyBody(); m_channelConfigs.append(ChannelConfig(channel, config)); }
+	int getChannelCount() const { loadBody(); return m_channelConfigs.count(); }
+	const ChannelConfig& getChannelConfig(int index) const { loadBody(); return m_channelConfigs.at(index); }
 
-    void clearDevices() { m_deviceConfigs.clear(); }
+    void clearDevices() { modifyBody(); m_deviceConfigs.clear(); }
 	void setDeviceConfig(const QString& deviceId, const QString& deviceSerial, int deviceSequence, const QByteArray& config) {
 		addOrUpdateDeviceConfig(deviceId, deviceSerial, deviceSequence, config);
 	}
-    int getDeviceCount() const { return m_deviceConfigs.count(); }
-    const DeviceConfig& getDeviceConfig(int index) const { return m_deviceConfigs.at(index); }
+    int getDeviceCount() const { loadBody(); return m_deviceConfigs.count(); }
+    const DeviceConfig& getDeviceConfig(int index) const { loadBody(); return m_deviceConfigs.at(index); }
+
+    /** The body (everything but the group, description, center frequency and type) is read from the store file on first use */
+    void setStoreFile(const QString& fileName, bool bodyLoaded) { m_storeFileName = fileName; m_bodyLoaded = bodyLoaded; m_bodyUnreadable = false; }
+    const QString& getStoreFileName() const { return m_storeFileName; }
+    bool isBodyLoaded() const { return m_bodyLoaded; }
+    bool isBodyUnreadable() const { return m_bodyUnreadable; } //!< the store file could not be read: it must not be written back
 
 	void addOrUpdateDeviceConfig(const QString& deviceId,
 			const QString& deviceSerial,
@@ -166,7 +173,15 @@ protected:
 	// screen and dock layout
 	QByteArray m_layout;
 
+	// preset store file (see MainSettings)
+	QString m_storeFileName;
+	bool m_bodyLoaded;
+	bool m_bodyUnreadable;
+
 private:
+	void loadBody() const { if (!m_bodyLoaded && !m_bodyUnreadable) { readBody(); } }
+	void modifyBody() { loadBody(); m_bodyLoaded = true; m_bodyUnreadable = false; } //!< the body is changed: it has to be saved even if the store file could not be read
+	void readBody() const;
 	const QByteArray* findBestDeviceConfigSoapy(const QString& sourceId, const QString& deviceSerial) const;
 };
 
@@ -24,7 +24,8 @@
 const char* Message::m_identifier = 0;
 
 Message::Message() :
-	m_destination(0)
+	m_destination(0),
+	m_queueNext(nullptr)
 {
 }
 
@@ -46,3 +47,8 @@ bool Message::match(const Message* message)
 {
 	return message->matchIdentifier(m_identifier);
 }
+
+quint32 Message::getTypeId() const
+{
+	return typeId("Message");
+}
@@ -20,8 +20,16 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <cstddef>
+
+#include <QtGlobal>
+#include <QAtomicPointer>
+
+#include "util/messagepool.h"
 #include "export.h"
 
+class MessageQueue;
+
 class SDRBASE_API Message {
 public:
 	Message();
@@ -30,14 +38,29 @@ public:
 	virtual const char* getIdentifier() const;
 	virtual bool matchIdentifier(const char* identifier) const;
 	static bool match(const Message* message);
+	virtual quint32 getTypeId() const; //!< Identifier of the exact message class for switch dispatch (see MESSAGE_TYPE_ID)
 
 	void* getDestination() const { return m_destination; }
 	void setDestination(void *destination) { m_destination = destination; }
 
+	// messages are taken from and returned to free lists by size class
+	static void* operator new(std::size_t size) { return MessagePool::allocate(size); }
+	static void operator delete(void *block, std::size_t size) { MessagePool::release(block, size); }
+
+	/** FNV-1a hash of the class name given to MESSAGE_CLASS_DEFINITION evaluated at compile time */
+	static constexpr quint32 typeId(const char *name, quint32 hash = 2166136261u)
+	{
+		return *name == 0 ? hash : typeId(name + 1, (hash ^ (quint32) (unsigned char) *name) * 16777619u);
+	}
+
 protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	QAtomicPointer<Message> m_queueNext; //!< link in the MessageQueue the message is pushed to
+	friend class MessageQueue;
 };
 
 #define MESSAGE_CLASS_DECLARATION \
@@ -45,6 +68,7 @@ protected:
 		const char* getIdentifier() const; \
 		bool matchIdentifier(const char* identifier) const; \
 		static bool match(const Message& message); \
+		quint32 getTypeId() const; \
 	protected: \
 		static const char* m_identifier; \
 	private:
@@ -55,6 +79,13 @@ protected:
 	bool Name::matchIdentifier(const char* identifier) const {\
 		return (m_identifier == identifier) ? true : BaseClass::matchIdentifier(identifier); \
 	} \
-	bool Name::match(const Message& message) { return message.matchIdentifier(m_identifier); }
+	bool Name::match(const Message& message) { return message.matchIdentifier(m_identifier); } \
+	quint32 Name::getTypeId() const { return Message::typeId(#Name); }
+
+/**
+ * Case label of a switch on Message::getTypeId(). Name is spelled as in MESSAGE_CLASS_DEFINITION.
+ * Unlike match() the exact class is matched not the classes derived from it.
+ */
+#define MESSAGE_TYPE_ID(Name) Message::typeId(#Name)
 
 #endif // INCLUDE_MESSAGE_H
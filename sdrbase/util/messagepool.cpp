@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Free lists of message blocks. Messages are allocated and deleted at a high    //
+// rate by control and report traffic. Released blocks are kept by size class   //
+// and reused by the next message of the same size class instead of going       //
+// back to the heap.                                                             //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+
+#include <QGlobalStatic>
+
+#include "util/messagepool.h"
+
+Q_GLOBAL_STATIC(MessagePool, messagePool)
+
+const std::size_t MessagePool::m_granularity;
+const unsigned int MessagePool::m_nbClasses;
+const unsigned int MessagePool::m_maxBlocks;
+
+MessagePool::MessagePool()
+{
+    for (unsigned int i = 0; i < m_nbClasses; i++)
+    {
+        m_freeLists[i].m_head = nullptr;
+        m_freeLists[i].m_count = 0;
+    }
+}
+
+MessagePool::~MessagePool()
+{
+    for (unsigned int i = 0; i < m_nbClasses; i++)
+    {
+        while (m_freeLists[i].m_head)
+        {
+            Block *block = m_freeLists[i].m_head;
+            m_freeLists[i].m_head = block->m_next;
+            ::operator delete(block);
+        }
+    }
+}
+
+MessagePool *MessagePool::instance()
+{
+    // messages deleted during static destruction go back to the heap
+    return messagePool.isDestroyed() ? nullptr : messagePool();
+}
+
+void *MessagePool::allocate(std::size_t size)
+{
+    unsigned int sizeClass = (size + m_granularity - 1) / m_granularity;
+    MessagePool *pool = sizeClass < m_nbClasses ? instance() : nullptr;
+
+    if (pool)
+    {
+        FreeList& freeList = pool->m_freeLists[sizeClass];
+        freeList.m_lock.lock();
+        Block *block = freeList.m_head;
+
+        if (block)
+        {
+            freeList.m_head = block->m_next;
+            freeList.m_count--;
+        }
+
+        freeList.m_lock.unlock();
+
+        if (block) {
+            return block;
+        }
+
+        // blocks are allocated at the size of their class so that they can be reused by any message of the class
+        return ::operator new(sizeClass * m_granularity);
+    }
+
+    return ::operator new(size);
+}
+
+void MessagePool::release(void *block, std::size_t size)
+{
+    if (!block) {
+        return;
+    }
+
+    unsigned int sizeClass = (size + m_granularity - 1) / m_granularity;
+    MessagePool *pool = sizeClass < m_nbClasses ? instance() : nullptr;
+
+    if (pool)
+    {
+        FreeList& freeList = pool->m_freeLists[sizeClass];
+        freeList.m_lock.lock();
+
+        if (freeList.m_count < m_maxBlocks)
+        {
+            Block *freeBlock = (Block *) block;
+            freeBlock->m_next = freeList.m_head;
+            freeList.m_head = freeBlock;
+            freeList.m_count++;
+            freeList.m_lock.unlock();
+            return;
+        }
+
+        freeList.m_lock.unlock();
+    }
+
+    ::operator delete(block);
+}
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Free lists of message blocks. Messages are allocated and deleted at a high    //
+// rate by control and report traffic. Released blocks are kept by size class   //
+// and reused by the next message of the same size class instead of going       //
+// back to the heap.                                                             //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_MESSAGEPOOL_H_
+#define SDRBASE_UTIL_MESSAGEPOOL_H_
+
+#include <cstddef>
+
+#include "util/spinlock.h"
+#include "export.h"
+
+class SDRBASE_API MessagePool
+{
+public:
+    MessagePool();
+    ~MessagePool();
+
+    static void *allocate(std::size_t size);
+    static void release(void *block, std::size_t size); //!< size is the one given at allocation
+
+private:
+    struct Block
+    {
+        Block *m_next;
+    };
+
+    struct FreeList
+    {
+        Spinlock m_lock;
+        Block *m_head;
+        unsigned int m_count;
+    };
+
+    static const std::size_t m_granularity = 16;  //!< size class step in bytes
+    static const unsigned int m_nbClasses = 32;   //!< larger messages use the heap directly
+    static const unsigned int m_maxBlocks = 1024; //!< kept per size class
+
+    FreeList m_freeLists[m_nbClasses];
+
+    static MessagePool *instance();
+};
+
+#endif /* SDRBASE_UTIL_MESSAGEPOOL_H_ */
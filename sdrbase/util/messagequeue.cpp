@@ -23,8 +23,9 @@
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -39,13 +40,19 @@ MessageQueue::~MessageQueue()
 	}
 }
 
+void MessageQueue::link(Message* message)
+{
+	message->m_queueNext.store(nullptr);
+	Message* previous = m_head.fetchAndStoreAcqRel(message); // serialization point between producers
+	previous->m_queueNext.storeRelease(message);
+}
+
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddRelaxed(1);
+		link(message);
 	}
 
 	if (emitSignal)
@@ -56,30 +63,56 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	QMutexLocker locker(&m_popLock);
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
+
+	if (tail == &m_stub)
+	{
+		if (!next) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = tail->m_queueNext.loadAcquire();
+	}
 
-	if (m_queue.isEmpty())
+	if (next)
 	{
-		return 0;
+		m_tail = next;
+		m_size.fetchAndAddRelaxed(-1);
+		return tail;
+	}
+
+	if (tail != m_head.loadAcquire()) {
+		return 0; // a producer is linking its message: it signals when done
 	}
-	else
+
+	// the last message is only returned after the stub is pushed behind it
+	link(&m_stub);
+	next = tail->m_queueNext.loadAcquire();
+
+	if (next)
 	{
-		return m_queue.takeFirst();
+		m_tail = next;
+		m_size.fetchAndAddRelaxed(-1);
+		return tail;
 	}
+
+	return 0;
 }
 
 int MessageQueue::size()
 {
-	QMutexLocker locker(&m_lock);
-
-	return m_queue.size();
+	return m_size.loadAcquire();
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
 
-    while (!m_queue.isEmpty()) {
-        delete m_queue.takeFirst();
-    }
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
@@ -20,12 +20,17 @@
 #define INCLUDE_MESSAGEQUEUE_H
 
 #include <QObject>
-#include <QQueue>
 #include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include "util/message.h"
 #include "export.h"
 
-class Message;
-
+/**
+ * Multiple producers single consumer queue linking the messages themselves.
+ * Pushing never locks. Pops are serialized by a mutex which is not contended
+ * as messages are normally popped from the thread of the queue owner only.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -43,8 +48,13 @@ signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< last pushed message
+	Message* m_tail;                //!< next message to pop (consumer side)
+	Message m_stub;                 //!< keeps the list non empty
+	QAtomicInt m_size;
+	QMutex m_popLock;
+
+	void link(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
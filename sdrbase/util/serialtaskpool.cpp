@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QRunnable>
+#include <QThread>
+#include <QDebug>
+
+#include "serialtaskpool.h"
+
+// Processes the pending items of one queue until it is empty
+class SerialTaskPool::QueueTask : public QRunnable
+{
+public:
+    QueueTask(SerialTaskPool *pool, Queue *queue) :
+        m_pool(pool),
+        m_queue(queue)
+    {
+        setAutoDelete(true);
+    }
+
+    virtual void run() {
+        m_pool->runQueue(m_queue);
+    }
+
+private:
+    SerialTaskPool *m_pool;
+    Queue *m_queue;
+};
+
+SerialTaskPool::Queue::Queue() :
+    m_scheduled(false)
+{
+    m_stats.m_nbItems = 0;
+    m_stats.m_droppedItems = 0;
+    m_stats.m_processTimeAvg = 0.0f;
+    m_stats.m_processTimeMax = 0.0f;
+    m_stats.m_latencyAvg = 0.0f;
+    m_stats.m_latencyMax = 0.0f;
+}
+
+SerialTaskPool::Queue::~Queue()
+{
+    for (std::deque<Item*>::iterator it = m_items.begin(); it != m_items.end(); ++it) {
+        delete *it;
+    }
+
+    for (std::vector<Item*>::iterator it = m_freeItems.begin(); it != m_freeItems.end(); ++it) {
+        delete *it;
+    }
+}
+
+SerialTaskPool::SerialTaskPool(unsigned int maxQueuedItems) :
+    m_maxQueuedItems(maxQueuedItems)
+{
+    m_workers.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+    m_clock.start();
+}
+
+SerialTaskPool::~SerialTaskPool()
+{
+    m_workers.waitForDone();
+}
+
+void SerialTaskPool::addQueue(Queue *queue, const QString& name)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (std::find(m_queues.begin(), m_queues.end(), queue) == m_queues.end())
+    {
+        queue->m_stats.m_name = name;
+        m_queues.push_back(queue);
+        qDebug("SerialTaskPool::addQueue: %s: %d queues", qPrintable(name), (int) m_queues.size());
+    }
+}
+
+void SerialTaskPool::removeQueue(Queue *queue)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    dropItems(queue);
+
+    while (queue->m_scheduled) {
+        m_queueIdle.wait(&m_mutex);
+    }
+
+    m_queues.erase(std::remove(m_queues.begin(), m_queues.end(), queue), m_queues.end());
+    const QueueStats& stats = queue->m_stats;
+    qDebug("SerialTaskPool::removeQueue: %s: %llu items %llu dropped process avg %.0f max %.0f us latency avg %.0f max %.0f us",
+        qPrintable(stats.m_name), stats.m_nbItems, stats.m_droppedItems,
+        stats.m_processTimeAvg, stats.m_processTimeMax, stats.m_latencyAvg, stats.m_latencyMax);
+}
+
+void SerialTaskPool::drainQueue(Queue *queue)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    dropItems(queue);
+
+    while (queue->m_scheduled) {
+        m_queueIdle.wait(&m_mutex);
+    }
+}
+
+void SerialTaskPool::setQueueName(Queue *queue, const QString& name)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    queue->m_stats.m_name = name;
+}
+
+void SerialTaskPool::setMaxQueuedItems(unsigned int maxQueuedItems)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_maxQueuedItems = maxQueuedItems;
+}
+
+void SerialTaskPool::dropItems(Queue *queue)
+{
+    while (!queue->m_items.empty())
+    {
+        queue->m_freeItems.push_back(queue->m_items.front());
+        queue->m_items.pop_front();
+    }
+}
+
+SerialTaskPool::Item *SerialTaskPool::takeItem(Queue *queue)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (queue->m_freeItems.size() > 0)
+    {
+        Item *item = queue->m_freeItems.back();
+        queue->m_freeItems.pop_back();
+        return item;
+    }
+    else
+    {
+        return queue->createItem();
+    }
+}
+
+bool SerialTaskPool::submit(Queue *queue, Item *item)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    bool dropped = false;
+
+    if (queue->m_items.size() >= m_maxQueuedItems)
+    {
+        // late results are useless: the oldest item is sacrificed
+        queue->m_freeItems.push_back(queue->m_items.front());
+        queue->m_items.pop_front();
+        queue->m_stats.m_droppedItems++;
+        dropped = true;
+    }
+
+    item->m_submitTime = m_clock.nsecsElapsed();
+    queue->m_items.push_back(item);
+
+    if (!queue->m_scheduled)
+    {
+        queue->m_scheduled = true;
+        m_workers.start(new QueueTask(this, queue));
+    }
+
+    return !dropped;
+}
+
+void SerialTaskPool::runQueue(Queue *queue)
+{
+    m_mutex.lock();
+
+    while (!queue->m_items.empty())
+    {
+        Item *item = queue->m_items.front();
+        queue->m_items.pop_front();
+        m_mutex.unlock();
+
+        qint64 startTime = m_clock.nsecsElapsed();
+        queue->processItem(item);
+        qint64 endTime = m_clock.nsecsElapsed();
+
+        m_mutex.lock();
+        QueueStats& stats = queue->m_stats;
+        float processTime = (endTime - startTime) / 1000.0f;
+        float latency = (endTime - item->m_submitTime) / 1000.0f;
+        stats.m_nbItems++;
+        stats.m_processTimeAvg += (processTime - stats.m_processTimeAvg) / stats.m_nbItems;
+        stats.m_processTimeMax = std::max(stats.m_processTimeMax, processTime);
+        stats.m_latencyAvg += (latency - stats.m_latencyAvg) / stats.m_nbItems;
+        stats.m_latencyMax = std::max(stats.m_latencyMax, latency);
+        queue->m_freeItems.push_back(item);
+    }
+
+    queue->m_scheduled = false;
+    m_queueIdle.wakeAll();
+    m_mutex.unlock();
+}
+
+void SerialTaskPool::getQueueStats(Queue *queue, QueueStats& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats = queue->m_stats;
+}
+
+void SerialTaskPool::getQueueStats(std::vector<QueueStats>& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats.clear();
+
+    for (std::vector<Queue*>::const_iterator it = m_queues.begin(); it != m_queues.end(); ++it) {
+        stats.push_back((*it)->m_stats);
+    }
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_SERIALTASKPOOL_H_
+#define SDRBASE_UTIL_SERIALTASKPOOL_H_
+
+#include <vector>
+#include <deque>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QString>
+
+#include "export.h"
+
+/**
+ * Worker threads shared by many queues of items. The items of a queue are processed in order
+ * and one at a time while different queues are processed in parallel. A queue that cannot keep
+ * up drops its oldest pending item. Items are recycled by their queue so that submitting does
+ * not allocate once the queue has reached its working depth.
+ */
+class SDRBASE_API SerialTaskPool
+{
+public:
+    struct QueueStats
+    {
+        QString m_name;
+        quint64 m_nbItems;         //!< items processed
+        quint64 m_droppedItems;    //!< items dropped because the queue was late
+        float m_processTimeAvg;    //!< average processing time in microseconds
+        float m_processTimeMax;    //!< largest processing time in microseconds
+        float m_latencyAvg;        //!< average time from submission to the end of processing in microseconds
+        float m_latencyMax;        //!< largest latency in microseconds
+    };
+
+    /** Unit of work. Queues derive it with their own data. */
+    struct Item
+    {
+        qint64 m_submitTime;       //!< nanoseconds on the pool clock
+
+        Item() : m_submitTime(0) {}
+        virtual ~Item() {}
+    };
+
+    class Queue
+    {
+    public:
+        Queue();
+        virtual ~Queue();          //!< The queue must have been removed from its pool
+
+    protected:
+        virtual Item *createItem() = 0;            //!< called with the pool lock held
+        virtual void processItem(Item *item) = 0;  //!< called by a worker thread
+
+    private:
+        std::deque<Item*> m_items;
+        std::vector<Item*> m_freeItems;
+        bool m_scheduled;          //!< a worker is processing the items of the queue
+        QueueStats m_stats;
+
+        friend class SerialTaskPool;
+    };
+
+    SerialTaskPool(unsigned int maxQueuedItems);
+    ~SerialTaskPool();
+
+    void addQueue(Queue *queue, const QString& name);
+    void removeQueue(Queue *queue);  //!< Drops the pending items and waits for the item being processed
+    void drainQueue(Queue *queue);   //!< Same but the queue stays registered
+    void setQueueName(Queue *queue, const QString& name);
+    void setMaxQueuedItems(unsigned int maxQueuedItems);
+
+    /** Item to fill then to give to submit. Never waits for a worker. */
+    Item *takeItem(Queue *queue);
+    /** Queue the item for processing. Returns false if the oldest pending item was dropped. */
+    bool submit(Queue *queue, Item *item);
+
+    void getQueueStats(Queue *queue, QueueStats& stats);
+    void getQueueStats(std::vector<QueueStats>& stats);
+
+private:
+    class QueueTask;
+
+    QThreadPool m_workers;
+    QMutex m_mutex;                  //!< guards the queues, their items and their statistics
+    QWaitCondition m_queueIdle;
+    std::vector<Queue*> m_queues;
+    unsigned int m_maxQueuedItems;   //!< per queue
+    QElapsedTimer m_clock;
+
+    void runQueue(Queue *queue);
+    void dropItems(Queue *queue);
+};
+
+#endif /* SDRBASE_UTIL_SERIALTASKPOOL_H_ */
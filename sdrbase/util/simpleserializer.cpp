@@ -1,4 +1,6 @@
 #include <stdint.h>
+#include <algorithm>
+
 #include "util/simpleserializer.h"
 
 #if __WORDSIZE == 64
@@ -295,23 +297,28 @@ bool SimpleSerializer::writeTag(Type type, quint32 id, quint32 length)
 }
 
 SimpleDeserializer::SimpleDeserializer(const QByteArray& data) :
-	m_data(data)
+	m_data(data),
+	m_end(0),
+	m_ordered(true),
+	m_readOfs(0),
+	m_lastId(0),
+	m_version(0)
 {
 	m_valid = parseAll();
 
 	// read version information
 	uint readOfs;
-	Elements::const_iterator it = m_elements.constFind(0);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(0, &element))
 		goto setInvalid;
-	if(it->type != TVersion)
+	if(element.type != TVersion)
 		goto setInvalid;
-	if(it->length > 4)
+	if(element.length > 4)
 		goto setInvalid;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	m_version = 0;
-	for(uint i = 0; i < it->length; i++)
+	for(uint i = 0; i < element.length; i++)
 		m_version = (m_version << 8) | readByte(&readOfs);
 	return;
 
@@ -323,17 +330,17 @@ bool SimpleDeserializer::readS32(quint32 id, qint32* result, qint32 def) const
 {
 	uint readOfs;
 	qint32 tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TSigned32)
+	if(element.type != TSigned32)
 		goto returnDefault;
-	if(it->length > 4)
+	if(element.length > 4)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp = 0;
-	for(uint i = 0; i < it->length; i++) {
+	for(uint i = 0; i < element.length; i++) {
 		quint8 byte = readByte(&readOfs);
 		if((i == 0) && (byte & 0x80))
 			tmp = -1;
@@ -351,17 +358,17 @@ bool SimpleDeserializer::readU32(quint32 id, quint32* result, quint32 def) const
 {
 	uint readOfs;
 	quint32 tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TUnsigned32)
+	if(element.type != TUnsigned32)
 		goto returnDefault;
-	if(it->length > 4)
+	if(element.length > 4)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp = 0;
-	for(uint i = 0; i < it->length; i++)
+	for(uint i = 0; i < element.length; i++)
 		tmp = (tmp << 8) | readByte(&readOfs);
 	*result = tmp;
 	return true;
@@ -375,17 +382,17 @@ bool SimpleDeserializer::readS64(quint32 id, qint64* result, qint64 def) const
 {
 	uint readOfs;
 	qint64 tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TSigned64)
+	if(element.type != TSigned64)
 		goto returnDefault;
-	if(it->length > 8)
+	if(element.length > 8)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp = 0;
-	for(uint i = 0; i < it->length; i++) {
+	for(uint i = 0; i < element.length; i++) {
 		quint8 byte = readByte(&readOfs);
 		if((i == 0) && (byte & 0x80))
 			tmp = -1;
@@ -403,17 +410,17 @@ bool SimpleDeserializer::readU64(quint32 id, quint64* result, quint64 def) const
 {
 	uint readOfs;
 	quint64 tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TUnsigned64)
+	if(element.type != TUnsigned64)
 		goto returnDefault;
-	if(it->length > 8)
+	if(element.length > 8)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp = 0;
-	for(uint i = 0; i < it->length; i++)
+	for(uint i = 0; i < element.length; i++)
 		tmp = (tmp << 8) | readByte(&readOfs);
 	*result = tmp;
 	return true;
@@ -427,15 +434,15 @@ bool SimpleDeserializer::readFloat(quint32 id, float* result, float def) const
 {
 	uint readOfs;
 	union floatasint tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TFloat)
+	if(element.type != TFloat)
 		goto returnDefault;
-	if(it->length != 4)
+	if(element.length != 4)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp.u = 0;
 	for(int i = 0; i < 4; i++)
 		tmp.u = (tmp.u << 8) | readByte(&readOfs);
@@ -451,15 +458,15 @@ bool SimpleDeserializer::readDouble(quint32 id, double* result, double def) cons
 {
 	uint readOfs;
 	union doubleasint tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TDouble)
+	if(element.type != TDouble)
 		goto returnDefault;
-	if(it->length != 8)
+	if(element.length != 8)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp.u = 0;
 	for(int i = 0; i < 8; i++)
 		tmp.u = (tmp.u << 8) | readByte(&readOfs);
@@ -486,15 +493,15 @@ bool SimpleDeserializer::readReal(quint32 id, Real* result, Real def) const
 	if(sizeof(Real) == 4) {
 		uint readOfs;
 		union real4asint tmp;
-		Elements::const_iterator it = m_elements.constFind(id);
-		if(it == m_elements.constEnd())
+		Element element;
+		if(!findElement(id, &element))
 			goto returnDefault32;
-		if(it->type != TFloat)
+		if(element.type != TFloat)
 			goto returnDefault32;
-		if(it->length != 4)
+		if(element.length != 4)
 			goto returnDefault32;
 
-		readOfs = it->ofs;
+		readOfs = element.ofs;
 		tmp.u = 0;
 		for(int i = 0; i < 4; i++)
 			tmp.u = (tmp.u << 8) | readByte(&readOfs);
@@ -507,15 +514,15 @@ bool SimpleDeserializer::readReal(quint32 id, Real* result, Real def) const
 	} else {
 		uint readOfs;
 		union real8asint tmp;
-		Elements::const_iterator it = m_elements.constFind(id);
-		if(it == m_elements.constEnd())
+		Element element;
+		if(!findElement(id, &element))
 			goto returnDefault64;
-		if(it->type != TDouble)
+		if(element.type != TDouble)
 			goto returnDefault64;
-		if(it->length != 8)
+		if(element.length != 8)
 			goto returnDefault64;
 
-		readOfs = it->ofs;
+		readOfs = element.ofs;
 		tmp.u = 0;
 		for(int i = 0; i < 8; i++)
 			tmp.u = (tmp.u << 8) | readByte(&readOfs);
@@ -532,15 +539,15 @@ bool SimpleDeserializer::readBool(quint32 id, bool* result, bool def) const
 {
 	uint readOfs;
 	quint8 tmp;
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TBool)
+	if(element.type != TBool)
 		goto returnDefault;
-	if(it->length != 1)
+	if(element.length != 1)
 		goto returnDefault;
 
-	readOfs = it->ofs;
+	readOfs = element.ofs;
 	tmp = readByte(&readOfs);
 	if(tmp == 0x00)
 		*result = false;
@@ -554,13 +561,13 @@ returnDefault:
 
 bool SimpleDeserializer::readString(quint32 id, QString* result, const QString& def) const
 {
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TString)
+	if(element.type != TString)
 		goto returnDefault;
 
-	*result = QString::fromUtf8(m_data.data() + it->ofs, it->length);
+	*result = QString::fromUtf8(m_data.data() + element.ofs, element.length);
 	return true;
 
 returnDefault:
@@ -570,13 +577,13 @@ returnDefault:
 
 bool SimpleDeserializer::readBlob(quint32 id, QByteArray* result, const QByteArray& def) const
 {
-	Elements::const_iterator it = m_elements.constFind(id);
-	if(it == m_elements.constEnd())
+	Element element;
+	if(!findElement(id, &element))
 		goto returnDefault;
-	if(it->type != TBlob)
+	if(element.type != TBlob)
 		goto returnDefault;
 
-	*result = QByteArray(m_data.data() + it->ofs, it->length);
+	*result = QByteArray(m_data.data() + element.ofs, element.length);
 	return true;
 
 returnDefault:
@@ -593,68 +600,74 @@ void SimpleDeserializer::dump() const
 		qDebug("SimpleDeserializer dump: version %u", m_version);
 	}
 
-	for(Elements::const_iterator it = m_elements.constBegin(); it != m_elements.constEnd(); ++it) {
-		switch(it->type) {
+	uint readOfs = 0;
+	Element element;
+
+	while(readOfs < m_end) {
+		readTag(&readOfs, m_end, &element.type, &element.id, &element.length);
+		readOfs += element.length;
+
+		switch(element.type) {
 			case TSigned32: {
 				qint32 tmp;
-				readS32(it.key(), &tmp);
-				qDebug("id %d, S32, len %d: " PRINTF_FORMAT_S32, it.key(), it->length, tmp);
+				readS32(element.id, &tmp);
+				qDebug("id %d, S32, len %d: " PRINTF_FORMAT_S32, element.id, element.length, tmp);
 				break;
 			}
 			case TUnsigned32: {
 				quint32 tmp;
-				readU32(it.key(), &tmp);
-				qDebug("id %d, U32, len %d: " PRINTF_FORMAT_U32, it.key(), it->length, tmp);
+				readU32(element.id, &tmp);
+				qDebug("id %d, U32, len %d: " PRINTF_FORMAT_U32, element.id, element.length, tmp);
 				break;
 			}
 			case TSigned64: {
 				qint64 tmp;
-				readS64(it.key(), &tmp);
-//				qDebug("id %d, S64, len %d: " PRINTF_FORMAT_S64, it.key(), it->length, (int)tmp);
+				readS64(element.id, &tmp);
+//				qDebug("id %d, S64, len %d: " PRINTF_FORMAT_S64, element.id, element.length, (int)tmp);
 				break;
 			}
 			case TUnsigned64: {
 				quint64 tmp;
-				readU64(it.key(), &tmp);
-//				qDebug("id %d, U64, len %d: " PRINTF_FORMAT_U64, it.key(), it->length, (uint)tmp);
+				readU64(element.id, &tmp);
+//				qDebug("id %d, U64, len %d: " PRINTF_FORMAT_U64, element.id, element.length, (uint)tmp);
 				break;
 			}
 			case TFloat: {
 				float tmp;
-				readFloat(it.key(), &tmp);
-				qDebug("id %d, FLOAT, len %d: %f", it.key(), it->length, tmp);
+				readFloat(element.id, &tmp);
+				qDebug("id %d, FLOAT, len %d: %f", element.id, element.length, tmp);
 				break;
 			}
 			case TDouble: {
 				double tmp;
-				readDouble(it.key(), &tmp);
-				qDebug("id %d, DOUBLE, len %d: %f", it.key(), it->length, tmp);
+				readDouble(element.id, &tmp);
+				qDebug("id %d, DOUBLE, len %d: %f", element.id, element.length, tmp);
 				break;
 			}
 			case TBool: {
 				bool tmp;
-				readBool(it.key(), &tmp);
-				qDebug("id %d, BOOL, len %d: %s", it.key(), it->length, tmp ? "true" : "false");
+				readBool(element.id, &tmp);
+				qDebug("id %d, BOOL, len %d: %s", element.id, element.length, tmp ? "true" : "false");
 				break;
 			}
 			case TString: {
 				QString tmp;
-				readString(it.key(), &tmp);
-				qDebug("id %d, STRING, len %d: \"%s\"", it.key(), it->length, qPrintable(tmp));
+				readString(element.id, &tmp);
+				qDebug("id %d, STRING, len %d: \"%s\"", element.id, element.length, qPrintable(tmp));
 				break;
 			}
 			case TBlob: {
 				QByteArray tmp;
-				readBlob(it.key(), &tmp);
-				qDebug("id %d, BLOB, len %d", it.key(), it->length);
+				readBlob(element.id, &tmp);
+				qDebug("id %d, BLOB, len %d", element.id, element.length);
 				break;
 			}
 			case TVersion: {
-				qDebug("id %d, VERSION, len %d", it.key(), it->length);
+				qDebug("id %d, VERSION, len %d", element.id, element.length);
 				break;
 			}
 			default: {
-				qDebug("id %d, UNKNOWN TYPE 0x%02x, len %d", it.key(), it->type, it->length);
+				qDebug("id %d, UNKNOWN TYPE 0x%02x, len %d", element.id, element.type, element.length);
 				break;
 			}
 		}
@@ -664,9 +677,7 @@ void SimpleDeserializer::dump() const
 bool SimpleDeserializer::parseAll()
 {
 	uint readOfs = 0;
-	Type type;
-	quint32 id;
-	quint32 length;
+	Element element;
 
 	/*
 	QString hex;
@@ -676,24 +687,92 @@ bool SimpleDeserializer::parseAll()
 	qDebug("==");
 	*/
 
+	// check the elements are well formed without storing them
+	bool wellFormed = false;
+
 	while(readOfs < (uint)m_data.size()) {
-		if(!readTag(&readOfs, m_data.size(), &type, &id, &length))
-			return false;
+		if(!readTag(&readOfs, m_data.size(), &element.type, &element.id, &element.length))
+			break;
 
-		//qDebug("-- id %d, TYPE 0x%02x, len %d", id, type, length);
+		//qDebug("-- id %d, TYPE 0x%02x, len %d", element.id, element.type, element.length);
 
-		if(m_elements.contains(id)) {
-			qDebug("SimpleDeserializer: same ID found twice (id %u)", id);
-			return false;
+		if((m_end > 0) && (element.id <= m_lastId))
+			m_ordered = false;
+
+		m_lastId = element.id;
+		readOfs += element.length;
+		m_end = readOfs;
+
+		if(readOfs == (uint)m_data.size()) {
+			wellFormed = true;
+			break;
 		}
+	}
+
+	m_lastId = 0;
+
+	if(m_ordered)
+		return wellFormed;
 
-		m_elements.insert(id, Element(type, readOfs, length));
+	// index the elements by ID when they are not in order
+	readOfs = 0;
 
-		readOfs += length;
+	while(readOfs < m_end) {
+		readTag(&readOfs, m_end, &element.type, &element.id, &element.length);
+		element.ofs = readOfs;
+		m_elements.push_back(element);
+		readOfs += element.length;
+	}
+
+	std::stable_sort(m_elements.begin(), m_elements.end(), [](const Element& a, const Element& b) {
+		return a.id < b.id;
+	});
 
-		if(readOfs == (uint)m_data.size())
+	for(uint i = 1; i < m_elements.size(); i++) {
+		if(m_elements[i].id == m_elements[i - 1].id) {
+			qDebug("SimpleDeserializer: same ID found twice (id %u)", m_elements[i].id);
+			wellFormed = false;
+		}
+	}
+
+	// the first one prevails
+	m_elements.erase(std::unique(m_elements.begin(), m_elements.end(), [](const Element& a, const Element& b) {
+		return a.id == b.id;
+	}), m_elements.end());
+
+	return wellFormed;
+}
+
+bool SimpleDeserializer::findElement(quint32 id, Element* element) const
+{
+	if(!m_ordered) {
+		Elements::const_iterator it = std::lower_bound(m_elements.begin(), m_elements.end(), id, [](const Element& e, quint32 id) {
+			return e.id < id;
+		});
+		if((it == m_elements.end()) || (it->id != id))
+			return false;
+		*element = *it;
+		return true;
+	}
+
+	// fields are usually read in the order they were written so the search goes on from the last field found
+	uint readOfs = id > m_lastId ? m_readOfs : 0;
+
+	while(readOfs < m_end) {
+		readTag(&readOfs, m_end, &element->type, &element->id, &element->length);
+
+		if(element->id == id) {
+			element->ofs = readOfs;
+			m_readOfs = readOfs + element->length;
+			m_lastId = id;
 			return true;
+		} else if(element->id > id) {
+			return false;
+		}
+
+		readOfs += element->length;
 	}
+
 	return false;
 }
 
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_SIMPLESERIALIZER_H
 #define INCLUDE_SIMPLESERIALIZER_H
 
+#include <vector>
+
 #include <QString>
 #include <QMap>
 #include "dsp/dsptypes.h"
@@ -48,6 +50,11 @@ protected:
 	bool writeTag(Type type, quint32 id, quint32 length);
 };
 
+/**
+ * Reads the fields in place from the serialized data. When the IDs are in increasing order,
+ * which is the case for data written by SimpleSerializer with increasing IDs, no index is built
+ * and a field is searched from the last field read. Lookups are not thread safe.
+ */
 class SDRBASE_API SimpleDeserializer {
 public:
 	SimpleDeserializer(const QByteArray& data);
@@ -82,24 +89,24 @@ private:
 	};
 
 	struct Element {
+		quint32 id;
 		Type type;
 		quint32 ofs;
 		quint32 length;
-
-		Element(Type _type, quint32 _ofs, quint32 _length) :
-			type(_type),
-			ofs(_ofs),
-			length(_length)
-		{ }
 	};
-	typedef QMap<quint32, Element> Elements;
+	typedef std::vector<Element> Elements;
 
 	QByteArray m_data;
 	bool m_valid;
-	Elements m_elements;
+	uint m_end;             //!< end of the well formed elements
+	bool m_ordered;         //!< IDs are in increasing order
+	Elements m_elements;    //!< elements sorted by ID only when the IDs are not in order
+	mutable uint m_readOfs; //!< following the last element found
+	mutable quint32 m_lastId;
 	quint32 m_version;
 
 	bool parseAll();
+	bool findElement(quint32 id, Element* element) const;
 	bool readTag(uint* readOfs, uint readEnd, Type* type, quint32* id, quint32* length) const;
 	quint8 readByte(uint* readOfs) const
 	{
@@ -28,7 +28,13 @@ SyncMessenger::SyncMessenger() :
 }
 
 SyncMessenger::~SyncMessenger()
-{}
+{
+    AsyncBatch *batch;
+
+    while ((batch = takeAsyncBatch()) != 0) { // never processed: the futures get a broken promise
+        delete batch;
+    }
+}
 
 int SyncMessenger::sendWait(Message& message, unsigned long msPollTime)
 {
@@ -51,9 +57,64 @@ int SyncMessenger::sendWait(Message& message, unsigned long msPollTime)
 
 void SyncMessenger::done(int result)
 {
+    // taking the lock ensures the sender is already waiting otherwise the wake up could be lost
+    // and the sender would only notice completion at the next poll time
+    m_mutex.lock();
 	m_result = result;
 	m_complete.store(1);
 	m_waitCondition.wakeAll();
+    m_mutex.unlock();
+}
+
+SyncMessenger::AsyncBatch::~AsyncBatch()
+{
+    for (std::vector<Message*>::iterator it = m_messages.begin(); it != m_messages.end(); ++it) {
+        delete *it;
+    }
+}
+
+std::future<int> SyncMessenger::sendAsync(Message *message, const Completion& completion)
+{
+    return sendAsync(std::vector<Message*>(1, message), completion);
+}
+
+std::future<int> SyncMessenger::sendAsync(const std::vector<Message*>& messages, const Completion& completion)
+{
+    AsyncBatch *batch = new AsyncBatch();
+    batch->m_messages = messages;
+    batch->m_completion = completion;
+    std::future<int> future = batch->m_promise.get_future();
+
+    m_asyncMutex.lock();
+    m_asyncBatches.push(batch);
+    m_asyncMutex.unlock();
+
+    emit asyncMessageSent();
+
+    return future;
+}
+
+SyncMessenger::AsyncBatch *SyncMessenger::takeAsyncBatch()
+{
+    QMutexLocker mutexLocker(&m_asyncMutex);
+
+    if (m_asyncBatches.empty()) {
+        return 0;
+    }
+
+    AsyncBatch *batch = m_asyncBatches.front();
+    m_asyncBatches.pop();
+    return batch;
+}
+
+void SyncMessenger::doneAsync(AsyncBatch *batch, int result)
+{
+    if (batch->m_completion) {
+        batch->m_completion(result);
+    }
+
+    batch->m_promise.set_value(result);
+    delete batch;
 }
 
 
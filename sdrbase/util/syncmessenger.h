@@ -19,6 +19,11 @@
 #ifndef INCLUDE_UTIL_SYNCMESSENGER_H_
 #define INCLUDE_UTIL_SYNCMESSENGER_H_
 
+#include <vector>
+#include <queue>
+#include <future>
+#include <functional>
+
 #include <QObject>
 #include <QWaitCondition>
 #include <QMutex>
@@ -29,11 +34,29 @@ class Message;
 
 /**
  * This class is responsible of managing the synchronous processing of a message across threads
+ *
+ * Messages can also be sent asynchronously, alone or in batches. The receiving thread processes
+ * them in submission order and before any message sent synchronously afterwards. The caller gets
+ * a future for the processing result and can register a completion callback. The callback is
+ * invoked from the receiving thread.
  */
 class SDRBASE_API SyncMessenger : public QObject {
 	Q_OBJECT
 
 public:
+    typedef std::function<void(int)> Completion;
+
+    /** Messages sent asynchronously in one call */
+    class AsyncBatch
+    {
+    public:
+        std::vector<Message*> m_messages; //!< owned
+        std::promise<int> m_promise;
+        Completion m_completion;
+
+        ~AsyncBatch();
+    };
+
 	SyncMessenger();
 	~SyncMessenger();
 
@@ -42,8 +65,14 @@ public:
     void storeMessage(Message& message) { m_message = &message; }
 	void done(int result = 0); //!< Processing of the message is complete
 
+    std::future<int> sendAsync(Message *message, const Completion& completion = Completion()); //!< Send message (takes ownership) and return immediately
+    std::future<int> sendAsync(const std::vector<Message*>& messages, const Completion& completion = Completion()); //!< Send a batch of messages (takes ownership) processed in one go
+    AsyncBatch *takeAsyncBatch(); //!< Next batch to process by the receiving thread or 0 if none
+    void doneAsync(AsyncBatch *batch, int result); //!< Processing of the batch is complete. Deletes the batch.
+
 signals:
 	void messageSent();
+	void asyncMessageSent();
 
 protected:
 	QWaitCondition m_waitCondition;
@@ -51,6 +80,8 @@ protected:
 	QAtomicInt m_complete;
     Message *m_message;
 	int m_result;
+    QMutex m_asyncMutex;
+    std::queue<AsyncBatch*> m_asyncBatches;
 };
 
 
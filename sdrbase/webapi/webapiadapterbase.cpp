@@ -23,6 +23,7 @@
 #include "device/devicewebapiadapter.h"
 #include "device/deviceutils.h"
 #include "dsp/glspectrumsettings.h"
+#include "dsp/filerecord.h"
 #include "webapiadapterbase.h"
 
 WebAPIAdapterBase::WebAPIAdapterBase()
@@ -49,6 +50,15 @@ void WebAPIAdapterBase::webapiFormatPreferences(
     apiPreferences->setUseLogFile(preferences.getUseLogFile() ? 1 : 0);
     apiPreferences->setLogFileName(new QString(preferences.getLogFileName()));
     apiPreferences->setFileMinLogLevel((int) preferences.getFileMinLogLevel());
+    apiPreferences->setRecordNbBuffers(preferences.getRecordNbBuffers());
+    apiPreferences->setRecordBufferSize(preferences.getRecordBufferSize());
+    apiPreferences->setRecordDirectIo(preferences.getRecordDirectIO() ? 1 : 0);
+    apiPreferences->setRecordPreallocation(preferences.getRecordPreallocation());
+    apiPreferences->setRecordMaxFileSize(preferences.getRecordMaxFileSize());
+    apiPreferences->setRecordMaxFileSeconds(preferences.getRecordMaxFileSeconds());
+    apiPreferences->setRecordSigMf(preferences.getRecordSigMF() ? 1 : 0);
+    apiPreferences->setRecordSigMfPackingBits(preferences.getRecordSigMFPackingBits());
+    apiPreferences->setRecordSigMfCompressed(preferences.getRecordSigMFCompressed() ? 1 : 0);
 }
 
 void WebAPIAdapterBase::webapiInitConfig(
@@ -88,6 +98,33 @@ void WebAPIAdapterBase::webapiUpdatePreferences(
     if (preferenceKeys.contains("useLogFile")) {
         preferences.setUseLogFile(apiPreferences->getUseLogFile() != 0);
     }
+    if (preferenceKeys.contains("recordNbBuffers")) {
+        preferences.setRecordNbBuffers(apiPreferences->getRecordNbBuffers());
+    }
+    if (preferenceKeys.contains("recordBufferSize")) {
+        preferences.setRecordBufferSize(apiPreferences->getRecordBufferSize());
+    }
+    if (preferenceKeys.contains("recordDirectIO")) {
+        preferences.setRecordDirectIO(apiPreferences->getRecordDirectIo() != 0);
+    }
+    if (preferenceKeys.contains("recordPreallocation")) {
+        preferences.setRecordPreallocation(apiPreferences->getRecordPreallocation());
+    }
+    if (preferenceKeys.contains("recordMaxFileSize")) {
+        preferences.setRecordMaxFileSize(apiPreferences->getRecordMaxFileSize());
+    }
+    if (preferenceKeys.contains("recordMaxFileSeconds")) {
+        preferences.setRecordMaxFileSeconds(apiPreferences->getRecordMaxFileSeconds());
+    }
+    if (preferenceKeys.contains("recordSigMF")) {
+        preferences.setRecordSigMF(apiPreferences->getRecordSigMf() != 0);
+    }
+    if (preferenceKeys.contains("recordSigMFPackingBits")) {
+        preferences.setRecordSigMFPackingBits(apiPreferences->getRecordSigMfPackingBits());
+    }
+    if (preferenceKeys.contains("recordSigMFCompressed")) {
+        preferences.setRecordSigMFCompressed(apiPreferences->getRecordSigMfCompressed() != 0);
+    }
 }
 
 void WebAPIAdapterBase::webapiFormatPreset(
@@ -130,6 +167,8 @@ void WebAPIAdapterBase::webapiFormatPreset(
         swgSpectrumConfig->setAveragingMode((int) m_spectrumSettings.m_averagingMode);
         swgSpectrumConfig->setAveragingValue(GLSpectrumSettings::getAveragingValue(m_spectrumSettings.m_averagingIndex, m_spectrumSettings.m_averagingMode));
         swgSpectrumConfig->setLinear(m_spectrumSettings.m_linear ? 1 : 0);
+        swgSpectrumConfig->setDisplayRate(m_spectrumSettings.m_displayRate);
+        swgSpectrumConfig->setAccumulationMode((int) m_spectrumSettings.m_accumulationMode);
     }
 
     int nbChannels = preset.getChannelCount();
@@ -217,6 +256,9 @@ void WebAPIAdapterBase::webapiUpdatePreset(
     QStringList::const_iterator spectrumIt = presetKeys.m_spectrumKeys.begin();
     for (; spectrumIt != presetKeys.m_spectrumKeys.end(); ++spectrumIt)
     {
+        if (spectrumIt->contains("accumulationMode")) {
+            spectrumSettings.m_accumulationMode = (GLSpectrumSettings::AccumulationMode) apiPreset->getSpectrumConfig()->getAccumulationMode();
+        }
         if (spectrumIt->contains("averagingMode")) {
             spectrumSettings.m_averagingMode = (GLSpectrumSettings::AveragingMode) apiPreset->getSpectrumConfig()->getAveragingMode();
         }
@@ -246,6 +288,9 @@ void WebAPIAdapterBase::webapiUpdatePreset(
         if (spectrumIt->contains("displayMaxHold")) {
             spectrumSettings.m_displayMaxHold = apiPreset->getSpectrumConfig()->getDisplayMaxHold() != 0;
         }
+        if (spectrumIt->contains("displayRate")) {
+            spectrumSettings.m_displayRate = apiPreset->getSpectrumConfig()->getDisplayRate();
+        }
         if (spectrumIt->contains("displayTraceIntensity")) {
             spectrumSettings.m_displayTraceIntensity = apiPreset->getSpectrumConfig()->getDisplayTraceIntensity();
         }
@@ -386,6 +431,52 @@ void WebAPIAdapterBase::webapiFormatCommand(
     apiCommand->setRelease(command.getRelease() ? 1 : 0);
 }
 
+void WebAPIAdapterBase::webapiFormatReverseAPIDispatcherReport(
+        SWGSDRangel::SWGReverseAPIDispatcherReport *apiReport,
+        const WebAPIReverseDispatcher::Stats& stats
+)
+{
+    apiReport->init();
+    apiReport->setCoalescingWindow(stats.m_coalescingWindow);
+    apiReport->setQueueDepth(stats.m_queueDepth);
+    apiReport->setMaxQueueDepth(stats.m_maxQueueDepth);
+    apiReport->setInFlight(stats.m_inFlight);
+    apiReport->setNbQueued(stats.m_nbQueued);
+    apiReport->setNbCoalesced(stats.m_nbCoalesced);
+    apiReport->setNbSent(stats.m_nbSent);
+    apiReport->setNbFailed(stats.m_nbFailed);
+    apiReport->setAverageLatency(stats.m_averageLatency);
+    apiReport->setMaxLatency(stats.m_maxLatency);
+}
+
+void WebAPIAdapterBase::webapiFormatAudioOutputUdpStats(
+        SWGSDRangel::SWGAudioOutputDevice *apiDevice,
+        const AudioStreamingService::StreamStats& stats
+)
+{
+    apiDevice->setUdpEncodedBlocks(stats.m_nbItems);
+    apiDevice->setUdpDroppedBlocks(stats.m_droppedItems);
+    apiDevice->setUdpEncodeTimeAvg(stats.m_processTimeAvg);
+    apiDevice->setUdpLatencyAvg(stats.m_latencyAvg);
+    apiDevice->setUdpLatencyMax(stats.m_latencyMax);
+}
+
+void WebAPIAdapterBase::webapiFormatFileRecordReport(
+        SWGSDRangel::SWGFileRecordReport *apiFileRecordReport,
+        FileRecord *fileRecord
+)
+{
+    FileRecord::Stats stats;
+    fileRecord->getStats(stats);
+    apiFileRecordReport->setRecording(fileRecord->isRecording() ? 1 : 0);
+    apiFileRecordReport->setFileName(new QString(fileRecord->getFileName()));
+    apiFileRecordReport->setBytesWritten(stats.m_bytesWritten);
+    apiFileRecordReport->setDroppedBytes(stats.m_droppedBytes);
+    apiFileRecordReport->setNbFiles(stats.m_nbFiles);
+    apiFileRecordReport->setWriteBandwidth(stats.m_bandwidth);
+    apiFileRecordReport->setBufferHeadroom(stats.m_headroom);
+}
+
 void WebAPIAdapterBase::webapiUpdateCommand(
         SWGSDRangel::SWGCommand *apiCommand,
         const WebAPIAdapterInterface::CommandKeys& commandKeys,
@@ -25,13 +25,19 @@
 #include "SWGPreferences.h"
 #include "SWGPreset.h"
 #include "SWGCommand.h"
+#include "SWGReverseAPIDispatcherReport.h"
+#include "SWGAudioOutputDevice.h"
+#include "SWGFileRecordReport.h"
 #include "settings/preferences.h"
 #include "settings/preset.h"
 #include "settings/mainsettings.h"
 #include "commands/command.h"
+#include "audio/audiostreamingservice.h"
+#include "webapireversedispatcher.h"
 #include "webapiadapterinterface.h"
 
 class PluginManager;
+class FileRecord;
 class ChannelWebAPIAdapter;
 class DeviceWebAPIAdapter;
 
@@ -77,6 +83,18 @@ public:
         const WebAPIAdapterInterface::CommandKeys& commandKeys,
         Command& command
     );
+    static void webapiFormatReverseAPIDispatcherReport(
+        SWGSDRangel::SWGReverseAPIDispatcherReport *apiReport,
+        const WebAPIReverseDispatcher::Stats& stats
+    );
+    static void webapiFormatAudioOutputUdpStats(
+        SWGSDRangel::SWGAudioOutputDevice *apiDevice,
+        const AudioStreamingService::StreamStats& stats
+    );
+    static void webapiFormatFileRecordReport(
+        SWGSDRangel::SWGFileRecordReport *apiFileRecordReport,
+        FileRecord *fileRecord
+    );
 
 private:
     class WebAPIChannelAdapters
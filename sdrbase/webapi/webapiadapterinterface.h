@@ -48,6 +48,9 @@ namespace SWGSDRangel
     class SWGPresetImport;
     class SWGPresetExport;
     class SWGDeviceSetList;
+    class SWGInstanceReportsResponse;
+    class SWGReverseAPIDispatcherSettings;
+    class SWGReverseAPIDispatcherReport;
     class SWGDeviceSet;
     class SWGDeviceListItem;
     class SWGDeviceSettings;
@@ -159,14 +162,17 @@ public:
 
     /**
      * Handler of /sdrangel/devices (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceDevices
+     * refresh starts probing the hardware in the background
      * returns the Http status code (default 501: not implemented)
      */
     virtual int instanceDevices(
             int direction,
+            bool refresh,
             SWGSDRangel::SWGInstanceDevicesResponse& response,
             SWGSDRangel::SWGErrorResponse& error)
     {
         (void) direction;
+        (void) refresh;
         (void) response;
     	error.init();
     	*error.getMessage() = QString("Function not implemented");
@@ -545,6 +551,55 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/reports (GET)
+     * Collects device and channels reports of all device sets or only the one at deviceSetIndex if positive
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceReportsGet(
+            int deviceSetIndex,
+            bool withChannels,
+            SWGSDRangel::SWGInstanceReportsResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) withChannels;
+        (void) response;
+    	error.init();
+    	*error.getMessage() = QString("Function not implemented");
+    	return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/reverseapi (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceReverseAPIGet(
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) response;
+    	error.init();
+    	*error.getMessage() = QString("Function not implemented");
+    	return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/reverseapi (PATCH)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceReverseAPIPatch(
+            SWGSDRangel::SWGReverseAPIDispatcherSettings& query,
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) query;
+        (void) response;
+    	error.init();
+    	*error.getMessage() = QString("Function not implemented");
+    	return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset (POST) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -855,6 +910,8 @@ public:
     static QString instancePresetFileURL;
     static QString instanceDeviceSetsURL;
     static QString instanceDeviceSetURL;
+    static QString instanceReportsURL;
+    static QString instanceReverseAPIURL;
     static std::regex devicesetURLRe;
     static std::regex devicesetFocusURLRe;
     static std::regex devicesetDeviceURLRe;
@@ -21,8 +21,6 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
-#include <boost/lexical_cast.hpp>
-
 #include "httpdocrootsettings.h"
 #include "webapirequestmapper.h"
 #include "SWGInstanceSummaryResponse.h"
@@ -44,6 +42,9 @@
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
+#include "SWGInstanceReportsResponse.h"
+#include "SWGReverseAPIDispatcherSettings.h"
+#include "SWGReverseAPIDispatcherReport.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 
@@ -53,6 +54,7 @@ const QMap<QString, QString> WebAPIRequestMapper::m_channelURIToSettingsKey = {
     {"sdrangel.channeltx.modam", "AMModSettings"},
     {"sdrangel.channeltx.modatv", "ATVModSettings"},
     {"sdrangel.channel.bfm", "BFMDemodSettings"},
+    {"sdrangel.channel.bfmscanner", "BFMScannerSettings"},
     {"sdrangel.channel.chanalyzer", "ChannelAnalyzerSettings"},
     {"sdrangel.channel.chanalyzerng", "ChannelAnalyzerSettings"}, // remap
     {"org.f4exb.sdrangelove.channel.chanalyzer", "ChannelAnalyzerSettings"}, // remap
@@ -128,6 +130,7 @@ const QMap<QString, QString> WebAPIRequestMapper::m_channelTypeToSettingsKey = {
     {"ATVDemod", "ATVDemodSettings"},
     {"ATVMod", "ATVModSettings"},
     {"BFMDemod", "BFMDemodSettings"},
+    {"BFMScanner", "BFMScannerSettings"},
     {"ChannelAnalyzer", "ChannelAnalyzerSettings"},
     {"DATVDemod", "DATVDemodSettings"},
     {"DSDDemod", "DSDDemodSettings"},
@@ -235,81 +238,112 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             return;
         }
 
-        if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        WebAPIRouter::Match match;
+
+        if (!m_router.match(path, match)) // serve static documentation pages
+        {
+            m_staticFileController->service(request, response);
+            return;
+        }
+
+        switch (match.m_route)
+        {
+        case WebAPIRouter::RouteInstanceSummary:
             instanceSummaryService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceConfigURL) {
+            break;
+        case WebAPIRouter::RouteInstanceConfig:
             instanceConfigService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDevices:
             instanceDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+            break;
+        case WebAPIRouter::RouteInstanceChannels:
             instanceChannelsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+            break;
+        case WebAPIRouter::RouteInstanceLogging:
             instanceLoggingService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudio:
             instanceAudioService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioInputParameters:
             instanceAudioInputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioOutputParameters:
             instanceAudioOutputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioInputCleanup:
             instanceAudioInputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioOutputCleanup:
             instanceAudioOutputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+            break;
+        case WebAPIRouter::RouteInstanceLocation:
             instanceLocationService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBESerialURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAMBESerial:
             instanceAMBESerialService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBEDevicesURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAMBEDevices:
             instanceAMBEDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+            break;
+        case WebAPIRouter::RouteInstancePresets:
             instancePresetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+            break;
+        case WebAPIRouter::RouteInstancePreset:
             instancePresetService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+            break;
+        case WebAPIRouter::RouteInstancePresetFile:
             instancePresetFileService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDeviceSets:
             instanceDeviceSetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDeviceSet:
             instanceDeviceSetService(request, response);
-        }
-        else
-        {
-            std::smatch desc_match;
-            std::string pathStr(path.constData(), path.length());
-
-            if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
-                devicesetService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
-                devicesetDeviceService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
-                devicesetFocusService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
-                devicesetDeviceSettingsService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
-                devicesetDeviceRunService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
-                devicesetDeviceReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
-                devicesetChannelsReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
-                devicesetChannelService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
-                devicesetChannelIndexService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
-                devicesetChannelSettingsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
-                devicesetChannelReportService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            }
-            else // serve static documentation pages
-            {
-                m_staticFileController->service(request, response);
-            }
-
-//            QDirIterator it(":", QDirIterator::Subdirectories);
-//            while (it.hasNext()) {
-//                qDebug() << "WebAPIRequestMapper::service: " << it.next();
-//            }
-
+            break;
+        case WebAPIRouter::RouteInstanceReports:
+            instanceReportsService(request, response);
+            break;
+        case WebAPIRouter::RouteInstanceReverseAPI:
+            instanceReverseAPIService(request, response);
+            break;
+        case WebAPIRouter::RouteDeviceset:
+            devicesetService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetFocus:
+            devicesetFocusService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDevice:
+            devicesetDeviceService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceSettings:
+            devicesetDeviceSettingsService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceRun:
+            devicesetDeviceRunService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceReport:
+            devicesetDeviceReportService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelsReport:
+            devicesetChannelsReportService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannel:
+            devicesetChannelService(match.m_params[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelIndex:
+            devicesetChannelIndexService(match.m_params[0], match.m_params[1], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelSettings:
+            devicesetChannelSettingsService(match.m_params[0], match.m_params[1], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelReport:
+            devicesetChannelReportService(match.m_params[0], match.m_params[1], request, response);
+            break;
+        default:
+            m_staticFileController->service(request, response);
+            break;
         }
     }
 }
@@ -457,7 +491,10 @@ void WebAPIRequestMapper::instanceDevicesService(qtwebapp::HttpRequest& request,
             }
         }
 
-        int status = m_adapter->instanceDevices(direction, normalResponse, errorResponse);
+        QByteArray refreshStr = request.getParameter("refresh");
+        bool refresh = (refreshStr.length() != 0) && (refreshStr.toInt() != 0);
+
+        int status = m_adapter->instanceDevices(direction, refresh, normalResponse, errorResponse);
         response.setStatus(status);
 
         if (status/100 == 2) {
@@ -1310,7 +1347,7 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
     }
 }
 
-void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::instanceReportsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1318,24 +1355,36 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceSet normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGInstanceReportsResponse normalResponse;
+        QByteArray deviceSetIndexStr = request.getParameter("deviceSetIndex");
+        QByteArray channelsStr = request.getParameter("channels");
+        int deviceSetIndex = -1; // all device sets
+        bool withChannels = true;
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
+        if (deviceSetIndexStr.length() != 0)
+        {
+            bool ok;
+            int tmp = deviceSetIndexStr.toInt(&ok);
+            if (ok) {
+                deviceSetIndex = tmp;
             }
         }
-        catch (const boost::bad_lexical_cast &e)
+
+        if (channelsStr.length() != 0)
         {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+            bool ok;
+            int tmp = channelsStr.toInt(&ok);
+            if (ok) {
+                withChannels = tmp != 0;
+            }
+        }
+
+        int status = m_adapter->instanceReportsGet(deviceSetIndex, withChannels, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -1348,21 +1397,36 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
     }
 }
 
-void WebAPIRequestMapper::devicesetFocusService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::instanceReverseAPIService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        SWGSDRangel::SWGReverseAPIDispatcherReport normalResponse;
 
-        if (request.getMethod() == "PATCH")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
+        int status = m_adapter->instanceReverseAPIGet(normalResponse, errorResponse);
+        response.setStatus(status);
 
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "PATCH")
+    {
+        SWGSDRangel::SWGReverseAPIDispatcherSettings query;
+        SWGSDRangel::SWGReverseAPIDispatcherReport normalResponse;
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
+        {
+            query.fromJson(jsonStr);
+            int status = m_adapter->instanceReverseAPIPatch(query, normalResponse, errorResponse);
             response.setStatus(status);
 
             if (status/100 == 2) {
@@ -1373,235 +1437,254 @@ void WebAPIRequestMapper::devicesetFocusService(const std::string& indexStr, qtw
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGDeviceSet normalResponse;
+        int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
 
-        if (request.getMethod() == "PUT")
+void WebAPIRequestMapper::devicesetFocusService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "PATCH")
+    {
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
+
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetDeviceService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "PUT")
+    {
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceListItem query;
+            SWGSDRangel::SWGDeviceListItem normalResponse;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceListItem(query, jsonObject))
             {
-                SWGSDRangel::SWGDeviceListItem query;
-                SWGSDRangel::SWGDeviceListItem normalResponse;
+                int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
+                response.setStatus(status);
 
-                if (validateDeviceListItem(query, jsonObject))
-                {
-                    int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Missing device identification");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Missing device identification";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Missing device identification");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Missing device identification";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceSettings normalResponse;
+            resetDeviceSettings(normalResponse);
+            QStringList deviceSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
             {
-                SWGSDRangel::SWGDeviceSettings normalResponse;
-                resetDeviceSettings(normalResponse);
-                QStringList deviceSettingsKeys;
+                int status = m_adapter->devicesetDeviceSettingsPutPatch(
+                        deviceSetIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        deviceSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
 
-                if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
-                {
-                    int status = m_adapter->devicesetDeviceSettingsPutPatch(
-                            deviceSetIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            deviceSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceSettings normalResponse;
-            resetDeviceSettings(normalResponse);
-            int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGDeviceSettings normalResponse;
+        resetDeviceSettings(normalResponse);
+        int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceRunService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
 
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
-
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "POST")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "POST")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1609,25 +1692,14 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceReport normalResponse;
-            resetDeviceReport(normalResponse);
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGDeviceReport normalResponse;
+        resetDeviceReport(normalResponse);
+        int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -1640,7 +1712,7 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
     }
 }
 
-void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetChannelsReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1648,24 +1720,13 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGChannelsDetail normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGChannelsDetail normalResponse;
+        int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -1679,7 +1740,7 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
 }
 
 void WebAPIRequestMapper::devicesetChannelService(
-        const std::string& deviceSetIndexStr,
+        int deviceSetIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1687,77 +1748,65 @@ void WebAPIRequestMapper::devicesetChannelService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "POST")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "POST")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
-
-            if (parseJsonBody(jsonStr, jsonObject, response))
-            {
-                SWGSDRangel::SWGChannelSettings query;
-                SWGSDRangel::SWGSuccessResponse normalResponse;
-                resetChannelSettings(query);
+            SWGSDRangel::SWGChannelSettings query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            resetChannelSettings(query);
 
-                if (jsonObject.contains("direction")) {
-                    query.setDirection(jsonObject["direction"].toInt());
-                } else {
-                    query.setDirection(0); // assume Rx
-                }
+            if (jsonObject.contains("direction")) {
+                query.setDirection(jsonObject["direction"].toInt());
+            } else {
+                query.setDirection(0); // assume Rx
+            }
 
-                if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
-                {
-                    query.setChannelType(new QString(jsonObject["channelType"].toString()));
+            if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
+            {
+                query.setChannelType(new QString(jsonObject["channelType"].toString()));
 
-                    int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
+                int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
 
-                    response.setStatus(status);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelIndexService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1765,44 +1814,31 @@ void WebAPIRequestMapper::devicesetChannelIndexService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "DELETE")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
-
-        if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelSettingsService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1810,88 +1846,75 @@ void WebAPIRequestMapper::devicesetChannelSettingsService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+        SWGSDRangel::SWGChannelSettings normalResponse;
+        resetChannelSettings(normalResponse);
+        int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-        if (request.getMethod() == "GET")
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
+    {
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
             SWGSDRangel::SWGChannelSettings normalResponse;
             resetChannelSettings(normalResponse);
-            int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
-        {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            QStringList channelSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
             {
-                SWGSDRangel::SWGChannelSettings normalResponse;
-                resetChannelSettings(normalResponse);
-                QStringList channelSettingsKeys;
+                int status = m_adapter->devicesetChannelSettingsPutPatch(
+                        deviceSetIndex,
+                        channelIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        channelSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
 
-                if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
-                {
-                    int status = m_adapter->devicesetChannelSettingsPutPatch(
-                            deviceSetIndex,
-                            channelIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            channelSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelReportService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1899,30 +1922,24 @@ void WebAPIRequestMapper::devicesetChannelReportService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
-
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGChannelReport normalResponse;
-            resetChannelReport(normalResponse);
-            int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGChannelReport normalResponse;
+        resetChannelReport(normalResponse);
+        int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
@@ -2481,6 +2498,11 @@ bool WebAPIRequestMapper::getChannel(
             channelSettings->setBfmDemodSettings(new SWGSDRangel::SWGBFMDemodSettings());
             channelSettings->getBfmDemodSettings()->fromJsonObject(settingsJsonObject);
         }
+        else if (channelSettingsKey == "BFMScannerSettings")
+        {
+            channelSettings->setBfmScannerSettings(new SWGSDRangel::SWGBFMScannerSettings());
+            channelSettings->getBfmScannerSettings()->fromJsonObject(settingsJsonObject);
+        }
         else if (channelSettingsKey == "ChannelAnalyzerSettings")
         {
             processChannelAnalyzerSettings(channelSettings, settingsJsonObject, channelSettingsKeys);
@@ -2899,6 +2921,7 @@ void WebAPIRequestMapper::resetChannelSettings(SWGSDRangel::SWGChannelSettings&
     channelSettings.setAmModSettings(nullptr);
     channelSettings.setAtvModSettings(nullptr);
     channelSettings.setBfmDemodSettings(nullptr);
+    channelSettings.setBfmScannerSettings(nullptr);
     channelSettings.setDsdDemodSettings(nullptr);
     channelSettings.setNfmDemodSettings(nullptr);
     channelSettings.setNfmModSettings(nullptr);
@@ -2920,6 +2943,7 @@ void WebAPIRequestMapper::resetChannelReport(SWGSDRangel::SWGChannelReport& chan
     channelReport.setAmModReport(nullptr);
     channelReport.setAtvModReport(nullptr);
     channelReport.setBfmDemodReport(nullptr);
+    channelReport.setBfmScannerReport(nullptr);
     channelReport.setDsdDemodReport(nullptr);
     channelReport.setNfmDemodReport(nullptr);
     channelReport.setNfmModReport(nullptr);
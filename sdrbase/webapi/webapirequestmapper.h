@@ -27,6 +27,7 @@
 #include "httpresponse.h"
 #include "staticfilecontroller.h"
 #include "webapiadapterinterface.h"
+#include "webapirouter.h"
 
 #include "export.h"
 
@@ -50,6 +51,7 @@ public:
 private:
     WebAPIAdapterInterface *m_adapter;
     qtwebapp::StaticFileController *m_staticFileController;
+    WebAPIRouter m_router;
 
     void instanceSummaryService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceConfigService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -70,18 +72,20 @@ private:
     void instancePresetFileService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-
-    void devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetFocusService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelsReportService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelIndexService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelSettingsService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelReportService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceReportsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceReverseAPIService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+
+    void devicesetService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetFocusService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceRunService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelsReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelIndexService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelSettingsService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelReportService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
 
     bool validatePresetTransfer(SWGSDRangel::SWGPresetTransfer& presetTransfer);
     bool validatePresetIdentifer(SWGSDRangel::SWGPresetIdentifier& presetIdentifier);
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Process wide sender of reverse API notifications. Settings updates sent to    //
+// the same target within the coalescing window are merged into a single        //
+// request and all requests share one network access manager so that the        //
+// connections to a remote instance are kept alive.                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QGlobalStatic>
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QBuffer>
+#include <QTimer>
+#include <QUrl>
+#include <QDebug>
+
+#include "webapireversedispatcher.h"
+
+Q_GLOBAL_STATIC(WebAPIReverseDispatcher, webAPIReverseDispatcher)
+WebAPIReverseDispatcher *WebAPIReverseDispatcher::instance()
+{
+    return webAPIReverseDispatcher;
+}
+
+WebAPIReverseDispatcher::WebAPIReverseDispatcher() :
+    m_coalescingWindow(50),
+    m_latencySum(0.0),
+    m_nbAnswered(0)
+{
+    m_networkManager = new QNetworkAccessManager(this);
+    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    // network requests are always issued from the main thread. The children are created
+    // first so that they move along with their parent.
+    if (QCoreApplication::instance()) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    m_clock.start();
+}
+
+WebAPIReverseDispatcher::~WebAPIReverseDispatcher()
+{
+    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+}
+
+void WebAPIReverseDispatcher::sendSettings(const QString& url, const QString& json)
+{
+    QJsonObject body = QJsonDocument::fromJson(json.toUtf8()).object();
+    bool schedule;
+
+    m_mutex.lock();
+    QHash<QString, Pending>::iterator it = m_pending.find(url);
+    m_stats.m_nbQueued++;
+
+    if (it == m_pending.end())
+    {
+        Pending pending;
+        pending.m_body = body;
+        pending.m_enqueueTime = m_clock.elapsed();
+        m_pending.insert(url, pending);
+        m_pendingOrder.append(url);
+        m_stats.m_maxQueueDepth = m_pending.size() > m_stats.m_maxQueueDepth ? m_pending.size() : m_stats.m_maxQueueDepth;
+    }
+    else
+    {
+        mergeJson(it->m_body, body);
+        m_stats.m_nbCoalesced++;
+    }
+
+    schedule = m_pending.size() == 1; // first update of a new window
+    m_mutex.unlock();
+
+    if (schedule) {
+        QMetaObject::invokeMethod(this, "scheduleFlush", Qt::QueuedConnection);
+    }
+}
+
+void WebAPIReverseDispatcher::setCoalescingWindow(int coalescingWindow)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_coalescingWindow = coalescingWindow < 0 ? 0 : coalescingWindow;
+}
+
+WebAPIReverseDispatcher::Stats WebAPIReverseDispatcher::getStats()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    Stats stats = m_stats;
+    stats.m_coalescingWindow = m_coalescingWindow;
+    stats.m_queueDepth = m_pending.size();
+    stats.m_averageLatency = m_nbAnswered == 0 ? 0.0f : m_latencySum / m_nbAnswered;
+    return stats;
+}
+
+void WebAPIReverseDispatcher::scheduleFlush()
+{
+    if (!m_flushTimer->isActive())
+    {
+        m_mutex.lock();
+        int coalescingWindow = m_coalescingWindow;
+        m_mutex.unlock();
+        m_flushTimer->start(coalescingWindow);
+    }
+}
+
+void WebAPIReverseDispatcher::flush()
+{
+    QHash<QString, Pending> pending;
+    QList<QString> pendingOrder;
+
+    m_mutex.lock();
+    pending.swap(m_pending);
+    pendingOrder.swap(m_pendingOrder);
+    m_stats.m_nbSent += pendingOrder.size();
+    m_stats.m_inFlight += pendingOrder.size();
+    m_mutex.unlock();
+
+    // all requests of the window are issued back to back so that those sharing a host
+    // go through the same persistent connections
+    foreach (const QString& url, pendingOrder)
+    {
+        const Pending& update = pending[url];
+        QNetworkRequest request(QUrl(url));
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+
+        QBuffer *buffer = new QBuffer();
+        buffer->open((QBuffer::ReadWrite));
+        buffer->write(QJsonDocument(update.m_body).toJson(QJsonDocument::Compact));
+        buffer->seek(0);
+
+        QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", buffer);
+        reply->setProperty("enqueueTime", update.m_enqueueTime);
+        buffer->setParent(reply);
+    }
+}
+
+void WebAPIReverseDispatcher::networkManagerFinished(QNetworkReply *reply)
+{
+    QNetworkReply::NetworkError replyError = reply->error();
+    float latency = m_clock.elapsed() - reply->property("enqueueTime").toLongLong();
+
+    m_mutex.lock();
+    m_stats.m_inFlight--;
+    m_stats.m_nbFailed += replyError ? 1 : 0;
+    m_stats.m_maxLatency = latency > m_stats.m_maxLatency ? latency : m_stats.m_maxLatency;
+    m_latencySum += latency;
+    m_nbAnswered++;
+    m_mutex.unlock();
+
+    if (replyError)
+    {
+        qWarning() << "WebAPIReverseDispatcher::networkManagerFinished:"
+                << " url: " << reply->url().toString()
+                << " error(" << (int) replyError
+                << "): " << replyError
+                << ": " << reply->errorString();
+    }
+    else
+    {
+        QString answer = reply->readAll();
+        answer.chop(1); // remove last \n
+        qDebug("WebAPIReverseDispatcher::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
+    }
+
+    reply->deleteLater();
+}
+
+void WebAPIReverseDispatcher::mergeJson(QJsonObject& target, const QJsonObject& update)
+{
+    for (QJsonObject::const_iterator it = update.begin(); it != update.end(); ++it)
+    {
+        QJsonObject::iterator targetIt = target.find(it.key());
+
+        if ((targetIt != target.end()) && targetIt.value().isObject() && it.value().isObject())
+        {
+            // nested settings object e.g. nfmDemodSettings
+            QJsonObject merged = targetIt.value().toObject();
+            mergeJson(merged, it.value().toObject());
+            targetIt.value() = merged;
+        }
+        else
+        {
+            target.insert(it.key(), it.value());
+        }
+    }
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Process wide sender of reverse API notifications. Settings updates sent to    //
+// the same target within the coalescing window are merged into a single        //
+// request and all requests share one network access manager so that the        //
+// connections to a remote instance are kept alive.                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIREVERSEDISPATCHER_H_
+#define SDRBASE_WEBAPI_WEBAPIREVERSEDISPATCHER_H_
+
+#include <QObject>
+#include <QMutex>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+#include "export.h"
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+class SDRBASE_API WebAPIReverseDispatcher : public QObject
+{
+    Q_OBJECT
+public:
+    struct Stats
+    {
+        int m_coalescingWindow;  //!< milliseconds
+        int m_queueDepth;        //!< updates waiting for the end of the coalescing window
+        int m_maxQueueDepth;     //!< highest queue depth seen
+        int m_inFlight;          //!< requests sent and not yet answered
+        quint64 m_nbQueued;      //!< updates submitted
+        quint64 m_nbCoalesced;   //!< updates merged into an already queued one
+        quint64 m_nbSent;        //!< requests actually sent
+        quint64 m_nbFailed;      //!< requests answered with an error
+        float m_averageLatency;  //!< milliseconds from first submission to reply
+        float m_maxLatency;      //!< milliseconds
+
+        Stats() :
+            m_coalescingWindow(0),
+            m_queueDepth(0),
+            m_maxQueueDepth(0),
+            m_inFlight(0),
+            m_nbQueued(0),
+            m_nbCoalesced(0),
+            m_nbSent(0),
+            m_nbFailed(0),
+            m_averageLatency(0.0f),
+            m_maxLatency(0.0f)
+        {}
+    };
+
+    static WebAPIReverseDispatcher *instance();
+
+    WebAPIReverseDispatcher();
+    ~WebAPIReverseDispatcher();
+
+    /**
+     * Queue a settings update. Can be called from any thread. Updates to the same URL
+     * pending in the coalescing window are merged key by key with the latest values winning.
+     * The update is sent with the PATCH method.
+     */
+    void sendSettings(const QString& url, const QString& json);
+
+    void setCoalescingWindow(int coalescingWindow);
+    Stats getStats();
+
+private:
+    struct Pending
+    {
+        QJsonObject m_body;
+        qint64 m_enqueueTime;
+    };
+
+    QNetworkAccessManager *m_networkManager;
+    QTimer *m_flushTimer;
+    QMutex m_mutex;
+    QHash<QString, Pending> m_pending; //!< coalesced updates by target URL
+    QList<QString> m_pendingOrder;     //!< targets in submission order
+    QElapsedTimer m_clock;
+    int m_coalescingWindow;
+    Stats m_stats;
+    double m_latencySum;
+    quint64 m_nbAnswered;
+
+    static void mergeJson(QJsonObject& target, const QJsonObject& update);
+
+private slots:
+    void scheduleFlush();
+    void flush();
+    void networkManagerFinished(QNetworkReply *reply);
+};
+
+#endif /* SDRBASE_WEBAPI_WEBAPIREVERSEDISPATCHER_H_ */
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Web API path router. Resolves request paths to route identifiers through a    //
+// trie built once from the route patterns. Numeric path segments are parsed     //
+// while walking the trie so no regular expression is evaluated per request.     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "webapiadapterinterface.h"
+#include "webapirouter.h"
+
+WebAPIRouter::WebAPIRouter()
+{
+    m_nodes.push_back(Node()); // root
+
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceSummaryURL), RouteInstanceSummary);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceConfigURL), RouteInstanceConfig);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceDevicesURL), RouteInstanceDevices);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceChannelsURL), RouteInstanceChannels);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceLoggingURL), RouteInstanceLogging);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAudioURL), RouteInstanceAudio);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAudioInputParametersURL), RouteInstanceAudioInputParameters);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAudioOutputParametersURL), RouteInstanceAudioOutputParameters);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAudioInputCleanupURL), RouteInstanceAudioInputCleanup);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAudioOutputCleanupURL), RouteInstanceAudioOutputCleanup);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceLocationURL), RouteInstanceLocation);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAMBESerialURL), RouteInstanceAMBESerial);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceAMBEDevicesURL), RouteInstanceAMBEDevices);
+    addRoute(qPrintable(WebAPIAdapterInterface::instancePresetsURL), RouteInstancePresets);
+    addRoute(qPrintable(WebAPIAdapterInterface::instancePresetURL), RouteInstancePreset);
+    addRoute(qPrintable(WebAPIAdapterInterface::instancePresetFileURL), RouteInstancePresetFile);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceDeviceSetsURL), RouteInstanceDeviceSets);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceDeviceSetURL), RouteInstanceDeviceSet);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceReportsURL), RouteInstanceReports);
+    addRoute(qPrintable(WebAPIAdapterInterface::instanceReverseAPIURL), RouteInstanceReverseAPI);
+
+    addRoute("/sdrangel/deviceset/{i}", RouteDeviceset);
+    addRoute("/sdrangel/deviceset/{i}/focus", RouteDevicesetFocus);
+    addRoute("/sdrangel/deviceset/{i}/device", RouteDevicesetDevice);
+    addRoute("/sdrangel/deviceset/{i}/device/settings", RouteDevicesetDeviceSettings);
+    addRoute("/sdrangel/deviceset/{i}/device/run", RouteDevicesetDeviceRun);
+    addRoute("/sdrangel/deviceset/{i}/device/report", RouteDevicesetDeviceReport);
+    addRoute("/sdrangel/deviceset/{i}/channels/report", RouteDevicesetChannelsReport);
+    addRoute("/sdrangel/deviceset/{i}/channel", RouteDevicesetChannel);
+    addRoute("/sdrangel/deviceset/{i}/channel/{i}", RouteDevicesetChannelIndex);
+    addRoute("/sdrangel/deviceset/{i}/channel/{i}/settings", RouteDevicesetChannelSettings);
+    addRoute("/sdrangel/deviceset/{i}/channel/{i}/report", RouteDevicesetChannelReport);
+}
+
+WebAPIRouter::~WebAPIRouter()
+{}
+
+void WebAPIRouter::addRoute(const char *pattern, RouteId route)
+{
+    int nodeIndex = 0;
+    const char *p = pattern;
+
+    while (*p == '/') {
+        p++;
+    }
+
+    while (*p)
+    {
+        const char *end = std::strchr(p, '/');
+        int length = end ? end - p : std::strlen(p);
+        std::string segment(p, length);
+
+        if (segment == "{i}")
+        {
+            if (m_nodes[nodeIndex].m_paramChild < 0)
+            {
+                m_nodes.push_back(Node());
+                m_nodes[nodeIndex].m_paramChild = m_nodes.size() - 1;
+            }
+
+            nodeIndex = m_nodes[nodeIndex].m_paramChild;
+        }
+        else
+        {
+            int childIndex = findChild(nodeIndex, segment.c_str(), length);
+            nodeIndex = childIndex < 0 ? addChild(nodeIndex, segment) : childIndex;
+        }
+
+        p += length;
+
+        while (*p == '/') {
+            p++;
+        }
+    }
+
+    m_nodes[nodeIndex].m_route = route;
+}
+
+bool WebAPIRouter::match(const char *path, int length, Match& match) const
+{
+    int nodeIndex = 0;
+    int pos = 0;
+    match.m_route = RouteNone;
+    match.m_nbParams = 0;
+
+    if ((length == 0) || (path[0] != '/')) {
+        return false;
+    }
+
+    pos++;
+
+    while (pos < length)
+    {
+        int start = pos;
+
+        while ((pos < length) && (path[pos] != '/')) {
+            pos++;
+        }
+
+        int segmentLength = pos - start;
+        int childIndex = findChild(nodeIndex, &path[start], segmentLength);
+
+        if (childIndex >= 0)
+        {
+            nodeIndex = childIndex;
+        }
+        else if ((m_nodes[nodeIndex].m_paramChild >= 0)
+            && (segmentLength > 0)
+            && (segmentLength <= m_maxParamDigits)
+            && (match.m_nbParams < m_maxParams))
+        {
+            int value = 0;
+
+            for (int i = start; i < pos; i++)
+            {
+                if ((path[i] < '0') || (path[i] > '9')) {
+                    return false;
+                }
+
+                value = value*10 + (path[i] - '0');
+            }
+
+            match.m_params[match.m_nbParams++] = value;
+            nodeIndex = m_nodes[nodeIndex].m_paramChild;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (pos < length) // skip separator
+        {
+            pos++;
+
+            if (pos == length) { // trailing separator is not part of any route
+                return false;
+            }
+        }
+    }
+
+    match.m_route = m_nodes[nodeIndex].m_route;
+    return match.m_route != RouteNone;
+}
+
+int WebAPIRouter::findChild(int nodeIndex, const char *segment, int length) const
+{
+    const std::vector<std::pair<std::string, int> >& children = m_nodes[nodeIndex].m_children;
+
+    for (std::vector<std::pair<std::string, int> >::const_iterator it = children.begin(); it != children.end(); ++it)
+    {
+        if (((int) it->first.size() == length) && (std::memcmp(it->first.data(), segment, length) == 0)) {
+            return it->second;
+        }
+    }
+
+    return -1;
+}
+
+int WebAPIRouter::addChild(int nodeIndex, const std::string& segment)
+{
+    m_nodes.push_back(Node());
+    int childIndex = m_nodes.size() - 1;
+    m_nodes[nodeIndex].m_children.push_back(std::pair<std::string, int>(segment, childIndex));
+    return childIndex;
+}
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Web API path router. Resolves request paths to route identifiers through a    //
+// trie built once from the route patterns. Numeric path segments are parsed     //
+// while walking the trie so no regular expression is evaluated per request.     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIROUTER_H_
+#define SDRBASE_WEBAPI_WEBAPIROUTER_H_
+
+#include <vector>
+#include <string>
+
+#include <QByteArray>
+
+#include "export.h"
+
+class SDRBASE_API WebAPIRouter
+{
+public:
+    enum RouteId
+    {
+        RouteNone,
+        RouteInstanceSummary,
+        RouteInstanceConfig,
+        RouteInstanceDevices,
+        RouteInstanceChannels,
+        RouteInstanceLogging,
+        RouteInstanceAudio,
+        RouteInstanceAudioInputParameters,
+        RouteInstanceAudioOutputParameters,
+        RouteInstanceAudioInputCleanup,
+        RouteInstanceAudioOutputCleanup,
+        RouteInstanceLocation,
+        RouteInstanceAMBESerial,
+        RouteInstanceAMBEDevices,
+        RouteInstancePresets,
+        RouteInstancePreset,
+        RouteInstancePresetFile,
+        RouteInstanceDeviceSets,
+        RouteInstanceDeviceSet,
+        RouteInstanceReports,
+        RouteInstanceReverseAPI,
+        RouteDeviceset,
+        RouteDevicesetFocus,
+        RouteDevicesetDevice,
+        RouteDevicesetDeviceSettings,
+        RouteDevicesetDeviceRun,
+        RouteDevicesetDeviceReport,
+        RouteDevicesetChannelsReport,
+        RouteDevicesetChannel,
+        RouteDevicesetChannelIndex,
+        RouteDevicesetChannelSettings,
+        RouteDevicesetChannelReport
+    };
+
+    static const int m_maxParams = 2;   //!< Maximum number of numeric parameters in a route
+    static const int m_maxParamDigits = 2; //!< Same constraint as the historical [0-9]{1,2} patterns
+
+    struct Match
+    {
+        RouteId m_route;
+        int m_nbParams;
+        int m_params[m_maxParams];
+
+        Match() :
+            m_route(RouteNone),
+            m_nbParams(0)
+        {
+            m_params[0] = 0;
+            m_params[1] = 0;
+        }
+    };
+
+    WebAPIRouter();
+    ~WebAPIRouter();
+
+    /**
+     * Register a route. Pattern segments are separated by '/' and a segment
+     * written as {i} stands for a decimal integer parameter.
+     */
+    void addRoute(const char *pattern, RouteId route);
+
+    /** Resolve a decoded request path. Returns false if no route matches. */
+    bool match(const char *path, int length, Match& match) const;
+    bool match(const QByteArray& path, Match& match) const { return this->match(path.constData(), path.size(), match); }
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<std::string, int> > m_children; //!< literal segment to node index
+        int m_paramChild; //!< node index of the integer parameter segment or -1
+        RouteId m_route;
+
+        Node() :
+            m_paramChild(-1),
+            m_route(RouteNone)
+        {}
+    };
+
+    std::vector<Node> m_nodes; //!< index 0 is the root
+
+    int findChild(int nodeIndex, const char *segment, int length) const;
+    int addChild(int nodeIndex, const std::string& segment);
+};
+
+#endif /* SDRBASE_WEBAPI_WEBAPIROUTER_H_ */
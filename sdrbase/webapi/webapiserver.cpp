@@ -23,13 +23,14 @@
 #include "webapirequestmapper.h"
 #include "webapiserver.h"
 
-WebAPIServer::WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper) :
+WebAPIServer::WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper, int eventLoopThreads) :
     m_requestMapper(requestMapper),
     m_listener(0)
 {
     m_settings.host = host;
     m_settings.port = port;
     m_settings.maxRequestSize = 1<<23; // 8M
+    m_settings.eventLoopThreads = eventLoopThreads; // 0: one thread per connection
 }
 
 WebAPIServer::~WebAPIServer()
@@ -33,7 +33,7 @@ class WebAPIRequestMapper;
 class SDRBASE_API WebAPIServer
 {
 public:
-    WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper);
+    WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper, int eventLoopThreads = 0);
     ~WebAPIServer();
 
     void start();
@@ -64,6 +64,16 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestWebAPIRouter) {
+        testWebAPIRouter();
+    } else if (m_parser.getTestType() == ParserBench::TestAudioMix) {
+        testAudioMix();
+    } else if (m_parser.getTestType() == ParserBench::TestAudioResampler) {
+        testAudioResampler();
+    } else if (m_parser.getTestType() == ParserBench::TestSimpleSerializer) {
+        testSimpleSerializer();
+    } else if (m_parser.getTestType() == ParserBench::TestATVDemod) {
+        testATVDemod();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
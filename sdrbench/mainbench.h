@@ -53,6 +53,11 @@ private:
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testWebAPIRouter();
+    void testAudioMix();
+    void testAudioResampler();
+    void testSimpleSerializer();
+    void testATVDemod();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, webapirouter, audiomix, audioresampler, simpleserializer, atvdemod",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -38,7 +38,11 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_fileOption(QStringList() << "f" << "file",
+        "Input file for tests replaying recorded data.",
+        "file",
+        "")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
@@ -53,6 +57,7 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_fileOption);
 }
 
 ParserBench::~ParserBench()
@@ -111,6 +116,10 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // input file
+
+    m_fileName = m_parser.value(m_fileOption);
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -127,6 +136,16 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "webapirouter") {
+        return TestWebAPIRouter;
+    } else if (m_testStr == "audiomix") {
+        return TestAudioMix;
+    } else if (m_testStr == "audioresampler") {
+        return TestAudioResampler;
+    } else if (m_testStr == "simpleserializer") {
+        return TestSimpleSerializer;
+    } else if (m_testStr == "atvdemod") {
+        return TestATVDemod;
     } else {
         return TestDecimatorsII;
     }
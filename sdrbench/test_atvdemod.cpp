@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "atvdemodprocessor.h"
+
+#include "mainbench.h"
+
+static const float lineDuration = 64e-6f;   // PAL 625 lines at 25 frames per second
+static const float topDuration = 4.7e-6f;
+static const float blackLevel = 0.3f;
+
+// Video level of the sample at time t (s) from the start of a line of a field. Each field starts with
+// 3 lines at the sync level so that the vertical sync is detected on the line average.
+static float videoLevel(float t, int fieldLine)
+{
+    if (fieldLine < 3) {
+        return t < lineDuration - topDuration ? 0.0f : blackLevel;
+    } else if (t < topDuration) {
+        return 0.0f;               // horizontal sync pulse
+    } else if (t < 10.4e-6f) {
+        return blackLevel;         // back porch
+    } else if (t < lineDuration - 1.6e-6f) {
+        return blackLevel + (1.0f - blackLevel) * ((t - 10.4e-6f) / (lineDuration - 12.0e-6f)); // gray ramp
+    } else {
+        return blackLevel;         // front porch
+    }
+}
+
+// Composite video of 312 and 313 lines fields modulated for the given ATV modulation
+static void makeVideo(std::vector<Complex>& samples, int sampleRate, ATVDemod::ATVModulation modulation)
+{
+    float phase = 0.0f;
+    int samplesPerLine = (int) (lineDuration * sampleRate);
+    int line = 0;
+    int col = 0;
+
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+        int fieldLine = line < 312 ? line : line - 312;
+        float level = videoLevel(col / (float) sampleRate, fieldLine);
+
+        if (modulation == ATVDemod::ATV_AM)
+        {
+            samples[i] = Complex(0.5f * level * SDR_RX_SCALEF, 0.0f);
+        }
+        else
+        {
+            // the FM discriminators return (sin(dphi) + 1) / 2 for a phase step of dphi
+            phase += std::asin(2.0f * level - 1.0f);
+            phase = phase > M_PI ? phase - 2.0f * M_PI : phase < -M_PI ? phase + 2.0f * M_PI : phase;
+            samples[i] = Complex(0.5f * SDR_RX_SCALEF * std::cos(phase), 0.5f * SDR_RX_SCALEF * std::sin(phase));
+        }
+
+        if (++col == samplesPerLine)
+        {
+            col = 0;
+            line = line == 624 ? 0 : line + 1;
+        }
+    }
+}
+
+void MainBench::testATVDemod()
+{
+    const int sampleRate = 1000000 << m_parser.getLog2Factor();
+    const unsigned int blockSize = 4096; // typical size of a channelizer output block
+    const ATVDemod::ATVModulation modulations[3] = {ATVDemod::ATV_FM1, ATVDemod::ATV_FM2, ATVDemod::ATV_AM};
+    const char *modulationNames[3] = {"FM1", "FM2", "AM"};
+
+    ATVDemod::ATVConfig config;
+    config.m_intSampleRate = sampleRate;
+    config.m_enmATVStandard = ATVDemod::ATVStdPAL625;
+    config.m_intNumberOfLines = 625;
+    config.m_fltLineDuration = lineDuration;
+    config.m_fltTopDuration = topDuration;
+    config.m_fltFramePerS = 25.0f;
+    config.m_fltRatioOfRowsToDisplay = 1.0f;
+    config.m_fltVoltLevelSynchroTop = 0.15f;
+    config.m_fltVoltLevelSynchroBlack = blackLevel;
+    config.m_blnHSync = true;
+    config.m_blnVSync = true;
+
+    for (int m = 0; m < 3; m++)
+    {
+        qDebug() << "MainBench::testATVDemod: create test data for" << modulationNames[m];
+
+        std::vector<Complex> samples(m_parser.getNbSamples());
+        makeVideo(samples, sampleRate, modulations[m]);
+
+        ATVDemod::ATVRFConfig rfConfig;
+        rfConfig.m_enmModulation = modulations[m];
+        rfConfig.m_fltRFBandwidth = sampleRate / 2;
+        rfConfig.m_fltRFOppBandwidth = sampleRate / 2;
+
+        ATVDemodProcessor processor;
+        processor.applySettings(config, rfConfig, sampleRate);
+        TVFrameBuffer *frameBuffer = processor.getFrameBuffer();
+
+        qDebug() << "MainBench::testATVDemod: run test";
+
+        // headless screen: takes the frames as they come and sums their pixels
+        quint64 nbFrames = 0;
+        quint64 pixelSum = 0;
+        QElapsedTimer timer;
+        timer.start();
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            for (unsigned int j = 0; j < samples.size(); j += blockSize)
+            {
+                processor.feed(&samples[j], std::min(blockSize, (unsigned int) samples.size() - j));
+                const TVFrameBuffer::Frame *frame = frameBuffer->acquireFrame();
+
+                if (frame)
+                {
+                    nbFrames++;
+                    pixelSum += frame->m_pixels[frame->m_pixels.size() / 2];
+                    frameBuffer->releaseFrame();
+                }
+            }
+        }
+
+        qint64 nsecs = timer.nsecsElapsed();
+        printResults(QString("MainBench::testATVDemod: %1").arg(modulationNames[m]), nsecs);
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testATVDemod: %1: frames published: %2 dropped: %3 displayed: %4 mid pixel average: %5")
+            .arg(modulationNames[m])
+            .arg(frameBuffer->getNbPublished())
+            .arg(frameBuffer->getNbDropped())
+            .arg(nbFrames)
+            .arg(nbFrames == 0 ? 0.0 : pixelSum / (double) nbFrames, 0, 'f', 1);
+    }
+}
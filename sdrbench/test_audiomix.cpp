@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "audio/audiofifo.h"
+#include "audio/audiomix.h"
+
+#include "mainbench.h"
+
+// Sample by sample mix and clamp as done by AudioOutput before the mixing kernels
+static void legacyMix(std::vector<AudioFifo*>& fifos, AudioSample *out, std::vector<qint32>& mixBuffer, unsigned int nbSamples)
+{
+    memset(&mixBuffer[0], 0x00, 2 * nbSamples * sizeof(mixBuffer[0]));
+
+    for (std::vector<AudioFifo*>::iterator it = fifos.begin(); it != fifos.end(); ++it)
+    {
+        unsigned int samples = (*it)->read((quint8*) out, nbSamples);
+        const qint16* src = (const qint16*) out;
+        std::vector<qint32>::iterator dst = mixBuffer.begin();
+
+        for (unsigned int i = 0; i < samples; i++)
+        {
+            *dst += *src;
+            ++src;
+            ++dst;
+            *dst += *src;
+            ++src;
+            ++dst;
+        }
+    }
+
+    qint16* dst = (qint16*) out;
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++)
+    {
+        qint32 s = mixBuffer[i];
+        *dst++ = s < -32768 ? -32768 : s > 32767 ? 32767 : s;
+    }
+}
+
+static void kernelMix(std::vector<AudioFifo*>& fifos, AudioSample *out, std::vector<float>& mixBuffer, AudioVector& readBuffer, unsigned int nbSamples)
+{
+    memset(&mixBuffer[0], 0x00, 2 * nbSamples * sizeof(mixBuffer[0]));
+
+    for (unsigned int i = 0; i < fifos.size(); i++)
+    {
+        unsigned int samples = fifos[i]->read((quint8*) &readBuffer[0], nbSamples);
+        AudioMix::accumulate(&mixBuffer[0], &readBuffer[0], samples);
+    }
+
+    AudioMix::convert(out, &mixBuffer[0], nbSamples);
+}
+
+void MainBench::testAudioMix()
+{
+    // one audio callback worth of samples at 48 kS/s
+    const unsigned int blockSize = 1024;
+    const unsigned int maxChannels = 64;
+    unsigned int nbBlocks = m_parser.getNbSamples() / blockSize;
+
+    if (nbBlocks == 0) {
+        nbBlocks = 1;
+    }
+
+    qDebug() << "MainBench::testAudioMix: create test data";
+
+    AudioVector block(blockSize);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (unsigned int i = 0; i < blockSize; i++)
+    {
+        // keep the sum of all channels mostly below saturation
+        block[i].l = my_rand() / maxChannels;
+        block[i].r = my_rand() / maxChannels;
+    }
+
+    std::vector<AudioFifo*> fifos;
+
+    for (unsigned int i = 0; i < maxChannels; i++) {
+        fifos.push_back(new AudioFifo(2*blockSize));
+    }
+
+    AudioVector out(blockSize);
+    AudioVector readBuffer(blockSize);
+    std::vector<qint32> legacyBuffer(2*blockSize);
+    std::vector<float> mixBuffer(2*blockSize);
+
+    qDebug() << "MainBench::testAudioMix: run test";
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testAudioMix: %1 blocks of %2 samples").arg(nbBlocks * m_parser.getRepetition()).arg(blockSize);
+
+    for (unsigned int nbChannels = 1; nbChannels <= maxChannels; nbChannels *= 2)
+    {
+        std::vector<AudioFifo*> channelFifos(fifos.begin(), fifos.begin() + nbChannels);
+        QElapsedTimer timer;
+        qint64 nsecsLegacy = 0;
+        qint64 nsecsKernel = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            for (unsigned int j = 0; j < nbBlocks; j++)
+            {
+                for (unsigned int k = 0; k < nbChannels; k++) {
+                    channelFifos[k]->write((const quint8*) &block[0], blockSize);
+                }
+
+                timer.start();
+                legacyMix(channelFifos, &out[0], legacyBuffer, blockSize);
+                nsecsLegacy += timer.nsecsElapsed();
+
+                for (unsigned int k = 0; k < nbChannels; k++) {
+                    channelFifos[k]->write((const quint8*) &block[0], blockSize);
+                }
+
+                timer.start();
+                kernelMix(channelFifos, &out[0], mixBuffer, readBuffer, blockSize);
+                nsecsKernel += timer.nsecsElapsed();
+            }
+        }
+
+        double nbTotal = (double) nbBlocks * m_parser.getRepetition();
+        info << tr("\n  %1 channels: sample loop %2 ns/block - mixing kernels %3 ns/block")
+            .arg(nbChannels, 2).arg(nsecsLegacy / nbTotal, 0, 'f', 0).arg(nsecsKernel / nbTotal, 0, 'f', 0);
+    }
+
+    for (std::vector<AudioFifo*>::iterator it = fifos.begin(); it != fifos.end(); ++it) {
+        delete *it;
+    }
+}
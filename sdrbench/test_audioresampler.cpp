@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "audio/audioresampler.h"
+#include "audio/audiopolyphaseresampler.h"
+
+#include "mainbench.h"
+
+// Polyphase conversion of the whole buffer by blocks of an audio callback size
+static qint64 runPolyphase(AudioPolyphaseResampler& resampler, const std::vector<qint16>& in, std::vector<qint16>& out, quint64& nbOutput)
+{
+    const unsigned int blockSize = 1024;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (unsigned int i = 0; i < in.size(); i += blockSize)
+    {
+        unsigned int nbInput = std::min(blockSize, (unsigned int) in.size() - i);
+        nbOutput += resampler.process(&in[i], nbInput, &out[0]);
+    }
+
+    return timer.nsecsElapsed();
+}
+
+void MainBench::testAudioResampler()
+{
+    const int sampleRate = 48000;
+    unsigned int factor = 1 << m_parser.getLog2Factor();
+
+    qDebug() << "MainBench::testAudioResampler: create test data";
+
+    std::vector<qint16> in(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+    std::generate(in.begin(), in.end(), my_rand);
+    std::vector<qint16> out(1024 * factor + 1);
+
+    AudioResampler sampleResampler;
+    sampleResampler.setDecimation(factor);
+    sampleResampler.setAudioFilters(sampleRate, sampleRate / factor, 50, (int) (0.45 * sampleRate / factor));
+    AudioPolyphaseResampler decimator, interpolator, fractional;
+    decimator.setRates(sampleRate, sampleRate / factor);
+    interpolator.setRates(sampleRate / factor, sampleRate);
+    fractional.setRates(sampleRate, 44100);
+
+    qDebug() << "MainBench::testAudioResampler: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecsDown = 0, nsecsUp = 0;
+    qint64 nsecsPolyDown = 0, nsecsPolyUp = 0, nsecsPolyFrac = 0;
+    quint64 nbDown = 0, nbUp = 0, nbPolyDown = 0, nbPolyUp = 0, nbPolyFrac = 0;
+    qint16 sample;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (unsigned int j = 0; j < in.size(); j++)
+        {
+            if (sampleResampler.downSample(in[j], sample)) {
+                out[nbDown++ % out.size()] = sample;
+            }
+        }
+
+        nsecsDown += timer.nsecsElapsed();
+        timer.start();
+
+        for (unsigned int j = 0; j < in.size(); j++)
+        {
+            while (!sampleResampler.upSample(in[j], sample)) {
+                out[nbUp++ % out.size()] = sample;
+            }
+
+            out[nbUp++ % out.size()] = sample;
+        }
+
+        nsecsUp += timer.nsecsElapsed();
+
+        nsecsPolyDown += runPolyphase(decimator, in, out, nbPolyDown);
+        nsecsPolyUp += runPolyphase(interpolator, in, out, nbPolyUp);
+        nsecsPolyFrac += runPolyphase(fractional, in, out, nbPolyFrac);
+    }
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testAudioResampler: %1 input samples factor %2").arg(in.size() * m_parser.getRepetition()).arg(factor);
+    info << tr("\n  per sample decimation:  %1 ns/output sample").arg(nsecsDown / (double) nbDown, 0, 'f', 2);
+    info << tr("\n  polyphase decimation:   %1 ns/output sample").arg(nsecsPolyDown / (double) nbPolyDown, 0, 'f', 2);
+    info << tr("\n  per sample upsampling:  %1 ns/output sample").arg(nsecsUp / (double) nbUp, 0, 'f', 2);
+    info << tr("\n  polyphase interpolation: %1 ns/output sample").arg(nsecsPolyUp / (double) nbPolyUp, 0, 'f', 2);
+    info << tr("\n  polyphase 48000 to 44100: %1 ns/output sample").arg(nsecsPolyFrac / (double) nbPolyFrac, 0, 'f', 2);
+}
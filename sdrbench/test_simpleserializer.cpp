@@ -0,0 +1,472 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#include "util/simpleserializer.h"
+#include "settings/preset.h"
+
+#include "mainbench.h"
+
+// Deserializer as it was before reading the fields in place: all elements go in a map first
+class LegacySimpleDeserializer
+{
+public:
+    struct Element
+    {
+        int type;
+        quint32 ofs;
+        quint32 length;
+
+        Element(int _type, quint32 _ofs, quint32 _length) : type(_type), ofs(_ofs), length(_length) {}
+    };
+    typedef QMap<quint32, Element> Elements;
+
+    LegacySimpleDeserializer(const QByteArray& data) :
+        m_data(data),
+        m_version(0)
+    {
+        m_valid = parseAll();
+        Elements::const_iterator it = m_elements.constFind(0);
+
+        if ((it == m_elements.constEnd()) || (it->type != 9) || (it->length > 4))
+        {
+            m_valid = false;
+            return;
+        }
+
+        m_version = readUnsigned(*it);
+    }
+
+    bool isValid() const { return m_valid; }
+    quint32 getVersion() const { return m_version; }
+    const Elements& getElements() const { return m_elements; }
+
+    bool readS32(quint32 id, qint32 *result, qint32 def = 0) const { return readSigned(id, 0, 4, result, def); }
+    bool readU32(quint32 id, quint32 *result, quint32 def = 0) const { return readUnsigned(id, 1, 4, result, def); }
+    bool readS64(quint32 id, qint64 *result, qint64 def = 0) const { return readSigned(id, 2, 8, result, def); }
+    bool readU64(quint32 id, quint64 *result, quint64 def = 0) const { return readUnsigned(id, 3, 8, result, def); }
+
+    bool readFloat(quint32 id, float *result, float def = 0) const
+    {
+        union { quint32 u; float f; } tmp;
+        tmp.f = def;
+        bool ok = readUnsigned(id, 4, 4, &tmp.u, tmp.u);
+        *result = tmp.f;
+        return ok;
+    }
+
+    bool readDouble(quint32 id, double *result, double def = 0) const
+    {
+        union { quint64 u; double d; } tmp;
+        tmp.d = def;
+        bool ok = readUnsigned(id, 5, 8, &tmp.u, tmp.u);
+        *result = tmp.d;
+        return ok;
+    }
+
+    bool readBool(quint32 id, bool *result, bool def = false) const
+    {
+        quint32 tmp;
+        bool ok = readUnsigned(id, 6, 1, &tmp, def ? 1 : 0);
+        *result = tmp != 0;
+        return ok;
+    }
+
+    bool readString(quint32 id, QString *result, const QString& def = QString()) const
+    {
+        Elements::const_iterator it = m_elements.constFind(id);
+
+        if ((it == m_elements.constEnd()) || (it->type != 7))
+        {
+            *result = def;
+            return false;
+        }
+
+        *result = QString::fromUtf8(m_data.data() + it->ofs, it->length);
+        return true;
+    }
+
+    bool readBlob(quint32 id, QByteArray *result, const QByteArray& def = QByteArray()) const
+    {
+        Elements::const_iterator it = m_elements.constFind(id);
+
+        if ((it == m_elements.constEnd()) || (it->type != 8))
+        {
+            *result = def;
+            return false;
+        }
+
+        *result = QByteArray(m_data.data() + it->ofs, it->length);
+        return true;
+    }
+
+private:
+    QByteArray m_data;
+    bool m_valid;
+    Elements m_elements;
+    quint32 m_version;
+
+    quint64 readUnsigned(const Element& element) const
+    {
+        quint64 tmp = 0;
+
+        for (quint32 i = 0; i < element.length; i++) {
+            tmp = (tmp << 8) | (quint8) m_data[element.ofs + i];
+        }
+
+        return tmp;
+    }
+
+    template<typename T>
+    bool readUnsigned(quint32 id, int type, quint32 maxLength, T *result, T def) const
+    {
+        Elements::const_iterator it = m_elements.constFind(id);
+
+        if ((it == m_elements.constEnd()) || (it->type != type) || (it->length > maxLength))
+        {
+            *result = def;
+            return false;
+        }
+
+        *result = (T) readUnsigned(*it);
+        return true;
+    }
+
+    template<typename T>
+    bool readSigned(quint32 id, int type, quint32 maxLength, T *result, T def) const
+    {
+        Elements::const_iterator it = m_elements.constFind(id);
+
+        if ((it == m_elements.constEnd()) || (it->type != type) || (it->length > maxLength))
+        {
+            *result = def;
+            return false;
+        }
+
+        T tmp = (it->length > 0) && (m_data[it->ofs] & 0x80) ? -1 : 0;
+
+        for (quint32 i = 0; i < it->length; i++) {
+            tmp = (tmp << 8) | (quint8) m_data[it->ofs + i];
+        }
+
+        *result = tmp;
+        return true;
+    }
+
+    bool parseAll()
+    {
+        quint32 readOfs = 0;
+        quint32 size = m_data.size();
+
+        while (readOfs < size)
+        {
+            quint8 tag = m_data[readOfs++];
+            int idLen = ((tag >> 2) & 0x03) + 1;
+            int lengthLen = (tag & 0x03) + 1;
+
+            if (readOfs + idLen + lengthLen > size) {
+                return false;
+            }
+
+            quint32 id = 0, length = 0;
+
+            for (int i = 0; i < idLen; i++) {
+                id = (id << 8) | (quint8) m_data[readOfs++];
+            }
+
+            for (int i = 0; i < lengthLen; i++) {
+                length = (length << 8) | (quint8) m_data[readOfs++];
+            }
+
+            if ((readOfs + length > size) || m_elements.contains(id)) {
+                return false;
+            }
+
+            m_elements.insert(id, Element(tag >> 4, readOfs, length));
+            readOfs += length;
+
+            if (readOfs == size) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+// Fields of a serialized settings object in the order they are read, blobs that are serialized settings themselves are nested
+struct SerializedNode
+{
+    struct Field
+    {
+        quint32 m_id;
+        int m_type;
+        std::shared_ptr<SerializedNode> m_nested;
+    };
+
+    std::vector<Field> m_fields;
+};
+
+static std::shared_ptr<SerializedNode> scanSerialized(const QByteArray& data)
+{
+    LegacySimpleDeserializer d(data);
+
+    if (!d.isValid() || (d.getElements().size() < 2)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<SerializedNode> node(new SerializedNode);
+
+    for (LegacySimpleDeserializer::Elements::const_iterator it = d.getElements().begin(); it != d.getElements().end(); ++it)
+    {
+        if (it.key() == 0) {
+            continue; // version
+        }
+
+        SerializedNode::Field field;
+        field.m_id = it.key();
+        field.m_type = it->type;
+
+        if (it->type == 8)
+        {
+            QByteArray blob;
+            d.readBlob(it.key(), &blob);
+            field.m_nested = scanSerialized(blob);
+        }
+
+        node->m_fields.push_back(field);
+    }
+
+    return node;
+}
+
+// Reads every field like the deserialize methods of the settings do, returns a checksum of the values
+template<class Deserializer>
+static quint64 readSerialized(const QByteArray& data, const SerializedNode& node)
+{
+    Deserializer d(data);
+    quint64 checksum = d.getVersion();
+
+    for (std::vector<SerializedNode::Field>::const_iterator it = node.m_fields.begin(); it != node.m_fields.end(); ++it)
+    {
+        switch (it->m_type)
+        {
+        case 0: { qint32 v; d.readS32(it->m_id, &v); checksum += v; break; }
+        case 1: { quint32 v; d.readU32(it->m_id, &v); checksum += v; break; }
+        case 2: { qint64 v; d.readS64(it->m_id, &v); checksum += v; break; }
+        case 3: { quint64 v; d.readU64(it->m_id, &v); checksum += v; break; }
+        case 4: { float v; d.readFloat(it->m_id, &v); checksum += (quint64) v; break; }
+        case 5: { double v; d.readDouble(it->m_id, &v); checksum += (quint64) v; break; }
+        case 6: { bool v; d.readBool(it->m_id, &v); checksum += v ? 1 : 0; break; }
+        case 7: { QString v; d.readString(it->m_id, &v); checksum += v.size(); break; }
+        case 8:
+        {
+            QByteArray v;
+            d.readBlob(it->m_id, &v);
+            checksum += v.size();
+
+            if (it->m_nested) {
+                checksum += readSerialized<Deserializer>(v, *it->m_nested);
+            }
+
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return checksum;
+}
+
+// Typical multi device preset: 4 devices and 24 channels with their GUI settings nested in the channel settings
+static QByteArray makeSyntheticPreset()
+{
+    Preset preset;
+    preset.setGroup("bench");
+    preset.setDescription("synthetic");
+    preset.setCenterFrequency(145000000);
+    preset.setLayout(QByteArray(2048, 'L'));
+    preset.setSpectrumConfig(QByteArray(256, 'S'));
+
+    for (int i = 0; i < 4; i++)
+    {
+        SimpleSerializer s(1);
+
+        for (int j = 1; j < 40; j++) {
+            s.writeS32(j, j * 1000 * (j % 2 ? 1 : -1));
+        }
+
+        s.writeU64(40, 435000000ULL + i);
+        s.writeString(41, "/dev/null");
+        preset.setDeviceConfig(QString("sdrangel.samplesource.bench%1").arg(i), QString("%1").arg(i), i, s.final());
+    }
+
+    for (int i = 0; i < 24; i++)
+    {
+        SimpleSerializer gui(1);
+        gui.writeBool(1, true);
+        gui.writeString(2, "channel marker");
+        gui.writeU32(3, 0xffff00);
+        gui.writeBlob(4, QByteArray(64, 'G'));
+
+        SimpleSerializer s(1);
+
+        for (int j = 1; j < 30; j++) {
+            s.writeS32(j, j * (i + 1));
+        }
+
+        for (int j = 30; j < 40; j++) {
+            s.writeReal(j, j * 0.5f);
+        }
+
+        s.writeString(40, QString("Channel %1").arg(i));
+        s.writeBlob(41, gui.final());
+        s.writeBool(42, i % 2 == 0);
+        preset.addChannel("sdrangel.channel.bench", s.final());
+    }
+
+    return preset.serialize();
+}
+
+void MainBench::testSimpleSerializer()
+{
+    std::vector<QByteArray> presets;
+
+    qDebug() << "MainBench::testSimpleSerializer: create test data";
+
+    if (m_parser.getFileName().isEmpty())
+    {
+        presets.push_back(makeSyntheticPreset());
+    }
+    else
+    {
+        // preset export file (.prex), preset store file or preset store directory
+        QFileInfo fileInfo(m_parser.getFileName());
+        QStringList fileNames;
+
+        if (fileInfo.isDir())
+        {
+            QDir dir(fileInfo.absoluteFilePath());
+            QStringList storeFiles = dir.entryList(QStringList() << "*.dat", QDir::Files);
+
+            for (int i = 0; i < storeFiles.size(); i++) {
+                fileNames.append(dir.absoluteFilePath(storeFiles[i]));
+            }
+        }
+        else
+        {
+            fileNames.append(fileInfo.absoluteFilePath());
+        }
+
+        for (int i = 0; i < fileNames.size(); i++)
+        {
+            QFile file(fileNames[i]);
+
+            if (!file.open(QIODevice::ReadOnly))
+            {
+                qWarning("MainBench::testSimpleSerializer: cannot open %s", qPrintable(fileNames[i]));
+                continue;
+            }
+
+            QByteArray data = file.readAll();
+            presets.push_back(fileNames[i].endsWith(".prex") ? QByteArray::fromBase64(data) : qUncompress(data));
+        }
+    }
+
+    std::vector<QByteArray> readablePresets;
+    std::vector<std::shared_ptr<SerializedNode>> nodes;
+    int nbBytes = 0;
+
+    for (std::vector<QByteArray>::const_iterator it = presets.begin(); it != presets.end(); ++it)
+    {
+        std::shared_ptr<SerializedNode> node = scanSerialized(*it);
+
+        if (node)
+        {
+            readablePresets.push_back(*it);
+            nodes.push_back(node);
+            nbBytes += it->size();
+        }
+    }
+
+    presets.swap(readablePresets);
+
+    if (presets.size() == 0)
+    {
+        qWarning("MainBench::testSimpleSerializer: no presets to read");
+        return;
+    }
+
+    int mismatches = 0;
+
+    for (unsigned int i = 0; i < presets.size(); i++)
+    {
+        if (readSerialized<LegacySimpleDeserializer>(presets[i], *nodes[i]) != readSerialized<SimpleDeserializer>(presets[i], *nodes[i])) {
+            mismatches++;
+        }
+    }
+
+    qDebug() << "MainBench::testSimpleSerializer: run test";
+
+    // one pass reads every preset as when switching to it
+    unsigned int nbPasses = m_parser.getNbSamples() / 1024;
+    QElapsedTimer timer;
+    qint64 nsecsLegacy = 0, nsecsInPlace = 0;
+    quint64 checksumLegacy = 0, checksumInPlace = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (unsigned int j = 0; j < nbPasses; j++)
+        {
+            for (unsigned int k = 0; k < presets.size(); k++) {
+                checksumLegacy += readSerialized<LegacySimpleDeserializer>(presets[k], *nodes[k]);
+            }
+        }
+
+        nsecsLegacy += timer.nsecsElapsed();
+        timer.start();
+
+        for (unsigned int j = 0; j < nbPasses; j++)
+        {
+            for (unsigned int k = 0; k < presets.size(); k++) {
+                checksumInPlace += readSerialized<SimpleDeserializer>(presets[k], *nodes[k]);
+            }
+        }
+
+        nsecsInPlace += timer.nsecsElapsed();
+    }
+
+    double nbReads = (double) nbPasses * presets.size() * m_parser.getRepetition();
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testSimpleSerializer: %1 presets %2 bytes %3 mismatches %4 preset reads")
+        .arg(presets.size()).arg(nbBytes).arg(mismatches).arg(nbReads);
+    info << tr("\n  map of elements:   %1 us/preset").arg(nsecsLegacy / (nbReads * 1000.0), 0, 'f', 2);
+    info << tr("\n  fields in place:   %1 us/preset").arg(nsecsInPlace / (nbReads * 1000.0), 0, 'f', 2);
+    info << tr("\n  checksums %1").arg(checksumLegacy == checksumInPlace ? "match" : "differ");
+}
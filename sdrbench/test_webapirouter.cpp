@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapirouter.h"
+
+#include "mainbench.h"
+
+// Path resolution as performed by WebAPIRequestMapper before the route trie.
+// Returns the equivalent route identifier so that both methods can be cross checked.
+static WebAPIRouter::RouteId legacyRoute(const QByteArray& path)
+{
+    if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        return WebAPIRouter::RouteInstanceSummary;
+    } else if (path == WebAPIAdapterInterface::instanceConfigURL) {
+        return WebAPIRouter::RouteInstanceConfig;
+    } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+        return WebAPIRouter::RouteInstanceDevices;
+    } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+        return WebAPIRouter::RouteInstanceChannels;
+    } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+        return WebAPIRouter::RouteInstanceLogging;
+    } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+        return WebAPIRouter::RouteInstanceAudio;
+    } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+        return WebAPIRouter::RouteInstanceAudioInputParameters;
+    } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+        return WebAPIRouter::RouteInstanceAudioOutputParameters;
+    } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+        return WebAPIRouter::RouteInstanceAudioInputCleanup;
+    } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+        return WebAPIRouter::RouteInstanceAudioOutputCleanup;
+    } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+        return WebAPIRouter::RouteInstanceLocation;
+    } else if (path == WebAPIAdapterInterface::instanceAMBESerialURL) {
+        return WebAPIRouter::RouteInstanceAMBESerial;
+    } else if (path == WebAPIAdapterInterface::instanceAMBEDevicesURL) {
+        return WebAPIRouter::RouteInstanceAMBEDevices;
+    } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+        return WebAPIRouter::RouteInstancePresets;
+    } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+        return WebAPIRouter::RouteInstancePreset;
+    } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+        return WebAPIRouter::RouteInstancePresetFile;
+    } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+        return WebAPIRouter::RouteInstanceDeviceSets;
+    } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+        return WebAPIRouter::RouteInstanceDeviceSet;
+    }
+
+    std::smatch desc_match;
+    std::string pathStr(path.constData(), path.length());
+
+    if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
+        return WebAPIRouter::RouteDeviceset;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
+        return WebAPIRouter::RouteDevicesetDevice;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
+        return WebAPIRouter::RouteDevicesetFocus;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
+        return WebAPIRouter::RouteDevicesetDeviceSettings;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
+        return WebAPIRouter::RouteDevicesetDeviceRun;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
+        return WebAPIRouter::RouteDevicesetDeviceReport;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
+        return WebAPIRouter::RouteDevicesetChannelsReport;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
+        return WebAPIRouter::RouteDevicesetChannel;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
+        return WebAPIRouter::RouteDevicesetChannelIndex;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
+        return WebAPIRouter::RouteDevicesetChannelSettings;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
+        return WebAPIRouter::RouteDevicesetChannelReport;
+    }
+
+    return WebAPIRouter::RouteNone;
+}
+
+void MainBench::testWebAPIRouter()
+{
+    QElapsedTimer timer;
+    qint64 nsecsLegacy = 0;
+    qint64 nsecsRouter = 0;
+    std::vector<QByteArray> paths;
+
+    qDebug() << "MainBench::testWebAPIRouter: create test data";
+
+    if (m_parser.getFileName().isEmpty())
+    {
+        // typical monitoring mix: channel reports of 4 device sets with 10 channels each
+        // plus device reports and a few instance level queries
+        for (int deviceSetIndex = 0; deviceSetIndex < 4; deviceSetIndex++)
+        {
+            for (int channelIndex = 0; channelIndex < 10; channelIndex++) {
+                paths.push_back(QString("/sdrangel/deviceset/%1/channel/%2/report").arg(deviceSetIndex).arg(channelIndex).toLatin1());
+            }
+
+            paths.push_back(QString("/sdrangel/deviceset/%1/device/report").arg(deviceSetIndex).toLatin1());
+            paths.push_back(QString("/sdrangel/deviceset/%1/channels/report").arg(deviceSetIndex).toLatin1());
+        }
+
+        paths.push_back("/sdrangel");
+        paths.push_back("/sdrangel/devicesets");
+        paths.push_back("/index.html");
+    }
+    else
+    {
+        // recorded mix: one request per line as "<method> <path>" or "<path>"
+        QFile file(m_parser.getFileName());
+
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            qWarning("MainBench::testWebAPIRouter: cannot open %s", qPrintable(m_parser.getFileName()));
+            return;
+        }
+
+        QTextStream in(&file);
+
+        while (!in.atEnd())
+        {
+            QStringList fields = in.readLine().simplified().split(' ');
+
+            if (!fields.back().isEmpty()) {
+                paths.push_back(fields.back().toLatin1());
+            }
+        }
+    }
+
+    if (paths.size() == 0)
+    {
+        qWarning("MainBench::testWebAPIRouter: no requests to replay");
+        return;
+    }
+
+    WebAPIRouter router;
+    int mismatches = 0;
+
+    for (std::vector<QByteArray>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+    {
+        WebAPIRouter::Match match;
+        router.match(*it, match);
+
+        if (legacyRoute(*it) != match.m_route)
+        {
+            qDebug("MainBench::testWebAPIRouter: route mismatch on %s", it->constData());
+            mismatches++;
+        }
+    }
+
+    qDebug() << "MainBench::testWebAPIRouter: run test";
+
+    uint64_t nbRequests = m_parser.getNbSamples();
+    int legacyMatches = 0;
+    int routerMatches = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (uint64_t j = 0; j < nbRequests; j++) {
+            legacyMatches += legacyRoute(paths[j % paths.size()]) != WebAPIRouter::RouteNone ? 1 : 0;
+        }
+
+        nsecsLegacy += timer.nsecsElapsed();
+        timer.start();
+
+        for (uint64_t j = 0; j < nbRequests; j++)
+        {
+            WebAPIRouter::Match match;
+            routerMatches += router.match(paths[j % paths.size()], match) ? 1 : 0;
+        }
+
+        nsecsRouter += timer.nsecsElapsed();
+    }
+
+    double nbTotal = (double) nbRequests * m_parser.getRepetition();
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testWebAPIRouter: %1 distinct paths %2 mismatches %3 requests").arg(paths.size()).arg(mismatches).arg(nbTotal);
+    info << tr("\n  regex chain: %L1 ns (%2 matched) - %3 ns/request").arg(nsecsLegacy).arg(legacyMatches).arg(nsecsLegacy / nbTotal);
+    info << tr("\n  route trie:  %L1 ns (%2 matched) - %3 ns/request").arg(nsecsRouter).arg(routerMatches).arg(nsecsRouter / nbTotal);
+}
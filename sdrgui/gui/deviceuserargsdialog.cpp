@@ -31,6 +31,20 @@ DeviceUserArgsDialog::DeviceUserArgsDialog(
     m_deviceUserArgsCopy(hardwareDeviceUserArgs)
 {
 	ui->setupUi(this);
+    displayHWDevices();
+    connect(m_deviceEnumerator, SIGNAL(devicesChanged()), this, SLOT(displayHWDevices()));
+    displayArgsByDevice();
+}
+
+DeviceUserArgsDialog::~DeviceUserArgsDialog()
+{
+    delete ui;
+}
+
+void DeviceUserArgsDialog::displayHWDevices()
+{
+    m_availableHWDevices.clear();
+    ui->deviceTree->clear();
 
 	for (int i = 0; i < m_deviceEnumerator->getNbRxSamplingDevices(); i++) {
 		pushHWDeviceReference(m_deviceEnumerator->getRxSamplingDevice(i));
@@ -55,13 +69,6 @@ DeviceUserArgsDialog::DeviceUserArgsDialog(
     ui->deviceTree->resizeColumnToContents(0);
     ui->deviceTree->resizeColumnToContents(1);
     ui->deviceTree->resizeColumnToContents(2);
-
-    displayArgsByDevice();
-}
-
-DeviceUserArgsDialog::~DeviceUserArgsDialog()
-{
-    delete ui;
 }
 
 void DeviceUserArgsDialog::displayArgsByDevice()
@@ -63,6 +63,7 @@ private:
     void displayArgsByDevice();
 
 private slots:
+    void displayHWDevices();
 	void accept();
 	void reject();
     void on_importDevice_clicked(bool checked);
@@ -16,10 +16,12 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#if 0 //def USE_SSE2
+#ifdef USE_SSE2
 #include <emmintrin.h>
 #endif
 
+#include <algorithm>
+
 #include <QMouseEvent>
 #include <QOpenGLShaderProgram>
 #include <QOpenGLFunctions>
@@ -49,6 +51,9 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_displayGridIntensity(5),
 	m_displayTraceIntensity(50),
 	m_invertedWaterfall(false),
+	m_accumulatedCount(0),
+	m_accumulationMode(AccumulateMax),
+	m_displayRate(20),
 	m_displayMaxHold(false),
 	m_currentSpectrum(0),
 	m_displayCurrent(false),
@@ -147,7 +152,7 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_frequencyScale.setOrientation(Qt::Horizontal);
 
 	connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
-	m_timer.start(50);
+	m_timer.start(1000 / m_displayRate);
 }
 
 GLSpectrum::~GLSpectrum()
@@ -212,6 +217,27 @@ void GLSpectrum::setHistoStroke(int stroke)
 	m_histogramStroke = stroke < 1 ? 1 : stroke > 60 ? 60 : stroke;
 }
 
+void GLSpectrum::setDisplayRate(int displayRate)
+{
+    m_mutex.lock();
+    m_displayRate = displayRate < 1 ? 1 : displayRate > 100 ? 100 : displayRate;
+    m_changesPending = true; // waterfall time scale
+    m_mutex.unlock();
+
+    if (m_timer.isActive()) {
+        m_timer.start(1000 / m_displayRate);
+    }
+
+    update();
+}
+
+void GLSpectrum::setAccumulationMode(AccumulationMode accumulationMode)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_accumulationMode = accumulationMode;
+    m_accumulatedCount = 0;
+}
+
 void GLSpectrum::setSampleRate(qint32 sampleRate)
 {
     m_mutex.lock();
@@ -382,8 +408,81 @@ void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 		return;
 	}
 
-	updateWaterfall(spectrum);
-	updateHistogram(spectrum);
+	// spectra are only rendered at the display rate
+	accumulateSpectrum(spectrum);
+
+	if (m_renderTimer.isValid() && (m_renderTimer.elapsed() < 1000 / m_displayRate)) {
+		return;
+	}
+
+	m_renderTimer.start();
+	renderSpectrum();
+}
+
+void GLSpectrum::accumulateSpectrum(const std::vector<Real>& spectrum)
+{
+	if ((int) m_accumulatedSpectrum.size() != m_fftSize)
+	{
+		m_accumulatedSpectrum.resize(m_fftSize);
+		m_accumulatedCount = 0;
+	}
+
+	Real *acc = m_accumulatedSpectrum.data();
+	const Real *s = spectrum.data();
+
+	if (m_accumulatedCount == 0)
+	{
+		std::copy(s, s + m_fftSize, acc);
+	}
+	else if (m_accumulationMode == AccumulateMax)
+	{
+		for (int i = 0; i < m_fftSize; i++) {
+			acc[i] = s[i] > acc[i] ? s[i] : acc[i];
+		}
+	}
+	else
+	{
+		for (int i = 0; i < m_fftSize; i++) {
+			acc[i] += s[i];
+		}
+	}
+
+	m_accumulatedCount++;
+}
+
+void GLSpectrum::renderSpectrum()
+{
+	if (m_accumulatedCount == 0) {
+		return;
+	}
+
+	m_renderedSpectrum.resize(m_fftSize);
+
+	if ((m_accumulationMode == AccumulateMean) && (m_accumulatedCount > 1))
+	{
+		Real norm = 1.0f / m_accumulatedCount;
+
+		for (int i = 0; i < m_fftSize; i++) {
+			m_renderedSpectrum[i] = m_accumulatedSpectrum[i] * norm;
+		}
+	}
+	else
+	{
+		std::copy(m_accumulatedSpectrum.begin(), m_accumulatedSpectrum.begin() + m_fftSize, m_renderedSpectrum.begin());
+	}
+
+	m_accumulatedCount = 0;
+	updateWaterfall(m_renderedSpectrum);
+	updateHistogram(m_renderedSpectrum);
+}
+
+float GLSpectrum::getWaterfallLineTime() const
+{
+	// a line is at least a display period as spectra coming faster are accumulated
+	float scaleDiv = ((float)m_sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
+	float fftTime = m_fftSize / scaleDiv;
+	float displayTime = 1.0f / m_displayRate;
+	return fftTime > displayTime ? fftTime : displayTime;
 }
 
 void GLSpectrum::updateWaterfall(const std::vector<Real>& spectrum)
@@ -416,15 +515,19 @@ void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
 
 		if ((m_decay > 1) || (m_decayDivisorCount <= 0))
 		{
-			for (int i = 0; i < fftMulSize; i++)
-			{
-				if (*b > m_decay) {
-					*b = *b - m_decay;
-				} else {
-				    *b = 0;
-				}
+			// saturated subtraction: values at or below the decay go to zero
+			int i = 0;
+#ifdef USE_SSE2
+			const __m128i decay = _mm_set1_epi8((char) m_decay);
 
-				b++;
+			for (; i + 16 <= fftMulSize; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i *) (b + i));
+				_mm_storeu_si128((__m128i *) (b + i), _mm_subs_epu8(v, decay));
+			}
+#endif
+			for (; i < fftMulSize; i++) {
+				b[i] = b[i] > m_decay ? b[i] - m_decay : 0;
 			}
 
 			m_decayDivisorCount = m_decayDivisor;
@@ -499,20 +602,28 @@ void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
         }
     }
 #else
+    // the scaling loop has no dependency between bins and is vectorized by the compiler
+    if ((int) m_histogramRows.size() < m_fftSize) {
+        m_histogramRows.resize(m_fftSize);
+    }
+
+    int *rows = m_histogramRows.data();
+    const Real *s = spectrum.data();
+    const Real scale = 100.0f / m_powerRange;
+    const Real offset = 100.0f - m_referenceLevel * scale;
+
+    for (int i = 0; i < m_fftSize; i++) {
+        rows[i] = (int) (s[i] * scale + offset);
+    }
+
     for (int i = 0; i < m_fftSize; i++)
     {
-        int v = (int)((spectrum[i] - m_referenceLevel) * 100.0 / m_powerRange + 100.0);
-
-        if ((v >= 0) && (v <= 99))
+        if ((unsigned int) rows[i] <= 99)
         {
-            b = m_histogram + i * 100 + v;
-
+            b = m_histogram + i * 100 + rows[i];
             // capping to 239 as palette values are [0..239]
-            if (*b + m_histogramStroke <= 239) {
-                *b += m_histogramStroke; // was 4
-            } else {
-                *b = 239;
-            }
+            int v = *b + m_histogramStroke;
+            *b = v > 239 ? 239 : v;
         }
     }
 #endif
@@ -1110,15 +1221,15 @@ void GLSpectrum::applyChanges()
 
 		if(m_sampleRate > 0)
 		{
-			float scaleDiv = ((float)m_sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
+			float lineTime = getWaterfallLineTime();
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, waterfallHeight * lineTime, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, waterfallHeight * lineTime);
 			}
 		}
 		else
@@ -1214,15 +1325,15 @@ void GLSpectrum::applyChanges()
 
 		if(m_sampleRate > 0)
 		{
-			float scaleDiv = ((float)m_sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
+			float lineTime = getWaterfallLineTime();
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, waterfallHeight * lineTime, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, waterfallHeight * lineTime);
 			}
 		}
 		else
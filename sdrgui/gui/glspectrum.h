@@ -23,6 +23,7 @@
 #define INCLUDE_GLSPECTRUM_H
 
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QOpenGLBuffer>
 #include <QOpenGLVertexArrayObject>
@@ -61,6 +62,12 @@ public:
         quint32 m_sampleRate;
     };
 
+    enum AccumulationMode
+    {
+        AccumulateMax,  //!< peak of each bin over the spectra of a rendered line
+        AccumulateMean  //!< average of each bin over the spectra of a rendered line
+    };
+
 	GLSpectrum(QWidget* parent = NULL);
 	~GLSpectrum();
 
@@ -83,6 +90,8 @@ public:
 	void setDisplayGridIntensity(int intensity);
 	void setDisplayTraceIntensity(int intensity);
 	void setLinear(bool linear);
+	void setDisplayRate(int displayRate); //!< Rendered spectra per second. Spectra coming faster are accumulated.
+	void setAccumulationMode(AccumulationMode accumulationMode);
 	qint32 getSampleRate() const { return m_sampleRate; }
 
 	void addChannelMarker(ChannelMarker* channelMarker);
@@ -150,6 +159,13 @@ private:
 	int m_displayTraceIntensity;
 	bool m_invertedWaterfall;
 
+	std::vector<Real> m_accumulatedSpectrum; //!< spectra received since the last rendered line
+	std::vector<Real> m_renderedSpectrum;    //!< last rendered line
+	int m_accumulatedCount;
+	AccumulationMode m_accumulationMode;
+	int m_displayRate;
+	QElapsedTimer m_renderTimer;
+
 	std::vector<Real> m_maxHold;
 	bool m_displayMaxHold;
 	const std::vector<Real> *m_currentSpectrum;
@@ -183,6 +199,7 @@ private:
 	int m_decayDivisor;
 	int m_decayDivisorCount;
 	int m_histogramStroke;
+	std::vector<int> m_histogramRows; //!< histogram row of each bin of the spectrum being stroked
 	QMatrix4x4 m_glHistogramSpectrumMatrix;
 	QMatrix4x4 m_glHistogramBoxMatrix;
 	bool m_displayHistogram;
@@ -206,6 +223,9 @@ private:
 
 	static const int m_waterfallBufferHeight = 256;
 
+	void accumulateSpectrum(const std::vector<Real>& spectrum);
+	void renderSpectrum();
+	float getWaterfallLineTime() const;
 	void updateWaterfall(const std::vector<Real>& spectrum);
 	void updateHistogram(const std::vector<Real>& spectrum);
 
@@ -31,7 +31,10 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	m_averagingMode(AvgModeNone),
 	m_averagingIndex(0),
 	m_averagingMaxScale(5),
-	m_averagingNb(0)
+	m_averagingNb(0),
+	m_linear(false),
+	m_displayRate(20),
+	m_accumulationMode(AccumulateMax)
 {
 	ui->setupUi(this);
 	on_linscale_toggled(false);
@@ -79,6 +82,8 @@ void GLSpectrumGUI::resetToDefaults()
 	m_averagingMode = AvgModeNone;
 	m_averagingIndex = 0;
 	m_linear = false;
+	m_displayRate = 20;
+	m_accumulationMode = AccumulateMax;
 	applySettings();
 }
 
@@ -107,6 +112,8 @@ QByteArray GLSpectrumGUI::serialize() const
 	s.writeS32(19, (int) m_averagingMode);
 	s.writeS32(20, (qint32) getAveragingValue(m_averagingIndex));
 	s.writeBool(21, m_linear);
+	s.writeS32(22, m_displayRate);
+	s.writeS32(23, (int) m_accumulationMode);
 
     return s.final();
 }
@@ -149,6 +156,10 @@ bool GLSpectrumGUI::deserialize(const QByteArray& data)
 		m_averagingIndex = getAveragingIndex(tmp);
 	    m_averagingNb = getAveragingValue(m_averagingIndex);
 	    d.readBool(21, &m_linear, false);
+		d.readS32(22, &tmp, 20);
+		m_displayRate = tmp < 1 ? 1 : tmp > 100 ? 100 : tmp;
+		d.readS32(23, &tmp, 0);
+		m_accumulationMode = tmp == 1 ? AccumulateMean : AccumulateMax;
 
         m_glSpectrum->setWaterfallShare(waterfallShare);
     	applySettings();
@@ -175,6 +186,8 @@ void GLSpectrumGUI::applySettings()
 	ui->averaging->setCurrentIndex(m_averagingIndex);
 	ui->averagingMode->setCurrentIndex((int) m_averagingMode);
 	ui->linscale->setChecked(m_linear);
+	ui->displayRate->setValue(m_displayRate);
+	ui->accumulationMode->setCurrentIndex((int) m_accumulationMode);
 	ui->decay->setSliderPosition(m_decay);
 	ui->decayDivisor->setSliderPosition(m_decayDivisor);
 	ui->stroke->setSliderPosition(m_histogramStroke);
@@ -204,6 +217,8 @@ void GLSpectrumGUI::applySettings()
 	m_glSpectrum->setDisplayGrid(m_displayGrid);
 	m_glSpectrum->setDisplayGridIntensity(m_displayGridIntensity);
 	m_glSpectrum->setLinear(m_linear);
+	m_glSpectrum->setDisplayRate(m_displayRate);
+	m_glSpectrum->setAccumulationMode((GLSpectrum::AccumulationMode) m_accumulationMode);
 
 	if (m_spectrumVis) {
 	    m_spectrumVis->configure(m_messageQueueToVis,
@@ -335,6 +350,22 @@ void GLSpectrumGUI::on_linscale_toggled(bool checked)
     }
 }
 
+void GLSpectrumGUI::on_displayRate_valueChanged(int value)
+{
+	m_displayRate = value;
+	if(m_glSpectrum != 0) {
+	    m_glSpectrum->setDisplayRate(m_displayRate);
+	}
+}
+
+void GLSpectrumGUI::on_accumulationMode_currentIndexChanged(int index)
+{
+	m_accumulationMode = index == 1 ? AccumulateMean : AccumulateMax;
+	if(m_glSpectrum != 0) {
+	    m_glSpectrum->setAccumulationMode((GLSpectrum::AccumulationMode) m_accumulationMode);
+	}
+}
+
 void GLSpectrumGUI::on_refLevel_currentIndexChanged(int index)
 {
 	m_refLevel = 0 - index * 5;
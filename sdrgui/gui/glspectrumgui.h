@@ -26,6 +26,12 @@ public:
         AvgModeMax
     };
 
+    enum AccumulationMode
+    {
+        AccumulateMax,
+        AccumulateMean
+    };
+
 	explicit GLSpectrumGUI(QWidget* parent = NULL);
 	~GLSpectrumGUI();
 
@@ -65,6 +71,8 @@ private:
 	int m_averagingMaxScale; //!< Max power of 10 multiplier to 2,5,10 base ex: 2 -> 2,5,10,20,50,100,200,500,1000
 	unsigned int m_averagingNb;
 	bool m_linear; //!< linear else logarithmic scale
+	int m_displayRate; //!< spectrum lines rendered per second
+	AccumulationMode m_accumulationMode; //!< how the spectra coming faster than the display rate are combined
 
 	void applySettings();
 	int getAveragingIndex(int averaging) const;
@@ -88,6 +96,8 @@ private slots:
 	void on_averagingMode_currentIndexChanged(int index);
     void on_averaging_currentIndexChanged(int index);
     void on_linscale_toggled(bool checked);
+	void on_displayRate_valueChanged(int value);
+	void on_accumulationMode_currentIndexChanged(int index);
 
 	void on_waterfall_toggled(bool checked);
 	void on_histogram_toggled(bool checked);
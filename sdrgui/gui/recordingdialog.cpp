@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "recordingdialog.h"
+#include "ui_recordingdialog.h"
+
+RecordingDialog::RecordingDialog(MainSettings& mainSettings, QWidget* parent) :
+    QDialog(parent),
+    ui(new Ui::RecordingDialog),
+    m_mainSettings(mainSettings)
+{
+    ui->setupUi(this);
+    const Preferences& preferences = m_mainSettings.getPreferences();
+    ui->nbBuffers->setValue(preferences.getRecordNbBuffers());
+    ui->bufferSize->setValue(preferences.getRecordBufferSize());
+    ui->preallocation->setValue(preferences.getRecordPreallocation());
+    ui->maxFileSize->setValue(preferences.getRecordMaxFileSize());
+    ui->maxFileSeconds->setValue(preferences.getRecordMaxFileSeconds());
+    ui->directIO->setChecked(preferences.getRecordDirectIO());
+    ui->sigMF->setChecked(preferences.getRecordSigMF());
+    ui->sigMFPackingBits->setValue(preferences.getRecordSigMFPackingBits());
+    ui->sigMFCompressed->setChecked(preferences.getRecordSigMFCompressed());
+}
+
+RecordingDialog::~RecordingDialog()
+{
+    delete ui;
+}
+
+void RecordingDialog::accept()
+{
+    Preferences preferences = m_mainSettings.getPreferences();
+    preferences.setRecordNbBuffers(ui->nbBuffers->value());
+    preferences.setRecordBufferSize(ui->bufferSize->value());
+    preferences.setRecordPreallocation(ui->preallocation->value());
+    preferences.setRecordMaxFileSize(ui->maxFileSize->value());
+    preferences.setRecordMaxFileSeconds(ui->maxFileSeconds->value());
+    preferences.setRecordDirectIO(ui->directIO->isChecked());
+    preferences.setRecordSigMF(ui->sigMF->isChecked());
+    preferences.setRecordSigMFPackingBits(ui->sigMFPackingBits->value());
+    preferences.setRecordSigMFCompressed(ui->sigMFCompressed->isChecked());
+    m_mainSettings.setPreferences(preferences);
+    QDialog::accept();
+}
@@ -19,6 +19,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "samplingdevicedialog.h"
 #include "ui_samplingdevicedialog.h"
 #include "device/deviceenumerator.h"
@@ -32,8 +34,24 @@ SamplingDeviceDialog::SamplingDeviceDialog(int deviceType, int deviceTabIndex, Q
     m_selectedDeviceIndex(-1)
 {
     ui->setupUi(this);
+    displayDevices();
+    // the devices are listed from the last probe while the hardware is probed again
+    connect(DeviceEnumerator::instance(), SIGNAL(devicesChanged()), this, SLOT(displayDevices()));
+    DeviceEnumerator::instance()->refreshDevices();
+}
+
+SamplingDeviceDialog::~SamplingDeviceDialog()
+{
+    delete ui;
+}
 
+void SamplingDeviceDialog::displayDevices()
+{
+    // the device shown as selected stays selected when the list changes
+    int currentIndex = ui->deviceSelect->currentIndex();
+    int currentDeviceIndex = currentIndex < 0 ? -1 : m_deviceIndexes[currentIndex];
     QList<QString> deviceDisplayNames;
+    m_deviceIndexes.clear();
 
     if (m_deviceType == 0) { // Single Rx
         DeviceEnumerator::instance()->listRxDeviceNames(deviceDisplayNames, m_deviceIndexes);
@@ -44,12 +62,17 @@ SamplingDeviceDialog::SamplingDeviceDialog(int deviceType, int deviceTabIndex, Q
     }
 
     QStringList devicesNamesList(deviceDisplayNames);
+    ui->deviceSelect->blockSignals(true);
+    ui->deviceSelect->clear();
     ui->deviceSelect->addItems(devicesNamesList);
-}
 
-SamplingDeviceDialog::~SamplingDeviceDialog()
-{
-    delete ui;
+    std::vector<int>::const_iterator it = std::find(m_deviceIndexes.begin(), m_deviceIndexes.end(), currentDeviceIndex);
+
+    if (it != m_deviceIndexes.end()) {
+        ui->deviceSelect->setCurrentIndex(it - m_deviceIndexes.begin());
+    }
+
+    ui->deviceSelect->blockSignals(false);
 }
 
 void SamplingDeviceDialog::accept()
@@ -47,6 +47,7 @@ private:
     std::vector<int> m_deviceIndexes;
 
 private slots:
+    void displayDevices();
     void accept();
 };
 
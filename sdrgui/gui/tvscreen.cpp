@@ -23,13 +23,15 @@
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
 #include <QSurface>
+#include "dsp/tvframebuffer.h"
 #include "tvscreen.h"
 
 #include <algorithm>
 #include <QDebug>
 
 TVScreen::TVScreen(bool blnColor, QWidget* parent) :
-        QGLWidget(parent), m_objMutex(QMutex::NonRecursive), m_objGLShaderArray(blnColor)
+        QGLWidget(parent), m_objMutex(QMutex::NonRecursive), m_objGLShaderArray(blnColor),
+        m_frameBuffer(nullptr)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);
     connect(&m_objTimer, SIGNAL(timeout()), this, SLOT(tick()));
@@ -176,7 +178,31 @@ void TVScreen::paintGL()
         m_intAskedRows = 0;
     }
 
-    m_objGLShaderArray.RenderPixels(m_chrLastData);
+    if (m_frameBuffer)
+    {
+        const TVFrameBuffer::Frame *frame = m_frameBuffer->acquireFrame();
+
+        if (frame)
+        {
+            if ((frame->m_cols != m_cols) || (frame->m_rows != m_rows))
+            {
+                m_cols = frame->m_cols;
+                m_rows = frame->m_rows;
+                m_objGLShaderArray.InitializeGL(m_cols, m_rows);
+            }
+
+            m_objGLShaderArray.RenderPixels((unsigned char *) frame->m_pixels.data());
+            m_frameBuffer->releaseFrame();
+        }
+        else
+        {
+            m_objGLShaderArray.RenderPixels(0); // last frame
+        }
+    }
+    else
+    {
+        m_objGLShaderArray.RenderPixels(m_chrLastData);
+    }
 
     m_objMutex.unlock();
 }
@@ -188,7 +214,7 @@ void TVScreen::mousePressEvent(QMouseEvent* event)
 
 void TVScreen::tick()
 {
-    if (m_blnDataChanged) {
+    if (m_blnDataChanged || (m_frameBuffer && m_frameBuffer->hasNewFrame())) {
         update();
     }
 }
@@ -35,6 +35,7 @@
 #include "util/bitfieldindex.h"
 
 class QPainter;
+class TVFrameBuffer;
 
 class SDRGUI_API TVScreen: public QGLWidget
 {
@@ -49,6 +50,7 @@ public:
     void resizeTVScreen(int intCols, int intRows);
     void getSize(int& intCols, int& intRows) const;
     void renderImage(unsigned char * objData);
+    void setFrameBuffer(TVFrameBuffer *frameBuffer) { m_frameBuffer = frameBuffer; } //!< complete frames are taken from the buffer instead of the rows
     QRgb* getRowBuffer(int intRow);
     void resetImage();
     void resetImage(int alpha);
@@ -82,6 +84,7 @@ private:
     bool m_blnConfigChanged;
 
     GLShaderTVArray m_objGLShaderArray;
+    TVFrameBuffer *m_frameBuffer;
 
     int m_cols;
     int m_rows;
@@ -47,6 +47,7 @@
 #include "gui/channelwindow.h"
 #include "gui/audiodialog.h"
 #include "gui/loggingdialog.h"
+#include "gui/recordingdialog.h"
 #include "gui/deviceuserargsdialog.h"
 #include "gui/samplingdevicecontrol.h"
 #include "gui/sdrangelsplash.h"
@@ -61,12 +62,14 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
+#include "dsp/filerecord.h"
 #include "plugin/pluginapi.h"
 #include "gui/glspectrum.h"
 #include "gui/glspectrumgui.h"
 #include "loggerwithfile.h"
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
+#include "webapi/webapireversedispatcher.h"
 #include "webapi/webapiadaptergui.h"
 #include "commands/command.h"
 
@@ -109,6 +112,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	qDebug() << "MainWindow::MainWindow: start";
 
     m_instance = this;
+    WebAPIReverseDispatcher::instance(); // created on the main thread before any channel may notify
 
     QFontDatabase::addApplicationFont(":/LiberationSans-Regular.ttf");
     QFontDatabase::addApplicationFont(":/LiberationMono-Regular.ttf");
@@ -229,7 +233,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_requestMapper->setAdapter(m_apiAdapter);
 	m_apiHost = parser.getServerAddress();
 	m_apiPort = parser.getServerPort();
-	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
+	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper, parser.getServerEventLoops());
 	m_apiServer->start();
 
 	m_commandKeyReceiver = new CommandKeyReceiver();
@@ -719,6 +723,7 @@ void MainWindow::loadSettings()
     }
 
     setLoggingOptions();
+    setRecordingOptions();
 }
 
 void MainWindow::loadPresetSettings(const Preset* preset, int tabIndex)
@@ -730,6 +735,19 @@ void MainWindow::loadPresetSettings(const Preset* preset, int tabIndex)
 	if (tabIndex >= 0)
 	{
         DeviceUISet *deviceUI = m_deviceUIs[tabIndex];
+        // channels are replaced with the engine stopped then the engine is restarted without waiting
+        std::vector<int> runningSubsystems;
+        int nbSubsystems = deviceUI->m_deviceMIMOEngine ? 2 : 1;
+
+        for (int subsystemIndex = 0; subsystemIndex < nbSubsystems; subsystemIndex++)
+        {
+            if (deviceUI->m_deviceAPI->state(subsystemIndex) == DeviceAPI::StRunning)
+            {
+                deviceUI->m_deviceAPI->stopDeviceEngine(subsystemIndex);
+                runningSubsystems.push_back(subsystemIndex);
+            }
+        }
+
         deviceUI->m_spectrumGUI->deserialize(preset->getSpectrumConfig());
         deviceUI->m_deviceAPI->loadSamplingDeviceSettings(preset);
 
@@ -740,6 +758,15 @@ void MainWindow::loadPresetSettings(const Preset* preset, int tabIndex)
         } else if (deviceUI->m_deviceMIMOEngine) { // MIMO device
             deviceUI->loadMIMOChannelSettings(preset, m_pluginManager->getPluginAPI());
         }
+
+        for (int subsystemIndex : runningSubsystems)
+        {
+            deviceUI->m_deviceAPI->startDeviceEngineAsync(subsystemIndex, [tabIndex, subsystemIndex](int state) {
+                if (state != DeviceAPI::StRunning) {
+                    qWarning("MainWindow::loadPresetSettings: device set %d subsystem %d failed to restart", tabIndex, subsystemIndex);
+                }
+            });
+        }
 	}
 
 	// has to be last step
@@ -941,6 +968,7 @@ void MainWindow::applySettings()
     }
 
     setLoggingOptions();
+    setRecordingOptions();
 }
 
 bool MainWindow::handleMessage(const Message& cmd)
@@ -1655,6 +1683,13 @@ void MainWindow::on_action_Logging_triggered()
     setLoggingOptions();
 }
 
+void MainWindow::on_action_Recording_triggered()
+{
+    RecordingDialog recordingDialog(m_settings, this);
+    recordingDialog.exec();
+    setRecordingOptions();
+}
+
 void MainWindow::on_action_My_Position_triggered()
 {
 	MyPositionDialog myPositionDialog(m_settings, this);
@@ -2014,6 +2049,11 @@ void MainWindow::updateStatus()
     m_dateTimeWidget->setText(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss t"));
 }
 
+void MainWindow::setRecordingOptions()
+{
+    FileRecord::setRecordingPreferences(m_settings.getPreferences());
+}
+
 void MainWindow::setLoggingOptions()
 {
     m_logger->setConsoleMinMessageLevel(m_settings.getConsoleMinLogLevel());
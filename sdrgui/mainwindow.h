@@ -366,6 +366,7 @@ private:
     void deleteChannel(int deviceSetIndex, int channelIndex);
 
     void setLoggingOptions();
+    void setRecordingOptions();
 
     bool handleMessage(const Message& cmd);
 
@@ -393,6 +394,7 @@ private slots:
     void on_commandKeyboardConnect_toggled(bool checked);
 	void on_action_Audio_triggered();
     void on_action_Logging_triggered();
+    void on_action_Recording_triggered();
     void on_action_AMBE_triggered();
 	void on_action_My_Position_triggered();
     void on_action_DeviceUserArguments_triggered();
@@ -19,6 +19,7 @@
 
 #include <QApplication>
 #include <QList>
+#include <QDateTime>
 #include <QSysInfo>
 
 #include "mainwindow.h"
@@ -32,10 +33,12 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/filerecord.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelapi.h"
 #include "webapi/webapiadapterbase.h"
+#include "webapi/webapireversedispatcher.h"
 
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceConfigResponse.h"
@@ -55,6 +58,10 @@
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGDeviceSetReport.h"
+#include "SWGInstanceReportsResponse.h"
+#include "SWGReverseAPIDispatcherSettings.h"
+#include "SWGReverseAPIDispatcherReport.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
@@ -200,37 +207,35 @@ int WebAPIAdapterGUI::instanceConfigPutPatch(
 
 int WebAPIAdapterGUI::instanceDevices(
             int direction,
+            bool refresh,
             SWGSDRangel::SWGInstanceDevicesResponse& response,
             SWGSDRangel::SWGErrorResponse& error)
 {
     (void) error;
     response.init();
 
-    int nbSamplingDevices;
+    if (refresh) {
+        DeviceEnumerator::instance()->refreshDevices();
+    }
+
+    // the devices lists change on the main thread: they are read from a copy
+    DeviceEnumerator::DevicesSnapshot snapshot;
+    int nbSamplingDevices = 0;
 
-    if (direction == 0) { // Single Rx stream device
-        nbSamplingDevices = DeviceEnumerator::instance()->getNbRxSamplingDevices();
-    } else if (direction == 1) { // Single Tx stream device
-        nbSamplingDevices = DeviceEnumerator::instance()->getNbTxSamplingDevices();
-    } else { // not supported
-        nbSamplingDevices = 0;
+    if ((direction == 0) || (direction == 1)) // Single Rx or Tx stream device. Others not supported.
+    {
+        DeviceEnumerator::instance()->getDevicesSnapshot(direction, snapshot);
+        nbSamplingDevices = snapshot.m_samplingDevices.size();
     }
 
     response.setDevicecount(nbSamplingDevices);
+    response.setEnumerationIndex(snapshot.m_enumerationIndex);
+    response.setTimedOutProbes(snapshot.m_timedOutProbes.size());
     QList<SWGSDRangel::SWGDeviceListItem*> *devices = response.getDevices();
 
     for (int i = 0; i < nbSamplingDevices; i++)
     {
-        const PluginInterface::SamplingDevice *samplingDevice = nullptr;
-
-        if (direction == 0) {
-            samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(i);
-        } else if (direction == 1) {
-            samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(i);
-        } else {
-            continue;
-        }
-
+        const PluginInterface::SamplingDevice *samplingDevice = &snapshot.m_samplingDevices[i];
         devices->append(new SWGSDRangel::SWGDeviceListItem);
         devices->back()->init();
         *devices->back()->getDisplayedName() = samplingDevice->displayedName;
@@ -241,6 +246,7 @@ int WebAPIAdapterGUI::instanceDevices(
         devices->back()->setDeviceNbStreams(samplingDevice->deviceNbItems);
         devices->back()->setDeviceSetIndex(samplingDevice->claimed);
         devices->back()->setIndex(i);
+        devices->back()->setRemoved(snapshot.m_removed[i] ? 1 : 0);
     }
 
     return 200;
@@ -366,6 +372,7 @@ int WebAPIAdapterGUI::instanceAudioGet(
     QList<SWGSDRangel::SWGAudioOutputDevice*> *outputDevices = response.getOutputDevices();
     AudioDeviceManager::InputDeviceInfo inputDeviceInfo;
     AudioDeviceManager::OutputDeviceInfo outputDeviceInfo;
+    AudioStreamingService::StreamStats udpStats;
 
     // system default input device
     inputDevices->append(new SWGSDRangel::SWGAudioInputDevice);
@@ -410,6 +417,10 @@ int WebAPIAdapterGUI::instanceAudioGet(
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
 
+    if (m_mainWindow.m_dspEngine->getAudioDeviceManager()->getOutputUdpStreamStats(-1, udpStats)) {
+        WebAPIAdapterBase::webapiFormatAudioOutputUdpStats(outputDevices->back(), udpStats);
+    }
+
     // real output devices
     for (int i = 0; i < nbOutputDevices; i++)
     {
@@ -429,6 +440,10 @@ int WebAPIAdapterGUI::instanceAudioGet(
         outputDevices->back()->setUdpDecimationFactor((int) outputDeviceInfo.udpDecimationFactor);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+
+        if (m_mainWindow.m_dspEngine->getAudioDeviceManager()->getOutputUdpStreamStats(i, udpStats)) {
+            WebAPIAdapterBase::webapiFormatAudioOutputUdpStats(outputDevices->back(), udpStats);
+        }
     }
 
     return 200;
@@ -749,19 +764,22 @@ int WebAPIAdapterGUI::instanceAMBEDevicesGet(
     (void) error;
     response.init();
 
-    std::vector<std::string> deviceNames;
-    m_mainWindow.m_dspEngine->getDVSerialNames(deviceNames);
-    response.setNbDevices((int) deviceNames.size());
+    std::vector<AMBEEngine::DeviceStats> deviceStats;
+    m_mainWindow.m_dspEngine->getAMBEEngine()->getDeviceStats(deviceStats);
+    response.setNbDevices((int) deviceStats.size());
     QList<SWGSDRangel::SWGAMBEDevice*> *deviceNamesList = response.getAmbeDevices();
 
-    std::vector<std::string>::iterator it = deviceNames.begin();
+    std::vector<AMBEEngine::DeviceStats>::const_iterator it = deviceStats.begin();
 
-    while (it != deviceNames.end())
+    while (it != deviceStats.end())
     {
         deviceNamesList->append(new SWGSDRangel::SWGAMBEDevice);
         deviceNamesList->back()->init();
-        *deviceNamesList->back()->getDeviceRef() = QString::fromStdString(*it);
+        *deviceNamesList->back()->getDeviceRef() = it->m_deviceRef;
         deviceNamesList->back()->setDelete(0);
+        deviceNamesList->back()->setQueueDepth(it->m_queueDepth);
+        deviceNamesList->back()->setNbFrames((qint32) it->m_nbFrames);
+        deviceNamesList->back()->setUtilization(it->m_utilization);
         ++it;
     }
 
@@ -1100,6 +1118,79 @@ int WebAPIAdapterGUI::instanceDeviceSetsGet(
     return 200;
 }
 
+int WebAPIAdapterGUI::instanceReportsGet(
+        int deviceSetIndex,
+        bool withChannels,
+        SWGSDRangel::SWGInstanceReportsResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    int nbDeviceSets = m_mainWindow.m_deviceUIs.size();
+
+    if (deviceSetIndex >= nbDeviceSets)
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+
+    // all reports are stamped with the time at which the collection pass starts
+    response.init();
+    *response.getTimestamp() = QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'");
+    QList<SWGSDRangel::SWGDeviceSetReport*> *deviceSetReports = response.getDeviceSets();
+    QString errorMessage;
+
+    for (int i = 0; i < nbDeviceSets; i++)
+    {
+        if ((deviceSetIndex >= 0) && (i != deviceSetIndex)) {
+            continue;
+        }
+
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[i];
+        deviceSetReports->append(new SWGSDRangel::SWGDeviceSetReport);
+        deviceSetReports->back()->init();
+        deviceSetReports->back()->setIndex(i);
+
+        if (getDeviceReport(deviceSetReports->back()->getDeviceReport(), deviceSet, errorMessage)/100 != 2) {
+            qDebug("WebAPIAdapterGUI::instanceReportsGet: no device report for device set %d: %s", i, qPrintable(errorMessage));
+        }
+
+        if (withChannels) {
+            getChannelsDetail(deviceSetReports->back()->getChannelsDetail(), deviceSet);
+        }
+    }
+
+    response.setDevicesetcount(deviceSetReports->size());
+
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceReverseAPIGet(
+        SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    WebAPIAdapterBase::webapiFormatReverseAPIDispatcherReport(&response, WebAPIReverseDispatcher::instance()->getStats());
+
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceReverseAPIPatch(
+        SWGSDRangel::SWGReverseAPIDispatcherSettings& query,
+        SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    WebAPIReverseDispatcher *dispatcher = WebAPIReverseDispatcher::instance();
+
+    if (query.isSet()) {
+        dispatcher->setCoalescingWindow(query.getCoalescingWindow());
+    }
+
+    WebAPIAdapterBase::webapiFormatReverseAPIDispatcherReport(&response, dispatcher->getStats());
+
+    return 200;
+}
+
 int WebAPIAdapterGUI::instanceDeviceSetPost(
         int direction,
         SWGSDRangel::SWGSuccessResponse& response,
@@ -1207,36 +1298,19 @@ int WebAPIAdapterGUI::devicesetDevicePut(
             return 404;
         }
 
-        int nbSamplingDevices;
+        DeviceEnumerator::DevicesSnapshot snapshot;
+        int nbSamplingDevices = 0;
 
-        if (query.getDirection() == 0) {
-            nbSamplingDevices = DeviceEnumerator::instance()->getNbRxSamplingDevices();
-        } else if (query.getDirection() == 1) {
-            nbSamplingDevices = DeviceEnumerator::instance()->getNbTxSamplingDevices();
-        } else {
-            nbSamplingDevices = 0; // TODO: not implemented yet
+        if ((query.getDirection() == 0) || (query.getDirection() == 1)) // TODO: any device (2) not supported yet
+        {
+            DeviceEnumerator::instance()->getDevicesSnapshot(query.getDirection(), snapshot);
+            nbSamplingDevices = snapshot.m_samplingDevices.size();
         }
 
-
         for (int i = 0; i < nbSamplingDevices; i++)
         {
-            int tx;
-            const PluginInterface::SamplingDevice *samplingDevice;
-
-            if (query.getDirection() == 0)
-            {
-                tx = 0;
-                samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(i);
-            }
-            else if (query.getDirection() == 1)
-            {
-                tx = 1;
-                samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(i);
-            }
-            else
-            {
-                continue; // TODO: any device (2) not supported yet
-            }
+            int tx = query.getDirection();
+            const PluginInterface::SamplingDevice *samplingDevice = &snapshot.m_samplingDevices[i];
 
             if (query.getDisplayedName() && (*query.getDisplayedName() != samplingDevice->displayedName)) {
                 continue;
@@ -1506,26 +1580,7 @@ int WebAPIAdapterGUI::devicesetDeviceReportGet(
     if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
     {
         DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
-
-        if (deviceSet->m_deviceSourceEngine) // Single Rx
-        {
-            response.setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
-            response.setDirection(0);
-            DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
-            return source->webapiReportGet(response, *error.getMessage());
-        }
-        else if (deviceSet->m_deviceSinkEngine) // Single Tx
-        {
-            response.setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
-            response.setDirection(1);
-            DeviceSampleSink *sink = deviceSet->m_deviceAPI->getSampleSink();
-            return sink->webapiReportGet(response, *error.getMessage());
-        }
-        else
-        {
-            *error.getMessage() = QString("DeviceSet error");
-            return 500;
-        }
+        return getDeviceReport(&response, deviceSet, *error.getMessage());
     }
     else
     {
@@ -1984,6 +2039,40 @@ void WebAPIAdapterGUI::getDeviceSet(SWGSDRangel::SWGDeviceSet *deviceSet, const
     }
 }
 
+int WebAPIAdapterGUI::getDeviceReport(SWGSDRangel::SWGDeviceReport *deviceReport, DeviceUISet *deviceSet, QString& errorMessage)
+{
+    if (deviceSet->m_deviceSourceEngine) // Single Rx
+    {
+        deviceReport->setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
+        deviceReport->setDirection(0);
+        DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
+        int status = source->webapiReportGet(*deviceReport, errorMessage);
+        FileRecord *fileRecord = deviceSet->m_deviceAPI->getFileRecord();
+
+        if (fileRecord)
+        {
+            deviceReport->setFileRecordReport(new SWGSDRangel::SWGFileRecordReport());
+            deviceReport->getFileRecordReport()->init();
+            WebAPIAdapterBase::webapiFormatFileRecordReport(deviceReport->getFileRecordReport(), fileRecord);
+            status = status == 501 ? 200 : status; // the recording is reported anyway
+        }
+
+        return status;
+    }
+    else if (deviceSet->m_deviceSinkEngine) // Single Tx
+    {
+        deviceReport->setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
+        deviceReport->setDirection(1);
+        DeviceSampleSink *sink = deviceSet->m_deviceAPI->getSampleSink();
+        return sink->webapiReportGet(*deviceReport, errorMessage);
+    }
+    else
+    {
+        errorMessage = QString("DeviceSet error");
+        return 500;
+    }
+}
+
 void WebAPIAdapterGUI::getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceUISet* deviceUISet)
 {
     channelsDetail->init();
@@ -54,6 +54,7 @@ public:
 
     virtual int instanceDevices(
             int direction,
+            bool refresh,
             SWGSDRangel::SWGInstanceDevicesResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
@@ -167,6 +168,21 @@ public:
             SWGSDRangel::SWGDeviceSetList& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceReportsGet(
+            int deviceSetIndex,
+            bool withChannels,
+            SWGSDRangel::SWGInstanceReportsResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceReverseAPIGet(
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceReverseAPIPatch(
+            SWGSDRangel::SWGReverseAPIDispatcherSettings& query,
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceDeviceSetPost(
             int direction,
             SWGSDRangel::SWGSuccessResponse& response,
@@ -267,6 +283,7 @@ private:
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *deviceSet, const DeviceUISet* deviceUISet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceUISet* deviceUISet);
+    int getDeviceReport(SWGSDRangel::SWGDeviceReport *deviceReport, DeviceUISet *deviceSet, QString& errorMessage);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
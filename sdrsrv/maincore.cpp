@@ -24,6 +24,7 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/filerecord.h"
 #include "device/deviceapi.h"
 #include "device/deviceset.h"
 #include "device/deviceenumerator.h"
@@ -31,6 +32,7 @@
 #include "loggerwithfile.h"
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
+#include "webapi/webapireversedispatcher.h"
 #include "webapi/webapiadaptersrv.h"
 
 #include "maincore.h"
@@ -59,6 +61,7 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     qDebug() << "MainCore::MainCore: start";
 
     m_instance = this;
+    WebAPIReverseDispatcher::instance(); // created on the main thread before any channel may notify
     m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
     m_settings.setAMBEEngine(m_dspEngine->getAMBEEngine());
 
@@ -75,7 +78,7 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_apiAdapter = new WebAPIAdapterSrv(*this);
     m_requestMapper = new WebAPIRequestMapper(this);
     m_requestMapper->setAdapter(m_apiAdapter);
-    m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+    m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper, parser.getServerEventLoops());
     m_apiServer->start();
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
@@ -210,12 +213,19 @@ void MainCore::loadSettings()
     m_settings.load();
     m_settings.sortPresets();
     setLoggingOptions();
+    setRecordingOptions();
 }
 
 void MainCore::applySettings()
 {
     m_settings.sortPresets();
     setLoggingOptions();
+    setRecordingOptions();
+}
+
+void MainCore::setRecordingOptions()
+{
+    FileRecord::setRecordingPreferences(m_settings.getPreferences());
 }
 
 void MainCore::setLoggingOptions()
@@ -291,6 +301,7 @@ void MainCore::addSinkDevice()
 
     // create a file sink by default
     int fileSinkDeviceIndex = DeviceEnumerator::instance()->getFileSinkDeviceIndex();
+    DeviceEnumerator::instance()->changeTxSelection(deviceTabIndex, fileSinkDeviceIndex);
     const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(fileSinkDeviceIndex);
     m_deviceSets.back()->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
     m_deviceSets.back()->m_deviceAPI->setDeviceNbItems(samplingDevice->deviceNbItems);
@@ -336,6 +347,7 @@ void MainCore::addSourceDevice()
 
     // Create a file source instance by default
     int fileSourceDeviceIndex = DeviceEnumerator::instance()->getFileInputDeviceIndex();
+    DeviceEnumerator::instance()->changeRxSelection(deviceTabIndex, fileSourceDeviceIndex);
     const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(fileSourceDeviceIndex);
     m_deviceSets.back()->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
     m_deviceSets.back()->m_deviceAPI->setDeviceNbItems(samplingDevice->deviceNbItems);
@@ -372,6 +384,7 @@ void MainCore::removeLastDevice()
         m_deviceSets.back()->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
         DeviceAPI *sourceAPI = m_deviceSets.back()->m_deviceAPI;
+        DeviceEnumerator::instance()->removeRxSelection(m_deviceSets.size() - 1);
         delete m_deviceSets.back();
 
         lastDeviceEngine->stop();
@@ -392,6 +405,7 @@ void MainCore::removeLastDevice()
         m_deviceSets.back()->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
         DeviceAPI *sinkAPI = m_deviceSets.back()->m_deviceAPI;
+        DeviceEnumerator::instance()->removeTxSelection(m_deviceSets.size() - 1);
         delete m_deviceSets.back();
 
         lastDeviceEngine->stop();
@@ -418,6 +432,8 @@ void MainCore::changeSampleSource(int deviceSetIndex, int selectedDeviceIndex)
                 deviceSet->m_deviceAPI->getSampleSource());
         deviceSet->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
+        // claimed before it is opened so that the hardware is not probed meanwhile
+        DeviceEnumerator::instance()->changeRxSelection(deviceSetIndex, selectedDeviceIndex);
         const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(selectedDeviceIndex);
         deviceSet->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
         deviceSet->m_deviceAPI->setDeviceNbItems(samplingDevice->deviceNbItems);
@@ -486,6 +502,8 @@ void MainCore::changeSampleSink(int deviceSetIndex, int selectedDeviceIndex)
                 deviceSet->m_deviceAPI->getSampleSink());
         deviceSet->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
+        // claimed before it is opened so that the hardware is not probed meanwhile
+        DeviceEnumerator::instance()->changeTxSelection(deviceSetIndex, selectedDeviceIndex);
         const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(selectedDeviceIndex);
         deviceSet->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
         deviceSet->m_deviceAPI->setDeviceNbItems(samplingDevice->deviceNbItems);
@@ -574,6 +592,19 @@ void MainCore::loadPresetSettings(const Preset* preset, int tabIndex)
 	if (tabIndex >= 0)
 	{
         DeviceSet *deviceSet = m_deviceSets[tabIndex];
+        // channels are replaced with the engine stopped then the engine is restarted without waiting
+        std::vector<int> runningSubsystems;
+        int nbSubsystems = deviceSet->m_deviceMIMOEngine ? 2 : 1;
+
+        for (int subsystemIndex = 0; subsystemIndex < nbSubsystems; subsystemIndex++)
+        {
+            if (deviceSet->m_deviceAPI->state(subsystemIndex) == DeviceAPI::StRunning)
+            {
+                deviceSet->m_deviceAPI->stopDeviceEngine(subsystemIndex);
+                runningSubsystems.push_back(subsystemIndex);
+            }
+        }
+
         deviceSet->m_deviceAPI->loadSamplingDeviceSettings(preset);
 
         if (deviceSet->m_deviceSourceEngine) { // source device
@@ -583,6 +614,15 @@ void MainCore::loadPresetSettings(const Preset* preset, int tabIndex)
         } else if (deviceSet->m_deviceMIMOEngine) { // MIMO device
         	deviceSet->loadMIMOChannelSettings(preset, m_pluginManager->getPluginAPI());
         }
+
+        for (int subsystemIndex : runningSubsystems)
+        {
+            deviceSet->m_deviceAPI->startDeviceEngineAsync(subsystemIndex, [tabIndex, subsystemIndex](int state) {
+                if (state != DeviceAPI::StRunning) {
+                    qWarning("MainCore::loadPresetSettings: device set %d subsystem %d failed to restart", tabIndex, subsystemIndex);
+                }
+            });
+        }
 	}
 }
 
@@ -302,6 +302,7 @@ private:
 	void loadPresetSettings(const Preset* preset, int tabIndex);
 	void savePresetSettings(Preset* preset, int tabIndex);
     void setLoggingOptions();
+    void setRecordingOptions();
 
     bool handleMessage(const Message& cmd);
 
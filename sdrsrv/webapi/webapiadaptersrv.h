@@ -54,6 +54,7 @@ public:
 
     virtual int instanceDevices(
             int direction,
+            bool refresh,
             SWGSDRangel::SWGInstanceDevicesResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
@@ -177,6 +178,21 @@ public:
             SWGSDRangel::SWGDeviceSetList& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceReportsGet(
+            int deviceSetIndex,
+            bool withChannels,
+            SWGSDRangel::SWGInstanceReportsResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceReverseAPIGet(
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceReverseAPIPatch(
+            SWGSDRangel::SWGReverseAPIDispatcherSettings& query,
+            SWGSDRangel::SWGReverseAPIDispatcherReport& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceDeviceSetPost(
             int direction,
             SWGSDRangel::SWGSuccessResponse& response,
@@ -277,6 +293,7 @@ private:
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *swgDeviceSet, const DeviceSet* deviceSet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceSet* deviceSet);
+    int getDeviceReport(SWGSDRangel::SWGDeviceReport *deviceReport, DeviceSet *deviceSet, QString& errorMessage);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
@@ -32,6 +32,12 @@ SWGAMBEDevice::SWGAMBEDevice() {
     m_device_ref_isSet = false;
     _delete = 0;
     m__delete_isSet = false;
+    queue_depth = 0;
+    m_queue_depth_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    utilization = 0.0f;
+    m_utilization_isSet = false;
 }
 
 SWGAMBEDevice::~SWGAMBEDevice() {
@@ -44,6 +50,12 @@ SWGAMBEDevice::init() {
     m_device_ref_isSet = false;
     _delete = 0;
     m__delete_isSet = false;
+    queue_depth = 0;
+    m_queue_depth_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    utilization = 0.0f;
+    m_utilization_isSet = false;
 }
 
 void
@@ -69,6 +81,12 @@ SWGAMBEDevice::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&_delete, pJson["delete"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&queue_depth, pJson["queueDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_frames, pJson["nbFrames"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&utilization, pJson["utilization"], "float", "");
+    
 }
 
 QString
@@ -91,6 +109,15 @@ SWGAMBEDevice::asJsonObject() {
     if(m__delete_isSet){
         obj->insert("delete", QJsonValue(_delete));
     }
+    if(m_queue_depth_isSet){
+        obj->insert("queueDepth", QJsonValue(queue_depth));
+    }
+    if(m_nb_frames_isSet){
+        obj->insert("nbFrames", QJsonValue(nb_frames));
+    }
+    if(m_utilization_isSet){
+        obj->insert("utilization", QJsonValue(utilization));
+    }
 
     return obj;
 }
@@ -115,6 +142,36 @@ SWGAMBEDevice::setDelete(qint32 _delete) {
     this->m__delete_isSet = true;
 }
 
+qint32
+SWGAMBEDevice::getQueueDepth() {
+    return queue_depth;
+}
+void
+SWGAMBEDevice::setQueueDepth(qint32 queue_depth) {
+    this->queue_depth = queue_depth;
+    this->m_queue_depth_isSet = true;
+}
+
+qint32
+SWGAMBEDevice::getNbFrames() {
+    return nb_frames;
+}
+void
+SWGAMBEDevice::setNbFrames(qint32 nb_frames) {
+    this->nb_frames = nb_frames;
+    this->m_nb_frames_isSet = true;
+}
+
+float
+SWGAMBEDevice::getUtilization() {
+    return utilization;
+}
+void
+SWGAMBEDevice::setUtilization(float utilization) {
+    this->utilization = utilization;
+    this->m_utilization_isSet = true;
+}
+
 
 bool
 SWGAMBEDevice::isSet(){
@@ -126,6 +183,15 @@ SWGAMBEDevice::isSet(){
         if(m__delete_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_queue_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_frames_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_utilization_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -48,6 +48,15 @@ public:
     qint32 getDelete();
     void setDelete(qint32 _delete);
 
+    qint32 getQueueDepth();
+    void setQueueDepth(qint32 queue_depth);
+
+    qint32 getNbFrames();
+    void setNbFrames(qint32 nb_frames);
+
+    float getUtilization();
+    void setUtilization(float utilization);
+
 
     virtual bool isSet() override;
 
@@ -58,6 +67,15 @@ private:
     qint32 _delete;
     bool m__delete_isSet;
 
+    qint32 queue_depth;
+    bool m_queue_depth_isSet;
+
+    qint32 nb_frames;
+    bool m_nb_frames_isSet;
+
+    float utilization;
+    bool m_utilization_isSet;
+
 };
 
 }
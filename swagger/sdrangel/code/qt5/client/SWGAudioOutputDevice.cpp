@@ -52,6 +52,16 @@ SWGAudioOutputDevice::SWGAudioOutputDevice() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    udp_encoded_blocks = 0;
+    m_udp_encoded_blocks_isSet = false;
+    udp_dropped_blocks = 0;
+    m_udp_dropped_blocks_isSet = false;
+    udp_encode_time_avg = 0.0f;
+    m_udp_encode_time_avg_isSet = false;
+    udp_latency_avg = 0.0f;
+    m_udp_latency_avg_isSet = false;
+    udp_latency_max = 0.0f;
+    m_udp_latency_max_isSet = false;
 }
 
 SWGAudioOutputDevice::~SWGAudioOutputDevice() {
@@ -84,6 +94,16 @@ SWGAudioOutputDevice::init() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    udp_encoded_blocks = 0;
+    m_udp_encoded_blocks_isSet = false;
+    udp_dropped_blocks = 0;
+    m_udp_dropped_blocks_isSet = false;
+    udp_encode_time_avg = 0.0f;
+    m_udp_encode_time_avg_isSet = false;
+    udp_latency_avg = 0.0f;
+    m_udp_latency_avg_isSet = false;
+    udp_latency_max = 0.0f;
+    m_udp_latency_max_isSet = false;
 }
 
 void
@@ -141,6 +161,16 @@ SWGAudioOutputDevice::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_port, pJson["udpPort"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&udp_encoded_blocks, pJson["udpEncodedBlocks"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_dropped_blocks, pJson["udpDroppedBlocks"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_encode_time_avg, pJson["udpEncodeTimeAvg"], "float", "");
+    
+    ::SWGSDRangel::setValue(&udp_latency_avg, pJson["udpLatencyAvg"], "float", "");
+    
+    ::SWGSDRangel::setValue(&udp_latency_max, pJson["udpLatencyMax"], "float", "");
+    
 }
 
 QString
@@ -193,6 +223,21 @@ SWGAudioOutputDevice::asJsonObject() {
     if(m_udp_port_isSet){
         obj->insert("udpPort", QJsonValue(udp_port));
     }
+    if(m_udp_encoded_blocks_isSet){
+        obj->insert("udpEncodedBlocks", QJsonValue(udp_encoded_blocks));
+    }
+    if(m_udp_dropped_blocks_isSet){
+        obj->insert("udpDroppedBlocks", QJsonValue(udp_dropped_blocks));
+    }
+    if(m_udp_encode_time_avg_isSet){
+        obj->insert("udpEncodeTimeAvg", QJsonValue(udp_encode_time_avg));
+    }
+    if(m_udp_latency_avg_isSet){
+        obj->insert("udpLatencyAvg", QJsonValue(udp_latency_avg));
+    }
+    if(m_udp_latency_max_isSet){
+        obj->insert("udpLatencyMax", QJsonValue(udp_latency_max));
+    }
 
     return obj;
 }
@@ -317,6 +362,56 @@ SWGAudioOutputDevice::setUdpPort(qint32 udp_port) {
     this->m_udp_port_isSet = true;
 }
 
+qint32
+SWGAudioOutputDevice::getUdpEncodedBlocks() {
+    return udp_encoded_blocks;
+}
+void
+SWGAudioOutputDevice::setUdpEncodedBlocks(qint32 udp_encoded_blocks) {
+    this->udp_encoded_blocks = udp_encoded_blocks;
+    this->m_udp_encoded_blocks_isSet = true;
+}
+
+qint32
+SWGAudioOutputDevice::getUdpDroppedBlocks() {
+    return udp_dropped_blocks;
+}
+void
+SWGAudioOutputDevice::setUdpDroppedBlocks(qint32 udp_dropped_blocks) {
+    this->udp_dropped_blocks = udp_dropped_blocks;
+    this->m_udp_dropped_blocks_isSet = true;
+}
+
+float
+SWGAudioOutputDevice::getUdpEncodeTimeAvg() {
+    return udp_encode_time_avg;
+}
+void
+SWGAudioOutputDevice::setUdpEncodeTimeAvg(float udp_encode_time_avg) {
+    this->udp_encode_time_avg = udp_encode_time_avg;
+    this->m_udp_encode_time_avg_isSet = true;
+}
+
+float
+SWGAudioOutputDevice::getUdpLatencyAvg() {
+    return udp_latency_avg;
+}
+void
+SWGAudioOutputDevice::setUdpLatencyAvg(float udp_latency_avg) {
+    this->udp_latency_avg = udp_latency_avg;
+    this->m_udp_latency_avg_isSet = true;
+}
+
+float
+SWGAudioOutputDevice::getUdpLatencyMax() {
+    return udp_latency_max;
+}
+void
+SWGAudioOutputDevice::setUdpLatencyMax(float udp_latency_max) {
+    this->udp_latency_max = udp_latency_max;
+    this->m_udp_latency_max_isSet = true;
+}
+
 
 bool
 SWGAudioOutputDevice::isSet(){
@@ -358,6 +453,21 @@ SWGAudioOutputDevice::isSet(){
         if(m_udp_port_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_udp_encoded_blocks_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_udp_dropped_blocks_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_udp_encode_time_avg_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_udp_latency_avg_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_udp_latency_max_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
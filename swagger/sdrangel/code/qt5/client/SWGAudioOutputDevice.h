@@ -78,6 +78,21 @@ public:
     qint32 getUdpPort();
     void setUdpPort(qint32 udp_port);
 
+    qint32 getUdpEncodedBlocks();
+    void setUdpEncodedBlocks(qint32 udp_encoded_blocks);
+
+    qint32 getUdpDroppedBlocks();
+    void setUdpDroppedBlocks(qint32 udp_dropped_blocks);
+
+    float getUdpEncodeTimeAvg();
+    void setUdpEncodeTimeAvg(float udp_encode_time_avg);
+
+    float getUdpLatencyAvg();
+    void setUdpLatencyAvg(float udp_latency_avg);
+
+    float getUdpLatencyMax();
+    void setUdpLatencyMax(float udp_latency_max);
+
 
     virtual bool isSet() override;
 
@@ -118,6 +133,21 @@ private:
     qint32 udp_port;
     bool m_udp_port_isSet;
 
+    qint32 udp_encoded_blocks;
+    bool m_udp_encoded_blocks_isSet;
+
+    qint32 udp_dropped_blocks;
+    bool m_udp_dropped_blocks_isSet;
+
+    float udp_encode_time_avg;
+    bool m_udp_encode_time_avg_isSet;
+
+    float udp_latency_avg;
+    bool m_udp_latency_avg_isSet;
+
+    float udp_latency_max;
+    bool m_udp_latency_max_isSet;
+
 };
 
 }
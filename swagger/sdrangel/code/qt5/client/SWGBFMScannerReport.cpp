@@ -0,0 +1,183 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGBFMScannerReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGBFMScannerReport::SWGBFMScannerReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGBFMScannerReport::SWGBFMScannerReport() {
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    station_sample_rate = 0;
+    m_station_sample_rate_isSet = false;
+    noise_floor_db = 0.0f;
+    m_noise_floor_db_isSet = false;
+    stations = nullptr;
+    m_stations_isSet = false;
+}
+
+SWGBFMScannerReport::~SWGBFMScannerReport() {
+    this->cleanup();
+}
+
+void
+SWGBFMScannerReport::init() {
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    station_sample_rate = 0;
+    m_station_sample_rate_isSet = false;
+    noise_floor_db = 0.0f;
+    m_noise_floor_db_isSet = false;
+    stations = new QList<SWGBFMScannerStation*>();
+    m_stations_isSet = false;
+}
+
+void
+SWGBFMScannerReport::cleanup() {
+
+
+
+    if(stations != nullptr) { 
+        auto arr = stations;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete stations;
+    }
+}
+
+SWGBFMScannerReport*
+SWGBFMScannerReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGBFMScannerReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&channel_sample_rate, pJson["channelSampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&station_sample_rate, pJson["stationSampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&noise_floor_db, pJson["noiseFloorDB"], "float", "");
+    
+    
+    ::SWGSDRangel::setValue(&stations, pJson["stations"], "QList", "SWGBFMScannerStation");
+}
+
+QString
+SWGBFMScannerReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGBFMScannerReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_channel_sample_rate_isSet){
+        obj->insert("channelSampleRate", QJsonValue(channel_sample_rate));
+    }
+    if(m_station_sample_rate_isSet){
+        obj->insert("stationSampleRate", QJsonValue(station_sample_rate));
+    }
+    if(m_noise_floor_db_isSet){
+        obj->insert("noiseFloorDB", QJsonValue(noise_floor_db));
+    }
+    if(stations && stations->size() > 0){
+        toJsonArray((QList<void*>*)stations, obj, "stations", "SWGBFMScannerStation");
+    }
+
+    return obj;
+}
+
+qint32
+SWGBFMScannerReport::getChannelSampleRate() {
+    return channel_sample_rate;
+}
+void
+SWGBFMScannerReport::setChannelSampleRate(qint32 channel_sample_rate) {
+    this->channel_sample_rate = channel_sample_rate;
+    this->m_channel_sample_rate_isSet = true;
+}
+
+qint32
+SWGBFMScannerReport::getStationSampleRate() {
+    return station_sample_rate;
+}
+void
+SWGBFMScannerReport::setStationSampleRate(qint32 station_sample_rate) {
+    this->station_sample_rate = station_sample_rate;
+    this->m_station_sample_rate_isSet = true;
+}
+
+float
+SWGBFMScannerReport::getNoiseFloorDb() {
+    return noise_floor_db;
+}
+void
+SWGBFMScannerReport::setNoiseFloorDb(float noise_floor_db) {
+    this->noise_floor_db = noise_floor_db;
+    this->m_noise_floor_db_isSet = true;
+}
+
+QList<SWGBFMScannerStation*>*
+SWGBFMScannerReport::getStations() {
+    return stations;
+}
+void
+SWGBFMScannerReport::setStations(QList<SWGBFMScannerStation*>* stations) {
+    this->stations = stations;
+    this->m_stations_isSet = true;
+}
+
+
+bool
+SWGBFMScannerReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_channel_sample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_station_sample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_noise_floor_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(stations && (stations->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
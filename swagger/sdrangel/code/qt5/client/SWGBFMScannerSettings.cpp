@@ -0,0 +1,411 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGBFMScannerSettings.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGBFMScannerSettings::SWGBFMScannerSettings(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGBFMScannerSettings::SWGBFMScannerSettings() {
+    band_low = 0L;
+    m_band_low_isSet = false;
+    band_high = 0L;
+    m_band_high_isSet = false;
+    channel_spacing = 0;
+    m_channel_spacing_isSet = false;
+    rf_bandwidth = 0.0f;
+    m_rf_bandwidth_isSet = false;
+    threshold = 0.0f;
+    m_threshold_isSet = false;
+    max_stations = 0;
+    m_max_stations_isSet = false;
+    rgb_color = 0;
+    m_rgb_color_isSet = false;
+    title = nullptr;
+    m_title_isSet = false;
+    stream_index = 0;
+    m_stream_index_isSet = false;
+    use_reverse_api = 0;
+    m_use_reverse_api_isSet = false;
+    reverse_api_address = nullptr;
+    m_reverse_api_address_isSet = false;
+    reverse_api_port = 0;
+    m_reverse_api_port_isSet = false;
+    reverse_api_device_index = 0;
+    m_reverse_api_device_index_isSet = false;
+    reverse_api_channel_index = 0;
+    m_reverse_api_channel_index_isSet = false;
+}
+
+SWGBFMScannerSettings::~SWGBFMScannerSettings() {
+    this->cleanup();
+}
+
+void
+SWGBFMScannerSettings::init() {
+    band_low = 0L;
+    m_band_low_isSet = false;
+    band_high = 0L;
+    m_band_high_isSet = false;
+    channel_spacing = 0;
+    m_channel_spacing_isSet = false;
+    rf_bandwidth = 0.0f;
+    m_rf_bandwidth_isSet = false;
+    threshold = 0.0f;
+    m_threshold_isSet = false;
+    max_stations = 0;
+    m_max_stations_isSet = false;
+    rgb_color = 0;
+    m_rgb_color_isSet = false;
+    title = new QString("");
+    m_title_isSet = false;
+    stream_index = 0;
+    m_stream_index_isSet = false;
+    use_reverse_api = 0;
+    m_use_reverse_api_isSet = false;
+    reverse_api_address = new QString("");
+    m_reverse_api_address_isSet = false;
+    reverse_api_port = 0;
+    m_reverse_api_port_isSet = false;
+    reverse_api_device_index = 0;
+    m_reverse_api_device_index_isSet = false;
+    reverse_api_channel_index = 0;
+    m_reverse_api_channel_index_isSet = false;
+}
+
+void
+SWGBFMScannerSettings::cleanup() {
+
+
+
+
+
+
+
+    if(title != nullptr) { 
+        delete title;
+    }
+
+
+    if(reverse_api_address != nullptr) { 
+        delete reverse_api_address;
+    }
+
+
+
+}
+
+SWGBFMScannerSettings*
+SWGBFMScannerSettings::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGBFMScannerSettings::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&band_low, pJson["bandLow"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&band_high, pJson["bandHigh"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&channel_spacing, pJson["channelSpacing"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&rf_bandwidth, pJson["rfBandwidth"], "float", "");
+    
+    ::SWGSDRangel::setValue(&threshold, pJson["threshold"], "float", "");
+    
+    ::SWGSDRangel::setValue(&max_stations, pJson["maxStations"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&rgb_color, pJson["rgbColor"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&stream_index, pJson["streamIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&reverse_api_port, pJson["reverseAPIPort"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&reverse_api_device_index, pJson["reverseAPIDeviceIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&reverse_api_channel_index, pJson["reverseAPIChannelIndex"], "qint32", "");
+    
+}
+
+QString
+SWGBFMScannerSettings::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGBFMScannerSettings::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_band_low_isSet){
+        obj->insert("bandLow", QJsonValue(band_low));
+    }
+    if(m_band_high_isSet){
+        obj->insert("bandHigh", QJsonValue(band_high));
+    }
+    if(m_channel_spacing_isSet){
+        obj->insert("channelSpacing", QJsonValue(channel_spacing));
+    }
+    if(m_rf_bandwidth_isSet){
+        obj->insert("rfBandwidth", QJsonValue(rf_bandwidth));
+    }
+    if(m_threshold_isSet){
+        obj->insert("threshold", QJsonValue(threshold));
+    }
+    if(m_max_stations_isSet){
+        obj->insert("maxStations", QJsonValue(max_stations));
+    }
+    if(m_rgb_color_isSet){
+        obj->insert("rgbColor", QJsonValue(rgb_color));
+    }
+    if(title != nullptr && *title != QString("")){
+        toJsonValue(QString("title"), title, obj, QString("QString"));
+    }
+    if(m_stream_index_isSet){
+        obj->insert("streamIndex", QJsonValue(stream_index));
+    }
+    if(m_use_reverse_api_isSet){
+        obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
+    }
+    if(reverse_api_address != nullptr && *reverse_api_address != QString("")){
+        toJsonValue(QString("reverseAPIAddress"), reverse_api_address, obj, QString("QString"));
+    }
+    if(m_reverse_api_port_isSet){
+        obj->insert("reverseAPIPort", QJsonValue(reverse_api_port));
+    }
+    if(m_reverse_api_device_index_isSet){
+        obj->insert("reverseAPIDeviceIndex", QJsonValue(reverse_api_device_index));
+    }
+    if(m_reverse_api_channel_index_isSet){
+        obj->insert("reverseAPIChannelIndex", QJsonValue(reverse_api_channel_index));
+    }
+
+    return obj;
+}
+
+qint64
+SWGBFMScannerSettings::getBandLow() {
+    return band_low;
+}
+void
+SWGBFMScannerSettings::setBandLow(qint64 band_low) {
+    this->band_low = band_low;
+    this->m_band_low_isSet = true;
+}
+
+qint64
+SWGBFMScannerSettings::getBandHigh() {
+    return band_high;
+}
+void
+SWGBFMScannerSettings::setBandHigh(qint64 band_high) {
+    this->band_high = band_high;
+    this->m_band_high_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getChannelSpacing() {
+    return channel_spacing;
+}
+void
+SWGBFMScannerSettings::setChannelSpacing(qint32 channel_spacing) {
+    this->channel_spacing = channel_spacing;
+    this->m_channel_spacing_isSet = true;
+}
+
+float
+SWGBFMScannerSettings::getRfBandwidth() {
+    return rf_bandwidth;
+}
+void
+SWGBFMScannerSettings::setRfBandwidth(float rf_bandwidth) {
+    this->rf_bandwidth = rf_bandwidth;
+    this->m_rf_bandwidth_isSet = true;
+}
+
+float
+SWGBFMScannerSettings::getThreshold() {
+    return threshold;
+}
+void
+SWGBFMScannerSettings::setThreshold(float threshold) {
+    this->threshold = threshold;
+    this->m_threshold_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getMaxStations() {
+    return max_stations;
+}
+void
+SWGBFMScannerSettings::setMaxStations(qint32 max_stations) {
+    this->max_stations = max_stations;
+    this->m_max_stations_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getRgbColor() {
+    return rgb_color;
+}
+void
+SWGBFMScannerSettings::setRgbColor(qint32 rgb_color) {
+    this->rgb_color = rgb_color;
+    this->m_rgb_color_isSet = true;
+}
+
+QString*
+SWGBFMScannerSettings::getTitle() {
+    return title;
+}
+void
+SWGBFMScannerSettings::setTitle(QString* title) {
+    this->title = title;
+    this->m_title_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getStreamIndex() {
+    return stream_index;
+}
+void
+SWGBFMScannerSettings::setStreamIndex(qint32 stream_index) {
+    this->stream_index = stream_index;
+    this->m_stream_index_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getUseReverseApi() {
+    return use_reverse_api;
+}
+void
+SWGBFMScannerSettings::setUseReverseApi(qint32 use_reverse_api) {
+    this->use_reverse_api = use_reverse_api;
+    this->m_use_reverse_api_isSet = true;
+}
+
+QString*
+SWGBFMScannerSettings::getReverseApiAddress() {
+    return reverse_api_address;
+}
+void
+SWGBFMScannerSettings::setReverseApiAddress(QString* reverse_api_address) {
+    this->reverse_api_address = reverse_api_address;
+    this->m_reverse_api_address_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getReverseApiPort() {
+    return reverse_api_port;
+}
+void
+SWGBFMScannerSettings::setReverseApiPort(qint32 reverse_api_port) {
+    this->reverse_api_port = reverse_api_port;
+    this->m_reverse_api_port_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getReverseApiDeviceIndex() {
+    return reverse_api_device_index;
+}
+void
+SWGBFMScannerSettings::setReverseApiDeviceIndex(qint32 reverse_api_device_index) {
+    this->reverse_api_device_index = reverse_api_device_index;
+    this->m_reverse_api_device_index_isSet = true;
+}
+
+qint32
+SWGBFMScannerSettings::getReverseApiChannelIndex() {
+    return reverse_api_channel_index;
+}
+void
+SWGBFMScannerSettings::setReverseApiChannelIndex(qint32 reverse_api_channel_index) {
+    this->reverse_api_channel_index = reverse_api_channel_index;
+    this->m_reverse_api_channel_index_isSet = true;
+}
+
+
+bool
+SWGBFMScannerSettings::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_band_low_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_band_high_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_channel_spacing_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_rf_bandwidth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_threshold_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_max_stations_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_rgb_color_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(title && *title != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_stream_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_use_reverse_api_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(reverse_api_address && *reverse_api_address != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_reverse_api_port_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_reverse_api_device_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_reverse_api_channel_index_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,275 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGBFMScannerStation.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGBFMScannerStation::SWGBFMScannerStation(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGBFMScannerStation::SWGBFMScannerStation() {
+    frequency = 0L;
+    m_frequency_isSet = false;
+    active = 0;
+    m_active_isSet = false;
+    power_db = 0.0f;
+    m_power_db_isSet = false;
+    pilot_locked = 0;
+    m_pilot_locked_isSet = false;
+    rds_synced = 0;
+    m_rds_synced_isSet = false;
+    pid = nullptr;
+    m_pid_isSet = false;
+    prog_service_name = nullptr;
+    m_prog_service_name_isSet = false;
+    radio_text = nullptr;
+    m_radio_text_isSet = false;
+}
+
+SWGBFMScannerStation::~SWGBFMScannerStation() {
+    this->cleanup();
+}
+
+void
+SWGBFMScannerStation::init() {
+    frequency = 0L;
+    m_frequency_isSet = false;
+    active = 0;
+    m_active_isSet = false;
+    power_db = 0.0f;
+    m_power_db_isSet = false;
+    pilot_locked = 0;
+    m_pilot_locked_isSet = false;
+    rds_synced = 0;
+    m_rds_synced_isSet = false;
+    pid = new QString("");
+    m_pid_isSet = false;
+    prog_service_name = new QString("");
+    m_prog_service_name_isSet = false;
+    radio_text = new QString("");
+    m_radio_text_isSet = false;
+}
+
+void
+SWGBFMScannerStation::cleanup() {
+
+
+
+
+
+    if(pid != nullptr) { 
+        delete pid;
+    }
+    if(prog_service_name != nullptr) { 
+        delete prog_service_name;
+    }
+    if(radio_text != nullptr) { 
+        delete radio_text;
+    }
+}
+
+SWGBFMScannerStation*
+SWGBFMScannerStation::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGBFMScannerStation::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&frequency, pJson["frequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&active, pJson["active"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&power_db, pJson["powerDB"], "float", "");
+    
+    ::SWGSDRangel::setValue(&pilot_locked, pJson["pilotLocked"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&rds_synced, pJson["rdsSynced"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&pid, pJson["pid"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&prog_service_name, pJson["progServiceName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&radio_text, pJson["radioText"], "QString", "QString");
+    
+}
+
+QString
+SWGBFMScannerStation::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGBFMScannerStation::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_frequency_isSet){
+        obj->insert("frequency", QJsonValue(frequency));
+    }
+    if(m_active_isSet){
+        obj->insert("active", QJsonValue(active));
+    }
+    if(m_power_db_isSet){
+        obj->insert("powerDB", QJsonValue(power_db));
+    }
+    if(m_pilot_locked_isSet){
+        obj->insert("pilotLocked", QJsonValue(pilot_locked));
+    }
+    if(m_rds_synced_isSet){
+        obj->insert("rdsSynced", QJsonValue(rds_synced));
+    }
+    if(pid != nullptr && *pid != QString("")){
+        toJsonValue(QString("pid"), pid, obj, QString("QString"));
+    }
+    if(prog_service_name != nullptr && *prog_service_name != QString("")){
+        toJsonValue(QString("progServiceName"), prog_service_name, obj, QString("QString"));
+    }
+    if(radio_text != nullptr && *radio_text != QString("")){
+        toJsonValue(QString("radioText"), radio_text, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+qint64
+SWGBFMScannerStation::getFrequency() {
+    return frequency;
+}
+void
+SWGBFMScannerStation::setFrequency(qint64 frequency) {
+    this->frequency = frequency;
+    this->m_frequency_isSet = true;
+}
+
+qint32
+SWGBFMScannerStation::getActive() {
+    return active;
+}
+void
+SWGBFMScannerStation::setActive(qint32 active) {
+    this->active = active;
+    this->m_active_isSet = true;
+}
+
+float
+SWGBFMScannerStation::getPowerDb() {
+    return power_db;
+}
+void
+SWGBFMScannerStation::setPowerDb(float power_db) {
+    this->power_db = power_db;
+    this->m_power_db_isSet = true;
+}
+
+qint32
+SWGBFMScannerStation::getPilotLocked() {
+    return pilot_locked;
+}
+void
+SWGBFMScannerStation::setPilotLocked(qint32 pilot_locked) {
+    this->pilot_locked = pilot_locked;
+    this->m_pilot_locked_isSet = true;
+}
+
+qint32
+SWGBFMScannerStation::getRdsSynced() {
+    return rds_synced;
+}
+void
+SWGBFMScannerStation::setRdsSynced(qint32 rds_synced) {
+    this->rds_synced = rds_synced;
+    this->m_rds_synced_isSet = true;
+}
+
+QString*
+SWGBFMScannerStation::getPid() {
+    return pid;
+}
+void
+SWGBFMScannerStation::setPid(QString* pid) {
+    this->pid = pid;
+    this->m_pid_isSet = true;
+}
+
+QString*
+SWGBFMScannerStation::getProgServiceName() {
+    return prog_service_name;
+}
+void
+SWGBFMScannerStation::setProgServiceName(QString* prog_service_name) {
+    this->prog_service_name = prog_service_name;
+    this->m_prog_service_name_isSet = true;
+}
+
+QString*
+SWGBFMScannerStation::getRadioText() {
+    return radio_text;
+}
+void
+SWGBFMScannerStation::setRadioText(QString* radio_text) {
+    this->radio_text = radio_text;
+    this->m_radio_text_isSet = true;
+}
+
+
+bool
+SWGBFMScannerStation::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_frequency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_active_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_power_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_pilot_locked_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_rds_synced_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(pid && *pid != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(prog_service_name && *prog_service_name != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(radio_text && *radio_text != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
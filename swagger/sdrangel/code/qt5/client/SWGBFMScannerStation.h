@@ -0,0 +1,101 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGBFMScannerStation.h
+ *
+ * Station found by the BFM scanner
+ */
+
+#ifndef SWGBFMScannerStation_H_
+#define SWGBFMScannerStation_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGBFMScannerStation: public SWGObject {
+public:
+    SWGBFMScannerStation();
+    SWGBFMScannerStation(QString* json);
+    virtual ~SWGBFMScannerStation();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGBFMScannerStation* fromJson(QString &jsonString) override;
+
+    qint64 getFrequency();
+    void setFrequency(qint64 frequency);
+
+    qint32 getActive();
+    void setActive(qint32 active);
+
+    float getPowerDb();
+    void setPowerDb(float power_db);
+
+    qint32 getPilotLocked();
+    void setPilotLocked(qint32 pilot_locked);
+
+    qint32 getRdsSynced();
+    void setRdsSynced(qint32 rds_synced);
+
+    QString* getPid();
+    void setPid(QString* pid);
+
+    QString* getProgServiceName();
+    void setProgServiceName(QString* prog_service_name);
+
+    QString* getRadioText();
+    void setRadioText(QString* radio_text);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint64 frequency;
+    bool m_frequency_isSet;
+
+    qint32 active;
+    bool m_active_isSet;
+
+    float power_db;
+    bool m_power_db_isSet;
+
+    qint32 pilot_locked;
+    bool m_pilot_locked_isSet;
+
+    qint32 rds_synced;
+    bool m_rds_synced_isSet;
+
+    QString* pid;
+    bool m_pid_isSet;
+
+    QString* prog_service_name;
+    bool m_prog_service_name_isSet;
+
+    QString* radio_text;
+    bool m_radio_text_isSet;
+
+};
+
+}
+
+#endif /* SWGBFMScannerStation_H_ */
@@ -40,6 +40,8 @@ SWGChannelReport::SWGChannelReport() {
     m_atv_mod_report_isSet = false;
     bfm_demod_report = nullptr;
     m_bfm_demod_report_isSet = false;
+    bfm_scanner_report = nullptr;
+    m_bfm_scanner_report_isSet = false;
     dsd_demod_report = nullptr;
     m_dsd_demod_report_isSet = false;
     file_source_report = nullptr;
@@ -50,6 +52,8 @@ SWGChannelReport::SWGChannelReport() {
     m_free_dv_mod_report_isSet = false;
     freq_tracker_report = nullptr;
     m_freq_tracker_report_isSet = false;
+    lo_ra_demod_report = nullptr;
+    m_lo_ra_demod_report_isSet = false;
     nfm_demod_report = nullptr;
     m_nfm_demod_report_isSet = false;
     nfm_mod_report = nullptr;
@@ -88,6 +92,8 @@ SWGChannelReport::init() {
     m_atv_mod_report_isSet = false;
     bfm_demod_report = new SWGBFMDemodReport();
     m_bfm_demod_report_isSet = false;
+    bfm_scanner_report = new SWGBFMScannerReport();
+    m_bfm_scanner_report_isSet = false;
     dsd_demod_report = new SWGDSDDemodReport();
     m_dsd_demod_report_isSet = false;
     file_source_report = new SWGFileSourceReport();
@@ -98,6 +104,8 @@ SWGChannelReport::init() {
     m_free_dv_mod_report_isSet = false;
     freq_tracker_report = new SWGFreqTrackerReport();
     m_freq_tracker_report_isSet = false;
+    lo_ra_demod_report = new SWGLoRaDemodReport();
+    m_lo_ra_demod_report_isSet = false;
     nfm_demod_report = new SWGNFMDemodReport();
     m_nfm_demod_report_isSet = false;
     nfm_mod_report = new SWGNFMModReport();
@@ -136,6 +144,9 @@ SWGChannelReport::cleanup() {
     if(bfm_demod_report != nullptr) { 
         delete bfm_demod_report;
     }
+    if(bfm_scanner_report != nullptr) { 
+        delete bfm_scanner_report;
+    }
     if(dsd_demod_report != nullptr) { 
         delete dsd_demod_report;
     }
@@ -151,6 +162,9 @@ SWGChannelReport::cleanup() {
     if(freq_tracker_report != nullptr) { 
         delete freq_tracker_report;
     }
+    if(lo_ra_demod_report != nullptr) { 
+        delete lo_ra_demod_report;
+    }
     if(nfm_demod_report != nullptr) { 
         delete nfm_demod_report;
     }
@@ -203,6 +217,8 @@ SWGChannelReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&bfm_demod_report, pJson["BFMDemodReport"], "SWGBFMDemodReport", "SWGBFMDemodReport");
     
+    ::SWGSDRangel::setValue(&bfm_scanner_report, pJson["BFMScannerReport"], "SWGBFMScannerReport", "SWGBFMScannerReport");
+    
     ::SWGSDRangel::setValue(&dsd_demod_report, pJson["DSDDemodReport"], "SWGDSDDemodReport", "SWGDSDDemodReport");
     
     ::SWGSDRangel::setValue(&file_source_report, pJson["FileSourceReport"], "SWGFileSourceReport", "SWGFileSourceReport");
@@ -213,6 +229,8 @@ SWGChannelReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&freq_tracker_report, pJson["FreqTrackerReport"], "SWGFreqTrackerReport", "SWGFreqTrackerReport");
     
+    ::SWGSDRangel::setValue(&lo_ra_demod_report, pJson["LoRaDemodReport"], "SWGLoRaDemodReport", "SWGLoRaDemodReport");
+    
     ::SWGSDRangel::setValue(&nfm_demod_report, pJson["NFMDemodReport"], "SWGNFMDemodReport", "SWGNFMDemodReport");
     
     ::SWGSDRangel::setValue(&nfm_mod_report, pJson["NFMModReport"], "SWGNFMModReport", "SWGNFMModReport");
@@ -265,6 +283,9 @@ SWGChannelReport::asJsonObject() {
     if((bfm_demod_report != nullptr) && (bfm_demod_report->isSet())){
         toJsonValue(QString("BFMDemodReport"), bfm_demod_report, obj, QString("SWGBFMDemodReport"));
     }
+    if((bfm_scanner_report != nullptr) && (bfm_scanner_report->isSet())){
+        toJsonValue(QString("BFMScannerReport"), bfm_scanner_report, obj, QString("SWGBFMScannerReport"));
+    }
     if((dsd_demod_report != nullptr) && (dsd_demod_report->isSet())){
         toJsonValue(QString("DSDDemodReport"), dsd_demod_report, obj, QString("SWGDSDDemodReport"));
     }
@@ -280,6 +301,9 @@ SWGChannelReport::asJsonObject() {
     if((freq_tracker_report != nullptr) && (freq_tracker_report->isSet())){
         toJsonValue(QString("FreqTrackerReport"), freq_tracker_report, obj, QString("SWGFreqTrackerReport"));
     }
+    if((lo_ra_demod_report != nullptr) && (lo_ra_demod_report->isSet())){
+        toJsonValue(QString("LoRaDemodReport"), lo_ra_demod_report, obj, QString("SWGLoRaDemodReport"));
+    }
     if((nfm_demod_report != nullptr) && (nfm_demod_report->isSet())){
         toJsonValue(QString("NFMDemodReport"), nfm_demod_report, obj, QString("SWGNFMDemodReport"));
     }
@@ -371,6 +395,16 @@ SWGChannelReport::setBfmDemodReport(SWGBFMDemodReport* bfm_demod_report) {
     this->m_bfm_demod_report_isSet = true;
 }
 
+SWGBFMScannerReport*
+SWGChannelReport::getBfmScannerReport() {
+    return bfm_scanner_report;
+}
+void
+SWGChannelReport::setBfmScannerReport(SWGBFMScannerReport* bfm_scanner_report) {
+    this->bfm_scanner_report = bfm_scanner_report;
+    this->m_bfm_scanner_report_isSet = true;
+}
+
 SWGDSDDemodReport*
 SWGChannelReport::getDsdDemodReport() {
     return dsd_demod_report;
@@ -421,6 +455,16 @@ SWGChannelReport::setFreqTrackerReport(SWGFreqTrackerReport* freq_tracker_report
     this->m_freq_tracker_report_isSet = true;
 }
 
+SWGLoRaDemodReport*
+SWGChannelReport::getLoRaDemodReport() {
+    return lo_ra_demod_report;
+}
+void
+SWGChannelReport::setLoRaDemodReport(SWGLoRaDemodReport* lo_ra_demod_report) {
+    this->lo_ra_demod_report = lo_ra_demod_report;
+    this->m_lo_ra_demod_report_isSet = true;
+}
+
 SWGNFMDemodReport*
 SWGChannelReport::getNfmDemodReport() {
     return nfm_demod_report;
@@ -534,6 +578,9 @@ SWGChannelReport::isSet(){
         if(bfm_demod_report && bfm_demod_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(bfm_scanner_report && bfm_scanner_report->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(dsd_demod_report && dsd_demod_report->isSet()){
             isObjectUpdated = true; break;
         }
@@ -549,6 +596,9 @@ SWGChannelReport::isSet(){
         if(freq_tracker_report && freq_tracker_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(lo_ra_demod_report && lo_ra_demod_report->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(nfm_demod_report && nfm_demod_report->isSet()){
             isObjectUpdated = true; break;
         }
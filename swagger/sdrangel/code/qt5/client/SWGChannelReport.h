@@ -26,11 +26,13 @@
 #include "SWGAMModReport.h"
 #include "SWGATVModReport.h"
 #include "SWGBFMDemodReport.h"
+#include "SWGBFMScannerReport.h"
 #include "SWGDSDDemodReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFreeDVDemodReport.h"
 #include "SWGFreeDVModReport.h"
 #include "SWGFreqTrackerReport.h"
+#include "SWGLoRaDemodReport.h"
 #include "SWGNFMDemodReport.h"
 #include "SWGNFMModReport.h"
 #include "SWGRemoteSourceReport.h"
@@ -78,6 +80,9 @@ public:
     SWGBFMDemodReport* getBfmDemodReport();
     void setBfmDemodReport(SWGBFMDemodReport* bfm_demod_report);
 
+    SWGBFMScannerReport* getBfmScannerReport();
+    void setBfmScannerReport(SWGBFMScannerReport* bfm_scanner_report);
+
     SWGDSDDemodReport* getDsdDemodReport();
     void setDsdDemodReport(SWGDSDDemodReport* dsd_demod_report);
 
@@ -93,6 +98,9 @@ public:
     SWGFreqTrackerReport* getFreqTrackerReport();
     void setFreqTrackerReport(SWGFreqTrackerReport* freq_tracker_report);
 
+    SWGLoRaDemodReport* getLoRaDemodReport();
+    void setLoRaDemodReport(SWGLoRaDemodReport* lo_ra_demod_report);
+
     SWGNFMDemodReport* getNfmDemodReport();
     void setNfmDemodReport(SWGNFMDemodReport* nfm_demod_report);
 
@@ -142,6 +150,9 @@ private:
     SWGBFMDemodReport* bfm_demod_report;
     bool m_bfm_demod_report_isSet;
 
+    SWGBFMScannerReport* bfm_scanner_report;
+    bool m_bfm_scanner_report_isSet;
+
     SWGDSDDemodReport* dsd_demod_report;
     bool m_dsd_demod_report_isSet;
 
@@ -157,6 +168,9 @@ private:
     SWGFreqTrackerReport* freq_tracker_report;
     bool m_freq_tracker_report_isSet;
 
+    SWGLoRaDemodReport* lo_ra_demod_report;
+    bool m_lo_ra_demod_report_isSet;
+
     SWGNFMDemodReport* nfm_demod_report;
     bool m_nfm_demod_report_isSet;
 
@@ -46,6 +46,8 @@ SWGChannelSettings::SWGChannelSettings() {
     m_atv_mod_settings_isSet = false;
     bfm_demod_settings = nullptr;
     m_bfm_demod_settings_isSet = false;
+    bfm_scanner_settings = nullptr;
+    m_bfm_scanner_settings_isSet = false;
     channel_analyzer_settings = nullptr;
     m_channel_analyzer_settings_isSet = false;
     datv_demod_settings = nullptr;
@@ -110,6 +112,8 @@ SWGChannelSettings::init() {
     m_atv_mod_settings_isSet = false;
     bfm_demod_settings = new SWGBFMDemodSettings();
     m_bfm_demod_settings_isSet = false;
+    bfm_scanner_settings = new SWGBFMScannerSettings();
+    m_bfm_scanner_settings_isSet = false;
     channel_analyzer_settings = new SWGChannelAnalyzerSettings();
     m_channel_analyzer_settings_isSet = false;
     datv_demod_settings = new SWGDATVDemodSettings();
@@ -173,6 +177,9 @@ SWGChannelSettings::cleanup() {
     if(bfm_demod_settings != nullptr) { 
         delete bfm_demod_settings;
     }
+    if(bfm_scanner_settings != nullptr) { 
+        delete bfm_scanner_settings;
+    }
     if(channel_analyzer_settings != nullptr) { 
         delete channel_analyzer_settings;
     }
@@ -261,6 +268,8 @@ SWGChannelSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&bfm_demod_settings, pJson["BFMDemodSettings"], "SWGBFMDemodSettings", "SWGBFMDemodSettings");
     
+    ::SWGSDRangel::setValue(&bfm_scanner_settings, pJson["BFMScannerSettings"], "SWGBFMScannerSettings", "SWGBFMScannerSettings");
+    
     ::SWGSDRangel::setValue(&channel_analyzer_settings, pJson["ChannelAnalyzerSettings"], "SWGChannelAnalyzerSettings", "SWGChannelAnalyzerSettings");
     
     ::SWGSDRangel::setValue(&datv_demod_settings, pJson["DATVDemodSettings"], "SWGDATVDemodSettings", "SWGDATVDemodSettings");
@@ -342,6 +351,9 @@ SWGChannelSettings::asJsonObject() {
     if((bfm_demod_settings != nullptr) && (bfm_demod_settings->isSet())){
         toJsonValue(QString("BFMDemodSettings"), bfm_demod_settings, obj, QString("SWGBFMDemodSettings"));
     }
+    if((bfm_scanner_settings != nullptr) && (bfm_scanner_settings->isSet())){
+        toJsonValue(QString("BFMScannerSettings"), bfm_scanner_settings, obj, QString("SWGBFMScannerSettings"));
+    }
     if((channel_analyzer_settings != nullptr) && (channel_analyzer_settings->isSet())){
         toJsonValue(QString("ChannelAnalyzerSettings"), channel_analyzer_settings, obj, QString("SWGChannelAnalyzerSettings"));
     }
@@ -493,6 +505,16 @@ SWGChannelSettings::setBfmDemodSettings(SWGBFMDemodSettings* bfm_demod_settings)
     this->m_bfm_demod_settings_isSet = true;
 }
 
+SWGBFMScannerSettings*
+SWGChannelSettings::getBfmScannerSettings() {
+    return bfm_scanner_settings;
+}
+void
+SWGChannelSettings::setBfmScannerSettings(SWGBFMScannerSettings* bfm_scanner_settings) {
+    this->bfm_scanner_settings = bfm_scanner_settings;
+    this->m_bfm_scanner_settings_isSet = true;
+}
+
 SWGChannelAnalyzerSettings*
 SWGChannelSettings::getChannelAnalyzerSettings() {
     return channel_analyzer_settings;
@@ -715,6 +737,9 @@ SWGChannelSettings::isSet(){
         if(bfm_demod_settings && bfm_demod_settings->isSet()){
             isObjectUpdated = true; break;
         }
+        if(bfm_scanner_settings && bfm_scanner_settings->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(channel_analyzer_settings && channel_analyzer_settings->isSet()){
             isObjectUpdated = true; break;
         }
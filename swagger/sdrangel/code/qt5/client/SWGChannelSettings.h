@@ -27,6 +27,7 @@
 #include "SWGATVDemodSettings.h"
 #include "SWGATVModSettings.h"
 #include "SWGBFMDemodSettings.h"
+#include "SWGBFMScannerSettings.h"
 #include "SWGChannelAnalyzerSettings.h"
 #include "SWGDATVDemodSettings.h"
 #include "SWGDSDDemodSettings.h"
@@ -93,6 +94,9 @@ public:
     SWGBFMDemodSettings* getBfmDemodSettings();
     void setBfmDemodSettings(SWGBFMDemodSettings* bfm_demod_settings);
 
+    SWGBFMScannerSettings* getBfmScannerSettings();
+    void setBfmScannerSettings(SWGBFMScannerSettings* bfm_scanner_settings);
+
     SWGChannelAnalyzerSettings* getChannelAnalyzerSettings();
     void setChannelAnalyzerSettings(SWGChannelAnalyzerSettings* channel_analyzer_settings);
 
@@ -181,6 +185,9 @@ private:
     SWGBFMDemodSettings* bfm_demod_settings;
     bool m_bfm_demod_settings_isSet;
 
+    SWGBFMScannerSettings* bfm_scanner_settings;
+    bool m_bfm_scanner_settings_isSet;
+
     SWGChannelAnalyzerSettings* channel_analyzer_settings;
     bool m_channel_analyzer_settings_isSet;
 
@@ -66,6 +66,8 @@ SWGDSDDemodSettings::SWGDSDDemodSettings() {
     m_audio_device_name_isSet = false;
     high_pass_filter = 0;
     m_high_pass_filter_isSet = false;
+    vocoder_pool = 0;
+    m_vocoder_pool_isSet = false;
     trace_length_mutliplier = 0;
     m_trace_length_mutliplier_isSet = false;
     trace_stroke = 0;
@@ -130,6 +132,8 @@ SWGDSDDemodSettings::init() {
     m_audio_device_name_isSet = false;
     high_pass_filter = 0;
     m_high_pass_filter_isSet = false;
+    vocoder_pool = 0;
+    m_vocoder_pool_isSet = false;
     trace_length_mutliplier = 0;
     m_trace_length_mutliplier_isSet = false;
     trace_stroke = 0;
@@ -237,6 +241,8 @@ SWGDSDDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&high_pass_filter, pJson["highPassFilter"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&vocoder_pool, pJson["vocoderPool"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&trace_length_mutliplier, pJson["traceLengthMutliplier"], "qint32", "");
     
     ::SWGSDRangel::setValue(&trace_stroke, pJson["traceStroke"], "qint32", "");
@@ -328,6 +334,9 @@ SWGDSDDemodSettings::asJsonObject() {
     if(m_high_pass_filter_isSet){
         obj->insert("highPassFilter", QJsonValue(high_pass_filter));
     }
+    if(m_vocoder_pool_isSet){
+        obj->insert("vocoderPool", QJsonValue(vocoder_pool));
+    }
     if(m_trace_length_mutliplier_isSet){
         obj->insert("traceLengthMutliplier", QJsonValue(trace_length_mutliplier));
     }
@@ -549,6 +558,16 @@ SWGDSDDemodSettings::setHighPassFilter(qint32 high_pass_filter) {
     this->m_high_pass_filter_isSet = true;
 }
 
+qint32
+SWGDSDDemodSettings::getVocoderPool() {
+    return vocoder_pool;
+}
+void
+SWGDSDDemodSettings::setVocoderPool(qint32 vocoder_pool) {
+    this->vocoder_pool = vocoder_pool;
+    this->m_vocoder_pool_isSet = true;
+}
+
 qint32
 SWGDSDDemodSettings::getTraceLengthMutliplier() {
     return trace_length_mutliplier;
@@ -701,6 +720,9 @@ SWGDSDDemodSettings::isSet(){
         if(m_high_pass_filter_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_vocoder_pool_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_trace_length_mutliplier_isSet){
             isObjectUpdated = true; break;
         }
@@ -99,6 +99,9 @@ public:
     qint32 getHighPassFilter();
     void setHighPassFilter(qint32 high_pass_filter);
 
+    qint32 getVocoderPool();
+    void setVocoderPool(qint32 vocoder_pool);
+
     qint32 getTraceLengthMutliplier();
     void setTraceLengthMutliplier(qint32 trace_length_mutliplier);
 
@@ -187,6 +190,9 @@ private:
     qint32 high_pass_filter;
     bool m_high_pass_filter_isSet;
 
+    qint32 vocoder_pool;
+    bool m_vocoder_pool_isSet;
+
     qint32 trace_length_mutliplier;
     bool m_trace_length_mutliplier_isSet;
 
@@ -46,6 +46,8 @@ SWGDeviceListItem::SWGDeviceListItem() {
     m_device_set_index_isSet = false;
     index = 0;
     m_index_isSet = false;
+    removed = 0;
+    m_removed_isSet = false;
 }
 
 SWGDeviceListItem::~SWGDeviceListItem() {
@@ -72,6 +74,8 @@ SWGDeviceListItem::init() {
     m_device_set_index_isSet = false;
     index = 0;
     m_index_isSet = false;
+    removed = 0;
+    m_removed_isSet = false;
 }
 
 void
@@ -122,6 +126,8 @@ SWGDeviceListItem::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&removed, pJson["removed"], "qint32", "");
+    
 }
 
 QString
@@ -165,6 +171,9 @@ SWGDeviceListItem::asJsonObject() {
     if(m_index_isSet){
         obj->insert("index", QJsonValue(index));
     }
+    if(m_removed_isSet){
+        obj->insert("removed", QJsonValue(removed));
+    }
 
     return obj;
 }
@@ -259,6 +268,16 @@ SWGDeviceListItem::setIndex(qint32 index) {
     this->m_index_isSet = true;
 }
 
+qint32
+SWGDeviceListItem::getRemoved() {
+    return removed;
+}
+void
+SWGDeviceListItem::setRemoved(qint32 removed) {
+    this->removed = removed;
+    this->m_removed_isSet = true;
+}
+
 
 bool
 SWGDeviceListItem::isSet(){
@@ -291,6 +310,9 @@ SWGDeviceListItem::isSet(){
         if(m_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_removed_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -69,6 +69,9 @@ public:
     qint32 getIndex();
     void setIndex(qint32 index);
 
+    qint32 getRemoved();
+    void setRemoved(qint32 removed);
+
 
     virtual bool isSet() override;
 
@@ -100,6 +103,9 @@ private:
     qint32 index;
     bool m_index_isSet;
 
+    qint32 removed;
+    bool m_removed_isSet;
+
 };
 
 }
@@ -74,6 +74,8 @@ SWGDeviceReport::SWGDeviceReport() {
     m_xtrx_input_report_isSet = false;
     xtrx_output_report = nullptr;
     m_xtrx_output_report_isSet = false;
+    file_record_report = nullptr;
+    m_file_record_report_isSet = false;
 }
 
 SWGDeviceReport::~SWGDeviceReport() {
@@ -128,6 +130,8 @@ SWGDeviceReport::init() {
     m_xtrx_input_report_isSet = false;
     xtrx_output_report = new SWGXtrxOutputReport();
     m_xtrx_output_report_isSet = false;
+    file_record_report = new SWGFileRecordReport();
+    m_file_record_report_isSet = false;
 }
 
 void
@@ -199,6 +203,9 @@ SWGDeviceReport::cleanup() {
     if(xtrx_output_report != nullptr) { 
         delete xtrx_output_report;
     }
+    if(file_record_report != nullptr) { 
+        delete file_record_report;
+    }
 }
 
 SWGDeviceReport*
@@ -258,6 +265,8 @@ SWGDeviceReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&xtrx_output_report, pJson["xtrxOutputReport"], "SWGXtrxOutputReport", "SWGXtrxOutputReport");
     
+    ::SWGSDRangel::setValue(&file_record_report, pJson["fileRecordReport"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -343,6 +352,9 @@ SWGDeviceReport::asJsonObject() {
     if((xtrx_output_report != nullptr) && (xtrx_output_report->isSet())){
         toJsonValue(QString("xtrxOutputReport"), xtrx_output_report, obj, QString("SWGXtrxOutputReport"));
     }
+    if((file_record_report != nullptr) && (file_record_report->isSet())){
+        toJsonValue(QString("fileRecordReport"), file_record_report, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -577,6 +589,16 @@ SWGDeviceReport::setXtrxOutputReport(SWGXtrxOutputReport* xtrx_output_report) {
     this->m_xtrx_output_report_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGDeviceReport::getFileRecordReport() {
+    return file_record_report;
+}
+void
+SWGDeviceReport::setFileRecordReport(SWGFileRecordReport* file_record_report) {
+    this->file_record_report = file_record_report;
+    this->m_file_record_report_isSet = true;
+}
+
 
 bool
 SWGDeviceReport::isSet(){
@@ -651,6 +673,9 @@ SWGDeviceReport::isSet(){
         if(xtrx_output_report && xtrx_output_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(file_record_report && file_record_report->isSet()){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
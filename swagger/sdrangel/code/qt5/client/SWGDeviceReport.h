@@ -27,6 +27,7 @@
 #include "SWGBladeRF2InputReport.h"
 #include "SWGBladeRF2OutputReport.h"
 #include "SWGFileInputReport.h"
+#include "SWGFileRecordReport.h"
 #include "SWGKiwiSDRReport.h"
 #include "SWGLimeSdrInputReport.h"
 #include "SWGLimeSdrOutputReport.h"
@@ -131,6 +132,9 @@ public:
     SWGXtrxOutputReport* getXtrxOutputReport();
     void setXtrxOutputReport(SWGXtrxOutputReport* xtrx_output_report);
 
+    SWGFileRecordReport* getFileRecordReport();
+    void setFileRecordReport(SWGFileRecordReport* file_record_report);
+
 
     virtual bool isSet() override;
 
@@ -204,6 +208,9 @@ private:
     SWGXtrxOutputReport* xtrx_output_report;
     bool m_xtrx_output_report_isSet;
 
+    SWGFileRecordReport* file_record_report;
+    bool m_file_record_report_isSet;
+
 };
 
 }
@@ -0,0 +1,158 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetReport::SWGDeviceSetReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetReport::SWGDeviceSetReport() {
+    index = 0;
+    m_index_isSet = false;
+    device_report = nullptr;
+    m_device_report_isSet = false;
+    channels_detail = nullptr;
+    m_channels_detail_isSet = false;
+}
+
+SWGDeviceSetReport::~SWGDeviceSetReport() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetReport::init() {
+    index = 0;
+    m_index_isSet = false;
+    device_report = new SWGDeviceReport();
+    m_device_report_isSet = false;
+    channels_detail = new SWGChannelsDetail();
+    m_channels_detail_isSet = false;
+}
+
+void
+SWGDeviceSetReport::cleanup() {
+
+    if(device_report != nullptr) { 
+        delete device_report;
+    }
+    if(channels_detail != nullptr) { 
+        delete channels_detail;
+    }
+}
+
+SWGDeviceSetReport*
+SWGDeviceSetReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&device_report, pJson["deviceReport"], "SWGDeviceReport", "SWGDeviceReport");
+    
+    ::SWGSDRangel::setValue(&channels_detail, pJson["channelsDetail"], "SWGChannelsDetail", "SWGChannelsDetail");
+    
+}
+
+QString
+SWGDeviceSetReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if((device_report != nullptr) && (device_report->isSet())){
+        toJsonValue(QString("deviceReport"), device_report, obj, QString("SWGDeviceReport"));
+    }
+    if((channels_detail != nullptr) && (channels_detail->isSet())){
+        toJsonValue(QString("channelsDetail"), channels_detail, obj, QString("SWGChannelsDetail"));
+    }
+
+    return obj;
+}
+
+qint32
+SWGDeviceSetReport::getIndex() {
+    return index;
+}
+void
+SWGDeviceSetReport::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+SWGDeviceReport*
+SWGDeviceSetReport::getDeviceReport() {
+    return device_report;
+}
+void
+SWGDeviceSetReport::setDeviceReport(SWGDeviceReport* device_report) {
+    this->device_report = device_report;
+    this->m_device_report_isSet = true;
+}
+
+SWGChannelsDetail*
+SWGDeviceSetReport::getChannelsDetail() {
+    return channels_detail;
+}
+void
+SWGDeviceSetReport::setChannelsDetail(SWGChannelsDetail* channels_detail) {
+    this->channels_detail = channels_detail;
+    this->m_channels_detail_isSet = true;
+}
+
+
+bool
+SWGDeviceSetReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(device_report && device_report->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(channels_detail && channels_detail->isSet()){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -40,6 +40,8 @@ SWGFileInputReport::SWGFileInputReport() {
     m_elapsed_time_isSet = false;
     duration_time = nullptr;
     m_duration_time_isSet = false;
+    speed_up_factor = 0.0f;
+    m_speed_up_factor_isSet = false;
 }
 
 SWGFileInputReport::~SWGFileInputReport() {
@@ -60,6 +62,8 @@ SWGFileInputReport::init() {
     m_elapsed_time_isSet = false;
     duration_time = new QString("");
     m_duration_time_isSet = false;
+    speed_up_factor = 0.0f;
+    m_speed_up_factor_isSet = false;
 }
 
 void
@@ -78,6 +82,7 @@ SWGFileInputReport::cleanup() {
     if(duration_time != nullptr) { 
         delete duration_time;
     }
+
 }
 
 SWGFileInputReport*
@@ -103,6 +108,8 @@ SWGFileInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&duration_time, pJson["durationTime"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&speed_up_factor, pJson["speedUpFactor"], "float", "");
+    
 }
 
 QString
@@ -137,6 +144,9 @@ SWGFileInputReport::asJsonObject() {
     if(duration_time != nullptr && *duration_time != QString("")){
         toJsonValue(QString("durationTime"), duration_time, obj, QString("QString"));
     }
+    if(m_speed_up_factor_isSet){
+        obj->insert("speedUpFactor", QJsonValue(speed_up_factor));
+    }
 
     return obj;
 }
@@ -201,6 +211,16 @@ SWGFileInputReport::setDurationTime(QString* duration_time) {
     this->m_duration_time_isSet = true;
 }
 
+float
+SWGFileInputReport::getSpeedUpFactor() {
+    return speed_up_factor;
+}
+void
+SWGFileInputReport::setSpeedUpFactor(float speed_up_factor) {
+    this->speed_up_factor = speed_up_factor;
+    this->m_speed_up_factor_isSet = true;
+}
+
 
 bool
 SWGFileInputReport::isSet(){
@@ -224,6 +244,9 @@ SWGFileInputReport::isSet(){
         if(duration_time && *duration_time != QString("")){
             isObjectUpdated = true; break;
         }
+        if(m_speed_up_factor_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
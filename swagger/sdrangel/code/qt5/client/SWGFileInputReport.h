@@ -60,6 +60,9 @@ public:
     QString* getDurationTime();
     void setDurationTime(QString* duration_time);
 
+    float getSpeedUpFactor();
+    void setSpeedUpFactor(float speed_up_factor);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +85,9 @@ private:
     QString* duration_time;
     bool m_duration_time_isSet;
 
+    float speed_up_factor;
+    bool m_speed_up_factor_isSet;
+
 };
 
 }
@@ -32,6 +32,8 @@ SWGFileInputSettings::SWGFileInputSettings() {
     m_file_name_isSet = false;
     acceleration_factor = 0;
     m_acceleration_factor_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
     loop = 0;
     m_loop_isSet = false;
     use_reverse_api = 0;
@@ -42,6 +44,10 @@ SWGFileInputSettings::SWGFileInputSettings() {
     m_reverse_api_port_isSet = false;
     reverse_api_device_index = 0;
     m_reverse_api_device_index_isSet = false;
+    seek_timestamp = 0L;
+    m_seek_timestamp_isSet = false;
+    seek_event_peak_power = 0.0f;
+    m_seek_event_peak_power_isSet = false;
 }
 
 SWGFileInputSettings::~SWGFileInputSettings() {
@@ -54,6 +60,8 @@ SWGFileInputSettings::init() {
     m_file_name_isSet = false;
     acceleration_factor = 0;
     m_acceleration_factor_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
     loop = 0;
     m_loop_isSet = false;
     use_reverse_api = 0;
@@ -64,6 +72,10 @@ SWGFileInputSettings::init() {
     m_reverse_api_port_isSet = false;
     reverse_api_device_index = 0;
     m_reverse_api_device_index_isSet = false;
+    seek_timestamp = 0L;
+    m_seek_timestamp_isSet = false;
+    seek_event_peak_power = 0.0f;
+    m_seek_event_peak_power_isSet = false;
 }
 
 void
@@ -74,6 +86,7 @@ SWGFileInputSettings::cleanup() {
 
 
 
+
     if(reverse_api_address != nullptr) { 
         delete reverse_api_address;
     }
@@ -96,6 +109,8 @@ SWGFileInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&acceleration_factor, pJson["accelerationFactor"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&as_fast_as_possible, pJson["asFastAsPossible"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&loop, pJson["loop"], "qint32", "");
     
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
@@ -106,6 +121,10 @@ SWGFileInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&reverse_api_device_index, pJson["reverseAPIDeviceIndex"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&seek_timestamp, pJson["seekTimestamp"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&seek_event_peak_power, pJson["seekEventPeakPower"], "float", "");
+    
 }
 
 QString
@@ -128,6 +147,9 @@ SWGFileInputSettings::asJsonObject() {
     if(m_acceleration_factor_isSet){
         obj->insert("accelerationFactor", QJsonValue(acceleration_factor));
     }
+    if(m_as_fast_as_possible_isSet){
+        obj->insert("asFastAsPossible", QJsonValue(as_fast_as_possible));
+    }
     if(m_loop_isSet){
         obj->insert("loop", QJsonValue(loop));
     }
@@ -143,6 +165,12 @@ SWGFileInputSettings::asJsonObject() {
     if(m_reverse_api_device_index_isSet){
         obj->insert("reverseAPIDeviceIndex", QJsonValue(reverse_api_device_index));
     }
+    if(m_seek_timestamp_isSet){
+        obj->insert("seekTimestamp", QJsonValue(seek_timestamp));
+    }
+    if(m_seek_event_peak_power_isSet){
+        obj->insert("seekEventPeakPower", QJsonValue(seek_event_peak_power));
+    }
 
     return obj;
 }
@@ -167,6 +195,16 @@ SWGFileInputSettings::setAccelerationFactor(qint32 acceleration_factor) {
     this->m_acceleration_factor_isSet = true;
 }
 
+qint32
+SWGFileInputSettings::getAsFastAsPossible() {
+    return as_fast_as_possible;
+}
+void
+SWGFileInputSettings::setAsFastAsPossible(qint32 as_fast_as_possible) {
+    this->as_fast_as_possible = as_fast_as_possible;
+    this->m_as_fast_as_possible_isSet = true;
+}
+
 qint32
 SWGFileInputSettings::getLoop() {
     return loop;
@@ -217,6 +255,26 @@ SWGFileInputSettings::setReverseApiDeviceIndex(qint32 reverse_api_device_index)
     this->m_reverse_api_device_index_isSet = true;
 }
 
+qint64
+SWGFileInputSettings::getSeekTimestamp() {
+    return seek_timestamp;
+}
+void
+SWGFileInputSettings::setSeekTimestamp(qint64 seek_timestamp) {
+    this->seek_timestamp = seek_timestamp;
+    this->m_seek_timestamp_isSet = true;
+}
+
+float
+SWGFileInputSettings::getSeekEventPeakPower() {
+    return seek_event_peak_power;
+}
+void
+SWGFileInputSettings::setSeekEventPeakPower(float seek_event_peak_power) {
+    this->seek_event_peak_power = seek_event_peak_power;
+    this->m_seek_event_peak_power_isSet = true;
+}
+
 
 bool
 SWGFileInputSettings::isSet(){
@@ -228,6 +286,9 @@ SWGFileInputSettings::isSet(){
         if(m_acceleration_factor_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_as_fast_as_possible_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_loop_isSet){
             isObjectUpdated = true; break;
         }
@@ -243,6 +304,12 @@ SWGFileInputSettings::isSet(){
         if(m_reverse_api_device_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_seek_timestamp_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_seek_event_peak_power_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
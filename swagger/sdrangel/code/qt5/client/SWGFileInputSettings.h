@@ -48,6 +48,9 @@ public:
     qint32 getAccelerationFactor();
     void setAccelerationFactor(qint32 acceleration_factor);
 
+    qint32 getAsFastAsPossible();
+    void setAsFastAsPossible(qint32 as_fast_as_possible);
+
     qint32 getLoop();
     void setLoop(qint32 loop);
 
@@ -63,6 +66,12 @@ public:
     qint32 getReverseApiDeviceIndex();
     void setReverseApiDeviceIndex(qint32 reverse_api_device_index);
 
+    qint64 getSeekTimestamp();
+    void setSeekTimestamp(qint64 seek_timestamp);
+
+    float getSeekEventPeakPower();
+    void setSeekEventPeakPower(float seek_event_peak_power);
+
 
     virtual bool isSet() override;
 
@@ -73,6 +82,9 @@ private:
     qint32 acceleration_factor;
     bool m_acceleration_factor_isSet;
 
+    qint32 as_fast_as_possible;
+    bool m_as_fast_as_possible_isSet;
+
     qint32 loop;
     bool m_loop_isSet;
 
@@ -88,6 +100,12 @@ private:
     qint32 reverse_api_device_index;
     bool m_reverse_api_device_index_isSet;
 
+    qint64 seek_timestamp;
+    bool m_seek_timestamp_isSet;
+
+    float seek_event_peak_power;
+    bool m_seek_event_peak_power_isSet;
+
 };
 
 }
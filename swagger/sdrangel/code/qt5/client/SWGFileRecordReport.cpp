@@ -0,0 +1,248 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFileRecordReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileRecordReport::SWGFileRecordReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileRecordReport::SWGFileRecordReport() {
+    recording = 0;
+    m_recording_isSet = false;
+    file_name = nullptr;
+    m_file_name_isSet = false;
+    bytes_written = 0L;
+    m_bytes_written_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+    nb_files = 0;
+    m_nb_files_isSet = false;
+    write_bandwidth = 0.0f;
+    m_write_bandwidth_isSet = false;
+    buffer_headroom = 0.0f;
+    m_buffer_headroom_isSet = false;
+}
+
+SWGFileRecordReport::~SWGFileRecordReport() {
+    this->cleanup();
+}
+
+void
+SWGFileRecordReport::init() {
+    recording = 0;
+    m_recording_isSet = false;
+    file_name = new QString("");
+    m_file_name_isSet = false;
+    bytes_written = 0L;
+    m_bytes_written_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+    nb_files = 0;
+    m_nb_files_isSet = false;
+    write_bandwidth = 0.0f;
+    m_write_bandwidth_isSet = false;
+    buffer_headroom = 0.0f;
+    m_buffer_headroom_isSet = false;
+}
+
+void
+SWGFileRecordReport::cleanup() {
+
+    if(file_name != nullptr) { 
+        delete file_name;
+    }
+
+
+
+
+
+}
+
+SWGFileRecordReport*
+SWGFileRecordReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileRecordReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&bytes_written, pJson["bytesWritten"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped_bytes, pJson["droppedBytes"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_files, pJson["nbFiles"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&write_bandwidth, pJson["writeBandwidth"], "float", "");
+    
+    ::SWGSDRangel::setValue(&buffer_headroom, pJson["bufferHeadroom"], "float", "");
+    
+}
+
+QString
+SWGFileRecordReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileRecordReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(file_name != nullptr && *file_name != QString("")){
+        toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
+    }
+    if(m_bytes_written_isSet){
+        obj->insert("bytesWritten", QJsonValue(bytes_written));
+    }
+    if(m_dropped_bytes_isSet){
+        obj->insert("droppedBytes", QJsonValue(dropped_bytes));
+    }
+    if(m_nb_files_isSet){
+        obj->insert("nbFiles", QJsonValue(nb_files));
+    }
+    if(m_write_bandwidth_isSet){
+        obj->insert("writeBandwidth", QJsonValue(write_bandwidth));
+    }
+    if(m_buffer_headroom_isSet){
+        obj->insert("bufferHeadroom", QJsonValue(buffer_headroom));
+    }
+
+    return obj;
+}
+
+qint32
+SWGFileRecordReport::getRecording() {
+    return recording;
+}
+void
+SWGFileRecordReport::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+QString*
+SWGFileRecordReport::getFileName() {
+    return file_name;
+}
+void
+SWGFileRecordReport::setFileName(QString* file_name) {
+    this->file_name = file_name;
+    this->m_file_name_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getBytesWritten() {
+    return bytes_written;
+}
+void
+SWGFileRecordReport::setBytesWritten(qint64 bytes_written) {
+    this->bytes_written = bytes_written;
+    this->m_bytes_written_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getDroppedBytes() {
+    return dropped_bytes;
+}
+void
+SWGFileRecordReport::setDroppedBytes(qint64 dropped_bytes) {
+    this->dropped_bytes = dropped_bytes;
+    this->m_dropped_bytes_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getNbFiles() {
+    return nb_files;
+}
+void
+SWGFileRecordReport::setNbFiles(qint32 nb_files) {
+    this->nb_files = nb_files;
+    this->m_nb_files_isSet = true;
+}
+
+float
+SWGFileRecordReport::getWriteBandwidth() {
+    return write_bandwidth;
+}
+void
+SWGFileRecordReport::setWriteBandwidth(float write_bandwidth) {
+    this->write_bandwidth = write_bandwidth;
+    this->m_write_bandwidth_isSet = true;
+}
+
+float
+SWGFileRecordReport::getBufferHeadroom() {
+    return buffer_headroom;
+}
+void
+SWGFileRecordReport::setBufferHeadroom(float buffer_headroom) {
+    this->buffer_headroom = buffer_headroom;
+    this->m_buffer_headroom_isSet = true;
+}
+
+
+bool
+SWGFileRecordReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_recording_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(file_name && *file_name != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_bytes_written_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_dropped_bytes_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_files_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_write_bandwidth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_buffer_headroom_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,95 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGFileRecordReport.h
+ *
+ * FileRecord
+ */
+
+#ifndef SWGFileRecordReport_H_
+#define SWGFileRecordReport_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGFileRecordReport: public SWGObject {
+public:
+    SWGFileRecordReport();
+    SWGFileRecordReport(QString* json);
+    virtual ~SWGFileRecordReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGFileRecordReport* fromJson(QString &jsonString) override;
+
+    qint32 getRecording();
+    void setRecording(qint32 recording);
+
+    QString* getFileName();
+    void setFileName(QString* file_name);
+
+    qint64 getBytesWritten();
+    void setBytesWritten(qint64 bytes_written);
+
+    qint64 getDroppedBytes();
+    void setDroppedBytes(qint64 dropped_bytes);
+
+    qint32 getNbFiles();
+    void setNbFiles(qint32 nb_files);
+
+    float getWriteBandwidth();
+    void setWriteBandwidth(float write_bandwidth);
+
+    float getBufferHeadroom();
+    void setBufferHeadroom(float buffer_headroom);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 recording;
+    bool m_recording_isSet;
+
+    QString* file_name;
+    bool m_file_name_isSet;
+
+    qint64 bytes_written;
+    bool m_bytes_written_isSet;
+
+    qint64 dropped_bytes;
+    bool m_dropped_bytes_isSet;
+
+    qint32 nb_files;
+    bool m_nb_files_isSet;
+
+    float write_bandwidth;
+    bool m_write_bandwidth_isSet;
+
+    float buffer_headroom;
+    bool m_buffer_headroom_isSet;
+
+};
+
+}
+
+#endif /* SWGFileRecordReport_H_ */
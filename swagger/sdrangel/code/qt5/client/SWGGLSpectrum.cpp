@@ -70,6 +70,10 @@ SWGGLSpectrum::SWGGLSpectrum() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    display_rate = 0;
+    m_display_rate_isSet = false;
+    accumulation_mode = 0;
+    m_accumulation_mode_isSet = false;
 }
 
 SWGGLSpectrum::~SWGGLSpectrum() {
@@ -120,6 +124,10 @@ SWGGLSpectrum::init() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    display_rate = 0;
+    m_display_rate_isSet = false;
+    accumulation_mode = 0;
+    m_accumulation_mode_isSet = false;
 }
 
 void
@@ -200,6 +208,10 @@ SWGGLSpectrum::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&linear, pJson["linear"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&display_rate, pJson["displayRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&accumulation_mode, pJson["accumulationMode"], "qint32", "");
+    
 }
 
 QString
@@ -279,6 +291,12 @@ SWGGLSpectrum::asJsonObject() {
     if(m_linear_isSet){
         obj->insert("linear", QJsonValue(linear));
     }
+    if(m_display_rate_isSet){
+        obj->insert("displayRate", QJsonValue(display_rate));
+    }
+    if(m_accumulation_mode_isSet){
+        obj->insert("accumulationMode", QJsonValue(accumulation_mode));
+    }
 
     return obj;
 }
@@ -493,6 +511,26 @@ SWGGLSpectrum::setLinear(qint32 linear) {
     this->m_linear_isSet = true;
 }
 
+qint32
+SWGGLSpectrum::getDisplayRate() {
+    return display_rate;
+}
+void
+SWGGLSpectrum::setDisplayRate(qint32 display_rate) {
+    this->display_rate = display_rate;
+    this->m_display_rate_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getAccumulationMode() {
+    return accumulation_mode;
+}
+void
+SWGGLSpectrum::setAccumulationMode(qint32 accumulation_mode) {
+    this->accumulation_mode = accumulation_mode;
+    this->m_accumulation_mode_isSet = true;
+}
+
 
 bool
 SWGGLSpectrum::isSet(){
@@ -561,6 +599,12 @@ SWGGLSpectrum::isSet(){
         if(m_linear_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_display_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_accumulation_mode_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
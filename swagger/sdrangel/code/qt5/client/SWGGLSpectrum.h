@@ -104,6 +104,12 @@ public:
     qint32 getLinear();
     void setLinear(qint32 linear);
 
+    qint32 getDisplayRate();
+    void setDisplayRate(qint32 display_rate);
+
+    qint32 getAccumulationMode();
+    void setAccumulationMode(qint32 accumulation_mode);
+
 
     virtual bool isSet() override;
 
@@ -171,6 +177,12 @@ private:
     qint32 linear;
     bool m_linear_isSet;
 
+    qint32 display_rate;
+    bool m_display_rate_isSet;
+
+    qint32 accumulation_mode;
+    bool m_accumulation_mode_isSet;
+
 };
 
 }
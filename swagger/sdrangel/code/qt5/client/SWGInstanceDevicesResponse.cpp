@@ -30,6 +30,10 @@ SWGInstanceDevicesResponse::SWGInstanceDevicesResponse(QString* json) {
 SWGInstanceDevicesResponse::SWGInstanceDevicesResponse() {
     devicecount = 0;
     m_devicecount_isSet = false;
+    enumeration_index = 0;
+    m_enumeration_index_isSet = false;
+    timed_out_probes = 0;
+    m_timed_out_probes_isSet = false;
     devices = nullptr;
     m_devices_isSet = false;
 }
@@ -42,6 +46,10 @@ void
 SWGInstanceDevicesResponse::init() {
     devicecount = 0;
     m_devicecount_isSet = false;
+    enumeration_index = 0;
+    m_enumeration_index_isSet = false;
+    timed_out_probes = 0;
+    m_timed_out_probes_isSet = false;
     devices = new QList<SWGDeviceListItem*>();
     m_devices_isSet = false;
 }
@@ -71,6 +79,10 @@ void
 SWGInstanceDevicesResponse::fromJsonObject(QJsonObject &pJson) {
     ::SWGSDRangel::setValue(&devicecount, pJson["devicecount"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&enumeration_index, pJson["enumerationIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&timed_out_probes, pJson["timedOutProbes"], "qint32", "");
+    
     
     ::SWGSDRangel::setValue(&devices, pJson["devices"], "QList", "SWGDeviceListItem");
 }
@@ -92,6 +104,12 @@ SWGInstanceDevicesResponse::asJsonObject() {
     if(m_devicecount_isSet){
         obj->insert("devicecount", QJsonValue(devicecount));
     }
+    if(m_enumeration_index_isSet){
+        obj->insert("enumerationIndex", QJsonValue(enumeration_index));
+    }
+    if(m_timed_out_probes_isSet){
+        obj->insert("timedOutProbes", QJsonValue(timed_out_probes));
+    }
     if(devices && devices->size() > 0){
         toJsonArray((QList<void*>*)devices, obj, "devices", "SWGDeviceListItem");
     }
@@ -109,6 +127,26 @@ SWGInstanceDevicesResponse::setDevicecount(qint32 devicecount) {
     this->m_devicecount_isSet = true;
 }
 
+qint32
+SWGInstanceDevicesResponse::getEnumerationIndex() {
+    return enumeration_index;
+}
+void
+SWGInstanceDevicesResponse::setEnumerationIndex(qint32 enumeration_index) {
+    this->enumeration_index = enumeration_index;
+    this->m_enumeration_index_isSet = true;
+}
+
+qint32
+SWGInstanceDevicesResponse::getTimedOutProbes() {
+    return timed_out_probes;
+}
+void
+SWGInstanceDevicesResponse::setTimedOutProbes(qint32 timed_out_probes) {
+    this->timed_out_probes = timed_out_probes;
+    this->m_timed_out_probes_isSet = true;
+}
+
 QList<SWGDeviceListItem*>*
 SWGInstanceDevicesResponse::getDevices() {
     return devices;
@@ -127,6 +165,12 @@ SWGInstanceDevicesResponse::isSet(){
         if(m_devicecount_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_enumeration_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_timed_out_probes_isSet){
+            isObjectUpdated = true; break;
+        }
         if(devices && (devices->size() > 0)){
             isObjectUpdated = true; break;
         }
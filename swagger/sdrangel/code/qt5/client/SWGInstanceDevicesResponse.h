@@ -46,6 +46,12 @@ public:
     qint32 getDevicecount();
     void setDevicecount(qint32 devicecount);
 
+    qint32 getEnumerationIndex();
+    void setEnumerationIndex(qint32 enumeration_index);
+
+    qint32 getTimedOutProbes();
+    void setTimedOutProbes(qint32 timed_out_probes);
+
     QList<SWGDeviceListItem*>* getDevices();
     void setDevices(QList<SWGDeviceListItem*>* devices);
 
@@ -56,6 +62,12 @@ private:
     qint32 devicecount;
     bool m_devicecount_isSet;
 
+    qint32 enumeration_index;
+    bool m_enumeration_index_isSet;
+
+    qint32 timed_out_probes;
+    bool m_timed_out_probes_isSet;
+
     QList<SWGDeviceListItem*>* devices;
     bool m_devices_isSet;
 
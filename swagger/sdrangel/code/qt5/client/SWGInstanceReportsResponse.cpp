@@ -0,0 +1,162 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGInstanceReportsResponse.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGInstanceReportsResponse::SWGInstanceReportsResponse(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGInstanceReportsResponse::SWGInstanceReportsResponse() {
+    timestamp = nullptr;
+    m_timestamp_isSet = false;
+    devicesetcount = 0;
+    m_devicesetcount_isSet = false;
+    device_sets = nullptr;
+    m_device_sets_isSet = false;
+}
+
+SWGInstanceReportsResponse::~SWGInstanceReportsResponse() {
+    this->cleanup();
+}
+
+void
+SWGInstanceReportsResponse::init() {
+    timestamp = new QString("");
+    m_timestamp_isSet = false;
+    devicesetcount = 0;
+    m_devicesetcount_isSet = false;
+    device_sets = new QList<SWGDeviceSetReport*>();
+    m_device_sets_isSet = false;
+}
+
+void
+SWGInstanceReportsResponse::cleanup() {
+    if(timestamp != nullptr) { 
+        delete timestamp;
+    }
+
+    if(device_sets != nullptr) { 
+        auto arr = device_sets;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete device_sets;
+    }
+}
+
+SWGInstanceReportsResponse*
+SWGInstanceReportsResponse::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGInstanceReportsResponse::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&timestamp, pJson["timestamp"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&devicesetcount, pJson["devicesetcount"], "qint32", "");
+    
+    
+    ::SWGSDRangel::setValue(&device_sets, pJson["deviceSets"], "QList", "SWGDeviceSetReport");
+}
+
+QString
+SWGInstanceReportsResponse::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGInstanceReportsResponse::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(timestamp != nullptr && *timestamp != QString("")){
+        toJsonValue(QString("timestamp"), timestamp, obj, QString("QString"));
+    }
+    if(m_devicesetcount_isSet){
+        obj->insert("devicesetcount", QJsonValue(devicesetcount));
+    }
+    if(device_sets && device_sets->size() > 0){
+        toJsonArray((QList<void*>*)device_sets, obj, "deviceSets", "SWGDeviceSetReport");
+    }
+
+    return obj;
+}
+
+QString*
+SWGInstanceReportsResponse::getTimestamp() {
+    return timestamp;
+}
+void
+SWGInstanceReportsResponse::setTimestamp(QString* timestamp) {
+    this->timestamp = timestamp;
+    this->m_timestamp_isSet = true;
+}
+
+qint32
+SWGInstanceReportsResponse::getDevicesetcount() {
+    return devicesetcount;
+}
+void
+SWGInstanceReportsResponse::setDevicesetcount(qint32 devicesetcount) {
+    this->devicesetcount = devicesetcount;
+    this->m_devicesetcount_isSet = true;
+}
+
+QList<SWGDeviceSetReport*>*
+SWGInstanceReportsResponse::getDeviceSets() {
+    return device_sets;
+}
+void
+SWGInstanceReportsResponse::setDeviceSets(QList<SWGDeviceSetReport*>* device_sets) {
+    this->device_sets = device_sets;
+    this->m_device_sets_isSet = true;
+}
+
+
+bool
+SWGInstanceReportsResponse::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(timestamp && *timestamp != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_devicesetcount_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(device_sets && (device_sets->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
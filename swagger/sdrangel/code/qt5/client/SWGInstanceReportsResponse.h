@@ -0,0 +1,73 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGInstanceReportsResponse.h
+ *
+ * Reports of device sets opened in this instance collected in one pass
+ */
+
+#ifndef SWGInstanceReportsResponse_H_
+#define SWGInstanceReportsResponse_H_
+
+#include <QJsonObject>
+
+
+#include "SWGDeviceSetReport.h"
+#include <QString>
+#include <QList>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGInstanceReportsResponse: public SWGObject {
+public:
+    SWGInstanceReportsResponse();
+    SWGInstanceReportsResponse(QString* json);
+    virtual ~SWGInstanceReportsResponse();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGInstanceReportsResponse* fromJson(QString &jsonString) override;
+
+    QString* getTimestamp();
+    void setTimestamp(QString* timestamp);
+
+    qint32 getDevicesetcount();
+    void setDevicesetcount(qint32 devicesetcount);
+
+    QList<SWGDeviceSetReport*>* getDeviceSets();
+    void setDeviceSets(QList<SWGDeviceSetReport*>* device_sets);
+
+
+    virtual bool isSet() override;
+
+private:
+    QString* timestamp;
+    bool m_timestamp_isSet;
+
+    qint32 devicesetcount;
+    bool m_devicesetcount_isSet;
+
+    QList<SWGDeviceSetReport*>* device_sets;
+    bool m_device_sets_isSet;
+
+};
+
+}
+
+#endif /* SWGInstanceReportsResponse_H_ */
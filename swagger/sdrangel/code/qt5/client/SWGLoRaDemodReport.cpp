@@ -0,0 +1,225 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGLoRaDemodReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGLoRaDemodReport::SWGLoRaDemodReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGLoRaDemodReport::SWGLoRaDemodReport() {
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    spread_factor = 0;
+    m_spread_factor_isSet = false;
+    snr_db = 0.0f;
+    m_snr_db_isSet = false;
+    nb_symbols = 0;
+    m_nb_symbols_isSet = false;
+    symbols = nullptr;
+    m_symbols_isSet = false;
+}
+
+SWGLoRaDemodReport::~SWGLoRaDemodReport() {
+    this->cleanup();
+}
+
+void
+SWGLoRaDemodReport::init() {
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    spread_factor = 0;
+    m_spread_factor_isSet = false;
+    snr_db = 0.0f;
+    m_snr_db_isSet = false;
+    nb_symbols = 0;
+    m_nb_symbols_isSet = false;
+    symbols = new QString("");
+    m_symbols_isSet = false;
+}
+
+void
+SWGLoRaDemodReport::cleanup() {
+
+
+
+
+
+    if(symbols != nullptr) { 
+        delete symbols;
+    }
+}
+
+SWGLoRaDemodReport*
+SWGLoRaDemodReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGLoRaDemodReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&channel_sample_rate, pJson["channelSampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_frames, pJson["nbFrames"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&spread_factor, pJson["spreadFactor"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&snr_db, pJson["snrDB"], "float", "");
+    
+    ::SWGSDRangel::setValue(&nb_symbols, pJson["nbSymbols"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&symbols, pJson["symbols"], "QString", "QString");
+    
+}
+
+QString
+SWGLoRaDemodReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGLoRaDemodReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_channel_sample_rate_isSet){
+        obj->insert("channelSampleRate", QJsonValue(channel_sample_rate));
+    }
+    if(m_nb_frames_isSet){
+        obj->insert("nbFrames", QJsonValue(nb_frames));
+    }
+    if(m_spread_factor_isSet){
+        obj->insert("spreadFactor", QJsonValue(spread_factor));
+    }
+    if(m_snr_db_isSet){
+        obj->insert("snrDB", QJsonValue(snr_db));
+    }
+    if(m_nb_symbols_isSet){
+        obj->insert("nbSymbols", QJsonValue(nb_symbols));
+    }
+    if(symbols != nullptr && *symbols != QString("")){
+        toJsonValue(QString("symbols"), symbols, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+qint32
+SWGLoRaDemodReport::getChannelSampleRate() {
+    return channel_sample_rate;
+}
+void
+SWGLoRaDemodReport::setChannelSampleRate(qint32 channel_sample_rate) {
+    this->channel_sample_rate = channel_sample_rate;
+    this->m_channel_sample_rate_isSet = true;
+}
+
+qint32
+SWGLoRaDemodReport::getNbFrames() {
+    return nb_frames;
+}
+void
+SWGLoRaDemodReport::setNbFrames(qint32 nb_frames) {
+    this->nb_frames = nb_frames;
+    this->m_nb_frames_isSet = true;
+}
+
+qint32
+SWGLoRaDemodReport::getSpreadFactor() {
+    return spread_factor;
+}
+void
+SWGLoRaDemodReport::setSpreadFactor(qint32 spread_factor) {
+    this->spread_factor = spread_factor;
+    this->m_spread_factor_isSet = true;
+}
+
+float
+SWGLoRaDemodReport::getSnrDb() {
+    return snr_db;
+}
+void
+SWGLoRaDemodReport::setSnrDb(float snr_db) {
+    this->snr_db = snr_db;
+    this->m_snr_db_isSet = true;
+}
+
+qint32
+SWGLoRaDemodReport::getNbSymbols() {
+    return nb_symbols;
+}
+void
+SWGLoRaDemodReport::setNbSymbols(qint32 nb_symbols) {
+    this->nb_symbols = nb_symbols;
+    this->m_nb_symbols_isSet = true;
+}
+
+QString*
+SWGLoRaDemodReport::getSymbols() {
+    return symbols;
+}
+void
+SWGLoRaDemodReport::setSymbols(QString* symbols) {
+    this->symbols = symbols;
+    this->m_symbols_isSet = true;
+}
+
+
+bool
+SWGLoRaDemodReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_channel_sample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_frames_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_spread_factor_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_snr_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_symbols_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(symbols && *symbols != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -34,6 +34,9 @@
 #include "SWGAudioOutputDevice.h"
 #include "SWGBFMDemodReport.h"
 #include "SWGBFMDemodSettings.h"
+#include "SWGBFMScannerReport.h"
+#include "SWGBFMScannerSettings.h"
+#include "SWGBFMScannerStation.h"
 #include "SWGBandwidth.h"
 #include "SWGBladeRF1InputSettings.h"
 #include "SWGBladeRF1OutputSettings.h"
@@ -62,6 +65,7 @@
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
 #include "SWGDeviceSetList.h"
+#include "SWGDeviceSetReport.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGErrorResponse.h"
@@ -69,6 +73,7 @@
 #include "SWGFCDProSettings.h"
 #include "SWGFileInputReport.h"
 #include "SWGFileInputSettings.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFileSourceSettings.h"
 #include "SWGFreeDVDemodReport.h"
@@ -88,6 +93,7 @@
 #include "SWGInstanceChannelsResponse.h"
 #include "SWGInstanceConfigResponse.h"
 #include "SWGInstanceDevicesResponse.h"
+#include "SWGInstanceReportsResponse.h"
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGKiwiSDRReport.h"
 #include "SWGKiwiSDRSettings.h"
@@ -95,6 +101,7 @@
 #include "SWGLimeSdrInputSettings.h"
 #include "SWGLimeSdrOutputReport.h"
 #include "SWGLimeSdrOutputSettings.h"
+#include "SWGLoRaDemodReport.h"
 #include "SWGLocalInputReport.h"
 #include "SWGLocalInputSettings.h"
 #include "SWGLocalOutputReport.h"
@@ -134,6 +141,8 @@
 #include "SWGRemoteSinkSettings.h"
 #include "SWGRemoteSourceReport.h"
 #include "SWGRemoteSourceSettings.h"
+#include "SWGReverseAPIDispatcherReport.h"
+#include "SWGReverseAPIDispatcherSettings.h"
 #include "SWGRtlSdrReport.h"
 #include "SWGRtlSdrSettings.h"
 #include "SWGSDRPlayReport.h"
@@ -231,6 +240,15 @@ namespace SWGSDRangel {
     if(QString("SWGBFMDemodSettings").compare(type) == 0) {
       return new SWGBFMDemodSettings();
     }
+    if(QString("SWGBFMScannerReport").compare(type) == 0) {
+      return new SWGBFMScannerReport();
+    }
+    if(QString("SWGBFMScannerSettings").compare(type) == 0) {
+      return new SWGBFMScannerSettings();
+    }
+    if(QString("SWGBFMScannerStation").compare(type) == 0) {
+      return new SWGBFMScannerStation();
+    }
     if(QString("SWGBandwidth").compare(type) == 0) {
       return new SWGBandwidth();
     }
@@ -315,6 +333,9 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceSetList").compare(type) == 0) {
       return new SWGDeviceSetList();
     }
+    if(QString("SWGDeviceSetReport").compare(type) == 0) {
+      return new SWGDeviceSetReport();
+    }
     if(QString("SWGDeviceSettings").compare(type) == 0) {
       return new SWGDeviceSettings();
     }
@@ -336,6 +357,9 @@ namespace SWGSDRangel {
     if(QString("SWGFileInputSettings").compare(type) == 0) {
       return new SWGFileInputSettings();
     }
+    if(QString("SWGFileRecordReport").compare(type) == 0) {
+      return new SWGFileRecordReport();
+    }
     if(QString("SWGFileSourceReport").compare(type) == 0) {
       return new SWGFileSourceReport();
     }
@@ -393,6 +417,9 @@ namespace SWGSDRangel {
     if(QString("SWGInstanceDevicesResponse").compare(type) == 0) {
       return new SWGInstanceDevicesResponse();
     }
+    if(QString("SWGInstanceReportsResponse").compare(type) == 0) {
+      return new SWGInstanceReportsResponse();
+    }
     if(QString("SWGInstanceSummaryResponse").compare(type) == 0) {
       return new SWGInstanceSummaryResponse();
     }
@@ -414,6 +441,9 @@ namespace SWGSDRangel {
     if(QString("SWGLimeSdrOutputSettings").compare(type) == 0) {
       return new SWGLimeSdrOutputSettings();
     }
+    if(QString("SWGLoRaDemodReport").compare(type) == 0) {
+      return new SWGLoRaDemodReport();
+    }
     if(QString("SWGLocalInputReport").compare(type) == 0) {
       return new SWGLocalInputReport();
     }
@@ -531,6 +561,12 @@ namespace SWGSDRangel {
     if(QString("SWGRemoteSourceSettings").compare(type) == 0) {
       return new SWGRemoteSourceSettings();
     }
+    if(QString("SWGReverseAPIDispatcherReport").compare(type) == 0) {
+      return new SWGReverseAPIDispatcherReport();
+    }
+    if(QString("SWGReverseAPIDispatcherSettings").compare(type) == 0) {
+      return new SWGReverseAPIDispatcherSettings();
+    }
     if(QString("SWGRtlSdrReport").compare(type) == 0) {
       return new SWGRtlSdrReport();
     }
@@ -48,6 +48,24 @@ SWGPreferences::SWGPreferences() {
     m_log_file_name_isSet = false;
     file_min_log_level = 0;
     m_file_min_log_level_isSet = false;
+    record_nb_buffers = 0;
+    m_record_nb_buffers_isSet = false;
+    record_buffer_size = 0;
+    m_record_buffer_size_isSet = false;
+    record_direct_io = 0;
+    m_record_direct_io_isSet = false;
+    record_preallocation = 0;
+    m_record_preallocation_isSet = false;
+    record_max_file_size = 0;
+    m_record_max_file_size_isSet = false;
+    record_max_file_seconds = 0;
+    m_record_max_file_seconds_isSet = false;
+    record_sig_mf = 0;
+    m_record_sig_mf_isSet = false;
+    record_sig_mf_packing_bits = 0;
+    m_record_sig_mf_packing_bits_isSet = false;
+    record_sig_mf_compressed = 0;
+    m_record_sig_mf_compressed_isSet = false;
 }
 
 SWGPreferences::~SWGPreferences() {
@@ -76,6 +94,24 @@ SWGPreferences::init() {
     m_log_file_name_isSet = false;
     file_min_log_level = 0;
     m_file_min_log_level_isSet = false;
+    record_nb_buffers = 0;
+    m_record_nb_buffers_isSet = false;
+    record_buffer_size = 0;
+    m_record_buffer_size_isSet = false;
+    record_direct_io = 0;
+    m_record_direct_io_isSet = false;
+    record_preallocation = 0;
+    m_record_preallocation_isSet = false;
+    record_max_file_size = 0;
+    m_record_max_file_size_isSet = false;
+    record_max_file_seconds = 0;
+    m_record_max_file_seconds_isSet = false;
+    record_sig_mf = 0;
+    m_record_sig_mf_isSet = false;
+    record_sig_mf_packing_bits = 0;
+    m_record_sig_mf_packing_bits_isSet = false;
+    record_sig_mf_compressed = 0;
+    m_record_sig_mf_compressed_isSet = false;
 }
 
 void
@@ -131,6 +167,24 @@ SWGPreferences::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&file_min_log_level, pJson["fileMinLogLevel"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&record_nb_buffers, pJson["recordNbBuffers"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_buffer_size, pJson["recordBufferSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_direct_io, pJson["recordDirectIO"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_preallocation, pJson["recordPreallocation"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_max_file_size, pJson["recordMaxFileSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_max_file_seconds, pJson["recordMaxFileSeconds"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_sig_mf, pJson["recordSigMF"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_sig_mf_packing_bits, pJson["recordSigMFPackingBits"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&record_sig_mf_compressed, pJson["recordSigMFCompressed"], "qint32", "");
+    
 }
 
 QString
@@ -177,6 +231,33 @@ SWGPreferences::asJsonObject() {
     if(m_file_min_log_level_isSet){
         obj->insert("fileMinLogLevel", QJsonValue(file_min_log_level));
     }
+    if(m_record_nb_buffers_isSet){
+        obj->insert("recordNbBuffers", QJsonValue(record_nb_buffers));
+    }
+    if(m_record_buffer_size_isSet){
+        obj->insert("recordBufferSize", QJsonValue(record_buffer_size));
+    }
+    if(m_record_direct_io_isSet){
+        obj->insert("recordDirectIO", QJsonValue(record_direct_io));
+    }
+    if(m_record_preallocation_isSet){
+        obj->insert("recordPreallocation", QJsonValue(record_preallocation));
+    }
+    if(m_record_max_file_size_isSet){
+        obj->insert("recordMaxFileSize", QJsonValue(record_max_file_size));
+    }
+    if(m_record_max_file_seconds_isSet){
+        obj->insert("recordMaxFileSeconds", QJsonValue(record_max_file_seconds));
+    }
+    if(m_record_sig_mf_isSet){
+        obj->insert("recordSigMF", QJsonValue(record_sig_mf));
+    }
+    if(m_record_sig_mf_packing_bits_isSet){
+        obj->insert("recordSigMFPackingBits", QJsonValue(record_sig_mf_packing_bits));
+    }
+    if(m_record_sig_mf_compressed_isSet){
+        obj->insert("recordSigMFCompressed", QJsonValue(record_sig_mf_compressed));
+    }
 
     return obj;
 }
@@ -281,6 +362,96 @@ SWGPreferences::setFileMinLogLevel(qint32 file_min_log_level) {
     this->m_file_min_log_level_isSet = true;
 }
 
+qint32
+SWGPreferences::getRecordNbBuffers() {
+    return record_nb_buffers;
+}
+void
+SWGPreferences::setRecordNbBuffers(qint32 record_nb_buffers) {
+    this->record_nb_buffers = record_nb_buffers;
+    this->m_record_nb_buffers_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordBufferSize() {
+    return record_buffer_size;
+}
+void
+SWGPreferences::setRecordBufferSize(qint32 record_buffer_size) {
+    this->record_buffer_size = record_buffer_size;
+    this->m_record_buffer_size_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordDirectIo() {
+    return record_direct_io;
+}
+void
+SWGPreferences::setRecordDirectIo(qint32 record_direct_io) {
+    this->record_direct_io = record_direct_io;
+    this->m_record_direct_io_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordPreallocation() {
+    return record_preallocation;
+}
+void
+SWGPreferences::setRecordPreallocation(qint32 record_preallocation) {
+    this->record_preallocation = record_preallocation;
+    this->m_record_preallocation_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordMaxFileSize() {
+    return record_max_file_size;
+}
+void
+SWGPreferences::setRecordMaxFileSize(qint32 record_max_file_size) {
+    this->record_max_file_size = record_max_file_size;
+    this->m_record_max_file_size_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordMaxFileSeconds() {
+    return record_max_file_seconds;
+}
+void
+SWGPreferences::setRecordMaxFileSeconds(qint32 record_max_file_seconds) {
+    this->record_max_file_seconds = record_max_file_seconds;
+    this->m_record_max_file_seconds_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordSigMf() {
+    return record_sig_mf;
+}
+void
+SWGPreferences::setRecordSigMf(qint32 record_sig_mf) {
+    this->record_sig_mf = record_sig_mf;
+    this->m_record_sig_mf_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordSigMfPackingBits() {
+    return record_sig_mf_packing_bits;
+}
+void
+SWGPreferences::setRecordSigMfPackingBits(qint32 record_sig_mf_packing_bits) {
+    this->record_sig_mf_packing_bits = record_sig_mf_packing_bits;
+    this->m_record_sig_mf_packing_bits_isSet = true;
+}
+
+qint32
+SWGPreferences::getRecordSigMfCompressed() {
+    return record_sig_mf_compressed;
+}
+void
+SWGPreferences::setRecordSigMfCompressed(qint32 record_sig_mf_compressed) {
+    this->record_sig_mf_compressed = record_sig_mf_compressed;
+    this->m_record_sig_mf_compressed_isSet = true;
+}
+
 
 bool
 SWGPreferences::isSet(){
@@ -316,6 +487,33 @@ SWGPreferences::isSet(){
         if(m_file_min_log_level_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_record_nb_buffers_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_buffer_size_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_direct_io_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_preallocation_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_max_file_size_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_max_file_seconds_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_sig_mf_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_sig_mf_packing_bits_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_record_sig_mf_compressed_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -72,6 +72,33 @@ public:
     qint32 getFileMinLogLevel();
     void setFileMinLogLevel(qint32 file_min_log_level);
 
+    qint32 getRecordNbBuffers();
+    void setRecordNbBuffers(qint32 record_nb_buffers);
+
+    qint32 getRecordBufferSize();
+    void setRecordBufferSize(qint32 record_buffer_size);
+
+    qint32 getRecordDirectIo();
+    void setRecordDirectIo(qint32 record_direct_io);
+
+    qint32 getRecordPreallocation();
+    void setRecordPreallocation(qint32 record_preallocation);
+
+    qint32 getRecordMaxFileSize();
+    void setRecordMaxFileSize(qint32 record_max_file_size);
+
+    qint32 getRecordMaxFileSeconds();
+    void setRecordMaxFileSeconds(qint32 record_max_file_seconds);
+
+    qint32 getRecordSigMf();
+    void setRecordSigMf(qint32 record_sig_mf);
+
+    qint32 getRecordSigMfPackingBits();
+    void setRecordSigMfPackingBits(qint32 record_sig_mf_packing_bits);
+
+    qint32 getRecordSigMfCompressed();
+    void setRecordSigMfCompressed(qint32 record_sig_mf_compressed);
+
 
     virtual bool isSet() override;
 
@@ -106,6 +133,33 @@ private:
     qint32 file_min_log_level;
     bool m_file_min_log_level_isSet;
 
+    qint32 record_nb_buffers;
+    bool m_record_nb_buffers_isSet;
+
+    qint32 record_buffer_size;
+    bool m_record_buffer_size_isSet;
+
+    qint32 record_direct_io;
+    bool m_record_direct_io_isSet;
+
+    qint32 record_preallocation;
+    bool m_record_preallocation_isSet;
+
+    qint32 record_max_file_size;
+    bool m_record_max_file_size_isSet;
+
+    qint32 record_max_file_seconds;
+    bool m_record_max_file_seconds_isSet;
+
+    qint32 record_sig_mf;
+    bool m_record_sig_mf_isSet;
+
+    qint32 record_sig_mf_packing_bits;
+    bool m_record_sig_mf_packing_bits_isSet;
+
+    qint32 record_sig_mf_compressed;
+    bool m_record_sig_mf_compressed_isSet;
+
 };
 
 }
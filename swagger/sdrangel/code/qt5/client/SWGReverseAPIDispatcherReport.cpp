@@ -0,0 +1,315 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGReverseAPIDispatcherReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGReverseAPIDispatcherReport::SWGReverseAPIDispatcherReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGReverseAPIDispatcherReport::SWGReverseAPIDispatcherReport() {
+    coalescing_window = 0;
+    m_coalescing_window_isSet = false;
+    queue_depth = 0;
+    m_queue_depth_isSet = false;
+    max_queue_depth = 0;
+    m_max_queue_depth_isSet = false;
+    in_flight = 0;
+    m_in_flight_isSet = false;
+    nb_queued = 0L;
+    m_nb_queued_isSet = false;
+    nb_coalesced = 0L;
+    m_nb_coalesced_isSet = false;
+    nb_sent = 0L;
+    m_nb_sent_isSet = false;
+    nb_failed = 0L;
+    m_nb_failed_isSet = false;
+    average_latency = 0.0f;
+    m_average_latency_isSet = false;
+    max_latency = 0.0f;
+    m_max_latency_isSet = false;
+}
+
+SWGReverseAPIDispatcherReport::~SWGReverseAPIDispatcherReport() {
+    this->cleanup();
+}
+
+void
+SWGReverseAPIDispatcherReport::init() {
+    coalescing_window = 0;
+    m_coalescing_window_isSet = false;
+    queue_depth = 0;
+    m_queue_depth_isSet = false;
+    max_queue_depth = 0;
+    m_max_queue_depth_isSet = false;
+    in_flight = 0;
+    m_in_flight_isSet = false;
+    nb_queued = 0L;
+    m_nb_queued_isSet = false;
+    nb_coalesced = 0L;
+    m_nb_coalesced_isSet = false;
+    nb_sent = 0L;
+    m_nb_sent_isSet = false;
+    nb_failed = 0L;
+    m_nb_failed_isSet = false;
+    average_latency = 0.0f;
+    m_average_latency_isSet = false;
+    max_latency = 0.0f;
+    m_max_latency_isSet = false;
+}
+
+void
+SWGReverseAPIDispatcherReport::cleanup() {
+
+
+
+
+
+
+
+
+
+
+}
+
+SWGReverseAPIDispatcherReport*
+SWGReverseAPIDispatcherReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGReverseAPIDispatcherReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&coalescing_window, pJson["coalescingWindow"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&queue_depth, pJson["queueDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&max_queue_depth, pJson["maxQueueDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&in_flight, pJson["inFlight"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_queued, pJson["nbQueued"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_coalesced, pJson["nbCoalesced"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_sent, pJson["nbSent"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_failed, pJson["nbFailed"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&average_latency, pJson["averageLatency"], "float", "");
+    
+    ::SWGSDRangel::setValue(&max_latency, pJson["maxLatency"], "float", "");
+    
+}
+
+QString
+SWGReverseAPIDispatcherReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGReverseAPIDispatcherReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_coalescing_window_isSet){
+        obj->insert("coalescingWindow", QJsonValue(coalescing_window));
+    }
+    if(m_queue_depth_isSet){
+        obj->insert("queueDepth", QJsonValue(queue_depth));
+    }
+    if(m_max_queue_depth_isSet){
+        obj->insert("maxQueueDepth", QJsonValue(max_queue_depth));
+    }
+    if(m_in_flight_isSet){
+        obj->insert("inFlight", QJsonValue(in_flight));
+    }
+    if(m_nb_queued_isSet){
+        obj->insert("nbQueued", QJsonValue(nb_queued));
+    }
+    if(m_nb_coalesced_isSet){
+        obj->insert("nbCoalesced", QJsonValue(nb_coalesced));
+    }
+    if(m_nb_sent_isSet){
+        obj->insert("nbSent", QJsonValue(nb_sent));
+    }
+    if(m_nb_failed_isSet){
+        obj->insert("nbFailed", QJsonValue(nb_failed));
+    }
+    if(m_average_latency_isSet){
+        obj->insert("averageLatency", QJsonValue(average_latency));
+    }
+    if(m_max_latency_isSet){
+        obj->insert("maxLatency", QJsonValue(max_latency));
+    }
+
+    return obj;
+}
+
+qint32
+SWGReverseAPIDispatcherReport::getCoalescingWindow() {
+    return coalescing_window;
+}
+void
+SWGReverseAPIDispatcherReport::setCoalescingWindow(qint32 coalescing_window) {
+    this->coalescing_window = coalescing_window;
+    this->m_coalescing_window_isSet = true;
+}
+
+qint32
+SWGReverseAPIDispatcherReport::getQueueDepth() {
+    return queue_depth;
+}
+void
+SWGReverseAPIDispatcherReport::setQueueDepth(qint32 queue_depth) {
+    this->queue_depth = queue_depth;
+    this->m_queue_depth_isSet = true;
+}
+
+qint32
+SWGReverseAPIDispatcherReport::getMaxQueueDepth() {
+    return max_queue_depth;
+}
+void
+SWGReverseAPIDispatcherReport::setMaxQueueDepth(qint32 max_queue_depth) {
+    this->max_queue_depth = max_queue_depth;
+    this->m_max_queue_depth_isSet = true;
+}
+
+qint32
+SWGReverseAPIDispatcherReport::getInFlight() {
+    return in_flight;
+}
+void
+SWGReverseAPIDispatcherReport::setInFlight(qint32 in_flight) {
+    this->in_flight = in_flight;
+    this->m_in_flight_isSet = true;
+}
+
+qint64
+SWGReverseAPIDispatcherReport::getNbQueued() {
+    return nb_queued;
+}
+void
+SWGReverseAPIDispatcherReport::setNbQueued(qint64 nb_queued) {
+    this->nb_queued = nb_queued;
+    this->m_nb_queued_isSet = true;
+}
+
+qint64
+SWGReverseAPIDispatcherReport::getNbCoalesced() {
+    return nb_coalesced;
+}
+void
+SWGReverseAPIDispatcherReport::setNbCoalesced(qint64 nb_coalesced) {
+    this->nb_coalesced = nb_coalesced;
+    this->m_nb_coalesced_isSet = true;
+}
+
+qint64
+SWGReverseAPIDispatcherReport::getNbSent() {
+    return nb_sent;
+}
+void
+SWGReverseAPIDispatcherReport::setNbSent(qint64 nb_sent) {
+    this->nb_sent = nb_sent;
+    this->m_nb_sent_isSet = true;
+}
+
+qint64
+SWGReverseAPIDispatcherReport::getNbFailed() {
+    return nb_failed;
+}
+void
+SWGReverseAPIDispatcherReport::setNbFailed(qint64 nb_failed) {
+    this->nb_failed = nb_failed;
+    this->m_nb_failed_isSet = true;
+}
+
+float
+SWGReverseAPIDispatcherReport::getAverageLatency() {
+    return average_latency;
+}
+void
+SWGReverseAPIDispatcherReport::setAverageLatency(float average_latency) {
+    this->average_latency = average_latency;
+    this->m_average_latency_isSet = true;
+}
+
+float
+SWGReverseAPIDispatcherReport::getMaxLatency() {
+    return max_latency;
+}
+void
+SWGReverseAPIDispatcherReport::setMaxLatency(float max_latency) {
+    this->max_latency = max_latency;
+    this->m_max_latency_isSet = true;
+}
+
+
+bool
+SWGReverseAPIDispatcherReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_coalescing_window_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_queue_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_max_queue_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_in_flight_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_queued_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_coalesced_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_sent_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_failed_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_average_latency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_max_latency_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,113 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.6
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGReverseAPIDispatcherReport.h
+ *
+ * Reverse API sender settings and send queue statistics
+ */
+
+#ifndef SWGReverseAPIDispatcherReport_H_
+#define SWGReverseAPIDispatcherReport_H_
+
+#include <QJsonObject>
+
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGReverseAPIDispatcherReport: public SWGObject {
+public:
+    SWGReverseAPIDispatcherReport();
+    SWGReverseAPIDispatcherReport(QString* json);
+    virtual ~SWGReverseAPIDispatcherReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGReverseAPIDispatcherReport* fromJson(QString &jsonString) override;
+
+    qint32 getCoalescingWindow();
+    void setCoalescingWindow(qint32 coalescing_window);
+
+    qint32 getQueueDepth();
+    void setQueueDepth(qint32 queue_depth);
+
+    qint32 getMaxQueueDepth();
+    void setMaxQueueDepth(qint32 max_queue_depth);
+
+    qint32 getInFlight();
+    void setInFlight(qint32 in_flight);
+
+    qint64 getNbQueued();
+    void setNbQueued(qint64 nb_queued);
+
+    qint64 getNbCoalesced();
+    void setNbCoalesced(qint64 nb_coalesced);
+
+    qint64 getNbSent();
+    void setNbSent(qint64 nb_sent);
+
+    qint64 getNbFailed();
+    void setNbFailed(qint64 nb_failed);
+
+    float getAverageLatency();
+    void setAverageLatency(float average_latency);
+
+    float getMaxLatency();
+    void setMaxLatency(float max_latency);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 coalescing_window;
+    bool m_coalescing_window_isSet;
+
+    qint32 queue_depth;
+    bool m_queue_depth_isSet;
+
+    qint32 max_queue_depth;
+    bool m_max_queue_depth_isSet;
+
+    qint32 in_flight;
+    bool m_in_flight_isSet;
+
+    qint64 nb_queued;
+    bool m_nb_queued_isSet;
+
+    qint64 nb_coalesced;
+    bool m_nb_coalesced_isSet;
+
+    qint64 nb_sent;
+    bool m_nb_sent_isSet;
+
+    qint64 nb_failed;
+    bool m_nb_failed_isSet;
+
+    float average_latency;
+    bool m_average_latency_isSet;
+
+    float max_latency;
+    bool m_max_latency_isSet;
+
+};
+
+}
+
+#endif /* SWGReverseAPIDispatcherReport_H_ */